@@ -0,0 +1,152 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./shortest_path.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+#include <string.h>
+
+#define SRC_SIDE 0
+#define DEST_SIDE 1
+
+ShortestPathCtx *ShortestPathCtx_New(GrB_Matrix *forward, GrB_Matrix *backward, uint count, GrB_Index dim) {
+    assert(forward && count > 0);
+
+    ShortestPathCtx *ctx = rm_malloc(sizeof(ShortestPathCtx));
+    ctx->count = count;
+    ctx->forward = rm_malloc(sizeof(GrB_Matrix) * count);
+    memcpy(ctx->forward, forward, sizeof(GrB_Matrix) * count);
+    ctx->backward = NULL;
+    if(backward) {
+        ctx->backward = rm_malloc(sizeof(GrB_Matrix) * count);
+        memcpy(ctx->backward, backward, sizeof(GrB_Matrix) * count);
+    }
+
+    for(int side = SRC_SIDE; side <= DEST_SIDE; side++) {
+        GrB_Vector_new(&ctx->visited[side], GrB_UINT64, dim);
+        GrB_Vector_new(&ctx->frontier[side], GrB_UINT64, dim);
+    }
+    GrB_Vector_new(&ctx->next, GrB_UINT64, dim);
+
+    // Only discover nodes which weren't visited yet.
+    GrB_Descriptor_new(&ctx->desc);
+    GrB_Descriptor_set(ctx->desc, GrB_MASK, GrB_SCMP);
+    GrB_Descriptor_set(ctx->desc, GrB_OUTP, GrB_REPLACE);
+    GrB_Descriptor_new(&ctx->accum_desc);
+    GrB_Descriptor_set(ctx->accum_desc, GrB_MASK, GrB_SCMP);
+
+    return ctx;
+}
+
+/* Expands given side by a single level, next = frontier * M for every traversed M,
+ * summing up the number of paths reaching each newly discovered node.
+ * Returns false if no new nodes were discovered. */
+static bool _ShortestPath_Expand(ShortestPathCtx *ctx, int side) {
+    GrB_Vector frontier = ctx->frontier[side];
+    GrB_Vector visited = ctx->visited[side];
+
+    for(uint i = 0; i < ctx->count; i++) {
+        GrB_BinaryOp accum = (i == 0) ? GrB_NULL : GrB_PLUS_UINT64;
+        GrB_Descriptor desc = (i == 0) ? ctx->desc : ctx->accum_desc;
+
+        if(side == SRC_SIDE) {
+            GrB_vxm(ctx->next, visited, accum, GxB_PLUS_TIMES_UINT64, frontier, ctx->forward[i], desc);
+        } else if(ctx->backward) {
+            GrB_vxm(ctx->next, visited, accum, GxB_PLUS_TIMES_UINT64, frontier, ctx->backward[i], desc);
+        } else {
+            // frontier * M' = M * frontier.
+            GrB_mxv(ctx->next, visited, accum, GxB_PLUS_TIMES_UINT64, ctx->forward[i], frontier, desc);
+        }
+    }
+
+    GrB_Index nvals;
+    GrB_Vector_nvals(&nvals, ctx->next);
+    if(nvals == 0) return false;
+
+    // Newly discovered nodes form the next frontier.
+    GrB_eWiseAdd_Vector_BinaryOp(visited, GrB_NULL, GrB_NULL, GrB_PLUS_UINT64, visited, ctx->next, GrB_NULL);
+    ctx->frontier[side] = ctx->next;
+    ctx->next = frontier;
+    return true;
+}
+
+/* Number of shortest paths going through nodes discovered by both sides,
+ * 0 if frontiers haven't met. */
+static uint64_t _ShortestPath_Meet(ShortestPathCtx *ctx) {
+    GrB_Index nvals;
+    uint64_t path_count = 0;
+
+    GrB_eWiseMult_Vector_BinaryOp(ctx->next, GrB_NULL, GrB_NULL, GrB_TIMES_UINT64,
+                                  ctx->frontier[SRC_SIDE], ctx->frontier[DEST_SIDE], GrB_NULL);
+    GrB_Vector_nvals(&nvals, ctx->next);
+    if(nvals > 0) GrB_Vector_reduce_UINT64(&path_count, GrB_NULL, GxB_PLUS_UINT64_MONOID, ctx->next, GrB_NULL);
+    GrB_Vector_clear(ctx->next);
+    return path_count;
+}
+
+int64_t ShortestPath_Search(ShortestPathCtx *ctx, NodeID src, NodeID dest, unsigned int minHops,
+                            unsigned int maxHops, uint64_t *path_count) {
+    assert(ctx && path_count && minHops <= 1);
+
+    *path_count = 0;
+    if(src == dest) {
+        // Shortest paths are simple, a node is only connected to itself by the empty path.
+        if(minHops > 0) return -1;
+        *path_count = 1;
+        return 0;
+    }
+
+    for(int side = SRC_SIDE; side <= DEST_SIDE; side++) {
+        GrB_Vector_clear(ctx->visited[side]);
+        GrB_Vector_clear(ctx->frontier[side]);
+    }
+    GrB_Vector_setElement_UINT64(ctx->visited[SRC_SIDE], 1, src);
+    GrB_Vector_setElement_UINT64(ctx->frontier[SRC_SIDE], 1, src);
+    GrB_Vector_setElement_UINT64(ctx->visited[DEST_SIDE], 1, dest);
+    GrB_Vector_setElement_UINT64(ctx->frontier[DEST_SIDE], 1, dest);
+
+    /* Once a node discovered by one side was already visited by the other side
+     * it must have been discovered by the other side's last level,
+     * otherwise a shorter path would have been detected earlier. */
+    int64_t length = -1;
+    for(unsigned int hops = 1; hops <= maxHops; hops++) {
+        // Expand the side with the smaller frontier.
+        GrB_Index src_nvals;
+        GrB_Index dest_nvals;
+        GrB_Vector_nvals(&src_nvals, ctx->frontier[SRC_SIDE]);
+        GrB_Vector_nvals(&dest_nvals, ctx->frontier[DEST_SIDE]);
+        int side = (src_nvals <= dest_nvals) ? SRC_SIDE : DEST_SIDE;
+
+        // Side can't be expanded any further, destination is unreachable.
+        if(!_ShortestPath_Expand(ctx, side)) break;
+
+        *path_count = _ShortestPath_Meet(ctx);
+        if(*path_count > 0) {
+            length = hops;
+            break;
+        }
+    }
+
+    for(int side = SRC_SIDE; side <= DEST_SIDE; side++) {
+        GrB_Vector_clear(ctx->visited[side]);
+        GrB_Vector_clear(ctx->frontier[side]);
+    }
+    return length;
+}
+
+void ShortestPathCtx_Free(ShortestPathCtx *ctx) {
+    if(!ctx) return;
+    for(int side = SRC_SIDE; side <= DEST_SIDE; side++) {
+        GrB_Vector_free(&ctx->visited[side]);
+        GrB_Vector_free(&ctx->frontier[side]);
+    }
+    GrB_Vector_free(&ctx->next);
+    GrB_Descriptor_free(&ctx->desc);
+    GrB_Descriptor_free(&ctx->accum_desc);
+    rm_free(ctx->forward);
+    if(ctx->backward) rm_free(ctx->backward);
+    rm_free(ctx);
+}
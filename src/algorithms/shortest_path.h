@@ -0,0 +1,55 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "../graph/entities/node.h"
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Bidirectional BFS context, searches for the shortest paths connecting
+ * a source node to a destination node, a path may advance from node i to node j
+ * if any of the traversed matrices holds an entry at [i, j].
+ * Both sides keep a frontier vector holding for each node discovered at the
+ * last level the number of shortest paths leading to it,
+ * the side with the smaller frontier is expanded by a vector matrix product
+ * masked by the nodes it already visited, search stops once frontiers meet. */
+typedef struct {
+    GrB_Matrix *forward;        // Traversed matrices, expanded from source.
+    GrB_Matrix *backward;       // Transposes of forward matrices, expanded from destination.
+    uint count;                 // Number of traversed matrices.
+    GrB_Vector visited[2];      // Nodes reached from source and from destination.
+    GrB_Vector frontier[2];     // Nodes discovered at last level, from source and from destination.
+    GrB_Vector next;            // Nodes discovered at the level being expanded.
+    GrB_Descriptor desc;        // Replaces next, masked by complement of visited.
+    GrB_Descriptor accum_desc;  // Accumulates into next, masked by complement of visited.
+} ShortestPathCtx;
+
+/* Creates a new context traversing count dim x dim matrices,
+ * backward[i] is the transpose of forward[i], if backward is NULL
+ * destination side is expanded by multiplying forward matrices by its frontier. */
+ShortestPathCtx *ShortestPathCtx_New (
+    GrB_Matrix *forward,        // Traversed matrices.
+    GrB_Matrix *backward,       // Transposes of traversed matrices, optional.
+    uint count,                 // Number of traversed matrices.
+    GrB_Index dim               // Matrices dimension.
+);
+
+/* Searches for the shortest paths from src to dest consisting of
+ * at least minHops and at most maxHops hops, minHops must be either 0 or 1.
+ * Returns the length of the shortest paths or -1 if there are none,
+ * path_count is set to the number of shortest paths, paths are counted
+ * by the traversed matrices connecting consecutive nodes. */
+int64_t ShortestPath_Search (
+    ShortestPathCtx *ctx,
+    NodeID src,                 // Path source.
+    NodeID dest,                // Path destination.
+    unsigned int minHops,       // Minimum path length.
+    unsigned int maxHops,       // Maximum path length.
+    uint64_t *path_count        // [Output] Number of shortest paths.
+);
+
+void ShortestPathCtx_Free(ShortestPathCtx *ctx);
@@ -17,6 +17,7 @@ struct AggCtx {
     SIValue result;
     int (*Step)(struct AggCtx *ctx, SIValue *argv, int argc);
     int (*ReduceNext)(struct AggCtx *ctx);
+    int (*Merge)(struct AggCtx *ctx, struct AggCtx *other);
 };
 typedef struct AggCtx AggCtx;
 
@@ -5,11 +5,14 @@
 */
 
 #include <float.h>
+#include <string.h>
 #include "agg_funcs.h"
 #include "aggregate.h"
 #include "repository.h"
 #include "../value.h"
+#include "../util/hll.h"
 #include "../util/qsort.h"
+#include "../util/tdigest.h"
 #include <assert.h>
 #include <math.h>
 
@@ -49,12 +52,20 @@ int __agg_sumReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_sumMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_sumCtx *ac = Agg_FuncCtx(ctx);
+    __agg_sumCtx *oc = Agg_FuncCtx(other);
+    ac->num += oc->num;
+    ac->total += oc->total;
+    return AGG_OK;
+}
+
 AggCtx* Agg_SumFunc() {
     __agg_sumCtx *ac = malloc(sizeof(__agg_sumCtx));
     ac->num = 0;
     ac->total = 0;
     
-    return Agg_Reduce(ac, __agg_sumStep, __agg_sumReduceNext);
+    return Agg_Reduce(ac, __agg_sumStep, __agg_sumReduceNext, __agg_sumMerge);
 }
 
 //------------------------------------------------------------------------
@@ -99,12 +110,20 @@ int __agg_avgReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_avgMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_avgCtx *ac = Agg_FuncCtx(ctx);
+    __agg_avgCtx *oc = Agg_FuncCtx(other);
+    ac->count += oc->count;
+    ac->total += oc->total;
+    return AGG_OK;
+}
+
 AggCtx* Agg_AvgFunc() {
     __agg_avgCtx *ac = malloc(sizeof(__agg_avgCtx));
     ac->count = 0;
     ac->total = 0;
     
-    return Agg_Reduce(ac, __agg_avgStep, __agg_avgReduceNext);
+    return Agg_Reduce(ac, __agg_avgStep, __agg_avgReduceNext, __agg_avgMerge);
 }
 
 //------------------------------------------------------------------------
@@ -140,12 +159,18 @@ int __agg_maxReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_maxMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_maxCtx *oc = Agg_FuncCtx(other);
+    if(!oc->init) return AGG_OK;
+    return __agg_maxStep(ctx, &oc->max, 1);
+}
+
 AggCtx* Agg_MaxFunc() {
     __agg_maxCtx *ac = malloc(sizeof(__agg_maxCtx));
     // ac->max = SI_DoubleVal(DBL_MIN);
     ac->init = false;
     
-    return Agg_Reduce(ac, __agg_maxStep, __agg_maxReduceNext);
+    return Agg_Reduce(ac, __agg_maxStep, __agg_maxReduceNext, __agg_maxMerge);
 }
 
 //------------------------------------------------------------------------
@@ -181,12 +206,18 @@ int __agg_minReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_minMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_minCtx *oc = Agg_FuncCtx(other);
+    if(!oc->init) return AGG_OK;
+    return __agg_minStep(ctx, &oc->min, 1);
+}
+
 AggCtx* Agg_MinFunc() {
     __agg_minCtx *ac = malloc(sizeof(__agg_minCtx));
     // ac->min = SI_DoubleVal(DBL_MAX);
     ac->init = false;
     
-    return Agg_Reduce(ac, __agg_minStep, __agg_minReduceNext);
+    return Agg_Reduce(ac, __agg_minStep, __agg_minReduceNext, __agg_minMerge);
 }
 
 //------------------------------------------------------------------------
@@ -210,11 +241,18 @@ int __agg_countReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_countMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_countCtx *ac = Agg_FuncCtx(ctx);
+    __agg_countCtx *oc = Agg_FuncCtx(other);
+    ac->count += oc->count;
+    return AGG_OK;
+}
+
 AggCtx* Agg_CountFunc() {
     __agg_countCtx *ac = malloc(sizeof(__agg_countCtx));
     ac->count = 0;
     
-    return Agg_Reduce(ac, __agg_countStep, __agg_countReduceNext);
+    return Agg_Reduce(ac, __agg_countStep, __agg_countReduceNext, __agg_countMerge);
 }
 
 //------------------------------------------------------------------------
@@ -224,6 +262,7 @@ typedef struct {
     double *values;
     size_t count;
     size_t values_allocated;
+    bool sorted;
 } __agg_percCtx;
 
 // This function is agnostic as to percentile method
@@ -262,15 +301,56 @@ int __agg_percStep(AggCtx *ctx, SIValue *argv, int argc) {
         }
         ac->values[ac->count] = n;
         ac->count++;
+        ac->sorted = false;
     }
 
     return AGG_OK;
 }
 
+static void __agg_percSort(__agg_percCtx *ac) {
+    if(ac->sorted) return;
+    QSORT(double, ac->values, ac->count, ISLT);
+    ac->sorted = true;
+}
+
+// Merges both partial aggregations' values as sorted runs.
+int __agg_percMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_percCtx *ac = Agg_FuncCtx(ctx);
+    __agg_percCtx *oc = Agg_FuncCtx(other);
+    if(ac->percentile < 0) ac->percentile = oc->percentile;
+
+    __agg_percSort(ac);
+    __agg_percSort(oc);
+
+    size_t count = ac->count + oc->count;
+    size_t allocated = (count > ac->values_allocated) ? count : ac->values_allocated;
+    double *values = malloc(sizeof(double) * allocated);
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    while(i < ac->count && j < oc->count) {
+        values[k++] = (oc->values[j] < ac->values[i]) ? oc->values[j++] : ac->values[i++];
+    }
+    while(i < ac->count) values[k++] = ac->values[i++];
+    while(j < oc->count) values[k++] = oc->values[j++];
+
+    free(ac->values);
+    ac->values = values;
+    ac->values_allocated = allocated;
+    ac->count = count;
+
+    // Partial aggregation is never reduced, release its values.
+    free(oc->values);
+    oc->values = NULL;
+    oc->values_allocated = 0;
+    oc->count = 0;
+    return AGG_OK;
+}
+
 int __agg_percDiscReduceNext(AggCtx *ctx) {
     __agg_percCtx *ac = Agg_FuncCtx(ctx);
 
-    QSORT(double, ac->values, ac->count, ISLT);
+    __agg_percSort(ac);
 
     // If ac->percentile == 0, employing this formula would give an index of -1
     int idx = ac->percentile > 0 ? ceil(ac->percentile * ac->count) - 1 : 0;
@@ -284,7 +364,7 @@ int __agg_percDiscReduceNext(AggCtx *ctx) {
 int __agg_percContReduceNext(AggCtx *ctx) {
     __agg_percCtx *ac = Agg_FuncCtx(ctx);
 
-    QSORT(double, ac->values, ac->count, ISLT);
+    __agg_percSort(ac);
 
     if (ac->percentile == 1.0 || ac->count == 1) {
         Agg_SetResult(ctx, SI_DoubleVal(ac->values[ac->count - 1]));
@@ -321,9 +401,10 @@ AggCtx* Agg_PercDiscFunc() {
     ac->count = 0;
     ac->values = malloc(1024 * sizeof(double));
     ac->values_allocated = 1024;
+    ac->sorted = true;
     // Percentile will be updated by the first call to Step
     ac->percentile = -1;
-    return Agg_Reduce(ac, __agg_percStep, __agg_percDiscReduceNext);
+    return Agg_Reduce(ac, __agg_percStep, __agg_percDiscReduceNext, __agg_percMerge);
 }
 
 AggCtx* Agg_PercContFunc() {
@@ -331,9 +412,10 @@ AggCtx* Agg_PercContFunc() {
     ac->count = 0;
     ac->values = malloc(1024 * sizeof(double));
     ac->values_allocated = 1024;
+    ac->sorted = true;
     // Percentile will be updated by the first call to Step
     ac->percentile = -1;
-    return Agg_Reduce(ac, __agg_percStep, __agg_percContReduceNext);
+    return Agg_Reduce(ac, __agg_percStep, __agg_percContReduceNext, __agg_percMerge);
 }
 
 //------------------------------------------------------------------------
@@ -397,6 +479,27 @@ int __agg_StdevReduceNext(AggCtx *ctx) {
     return AGG_OK;
 }
 
+int __agg_StdevMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_stdevCtx *ac = Agg_FuncCtx(ctx);
+    __agg_stdevCtx *oc = Agg_FuncCtx(other);
+
+    if(ac->count + oc->count > ac->values_allocated) {
+        ac->values_allocated = ac->count + oc->count;
+        ac->values = realloc(ac->values, sizeof(double) * ac->values_allocated);
+    }
+    memcpy(ac->values + ac->count, oc->values, sizeof(double) * oc->count);
+    ac->count += oc->count;
+    ac->total += oc->total;
+
+    // Partial aggregation is never reduced, release its values.
+    free(oc->values);
+    oc->values = NULL;
+    oc->values_allocated = 0;
+    oc->count = 0;
+    oc->total = 0;
+    return AGG_OK;
+}
+
 AggCtx* Agg_StdevFunc() {
     __agg_stdevCtx *ac = malloc(sizeof(__agg_stdevCtx));
     ac->is_sampled = 1;
@@ -404,7 +507,7 @@ AggCtx* Agg_StdevFunc() {
     ac->total = 0;
     ac->values = malloc(1024 * sizeof(double));
     ac->values_allocated = 1024;
-    return Agg_Reduce(ac, __agg_StdevStep, __agg_StdevReduceNext);
+    return Agg_Reduce(ac, __agg_StdevStep, __agg_StdevReduceNext, __agg_StdevMerge);
 }
 
 // StdevP is identical to Stdev save for an altered value we can check for with a bool
@@ -417,6 +520,108 @@ AggCtx* Agg_StdevPFunc() {
 
 //------------------------------------------------------------------------
 
+typedef struct {
+    HLL hll;
+} __agg_approxCountDistinctCtx;
+
+int __agg_approxCountDistinctStep(AggCtx *ctx, SIValue *argv, int argc) {
+    __agg_approxCountDistinctCtx *ac = Agg_FuncCtx(ctx);
+    // Any null values are excluded from the calculation.
+    if (SIValue_IsNullPtr(argv)) return AGG_OK;
+
+    // Integral doubles hash as integers, such that 1 and 1.0 count once.
+    HLL_Add(&ac->hll, SIValue_HashCode(argv[0]));
+    return AGG_OK;
+}
+
+int __agg_approxCountDistinctReduceNext(AggCtx *ctx) {
+    __agg_approxCountDistinctCtx *ac = Agg_FuncCtx(ctx);
+    Agg_SetResult(ctx, SI_LongVal(HLL_Count(&ac->hll)));
+    return AGG_OK;
+}
+
+int __agg_approxCountDistinctMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_approxCountDistinctCtx *ac = Agg_FuncCtx(ctx);
+    __agg_approxCountDistinctCtx *oc = Agg_FuncCtx(other);
+    HLL_Merge(&ac->hll, &oc->hll);
+    return AGG_OK;
+}
+
+AggCtx* Agg_ApproxCountDistinctFunc() {
+    __agg_approxCountDistinctCtx *ac = malloc(sizeof(__agg_approxCountDistinctCtx));
+    HLL_Init(&ac->hll);
+    return Agg_Reduce(ac, __agg_approxCountDistinctStep, __agg_approxCountDistinctReduceNext,
+                      __agg_approxCountDistinctMerge);
+}
+
+//------------------------------------------------------------------------
+
+typedef struct {
+    double percentile;
+    TDigest digest;
+} __agg_approxPercCtx;
+
+int __agg_approxPercStep(AggCtx *ctx, SIValue *argv, int argc) {
+    __agg_approxPercCtx *ac = Agg_FuncCtx(ctx);
+
+    // The last argument is the requested percentile,
+    // which we only need to apply on the first function invocation.
+    if (ac->percentile < 0) {
+        if (!SIValue_ToDouble(&argv[argc - 1], &ac->percentile)) {
+            return Agg_SetError(ctx,
+                    "APPROX_PERCENTILE Could not convert percentile argument to double");
+        }
+        if (ac->percentile < 0 || ac->percentile > 1) {
+            return Agg_SetError(ctx,
+                    "APPROX_PERCENTILE Invalid input for percentile is not a valid argument, must be a number in the range 0.0 to 1.0");
+        }
+    }
+
+    double n;
+    for (int i = 0; i < argc - 1; i ++) {
+        if (!SIValue_ToDouble(&argv[i], &n)) {
+            if (!SIValue_IsNullPtr(&argv[i])) {
+                // not convertible to double!
+                return Agg_SetError(ctx,
+                        "APPROX_PERCENTILE Could not convert upstream value to double");
+            } else {
+                return AGG_OK;
+            }
+        }
+        TDigest_Add(&ac->digest, n);
+    }
+
+    return AGG_OK;
+}
+
+int __agg_approxPercReduceNext(AggCtx *ctx) {
+    __agg_approxPercCtx *ac = Agg_FuncCtx(ctx);
+    if (ac->digest.count == 0) {
+        Agg_SetResult(ctx, SI_NullVal());
+    } else {
+        Agg_SetResult(ctx, SI_DoubleVal(TDigest_Quantile(&ac->digest, ac->percentile)));
+    }
+    return AGG_OK;
+}
+
+int __agg_approxPercMerge(AggCtx *ctx, AggCtx *other) {
+    __agg_approxPercCtx *ac = Agg_FuncCtx(ctx);
+    __agg_approxPercCtx *oc = Agg_FuncCtx(other);
+    if(ac->percentile < 0) ac->percentile = oc->percentile;
+    TDigest_Merge(&ac->digest, &oc->digest);
+    return AGG_OK;
+}
+
+AggCtx* Agg_ApproxPercentileFunc() {
+    __agg_approxPercCtx *ac = malloc(sizeof(__agg_approxPercCtx));
+    TDigest_Init(&ac->digest);
+    // Percentile will be updated by the first call to Step
+    ac->percentile = -1;
+    return Agg_Reduce(ac, __agg_approxPercStep, __agg_approxPercReduceNext, __agg_approxPercMerge);
+}
+
+//------------------------------------------------------------------------
+
 void Agg_RegisterFuncs() {
     Agg_RegisterFunc("sum", Agg_SumFunc);
     Agg_RegisterFunc("avg", Agg_AvgFunc);
@@ -427,4 +632,6 @@ void Agg_RegisterFuncs() {
     Agg_RegisterFunc("percentileCont", Agg_PercContFunc);
     Agg_RegisterFunc("stDev", Agg_StdevFunc);
     Agg_RegisterFunc("stDevP", Agg_StdevPFunc);
+    Agg_RegisterFunc("approxCountDistinct", Agg_ApproxCountDistinctFunc);
+    Agg_RegisterFunc("approxPercentile", Agg_ApproxPercentileFunc);
 }
\ No newline at end of file
@@ -19,6 +19,8 @@ AggCtx* Agg_CountFunc();
 AggCtx* Agg_PercContFunc();
 AggCtx* Agg_PercDiscFunc();
 AggCtx* Agg_stDev();
+AggCtx* Agg_ApproxCountDistinctFunc();
+AggCtx* Agg_ApproxPercentileFunc();
 
 void Agg_RegisterFuncs();
 
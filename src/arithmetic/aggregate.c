@@ -6,10 +6,11 @@
 
 #include "aggregate.h"
 
-AggCtx *Agg_Reduce(void *ctx, StepFunc f, ReduceFunc reduce) {
+AggCtx *Agg_Reduce(void *ctx, StepFunc f, ReduceFunc reduce, MergeFunc merge) {
   AggCtx *ac = Agg_NewCtx(ctx);
   ac->Step = f;
   ac->ReduceNext = reduce;
+  ac->Merge = merge;
   return ac;
 }
 
@@ -20,6 +21,7 @@ AggCtx *Agg_NewCtx(void *fctx) {
     ac->result = SI_NullVal();
     ac->Step = NULL;
     ac->ReduceNext = NULL;
+    ac->Merge = NULL;
     return ac;
 }
 
@@ -42,6 +44,12 @@ int Agg_Finalize(AggCtx *ctx) {
   return ctx->ReduceNext(ctx);
 }
 
+int Agg_Merge(AggCtx *ctx, AggCtx *other) {
+  // Errors raised by either partial aggregation carry over.
+  if(!ctx->err) ctx->err = other->err;
+  return ctx->Merge(ctx, other);
+}
+
 inline void *Agg_FuncCtx(AggCtx *ctx) { return ctx->fctx; }
 
 inline void Agg_SetResult(struct AggCtx *ctx, SIValue v) {
@@ -24,8 +24,10 @@
 
 typedef int (*StepFunc)(AggCtx *ctx, SIValue *argv, int argc);
 typedef int (*ReduceFunc)(AggCtx *ctx);
+/* Folds other's partial aggregation into ctx, other is left empty. */
+typedef int (*MergeFunc)(AggCtx *ctx, AggCtx *other);
 
-AggCtx *Agg_Reduce(void *ctx, StepFunc f, ReduceFunc reduce);
+AggCtx *Agg_Reduce(void *ctx, StepFunc f, ReduceFunc reduce, MergeFunc merge);
 AggCtx *Agg_NewCtx(void *fctx);
 void AggCtx_Free(AggCtx *ctx);
 int Agg_SetError(AggCtx *ctx, AggError *err);
@@ -34,5 +36,6 @@ void Agg_SetResult(AggCtx *ctx, SIValue v);
 
 int Agg_Step(AggCtx *ctx, SIValue *argv, int argc);
 int Agg_Finalize(AggCtx *ctx);
+int Agg_Merge(AggCtx *ctx, AggCtx *other);
 
 #endif
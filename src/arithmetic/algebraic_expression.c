@@ -18,6 +18,7 @@ AlgebraicExpression *_AE_MUL(size_t operand_cap) {
     ae->operand_count = 0;
     ae->operands = malloc(sizeof(AlgebraicExpressionOperand) * ae->operand_cap);
     ae->edge = NULL;
+    ae->ast = NULL;
     return ae;
 }
 
@@ -108,9 +109,10 @@ static AlgebraicExpression** _AlgebraicExpression_IsolateVariableLenExps(Algebra
 
             /* Create a new expression. */
             AlgebraicExpression *newExp = _AE_MUL(1);
+            newExp->ast = exp->ast;
             newExp->src_node = exp->src_node;
             newExp->dest_node = exp->src_node;
-            AlgebraicExpression_PrependTerm(newExp, op.operand, op.transpose, op.free, op.diagonal);
+            AlgebraicExpression_PrependOperand(newExp, op);
             res = array_append(res, newExp);
         }
 
@@ -126,12 +128,13 @@ static AlgebraicExpression** _AlgebraicExpression_IsolateVariableLenExps(Algebra
              * If not create a new expression. */
             if(expIdx < expCount-1 &&
                 !_AlgebraicExpression_ContainsVariableLengthEdge(expressions[expIdx+1])) {
-                AlgebraicExpression_PrependTerm(expressions[expIdx+1], op.operand, op.transpose, op.free, op.diagonal);
+                AlgebraicExpression_PrependOperand(expressions[expIdx+1], op);
             } else {
                 AlgebraicExpression *newExp = _AE_MUL(1);
+                newExp->ast = exp->ast;
                 newExp->src_node = exp->dest_node;
                 newExp->dest_node = exp->dest_node;
-                AlgebraicExpression_PrependTerm(newExp, op.operand, op.transpose, op.free, op.diagonal);
+                AlgebraicExpression_PrependOperand(newExp, op);
                 res = array_append(res, newExp);
             }
         }
@@ -156,6 +159,23 @@ static inline void _AlgebraicExpression_Execute_MUL(GrB_Matrix C, GrB_Matrix A,
     assert(res == GrB_SUCCESS);
 }
 
+/* Computes C = A*B where B is a graph matrix with pending additions DP,
+ * C = A*B + A*DP, C might be aliased with A. */
+static void _AlgebraicExpression_Execute_MUL_Delta(GrB_Matrix C, GrB_Matrix A, GrB_Matrix B, GrB_Matrix DP) {
+    GrB_Matrix T;
+    GrB_Index nrows;
+    GrB_Index ncols;
+    GrB_Matrix_nrows(&nrows, A);
+    GrB_Matrix_ncols(&ncols, DP);
+    GrB_Matrix_new(&T, GrB_BOOL, nrows, ncols);
+
+    _AlgebraicExpression_Execute_MUL(T, A, DP, GrB_NULL);
+    _AlgebraicExpression_Execute_MUL(C, A, B, GrB_NULL);
+    GrB_Info res = GrB_eWiseAdd_Matrix_Semiring(C, GrB_NULL, GrB_NULL, Rg_structured_bool, C, T, GrB_NULL);
+    assert(res == GrB_SUCCESS);
+    GrB_Matrix_free(&T);
+}
+
 // Reverse order of operand within expression,
 // A*B*C will become C*B*A. 
 static void _AlgebraicExpression_ReverseOperandOrder(AlgebraicExpression *exp) {
@@ -192,6 +212,10 @@ void AlgebraicExpression_AppendTerm(AlgebraicExpression *ae, GrB_Matrix m, bool
     ae->operands[ae->operand_count].free = freeOp;
     ae->operands[ae->operand_count].diagonal = diagonal;
     ae->operands[ae->operand_count].transpose = transposeOp;
+    ae->operands[ae->operand_count].transposed = false;
+    ae->operands[ae->operand_count].schema_id = GRAPH_NO_RELATION;
+    ae->operands[ae->operand_count].node = NULL;
+    ae->operands[ae->operand_count].edge = NULL;
     ae->operand_count++;
 }
 
@@ -214,6 +238,10 @@ void AlgebraicExpression_PrependTerm(AlgebraicExpression *ae, GrB_Matrix m, bool
     ae->operands[0].free = freeOp;
     ae->operands[0].diagonal = diagonal;
     ae->operands[0].transpose = transposeOp;
+    ae->operands[0].transposed = false;
+    ae->operands[0].schema_id = GRAPH_NO_RELATION;
+    ae->operands[0].node = NULL;
+    ae->operands[0].edge = NULL;
 }
 
 void AlgebraicExpression_AppendOperand(AlgebraicExpression *ae, AlgebraicExpressionOperand op) {
@@ -293,6 +321,7 @@ static AlgebraicExpression** _AlgebraicExpression_Intermidate_Expressions(
     expressions = array_new(AlgebraicExpression*, exp->operand_count);
     AlgebraicExpression *iexp = _AE_MUL(exp->operand_count);
     iexp->operand_count = 0;
+    iexp->ast = exp->ast;
     iexp->src_node = exp->src_node;
     iexp->dest_node = exp->dest_node;
     expressions = array_append(expressions, iexp);
@@ -334,6 +363,7 @@ static AlgebraicExpression** _AlgebraicExpression_Intermidate_Expressions(
             /* Create a new algebraic expression. */
             iexp = _AE_MUL(exp->operand_count - operandIdx);
             iexp->operand_count = 0;
+            iexp->ast = exp->ast;
             iexp->src_node = expressions[expIdx-1]->dest_node;
             iexp->dest_node = exp->dest_node;
             expressions = array_append(expressions, iexp);
@@ -349,6 +379,10 @@ static AlgebraicExpressionOperand _AlgebraicExpression_OperandFromNode(Node *n)
     op.free = false;
     op.diagonal = true;
     op.transpose = false;
+    op.transposed = false;
+    op.schema_id = n->labelID;
+    op.node = n;
+    op.edge = NULL;
     op.operand = Node_GetMatrix(n);
     return op;
 }
@@ -382,14 +416,22 @@ static AlgebraicExpressionOperand _AlgebraicExpression_OperandFromEdge (
             if(!s) continue;
             GrB_Matrix l = Graph_GetRelationMatrix(g, s->id);
             GrB_Info info = GrB_eWiseAdd_Matrix_Semiring(m, NULL, NULL, Rg_structured_bool, m, l, NULL);
+            // Include relation's pending additions.
+            l = Graph_GetDeltaMatrix(g, l);
+            if(l) info = GrB_eWiseAdd_Matrix_Semiring(m, NULL, NULL, Rg_structured_bool, m, l, NULL);
         }
         mat = m;
     }
 
     op.operand = mat;
+    // Multiple relation types are estimated as an untyped relation.
+    op.schema_id = (labelCount > 1) ? GRAPH_NO_RELATION : e->relationID;
     op.diagonal = false;
     op.free = freeMatrix;
     op.transpose = transpose;
+    op.transposed = false;
+    op.node = NULL;
+    op.edge = e;
     return op;
 }
 
@@ -455,12 +497,11 @@ static AlgebraicExpression* _AlgebraicExpression_From_Path(Edge **path, uint pat
             AlgebraicExpression_AppendOperand(exp, op);
         }
 
-        // Add Edge matrix.
-        op = _AlgebraicExpression_OperandFromEdge(e, transpose, ast);
-
-        /* Expand fixed variable length edge */
+        /* Add Edge matrix, expand fixed variable length edge
+         * each hop owns its operand, as multi-type operands are freed by the expression. */
         unsigned int hops = (!Edge_VariableLength(e)) ? e->minHops : 1;
         for(int j = 0; j < hops; j++) {
+            op = _AlgebraicExpression_OperandFromEdge(e, transpose, ast);
             AlgebraicExpression_AppendOperand(exp, op);
         }
     }   // End of path traversal.
@@ -472,6 +513,7 @@ static AlgebraicExpression* _AlgebraicExpression_From_Path(Edge **path, uint pat
     }
 
     // Set expression source and destination nodes.
+    exp->ast = ast;
     exp->src_node = path[0]->src;
     exp->dest_node = e->dest;
 
@@ -581,6 +623,17 @@ void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
     AlgebraicExpressionOperand operands[operand_count];
     memcpy(operands, ae->operands, sizeof(AlgebraicExpressionOperand) * operand_count);
 
+    /* Graph matrices might have pending additions held in delta matrices,
+     * in which case the left most operand is merged with its delta. */
+    Graph *g = GraphContext_GetFromTLS()->g;
+    GrB_Matrix first = NULL;
+    GrB_Matrix DP = Graph_GetDeltaMatrix(g, operands[0].operand);
+    if(DP) {
+        GrB_Matrix_dup(&first, operands[0].operand);
+        GrB_eWiseAdd_Matrix_Semiring(first, GrB_NULL, GrB_NULL, Rg_structured_bool, first, DP, GrB_NULL);
+        operands[0].operand = first;
+    }
+
     /* Multiply left to right
      * A*B*C*D
      * X = A*B
@@ -597,24 +650,36 @@ void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
         if (rightTerm.transpose) {
             assert(!rightTerm.diagonal); // Never transpose diagonal matrix.
             GrB_Matrix t = rightTerm.operand;
-            /* Graph matrices are immutable, create a new matrix. 
-             * and transpose. */
             if (!rightTerm.free) {
-                GrB_Index cols;
-                GrB_Matrix_ncols(&cols, rightTerm.operand);
-                GrB_Matrix_new(&t, GrB_BOOL, cols, cols);
+                /* Graph maintains a transposed version of its relation matrices,
+                 * use it if available, otherwise as graph matrices are immutable,
+                 * create a new matrix and transpose. */
+                t = Graph_GetTransposedMatrix(g, rightTerm.operand);
+                if (t == NULL) {
+                    GrB_Index cols;
+                    GrB_Matrix_ncols(&cols, rightTerm.operand);
+                    GrB_Matrix_new(&t, GrB_BOOL, cols, cols);
+                    GrB_transpose(t, GrB_NULL, GrB_NULL, rightTerm.operand, GrB_NULL);
+                    // Operand might be a replaced graph matrix with pending additions.
+                    DP = Graph_GetDeltaMatrix(g, rightTerm.operand);
+                    if(DP) GrB_transpose(t, GrB_NULL, GrB_LOR, DP, GrB_NULL);
+                    rightTerm.free = true;
+                }
+            } else {
+                GrB_transpose(t, GrB_NULL, GrB_NULL, rightTerm.operand, GrB_NULL);
             }
-            GrB_transpose(t, GrB_NULL, GrB_NULL, rightTerm.operand, GrB_NULL);
 
             // Update local and original expressions.
-            rightTerm.free = true;
             rightTerm.operand = t;
             rightTerm.transpose = false;
             ae->operands[i].free = rightTerm.free;
             ae->operands[i].operand = rightTerm.operand;
             ae->operands[i].transpose = rightTerm.transpose;
+            ae->operands[i].transposed = true;
         }
-        _AlgebraicExpression_Execute_MUL(res, leftTerm.operand, rightTerm.operand, GrB_NULL);
+        DP = (rightTerm.free) ? NULL : Graph_GetDeltaMatrix(g, rightTerm.operand);
+        if(DP) _AlgebraicExpression_Execute_MUL_Delta(res, leftTerm.operand, rightTerm.operand, DP);
+        else _AlgebraicExpression_Execute_MUL(res, leftTerm.operand, rightTerm.operand, GrB_NULL);
 
         // Quick return if C is ZERO, there's no way to make progress.
         GrB_Index nvals = 0;
@@ -624,6 +689,30 @@ void AlgebraicExpression_Execute(AlgebraicExpression *ae, GrB_Matrix res) {
         // Assign result and update operands count.
         operands[i].operand = res;
     }
+
+    if(first) GrB_Matrix_free(&first);
+}
+
+void AlgebraicExpression_Rebind(AlgebraicExpression *ae) {
+    assert(ae);
+    for(size_t i = 0; i < ae->operand_count; i++) {
+        AlgebraicExpressionOperand *op = ae->operands + i;
+        // Operand is managed by the expression's user, e.g. a filter matrix.
+        if(!op->node && !op->edge) continue;
+
+        // Evaluation might have replaced operand with its transpose.
+        bool transpose = op->transpose || op->transposed;
+        if(op->free) GrB_Matrix_free(&op->operand);
+
+        // Drop matrices cached by query graph entities.
+        if(op->node) {
+            op->node->mat = NULL;
+            *op = _AlgebraicExpression_OperandFromNode(op->node);
+        } else {
+            op->edge->mat = NULL;
+            *op = _AlgebraicExpression_OperandFromEdge(op->edge, transpose, ae->ast);
+        }
+    }
 }
 
 void AlgebraicExpression_RemoveTerm(AlgebraicExpression *ae, int idx, AlgebraicExpressionOperand *operand) {
@@ -55,6 +55,10 @@ typedef struct  {
     bool diagonal;          // Diagonal matrix.
     bool transpose;         // Should the matrix be transposed.
     bool free;              // Should the matrix be freed?
+    bool transposed;        // Operand was replaced by its transpose on evaluation.
+    int schema_id;          // Label or relation operand represents, GRAPH_NO_RELATION if untyped or unknown.
+    Node *node;             // Labeled node operand was built from, NULL otherwise.
+    Edge *edge;             // Edge operand was built from, NULL otherwise.
     GrB_Matrix operand;
 } AlgebraicExpressionOperand;
 
@@ -67,6 +71,7 @@ typedef struct {
     Node *src_node;                         // Nodes represented by the first operand columns.
     Node *dest_node;                        // Nodes represented by the last operand rows.
     Edge *edge;                             // Edge represented by sole operand.
+    const AST *ast;                         // AST expression was built from.
 } AlgebraicExpression;
 
 /* Constructs an empty expression. */
@@ -88,6 +93,14 @@ void AlgebraicExpression_AppendTerm(AlgebraicExpression *ae, GrB_Matrix m, bool
 /* Prepend m as the first term in the expression ae. */
 void AlgebraicExpression_PrependTerm(AlgebraicExpression *ae, GrB_Matrix m, bool transposeOp, bool freeOp, bool diagonal);
 
+/* Prepend operand as the first term in the expression ae. */
+void AlgebraicExpression_PrependOperand(AlgebraicExpression *ae, AlgebraicExpressionOperand op);
+
+/* Rebinds operands built from the query graph to the graph's current matrices,
+ * as graph matrices are replaced by writers, expressions held by a reused
+ * execution plan are rebound before evaluation. */
+void AlgebraicExpression_Rebind(AlgebraicExpression *ae);
+
 /* Removes operand at position idx */
 void AlgebraicExpression_RemoveTerm(AlgebraicExpression *ae, int idx, AlgebraicExpressionOperand *operand);
 
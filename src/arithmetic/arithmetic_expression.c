@@ -11,6 +11,7 @@
 #include "../util/rmalloc.h"
 #include "../graph/graphcontext.h"
 #include "../util/triemap/triemap.h"
+#include "../query_params.h"
 
 #include "assert.h"
 #include <math.h>
@@ -48,6 +49,14 @@ AR_ExpNode* AR_EXP_NewVariableOperandNode(const AST *ast, char *entity_prop, cha
     return node;
 }
 
+AR_ExpNode* AR_EXP_NewParamOperandNode(const char *param) {
+    AR_ExpNode *node = rm_calloc(1, sizeof(AR_ExpNode));
+    node->type = AR_EXP_OPERAND;
+    node->operand.type = AR_EXP_PARAM;
+    node->operand.param = rm_strdup(param);
+    return node;
+}
+
 AR_ExpNode* AR_EXP_NewOpNode(char *func_name, int child_count) {
     AR_ExpNode *node = rm_calloc(1, sizeof(AR_ExpNode));
     node->type = AR_EXP_OP;    
@@ -89,6 +98,8 @@ AR_ExpNode* AR_EXP_BuildFromAST(const AST *ast, const AST_ArithmeticExpressionNo
     } else {
         if(exp->operand.type == AST_AR_EXP_CONSTANT) {
             root = AR_EXP_NewConstOperandNode(exp->operand.constant);
+        } else if(exp->operand.type == AST_AR_EXP_PARAM) {
+            root = AR_EXP_NewParamOperandNode(exp->operand.param);
         } else {
             root = AR_EXP_NewVariableOperandNode(ast,
                                                   exp->operand.variadic.property,
@@ -116,6 +127,34 @@ void _AR_EXP_UpdatePropIdx(AR_ExpNode *root, const Record r) {
     root->operand.variadic.entity_prop_idx = GraphContext_GetAttributeID(gc, root->operand.variadic.entity_prop);
 }
 
+/* Reads node property from its label's property column.
+ * Returns false if the property isn't stored in a column. */
+static bool _AR_EXP_ReadColumn(const GraphEntity *ge, Attribute_ID attr_id,
+                               AR_ColumnSource *columns, SIValue *v) {
+    int schema_id = ge->entity->column_schema;
+    if(schema_id == NO_COLUMN_SCHEMA) return false;
+    if(!columns->gc) columns->gc = GraphContext_GetFromTLS();
+
+    // Nodes read by an expression usually share a label.
+    if(!columns->schema || columns->label != schema_id) {
+        columns->schema = GraphContext_GetSchemaByID(columns->gc, schema_id, SCHEMA_NODE);
+        columns->label = schema_id;
+    }
+    return PropertyColumn_Get(Schema_GetColumn(columns->schema, attr_id), ENTITY_GET_ID(ge), v);
+}
+
+SIValue AR_EXP_ReadProperty(const Record r, int idx, Attribute_ID attr_id,
+                            AR_ColumnSource *columns) {
+    GraphEntity *ge = Record_GetGraphEntity(r, idx);
+    // Values a column refused are held by the node itself.
+    SIValue *property = GraphEntity_GetProperty(ge, attr_id);
+    if(property != PROPERTY_NOTFOUND) return SI_ShallowCopy(*property);
+
+    SIValue result;
+    if(_AR_EXP_ReadColumn(ge, attr_id, columns, &result)) return result;
+    return SI_NullVal();
+}
+
 SIValue AR_EXP_Evaluate(AR_ExpNode *root, const Record r) {
     SIValue result;
     /* Deal with Operation node. */
@@ -138,16 +177,20 @@ SIValue AR_EXP_Evaluate(AR_ExpNode *root, const Record r) {
         /* Deal with a constant node. */
         if(root->operand.type == AR_EXP_CONSTANT) {
             result = root->operand.constant;
+        } else if(root->operand.type == AR_EXP_PARAM) {
+            // Parameters are validated before execution.
+            if(!QueryParams_Get(QueryParams_Bound(), root->operand.param, &result)) {
+                result = SI_NullVal();
+            }
         } else {
             // Fetch entity property value.
             if (root->operand.variadic.entity_prop != NULL) {
-                GraphEntity *ge = Record_GetGraphEntity(r, root->operand.variadic.entity_alias_idx);
                 if(root->operand.variadic.entity_prop_idx == ATTRIBUTE_NOTFOUND) {
                     _AR_EXP_UpdatePropIdx(root, r);
                 }
-                SIValue *property = GraphEntity_GetProperty(ge, root->operand.variadic.entity_prop_idx);
-                if(property == PROPERTY_NOTFOUND) result = SI_NullVal();
-                else result = SI_ShallowCopy(*property);
+                result = AR_EXP_ReadProperty(r, root->operand.variadic.entity_alias_idx,
+                                             root->operand.variadic.entity_prop_idx,
+                                             &root->operand.variadic.columns);
             } else {
                 // Alias doesn't necessarily refers to a graph entity,
                 // it could also be a constant.
@@ -199,6 +242,20 @@ void AR_EXP_Reduce(const AR_ExpNode *root) {
     }
 }
 
+void AR_EXP_Merge(const AR_ExpNode *root, const AR_ExpNode *other) {
+    if(root->type == AR_EXP_OP) {
+        if(root->op.type == AR_OP_AGGREGATE) {
+            /* Merge. */
+            Agg_Merge(root->op.agg_func, other->op.agg_func);
+        } else {
+            /* Keep searching for aggregation nodes. */
+            for(int i = 0; i < root->op.child_count; i++) {
+                AR_EXP_Merge(root->op.children[i], other->op.children[i]);
+            }
+        }
+    }
+}
+
 void AR_EXP_CollectAliases(AR_ExpNode *root, rax *aliases) {
     if (root->type == AR_EXP_OP) {
         for (int i = 0; i < root->op.child_count; i ++) {
@@ -288,6 +345,8 @@ void _AR_EXP_ToString(const AR_ExpNode *root, char **str, size_t *str_size, size
         if (root->operand.type == AR_EXP_CONSTANT) {
             size_t len = SIValue_ToString(root->operand.constant, (*str + *bytes_written), 64);
             *bytes_written += len;
+        } else if (root->operand.type == AR_EXP_PARAM) {
+            *bytes_written += snprintf((*str + *bytes_written), 64, "$%s", root->operand.param);
         } else {
             if (root->operand.variadic.entity_prop != NULL) {
                 *bytes_written += sprintf(
@@ -324,6 +383,10 @@ static AR_ExpNode* _AR_EXP_CloneOperand(AR_ExpNode* exp) {
             }
             clone->operand.variadic.entity_prop_idx = exp->operand.variadic.entity_prop_idx;
             break;
+        case AR_EXP_PARAM:
+            clone->operand.type = AR_EXP_PARAM;
+            clone->operand.param = rm_strdup(exp->operand.param);
+            break;
         default:
             assert(false);
             break;
@@ -368,6 +431,8 @@ void AR_EXP_Free(AR_ExpNode *root) {
     } else {
         if (root->operand.type == AR_EXP_CONSTANT) {
             SIValue_Free(&root->operand.constant);
+        } else if (root->operand.type == AR_EXP_PARAM) {
+            rm_free(root->operand.param);
         } else {
             if (root->operand.variadic.entity_alias) rm_free(root->operand.variadic.entity_alias);
             if (root->operand.variadic.entity_prop) rm_free(root->operand.variadic.entity_prop);
@@ -11,6 +11,7 @@
 #include "../parser/ast.h"
 #include "../../deps/rax/rax.h"
 #include "../graph/query_graph.h"
+#include "../graph/graphcontext.h"
 #include "../execution_plan/record.h"
 #include "../graph/entities/graph_entity.h"
 
@@ -30,10 +31,11 @@ typedef enum {
 } AR_OPType;
 
 /* AR_OperandNodeType type of leaf node,
- * either a constant: 3, or a variable: node.property. */
+ * either a constant: 3, a variable: node.property, or a parameter: $name. */
 typedef enum {
     AR_EXP_CONSTANT,
     AR_EXP_VARIADIC,
+    AR_EXP_PARAM,
 } AR_OperandNodeType;
 
 /* AR_Func - Function pointer to an operation with an arithmetic expression */
@@ -90,8 +92,19 @@ typedef struct {
     AR_OPType type;
 } AR_OpNode;
 
+/* AR_ColumnSource caches where a property expression reads property columns from,
+ * the graph context is resolved once and the schema is looked up again only
+ * when a node's columns belong to a different schema than the previous node read.
+ * Zero initialized. */
+typedef struct {
+    GraphContext *gc;   /* Graph context, NULL until first read. */
+    Schema *schema;     /* Schema holding columns, NULL until first read. */
+    int label;          /* ID of schema. */
+} AR_ColumnSource;
+
 /* OperandNode represents either a constant numeric value, 
- * or a graph entity property. */
+ * a graph entity property or a query parameter,
+ * parameters are resolved on evaluation against the bound query parameters. */
 typedef struct {
     union {
         SIValue constant;
@@ -100,7 +113,9 @@ typedef struct {
             int entity_alias_idx;
             char *entity_prop;
             Attribute_ID entity_prop_idx;
+            AR_ColumnSource columns;
         } variadic;
+        char *param;
     };
 	AR_OperandNodeType type;
 } AR_OperandNode;
@@ -125,7 +140,15 @@ int AR_EXP_GetOperandType(AR_ExpNode *exp);
 /* Evaluate arithmetic expression tree. */
 SIValue AR_EXP_Evaluate(AR_ExpNode *root, const Record r);
 void AR_EXP_Aggregate(const AR_ExpNode *root, const Record r);
+
+/* Reads property attr_id of the graph entity at position idx of record,
+ * returns NULL if entity doesn't have the property.
+ * Property columns are located through the caller's columns source. */
+SIValue AR_EXP_ReadProperty(const Record r, int idx, Attribute_ID attr_id,
+                            AR_ColumnSource *columns);
 void AR_EXP_Reduce(const AR_ExpNode *root);
+/* Merges aggregations of other, a clone of root, into root's aggregations. */
+void AR_EXP_Merge(const AR_ExpNode *root, const AR_ExpNode *other);
 
 /* Utility functions */
 /* Traverse an expression tree and add all graph entity aliases
@@ -146,6 +169,9 @@ AR_ExpNode* AR_EXP_NewConstOperandNode(SIValue constant);
 /* Construct a variable expression: n.v*/
 AR_ExpNode* AR_EXP_NewVariableOperandNode(const AST *ast, char *entity_prop, char *entity_alias);
 
+/* Construct a parameter expression: $name */
+AR_ExpNode* AR_EXP_NewParamOperandNode(const char *param);
+
 /* Construct an operation expression: toUpper(n.v) */
 AR_ExpNode* AR_EXP_NewOpNode(char *func_name, int child_count);
 
@@ -0,0 +1,329 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./arithmetic_program.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../query_params.h"
+#include "../parser/grammar.h"
+#include "../graph/graphcontext.h"
+
+#include <assert.h>
+
+static inline bool _AR_CompareInt(int64_t a, int64_t b, int op) {
+    switch(op) {
+        case EQ: return a == b;
+        case NE: return a != b;
+        case GT: return a > b;
+        case GE: return a >= b;
+        case LT: return a < b;
+        case LE: return a <= b;
+        default: assert(false);
+    }
+    return false;
+}
+
+static inline bool _AR_CompareDouble(double a, double b, int op) {
+    switch(op) {
+        case EQ: return a == b;
+        case NE: return a != b;
+        case GT: return a > b;
+        case GE: return a >= b;
+        case LT: return a < b;
+        case LE: return a <= b;
+        default: assert(false);
+    }
+    return false;
+}
+
+/* Tests if a and b maintain relation op,
+ * values of disjoint types only pass inequality. */
+static inline bool _AR_Compare(SIValue a, SIValue b, int op) {
+    // Fast path, same typed numerics.
+    if(a.type == b.type) {
+        if(a.type == T_INT64) return _AR_CompareInt(a.longval, b.longval, op);
+        if(a.type == T_DOUBLE) return _AR_CompareDouble(a.doubleval, b.doubleval, op);
+    }
+
+    int rel = SIValue_Compare(a, b);
+    if(rel == DISJOINT) return (op == NE);
+    return _AR_CompareInt(rel, 0, op);
+}
+
+/* Returns operator op' such that b op' a equals a op b. */
+static int _AR_FlipCompare(int op) {
+    switch(op) {
+        case GT: return LT;
+        case GE: return LE;
+        case LT: return GT;
+        case LE: return GE;
+        default: return op;
+    }
+}
+
+static void _AR_PropOperand_Resolve(AR_PropOperand *prop) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    prop->attr_id = GraphContext_GetAttributeID(gc, prop->attr_name);
+    prop->attr_count = array_len(gc->string_mapping);
+}
+
+static inline SIValue _AR_PropOperand_Read(AR_PropOperand *prop, const Record r) {
+    /* Attribute might be introduced after compilation,
+     * e.g. MATCH (n) SET n.v = 1 WITH n WHERE n.v = 1 RETURN n
+     * look it up again only if new attributes were added. */
+    if(prop->attr_id == ATTRIBUTE_NOTFOUND) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        if(array_len(gc->string_mapping) != prop->attr_count) _AR_PropOperand_Resolve(prop);
+    }
+    return AR_EXP_ReadProperty(r, prop->entity_idx, prop->attr_id, &prop->columns);
+}
+
+AR_Program* AR_Program_New(void) {
+    AR_Program *p = rm_malloc(sizeof(AR_Program));
+    p->code = array_new(AR_Instr, 8);
+    p->code_len = 0;
+    p->folded = array_new(SIValue, 0);
+    p->stack = NULL;
+    p->depth = 0;
+    p->max_depth = 0;
+    return p;
+}
+
+uint AR_Program_Emit(AR_Program *p, AR_Instr instr) {
+    switch(instr.code) {
+        case AR_INSTR_PUSH_CONST:
+        case AR_INSTR_PUSH_PARAM:
+        case AR_INSTR_PUSH_ENTRY:
+        case AR_INSTR_PUSH_PROP:
+        case AR_INSTR_PUSH_AGG:
+            p->depth++;
+            break;
+        case AR_INSTR_CALL:
+            p->depth -= instr.call.argc - 1;
+            break;
+        case AR_INSTR_CMP:
+            p->depth -= 2;
+            break;
+        default:
+            break;
+    }
+
+    if(p->depth > p->max_depth) {
+        p->max_depth = p->depth;
+        p->stack = rm_realloc(p->stack, sizeof(SIValue) * p->max_depth);
+    }
+
+    p->code = array_append(p->code, instr);
+    return p->code_len++;
+}
+
+uint AR_Program_Offset(const AR_Program *p) {
+    return p->code_len;
+}
+
+/* Removes last count instructions, all of which push a value. */
+static void _AR_Program_DropPushes(AR_Program *p, uint count) {
+    p->code_len -= count;
+    p->code = array_trimm_len(p->code, p->code_len);
+    p->depth -= count;
+}
+
+static uint _AR_Program_EmitConst(AR_Program *p, SIValue v) {
+    AR_Instr instr = {.code = AR_INSTR_PUSH_CONST, .constant = v};
+    return AR_Program_Emit(p, instr);
+}
+
+bool AR_Program_CompileExpression(AR_Program *p, const AR_ExpNode *exp) {
+    AR_Instr instr = {0};
+
+    if(exp->type == AR_EXP_OPERAND) {
+        switch(exp->operand.type) {
+            case AR_EXP_CONSTANT:
+                _AR_Program_EmitConst(p, exp->operand.constant);
+                return true;
+            case AR_EXP_PARAM:
+                // Parameters vary between executions of a cached plan.
+                instr.code = AR_INSTR_PUSH_PARAM;
+                instr.param = exp->operand.param;
+                break;
+            case AR_EXP_VARIADIC:
+                if(exp->operand.variadic.entity_prop) {
+                    instr.code = AR_INSTR_PUSH_PROP;
+                    instr.prop.entity_idx = exp->operand.variadic.entity_alias_idx;
+                    instr.prop.attr_name = exp->operand.variadic.entity_prop;
+                    _AR_PropOperand_Resolve(&instr.prop);
+                } else {
+                    instr.code = AR_INSTR_PUSH_ENTRY;
+                    instr.entry_idx = exp->operand.variadic.entity_alias_idx;
+                }
+                break;
+            default:
+                assert(false);
+        }
+        AR_Program_Emit(p, instr);
+        return false;
+    }
+
+    // Aggregation functions are reduced by the time they're evaluated.
+    if(exp->op.type == AR_OP_AGGREGATE) {
+        instr.code = AR_INSTR_PUSH_AGG;
+        instr.agg = exp->op.agg_func;
+        AR_Program_Emit(p, instr);
+        return false;
+    }
+
+    int argc = exp->op.child_count;
+    bool constant = (exp->op.f != AR_RAND);
+    for(int i = 0; i < argc; i++) {
+        constant &= AR_Program_CompileExpression(p, exp->op.children[i]);
+    }
+
+    if(!constant) {
+        instr.code = AR_INSTR_CALL;
+        instr.call.f = exp->op.f;
+        instr.call.argc = argc;
+        AR_Program_Emit(p, instr);
+        return false;
+    }
+
+    /* All arguments are constants, each pushed by a single instruction,
+     * replace them with the function's result. */
+    SIValue argv[argc];
+    uint offset = AR_Program_Offset(p) - argc;
+    for(int i = 0; i < argc; i++) argv[i] = p->code[offset + i].constant;
+    _AR_Program_DropPushes(p, argc);
+
+    SIValue v = exp->op.f(argv, argc);
+    if(v.allocation == M_SELF) {
+        p->folded = array_append(p->folded, v);
+        v = SI_ShallowCopy(v);
+    }
+    _AR_Program_EmitConst(p, v);
+    return true;
+}
+
+/* Appends code setting pass flag to lhs op rhs,
+ * comparisons of a property against a constant are fused into a single
+ * instruction, comparisons of constants are computed ahead. */
+void AR_Program_CompileComparison(AR_Program *p, const AR_ExpNode *lhs,
+                                  const AR_ExpNode *rhs, int op) {
+    uint lhs_offset = AR_Program_Offset(p);
+    bool lhs_const = AR_Program_CompileExpression(p, lhs);
+    uint rhs_offset = AR_Program_Offset(p);
+    bool rhs_const = AR_Program_CompileExpression(p, rhs);
+    uint end = AR_Program_Offset(p);
+
+    AR_Instr instr = {.cmp = op};
+    AR_Instr *l = p->code + lhs_offset;
+    AR_Instr *r = p->code + rhs_offset;
+    bool single = (rhs_offset - lhs_offset == 1 && end - rhs_offset == 1);
+
+    if(lhs_const && rhs_const) {
+        instr.code = AR_INSTR_SET_PASS;
+        instr.pass = _AR_Compare(l->constant, r->constant, op);
+        _AR_Program_DropPushes(p, 2);
+    } else if(single && l->code == AR_INSTR_PUSH_PROP && rhs_const) {
+        instr.code = AR_INSTR_CMP_PROP_CONST;
+        instr.prop = l->prop;
+        instr.constant = r->constant;
+        _AR_Program_DropPushes(p, 2);
+    } else if(single && lhs_const && r->code == AR_INSTR_PUSH_PROP) {
+        instr.code = AR_INSTR_CMP_PROP_CONST;
+        instr.cmp = _AR_FlipCompare(op);
+        instr.prop = r->prop;
+        instr.constant = l->constant;
+        _AR_Program_DropPushes(p, 2);
+    } else {
+        instr.code = AR_INSTR_CMP;
+    }
+
+    AR_Program_Emit(p, instr);
+}
+
+AR_Program* AR_EXP_Compile(const AR_ExpNode *exp) {
+    AR_Program *p = AR_Program_New();
+    AR_Program_CompileExpression(p, exp);
+    return p;
+}
+
+static bool _AR_Program_Run(AR_Program *p, const Record r) {
+    SIValue *stack = p->stack;
+    const AR_Instr *code = p->code;
+    uint len = p->code_len;
+    uint sp = 0;
+    uint pc = 0;
+    bool pass = false;
+
+    while(pc < len) {
+        const AR_Instr *instr = code + pc++;
+        switch(instr->code) {
+            case AR_INSTR_PUSH_CONST:
+                stack[sp++] = instr->constant;
+                break;
+            case AR_INSTR_PUSH_PARAM:
+                // Parameters are validated before execution.
+                if(!QueryParams_Get(QueryParams_Bound(), instr->param, stack + sp)) {
+                    stack[sp] = SI_NullVal();
+                }
+                sp++;
+                break;
+            case AR_INSTR_PUSH_ENTRY:
+                stack[sp++] = Record_Get(r, instr->entry_idx);
+                break;
+            case AR_INSTR_PUSH_PROP:
+                stack[sp++] = _AR_PropOperand_Read((AR_PropOperand*)&instr->prop, r);
+                break;
+            case AR_INSTR_PUSH_AGG:
+                stack[sp++] = instr->agg->result;
+                break;
+            case AR_INSTR_CALL:
+                sp -= instr->call.argc;
+                stack[sp] = instr->call.f(stack + sp, instr->call.argc);
+                sp++;
+                break;
+            case AR_INSTR_CMP:
+                sp -= 2;
+                pass = _AR_Compare(stack[sp], stack[sp + 1], instr->cmp);
+                break;
+            case AR_INSTR_CMP_PROP_CONST:
+                pass = _AR_Compare(_AR_PropOperand_Read((AR_PropOperand*)&instr->prop, r),
+                                   instr->constant, instr->cmp);
+                break;
+            case AR_INSTR_SET_PASS:
+                pass = instr->pass;
+                break;
+            case AR_INSTR_JUMP_IF_FAIL:
+                if(!pass) pc = instr->target;
+                break;
+            case AR_INSTR_JUMP_IF_PASS:
+                if(pass) pc = instr->target;
+                break;
+            default:
+                assert(false);
+        }
+    }
+
+    return pass;
+}
+
+SIValue AR_Program_Evaluate(AR_Program *p, const Record r) {
+    assert(p->depth == 1);
+    _AR_Program_Run(p, r);
+    return p->stack[0];
+}
+
+bool AR_Program_Test(AR_Program *p, const Record r) {
+    return _AR_Program_Run(p, r);
+}
+
+void AR_Program_Free(AR_Program *p) {
+    uint folded_count = array_len(p->folded);
+    for(uint i = 0; i < folded_count; i++) SIValue_Free(&p->folded[i]);
+    array_free(p->folded);
+    array_free(p->code);
+    rm_free(p->stack);
+    rm_free(p);
+}
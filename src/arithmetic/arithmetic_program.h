@@ -0,0 +1,99 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __ARITHMETIC_PROGRAM_H
+#define __ARITHMETIC_PROGRAM_H
+
+#include "./arithmetic_expression.h"
+
+/* Arithmetic programs are arithmetic expressions (and filter trees)
+ * compiled into a flat sequence of instructions, evaluated by a
+ * stack machine. Compilation folds constant sub-expressions and
+ * resolves attribute IDs, such that evaluation doesn't need to
+ * walk the expression tree or look attributes up per record. */
+
+/* AR_InstrCode lists the instructions of an arithmetic program. */
+typedef enum {
+    AR_INSTR_PUSH_CONST,        /* Push constant. */
+    AR_INSTR_PUSH_PARAM,        /* Push bound query parameter. */
+    AR_INSTR_PUSH_ENTRY,        /* Push record entry. */
+    AR_INSTR_PUSH_PROP,         /* Push graph entity property. */
+    AR_INSTR_PUSH_AGG,          /* Push aggregation function result. */
+    AR_INSTR_CALL,              /* Pop arguments, push function result. */
+    AR_INSTR_CMP,               /* Pop two values, set pass flag to their comparison. */
+    AR_INSTR_CMP_PROP_CONST,    /* Set pass flag to the comparison of a property with a constant. */
+    AR_INSTR_SET_PASS,          /* Set pass flag to a constant. */
+    AR_INSTR_JUMP_IF_FAIL,      /* Jump to target if pass flag is off. */
+    AR_INSTR_JUMP_IF_PASS,      /* Jump to target if pass flag is on. */
+} AR_InstrCode;
+
+/* Property accessed by PUSH_PROP and CMP_PROP_CONST. */
+typedef struct {
+    int entity_idx;             /* Graph entity position within record. */
+    Attribute_ID attr_id;       /* Resolved attribute ID. */
+    const char *attr_name;      /* Attribute name, used to resolve unknown attributes. */
+    uint attr_count;            /* Number of attributes when attr_id was resolved. */
+    AR_ColumnSource columns;    /* Property columns location. */
+} AR_PropOperand;
+
+typedef struct {
+    AR_InstrCode code;
+    int cmp;                    /* Comparison operator (EQ, GT, ...) of CMP instructions. */
+    union {
+        SIValue constant;       /* PUSH_CONST, CMP_PROP_CONST. */
+        const char *param;      /* PUSH_PARAM. */
+        int entry_idx;          /* PUSH_ENTRY. */
+        AggCtx *agg;            /* PUSH_AGG. */
+        bool pass;              /* SET_PASS. */
+        uint target;            /* JUMP_IF_FAIL, JUMP_IF_PASS. */
+        struct {
+            AR_Func f;
+            int argc;
+        } call;                 /* CALL. */
+    };
+    AR_PropOperand prop;        /* PUSH_PROP, CMP_PROP_CONST. */
+} AR_Instr;
+
+typedef struct {
+    AR_Instr *code;             /* Instructions. */
+    uint code_len;              /* Number of instructions. */
+    SIValue *folded;            /* Values owned by program, produced by constant folding. */
+    SIValue *stack;             /* Evaluation stack. */
+    uint depth;                 /* Stack depth at end of code. */
+    uint max_depth;             /* Maximal stack depth. */
+} AR_Program;
+
+/* Creates an empty program. */
+AR_Program* AR_Program_New(void);
+
+/* Appends instruction to program, returns its offset. */
+uint AR_Program_Emit(AR_Program *p, AR_Instr instr);
+
+/* Returns offset of next emitted instruction. */
+uint AR_Program_Offset(const AR_Program *p);
+
+/* Appends code pushing the value of exp.
+ * Returns true if exp was folded into a constant, in which case
+ * the last emitted instruction pushes it. */
+bool AR_Program_CompileExpression(AR_Program *p, const AR_ExpNode *exp);
+
+/* Appends code setting the pass flag to the comparison lhs op rhs. */
+void AR_Program_CompileComparison(AR_Program *p, const AR_ExpNode *lhs,
+                                  const AR_ExpNode *rhs, int op);
+
+/* Compiles arithmetic expression into a program. */
+AR_Program* AR_EXP_Compile(const AR_ExpNode *exp);
+
+/* Evaluates program against record, returns the value at the top of the stack. */
+SIValue AR_Program_Evaluate(AR_Program *p, const Record r);
+
+/* Evaluates program against record, returns its pass flag. */
+bool AR_Program_Test(AR_Program *p, const Record r);
+
+/* Free program. */
+void AR_Program_Free(AR_Program *p);
+
+#endif
@@ -55,7 +55,7 @@ static Attribute_ID* _BulkInsert_ReadHeader(GraphContext *gc, SchemaType t,
 }
 
 // Read an SIValue from the data stream and update the index appropriately
-static inline SIValue _BulkInsert_ReadProperty(const char *data, size_t *data_idx) {
+static inline SIValue _BulkInsert_ReadProperty(GraphContext *gc, const char *data, size_t *data_idx) {
     /* Binary property format:
      * - property type : 1-byte integer corresponding to TYPE enum
      * - Nothing if type is NULL
@@ -79,10 +79,10 @@ static inline SIValue _BulkInsert_ReadProperty(const char *data, size_t *data_id
         *data_idx += sizeof(double);
         v = SI_DoubleVal(d);
     } else if (t == BI_STRING) {
-        char *s = rm_strdup(data + *data_idx);
+        const char *s = data + *data_idx;
         *data_idx += strlen(s) + 1;
-        // Ownership of the string will be passed to the GraphEntity properties
-        v = SI_TransferStringVal(s);
+        // The GraphEntity properties will hold an interned copy of the string
+        v = GraphContext_InternValue(gc, SI_ConstStringVal((char*)s));
     } else {
         assert(0);
     }
@@ -95,14 +95,16 @@ int _BulkInsert_ProcessNodeFile(RedisModuleCtx *ctx, GraphContext *gc, const cha
     int label_id;
     unsigned int prop_count;
     Attribute_ID *prop_indicies = _BulkInsert_ReadHeader(gc, SCHEMA_NODE, data, &data_idx, &label_id, &prop_count);
+    Schema *s = GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
 
     while (data_idx < data_len) {
         Node n;
         Graph_CreateNode(gc->g, label_id, &n);
         for (unsigned int i = 0; i < prop_count; i++) {
-            SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
+            SIValue value = _BulkInsert_ReadProperty(gc, data, &data_idx);
             GraphEntity_AddProperty((GraphEntity*)&n, prop_indicies[i], value);
         }
+        Schema_AddNodeToColumns(s, &n);
     }
 
     free(prop_indicies);
@@ -134,7 +136,7 @@ int _BulkInsert_ProcessRelationFile(RedisModuleCtx *ctx, GraphContext *gc, const
 
         // Process and add relation properties
         for (unsigned int i = 0; i < prop_count; i ++) {
-            SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
+            SIValue value = _BulkInsert_ReadProperty(gc, data, &data_idx);
             GraphEntity_AddProperty((GraphEntity*)&e, prop_indicies[i], value);
         }
     }
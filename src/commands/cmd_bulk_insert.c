@@ -79,7 +79,9 @@ void _MGraph_BulkInsert(void *args) {
         initial_node_count = Graph_NodeCount(gc->g);
     }
 
-    // Lock the graph for writing.
+    // Lock the graph for writing, once a background fold is done.
+    Graph_WriterEnter(gc->g);
+    Graph_AwaitFold(gc->g);
     Graph_AcquireWriteLock(gc->g);
 
     // Disable matrix synchronization for bulk insert operation
@@ -92,6 +94,8 @@ void _MGraph_BulkInsert(void *args) {
 
     if (rc == BULK_FAIL) {
         // If insertion failed, clean up keyspace and free added entities.
+        Graph_SetMatrixPolicy(gc->g, DISABLED);
+        Graph_WriterLeave(gc->g);
         key = RedisModule_OpenKey(ctx, rs_graph_name, REDISMODULE_WRITE);
         RedisModule_DeleteKey(key);
         gc = NULL;
@@ -104,7 +108,10 @@ void _MGraph_BulkInsert(void *args) {
     RedisModule_ReplyWithStringBuffer(ctx, reply, len);
 
 cleanup:
-    if (gc) Graph_ReleaseLock(gc->g);
+    if (gc) {
+        Graph_ReleaseLock(gc->g);
+        Graph_WriterLeave(gc->g);
+    }
     CommandCtx_ThreadSafeContextUnlock(context);
     CommandCtx_Free(context);
 }
@@ -15,6 +15,8 @@ CommandCtx* CommandCtx_New
     context->bc = bc;
     context->ctx = ctx;
     context->ast = ast;    
+    context->query = NULL;
+    context->params = NULL;
     context->argv = argv;
     context->argc = argc;
     context->graphName = NULL;
@@ -57,6 +59,8 @@ void CommandCtx_Free(CommandCtx* qctx) {
     }
 
     if(qctx->ast) AST_Free(qctx->ast);
+    if(qctx->query) rm_free(qctx->query);
+    QueryParams_Free(qctx->params);
     if(qctx->graphName) rm_free(qctx->graphName);
     rm_free(qctx);
 }
@@ -9,12 +9,15 @@
 
 #include "../redismodule.h"
 #include "../parser/ast.h"
+#include "../query_params.h"
 
 /* Query context, used for concurent query processing. */
 typedef struct {
     RedisModuleCtx *ctx;            // Redis module context.
     RedisModuleBlockedClient *bc;   // Blocked client.
     AST **ast;                      // Parsed AST.
+    char *query;                    // Query text, excluding parameters.
+    QueryParams *params;            // Query parameters.
     char *graphName;                // Graph ID.
     double tic[2];                  // Timings.
     RedisModuleString **argv;       // Arguments.
@@ -37,11 +37,15 @@ void _MGraph_Delete(void *args) {
     // Retrieve the GraphContext to disable synchronization.
     GraphContext *gc = RedisModule_ModuleTypeGetValue(key);
     
-    // Acquire write lock, guarantee we're the only thread executing.
+    /* Hold writers back and let a background fold finish,
+     * then acquire write lock, guarantee we're the only thread executing. */
+    Graph_WriterEnter(gc->g);
+    Graph_AwaitFold(gc->g);
     Graph_AcquireWriteLock(gc->g);
 
-    // Disable matrix synchronization for graph deletion.
+    // Disable matrix synchronization for graph deletion, no further folds are scheduled.
     Graph_SetMatrixPolicy(gc->g, DISABLED);
+    Graph_WriterLeave(gc->g);
 
     // Remove GraphContext from keyspace.
     if(RedisModule_DeleteKey(key) == REDISMODULE_OK) {
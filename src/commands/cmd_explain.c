@@ -9,6 +9,7 @@
 #include "../index/index.h"
 #include "../util/rmalloc.h"
 #include "../query_executor.h"
+#include "../query_params.h"
 #include "../execution_plan/execution_plan.h"
 
 extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
@@ -18,11 +19,14 @@ GraphContext* _empty_graph_context() {
     gc = rm_malloc(sizeof(GraphContext));
     gc->g = Graph_New(1, 1);
     gc->index_count = 0;
+    gc->schema_version = 0;
     gc->attributes = NULL;
     gc->node_schemas = NULL;
     gc->string_mapping = NULL;
     gc->relation_schemas = NULL;
     gc->graph_name = rm_strdup("");
+    gc->string_pool = NULL;
+    gc->plan_cache = NULL;
 
     pthread_setspecific(_tlsGCKey, gc);
     return gc;
@@ -94,8 +98,18 @@ int MGraph_Explain(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
         query = RedisModule_StringPtrLen(argv[2], NULL);
     }
 
-    /* Parse query, get AST. */
+    /* Skip query parameters, plan construction doesn't depend on their values. */
     char *errMsg = NULL;
+    QueryParams *params = NULL;
+    query = QueryParams_Parse(query, &params, &errMsg);
+    if(!query) {
+        RedisModule_ReplyWithError(ctx, errMsg);
+        free(errMsg);
+        return REDISMODULE_OK;
+    }
+    QueryParams_Free(params);
+
+    /* Parse query, get AST. */
     AST** ast = ParseQuery(query, strlen(query), &errMsg);
     if(!ast) {
         RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
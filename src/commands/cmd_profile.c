@@ -62,6 +62,8 @@ void _MGraph_Profile(void *args) {
     if (AST_PerformValidations(ctx, ast) != AST_VALID) goto cleanup;
     ModifyAST(ast);
     if (AST_PerformValidations(ctx, ast) != AST_VALID) goto cleanup;
+    if (AST_ValidateParams(ctx, ast, qctx->params) != AST_VALID) goto cleanup;
+    QueryParams_Bind(qctx->params);
 
     // Acquire the appropriate lock.
     if(readonly) Graph_AcquireReadLock(gc->g);
@@ -81,13 +83,15 @@ void _MGraph_Profile(void *args) {
 
 cleanup:
     // Release the read-write lock
-    if(lockAcquired) {
-        if(readonly)Graph_ReleaseLock(gc->g);
-        else Graph_WriterLeave(gc->g);
-    }
+    if(lockAcquired && readonly) Graph_ReleaseLock(gc->g);
+    QueryParams_Bind(NULL);
 
     ResultSet_Free(resultSet);
     CommandCtx_Free(qctx);
+
+    /* Let the next writer in, matrix additions are
+     * folded in the background once enough accumulate. */
+    if(lockAcquired && !readonly) Graph_WriterLeave(gc->g);
 }
 
 /* Profiles query
@@ -97,19 +101,29 @@ cleanup:
 int MGraph_Profile(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
     if (argc < 3) return RedisModule_WrongArity(ctx);
 
-    // Parse AST.
+    // Split query parameters from query.
     char *errMsg = NULL;    
+    QueryParams *params = NULL;
     const char *query = RedisModule_StringPtrLen(argv[2], NULL);
+    query = QueryParams_Parse(query, &params, &errMsg);
+    if (!query) {
+        RedisModule_ReplyWithError(ctx, errMsg);
+        free(errMsg);
+        return REDISMODULE_OK;
+    }
 
+    // Parse AST.
     AST **ast = ParseQuery(query, strlen(query), &errMsg);
     if (!ast) {
         RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
         RedisModule_ReplyWithError(ctx, errMsg);
         free(errMsg);
+        QueryParams_Free(params);
         return REDISMODULE_OK;
     }
     if(AST_Empty(ast[0])) {
         AST_Free(ast);
+        QueryParams_Free(params);
         RedisModule_ReplyWithError(ctx, "Error empty query.");
         return REDISMODULE_OK;
     }
@@ -124,11 +138,13 @@ int MGraph_Profile(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
     if (flags & (REDISMODULE_CTX_FLAGS_MULTI | REDISMODULE_CTX_FLAGS_LUA)) {
         // Run query on Redis main thread.
         context = CommandCtx_New(ctx, NULL, ast, argv[1], argv, argc);
+        context->params = params;
         _MGraph_Profile(context);
     } else {
         // Run query on a dedicated thread.
         RedisModuleBlockedClient *bc = RedisModule_BlockClient(ctx, NULL, NULL, NULL, 0);
         context = CommandCtx_New(NULL, bc, ast, argv[1], argv, argc);
+        context->params = params;
         thpool_add_work(_thpool, _MGraph_Profile, context);
     }
 
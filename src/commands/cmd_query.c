@@ -10,9 +10,27 @@
 #include "../query_executor.h"
 #include "../util/simple_timer.h"
 #include "../execution_plan/execution_plan.h"
+#include "../execution_plan/plan_cache.h"
+#include "../execution_plan/ops/op_aggregate.h"
+#include "../graph/serializers/graphcontext_type.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 
+// Returns a comma separated list of properties.
+static char* _join_properties(char **properties) {
+    size_t len = 1;
+    uint property_count = array_len(properties);
+    for(uint i = 0; i < property_count; i++) len += strlen(properties[i]) + 2;
+
+    char *joined = malloc(len);
+    joined[0] = '\0';
+    for(uint i = 0; i < property_count; i++) {
+        if(i > 0) strcat(joined, ", ");
+        strcat(joined, properties[i]);
+    }
+    return joined;
+}
+
 static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST_IndexNode *indexNode) {
     /* Set up nested array response for index creation and deletion,
      * Following the response struture of other queries:
@@ -23,9 +41,26 @@ static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST_IndexNod
     RedisModule_ReplyWithArray(ctx, 0); // Empty result-set
     RedisModule_ReplyWithArray(ctx, 2); // Statistics.
 
+  // Multiple properties are indexed by a single composite index.
+  const char **properties = (const char**)indexNode->properties;
+  uint property_count = array_len(indexNode->properties);
+  bool composite = (property_count > 1);
+  bool edge = (indexNode->entity_type == N_LINK);
+  IndexType type = IDX_BTREE;
+  if (indexNode->index_type == HASH_INDEX) type = IDX_HASH;
+  else if (indexNode->index_type == SKIPLIST_INDEX) type = IDX_SKIPLIST;
+  int res;
+
   switch(indexNode->operation) {
     case CREATE_INDEX:
-      if (GraphContext_AddIndex(gc, indexNode->label, indexNode->property) != INDEX_OK) {
+      if (composite && type == IDX_HASH) {
+        RedisModule_ReplyWithError(ctx, "ERR Hash indices cover a single property.");
+        break;
+      }
+      if (edge) res = GraphContext_AddEdgeIndex(gc, indexNode->label, properties[0], type);
+      else if (composite) res = GraphContext_AddCompositeIndex(gc, indexNode->label, properties, property_count, type);
+      else res = GraphContext_AddIndex(gc, indexNode->label, properties[0], type);
+      if (res != INDEX_OK) {
         // Index creation may have failed if the label or property was invalid, or the index already exists.
         RedisModule_ReplyWithSimpleString(ctx, "(no changes, no records)");
         break;
@@ -33,12 +68,18 @@ static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST_IndexNod
       RedisModule_ReplyWithSimpleString(ctx, "Indices added: 1");
       break;
     case DROP_INDEX:
-      if (GraphContext_DeleteIndex(gc, indexNode->label, indexNode->property) == INDEX_OK) {
+      if (edge) res = GraphContext_DeleteEdgeIndex(gc, indexNode->label, properties[0]);
+      else if (composite) res = GraphContext_DeleteCompositeIndex(gc, indexNode->label, properties, property_count);
+      else res = GraphContext_DeleteIndex(gc, indexNode->label, properties[0]);
+      if (res == INDEX_OK) {
         RedisModule_ReplyWithSimpleString(ctx, "Indices removed: 1");
       } else {
         char *reply;
-        asprintf(&reply, "ERR Unable to drop index on :%s(%s): no such index.", indexNode->label, indexNode->property);
+        char *joined = _join_properties(indexNode->properties);
+        if (edge) asprintf(&reply, "ERR Unable to drop index on [:%s](%s): no such index.", indexNode->label, joined);
+        else asprintf(&reply, "ERR Unable to drop index on :%s(%s): no such index.", indexNode->label, joined);
         RedisModule_ReplyWithError(ctx, reply);
+        free(joined);
         free(reply);
       }
       break;
@@ -47,11 +88,25 @@ static void _index_operation(RedisModuleCtx *ctx, GraphContext *gc, AST_IndexNod
   }
 }
 
-static inline bool _check_compact_flag(CommandCtx *qctx) {
-    // The only additional argument to check currently is whether the query results
-    // should be returned in compact form
-    return (qctx->argc > 3 &&
-            !strcasecmp(RedisModule_StringPtrLen(qctx->argv[3], NULL), "--compact"));
+/* Parses additional query arguments:
+ * --compact, query results should be returned in compact form.
+ * --aggregate-threads N, number of threads aggregating a node scan for this query.
+ * Returns false if arguments are malformed. */
+static bool _parse_query_args(CommandCtx *qctx, bool *compact, long long *aggregate_threads) {
+    *compact = false;
+    *aggregate_threads = 0;
+
+    for(int i = 3; i < qctx->argc; i++) {
+        const char *arg = RedisModule_StringPtrLen(qctx->argv[i], NULL);
+        if(!strcasecmp(arg, "--compact")) {
+            *compact = true;
+        } else if(!strcasecmp(arg, "--aggregate-threads")) {
+            if(++i == qctx->argc) return false;
+            if(RedisModule_StringToLongLong(qctx->argv[i], aggregate_threads) != REDISMODULE_OK ||
+               *aggregate_threads < 1) return false;
+        }
+    }
+    return true;
 }
 
 static ResultSet* _prepare_resultset(RedisModuleCtx *ctx, AST **ast, bool compact) {
@@ -62,19 +117,99 @@ static ResultSet* _prepare_resultset(RedisModuleCtx *ctx, AST **ast, bool compac
     return set;
 }
 
+// Only read-only queries are cached, as their plans can be re-executed.
+static inline bool _cacheable(AST **ast) {
+    return (PlanCache_Capacity() > 0 &&
+            AST_ReadOnly(ast) &&
+            !ast[0]->indexNode &&
+            !ast[0]->callNode);
+}
+
+/* Checks if query is cached for graph, called from Redis main thread
+ * as the graph can't be deleted while we hold the global lock. */
+static bool _query_cached(RedisModuleCtx *ctx, RedisModuleString *graphName, const char *query) {
+    if(PlanCache_Capacity() == 0) return false;
+
+    bool cached = false;
+    RedisModuleKey *key = RedisModule_OpenKey(ctx, graphName, REDISMODULE_READ);
+    if(RedisModule_ModuleTypeGetType(key) == GraphContextRedisModuleType) {
+        GraphContext *gc = RedisModule_ModuleTypeGetValue(key);
+        cached = PlanCache_Contains(gc->plan_cache, query);
+    }
+    RedisModule_CloseKey(key);
+    return cached;
+}
+
+/* Retrieves a validated AST for query,
+ * either from query's cache entry or by validating the parsed query.
+ * Returns NULL if query is invalid, in which case client was replied to. */
+static AST **_prepare_ast(RedisModuleCtx *ctx, CommandCtx *qctx, PlanCacheEntry **entry) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    AST **ast = qctx->ast;
+
+    // Query is expected to be cached, or was cached before.
+    if(!ast || _cacheable(ast)) {
+        *entry = PlanCache_Acquire(gc->plan_cache, qctx->query);
+        if((*entry)->ast) return (*entry)->ast;
+    }
+
+    // Entry was evicted after we've checked for it.
+    if(!ast) {
+        char *errMsg = NULL;
+        ast = ParseQuery(qctx->query, strlen(qctx->query), &errMsg);
+        assert(ast);
+        qctx->ast = ast;
+    }
+
+    // Perform query validations before and after ModifyAST
+    if (AST_PerformValidations(ctx, ast) != AST_VALID) return NULL;
+    ModifyAST(ast);
+    if (AST_PerformValidations(ctx, ast) != AST_VALID) return NULL;
+
+    // Hand AST over to cache entry.
+    if(*entry) {
+        (*entry)->ast = ast;
+        qctx->ast = NULL;
+    }
+    return ast;
+}
+
+/* Retrieves an execution plan for query, reusing cached plan
+ * if no label or relation type was introduced since it was built,
+ * reused plans are rebound to the graph's current matrices. */
+static ExecutionPlan *_prepare_plan(RedisModuleCtx *ctx, AST **ast, ResultSet *resultSet,
+                                    PlanCacheEntry *entry) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    uint64_t version = __atomic_load_n(&gc->schema_version, __ATOMIC_SEQ_CST);
+    if(!entry) return NewExecutionPlan(ctx, ast, resultSet, false);
+
+    if(entry->plan && !entry->plan->disposable && entry->schema_version == version) {
+        ExecutionPlan_Reset(entry->plan, resultSet);
+        return entry->plan;
+    }
+
+    // Plan is stale, build a new one.
+    ExecutionPlanFree(entry->plan);
+    entry->plan = NewExecutionPlan(ctx, ast, resultSet, false);
+    entry->schema_version = version;
+    return entry->plan;
+}
+
 void _MGraph_Query(void *args) {
     CommandCtx *qctx = (CommandCtx*)args;
     RedisModuleCtx *ctx = CommandCtx_GetRedisCtx(qctx);
     ResultSet* resultSet = NULL;
+    PlanCacheEntry *entry = NULL;
     AST **ast = qctx->ast;
-    bool readonly = AST_ReadOnly(ast);
+    // Query wasn't parsed only if it is cached, cached queries are read-only.
+    bool readonly = (ast) ? AST_ReadOnly(ast) : true;
     bool lockAcquired = false;
 
     // Try to access the GraphContext
     CommandCtx_ThreadSafeContextLock(qctx);
     GraphContext *gc = GraphContext_Retrieve(ctx, qctx->graphName, readonly);
     if(!gc) {
-        if(!ast[0]->createNode && !ast[0]->mergeNode) {
+        if(!ast || (!ast[0]->createNode && !ast[0]->mergeNode)) {
             CommandCtx_ThreadSafeContextUnlock(qctx);
             RedisModule_ReplyWithError(ctx, "key doesn't contains a graph object.");
             goto cleanup;
@@ -90,15 +225,21 @@ void _MGraph_Query(void *args) {
         /* TODO: free graph if no entities were created. */
     }
 
-    bool compact = _check_compact_flag(qctx);
+    bool compact;
+    long long aggregate_threads;
+    if(!_parse_query_args(qctx, &compact, &aggregate_threads)) {
+        CommandCtx_ThreadSafeContextUnlock(qctx);
+        RedisModule_ReplyWithError(ctx, "--aggregate-threads expects a positive thread count.");
+        goto cleanup;
+    }
 
     CommandCtx_ThreadSafeContextUnlock(qctx);
 
-    // Perform query validations before and after ModifyAST
-    if (AST_PerformValidations(ctx, ast) != AST_VALID) goto cleanup;
-
-    ModifyAST(ast);
-    if (AST_PerformValidations(ctx, ast) != AST_VALID) goto cleanup;
+    ast = _prepare_ast(ctx, qctx, &entry);
+    if(!ast) goto cleanup;
+    if(AST_ValidateParams(ctx, ast, qctx->params) != AST_VALID) goto cleanup;
+    QueryParams_Bind(qctx->params);
+    Aggregate_BindThreadCount(aggregate_threads);
 
     // Acquire the appropriate lock.
     if(readonly) Graph_AcquireReadLock(gc->g);
@@ -109,9 +250,9 @@ void _MGraph_Query(void *args) {
         _index_operation(ctx, gc, ast[0]->indexNode);
     } else {
         resultSet = _prepare_resultset(ctx, ast, compact);
-        ExecutionPlan *plan = NewExecutionPlan(ctx, ast, resultSet, false);
+        ExecutionPlan *plan = _prepare_plan(ctx, ast, resultSet, entry);
         ExecutionPlan_Execute(plan);
-        ExecutionPlanFree(plan);
+        if(!entry) ExecutionPlanFree(plan);
         ResultSet_Replay(resultSet);    // Send result-set back to client.
     }
 
@@ -124,14 +265,21 @@ void _MGraph_Query(void *args) {
 
     // Clean up.
 cleanup:
+    /* Return query to cache, keeping its AST and plan for the next execution,
+     * done while holding the read lock as graph deletion waits for it. */
+    if(entry) PlanCache_Release(gc->plan_cache, entry);
+    QueryParams_Bind(NULL);
+    Aggregate_BindThreadCount(0);
+
     // Release the read-write lock
-    if(lockAcquired) {
-        if(readonly)Graph_ReleaseLock(gc->g);
-        else Graph_WriterLeave(gc->g);
-    }
+    if(lockAcquired && readonly) Graph_ReleaseLock(gc->g);
 
     ResultSet_Free(resultSet);
     CommandCtx_Free(qctx);
+
+    /* Let the next writer in, matrix additions are
+     * folded in the background once enough accumulate. */
+    if(lockAcquired && !readonly) Graph_WriterLeave(gc->g);
 }
 
 /* Queries graph
@@ -144,24 +292,39 @@ int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
     
     simple_tic(tic);
 
-    // Parse AST.
+    // Split query parameters from query.
     char *errMsg = NULL;    
+    QueryParams *params = NULL;
     const char *query = RedisModule_StringPtrLen(argv[2], NULL);
-
-    AST **ast = ParseQuery(query, strlen(query), &errMsg);
-    if (!ast) {
-        RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
+    query = QueryParams_Parse(query, &params, &errMsg);
+    if (!query) {
         RedisModule_ReplyWithError(ctx, errMsg);
         free(errMsg);
         return REDISMODULE_OK;
     }
-    if(AST_Empty(ast[0])) {
-        AST_Free(ast);
-        RedisModule_ReplyWithError(ctx, "Error empty query.");
-        return REDISMODULE_OK;
-    }
 
-    bool readonly = AST_ReadOnly(ast);
+    /* Cached queries are valid and read-only, skip parsing,
+     * the executing thread will parse query if it was evicted meanwhile. */
+    AST **ast = NULL;
+    bool readonly = true;
+    if(!_query_cached(ctx, argv[1], query)) {
+        // Parse AST.
+        ast = ParseQuery(query, strlen(query), &errMsg);
+        if (!ast) {
+            RedisModule_Log(ctx, "debug", "Error parsing query: %s", errMsg);
+            RedisModule_ReplyWithError(ctx, errMsg);
+            free(errMsg);
+            QueryParams_Free(params);
+            return REDISMODULE_OK;
+        }
+        if(AST_Empty(ast[0])) {
+            AST_Free(ast);
+            QueryParams_Free(params);
+            RedisModule_ReplyWithError(ctx, "Error empty query.");
+            return REDISMODULE_OK;
+        }
+        readonly = AST_ReadOnly(ast);
+    }
 
     /* Determin query execution context
      * queries issued within a LUA script or multi exec block must
@@ -173,6 +336,8 @@ int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
       context = CommandCtx_New(ctx, NULL, ast, argv[1], argv, argc);
       context->tic[0] = tic[0];
       context->tic[1] = tic[1];
+      context->query = rm_strdup(query);
+      context->params = params;
       _MGraph_Query(context);
     } else {
       // Run query on a dedicated thread.
@@ -180,6 +345,8 @@ int MGraph_Query(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
       context = CommandCtx_New(NULL, bc, ast, argv[1], argv, argc);
       context->tic[0] = tic[0];
       context->tic[1] = tic[1];
+      context->query = rm_strdup(query);
+      context->params = params;
       thpool_add_work(_thpool, _MGraph_Query, context);
     }
 
@@ -5,6 +5,11 @@
 */
 
 #include "config.h"
+#include "execution_plan/plan_cache.h"
+#include "execution_plan/ops/op_value_hash_join.h"
+#include "execution_plan/traverse_batch.h"
+#include "execution_plan/ops/op_aggregate.h"
+#include "execution_plan/ops/op_distinct.h"
 #include <unistd.h>
 #include <string.h>
 #include <assert.h>
@@ -38,3 +43,167 @@ long long Config_GetThreadCount(RedisModuleCtx *ctx, RedisModuleString **argv, i
 
     return threadCount;
 }
+
+bool Config_GetColumnarLayout(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    bool columnar = false;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for COLUMNAR_LAYOUT.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, COLUMNAR_LAYOUT) == 0) {
+                const char *value = RedisModule_StringPtrLen(argv[i+1], NULL);
+                columnar = (strcasecmp(value, "yes") == 0);
+                break;
+            }
+        }
+    }
+
+    return columnar;
+}
+
+long long Config_GetQueryCacheSize(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long cacheSize = PLAN_CACHE_DEFAULT_CAP;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for QUERY_CACHE_SIZE.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, QUERY_CACHE_SIZE) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &cacheSize);
+                break;
+            }
+        }
+    }
+
+    if(cacheSize < 0) {
+        RedisModule_Log(ctx, "warning", "Invalid query cache size: %lld, disabling query cache.", cacheSize);
+        cacheSize = 0;
+    }
+
+    return cacheSize;
+}
+
+long long Config_GetJoinMemoryLimit(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long memoryLimit = VALUE_HASH_JOIN_DEFAULT_MEMORY_LIMIT;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for JOIN_MEMORY_LIMIT.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, JOIN_MEMORY_LIMIT) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &memoryLimit);
+                break;
+            }
+        }
+    }
+
+    if(memoryLimit < 0) {
+        RedisModule_Log(ctx, "warning", "Invalid join memory limit: %lld, disabling join spilling.", memoryLimit);
+        memoryLimit = 0;
+    }
+
+    return memoryLimit;
+}
+
+long long Config_GetTraverseBatchCap(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long batchCap = TRAVERSE_BATCH_DEFAULT_CAP;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for TRAVERSE_BATCH_CAP.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, TRAVERSE_BATCH_CAP) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &batchCap);
+                break;
+            }
+        }
+    }
+
+    if(batchCap < 1) {
+        RedisModule_Log(ctx, "warning", "Invalid traverse batch cap: %lld, using default.", batchCap);
+        batchCap = TRAVERSE_BATCH_DEFAULT_CAP;
+    }
+
+    return batchCap;
+}
+
+long long Config_GetAggregateThreadCount(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long threadCount = AGGREGATE_DEFAULT_THREAD_COUNT;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for AGGREGATE_THREAD_COUNT.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, AGGREGATE_THREAD_COUNT) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &threadCount);
+                break;
+            }
+        }
+    }
+
+    if(threadCount < 1) {
+        RedisModule_Log(ctx, "warning", "Invalid aggregate thread count: %lld, using default.", threadCount);
+        threadCount = AGGREGATE_DEFAULT_THREAD_COUNT;
+    }
+
+    return threadCount;
+}
+
+long long Config_GetParallelAggregateThreshold(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long threshold = AGGREGATE_DEFAULT_PARALLEL_THRESHOLD;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for PARALLEL_AGGREGATE_THRESHOLD.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, PARALLEL_AGGREGATE_THRESHOLD) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &threshold);
+                break;
+            }
+        }
+    }
+
+    if(threshold < 0) {
+        RedisModule_Log(ctx, "warning", "Invalid parallel aggregate threshold: %lld, using default.", threshold);
+        threshold = AGGREGATE_DEFAULT_PARALLEL_THRESHOLD;
+    }
+
+    return threshold;
+}
+
+long long Config_GetDistinctMemoryLimit(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
+    // Default.
+    long long memoryLimit = DISTINCT_DEFAULT_MEMORY_LIMIT;
+
+    // Expecting configuration to be in the form of key value pairs.
+    if(argc%2 == 0) {
+        // Scan arguments for DISTINCT_MEMORY_LIMIT.
+        for(int i = 0; i < argc; i+=2) {
+            const char *param = RedisModule_StringPtrLen(argv[i], NULL);
+            if(strcasecmp(param, DISTINCT_MEMORY_LIMIT) == 0) {
+                RedisModule_StringToLongLong(argv[i+1], &memoryLimit);
+                break;
+            }
+        }
+    }
+
+    if(memoryLimit < 0) {
+        RedisModule_Log(ctx, "warning", "Invalid distinct memory limit: %lld, disabling distinct spilling.", memoryLimit);
+        memoryLimit = 0;
+    }
+
+    return memoryLimit;
+}
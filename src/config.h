@@ -7,9 +7,17 @@
 #ifndef _REDISGRAPH_CONFIG_
 #define _REDISGRAPH_CONFIG_
 
+#include <stdbool.h>
 #include "redismodule.h"
 
 #define THREAD_COUNT "THREAD_COUNT" // Config param, number of threads in thread pool
+#define COLUMNAR_LAYOUT "COLUMNAR_LAYOUT" // Config param, store node properties in per-label columns
+#define QUERY_CACHE_SIZE "QUERY_CACHE_SIZE" // Config param, number of cached queries per graph
+#define JOIN_MEMORY_LIMIT "JOIN_MEMORY_LIMIT" // Config param, bytes a join may cache before spilling to disk
+#define TRAVERSE_BATCH_CAP "TRAVERSE_BATCH_CAP" // Config param, max number of nodes a traversal expands at once
+#define AGGREGATE_THREAD_COUNT "AGGREGATE_THREAD_COUNT" // Config param, number of threads aggregating a node scan
+#define PARALLEL_AGGREGATE_THRESHOLD "PARALLEL_AGGREGATE_THRESHOLD" // Config param, min scanned nodes for parallel aggregation
+#define DISTINCT_MEMORY_LIMIT "DISTINCT_MEMORY_LIMIT" // Config param, bytes a distinct may hold before spilling to disk
 
 // Tries to fetch number of threads from
 // command line arguments if specified
@@ -21,4 +29,71 @@ long long Config_GetThreadCount (
     int argc
 );
 
+// Tries to fetch columnar layout switch from
+// command line arguments if specified ("yes" / "no"),
+// otherwise returns false.
+bool Config_GetColumnarLayout (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch number of queries cached per graph from
+// command line arguments if specified,
+// otherwise returns default cache size.
+// 0 disables query caching.
+long long Config_GetQueryCacheSize (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch the number of bytes a single join operation
+// may hold in memory from command line arguments if specified,
+// otherwise returns default limit.
+// 0 disables spilling to disk.
+long long Config_GetJoinMemoryLimit (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch the maximum number of source nodes a traversal
+// evaluates at once from command line arguments if specified,
+// otherwise returns default cap.
+long long Config_GetTraverseBatchCap (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch the number of threads a single aggregation
+// splits its node scan between from command line arguments if specified,
+// otherwise returns default thread count.
+// 1 disables parallel aggregation.
+long long Config_GetAggregateThreadCount (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch the minimal number of scanned nodes
+// for which aggregation runs in parallel from command line arguments
+// if specified, otherwise returns default threshold.
+long long Config_GetParallelAggregateThreshold (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
+// Tries to fetch the number of bytes a single distinct operation
+// may hold in memory from command line arguments if specified,
+// otherwise returns default limit.
+// 0 disables spilling to disk.
+long long Config_GetDistinctMemoryLimit (
+    RedisModuleCtx *ctx,
+    RedisModuleString **argv,
+    int argc
+);
+
 #endif
@@ -10,6 +10,7 @@
 #include "./ops/ops.h"
 #include "../util/arr.h"
 #include "../util/vector.h"
+#include "../util/simple_timer.h"
 #include "../query_executor.h"
 #include "../graph/entities/edge.h"
 #include "./optimizations/optimizer.h"
@@ -219,6 +220,8 @@ static bool inline _TapOperation(const OpBase *op) {
     return (op->type == OPType_ALL_NODE_SCAN ||
        op->type == OPType_NODE_BY_LABEL_SCAN ||
        op->type == OPType_INDEX_SCAN ||
+       op->type == OPType_ORDERED_INDEX_SCAN ||
+       op->type == OPType_EDGE_INDEX_SEEK ||
        op->type == OPType_CREATE ||
        op->type == OPType_UNWIND ||
        op->type == OPType_PROC_CALL);
@@ -419,11 +422,12 @@ ExecutionPlan* _NewExecutionPlan(RedisModuleCtx *ctx, AST *ast, ResultSet *resul
                 size_t expCount = 0;
                 AlgebraicExpression **exps = AlgebraicExpression_From_QueryGraph(cc, ast, &expCount);
 
-                // Reorder exps, to the most performent arrangement of evaluation.
-                orderExpressions(exps, expCount, execution_plan->filter_tree);
+                /* Reorder exps, to the most performent arrangement of evaluation,
+                 * estimated number of rows produced by each operation is reported by EXPLAIN. */
+                double estimates[expCount + 1];
+                orderExpressions(exps, expCount, execution_plan->filter_tree, gc, estimates);
 
                 AlgebraicExpression *exp = exps[0];
-                selectEntryPoint(exp, execution_plan->filter_tree);
 
                 // Create SCAN operation.
                 if(exp->src_node->label) {
@@ -439,6 +443,7 @@ ExecutionPlan* _NewExecutionPlan(RedisModuleCtx *ctx, AST *ast, ResultSet *resul
                 } else {
                     op = NewAllNodeScanOp(g, exp->src_node, ast);
                 }
+                op->estimated_rows = estimates[0];
 
                 Vector_Push(traversals, op);
                 _UpdateResolvedVariables(resolved, op);
@@ -472,6 +477,7 @@ ExecutionPlan* _NewExecutionPlan(RedisModuleCtx *ctx, AST *ast, ResultSet *resul
                     else {
                         op = NewCondTraverseOp(exp, ast);
                     }
+                    op->estimated_rows = estimates[i + 1];
 
                     Vector_Push(traversals, op);
                     _UpdateResolvedVariables(resolved, op);
@@ -501,6 +507,30 @@ ExecutionPlan* _NewExecutionPlan(RedisModuleCtx *ctx, AST *ast, ResultSet *resul
             Vector_Clear(traversals);
         }
         Vector_Free(traversals);
+
+        // Shortest paths are computed once both of their endpoints are resolved.
+        Vector *entities = ast->matchNode->_mergedPatterns;
+        for(int i = 0; i < Vector_Size(entities); i++) {
+            AST_GraphEntity *entity;
+            Vector_Get(entities, i, &entity);
+            if(entity->t != N_LINK) continue;
+
+            AST_LinkEntity *link = (AST_LinkEntity*)entity;
+            if(link->selector == N_PATH_ALL) continue;
+
+            AST_GraphEntity *l_entity;
+            AST_GraphEntity *r_entity;
+            Vector_Get(entities, i-1, &l_entity);
+            Vector_Get(entities, i+1, &r_entity);
+            if(link->direction == N_RIGHT_TO_LEFT) {
+                AST_GraphEntity *t = l_entity;
+                l_entity = r_entity;
+                r_entity = t;
+            }
+
+            op = NewShortestPathOp(g, ast, link, l_entity->alias, r_entity->alias);
+            Vector_Push(ops, op);
+        }
     }
 
     if(ast->unwindNode) {
@@ -567,12 +597,12 @@ ExecutionPlan* _NewExecutionPlan(RedisModuleCtx *ctx, AST *ast, ResultSet *resul
     }
 
     if(ast->skipNode) {
-        OpBase *op_skip = NewSkipOp(ast->skipNode->skip);
+        OpBase *op_skip = NewSkipOp(ast->skipNode);
         Vector_Push(ops, op_skip);
     }
 
     if(ast->limitNode) {
-        OpBase *op_limit = NewLimitOp(ast->limitNode->limit);
+        OpBase *op_limit = NewLimitOp(ast->limitNode);
         Vector_Push(ops, op_limit);
     }
 
@@ -642,6 +672,7 @@ static ExecutionPlan *_ExecutionPlan_Connect(ExecutionPlan *a, ExecutionPlan *b,
     array_free(taps);
     // Null root to avoid freeing connected operations.
     a->root = NULL;
+    b->disposable |= a->disposable;
 
     // Copy connected components over.
     if(a->connected_components) {
@@ -664,6 +695,8 @@ static ExecutionPlan *_ExecutionPlan_Connect(ExecutionPlan *a, ExecutionPlan *b,
 ExecutionPlan* NewExecutionPlan(RedisModuleCtx *ctx, AST **ast, ResultSet *result_set, bool explain) {
     ExecutionPlan *plan = NULL;
     ExecutionPlan *curr_plan;
+    double tic[2];
+    simple_tic(tic);
 
     for(unsigned int i = 0; i < array_len(ast); i++) {
         curr_plan = _NewExecutionPlan(ctx, ast[i], result_set);
@@ -697,6 +730,7 @@ ExecutionPlan* NewExecutionPlan(RedisModuleCtx *ctx, AST **ast, ResultSet *resul
         optimizePlan(plan, ast[i]);
     }
 
+    plan->planning_time = simple_toc(tic) * 1000;
     return plan;
 }
 
@@ -727,33 +761,72 @@ void ExecutionPlan_Print(const ExecutionPlan *plan, RedisModuleCtx *ctx) {
     // No idea how many operation are in execution plan.
     RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
     _ExecutionPlan_Print(plan->root, ctx, buffer, 1024, 0, &op_count);
+
+    // Profiled plans report planning time and record allocations.
+    if(plan->root->stats) {
+        int bytes_written = snprintf(buffer, 1024, "Planning time: %f ms", plan->planning_time);
+        RedisModule_ReplyWithStringBuffer(ctx, buffer, bytes_written);
+        op_count++;
+    }
+    if(plan->record_pool && plan->root->stats) {
+        int bytes_written = snprintf(buffer, 1024,
+                                     "Record pool | Records allocated: %llu, Records reused: %llu",
+                                     (unsigned long long)plan->record_pool->allocated,
+                                     (unsigned long long)plan->record_pool->reused);
+        RedisModule_ReplyWithStringBuffer(ctx, buffer, bytes_written);
+        op_count++;
+    }
     RedisModule_ReplySetArrayLength(ctx, op_count);
 }
 
-void _ExecutionPlanInit(OpBase *root) {
+void _ExecutionPlanInit(OpBase *root, RecordPool *pool) {
+    root->record_pool = pool;
     if(root->init) root->init(root);
     for(int i = 0; i < root->childCount; i++) {
-        _ExecutionPlanInit(root->children[i]);
+        _ExecutionPlanInit(root->children[i], pool);
     }
 }
 
 void ExecutionPlanInit(ExecutionPlan *plan) {
     if(!plan) return;
-    _ExecutionPlanInit(plan->root);
+    // Operations are initialized once, reused plans are reset instead.
+    if(plan->record_pool) return;
+    // Operations draw their records from a pool shared across the plan.
+    plan->record_pool = RecordPool_New();
+    _ExecutionPlanInit(plan->root, plan->record_pool);
 }
 
 ResultSet* ExecutionPlan_Execute(ExecutionPlan *plan) {
-    Record r;
     OpBase *op = plan->root;
-    
+    RecordBatch *batch = RecordBatch_New();
+
     ExecutionPlanInit(plan);
-    while((r = OpBase_Consume(op)) != NULL) Record_Free(r);
+    // Pull batches of records through the plan.
+    while(OpBase_ConsumeBatch(op, batch)) RecordBatch_Clear(batch);
+
+    RecordBatch_Free(batch);
     return plan->result_set;
 }
 
+void ExecutionPlan_Reset(ExecutionPlan *plan, ResultSet *result_set) {
+    assert(plan);
+    plan->result_set = result_set;
+    Results *results = (Results*)ExecutionPlan_LocateOp(plan->root, OPType_RESULTS);
+    if(results) results->result_set = result_set;
+    OpBase_Reset(plan->root);
+    // Matrices might have been replaced and the graph grown since the plan was executed.
+    OpBase_Rebind(plan->root);
+}
+
 static void _ExecutionPlan_InitProfiling(OpBase *root) {
     root->profile = root->consume;
     root->consume = OpBase_Profile;
+    /* Operations without a native batch implementation
+     * are profiled through their consume function. */
+    if(root->consumeBatch != OpBase_ConsumeRowsAsBatch) {
+        root->profileBatch = root->consumeBatch;
+        root->consumeBatch = OpBase_ProfileBatch;
+    }
     root->stats = rm_malloc(sizeof(OpStats));
     root->stats->profileExecTime = 0;
     root->stats->profileRecordCount = 0;
@@ -800,5 +873,7 @@ void ExecutionPlanFree(ExecutionPlan *plan) {
         }
         array_free(plan->connected_components);
     }
+    // Operations are freed, no record refers to pool.
+    if(plan->record_pool) RecordPool_Free(plan->record_pool);
     free(plan);
 }
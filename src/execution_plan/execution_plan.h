@@ -27,6 +27,9 @@ typedef struct {
     ResultSet *result_set;
     FT_FilterNode *filter_tree;
     QueryGraph **connected_components;
+    RecordPool *record_pool;    // Recycles records produced by plan's operations.
+    double planning_time;       // Time spent constructing plan in ms.
+    bool disposable;            // Plan embeds graph state (e.g. reduced counts) and can't be reused.
 } ExecutionPlan;
 
 /* Creates a new execution plan from AST */
@@ -71,6 +74,11 @@ void ExecutionPlan_Taps(OpBase *root, OpBase ***taps);
 /* Executes plan */
 ResultSet* ExecutionPlan_Execute(ExecutionPlan *plan);
 
+/* Prepares an executed plan for re-execution,
+ * resets plan's operations, rebinds them to the graph's current matrices
+ * and directs results to result_set. */
+void ExecutionPlan_Reset(ExecutionPlan *plan, ResultSet *result_set);
+
 /* Profile executes plan */
 ResultSet* ExecutionPlan_Profile(ExecutionPlan *plan);
 
@@ -16,12 +16,17 @@ void OpBase_Init(OpBase *op) {
     op->children = NULL;
     op->parent = NULL;
     op->stats = NULL;
+    op->record_pool = NULL;
+    op->estimated_rows = -1;
     
     // Function pointers.
     op->init = NULL;
     op->free = NULL;
     op->reset = NULL;
+    op->rebind = NULL;
     op->consume = NULL;
+    op->consumeBatch = OpBase_ConsumeRowsAsBatch;
+    op->profileBatch = NULL;
     op->toString = NULL;
 }
 
@@ -29,11 +34,30 @@ inline Record OpBase_Consume(OpBase *op) {
     return op->consume(op);
 }
 
+inline uint OpBase_ConsumeBatch(OpBase *op, RecordBatch *batch) {
+    assert(batch->count == 0);
+    return op->consumeBatch(op, batch);
+}
+
+uint OpBase_ConsumeRowsAsBatch(OpBase *op, RecordBatch *batch) {
+    Record r;
+    while(!RecordBatch_Full(batch) && (r = OpBase_Consume(op))) {
+        RecordBatch_Add(batch, r);
+    }
+    return batch->count;
+}
+
 void OpBase_Reset(OpBase *op) {
-    assert(op->reset(op) == OP_OK);
+    OpResult res = op->reset(op);
+    assert(res == OP_OK);
     for(int i = 0; i < op->childCount; i++) OpBase_Reset(op->children[i]);
 }
 
+void OpBase_Rebind(OpBase *op) {
+    if(op->rebind) op->rebind(op);
+    for(int i = 0; i < op->childCount; i++) OpBase_Rebind(op->children[i]);
+}
+
 static int _OpBase_StatsToString(const OpBase *op, char *buff, uint buff_len) {
     return snprintf(buff, buff_len,
                     " | Records produced: %d, Execution time: %f ms",
@@ -47,6 +71,11 @@ int OpBase_ToString(const OpBase *op, char *buff, uint buff_len) {
     if(op->toString) bytes_written = op->toString(op, buff, buff_len);
     else bytes_written = snprintf(buff, buff_len, "%s", op->name);
 
+    if(op->estimated_rows >= 0) {
+        bytes_written += snprintf(buff + bytes_written, buff_len - bytes_written,
+                                  " | Estimated rows: %.0f", op->estimated_rows);
+    }
+
     if(op->stats) {
         bytes_written += _OpBase_StatsToString(op,
                                               buff + bytes_written,
@@ -67,6 +96,21 @@ Record OpBase_Profile(OpBase *op) {
     return r;
 }
 
+uint OpBase_ProfileBatch(OpBase *op, RecordBatch *batch) {
+    double tic [2];
+    // Start timer.
+    simple_tic(tic);
+    uint count = op->profileBatch(op, batch);
+    // Stop timer and accumulate.
+    op->stats->profileExecTime += simple_toc(tic);
+    op->stats->profileRecordCount += count;
+    return count;
+}
+
+Record OpBase_CreateRecord(const OpBase *op, int entries) {
+    return Record_NewPooled(op->record_pool, entries);
+}
+
 void OpBase_Free(OpBase *op) {
     // Free internal operation
     op->free(op);
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "../record.h"
+#include "../record_batch.h"
+#include "../record_pool.h"
 #include "../../redismodule.h"
 #include "../../graph/query_graph.h"
 #include "../../graph/entities/node.h"
@@ -43,9 +45,13 @@ typedef enum {
     OPType_PROC_CALL = (1<<22),
     OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO = (1<<23),
     OPType_VALUE_HASH_JOIN = (1<<24),
+    OPType_VAR_LEN_REACH = (1<<25),
+    OPType_SHORTEST_PATH = (1<<26),
+    OPType_ORDERED_INDEX_SCAN = (1<<27),
+    OPType_EDGE_INDEX_SEEK = (1<<28),
 } OPType;
 
-#define OP_SCAN (OPType_ALL_NODE_SCAN | OPType_NODE_BY_LABEL_SCAN | OPType_INDEX_SCAN | OPType_NODE_BY_ID_SEEK)
+#define OP_SCAN (OPType_ALL_NODE_SCAN | OPType_NODE_BY_LABEL_SCAN | OPType_INDEX_SCAN | OPType_NODE_BY_ID_SEEK | OPType_ORDERED_INDEX_SCAN | OPType_EDGE_INDEX_SEEK)
 
 typedef enum {
     OP_DEPLETED = 1,
@@ -59,7 +65,9 @@ struct OpBase;
 typedef void (*fpFree)(struct OpBase*);
 typedef OpResult (*fpInit)(struct OpBase*);
 typedef Record (*fpConsume)(struct OpBase*);
+typedef uint (*fpConsumeBatch)(struct OpBase*, RecordBatch*);
 typedef OpResult (*fpReset)(struct OpBase*);
+typedef void (*fpRebind)(struct OpBase*);
 typedef int (*fpToString)(const struct OpBase*, char *, uint);
 
 // Execution plan operation statistics.
@@ -73,7 +81,10 @@ struct OpBase {
     fpInit init;                // Called once before execution.
     fpConsume consume;          // Produce next record.
     fpConsume profile;          // Profiled version of consume.
+    fpConsumeBatch consumeBatch;    // Produce next batch of records.
+    fpConsumeBatch profileBatch;    // Profiled version of consumeBatch.
     fpReset reset;              // Reset operation state.
+    fpRebind rebind;            // Refresh graph state (matrices, dimensions) captured by operation.
     fpFree free;                // Free operation.
     fpToString toString;        // operation string representation.
     char *name;                 // Operation name.
@@ -82,12 +93,28 @@ struct OpBase {
     int childCount;             // Number of children.
     OpStats *stats;             // Profiling statistics.
     struct OpBase *parent;      // Parent operations.
+    RecordPool *record_pool;    // Execution plan's record pool.
+    double estimated_rows;      // Planner's estimate of rows produced, negative if not estimated.
 };
 typedef struct OpBase OpBase;
 
 void OpBase_Init(OpBase *op);       // Initialize op.
 void OpBase_Free(OpBase *op);       // Free op.
 void OpBase_Reset(OpBase *op);      // Reset op.
+void OpBase_Rebind(OpBase *op);     // Rebind op to the graph's current state.
 Record OpBase_Consume(OpBase *op);  // Consume op.
 Record OpBase_Profile(OpBase *op);  // Profile op.
+
+/* Consume a batch of records from op into an empty batch,
+ * returns number of records produced, 0 once op is depleted. */
+uint OpBase_ConsumeBatch(OpBase *op, RecordBatch *batch);
+
+/* Default consumeBatch for operations without a native batch implementation,
+ * fills batch by repeatedly calling op's consume function. */
+uint OpBase_ConsumeRowsAsBatch(OpBase *op, RecordBatch *batch);
+
+uint OpBase_ProfileBatch(OpBase *op, RecordBatch *batch);   // Profile op batch consumption.
+
+// Create a new record capable of holding N entries from op's record pool.
+Record OpBase_CreateRecord(const OpBase *op, int entries);
 int OpBase_ToString(const OpBase *op, char *buff, uint buff_len);
@@ -6,11 +6,36 @@
 
 #include "op_aggregate.h"
 #include "op_sort.h"
+#include "op_filter.h"
+#include "op_all_node_scan.h"
+#include "op_node_by_label_scan.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
 #include "../../grouping/group.h"
+#include "../../query_params.h"
 #include "../../query_executor.h"
+#include "../../graph/graphcontext.h"
 #include "../../arithmetic/aggregate.h"
+#include "../../arithmetic/arithmetic_program.h"
+
+#include <pthread.h>
+#include <sys/param.h>
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+static uint _thread_count = AGGREGATE_DEFAULT_THREAD_COUNT;
+static uint64_t _parallel_threshold = AGGREGATE_DEFAULT_PARALLEL_THRESHOLD;
+// Thread count of the query executed by the calling thread, 0 if unset.
+static __thread uint _query_thread_count = 0;
+
+void Aggregate_SetParallelism(uint thread_count, uint64_t threshold) {
+    _thread_count = MAX(thread_count, 1);
+    _parallel_threshold = threshold;
+}
+
+void Aggregate_BindThreadCount(uint thread_count) {
+    _query_thread_count = thread_count;
+}
 
 static AR_ExpNode** _getOrderExpressions(OpBase *op) {
     if(op == NULL) return NULL;
@@ -59,7 +84,7 @@ static AR_ExpNode** _build_aggregated_expressions(OpAggregate *op) {
     return agg_exps;
 }
 
-static Group* _CreateGroup(OpAggregate *op, Record r) {
+static Group* _CreateGroup(OpAggregate *op, AggregateGroups *groups, Record r, uint64_t hash) {
     /* Create a new group
      * Get a fresh copy of aggregation functions. */
     AR_ExpNode **agg_exps = _build_aggregated_expressions(op);
@@ -69,16 +94,15 @@ static Group* _CreateGroup(OpAggregate *op, Record r) {
     SIValue *group_keys = rm_malloc(sizeof(SIValue) * key_count);
 
     for(uint i = 0; i < key_count; i++) {
-        SIValue key = op->group_keys[i];
+        SIValue key = groups->keys[i];
         SIValue_Persist(&key);
         group_keys[i] = key;
     }
 
     /* There's no need to keep a reference to record if we're not sorting groups. */
-    if(!op->order_exps) op->group = NewGroup(key_count, group_keys, agg_exps, NULL);
-    else op->group = NewGroup(key_count, group_keys, agg_exps, r);
-
-    return op->group;
+    if(!op->order_exps) r = NULL;
+    groups->group = CacheGroupAdd(groups->groups, hash, key_count, group_keys, agg_exps, r);
+    return groups->group;
 }
 
 static void _ComputeGroupKey(OpAggregate *op, Record r) {
@@ -86,70 +110,33 @@ static void _ComputeGroupKey(OpAggregate *op, Record r) {
 
     for(uint i = 0; i < expCount; i++) {
         AR_ExpNode *exp = op->none_aggregated_expressions[i];
-        op->group_keys[i] = AR_EXP_Evaluate(exp, r);
+        op->groups.keys[i] = AR_EXP_Evaluate(exp, r);
     }
 }
 
-static void _ComputeGroupKeyStr(OpAggregate *op, char **key) {
-    uint none_agg_exp_count = array_len(op->none_aggregated_expressions);
-    if(none_agg_exp_count == 0) {
-        *key = rm_strdup("SINGLE_GROUP");
-        return;
-    }
-
-    // Determine required size for group key string representation.
-    size_t key_len = SIValue_StringConcatLen(op->group_keys, none_agg_exp_count);
-    *key = rm_malloc(sizeof(char) * key_len);
-    SIValue_StringConcat(op->group_keys, none_agg_exp_count, *key, key_len);
-}
-
 /* Retrieves group under which given record belongs to,
- * creates group if one doesn't exists. */
-static Group* _GetGroup(OpAggregate *op, Record r) {
-    char *group_key_str;
-    // Construct group key.
-    _ComputeGroupKey(op, r);
-
-    // First group created.
-    if(!op->group) {
-        op->group = _CreateGroup(op, r);
-        Group_KeyStr(op->group, &group_key_str);
-        CacheGroupAdd(op->groups, group_key_str, op->group);
-        rm_free(group_key_str);
-        return op->group;
-    }
-
-    // Evaluate none-aggregated fields, see if they match
-    // the last accessed group.
-    bool reuseLastAccessedGroup = true;
-    uint expCount = array_len(op->none_aggregated_expressions);
-    for(uint i = 0; i < expCount; i++) {
-        if( reuseLastAccessedGroup &&
-            SIValue_Compare(op->group->keys[i], op->group_keys[i]) == 0 ) {
-            reuseLastAccessedGroup = true;
-        } else {
-            reuseLastAccessedGroup = false;
-        }
-    }
+ * creates group if one doesn't exists, expects groups->keys
+ * to hold the record's group key. */
+static Group* _GetGroup(OpAggregate *op, AggregateGroups *groups, Record r) {
+    uint key_count = array_len(op->none_aggregated_expressions);
 
     // See if we can reuse last accessed group.
-    if(reuseLastAccessedGroup) return op->group;
+    if(groups->group && Group_KeysEqual(groups->group->keys, groups->keys, key_count)) {
+        return groups->group;
+    }
 
-    // Can't reuse last accessed group, lookup group by identifier key.
-    _ComputeGroupKeyStr(op, &group_key_str);
-    op->group = CacheGroupGet(op->groups, group_key_str);
-    if(op->group) return op->group;
+    // Can't reuse last accessed group, lookup group by its keys.
+    uint64_t hash = Group_HashKeys(groups->keys, key_count);
+    groups->group = CacheGroupGet(groups->groups, hash, groups->keys, key_count);
+    if(groups->group) return groups->group;
 
     // Group does not exists, create it.
-    op->group = _CreateGroup(op, r);
-    CacheGroupAdd(op->groups, group_key_str, op->group);
-    rm_free(group_key_str);
-    return op->group;
+    return _CreateGroup(op, groups, r, hash);
 }
 
-static void _aggregateRecord(OpAggregate *op, Record r) {
+static void _aggregateGroupedRecord(OpAggregate *op, AggregateGroups *groups, Record r) {
     /* Get group */
-    Group* group = _GetGroup(op, r);
+    Group* group = _GetGroup(op, groups, r);
     assert(group);
 
     // Aggregate group expressions.
@@ -164,14 +151,226 @@ static void _aggregateRecord(OpAggregate *op, Record r) {
     Record_Free(r);
 }
 
+static void _aggregateRecord(OpAggregate *op, Record r) {
+    // Construct group key.
+    _ComputeGroupKey(op, r);
+    _aggregateGroupedRecord(op, &op->groups, r);
+}
+
+/* Aggregates scanned nodes with IDs in the range [start, end). */
+typedef struct {
+    OpAggregate *op;
+    GraphContext *gc;
+    QueryParams *params;
+    GraphReader reader;         /* Matrices version the calling thread is pinned to. */
+    bool labeled;               /* Only aggregate nodes with label. */
+    int label;
+    NodeID start;
+    NodeID end;
+    uint nodeRecIdx;            /* Scanned node position within record. */
+    uint recLength;             /* Number of entries in a record. */
+    AR_Program **filters;       /* Compiled scan filters. */
+    AR_Program **keys;          /* Compiled group key expressions. */
+    AggregateGroups groups;     /* Partial groups. */
+} AggregateWorker;
+
+static void _AggregateWorker_Run(AggregateWorker *w) {
+    Graph *g = w->gc->g;
+    uint filter_count = array_len(w->filters);
+    uint key_count = array_len(w->keys);
+
+    Node n;
+    for(NodeID id = w->start; id < w->end; id++) {
+        if(w->labeled && Graph_GetNodeLabel(g, id) != w->label) continue;
+        if(!Graph_GetNode(g, id, &n)) continue;
+
+        Record r = Record_New(w->recLength);
+        Record_AddNode(r, w->nodeRecIdx, n);
+
+        bool pass = true;
+        for(uint i = 0; i < filter_count && pass; i++) pass = AR_Program_Test(w->filters[i], r);
+        if(!pass) {
+            Record_Free(r);
+            continue;
+        }
+
+        for(uint i = 0; i < key_count; i++) w->groups.keys[i] = AR_Program_Evaluate(w->keys[i], r);
+        _aggregateGroupedRecord(w->op, &w->groups, r);
+    }
+}
+
+/* Thread entry point, expressions read the graph context, query parameters
+ * and graph reader state of the thread executing the query from thread local
+ * storage, these are bound for the duration of the worker's run. */
+static void* _AggregateWorker_Thread(void *arg) {
+    AggregateWorker *w = (AggregateWorker*)arg;
+    pthread_setspecific(_tlsGCKey, w->gc);
+    QueryParams_Bind(w->params);
+    Graph_BindReader(w->reader);
+
+    _AggregateWorker_Run(w);
+
+    GraphReader unbound = {0};
+    Graph_BindReader(unbound);
+    QueryParams_Bind(NULL);
+    pthread_setspecific(_tlsGCKey, NULL);
+    return NULL;
+}
+
+/* Folds worker's partial groups into the operation's groups. */
+static void _AggregateWorker_Merge(AggregateWorker *w) {
+    OpAggregate *op = w->op;
+    uint key_count = array_len(op->none_aggregated_expressions);
+
+    Group *partial;
+    CacheGroupIterator *iter = CacheGroupIter(w->groups.groups);
+    while(CacheGroupIterNext(iter, &partial)) {
+        uint64_t hash = Group_HashKeys(partial->keys, key_count);
+        Group *group = CacheGroupGet(op->groups.groups, hash, partial->keys, key_count);
+        if(group) {
+            uint agg_count = array_len(group->aggregationFunctions);
+            for(uint i = 0; i < agg_count; i++) {
+                AR_EXP_Merge(group->aggregationFunctions[i], partial->aggregationFunctions[i]);
+            }
+        } else {
+            // First encounter of group, hand partial group over.
+            CacheGroupAdd(op->groups.groups, hash, key_count, partial->keys,
+                          partial->aggregationFunctions, partial->r);
+            partial->keys = NULL;
+            partial->aggregationFunctions = NULL;
+        }
+    }
+    CacheGroupIterator_Free(iter);
+}
+
+static void _AggregateWorker_Free(AggregateWorker *w) {
+    for(uint i = 0; i < array_len(w->filters); i++) AR_Program_Free(w->filters[i]);
+    for(uint i = 0; i < array_len(w->keys); i++) AR_Program_Free(w->keys[i]);
+    array_free(w->filters);
+    array_free(w->keys);
+    FreeGroupCache(w->groups.groups);
+    if(w->groups.keys) rm_free(w->groups.keys);
+}
+
+/* Locates a node scan, possibly filtered, feeding the aggregation.
+ * Such input can be split by node ID between threads. */
+static void _LocateParallelScan(OpAggregate *op) {
+    OpBase *child = op->op.children[0];
+    FT_FilterNode **filters = array_new(FT_FilterNode*, 0);
+
+    while(child->type == OPType_FILTER && child->childCount == 1) {
+        filters = array_append(filters, ((Filter*)child)->filterTree);
+        child = child->children[0];
+    }
+
+    if(child->childCount == 0 &&
+       (child->type == OPType_ALL_NODE_SCAN || child->type == OPType_NODE_BY_LABEL_SCAN)) {
+        op->scan = child;
+        op->filters = filters;
+    } else {
+        array_free(filters);
+    }
+}
+
+/* Aggregates scanned nodes using multiple threads, each aggregating
+ * a range of node IDs into its own groups, which are merged once done.
+ * Returns false if input isn't aggregated in parallel. */
+static bool _AggregateParallel(OpAggregate *op) {
+    uint thread_count = (_query_thread_count) ? _query_thread_count : _thread_count;
+    thread_count = MIN(thread_count, AGGREGATE_MAX_THREAD_COUNT);
+    if(thread_count < 2 || !op->scan) return false;
+
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Graph *g = gc->g;
+    bool labeled = false;
+    int label = GRAPH_NO_LABEL;
+    uint nodeRecIdx;
+    uint recLength;
+    uint64_t estimate;
+
+    if(op->scan->type == OPType_ALL_NODE_SCAN) {
+        AllNodeScan *scan = (AllNodeScan*)op->scan;
+        nodeRecIdx = scan->nodeRecIdx;
+        recLength = scan->recLength;
+        estimate = Graph_NodeCount(g);
+    } else {
+        NodeByLabelScan *scan = (NodeByLabelScan*)op->scan;
+        Schema *schema = GraphContext_GetSchema(gc, scan->node->label, SCHEMA_NODE);
+        if(!schema) return false;
+        labeled = true;
+        label = schema->id;
+        nodeRecIdx = scan->nodeRecIdx;
+        recLength = scan->recLength;
+        estimate = Graph_LabeledNodeCount(g, label);
+    }
+
+    if(estimate < _parallel_threshold) return false;
+
+    NodeID dim = Graph_RequiredMatrixDim(g);
+    uint worker_count = thread_count;
+    NodeID range = (dim + worker_count - 1) / worker_count;
+    uint key_count = array_len(op->none_aggregated_expressions);
+    uint filter_count = array_len(op->filters);
+
+    AggregateWorker workers[worker_count];
+    pthread_t threads[worker_count];
+
+    for(uint i = 0; i < worker_count; i++) {
+        AggregateWorker *w = workers + i;
+        w->op = op;
+        w->gc = gc;
+        w->params = QueryParams_Bound();
+        w->reader = Graph_CurrentReader();
+        w->labeled = labeled;
+        w->label = label;
+        w->start = MIN(i * range, dim);
+        w->end = MIN(w->start + range, dim);
+        w->nodeRecIdx = nodeRecIdx;
+        w->recLength = recLength;
+
+        // Programs hold evaluation state, compile a private copy per worker.
+        w->filters = array_new(AR_Program*, filter_count);
+        for(uint j = 0; j < filter_count; j++) {
+            w->filters = array_append(w->filters, FilterTree_Compile(op->filters[j]));
+        }
+        w->keys = array_new(AR_Program*, key_count);
+        for(uint j = 0; j < key_count; j++) {
+            w->keys = array_append(w->keys, AR_EXP_Compile(op->none_aggregated_expressions[j]));
+        }
+
+        w->groups.groups = CacheGroupNew();
+        w->groups.group = NULL;
+        w->groups.keys = (key_count) ? rm_malloc(sizeof(SIValue) * key_count) : NULL;
+    }
+
+    /* The calling thread handles the first range, along with every range
+     * left without a thread once spawning fails (e.g. resources are exhausted),
+     * partial groups are per range such that results are unaffected. */
+    uint spawned = 1;
+    for(; spawned < worker_count; spawned++) {
+        if(pthread_create(threads + spawned, NULL, _AggregateWorker_Thread, workers + spawned) != 0) break;
+    }
+    _AggregateWorker_Run(workers);
+    for(uint i = spawned; i < worker_count; i++) _AggregateWorker_Run(workers + i);
+    for(uint i = 1; i < spawned; i++) pthread_join(threads[i], NULL);
+
+    // Merge by range order, such that groups keep the order of a sequential scan.
+    for(uint i = 0; i < worker_count; i++) {
+        _AggregateWorker_Merge(workers + i);
+        _AggregateWorker_Free(workers + i);
+    }
+    op->groups.group = NULL;
+
+    return true;
+}
+
 /* Returns a record populated with group data. */
 static Record _handoff(OpAggregate *op) {
-    char *key;
     Group *group;
     if(!op->groupIter) return NULL;
-    if(!CacheGroupIterNext(op->groupIter, &key, &group)) return NULL;
+    if(!CacheGroupIterNext(op->groupIter, &group)) return NULL;
 
-    Record r = Record_New(op->exp_count + op->order_exp_count);
+    Record r = OpBase_CreateRecord((OpBase*)op, op->exp_count + op->order_exp_count);
 
     // Populate record.
     uint aggIdx = 0; // Index into group aggregated expressions.
@@ -224,15 +423,18 @@ OpBase* NewAggregateOp(AST *ast, AR_ExpNode **expressions, char **aliases) {
     aggregate->none_aggregated_expressions = NULL;
     aggregate->order_exps = NULL;
     aggregate->order_exp_count = 0;
-    aggregate->group = NULL;
     aggregate->groupIter = NULL;
-    aggregate->group_keys = NULL;
-    aggregate->groups = CacheGroupNew();
+    aggregate->groups.group = NULL;
+    aggregate->groups.keys = NULL;
+    aggregate->groups.groups = CacheGroupNew();
+    aggregate->scan = NULL;
+    aggregate->filters = NULL;
 
     OpBase_Init(&aggregate->op);
     aggregate->op.name = "Aggregate";
     aggregate->op.type = OPType_AGGREGATE;
     aggregate->op.consume = AggregateConsume;
+    aggregate->op.consumeBatch = AggregateConsumeBatch;
     aggregate->op.init = AggregateInit;
     aggregate->op.reset = AggregateReset;
     aggregate->op.free = AggregateFree;
@@ -256,7 +458,9 @@ OpResult AggregateInit(OpBase *opBase) {
 
     /* Allocate memory for group keys. */
     uint noneAggExpCount = array_len(op->none_aggregated_expressions);
-    if(noneAggExpCount) op->group_keys = rm_malloc(sizeof(SIValue) * noneAggExpCount);
+    if(noneAggExpCount) op->groups.keys = rm_malloc(sizeof(SIValue) * noneAggExpCount);
+
+    _LocateParallelScan(op);
     return OP_OK;
 }
 
@@ -266,18 +470,43 @@ Record AggregateConsume(OpBase *opBase) {
 
     if(op->groupIter) return _handoff(op);
 
-    Record r;
-    while((r = OpBase_Consume(child))) _aggregateRecord(op, r);
+    if(!_AggregateParallel(op)) {
+        Record r;
+        while((r = OpBase_Consume(child))) _aggregateRecord(op, r);
+    }
 
-    op->groupIter = CacheGroupIter(op->groups);
+    op->groupIter = CacheGroupIter(op->groups.groups);
     return _handoff(op);
 }
 
+uint AggregateConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    OpAggregate *op = (OpAggregate*)opBase;
+    OpBase *child = op->op.children[0];
+
+    if(!op->groupIter) {
+        if(!_AggregateParallel(op)) {
+            // Aggregate child's batches, records are freed by _aggregateRecord.
+            RecordBatch *input = RecordBatch_New();
+            while(OpBase_ConsumeBatch(child, input)) {
+                for(uint i = 0; i < input->count; i++) _aggregateRecord(op, input->records[i]);
+                input->count = 0;
+            }
+            RecordBatch_Free(input);
+        }
+        op->groupIter = CacheGroupIter(op->groups.groups);
+    }
+
+    Record r;
+    while(!RecordBatch_Full(batch) && (r = _handoff(op))) RecordBatch_Add(batch, r);
+    return batch->count;
+}
+
 OpResult AggregateReset(OpBase *opBase) {
     OpAggregate *op = (OpAggregate*)opBase;
 
-    FreeGroupCache(op->groups);
-    op->groups = CacheGroupNew();
+    FreeGroupCache(op->groups.groups);
+    op->groups.groups = CacheGroupNew();
+    op->groups.group = NULL;
 
     if(op->groupIter) {
         CacheGroupIterator_Free(op->groupIter);
@@ -291,7 +520,8 @@ void AggregateFree(OpBase *opBase) {
     OpAggregate *op = (OpAggregate*)opBase;
     if(!op) return;
 
-    if(op->group_keys) rm_free(op->group_keys);
+    if(op->groups.keys) rm_free(op->groups.keys);
+    if(op->filters) array_free(op->filters);
     if(op->groupIter) CacheGroupIterator_Free(op->groupIter);
     if(op->expression_classification) rm_free(op->expression_classification);
     if(op->none_aggregated_expressions) array_free(op->none_aggregated_expressions);
@@ -303,5 +533,5 @@ void AggregateFree(OpBase *opBase) {
     }
     array_free(op->aliases);
 
-    FreeGroupCache(op->groups);
+    FreeGroupCache(op->groups.groups);
 }
@@ -13,14 +13,26 @@
 #include "../../resultset/resultset.h"
 #include "../../graph/query_graph.h"
 #include "../../grouping/group_cache.h"
+#include "../../filter_tree/filter_tree.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
+#define AGGREGATE_DEFAULT_THREAD_COUNT 1            // Default number of threads aggregating a scan.
+#define AGGREGATE_DEFAULT_PARALLEL_THRESHOLD 100000 // Default number of scanned nodes justifying parallelism.
+#define AGGREGATE_MAX_THREAD_COUNT 64               // Maximal number of threads aggregating a scan.
+
 // Matrix, vector operations.
 typedef enum {
     AGGREGATED,
     NONE_AGGREGATED,
 } ExpClassification;
 
+/* Groups records are aggregated under. */
+typedef struct {
+    CacheGroup *groups;
+    Group *group;                                  /* Last accessed group. */
+    SIValue *keys;                                 /* Array of values composing an aggregated group. */
+} AggregateGroups;
+
 /* Aggregate
  * aggregates graph according to  
  * return clause */
@@ -34,15 +46,24 @@ typedef enum {
     unsigned short order_exp_count;
     AR_ExpNode **none_aggregated_expressions;      /* Array of arithmetic expression. */
     ExpClassification *expression_classification;  /* classifies expression as aggregated/none aggregated.  */
-    Group *group;                                  /* Last accessed group. */
-    TrieMap *groups;
-    SIValue *group_keys;                           /* Array of values composing an aggregated group. */
+    AggregateGroups groups;
     CacheGroupIterator *groupIter;
+    OpBase *scan;                                  /* Node scan aggregated in parallel, NULL if input can't be split. */
+    FT_FilterNode **filters;                       /* Filters applied to scanned nodes. */
  } OpAggregate;
 
+/* Sets number of threads aggregating a node scan and the
+ * minimal number of scanned nodes for which threads are spawned. */
+void Aggregate_SetParallelism(uint thread_count, uint64_t threshold);
+
+/* Overrides the number of threads aggregating a node scan for
+ * queries executed by the calling thread, 0 restores the module setting. */
+void Aggregate_BindThreadCount(uint thread_count);
+
 OpBase* NewAggregateOp(AST *ast, AR_ExpNode **expressions, char **aliases);
 OpResult AggregateInit(OpBase *opBase);
 Record AggregateConsume(OpBase *opBase);
+uint AggregateConsumeBatch(OpBase *opBase, RecordBatch *batch);
 OpResult AggregateReset(OpBase *opBase);
 void AggregateFree(OpBase *opBase);
 
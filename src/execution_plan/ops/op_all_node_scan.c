@@ -16,6 +16,7 @@ int AllNodeScanToString(const OpBase *ctx, char *buff, uint buff_len) {
 
 OpBase* NewAllNodeScanOp(const Graph *g, Node *n, AST *ast) {
     AllNodeScan *allNodeScan = malloc(sizeof(AllNodeScan));
+    allNodeScan->g = g;
     allNodeScan->n = n;
     allNodeScan->iter = Graph_ScanNodes(g);
     allNodeScan->nodeRecIdx = AST_GetAliasID(ast, n->alias);
@@ -26,7 +27,9 @@ OpBase* NewAllNodeScanOp(const Graph *g, Node *n, AST *ast) {
     allNodeScan->op.name = "All Node Scan";
     allNodeScan->op.type = OPType_ALL_NODE_SCAN;
     allNodeScan->op.consume = AllNodeScanConsume;
+    allNodeScan->op.consumeBatch = AllNodeScanConsumeBatch;
     allNodeScan->op.reset = AllNodeScanReset;
+    allNodeScan->op.rebind = AllNodeScanRebind;
     allNodeScan->op.toString = AllNodeScanToString;
     allNodeScan->op.free = AllNodeScanFree;
     allNodeScan->op.modifies = NewVector(char*, 1);
@@ -42,19 +45,40 @@ Record AllNodeScanConsume(OpBase *opBase) {
     Entity *en = (Entity*)DataBlockIterator_Next(op->iter);
     if(en == NULL) return NULL;
     
-    Record r = Record_New(op->recLength);
+    Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
     Node *n = Record_GetNode(r, op->nodeRecIdx);
     n->entity = en;
 
     return r;
 }
 
+uint AllNodeScanConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    AllNodeScan *op = (AllNodeScan*)opBase;
+
+    Entity *en;
+    while(!RecordBatch_Full(batch) && (en = (Entity*)DataBlockIterator_Next(op->iter))) {
+        Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
+        Node *n = Record_GetNode(r, op->nodeRecIdx);
+        n->entity = en;
+        RecordBatch_Add(batch, r);
+    }
+
+    return batch->count;
+}
+
 OpResult AllNodeScanReset(OpBase *op) {
     AllNodeScan *allNodeScan = (AllNodeScan*)op;
     DataBlockIterator_Reset(allNodeScan->iter);
     return OP_OK;
 }
 
+void AllNodeScanRebind(OpBase *op) {
+    AllNodeScan *allNodeScan = (AllNodeScan*)op;
+    // Iterator is bound to the number of nodes at the time it was created.
+    DataBlockIterator_Free(allNodeScan->iter);
+    allNodeScan->iter = Graph_ScanNodes(allNodeScan->g);
+}
+
 void AllNodeScanFree(OpBase *ctx) {
     AllNodeScan *op = (AllNodeScan *)ctx;    
     DataBlockIterator_Free(op->iter);
@@ -18,6 +18,7 @@
  * Scans entire graph */
  typedef struct {
     OpBase op;
+    const Graph *g;
     Node *n;
     DataBlockIterator *iter;
     uint nodeRecIdx;
@@ -26,7 +27,9 @@
 
 OpBase* NewAllNodeScanOp(const Graph *g, Node *n, AST *ast);
 Record AllNodeScanConsume(OpBase *opBase);
+uint AllNodeScanConsumeBatch(OpBase *opBase, RecordBatch *batch);
 OpResult AllNodeScanReset(OpBase *op);
+void AllNodeScanRebind(OpBase *op);
 void AllNodeScanFree(OpBase *ctx);
 
 #endif
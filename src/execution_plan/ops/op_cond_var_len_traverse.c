@@ -152,7 +152,7 @@ OpResult CondVarLenTraverseReset(OpBase *ctx) {
 void CondVarLenTraverseFree(OpBase *ctx) {
     CondVarLenTraverse *op = (CondVarLenTraverse*)ctx;
     array_free(op->relationIDs);
-    AlgebraicExpression_Free(op->ae);
+    if(op->ae) AlgebraicExpression_Free(op->ae);
     if(op->r) Record_Free(op->r);
     if(op->allPathsCtx) AllPathsCtx_Free(op->allPathsCtx);
 }
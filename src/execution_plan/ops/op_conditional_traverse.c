@@ -65,12 +65,37 @@ void _traverse(CondTraverse *op) {
     GrB_Matrix_clear(op->F);
 }
 
-// Determin the maximum number of records
-// which will be considered when evaluating an algebraic expression.
-static int _determinRecordCap(const AST *ast) {
-    int recordsCap = 16;    // Default.
-    if(ast->limitNode) recordsCap = MIN(recordsCap, ast->limitNode->limit);
-    return recordsCap;
+// Get next child record, from input batch if op is consumed in batches.
+static Record _CondTraverse_PullChild(CondTraverse *op) {
+    OpBase *child = op->op.children[0];
+    if(!op->input) return OpBase_Consume(child);
+
+    if(op->input_idx == op->input->count) {
+        op->input->count = 0;
+        op->input_idx = 0;
+        if(!OpBase_ConsumeBatch(child, op->input)) return NULL;
+    }
+    return op->input->records[op->input_idx++];
+}
+
+// Free input records which weren't processed.
+static void _CondTraverse_DiscardInput(CondTraverse *op) {
+    if(!op->input) return;
+    for(uint i = op->input_idx; i < op->input->count; i++) Record_Free(op->input->records[i]);
+    op->input->count = 0;
+    op->input_idx = 0;
+}
+
+// Grows records buffer and matrices to accommodate current batch size.
+static void _CondTraverse_FitBatch(CondTraverse *op) {
+    if(op->batch.size <= op->recordsCap) return;
+
+    GrB_Index ncols;
+    GrB_Matrix_ncols(&ncols, op->F);
+    op->recordsCap = op->batch.size;
+    op->records = rm_realloc(op->records, sizeof(Record) * op->recordsCap);
+    GxB_Matrix_resize(op->F, op->recordsCap, ncols);
+    GxB_Matrix_resize(op->M, op->recordsCap, ncols);
 }
 
 int CondTraverseToString(const OpBase *ctx, char *buff, uint buff_len) {
@@ -87,6 +112,7 @@ int CondTraverseToString(const OpBase *ctx, char *buff, uint buff_len) {
         offset += snprintf(buff + offset, buff_len-offset, "->");
     }
     offset += Node_ToString(op->algebraic_expression->dest_node, buff + offset, buff_len - offset);
+    if(op->op.stats) offset += TraverseBatch_ToString(&op->batch, buff + offset, buff_len - offset);
     return offset;
 }
 
@@ -97,6 +123,8 @@ OpBase* NewCondTraverseOp(AlgebraicExpression *algebraic_expression, AST *ast) {
     traverse->ast = ast;
     traverse->r = NULL;
     traverse->F = NULL;    
+    traverse->input = NULL;
+    traverse->input_idx = 0;
     traverse->iter = NULL;
     traverse->edges = NULL;
     traverse->graph = gc->g;
@@ -107,7 +135,8 @@ OpBase* NewCondTraverseOp(AlgebraicExpression *algebraic_expression, AST *ast) {
     
     traverse->recordsLen = 0;
     traverse->transposed_edge = false;
-    traverse->recordsCap = _determinRecordCap(ast);
+    TraverseBatch_Init(&traverse->batch, ast->limitNode ? ast->limitNode->limit : 0);
+    traverse->recordsCap = traverse->batch.size;
     traverse->records = rm_calloc(traverse->recordsCap, sizeof(Record));
     size_t required_dim = Graph_RequiredMatrixDim(gc->g);
     GrB_Matrix_new(&traverse->M, GrB_BOOL, traverse->recordsCap, required_dim);
@@ -118,8 +147,10 @@ OpBase* NewCondTraverseOp(AlgebraicExpression *algebraic_expression, AST *ast) {
     traverse->op.name = "Conditional Traverse";
     traverse->op.type = OPType_CONDITIONAL_TRAVERSE;
     traverse->op.consume = CondTraverseConsume;
+    traverse->op.consumeBatch = CondTraverseConsumeBatch;
     traverse->op.init = CondTraverseInit;
     traverse->op.reset = CondTraverseReset;
+    traverse->op.rebind = CondTraverseRebind;
     traverse->op.toString = CondTraverseToString;
     traverse->op.free = CondTraverseFree;
     traverse->op.modifies = NewVector(char*, 1);
@@ -155,7 +186,6 @@ OpResult CondTraverseInit(OpBase *opBase) {
  * returns OP_DEPLETED when no additional updates are available */
 Record CondTraverseConsume(OpBase *opBase) {
     CondTraverse *op = (CondTraverse*)opBase;
-    OpBase *child = op->op.children[0];
 
     /* If we're required to update edge,
      * try to get an edge, if successful we can return quickly,
@@ -183,8 +213,9 @@ Record CondTraverseConsume(OpBase *opBase) {
         for(int i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
 
         // Ask child operations for data.
-        for(op->recordsLen = 0; op->recordsLen < op->recordsCap; op->recordsLen++) {
-            Record childRecord = OpBase_Consume(child);
+        _CondTraverse_FitBatch(op);
+        for(op->recordsLen = 0; op->recordsLen < op->batch.size; op->recordsLen++) {
+            Record childRecord = _CondTraverse_PullChild(op);
             if(!childRecord) break;
 
             // Store received record.
@@ -200,6 +231,9 @@ Record CondTraverseConsume(OpBase *opBase) {
         if(op->recordsLen == 0) return NULL;
 
         _traverse(op);
+        GrB_Index nvals;
+        GrB_Matrix_nvals(&nvals, op->M);
+        TraverseBatch_Update(&op->batch, op->recordsLen, nvals);
     }
 
     /* Get node from current column. */
@@ -234,18 +268,44 @@ Record CondTraverseConsume(OpBase *opBase) {
     return Record_Clone(op->r);
 }
 
+uint CondTraverseConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    CondTraverse *op = (CondTraverse*)opBase;
+    if(!op->input) op->input = RecordBatch_New();
+
+    Record r;
+    while(!RecordBatch_Full(batch) && (r = CondTraverseConsume(opBase))) {
+        RecordBatch_Add(batch, r);
+    }
+    return batch->count;
+}
+
 OpResult CondTraverseReset(OpBase *ctx) {
     CondTraverse *op = (CondTraverse*)ctx;
-    if(op->r) Record_Free(op->r);
+    _CondTraverse_DiscardInput(op);
+    // Current record is one of the buffered records.
+    for(int i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+    op->recordsLen = 0;
+    op->r = NULL;
     if(op->edges) array_clear(op->edges);
     if(op->iter) {
         GxB_MatrixTupleIter_free(op->iter);
         op->iter = NULL;
     }
     if(op->F) GrB_Matrix_clear(op->F);
+    TraverseBatch_Reset(&op->batch);
     return OP_OK;
 }
 
+void CondTraverseRebind(OpBase *ctx) {
+    CondTraverse *op = (CondTraverse*)ctx;
+    AlgebraicExpression_Rebind(op->algebraic_expression);
+
+    // Graph might have grown since filter and result matrices were created.
+    GrB_Index dim = Graph_RequiredMatrixDim(op->graph);
+    GxB_Matrix_resize(op->F, op->recordsCap, dim);
+    GxB_Matrix_resize(op->M, op->recordsCap, dim);
+}
+
 /* Frees CondTraverse */
 void CondTraverseFree(OpBase *ctx) {
     CondTraverse *op = (CondTraverse*)ctx;
@@ -255,6 +315,10 @@ void CondTraverseFree(OpBase *ctx) {
     if(op->edges) array_free(op->edges);
     if(op->algebraic_expression) AlgebraicExpression_Free(op->algebraic_expression);
     if(op->edgeRelationTypes) array_free(op->edgeRelationTypes);
+    if(op->input) {
+        _CondTraverse_DiscardInput(op);
+        RecordBatch_Free(op->input);
+    }
     if(op->records) {
         for(int i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
         rm_free(op->records);
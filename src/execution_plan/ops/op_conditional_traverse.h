@@ -8,6 +8,7 @@
 #define __OP_COND_TRAVERSE_H
 
 #include "op.h"
+#include "../traverse_batch.h"
 #include "../../parser/ast.h"
 #include "../../arithmetic/algebraic_expression.h"
 #include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
@@ -28,11 +29,14 @@ typedef struct {
     int srcNodeRecIdx;          // Index into record.
     int destNodeRecIdx;         // Index into record.
     int edgeRecIdx;             // Index into record.
-    int recordsCap;             // Max number of records to process.
+    int recordsCap;             // Number of records buffer and matrices can hold.
     int recordsLen;             // Number of records to process.
+    TraverseBatch batch;        // Number of records to process at once.
     bool transposed_edge;       // Track whether the expression references a transposed edge.
     Record *records;            // Array of records.
     Record r;                   // Current selected record.
+    RecordBatch *input;         // Child records, when consumed in batches.
+    uint input_idx;             // Next record to take from input.
 } CondTraverse;
 
 /* Creates a new Traverse operation */
@@ -46,9 +50,16 @@ OpResult CondTraverseInit(OpBase *opBase);
  * returns NULL when no additional updates are available */
 Record CondTraverseConsume(OpBase *opBase);
 
+/* Batched CondTraverseConsume, pulls child records in batches
+ * returns number of records produced, 0 when depleted. */
+uint CondTraverseConsumeBatch(OpBase *opBase, RecordBatch *batch);
+
 /* Restart iterator */
 OpResult CondTraverseReset(OpBase *ctx);
 
+/* Rebinds expression to the graph's current matrices */
+void CondTraverseRebind(OpBase *ctx);
+
 /* Frees Traverse*/
 void CondTraverseFree(OpBase *ctx);
 
@@ -166,7 +166,7 @@ static void _CommitNodes(OpCreate *op, TrieMap *createEntities) {
                     Vector_Get(entity->properties, prop_idx+1, &value);
 
                     Attribute_ID prop_id = GraphContext_FindOrAddAttribute(op->gc, key->stringval);
-                    GraphEntity_AddProperty((GraphEntity*)n, prop_id, *value);
+                    GraphEntity_AddProperty((GraphEntity*)n, prop_id, GraphContext_InternValue(op->gc, AST_InlineValue(value)));
                 }
                 // Introduce node to schema indices.
                 if(n->label) GraphContext_AddNodeToIndices(op->gc, schema, n);
@@ -221,11 +221,12 @@ static void _CommitEdges(OpCreate *op, TrieMap *createEntities) {
                     Vector_Get(entity->properties, prop_idx+1, &value);
 
                     Attribute_ID prop_id = GraphContext_FindOrAddAttribute(op->gc, key->stringval);
-                    GraphEntity_AddProperty((GraphEntity*)e, prop_id, *value);
+                    GraphEntity_AddProperty((GraphEntity*)e, prop_id, GraphContext_InternValue(op->gc, AST_InlineValue(value)));
                 }
                 op->result_set->stats.properties_set += propCount/2;
             }
         }
+        GraphContext_AddEdgeToIndices(op->gc, schema, e);
         relationships_created++;
     }
     
@@ -268,7 +269,7 @@ Record OpCreateConsume(OpBase *opBase) {
     // No child operation to call.
     if(!op->op.childCount) {
         AST *ast = op->ast;
-        r = Record_New(AST_AliasCount(ast));
+        r = OpBase_CreateRecord((OpBase*)op, AST_AliasCount(ast));
         /* Create entities. */
         _CreateNodes(op, r);
         _CreateEdges(op, r);
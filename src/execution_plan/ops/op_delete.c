@@ -45,6 +45,37 @@ static uint64_t _binarySearch(Edge *array, EdgeID id) {
     return left;
 }
 
+/* Removes deleted edges from edge indices, including edges
+ * implicitly deleted along with their endpoints. */
+static void _DeleteEdgesFromIndices(OpDelete *op) {
+    uint node_count = array_len(op->deleted_nodes);
+    uint edge_count = array_len(op->deleted_edges);
+
+    for(uint i = 0; i < edge_count; i++) {
+        GraphContext_DeleteEdgeFromIndices(op->gc, op->deleted_edges + i);
+    }
+
+    // Skip collecting implicitly deleted edges when no relation is indexed.
+    bool edge_indices = false;
+    uint relation_count = GraphContext_SchemaCount(op->gc, SCHEMA_EDGE);
+    for(uint i = 0; i < relation_count && !edge_indices; i++) {
+        Schema *s = GraphContext_GetSchemaByID(op->gc, i, SCHEMA_EDGE);
+        edge_indices = (Schema_IndexCount(s) > 0);
+    }
+    if(!edge_indices || node_count == 0) return;
+
+    Edge *edges = array_new(Edge, 32);
+    for(uint i = 0; i < node_count; i++) {
+        Graph_GetNodeEdges(op->gc->g, op->deleted_nodes + i, GRAPH_EDGE_DIR_BOTH,
+                           GRAPH_NO_RELATION, &edges);
+    }
+    uint implicit_count = array_len(edges);
+    for(uint i = 0; i < implicit_count; i++) {
+        GraphContext_DeleteEdgeFromIndices(op->gc, edges + i);
+    }
+    array_free(edges);
+}
+
 void _DeleteEntities(OpDelete *op) {
     Graph *g = op->gc->g;
     uint node_deleted = 0;
@@ -55,13 +86,15 @@ void _DeleteEntities(OpDelete *op) {
     /* Lock everything. */
     Graph_AcquireWriteLock(g);
 
-    if(GraphContext_HasIndices(op->gc)) {
+    if(GraphContext_HasIndices(op->gc) || Schema_ColumnarLayout()) {
         for(int i = 0; i < node_count; i++) {
             Node *n = op->deleted_nodes + i;
             GraphContext_DeleteNodeFromIndices(op->gc, n);
         }
     }
 
+    if(GraphContext_HasIndices(op->gc)) _DeleteEdgesFromIndices(op);
+
     Graph_BulkDelete(g, op->deleted_nodes, node_count, op->deleted_edges,
                      edge_count, &node_deleted, &relationships_deleted);
     
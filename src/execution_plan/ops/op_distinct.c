@@ -5,13 +5,332 @@
 */
 
 #include "op_distinct.h"
+#include "../../value.h"
+#include "../../util/arr.h"
+#include "../../util/qsort.h"
+#include "../../util/rmalloc.h"
 #include "xxhash/xxhash.h"
-#include "util/arr.h" 
-#include "util/triemap/triemap.h" 
+#include <string.h>
+#include <assert.h>
 
-OpBase* NewDistinctOp(ResultSet *resultset) {
+#define DISTINCT_SET_INITIAL_SLOTS 64
+#define DISTINCT_SET_MAX_LOAD 0.7
+#define SLOT_LT(a, b) ((a)->hash < (b)->hash)
+
+static size_t _memory_limit = DISTINCT_DEFAULT_MEMORY_LIMIT;
+
+void Distinct_SetMemoryLimit(size_t limit) {
+    _memory_limit = limit;
+}
+
+/* Returns the value records are compared by at position idx,
+ * nodes and edges are compared by their IDs. */
+static SIValue _record_value(const Record r, int idx) {
+    RecordEntryType t = Record_GetType(r, idx);
+    if(t == REC_TYPE_SCALAR) return Record_GetScalar(r, idx);
+
+    SIValue v = SI_LongVal(ENTITY_GET_ID(Record_GetGraphEntity(r, idx)));
+    v.type = (t == REC_TYPE_NODE) ? T_NODE : T_EDGE;
+    return v;
+}
+
+static bool _values_equal(SIValue a, SIValue b) {
+    if(a.type != b.type) {
+        // Numerics of different types, e.g. 1 and 1.0, as grouping keys.
+        return (SI_TYPE(a) & SI_NUMERIC) && (SI_TYPE(b) & SI_NUMERIC) &&
+               SI_GET_NUMERIC(a) == SI_GET_NUMERIC(b);
+    }
+    switch(a.type) {
+        case T_NULL:
+            return true;
+        case T_STRING:
+            return a.stringval == b.stringval || strcmp(a.stringval, b.stringval) == 0;
+        case T_DOUBLE:
+            return a.doubleval == b.doubleval;
+        case T_PTR:
+            return a.ptrval == b.ptrval;
+        default:
+            // Integers, booleans, node and edge IDs.
+            return a.longval == b.longval;
+    }
+}
+
+static bool _record_equal(const SIValue *values, const Record r, uint width) {
+    for(uint i = 0; i < width; i++) {
+        if(!_values_equal(values[i], _record_value(r, i))) return false;
+    }
+    return true;
+}
+
+/* Hashes the values records are compared by, consistent with _values_equal
+ * as numerics comparing equal share a hash code, see Group_HashKeys. */
+static uint64_t _record_hash(const Record r, uint width) {
+    uint64_t hash = 0;
+    for(uint i = 0; i < width; i++) {
+        SIValue v = _record_value(r, i);
+        uint64_t h;
+        if(v.type == T_NODE || v.type == T_EDGE) h = XXH64(&v.longval, sizeof(v.longval), v.type);
+        else if(v.type == T_NULL) h = T_NULL;
+        else h = SIValue_HashCode(v);
+        hash = (hash ^ h) * 0x100000001b3ULL + (hash >> 29);
+    }
+    return hash;
+}
+
+static void _free_values(SIValue *values, uint width) {
+    for(uint i = 0; i < width; i++) SIValue_Free(&values[i]);
+}
+
+static void _set_init(OpDistinct *op) {
+    op->slot_count = DISTINCT_SET_INITIAL_SLOTS;
+    op->used_slots = 0;
+    op->slots = rm_malloc(sizeof(DistinctSlot) * op->slot_count);
+    for(uint64_t i = 0; i < op->slot_count; i++) op->slots[i].entry = -1;
+    op->values = array_new(SIValue, 32);
+    op->memory_usage = sizeof(DistinctSlot) * op->slot_count;
+}
+
+// Frees seen records and hash set.
+static void _set_free(OpDistinct *op) {
+    if(op->values) {
+        _free_values(op->values, array_len(op->values));
+        array_free(op->values);
+        op->values = NULL;
+    }
+    if(op->slots) {
+        rm_free(op->slots);
+        op->slots = NULL;
+    }
+    op->slot_count = 0;
+    op->used_slots = 0;
+    op->memory_usage = 0;
+}
+
+// Locates the slot of record r, or the empty slot it should occupy.
+static DistinctSlot *_set_locate(OpDistinct *op, const Record r, uint64_t hash) {
+    uint64_t mask = op->slot_count - 1;
+    for(uint64_t i = hash & mask;; i = (i + 1) & mask) {
+        DistinctSlot *slot = op->slots + i;
+        if(slot->entry == -1) return slot;
+        if(slot->hash == hash && _record_equal(op->values + slot->entry, r, op->width)) return slot;
+    }
+}
+
+static void _set_grow(OpDistinct *op) {
+    DistinctSlot *old_slots = op->slots;
+    uint64_t old_slot_count = op->slot_count;
+
+    op->memory_usage += sizeof(DistinctSlot) * old_slot_count;
+    op->slot_count *= 2;
+    op->slots = rm_malloc(sizeof(DistinctSlot) * op->slot_count);
+    for(uint64_t i = 0; i < op->slot_count; i++) op->slots[i].entry = -1;
+
+    // Slots hold distinct records, reinsert by probing for a free slot.
+    uint64_t mask = op->slot_count - 1;
+    for(uint64_t i = 0; i < old_slot_count; i++) {
+        if(old_slots[i].entry == -1) continue;
+        uint64_t j = old_slots[i].hash & mask;
+        while(op->slots[j].entry != -1) j = (j + 1) & mask;
+        op->slots[j] = old_slots[i];
+    }
+    rm_free(old_slots);
+}
+
+/* Adds record r to set at the empty slot located for it,
+ * strings are copied as the record is handed over to the parent operation. */
+static void _set_insert(OpDistinct *op, DistinctSlot *slot, const Record r, uint64_t hash) {
+    slot->hash = hash;
+    slot->entry = array_len(op->values);
+
+    for(uint i = 0; i < op->width; i++) {
+        SIValue v = _record_value(r, i);
+        if(v.type == T_STRING) {
+            v = SI_Clone(v);
+            op->memory_usage += strlen(v.stringval) + 1;
+        }
+        op->values = array_append(op->values, v);
+    }
+    op->memory_usage += sizeof(SIValue) * op->width;
+
+    op->used_slots++;
+    if(op->used_slots > op->slot_count * DISTINCT_SET_MAX_LOAD) _set_grow(op);
+}
+
+/* Spilled records are only compared against, values are written as
+ * their type followed by either their string or their 8 byte payload. */
+
+static void _write_value(FILE *f, SIValue v) {
+    fwrite(&v.type, sizeof(v.type), 1, f);
+    if(v.type == T_STRING) {
+        uint32_t len = strlen(v.stringval);
+        fwrite(&len, sizeof(len), 1, f);
+        fwrite(v.stringval, 1, len, f);
+    } else {
+        fwrite(&v.longval, sizeof(v.longval), 1, f);
+    }
+}
+
+static void _read_value(FILE *f, SIValue *v) {
+    *v = SI_NullVal();
+    size_t read = fread(&v->type, sizeof(v->type), 1, f);
+    assert(read == 1);
+    if(v->type == T_STRING) {
+        uint32_t len;
+        read = fread(&len, sizeof(len), 1, f);
+        assert(read == 1);
+        v->stringval = rm_malloc(len + 1);
+        read = fread(v->stringval, 1, len, f);
+        assert(read == len);
+        v->stringval[len] = '\0';
+        v->allocation = M_SELF;
+    } else {
+        read = fread(&v->longval, sizeof(v->longval), 1, f);
+        assert(read == 1);
+    }
+}
+
+static void _run_write_record(DistinctRun *run, uint64_t hash, const SIValue *values, uint width) {
+    if(run->count % DISTINCT_RUN_INDEX_STRIDE == 0) {
+        DistinctRunBlock block = {.hash = hash, .offset = ftell(run->f)};
+        run->index = array_append(run->index, block);
+    }
+    fwrite(&hash, sizeof(hash), 1, run->f);
+    for(uint i = 0; i < width; i++) _write_value(run->f, values[i]);
+    run->count++;
+}
+
+// Reads the next spilled record, returns false once run is depleted.
+static bool _run_read_record(FILE *f, uint width, uint64_t *hash, SIValue *values) {
+    if(fread(hash, sizeof(*hash), 1, f) != 1) return false;
+    for(uint i = 0; i < width; i++) _read_value(f, values + i);
+    return true;
+}
+
+static void _run_free(DistinctRun *run) {
+    fclose(run->f);
+    array_free(run->index);
+}
+
+// Checks if record r with the given hash was spilled to run.
+static bool _run_contains(const OpDistinct *op, DistinctRun *run, const Record r, uint64_t hash) {
+    DistinctRunBlock *index = run->index;
+    uint block_count = array_len(index);
+
+    // Locate first block starting at hash or above,
+    // records sharing hash might reside at the end of its preceding block.
+    uint lo = 0;
+    uint hi = block_count;
+    while(lo < hi) {
+        uint mid = (lo + hi) / 2;
+        if(index[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    if(lo > 0) lo--;
+    if(lo >= block_count) return false;
+
+    fseek(run->f, index[lo].offset, SEEK_SET);
+    uint64_t remaining = run->count - (uint64_t)lo * DISTINCT_RUN_INDEX_STRIDE;
+    SIValue values[op->width];
+    uint64_t h;
+    bool found = false;
+
+    for(; remaining > 0; remaining--) {
+        _run_read_record(run->f, op->width, &h, values);
+        if(h == hash) found = _record_equal(values, r, op->width);
+        _free_values(values, op->width);
+        if(found || h > hash) break;
+    }
+
+    return found;
+}
+
+static bool _spilled_contains(const OpDistinct *op, const Record r, uint64_t hash) {
+    uint run_count = array_len(op->runs);
+    for(uint i = 0; i < run_count; i++) {
+        if(_run_contains(op, op->runs + i, r, hash)) return true;
+    }
+    return false;
+}
+
+// Merges all runs into a single run, reducing the number of runs lookups visit.
+static void _merge_runs(OpDistinct *op) {
+    DistinctRun merged = {.f = tmpfile(), .count = 0, .index = NULL};
+    // Can't merge, keep runs apart.
+    if(!merged.f) return;
+    merged.index = array_new(DistinctRunBlock, 1);
+
+    uint width = op->width;
+    uint run_count = array_len(op->runs);
+    uint64_t hashes[run_count];
+    bool live[run_count];
+    SIValue *heads = rm_malloc(sizeof(SIValue) * width * run_count);
+
+    for(uint i = 0; i < run_count; i++) {
+        rewind(op->runs[i].f);
+        live[i] = _run_read_record(op->runs[i].f, width, hashes + i, heads + i * width);
+    }
+
+    // Runs hold disjoint records, repeatedly move the record with the lowest hash.
+    while(true) {
+        int min = -1;
+        for(uint i = 0; i < run_count; i++) {
+            if(live[i] && (min == -1 || hashes[i] < hashes[min])) min = i;
+        }
+        if(min == -1) break;
+
+        SIValue *head = heads + min * width;
+        _run_write_record(&merged, hashes[min], head, width);
+        _free_values(head, width);
+        live[min] = _run_read_record(op->runs[min].f, width, hashes + min, head);
+    }
+
+    rm_free(heads);
+    for(uint i = 0; i < run_count; i++) _run_free(op->runs + i);
+    array_clear(op->runs);
+    op->runs = array_append(op->runs, merged);
+}
+
+/* Moves seen records to a new on-disk run sorted by hash,
+ * returns false if a run couldn't be created. */
+static bool _spill(OpDistinct *op) {
+    DistinctRun run = {.f = tmpfile(), .count = 0, .index = NULL};
+    if(!run.f) return false;
+    run.index = array_new(DistinctRunBlock, op->used_slots / DISTINCT_RUN_INDEX_STRIDE + 1);
+
+    uint64_t n = 0;
+    DistinctSlot *sorted = rm_malloc(sizeof(DistinctSlot) * op->used_slots);
+    for(uint64_t i = 0; i < op->slot_count; i++) {
+        if(op->slots[i].entry != -1) sorted[n++] = op->slots[i];
+    }
+    QSORT(DistinctSlot, sorted, n, SLOT_LT);
+
+    for(uint64_t i = 0; i < n; i++) {
+        _run_write_record(&run, sorted[i].hash, op->values + sorted[i].entry, op->width);
+    }
+    rm_free(sorted);
+
+    op->runs = array_append(op->runs, run);
+    if(array_len(op->runs) == DISTINCT_MAX_RUNS) _merge_runs(op);
+
+    _set_free(op);
+    _set_init(op);
+    return true;
+}
+
+static void _runs_free(OpDistinct *op) {
+    uint run_count = array_len(op->runs);
+    for(uint i = 0; i < run_count; i++) _run_free(op->runs + i);
+    array_clear(op->runs);
+}
+
+OpBase* NewDistinctOp() {
     OpDistinct *self = malloc(sizeof(OpDistinct));
-    self->trie = NewTrieMap();
+    self->width = 0;
+    self->values = NULL;
+    self->slots = NULL;
+    self->runs = array_new(DistinctRun, 0);
+    self->can_spill = (_memory_limit > 0);
+    _set_init(self);
 
     OpBase_Init(&self->op);
     self->op.name = "Distinct";
@@ -31,19 +350,39 @@ Record DistinctConsume(OpBase *opBase) {
         Record r = OpBase_Consume(child);
         if(!r) return NULL;
 
-        unsigned long long const hash = Record_Hash64(r);
-        int is_new = TrieMap_Add(self->trie, (char *) &hash, sizeof(hash), NULL, TrieMap_DONT_CARE_REPLACE);
-        if(is_new)
-            return r;
-        Record_Free(r);
+        // Records are projected, all share the same length.
+        if(self->width == 0) self->width = Record_length(r);
+        assert(Record_length(r) == self->width);
+
+        uint64_t hash = _record_hash(r, self->width);
+        DistinctSlot *slot = _set_locate(self, r, hash);
+        if(slot->entry != -1 || _spilled_contains(self, r, hash)) {
+            Record_Free(r);
+            continue;
+        }
+
+        _set_insert(self, slot, r, hash);
+        if(self->can_spill && self->memory_usage > _memory_limit) {
+            // Don't retry if spilling failed.
+            self->can_spill = _spill(self);
+        }
+        return r;
     }
 }
 
 OpResult DistinctReset(OpBase *ctx) {
+    OpDistinct *self = (OpDistinct*)ctx;
+    // Forget seen records.
+    _set_free(self);
+    _runs_free(self);
+    _set_init(self);
+    self->can_spill = (_memory_limit > 0);
     return OP_OK;
 }
 
 void DistinctFree(OpBase *ctx) {
     OpDistinct *self = (OpDistinct*)ctx;
-    TrieMap_Free(self->trie, TrieMap_NOP_CB);
+    _set_free(self);
+    _runs_free(self);
+    array_free(self->runs);
 }
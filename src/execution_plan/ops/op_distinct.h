@@ -6,15 +6,55 @@
 
 #pragma once
 
+#include <stdio.h>
 #include "op.h"
-#include "resultset/resultset.h"
-#include "util/triemap/triemap.h"
+#include "../../resultset/resultset.h"
 
+#define DISTINCT_DEFAULT_MEMORY_LIMIT 0     // Default number of bytes distinct may hold, 0 for unlimited.
+#define DISTINCT_RUN_INDEX_STRIDE 64        // Number of spilled records per sparse index entry.
+#define DISTINCT_MAX_RUNS 8                 // Number of spilled runs triggering their merge.
+
+/* Open addressing hash set slot, one per distinct record. */
+typedef struct {
+    uint64_t hash;      // Record hash code.
+    int64_t entry;      // Position of record's first value, -1 if slot is empty.
+} DistinctSlot;
+
+/* Spilled records are written sorted by hash, every DISTINCT_RUN_INDEX_STRIDE'th
+ * record is indexed, such that lookups scan a single block of records. */
+typedef struct {
+    uint64_t hash;      // Hash of block's first record.
+    long offset;        // Block's file offset.
+} DistinctRunBlock;
+
+typedef struct {
+    FILE *f;
+    uint64_t count;             // Number of records in run.
+    DistinctRunBlock *index;    // Sparse index.
+} DistinctRun;
+
+/* Distinct
+ * Passes on records it hasn't seen before.
+ * Seen records are kept in an open addressing hash set keyed by record hash,
+ * a hash match is confirmed by comparing record values.
+ * Once the set exceeds the distinct memory limit its records
+ * are moved to an on-disk run sorted by hash. */
 typedef struct {
     OpBase op;
-    TrieMap *trie;
+    uint width;                 // Number of values per record.
+    SIValue *values;            // Values of seen records, width values per record.
+    DistinctSlot *slots;        // Hash set over seen records.
+    uint64_t slot_count;        // Number of slots, power of 2.
+    uint64_t used_slots;        // Number of occupied slots.
+    size_t memory_usage;        // Approximated number of bytes held by set.
+    bool can_spill;             // Spill once memory limit is exceeded.
+    DistinctRun *runs;          // Spilled records.
 } OpDistinct;
 
+/* Sets the number of bytes a single distinct operation
+ * may hold before spilling to disk, 0 disables spilling. */
+void Distinct_SetMemoryLimit(size_t limit);
+
 OpBase* NewDistinctOp();
 Record DistinctConsume(OpBase *opBase);
 OpResult DistinctReset(OpBase *ctx);
@@ -0,0 +1,176 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_edge_index_seek.h"
+#include "../../graph/graphcontext.h"
+#include "../../util/arr.h"
+
+int EdgeIndexSeekToString(const OpBase *ctx, char *buff, uint buff_len) {
+    const EdgeIndexSeek *op = (const EdgeIndexSeek*)ctx;
+    int offset = snprintf(buff, buff_len, "%s | ", op->op.name);
+    offset += Node_ToString(op->e->src, buff + offset, buff_len - offset);
+    offset += snprintf(buff + offset, buff_len - offset, "-");
+    offset += Edge_ToString(op->e, buff + offset, buff_len - offset);
+    offset += snprintf(buff + offset, buff_len - offset, "->");
+    offset += Node_ToString(op->e->dest, buff + offset, buff_len - offset);
+    return offset;
+}
+
+/* Resolve the label ID a node is required to have,
+ * returns false if the label doesn't exist. */
+static bool _resolveLabel(GraphContext *gc, const Node *n, int *label_id) {
+    *label_id = GRAPH_NO_LABEL;
+    if(!n->label) return true;
+    Schema *s = GraphContext_GetSchema(gc, n->label, SCHEMA_NODE);
+    if(!s) return false;
+    *label_id = s->id;
+    return true;
+}
+
+OpBase *NewEdgeIndexSeekOp(Graph *g, Edge *e, Index *idx, IndexIter *iter, AST *ast) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    EdgeIndexSeek *seek = malloc(sizeof(EdgeIndexSeek));
+    seek->g = g;
+    seek->e = e;
+    seek->idx = idx;
+    seek->iter = iter;
+    seek->bounds = NULL;
+    seek->scanRelation = false;
+    seek->relation_iter = NULL;
+    seek->delta_matrix = NULL;
+    seek->edges = NULL;
+    seek->edge_idx = 0;
+    seek->relation_id = GraphContext_GetSchema(gc, idx->label, SCHEMA_EDGE)->id;
+    seek->depleted = !(_resolveLabel(gc, e->src, &seek->src_label) &&
+                       _resolveLabel(gc, e->dest, &seek->dest_label));
+    seek->edgeRecIdx = AST_GetAliasID(ast, e->alias);
+    seek->srcRecIdx = AST_GetAliasID(ast, e->src->alias);
+    seek->destRecIdx = AST_GetAliasID(ast, e->dest->alias);
+    seek->recLength = AST_AliasCount(ast);
+
+    // Set our Op operations
+    OpBase_Init(&seek->op);
+    seek->op.name = "Edge Index Seek";
+    seek->op.type = OPType_EDGE_INDEX_SEEK;
+    seek->op.consume = EdgeIndexSeekConsume;
+    seek->op.reset = EdgeIndexSeekReset;
+    seek->op.toString = EdgeIndexSeekToString;
+    seek->op.free = EdgeIndexSeekFree;
+
+    seek->op.modifies = NewVector(char*, 3);
+    Vector_Push(seek->op.modifies, e->src->alias);
+    Vector_Push(seek->op.modifies, e->alias);
+    if(seek->destRecIdx != seek->srcRecIdx) Vector_Push(seek->op.modifies, e->dest->alias);
+
+    return (OpBase*)seek;
+}
+
+// Restart the scan over all edges of the relation.
+static void _EdgeIndexSeek_ScanRelation(EdgeIndexSeek *op) {
+    GrB_Matrix m = Graph_GetRelationMatrix(op->g, op->relation_id);
+    op->delta_matrix = Graph_GetDeltaMatrix(op->g, m);
+    if(op->relation_iter) GxB_MatrixTupleIter_reuse(op->relation_iter, m);
+    else GxB_MatrixTupleIter_new(&op->relation_iter, m);
+    if(op->edges) array_clear(op->edges);
+    else op->edges = array_new(Edge, 1);
+    op->edge_idx = 0;
+}
+
+// Rebuild the iterator of a parameterised seek from its bounds.
+static void _EdgeIndexSeek_Bind(EdgeIndexSeek *op) {
+    if(op->iter) IndexIter_Free(op->iter);
+    op->iter = IndexScanBounds_Iterate(op->idx, op->bounds, &op->scanRelation);
+    if(op->scanRelation) _EdgeIndexSeek_ScanRelation(op);
+}
+
+// Sets edgeId and its endpoints to the next edge of the relation, false once depleted.
+static bool _EdgeIndexSeek_NextScanned(EdgeIndexSeek *op, EdgeID *edgeId, NodeID *srcId, NodeID *destId) {
+    while(op->edge_idx >= array_len(op->edges)) {
+        bool depleted = false;
+        GxB_MatrixTupleIter_next(op->relation_iter, srcId, destId, &depleted);
+        if(depleted) {
+            // Relation depleted, move on to its pending additions.
+            if(!op->delta_matrix) return false;
+            GxB_MatrixTupleIter_reuse(op->relation_iter, op->delta_matrix);
+            op->delta_matrix = NULL;
+            continue;
+        }
+        array_clear(op->edges);
+        Graph_GetEdgesConnectingNodes(op->g, *srcId, *destId, op->relation_id, &op->edges);
+        op->edge_idx = 0;
+    }
+
+    Edge *e = op->edges + op->edge_idx++;
+    *edgeId = ENTITY_GET_ID(e);
+    *srcId = Edge_GetSrcNodeID(e);
+    *destId = Edge_GetDestNodeID(e);
+    return true;
+}
+
+// Sets edgeId and its endpoints to the next sought edge, false once depleted.
+static bool _EdgeIndexSeek_Next(EdgeIndexSeek *op, EdgeID *edgeId, NodeID *srcId, NodeID *destId) {
+    if(op->scanRelation) return _EdgeIndexSeek_NextScanned(op, edgeId, srcId, destId);
+    if(!op->iter) return false;
+
+    EdgeID *id;
+    while((id = IndexIter_Next(op->iter))) {
+        if(!Index_EdgeEndpoints(op->idx, *id, srcId, destId)) continue;
+        *edgeId = *id;
+        return true;
+    }
+    return false;
+}
+
+OpBase *NewParamEdgeIndexSeekOp(Graph *g, Edge *e, Index *idx, IndexScanBound *bounds, AST *ast) {
+    EdgeIndexSeek *seek = (EdgeIndexSeek*)NewEdgeIndexSeekOp(g, e, idx, NULL, ast);
+    seek->bounds = bounds;
+    _EdgeIndexSeek_Bind(seek);
+    return (OpBase*)seek;
+}
+
+Record EdgeIndexSeekConsume(OpBase *opBase) {
+    EdgeIndexSeek *op = (EdgeIndexSeek*)opBase;
+    if(op->depleted) return NULL;
+
+    EdgeID edgeId;
+    NodeID srcId;
+    NodeID destId;
+    while(_EdgeIndexSeek_Next(op, &edgeId, &srcId, &destId)) {
+        // Endpoints must satisfy the pattern's labels.
+        if(op->src_label != GRAPH_NO_LABEL && Graph_GetNodeLabel(op->g, srcId) != op->src_label) continue;
+        if(op->dest_label != GRAPH_NO_LABEL && Graph_GetNodeLabel(op->g, destId) != op->dest_label) continue;
+        // Pattern (a)-[e]->(a) only matches self loops.
+        if(op->srcRecIdx == op->destRecIdx && srcId != destId) continue;
+
+        Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
+        Edge *e = Record_GetEdge(r, op->edgeRecIdx);
+        Graph_GetEdge(op->g, edgeId, e);
+        e->relationID = op->relation_id;
+        e->srcNodeID = srcId;
+        e->destNodeID = destId;
+        Graph_GetNode(op->g, srcId, Record_GetNode(r, op->srcRecIdx));
+        Graph_GetNode(op->g, destId, Record_GetNode(r, op->destRecIdx));
+        return r;
+    }
+
+    return NULL;
+}
+
+OpResult EdgeIndexSeekReset(OpBase *ctx) {
+    EdgeIndexSeek *seek = (EdgeIndexSeek*)ctx;
+    // Query parameters might have changed since the seek was built.
+    if(seek->bounds) _EdgeIndexSeek_Bind(seek);
+    else IndexIter_Reset(seek->iter);
+    return OP_OK;
+}
+
+void EdgeIndexSeekFree(OpBase *op) {
+    EdgeIndexSeek *seek = (EdgeIndexSeek *)op;
+    if(seek->iter) IndexIter_Free(seek->iter);
+    if(seek->bounds) IndexScanBounds_Free(seek->bounds);
+    if(seek->relation_iter) GxB_MatrixTupleIter_free(seek->relation_iter);
+    if(seek->edges) array_free(seek->edges);
+}
@@ -0,0 +1,61 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __OP_EDGE_INDEX_SEEK_H
+#define __OP_EDGE_INDEX_SEEK_H
+
+#include "op.h"
+#include "../../parser/ast.h"
+#include "../../graph/graph.h"
+#include "../../index/index.h"
+#include "../../graph/entities/edge.h"
+#include "op_index_scan.h"
+
+/* Edge Index Seek resolves edges through an edge index,
+ * each edge is produced along with both of its endpoints,
+ * which are read from the index rather than the adjacency matrices. */
+typedef struct {
+    OpBase op;
+    Edge *e;            // Query graph edge, e->src and e->dest are its endpoints.
+    Graph *g;
+    Index *idx;
+    IndexIter *iter;    // NULL while a parameterised seek produces no edges.
+    IndexScanBound *bounds; // Bounds of a parameterised seek, NULL if iter is fixed.
+    bool scanRelation;  // Parameters resolved to values the index doesn't hold.
+    GxB_MatrixTupleIter *relation_iter; // Scans the relation while scanRelation is set.
+    GrB_Matrix delta_matrix;    // Relation's pending additions, scanned after the relation.
+    Edge *edges;        // Scanned edges connecting the current pair of nodes.
+    uint edge_idx;      // Next scanned edge.
+    int relation_id;    // Indexed relationship type.
+    int src_label;      // Required source label, GRAPH_NO_LABEL if unlabeled.
+    int dest_label;     // Required destination label, GRAPH_NO_LABEL if unlabeled.
+    bool depleted;      // Set if a required label doesn't exist.
+    uint recLength;     // Number of entries in a record.
+    uint edgeRecIdx;
+    uint srcRecIdx;
+    uint destRecIdx;
+} EdgeIndexSeek;
+
+/* Creates a new EdgeIndexSeek operation, iter traverses idx. */
+OpBase *NewEdgeIndexSeekOp(Graph *g, Edge *e, Index *idx, IndexIter *iter, AST *ast);
+
+/* Creates an EdgeIndexSeek operation whose iterator is rebuilt from bounds
+ * whenever the seek is reset, see NewParamIndexScanOp. Parameters of types
+ * the index doesn't hold are served by scanning the relation,
+ * the operation takes ownership of bounds. */
+OpBase *NewParamEdgeIndexSeekOp(Graph *g, Edge *e, Index *idx, IndexScanBound *bounds, AST *ast);
+
+/* EdgeIndexSeek next operation
+ * called each time a new edge is required */
+Record EdgeIndexSeekConsume(OpBase *opBase);
+
+/* Restart iterator */
+OpResult EdgeIndexSeekReset(OpBase *ctx);
+
+/* Frees EdgeIndexSeek */
+void EdgeIndexSeekFree(OpBase *ctx);
+
+#endif
@@ -23,6 +23,7 @@ static int ExpandIntoToString(const OpBase *ctx, char *buff, uint buff_len) {
         offset += snprintf(buff + offset, buff_len-offset, "->");
     }
     offset += Node_ToString(op->ae->dest_node, buff + offset, buff_len - offset);
+    if(op->op.stats) offset += TraverseBatch_ToString(&op->batch, buff + offset, buff_len - offset);
     return offset;
 }
 
@@ -63,12 +64,17 @@ static bool _setEdge(OpExpandInto *op) {
     return true;
 }
 
-/* Determin the maximum number of records
- * which will be considered when evaluating an algebraic expression. */
-static uint _determinRecordCap(const AST *ast) {
-    uint recordsCap = 16;    // Default.
-    if(ast->limitNode) recordsCap = MIN(recordsCap, ast->limitNode->limit);
-    return recordsCap;
+// Grows records buffer and matrices to accommodate current batch size.
+static void _fitBatch(OpExpandInto *op) {
+    if(op->batch.size <= op->recordsCap) return;
+
+    GrB_Index ncols;
+    GrB_Matrix_ncols(&ncols, op->F);
+    op->records = rm_realloc(op->records, sizeof(Record) * op->batch.size);
+    memset(op->records + op->recordsCap, 0, sizeof(Record) * (op->batch.size - op->recordsCap));
+    op->recordsCap = op->batch.size;
+    GxB_Matrix_resize(op->F, op->recordsCap, ncols);
+    GxB_Matrix_resize(op->M, op->recordsCap, ncols);
 }
 
 /* Evaluate algebraic expression:
@@ -101,7 +107,8 @@ OpBase* NewExpandIntoOp(AlgebraicExpression *ae, AST *ast) {
     expandInto->graph = gc->g;
     expandInto->recordCount = 0;
     expandInto->edgeRelationTypes = NULL;
-    expandInto->recordsCap = _determinRecordCap(ast);
+    TraverseBatch_Init(&expandInto->batch, ast->limitNode ? ast->limitNode->limit : 0);
+    expandInto->recordsCap = expandInto->batch.size;
     expandInto->srcNodeRecIdx = AST_GetAliasID(ast, ae->src_node->alias);
     expandInto->destNodeRecIdx = AST_GetAliasID(ast, ae->dest_node->alias);
     expandInto->records = rm_calloc(expandInto->recordsCap, sizeof(Record));
@@ -113,6 +120,7 @@ OpBase* NewExpandIntoOp(AlgebraicExpression *ae, AST *ast) {
     expandInto->op.init = ExpandIntoInit;
     expandInto->op.free = ExpandIntoFree;
     expandInto->op.reset = ExpandIntoReset;
+    expandInto->op.rebind = ExpandIntoRebind;
     expandInto->op.consume = ExpandIntoConsume;
     expandInto->op.toString = ExpandIntoToString;
     expandInto->op.modifies = NULL;
@@ -205,17 +213,17 @@ Record ExpandIntoConsume(OpBase *opBase) {
     while((r = _handoff(op)) == NULL) {
         /* If we're here, we didn't managed to emit a record,
          * clean up and try to get new data points. */
+        // Emitted records leave gaps, scan entire buffer.
         for(int i = 0; i < op->recordsCap; i++) {
             if(op->records[i]) {
                 Record_Free(op->records[i]);
                 op->records[i] = NULL;
-            } else {
-                break;
             }
         }
 
         // Ask child operations for data.
-        for(op->recordCount = 0; op->recordCount < op->recordsCap; op->recordCount++) {
+        _fitBatch(op);
+        for(op->recordCount = 0; op->recordCount < op->batch.size; op->recordCount++) {
             Record childRecord = OpBase_Consume(child);
             // Did not managed to get new data, break.
             if(!childRecord) break;
@@ -232,6 +240,9 @@ Record ExpandIntoConsume(OpBase *opBase) {
         // Depleted.
         if(op->recordCount == 0) return NULL;
         _traverse(op);
+        GrB_Index nvals;
+        GrB_Matrix_nvals(&nvals, op->M);
+        TraverseBatch_Update(&op->batch, op->recordCount, nvals);
     }
 
     return r;
@@ -239,17 +250,30 @@ Record ExpandIntoConsume(OpBase *opBase) {
 
 OpResult ExpandIntoReset(OpBase *ctx) {
     OpExpandInto *op = (OpExpandInto*)ctx;
-    for(int i = 0; i < op->recordCount; i++) {
+    // Emitted records leave gaps, scan entire buffer.
+    for(int i = 0; i < op->recordsCap; i++) {
         if(op->records[i]) Record_Free(op->records[i]);
-        op->records = NULL;
+        op->records[i] = NULL;
     }
     op->recordCount = 0;
+    op->r = NULL;
 
     if(op->F) GrB_Matrix_clear(op->F);
     if(op->edges) array_clear(op->edges);
+    TraverseBatch_Reset(&op->batch);
     return OP_OK;
 }
 
+void ExpandIntoRebind(OpBase *ctx) {
+    OpExpandInto *op = (OpExpandInto*)ctx;
+    AlgebraicExpression_Rebind(op->ae);
+
+    // Graph might have grown since filter and result matrices were created.
+    GrB_Index dim = Graph_RequiredMatrixDim(op->graph);
+    if(op->F) GxB_Matrix_resize(op->F, op->recordsCap, dim);
+    if(op->M) GxB_Matrix_resize(op->M, op->recordsCap, dim);
+}
+
 /* Frees ExpandInto */
 void ExpandIntoFree(OpBase *ctx) {
     OpExpandInto *op = (OpExpandInto*)ctx;
@@ -261,7 +285,6 @@ void ExpandIntoFree(OpBase *ctx) {
     if(op->records) {
         for(int i = 0; i < op->recordsCap; i++) {
             if(op->records[i]) Record_Free(op->records[i]);
-            else break;
         }
         rm_free(op->records);
     }
@@ -8,6 +8,7 @@
 #define __OP_EXPAND_INTO_H
 
 #include "op.h"
+#include "../traverse_batch.h"
 #include "../../parser/ast.h"
 #include "../../graph/graph.h"
 #include "../../graph/entities/edge.h"
@@ -27,8 +28,9 @@ typedef struct {
     uint srcNodeRecIdx;         // Index into record.
     uint destNodeRecIdx;        // Index into record.
     uint edgeRecIdx;            // Index into record.
-    uint recordsCap;            // Max number of records to process.
+    uint recordsCap;            // Number of records buffer and matrices can hold.
     uint recordCount;           // Number of records to process.
+    TraverseBatch batch;        // Number of records to process at once.
     Record *records;            // Array of records.
     Record r;                   // Current selected record.
 } OpExpandInto;
@@ -37,6 +39,7 @@ OpBase* NewExpandIntoOp(AlgebraicExpression *algebraic_expression, AST *ast);
 OpResult ExpandIntoInit(OpBase *opBase);
 Record ExpandIntoConsume(OpBase *opBase);
 OpResult ExpandIntoReset(OpBase *ctx);
+void ExpandIntoRebind(OpBase *ctx);
 void ExpandIntoFree(OpBase *ctx);
 
 #endif
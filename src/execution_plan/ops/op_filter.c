@@ -9,18 +9,29 @@
 OpBase* NewFilterOp(FT_FilterNode *filterTree) {
     Filter *filter = malloc(sizeof(Filter));
     filter->filterTree = filterTree;
+    filter->program = NULL;
 
     // Set our Op operations
     OpBase_Init(&filter->op);
     filter->op.name = "Filter";
     filter->op.type = OPType_FILTER;
+    filter->op.init = FilterInit;
     filter->op.consume = FilterConsume;
+    filter->op.consumeBatch = FilterConsumeBatch;
     filter->op.reset = FilterReset;
     filter->op.free = FilterFree;
 
     return (OpBase*)filter;
 }
 
+/* Filter tree might be modified by optimizations
+ * up until the execution plan is initialized. */
+OpResult FilterInit(OpBase *opBase) {
+    Filter *filter = (Filter*)opBase;
+    filter->program = FilterTree_Compile(filter->filterTree);
+    return OP_OK;
+}
+
 /* FilterConsume next operation 
  * returns OP_OK when graph passes filter tree. */
 Record FilterConsume(OpBase *opBase) {
@@ -33,7 +44,7 @@ Record FilterConsume(OpBase *opBase) {
         if(!r) break;
 
         /* Pass graph through filter tree */
-        if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) break;
+        if(AR_Program_Test(filter->program, r)) break;
         else Record_Free(r);
     }
 
@@ -41,6 +52,29 @@ Record FilterConsume(OpBase *opBase) {
 }
 
 /* Restart iterator */
+uint FilterConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    Filter *filter = (Filter*)opBase;
+    OpBase *child = filter->op.children[0];
+
+    // Pull batches until at least one record passes.
+    while(OpBase_ConsumeBatch(child, batch)) {
+        // Compact passing records to the front of the batch.
+        uint passed = 0;
+        for(uint i = 0; i < batch->count; i++) {
+            Record r = batch->records[i];
+            if(AR_Program_Test(filter->program, r)) {
+                batch->records[passed++] = r;
+            } else {
+                Record_Free(r);
+            }
+        }
+        batch->count = passed;
+        if(passed) break;
+    }
+
+    return batch->count;
+}
+
 OpResult FilterReset(OpBase *ctx) {
     return OP_OK;
 }
@@ -49,4 +83,5 @@ OpResult FilterReset(OpBase *ctx) {
 void FilterFree(OpBase *ctx) {
     Filter *filter = (Filter*)ctx;
     FilterTree_Free(filter->filterTree);
+    if(filter->program) AR_Program_Free(filter->program);
 }
@@ -15,15 +15,23 @@
 typedef struct {
     OpBase op;
     FT_FilterNode *filterTree;
+    AR_Program *program;        /* Compiled filter tree. */
 } Filter;
 
 /* Creates a new Filter operation */
 OpBase* NewFilterOp(FT_FilterNode *filterTree);
 
+/* Compiles filter tree. */
+OpResult FilterInit(OpBase *opBase);
+
 /* FilterConsume next operation 
  * returns NULL when depleted. */
 Record FilterConsume(OpBase *opBase);
 
+/* Batched FilterConsume, returns number of records
+ * passing filter, 0 when depleted. */
+uint FilterConsumeBatch(OpBase *opBase, RecordBatch *batch);
+
 /* Restart iterator */
 OpResult FilterReset(OpBase *ctx);
 
@@ -6,6 +6,8 @@
 
 #include "op_index_scan.h"
 #include "../../parser/ast.h"
+#include "../../util/arr.h"
+#include "../../query_params.h"
 
 int IndexScanToString(const OpBase *ctx, char *buff, uint buff_len) {
     const IndexScan *op = (const IndexScan*)ctx;
@@ -14,11 +16,142 @@ int IndexScanToString(const OpBase *ctx, char *buff, uint buff_len) {
     return offset;
 }
 
+static SIValue _IndexScanBound_Value(const IndexScanBound *bound) {
+  if (!bound->param) return bound->value;
+  // Parameters are validated before execution.
+  SIValue v;
+  if (!QueryParams_Get(QueryParams_Bound(), bound->param, &v)) return SI_NullVal();
+  return v;
+}
+
+IndexIter* IndexScanBounds_Iterate(Index *idx, IndexScanBound *bounds, bool *unindexed) {
+  *unindexed = false;
+  uint bound_count = array_len(bounds);
+
+  /* Comparisons against null hold for no entity, values of other types
+   * the index doesn't hold can only be compared against unindexed entities. */
+  for (uint i = 0; i < bound_count; i++) {
+    SIValue v = _IndexScanBound_Value(bounds + i);
+    if (v.type == T_NULL) {
+      *unindexed = false;
+      return NULL;
+    }
+    if (!Index_SupportsValue(&v)) *unindexed = true;
+  }
+  if (*unindexed) return NULL;
+
+  SIValue first = _IndexScanBound_Value(bounds);
+  // Hash indices serve a single equality, any other bound is applied by a filter.
+  if (Index_IsHashIndex(idx)) {
+    assert(bounds[0].op == EQ);
+    return IndexIter_CreateLookup(idx, &first, 1);
+  }
+
+  IndexIter *iter = IndexIter_Create(idx, first.type);
+  for (uint i = 0; i < bound_count; i++) {
+    SIValue v = _IndexScanBound_Value(bounds + i);
+    // Strings and numerics never compare, bounds of both types admit no entity.
+    if ((v.type == T_STRING) != (first.type == T_STRING)) {
+      IndexIter_Free(iter);
+      return NULL;
+    }
+    IndexIter_ApplyBound(iter, &v, bounds[i].op);
+  }
+  return iter;
+}
+
+/* Composite index counterpart of IndexScanBounds_Iterate, entities holding values
+ * of other types for a bounded attribute are either missing or out of order. */
+static IndexIter* _CompositeScanBounds_Iterate(CompositeIndex *idx, IndexScanBound *bounds,
+                                               bool *unindexed) {
+  *unindexed = false;
+  uint bound_count = array_len(bounds);
+  uint prefix_len = 0;
+  SIValue prefix[COMPOSITE_INDEX_MAX_ATTRIBUTES];
+  const SIValue *min = NULL;
+  const SIValue *max = NULL;
+  SIValue values[bound_count];
+  int min_exclusive = 0;
+  int max_exclusive = 0;
+
+  for (uint i = 0; i < bound_count; i++) {
+    values[i] = _IndexScanBound_Value(bounds + i);
+    if (values[i].type == T_NULL) {
+      *unindexed = false;
+      return NULL;
+    }
+    if (!Index_SupportsValue(values + i)) *unindexed = true;
+  }
+  if (*unindexed) return NULL;
+
+  for (uint i = 0; i < bound_count; i++) {
+    const IndexScanBound *bound = bounds + i;
+    if (bound->op == EQ) {
+      prefix[bound->attr_idx] = values[i];
+      prefix_len = bound->attr_idx + 1;
+    } else if (bound->op == GT || bound->op == GE) {
+      min = values + i;
+      min_exclusive = (bound->op == GT);
+    } else {
+      max = values + i;
+      max_exclusive = (bound->op == LT);
+    }
+  }
+
+  // Strings and numerics never compare, a range of both types admits no entity.
+  if (min && max && (min->type == T_STRING) != (max->type == T_STRING)) return NULL;
+  return CompositeIndexIter_Create(idx, prefix, prefix_len, min, min_exclusive, max, max_exclusive);
+}
+
+bool IndexScanBounds_Parameterised(IndexScanBound *bounds) {
+  uint bound_count = array_len(bounds);
+  for (uint i = 0; i < bound_count; i++) {
+    if (bounds[i].param) return true;
+  }
+  return false;
+}
+
+void IndexScanBounds_Free(IndexScanBound *bounds) {
+  uint bound_count = array_len(bounds);
+  for (uint i = 0; i < bound_count; i++) {
+    free(bounds[i].param);
+    SIValue_Free(&bounds[i].value);
+  }
+  array_free(bounds);
+}
+
+// Rebuild the iterator of a parameterised scan from its bounds.
+static void _IndexScan_Bind(IndexScan *op) {
+  if (op->iter) IndexIter_Free(op->iter);
+  if (op->composite) op->iter = _CompositeScanBounds_Iterate(op->composite, op->bounds, &op->scanLabel);
+  else op->iter = IndexScanBounds_Iterate(op->idx, op->bounds, &op->scanLabel);
+  if (op->scanLabel) OpBase_Reset(op->labelScan);
+}
+
+static OpResult IndexScanInit(OpBase *opBase) {
+  IndexScan *op = (IndexScan*)opBase;
+  // Records produced by the replaced label scan are drawn from the plan's pool.
+  op->labelScan->record_pool = opBase->record_pool;
+  if (op->labelScan->init) op->labelScan->init(op->labelScan);
+  return OP_OK;
+}
+
+// The replaced label scan isn't a child operation, rebind it along with the scan.
+static void IndexScanRebind(OpBase *opBase) {
+  IndexScan *op = (IndexScan*)opBase;
+  OpBase_Rebind(op->labelScan);
+}
+
 OpBase *NewIndexScanOp(Graph *g, Node *n, IndexIter *iter, AST *ast) {
   IndexScan *indexScan = malloc(sizeof(IndexScan));
   indexScan->g = g;
   indexScan->n = n;
   indexScan->iter = iter;
+  indexScan->idx = NULL;
+  indexScan->composite = NULL;
+  indexScan->bounds = NULL;
+  indexScan->labelScan = NULL;
+  indexScan->scanLabel = false;
   indexScan->nodeRecIdx = AST_GetAliasID(ast, n->alias);
   indexScan->recLength = AST_AliasCount(ast);
 
@@ -37,13 +170,40 @@ OpBase *NewIndexScanOp(Graph *g, Node *n, IndexIter *iter, AST *ast) {
   return (OpBase*)indexScan;
 }
 
+OpBase *NewParamIndexScanOp(Graph *g, Node *n, Index *idx, IndexScanBound *bounds,
+                            OpBase *labelScan, AST *ast) {
+  IndexScan *indexScan = (IndexScan*)NewIndexScanOp(g, n, NULL, ast);
+  indexScan->idx = idx;
+  indexScan->bounds = bounds;
+  indexScan->labelScan = labelScan;
+  indexScan->op.init = IndexScanInit;
+  indexScan->op.rebind = IndexScanRebind;
+  _IndexScan_Bind(indexScan);
+  return (OpBase*)indexScan;
+}
+
+OpBase *NewParamCompositeIndexScanOp(Graph *g, Node *n, CompositeIndex *idx, IndexScanBound *bounds,
+                                     OpBase *labelScan, AST *ast) {
+  IndexScan *indexScan = (IndexScan*)NewIndexScanOp(g, n, NULL, ast);
+  indexScan->composite = idx;
+  indexScan->bounds = bounds;
+  indexScan->labelScan = labelScan;
+  indexScan->op.init = IndexScanInit;
+  indexScan->op.rebind = IndexScanRebind;
+  _IndexScan_Bind(indexScan);
+  return (OpBase*)indexScan;
+}
+
 Record IndexScanConsume(OpBase *opBase) {
   IndexScan *op = (IndexScan*)opBase;
 
+  if (op->scanLabel) return OpBase_Consume(op->labelScan);
+  if (!op->iter) return NULL;
+
   EntityID *nodeId = IndexIter_Next(op->iter);
   if (!nodeId) return NULL;
 
-  Record r = Record_New(op->recLength);
+  Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
   // Get a pointer to a heap allocated node.
   Node *n = Record_GetNode(r, op->nodeRecIdx);
   // Update node's internal entity pointer.
@@ -54,11 +214,15 @@ Record IndexScanConsume(OpBase *opBase) {
 
 OpResult IndexScanReset(OpBase *ctx) {
   IndexScan *indexScan = (IndexScan*)ctx;
-  IndexIter_Reset(indexScan->iter);
+  // Query parameters might have changed since the scan was built.
+  if (indexScan->bounds) _IndexScan_Bind(indexScan);
+  else IndexIter_Reset(indexScan->iter);
   return OP_OK;
 }
 
 void IndexScanFree(OpBase *op) {
   IndexScan *indexScan = (IndexScan *)op;
-  IndexIter_Free(indexScan->iter);
+  if (indexScan->iter) IndexIter_Free(indexScan->iter);
+  if (indexScan->bounds) IndexScanBounds_Free(indexScan->bounds);
+  if (indexScan->labelScan) OpBase_Free(indexScan->labelScan);
 }
@@ -11,21 +11,59 @@
 #include "../../parser/ast.h"
 #include "../../graph/graph.h"
 #include "../../index/index.h"
+#include "../../index/composite_index.h"
 #include "../../graph/entities/node.h"
 
 
+/* Bound of a parameterised index scan, indexed values are related by op
+ * to either a constant or a query parameter resolved whenever the scan is reset. */
+typedef struct {
+    SIValue value;  // Constant bound, unused if param is set.
+    char *param;    // Query parameter bound, NULL for constants.
+    int op;         // Relation of the indexed value to the bound.
+    uint attr_idx;  // Bounded attribute of a composite index, 0 otherwise.
+} IndexScanBound;
+
 typedef struct {
     OpBase op;
     Node *n;
     Graph *g;
     uint recLength;  // Number of entries in a record.
     uint nodeRecIdx;
-    IndexIter *iter;
+    IndexIter *iter;            // NULL while a parameterised scan produces no entities.
+    Index *idx;                 // Index of a parameterised scan.
+    CompositeIndex *composite;  // Composite index of a parameterised scan.
+    IndexScanBound *bounds;     // Bounds of a parameterised scan, NULL if iter is fixed.
+    OpBase *labelScan;          // Scan replaced by a parameterised scan.
+    bool scanLabel;             // Parameters resolved to values the index doesn't hold.
 } IndexScan;
 
 /* Creates a new IndexScan operation */
 OpBase *NewIndexScanOp(Graph *g, Node *n, IndexIter *iter, AST *ast);
 
+/* Creates an IndexScan operation whose iterator is rebuilt from bounds whenever
+ * the scan is reset, such that a cached plan serves any parameter values.
+ * Parameters of types the index doesn't hold are served by labelScan,
+ * the operation takes ownership of both bounds and labelScan. */
+OpBase *NewParamIndexScanOp(Graph *g, Node *n, Index *idx, IndexScanBound *bounds,
+                            OpBase *labelScan, AST *ast);
+
+/* Creates a parameterised IndexScan operation over a composite index, bounds are
+ * equalities on a prefix of its attributes optionally followed by a range on the next. */
+OpBase *NewParamCompositeIndexScanOp(Graph *g, Node *n, CompositeIndex *idx, IndexScanBound *bounds,
+                                     OpBase *labelScan, AST *ast);
+
+/* Builds an iterator over idx's entities satisfying bounds, parameters are resolved
+ * against the bound query parameters. Returns NULL and sets unindexed if entities the
+ * index doesn't hold may satisfy bounds, returns NULL if no entity can satisfy them. */
+IndexIter* IndexScanBounds_Iterate(Index *idx, IndexScanBound *bounds, bool *unindexed);
+
+/* Returns true if any of bounds is a query parameter. */
+bool IndexScanBounds_Parameterised(IndexScanBound *bounds);
+
+/* Frees bounds, an array of IndexScanBound. */
+void IndexScanBounds_Free(IndexScanBound *bounds);
+
 /* IndexScan next operation
  * called each time a new node is required */
 Record IndexScanConsume(OpBase *opBase);
@@ -67,7 +67,7 @@ static void _CommitNodes(OpMerge *op, Record r) {
                     Vector_Get(blueprint->properties, prop_idx*2+1, &value);
 
                     Attribute_ID prop_id = GraphContext_FindOrAddAttribute(op->gc, key->stringval);
-                    GraphEntity_AddProperty((GraphEntity*)n, prop_id, *value);
+                    GraphEntity_AddProperty((GraphEntity*)n, prop_id, GraphContext_InternValue(op->gc, AST_InlineValue(value)));
                 }
                 // Update tracked schema and add node to any matching indices.
                 if(schema) GraphContext_AddNodeToIndices(op->gc, schema, n);
@@ -125,11 +125,12 @@ static void _CommitEdges(OpMerge *op, Record r) {
                     Vector_Get(blueprint->ge.properties, prop_idx*2+1, &value);
 
                     Attribute_ID prop_id = GraphContext_FindOrAddAttribute(op->gc, key->stringval);
-                    GraphEntity_AddProperty((GraphEntity*)e, prop_id, *value);
+                    GraphEntity_AddProperty((GraphEntity*)e, prop_id, GraphContext_InternValue(op->gc, AST_InlineValue(value)));
                 }
                 op->result_set->stats.properties_set += propCount;
             }
         }
+        GraphContext_AddEdgeToIndices(op->gc, schema, e);
     }
 
     op->result_set->stats.relationships_created += edge_count;
@@ -187,7 +188,7 @@ Record OpMergeConsume(OpBase *opBase) {
         if(op->matched) return r;
 
         // No previous match, create MERGE pattern.
-        r = Record_New(AST_AliasCount(op->ast));
+        r = OpBase_CreateRecord((OpBase*)op, AST_AliasCount(op->ast));
         _CreateEntities(op, r);
         op->created = true;
     }
@@ -6,21 +6,85 @@
 
 #include "op_node_by_id_seek.h"
 
+#include "../../query_params.h"
+#include "../../parser/grammar.h"
+#include <math.h>
+
 #define MIN(a,b) (((a) < (b)) ? (a) : (b))
 
 // Checks to see if operation index is within its bounds.
 static inline bool _outOfBounds(OpNodeByIdSeek *op) {
-    /* Because currentId starts at minimum and only increases
-     * we only care about top bound. */
-    if(op->currentId > op->maxId) return true;
-    if(op->currentId == op->maxId && !op->maxInclusive) return true;
-    return false;
+    // Because currentId starts at minimum and only increases
+    // we only care about top bound.
+    return op->currentId >= op->endId;
+}
+
+/* Resolve the range of a parameterised seek, IDs are non-negative integers.
+ * Returns false if no ID can be related to the parameter's value,
+ * fractional values are rounded outwards as the filter is kept. */
+static bool _OpNodeByIdSeek_BindParam(OpNodeByIdSeek *op) {
+    SIValue v;
+    if(!QueryParams_Get(QueryParams_Bound(), op->param, &v)) return false;
+    if(!(SI_TYPE(v) & SI_NUMERIC)) return false;
+
+    double d = SI_GET_NUMERIC(v);
+    int rel = op->paramRel;
+    // ID(n) < $p is the same as $p > ID(n).
+    if(op->paramReverse) {
+        if(rel == LT) rel = GT;
+        else if(rel == LE) rel = GE;
+        else if(rel == GT) rel = LT;
+        else if(rel == GE) rel = LE;
+    }
+
+    op->minId = ID_RANGE_UNBOUND;
+    op->maxId = ID_RANGE_UNBOUND;
+    op->minInclusive = false;
+    op->maxInclusive = false;
+
+    if(rel == GT || rel == GE || rel == EQ) {
+        if(floor(d) >= 0) {
+            op->minId = floor(d);
+            op->minInclusive = true;
+        }
+    }
+    if(rel == LT || rel == LE || rel == EQ) {
+        if(ceil(d) < 0) return false;
+        op->maxId = ceil(d);
+        op->maxInclusive = true;
+    }
+    return true;
+}
+
+// Position the seek at the start of its range.
+static void _OpNodeByIdSeek_SetupRange(OpNodeByIdSeek *op) {
+    if(op->param && !_OpNodeByIdSeek_BindParam(op)) {
+        op->currentId = 0;
+        op->endId = 0;
+        return;
+    }
+
+    // The smallest possible entity ID is 0.
+    op->currentId = 0;
+    if(op->minId != ID_RANGE_UNBOUND) {
+        op->currentId = op->minId;
+        // Advance current ID when min is not inclusive.
+        if(!op->minInclusive) op->currentId++;
+    }
+
+    // The largest possible entity ID is the same as Graph_RequiredMatrixDim.
+    NodeID dim = Graph_RequiredMatrixDim(op->g);
+    op->endId = dim;
+    if(op->maxId != ID_RANGE_UNBOUND) {
+        op->endId = MIN(dim, op->maxId + (op->maxInclusive ? 1 : 0));
+    }
 }
 
 OpBase* NewOpNodeByIdSeekOp
 (
     const AST *ast,
     unsigned int nodeRecIdx,
+    int label,
     NodeID minId,
     NodeID maxId,
     bool minInclusive,
@@ -34,21 +98,15 @@ OpBase* NewOpNodeByIdSeekOp
     OpNodeByIdSeek *op_nodeByIdSeek = malloc(sizeof(OpNodeByIdSeek));
     op_nodeByIdSeek->g = GraphContext_GetFromTLS()->g;
     
+    op_nodeByIdSeek->minId = minId;
+    op_nodeByIdSeek->maxId = maxId;
     op_nodeByIdSeek->minInclusive = minInclusive;
     op_nodeByIdSeek->maxInclusive = maxInclusive;
-
-    // The smallest possible entity ID is 0.
-    op_nodeByIdSeek->minId = minId;
-    if(minId == ID_RANGE_UNBOUND) op_nodeByIdSeek->minId = 0;
-
-    // The largest possible entity ID is the same as Graph_RequiredMatrixDim.
-    if(maxId == ID_RANGE_UNBOUND) maxId = Graph_RequiredMatrixDim(op_nodeByIdSeek->g);
-    op_nodeByIdSeek->maxId = MIN(Graph_RequiredMatrixDim(op_nodeByIdSeek->g), maxId);
-
-    op_nodeByIdSeek->currentId = op_nodeByIdSeek->minId;
-    /* Advance current ID when min is not inclusive and 
-     * minimum range is specified. */
-    if(!minInclusive && minId != ID_RANGE_UNBOUND) op_nodeByIdSeek->currentId++;
+    op_nodeByIdSeek->label = label;
+    op_nodeByIdSeek->param = NULL;
+    op_nodeByIdSeek->paramRel = 0;
+    op_nodeByIdSeek->paramReverse = false;
+    _OpNodeByIdSeek_SetupRange(op_nodeByIdSeek);
 
     op_nodeByIdSeek->nodeRecIdx = nodeRecIdx;
     op_nodeByIdSeek->recLength = AST_AliasCount(ast);
@@ -63,6 +121,25 @@ OpBase* NewOpNodeByIdSeekOp
     return (OpBase*)op_nodeByIdSeek;
 }
 
+OpBase* NewOpNodeByIdSeekParamOp
+(
+    const AST *ast,
+    unsigned int nodeRecIdx,
+    int label,
+    const char *param,
+    int rel,
+    bool reverse
+)
+{
+    OpNodeByIdSeek *op = (OpNodeByIdSeek*)NewOpNodeByIdSeekOp(ast, nodeRecIdx, label,
+        ID_RANGE_UNBOUND, ID_RANGE_UNBOUND, false, false);
+    op->param = strdup(param);
+    op->paramRel = rel;
+    op->paramReverse = reverse;
+    _OpNodeByIdSeek_SetupRange(op);
+    return (OpBase*)op;
+}
+
 Record OpNodeByIdSeekConsume(OpBase *opBase) {
     OpNodeByIdSeek *op = (OpNodeByIdSeek*)opBase;
     Node n;
@@ -71,7 +148,11 @@ Record OpNodeByIdSeekConsume(OpBase *opBase) {
     /* As long as we're within range bounds
      * and we've yet to get a node. */
     while(!_outOfBounds(op)) {
-        if(Graph_GetNode(op->g, op->currentId, &n)) break;
+        if(Graph_GetNode(op->g, op->currentId, &n)) {
+            // Replaced label scans only produce nodes of their label.
+            if(op->label == GRAPH_NO_LABEL || Graph_GetNodeLabel(op->g, op->currentId) == op->label) break;
+            n.entity = NULL;
+        }
         op->currentId++;
     }
 
@@ -84,18 +165,19 @@ Record OpNodeByIdSeekConsume(OpBase *opBase) {
     // TODO If we're replacing a label scan, the correct label can be populated now.
     n.label = NULL;
 
-    Record r = Record_New(op->recLength);
+    Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
     Record_AddNode(r, op->nodeRecIdx, n);
     return r;
 }
 
 OpResult OpNodeByIdSeekReset(OpBase *ctx) {
     OpNodeByIdSeek *op = (OpNodeByIdSeek*)ctx;
-    op->currentId = op->minId;
-    if(!op->minInclusive) op->currentId++;
+    // Parameters might have changed and nodes been added since the range was set.
+    _OpNodeByIdSeek_SetupRange(op);
     return OP_OK;
 }
 
 void OpNodeByIdSeekFree(OpBase *ctx) {
-
+    OpNodeByIdSeek *op = (OpNodeByIdSeek*)ctx;
+    free(op->param);
 }
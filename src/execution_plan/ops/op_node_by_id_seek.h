@@ -18,23 +18,41 @@ typedef struct {
     Graph *g;               // Graph object.
     int nodeRecIdx;         // Position of entity within record.
     int recLength;          // Size of record.
+    int label;              // Label of sought nodes, GRAPH_NO_LABEL for any node.
     NodeID minId;           // Min ID to fetch.
     bool minInclusive;      // Include min ID.
     NodeID maxId;           // Max ID to fetch.
     bool maxInclusive;      // Include max ID.
     NodeID currentId;       // Current ID fetched.
+    NodeID endId;           // First ID past the range.
+    char *param;            // Query parameter IDs are compared against, NULL for constant ranges.
+    int paramRel;           // Relation of the ID to the parameter.
+    bool paramReverse;      // Parameter is the left-hand side of the relation.
 } OpNodeByIdSeek;
 
 OpBase* NewOpNodeByIdSeekOp
 (
     const AST *ast,
     unsigned int nodeRecIdx,
+    int label,
     NodeID minId,
     NodeID maxId,
     bool includeMin,
     bool includeMax
 );
 
+/* Creates a seek over IDs related by rel to a query parameter,
+ * the range is resolved whenever the operation is reset. */
+OpBase* NewOpNodeByIdSeekParamOp
+(
+    const AST *ast,
+    unsigned int nodeRecIdx,
+    int label,
+    const char *param,
+    int rel,
+    bool reverse
+);
+
 Record OpNodeByIdSeekConsume
 (
     OpBase *opBase
@@ -20,25 +20,31 @@ OpBase *NewNodeByLabelScanOp(Node *node, AST *ast) {
     nodeByLabelScan->g = gc->g;
     nodeByLabelScan->node = node;
     nodeByLabelScan->_zero_matrix = NULL;
+    nodeByLabelScan->delta_matrix = NULL;
+    nodeByLabelScan->scanning_delta = false;
     nodeByLabelScan->nodeRecIdx = AST_GetAliasID(ast, node->alias);
     nodeByLabelScan->recLength = AST_AliasCount(ast);
 
     /* Find out label matrix ID. */
     Schema *schema = GraphContext_GetSchema(gc, node->label, SCHEMA_NODE);
     if (schema) {
-        GxB_MatrixTupleIter_new(&nodeByLabelScan->iter, Graph_GetLabelMatrix(gc->g, schema->id));
+        nodeByLabelScan->label_matrix = Graph_GetLabelMatrix(gc->g, schema->id);
+        nodeByLabelScan->delta_matrix = Graph_GetDeltaMatrix(gc->g, nodeByLabelScan->label_matrix);
     } else {
         /* Label does not exist, use a fake empty matrix. */
         GrB_Matrix_new(&nodeByLabelScan->_zero_matrix, GrB_BOOL, 1, 1);
-        GxB_MatrixTupleIter_new(&nodeByLabelScan->iter, nodeByLabelScan->_zero_matrix);
+        nodeByLabelScan->label_matrix = nodeByLabelScan->_zero_matrix;
     }
+    GxB_MatrixTupleIter_new(&nodeByLabelScan->iter, nodeByLabelScan->label_matrix);
 
     // Set our Op operations
     OpBase_Init(&nodeByLabelScan->op);
     nodeByLabelScan->op.name = "Node By Label Scan";
     nodeByLabelScan->op.type = OPType_NODE_BY_LABEL_SCAN;
     nodeByLabelScan->op.consume = NodeByLabelScanConsume;
+    nodeByLabelScan->op.consumeBatch = NodeByLabelScanConsumeBatch;
     nodeByLabelScan->op.reset = NodeByLabelScanReset;
+    nodeByLabelScan->op.rebind = NodeByLabelScanRebind;
     nodeByLabelScan->op.toString = NodeByLabelScanToString;
     nodeByLabelScan->op.free = NodeByLabelScanFree;
     
@@ -48,15 +54,21 @@ OpBase *NewNodeByLabelScanOp(Node *node, AST *ast) {
     return (OpBase*)nodeByLabelScan;
 }
 
-Record NodeByLabelScanConsume(OpBase *opBase) {
-    NodeByLabelScan *op = (NodeByLabelScan*)opBase;
-    
-    GrB_Index nodeId;
-    bool depleted = false;    
-    GxB_MatrixTupleIter_next(op->iter, NULL, &nodeId, &depleted);
-    if(depleted) return NULL;
-    
-    Record r = Record_New(op->recLength);
+// Sets nodeId to the next scanned node, returns false once scan is depleted.
+static bool _NodeByLabelScan_NextID(NodeByLabelScan *op, GrB_Index *nodeId) {
+    bool depleted = false;
+    GxB_MatrixTupleIter_next(op->iter, NULL, nodeId, &depleted);
+    if(!depleted) return true;
+
+    // Label matrix depleted, move on to its pending additions.
+    if(op->scanning_delta || !op->delta_matrix) return false;
+    op->scanning_delta = true;
+    GxB_MatrixTupleIter_reuse(op->iter, op->delta_matrix);
+    return _NodeByLabelScan_NextID(op, nodeId);
+}
+
+static Record _NodeByLabelScan_CreateRecord(NodeByLabelScan *op, GrB_Index nodeId) {
+    Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
     // Get a pointer to a heap allocated node.
     Node *n = Record_GetNode(r, op->nodeRecIdx);
     // Update node's internal entity pointer.
@@ -64,12 +76,48 @@ Record NodeByLabelScanConsume(OpBase *opBase) {
     return r;
 }
 
+Record NodeByLabelScanConsume(OpBase *opBase) {
+    NodeByLabelScan *op = (NodeByLabelScan*)opBase;
+
+    GrB_Index nodeId;
+    if(!_NodeByLabelScan_NextID(op, &nodeId)) return NULL;
+    return _NodeByLabelScan_CreateRecord(op, nodeId);
+}
+
+uint NodeByLabelScanConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    NodeByLabelScan *op = (NodeByLabelScan*)opBase;
+
+    GrB_Index nodeId;
+    while(!RecordBatch_Full(batch) && _NodeByLabelScan_NextID(op, &nodeId)) {
+        RecordBatch_Add(batch, _NodeByLabelScan_CreateRecord(op, nodeId));
+    }
+    return batch->count;
+}
+
 OpResult NodeByLabelScanReset(OpBase *ctx) {
     NodeByLabelScan *op = (NodeByLabelScan*)ctx;
-    GxB_MatrixTupleIter_reset(op->iter);
+    if(op->scanning_delta) {
+        op->scanning_delta = false;
+        GxB_MatrixTupleIter_reuse(op->iter, op->label_matrix);
+    } else {
+        GxB_MatrixTupleIter_reset(op->iter);
+    }
     return OP_OK;
 }
 
+void NodeByLabelScanRebind(OpBase *ctx) {
+    NodeByLabelScan *op = (NodeByLabelScan*)ctx;
+    // Label does not exists, keep scanning the fake empty matrix.
+    if(op->_zero_matrix) return;
+
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Schema *schema = GraphContext_GetSchema(gc, op->node->label, SCHEMA_NODE);
+    op->label_matrix = Graph_GetLabelMatrix(op->g, schema->id);
+    op->delta_matrix = Graph_GetDeltaMatrix(op->g, op->label_matrix);
+    op->scanning_delta = false;
+    GxB_MatrixTupleIter_reuse(op->iter, op->label_matrix);
+}
+
 void NodeByLabelScanFree(OpBase *op) {
     NodeByLabelScan *nodeByLabelScan = (NodeByLabelScan*)op;
     GxB_MatrixTupleIter_free(nodeByLabelScan->iter);
@@ -22,6 +22,9 @@ typedef struct {
     unsigned int recLength;     /* Number of entries in a record. */
     Graph *g;
     GxB_MatrixTupleIter *iter;
+    GrB_Matrix label_matrix;    /* Label matrix being scanned. */
+    GrB_Matrix delta_matrix;    /* Label's pending additions, scanned after label matrix. */
+    bool scanning_delta;        /* True once iterator moved to delta matrix. */
     GrB_Matrix _zero_matrix;    /* Fake matrix, in-case label does not exists. */
 } NodeByLabelScan;
 
@@ -32,9 +35,15 @@ OpBase *NewNodeByLabelScanOp(Node *node, AST *ast);
  * called each time a new ID is required */
 Record NodeByLabelScanConsume(OpBase *opBase);
 
+/* Batched NodeByLabelScanConsume, fills batch with scanned nodes */
+uint NodeByLabelScanConsumeBatch(OpBase *opBase, RecordBatch *batch);
+
 /* Restart iterator */
 OpResult NodeByLabelScanReset(OpBase *ctx);
 
+/* Scans label's current matrix and pending additions */
+void NodeByLabelScanRebind(OpBase *ctx);
+
 /* Frees NodeByLabelScan */
 void NodeByLabelScanFree(OpBase *ctx);
 
@@ -0,0 +1,197 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "op_ordered_index_scan.h"
+#include "op_sort.h"
+#include "../../util/arr.h"
+#include "../../graph/graphcontext.h"
+
+// Value groups in ascending order, descending scans visit them in reverse.
+typedef enum {
+    STAGE_STRINGS,
+    STAGE_BOOLEANS,
+    STAGE_NUMERICS,
+    STAGE_REMAINING,
+    STAGE_COUNT,
+} ScanStage;
+
+int OrderedIndexScanToString(const OpBase *ctx, char *buff, uint buff_len) {
+    const OrderedIndexScan *op = (const OrderedIndexScan*)ctx;
+    int offset = snprintf(buff, buff_len, "%s | ", op->op.name);
+    offset += Node_ToString(op->n, buff + offset, buff_len - offset);
+    return offset;
+}
+
+OpBase *NewOrderedIndexScanOp(Graph *g, Node *n, Index *idx, int direction, AST *ast) {
+    OrderedIndexScan *scan = malloc(sizeof(OrderedIndexScan));
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Schema *schema = GraphContext_GetSchema(gc, n->label, SCHEMA_NODE);
+    assert(schema);
+
+    scan->g = g;
+    scan->n = n;
+    scan->idx = idx;
+    scan->label_id = schema->id;
+    scan->direction = direction;
+    scan->nodeRecIdx = AST_GetAliasID(ast, n->alias);
+    scan->recLength = AST_AliasCount(ast);
+    scan->string_iter = IndexIter_Create(idx, T_STRING);
+    scan->numeric_iter = IndexIter_Create(idx, T_DOUBLE);
+    if(direction == DIR_DESC) {
+        IndexIter_Reverse(scan->string_iter);
+        IndexIter_Reverse(scan->numeric_iter);
+    }
+    scan->stage = 0;
+    scan->offset = 0;
+    scan->collected = false;
+    scan->booleans = NULL;
+    scan->remaining = NULL;
+
+    // Set our Op operations
+    OpBase_Init(&scan->op);
+    scan->op.name = "Ordered Index Scan";
+    scan->op.type = OPType_ORDERED_INDEX_SCAN;
+    scan->op.consume = OrderedIndexScanConsume;
+    scan->op.reset = OrderedIndexScanReset;
+    scan->op.rebind = OrderedIndexScanRebind;
+    scan->op.toString = OrderedIndexScanToString;
+    scan->op.free = OrderedIndexScanFree;
+
+    scan->op.modifies = NewVector(char*, 1);
+    Vector_Push(scan->op.modifies, n->alias);
+
+    return (OpBase*)scan;
+}
+
+/* Scans label for nodes whose value isn't indexed,
+ * unless the index holds every labeled node. */
+static void _CollectUnindexed(OrderedIndexScan *op) {
+    if(op->collected) return;
+    op->collected = true;
+    op->booleans = array_new(NodeID, 0);
+    op->remaining = array_new(NodeID, 0);
+
+    if(Index_EntityCount(op->idx) >= Graph_LabeledNodeCount(op->g, op->label_id)) return;
+
+    NodeID *trues = array_new(NodeID, 0);
+    GrB_Matrix label_matrix = Graph_GetLabelMatrix(op->g, op->label_id);
+    // Label's pending additions are scanned once label matrix is depleted.
+    GrB_Matrix delta_matrix = Graph_GetDeltaMatrix(op->g, label_matrix);
+    GxB_MatrixTupleIter *it;
+    GxB_MatrixTupleIter_new(&it, label_matrix);
+
+    Node node;
+    NodeID node_id;
+    while(true) {
+        bool depleted = false;
+        GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
+        if(depleted) {
+            if(!delta_matrix) break;
+            GxB_MatrixTupleIter_reuse(it, delta_matrix);
+            delta_matrix = NULL;
+            continue;
+        }
+
+        Graph_GetNode(op->g, node_id, &node);
+        SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)&node, op->idx->attr_id);
+        if(SIValue_IsNull(v)) {
+            op->remaining = array_append(op->remaining, node_id);
+        } else if(v.type == T_BOOL) {
+            if(v.longval) trues = array_append(trues, node_id);
+            else op->booleans = array_append(op->booleans, node_id);
+        } else if(!(v.type == T_STRING || (v.type & SI_NUMERIC))) {
+            op->remaining = array_append(op->remaining, node_id);
+        }
+    }
+    GxB_MatrixTupleIter_free(it);
+
+    uint true_count = array_len(trues);
+    for(uint i = 0; i < true_count; i++) op->booleans = array_append(op->booleans, trues[i]);
+    array_free(trues);
+}
+
+// Sets node_id to the next node in order, returns false once scan is depleted.
+static bool _OrderedIndexScan_NextID(OrderedIndexScan *op, NodeID *node_id) {
+    for(; op->stage < STAGE_COUNT; op->stage++, op->offset = 0) {
+        ScanStage stage = (op->direction == DIR_ASC) ? op->stage : STAGE_COUNT - 1 - op->stage;
+        NodeID *id = NULL;
+        NodeID *unindexed = NULL;
+
+        switch(stage) {
+            case STAGE_STRINGS:
+                id = IndexIter_Next(op->string_iter);
+                break;
+            case STAGE_NUMERICS:
+                id = IndexIter_Next(op->numeric_iter);
+                break;
+            case STAGE_BOOLEANS:
+                _CollectUnindexed(op);
+                unindexed = op->booleans;
+                break;
+            default:
+                _CollectUnindexed(op);
+                unindexed = op->remaining;
+                break;
+        }
+
+        if(unindexed) {
+            uint64_t count = array_len(unindexed);
+            if(op->offset < count) {
+                uint64_t i = (op->direction == DIR_ASC) ? op->offset : count - 1 - op->offset;
+                op->offset++;
+                id = unindexed + i;
+            }
+        }
+
+        if(id) {
+            *node_id = *id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Record OrderedIndexScanConsume(OpBase *opBase) {
+    OrderedIndexScan *op = (OrderedIndexScan*)opBase;
+
+    NodeID node_id;
+    if(!_OrderedIndexScan_NextID(op, &node_id)) return NULL;
+
+    Record r = OpBase_CreateRecord((OpBase*)op, op->recLength);
+    // Get a pointer to a heap allocated node.
+    Node *n = Record_GetNode(r, op->nodeRecIdx);
+    // Update node's internal entity pointer.
+    Graph_GetNode(op->g, node_id, n);
+
+    return r;
+}
+
+OpResult OrderedIndexScanReset(OpBase *ctx) {
+    OrderedIndexScan *op = (OrderedIndexScan*)ctx;
+    IndexIter_Reset(op->string_iter);
+    IndexIter_Reset(op->numeric_iter);
+    op->stage = 0;
+    op->offset = 0;
+    return OP_OK;
+}
+
+void OrderedIndexScanRebind(OpBase *ctx) {
+    OrderedIndexScan *op = (OrderedIndexScan*)ctx;
+    if(op->booleans) array_free(op->booleans);
+    if(op->remaining) array_free(op->remaining);
+    op->booleans = NULL;
+    op->remaining = NULL;
+    op->collected = false;
+}
+
+void OrderedIndexScanFree(OpBase *ctx) {
+    OrderedIndexScan *op = (OrderedIndexScan*)ctx;
+    IndexIter_Free(op->string_iter);
+    IndexIter_Free(op->numeric_iter);
+    if(op->booleans) array_free(op->booleans);
+    if(op->remaining) array_free(op->remaining);
+}
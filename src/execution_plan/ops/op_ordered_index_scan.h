@@ -0,0 +1,57 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __OP_ORDERED_INDEX_SCAN_H
+#define __OP_ORDERED_INDEX_SCAN_H
+
+#include "op.h"
+#include "../../parser/ast.h"
+#include "../../graph/graph.h"
+#include "../../index/index.h"
+#include "../../graph/entities/node.h"
+
+/* OrderedIndexScan
+ * Produces every node of a label ordered by an indexed property,
+ * following Cypher's orderability: strings, booleans, numerics, then NULLs.
+ * Strings and numerics are read off the index skiplists, while nodes
+ * holding values the index doesn't store are collected by scanning the label,
+ * which is skipped if the index covers the entire label. */
+typedef struct {
+    OpBase op;
+    Node *n;
+    Graph *g;
+    Index *idx;
+    int label_id;
+    int direction;              // Ascending / descending.
+    uint recLength;             // Number of entries in a record.
+    uint nodeRecIdx;
+    IndexIter *string_iter;
+    IndexIter *numeric_iter;
+    uint stage;                 // Number of completed value groups.
+    uint64_t offset;            // Position within unindexed value group.
+    bool collected;             // Unindexed nodes were collected.
+    NodeID *booleans;           // Unindexed nodes holding booleans, false first.
+    NodeID *remaining;          // Unindexed nodes holding NULL or other values.
+} OrderedIndexScan;
+
+/* Creates a new OrderedIndexScan operation,
+ * direction is either DIR_ASC or DIR_DESC. */
+OpBase *NewOrderedIndexScanOp(Graph *g, Node *n, Index *idx, int direction, AST *ast);
+
+/* OrderedIndexScan next operation
+ * called each time a new node is required */
+Record OrderedIndexScanConsume(OpBase *opBase);
+
+/* Restart iterator */
+OpResult OrderedIndexScanReset(OpBase *ctx);
+
+/* Discards collected unindexed nodes, graph might have changed since */
+void OrderedIndexScanRebind(OpBase *ctx);
+
+/* Frees OrderedIndexScan */
+void OrderedIndexScanFree(OpBase *ctx);
+
+#endif
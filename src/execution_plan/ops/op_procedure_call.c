@@ -91,7 +91,7 @@ Record OpProcCallConsume(OpBase *opBase) {
 
     if(op->op.childCount == 0) {
         /* Make record large enough to accommodate all alias entities. */
-        r = Record_New(op->ast->_aliasIDMapping->cardinality);
+        r = OpBase_CreateRecord((OpBase*)op, op->ast->_aliasIDMapping->cardinality);
     } else {
         OpBase *child = op->op.children[0];
         r = OpBase_Consume(child);
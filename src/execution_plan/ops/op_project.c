@@ -49,6 +49,7 @@ OpBase* NewProjectOp(const AST *ast, AR_ExpNode **exps, char **aliases) {
     project->exp_count = array_len(exps);
     project->order_exps = NULL;
     project->order_exp_count = 0;
+    project->programs = NULL;
     project->singleResponse = false;
     project->aliases = aliases;
     project->record_len = project->exp_count;
@@ -58,6 +59,7 @@ OpBase* NewProjectOp(const AST *ast, AR_ExpNode **exps, char **aliases) {
     project->op.name = "Project";
     project->op.type = OPType_PROJECT;
     project->op.consume = ProjectConsume;
+    project->op.consumeBatch = ProjectConsumeBatch;
     project->op.init = ProjectInit;
     project->op.reset = ProjectReset;
     project->op.free = ProjectFree;
@@ -79,30 +81,23 @@ OpResult ProjectInit(OpBase *opBase) {
         op->record_len += op->order_exp_count;
     }
 
+    op->programs = array_new(AR_Program*, op->exp_count + op->order_exp_count);
+    for(unsigned short i = 0; i < op->exp_count; i++) {
+        op->programs = array_append(op->programs, AR_EXP_Compile(op->exps[i]));
+    }
+    for(unsigned short i = 0; i < op->order_exp_count; i++) {
+        op->programs = array_append(op->programs, AR_EXP_Compile(op->order_exps[i]));
+    }
+
     return OP_OK;
 }
 
-Record ProjectConsume(OpBase *opBase) {
-    OpProject *op = (OpProject*)opBase;
-    Record r = NULL;
-
-    if(op->op.childCount) {
-        OpBase *child = op->op.children[0];
-        r = OpBase_Consume(child);
-        if(!r) return NULL;
-    } else {
-        // QUERY: RETURN 1+2
-        // Return a single record followed by NULL
-        // on the second call.
-        if(op->singleResponse) return NULL;
-        op->singleResponse = true;
-        r = Record_New(AST_AliasCount(op->ast));  // Fake empty record.
-    }
-
-    Record projection = Record_New(op->record_len);
+// Projects r, r is freed.
+static Record _ProjectRecord(OpProject *op, Record r) {
+    Record projection = OpBase_CreateRecord((OpBase*)op, op->record_len);
     int rec_idx = 0;
     for(unsigned short i = 0; i < op->exp_count; i++) {
-        SIValue v = AR_EXP_Evaluate(op->exps[i], r);
+        SIValue v = AR_Program_Evaluate(op->programs[i], r);
         /* Incase expression is aliased, add it to record
          * as it might be referenced by other expressions:
          * e.g. RETURN n.v AS X ORDER BY X * X
@@ -117,7 +112,7 @@ Record ProjectConsume(OpBase *opBase) {
 
     // Project Order expressions.
     for(unsigned short i = 0; i < op->order_exp_count; i++) {
-        SIValue v = AR_EXP_Evaluate(op->order_exps[i], r);
+        SIValue v = AR_Program_Evaluate(op->programs[op->exp_count + i], r);
         Record_Add(projection, rec_idx, v);
         rec_idx++;
     }
@@ -126,7 +121,47 @@ Record ProjectConsume(OpBase *opBase) {
     return projection;
 }
 
+Record ProjectConsume(OpBase *opBase) {
+    OpProject *op = (OpProject*)opBase;
+    Record r = NULL;
+
+    if(op->op.childCount) {
+        OpBase *child = op->op.children[0];
+        r = OpBase_Consume(child);
+        if(!r) return NULL;
+    } else {
+        // QUERY: RETURN 1+2
+        // Return a single record followed by NULL
+        // on the second call.
+        if(op->singleResponse) return NULL;
+        op->singleResponse = true;
+        r = OpBase_CreateRecord((OpBase*)op, AST_AliasCount(op->ast));  // Fake empty record.
+    }
+
+    return _ProjectRecord(op, r);
+}
+
+uint ProjectConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    OpProject *op = (OpProject*)opBase;
+    // Without child operations a single record is produced.
+    if(!op->op.childCount) {
+        Record r = ProjectConsume(opBase);
+        if(r) RecordBatch_Add(batch, r);
+        return batch->count;
+    }
+
+    // Project child's batch in place.
+    OpBase *child = op->op.children[0];
+    uint count = OpBase_ConsumeBatch(child, batch);
+    for(uint i = 0; i < count; i++) {
+        batch->records[i] = _ProjectRecord(op, batch->records[i]);
+    }
+    return count;
+}
+
 OpResult ProjectReset(OpBase *ctx) {
+    OpProject *op = (OpProject*)ctx;
+    op->singleResponse = false;
     return OP_OK;
 }
 
@@ -134,6 +169,10 @@ void ProjectFree(OpBase *ctx) {
     OpProject *op = (OpProject*)ctx;
 
     for(unsigned short i = 0; i < op->exp_count; i++) AR_EXP_Free(op->exps[i]);
+    if(op->programs) {
+        for(uint i = 0; i < array_len(op->programs); i++) AR_Program_Free(op->programs[i]);
+        array_free(op->programs);
+    }
     array_free(op->exps);
     array_free(op->aliases);
 }
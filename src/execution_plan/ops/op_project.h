@@ -10,6 +10,7 @@
 #include "op.h"
 #include "../../parser/ast.h"
 #include "../../arithmetic/arithmetic_expression.h"
+#include "../../arithmetic/arithmetic_program.h"
 
 typedef struct {
     OpBase op;
@@ -17,6 +18,7 @@ typedef struct {
     char **aliases;                 // Aliases attached to projected expressions.
     AR_ExpNode **exps;              // Projected expressions.
     AR_ExpNode **order_exps;        // Order by expressions.
+    AR_Program **programs;          // Compiled projected expressions followed by order by expressions.
     bool singleResponse;            // When no child operations, return NULL after a first response.
     unsigned short exp_count;       // Number of projected expressions.
     unsigned short order_exp_count; // Number of order by expressions.
@@ -29,6 +31,8 @@ OpResult ProjectInit(OpBase *opBase);
 
 Record ProjectConsume(OpBase *op);
 
+uint ProjectConsumeBatch(OpBase *op, RecordBatch *batch);
+
 OpResult ProjectReset(OpBase *ctx);
 
 void ProjectFree(OpBase *ctx);
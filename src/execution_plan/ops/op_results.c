@@ -18,6 +18,7 @@ OpBase* NewResultsOp(ResultSet *result_set, QueryGraph* graph) {
     results->op.name = "Results";
     results->op.type = OPType_RESULTS;
     results->op.consume = ResultsConsume;
+    results->op.consumeBatch = ResultsConsumeBatch;
     results->op.reset = ResultsReset;
     results->op.free = ResultsFree;
 
@@ -42,6 +43,23 @@ Record ResultsConsume(OpBase *opBase) {
 }
 
 /* Restart */
+uint ResultsConsumeBatch(OpBase *opBase, RecordBatch *batch) {
+    Results *op = (Results*)opBase;
+    // Without child operations there's nothing to batch.
+    if(!op->op.childCount) {
+        Record r = ResultsConsume(opBase);
+        if(r) RecordBatch_Add(batch, r);
+        return batch->count;
+    }
+
+    OpBase *child = op->op.children[0];
+    uint count = OpBase_ConsumeBatch(child, batch);
+
+    /* Append to final result set. */
+    for(uint i = 0; i < count; i++) ResultSet_AddRecord(op->result_set, batch->records[i]);
+    return count;
+}
+
 OpResult ResultsReset(OpBase *op) {
     return OP_OK;
 }
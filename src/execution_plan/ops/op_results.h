@@ -29,6 +29,9 @@ OpBase* NewResultsOp(ResultSet *result_set, QueryGraph *graph);
  * called each time a new result record is required */
 Record ResultsConsume(OpBase *op);
 
+/* Batched ResultsConsume, appends an entire batch to the result set */
+uint ResultsConsumeBatch(OpBase *op, RecordBatch *batch);
+
 /* Restart iterator */
 OpResult ResultsReset(OpBase *ctx);
 
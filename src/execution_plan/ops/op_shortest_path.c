@@ -0,0 +1,164 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include <assert.h>
+
+#include "../../util/arr.h"
+#include "../../graph/graphcontext.h"
+#include "../../graph/entities/edge.h"
+#include "./op_shortest_path.h"
+
+static void _setupTraversedRelations(OpShortestPath *op, const AST_LinkEntity *link) {
+    int relationIDsCount = AST_LinkEntity_LabelCount(link);
+
+    if(relationIDsCount > 0) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        op->relationIDs = array_new(int, relationIDsCount);
+        for(int i = 0; i < relationIDsCount; i++) {
+            Schema *s = GraphContext_GetSchema(gc, link->labels[i], SCHEMA_EDGE);
+            if(!s) continue;
+            op->relationIDs = array_append(op->relationIDs, s->id);
+        }
+    } else {
+        op->relationIDs = array_new(int, 1);
+        op->relationIDs = array_append(op->relationIDs, GRAPH_NO_RELATION);
+    }
+}
+
+static int ShortestPathToString(const OpBase *ctx, char *buff, uint buff_len) {
+    const OpShortestPath *op = (const OpShortestPath*)ctx;
+
+    int offset = 0;
+    offset += snprintf(buff + offset, buff_len-offset, "%s | (%s)-[", op->op.name, op->srcAlias);
+    if(op->maxHops == EDGE_LENGTH_INF)
+        offset += snprintf(buff + offset, buff_len-offset, "*%u..INF", op->minHops);
+    else
+        offset += snprintf(buff + offset, buff_len-offset, "*%u..%u", op->minHops, op->maxHops);
+    offset += snprintf(buff + offset, buff_len-offset, "]->(%s)", op->destAlias);
+    return offset;
+}
+
+OpBase* NewShortestPathOp(Graph *g, AST *ast, const AST_LinkEntity *link,
+                          const char *srcAlias, const char *destAlias) {
+    assert(g && link && link->selector != N_PATH_ALL);
+
+    OpShortestPath *op = calloc(1, sizeof(OpShortestPath));
+    op->g = g;
+    op->selector = link->selector;
+    op->srcAlias = srcAlias;
+    op->destAlias = destAlias;
+    op->srcNodeIdx = AST_GetAliasID(ast, (char*)srcAlias);
+    op->destNodeIdx = AST_GetAliasID(ast, (char*)destAlias);
+    op->minHops = (link->length) ? link->length->minHops : 1;
+    op->maxHops = (link->length) ? link->length->maxHops : 1;
+    _setupTraversedRelations(op, link);
+
+    // Set our Op operations
+    OpBase_Init(&op->op);
+    op->op.name = (op->selector == N_PATH_SHORTEST) ? "Shortest Path" : "All Shortest Paths";
+    op->op.type = OPType_SHORTEST_PATH;
+    op->op.init = ShortestPathInit;
+    op->op.consume = ShortestPathConsume;
+    op->op.reset = ShortestPathReset;
+    op->op.rebind = ShortestPathRebind;
+    op->op.toString = ShortestPathToString;
+    op->op.free = ShortestPathFree;
+
+    return (OpBase*)op;
+}
+
+OpResult ShortestPathInit(OpBase *opBase) {
+    OpShortestPath *op = (OpShortestPath*)opBase;
+    uint relationCount = array_len(op->relationIDs);
+    // Query refers to none existing relationship types.
+    if(relationCount == 0) return OP_OK;
+
+    /* Traverse each relation matrix along with its pending additions,
+     * pairing every matrix with its transpose maintained by the graph. */
+    uint count = 0;
+    bool transposed = true;
+    GrB_Matrix forward[relationCount * 2];
+    GrB_Matrix backward[relationCount * 2];
+    for(uint i = 0; i < relationCount; i++) {
+        GrB_Matrix M = Graph_GetRelationMatrix(op->g, op->relationIDs[i]);
+        GrB_Matrix TM = Graph_GetTransposedRelationMatrix(op->g, op->relationIDs[i]);
+        GrB_Matrix DP = Graph_GetDeltaMatrix(op->g, M);
+        GrB_Matrix TDP = Graph_GetDeltaMatrix(op->g, TM);
+        forward[count] = M;
+        backward[count++] = TM;
+        if(DP) {
+            forward[count] = DP;
+            backward[count++] = TDP;
+            if(!TDP) transposed = false;
+        }
+    }
+
+    GrB_Index dim;
+    GrB_Matrix_nrows(&dim, forward[0]);
+    op->ctx = ShortestPathCtx_New(forward, transposed ? backward : NULL, count, dim);
+    return OP_OK;
+}
+
+Record ShortestPathConsume(OpBase *opBase) {
+    OpShortestPath *op = (OpShortestPath*)opBase;
+    OpBase *child = op->op.children[0];
+
+    /* Incase we don't have any relations to traverse we can return quickly
+     * Consider: MATCH (a), (b), shortestPath((a)-[:L*]->(b)) RETURN b
+     * where label L does not exists. */
+    if(!op->ctx) return NULL;
+
+    while(op->pending == 0) {
+        Record r = OpBase_Consume(child);
+        if(!r) return NULL;
+
+        uint64_t path_count;
+        Node *src = Record_GetNode(r, op->srcNodeIdx);
+        Node *dest = Record_GetNode(r, op->destNodeIdx);
+        int64_t length = ShortestPath_Search(op->ctx, ENTITY_GET_ID(src), ENTITY_GET_ID(dest),
+                                             op->minHops, op->maxHops, &path_count);
+        if(length < 0) {
+            Record_Free(r);
+            continue;
+        }
+
+        op->r = r;
+        op->pending = (op->selector == N_PATH_SHORTEST) ? 1 : path_count;
+    }
+
+    // Hand over current record once it's emitted for the last time.
+    op->pending--;
+    if(op->pending > 0) return Record_Clone(op->r);
+
+    Record r = op->r;
+    op->r = NULL;
+    return r;
+}
+
+OpResult ShortestPathReset(OpBase *ctx) {
+    OpShortestPath *op = (OpShortestPath*)ctx;
+    if(op->r) {
+        Record_Free(op->r);
+        op->r = NULL;
+    }
+    op->pending = 0;
+    return OP_OK;
+}
+
+void ShortestPathRebind(OpBase *ctx) {
+    OpShortestPath *op = (OpShortestPath*)ctx;
+    // Search context holds the relation matrices, build it anew.
+    if(op->ctx) ShortestPathCtx_Free(op->ctx);
+    op->ctx = NULL;
+    ShortestPathInit(ctx);
+}
+
+void ShortestPathFree(OpBase *ctx) {
+    OpShortestPath *op = (OpShortestPath*)ctx;
+    if(op->r) Record_Free(op->r);
+    if(op->ctx) ShortestPathCtx_Free(op->ctx);
+    if(op->relationIDs) array_free(op->relationIDs);
+}
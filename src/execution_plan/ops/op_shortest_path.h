@@ -0,0 +1,47 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __OP_SHORTEST_PATH_H
+#define __OP_SHORTEST_PATH_H
+
+#include "op.h"
+#include "../../graph/graph.h"
+#include "../../parser/ast.h"
+#include "../../algorithms/shortest_path.h"
+
+/* Matches shortestPath and allShortestPaths patterns,
+ * both endpoints are resolved by child operation, records
+ * whose endpoints are connected within minHops..maxHops hops
+ * are passed on, once for shortestPath and once per shortest path
+ * for allShortestPaths. Paths are found by a bidirectional BFS
+ * over the traversed relation matrices. */
+typedef struct {
+    OpBase op;
+    Graph *g;
+    AST_PathSelector selector;      /* Single or all shortest paths. */
+    const char *srcAlias;           /* Path source alias. */
+    const char *destAlias;          /* Path destination alias. */
+    int srcNodeIdx;                 /* Path source position within record. */
+    int destNodeIdx;                /* Path destination position within record. */
+    int *relationIDs;               /* Relation(s) we're traversing. */
+    unsigned int minHops;           /* Minimum path length. */
+    unsigned int maxHops;           /* Maximum path length. */
+    ShortestPathCtx *ctx;           /* Search context, NULL if there's nothing to traverse. */
+    Record r;                       /* Record currently emitted. */
+    uint64_t pending;               /* Number of times r is yet to be emitted. */
+} OpShortestPath;
+
+/* Creates a new shortest path operation matching link,
+ * connecting src to dest, following link's direction. */
+OpBase* NewShortestPathOp(Graph *g, AST *ast, const AST_LinkEntity *link,
+                          const char *srcAlias, const char *destAlias);
+OpResult ShortestPathInit(OpBase *opBase);
+Record ShortestPathConsume(OpBase *opBase);
+OpResult ShortestPathReset(OpBase *ctx);
+void ShortestPathRebind(OpBase *ctx);
+void ShortestPathFree(OpBase *ctx);
+
+#endif
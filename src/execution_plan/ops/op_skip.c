@@ -6,9 +6,10 @@
 
 #include "op_skip.h"
 
-OpBase* NewSkipOp(unsigned int rec_to_skip) {
+OpBase* NewSkipOp(const AST_SkipNode *skipNode) {
     OpSkip *skip = malloc(sizeof(OpSkip));
-    skip->rec_to_skip = rec_to_skip;
+    skip->skipNode = skipNode;
+    skip->rec_to_skip = AST_SkipNode_Value(skipNode);
     skip->skipped = 0;
 
     // Set our Op operations
@@ -45,6 +46,7 @@ Record SkipConsume(OpBase *op) {
 
 OpResult SkipReset(OpBase *ctx) {
     OpSkip *skip = (OpSkip*)ctx;
+    skip->rec_to_skip = AST_SkipNode_Value(skip->skipNode);
     skip->skipped = 0;
     return OP_OK;
 }
@@ -8,14 +8,16 @@
 #define __OP_SKIP_H
 
 #include "op.h"
+#include "../../parser/ast.h"
 
 typedef struct {
     OpBase op;
+    const AST_SkipNode *skipNode;   // Skip clause, a parameter is read on reset.
     unsigned int rec_to_skip;
     unsigned int skipped;
 } OpSkip;
 
-OpBase* NewSkipOp(unsigned int rec_to_skip);
+OpBase* NewSkipOp(const AST_SkipNode *skipNode);
 
 Record SkipConsume(OpBase *op);
 
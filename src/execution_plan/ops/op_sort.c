@@ -115,6 +115,24 @@ uint _determineOffset(OpBase *op) {
     return _determineOffset(op->children[0]);
 }
 
+/* Sets the number of records to produce, LIMIT and SKIP may be parameters.
+ * A heap holds the top records when limited, otherwise all records are buffered. */
+static void _setupLimit(OpSort *op) {
+    op->limit = 0;
+    if(op->ast->limitNode) {
+        op->limit = AST_LimitNode_Value(op->ast->limitNode);
+        if(op->ast->skipNode) {
+            op->limit += AST_SkipNode_Value(op->ast->skipNode);
+        }
+    }
+
+    if(op->limit) {
+        if(!op->heap) op->heap = heap_new(_heap_elem_compare, op);
+    } else {
+        op->buffer = array_new(Record, 32);
+    }
+}
+
 OpBase *NewSortOp(const AST *ast, AR_ExpNode **expressions) {
     assert(expressions && array_len(expressions) > 0);
     OpSort *sort = malloc(sizeof(OpSort));
@@ -125,16 +143,7 @@ OpBase *NewSortOp(const AST *ast, AR_ExpNode **expressions) {
     sort->expressions = expressions;
     sort->heap = NULL;
     sort->buffer = NULL;
-
-    if(ast->limitNode) {
-        sort->limit = ast->limitNode->limit;
-        if(ast->skipNode) {
-            sort->limit += ast->skipNode->skip;
-        }
-    }
-
-    if(sort->limit) sort->heap = heap_new(_heap_elem_compare, sort);
-    else sort->buffer = array_new(Record, 32);
+    _setupLimit(sort);
 
     // Set our Op operations
     OpBase_Init(&sort->op);
@@ -214,8 +223,12 @@ OpResult SortReset(OpBase *ctx) {
             Record r = array_pop(op->buffer);
             Record_Free(r);
         }
+        array_free(op->buffer);
+        op->buffer = NULL;
     }
 
+    // Limit might be a parameter, rebound on reset.
+    _setupLimit(op);
     return OP_OK;
 }
 
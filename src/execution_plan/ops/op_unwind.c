@@ -54,7 +54,7 @@ Record UnwindConsume(OpBase *opBase) {
     if(op->expIdx == array_len(op->expressions)) return NULL;
 
     AR_ExpNode *exp = op->expressions[op->expIdx];
-    Record r = Record_New(AST_AliasCount(ast));
+    Record r = OpBase_CreateRecord((OpBase*)op, AST_AliasCount(ast));
     SIValue v = AR_EXP_Evaluate(exp, r);
     Record_AddScalar(r, op->unwindRecIdx, v);
     op->expIdx++;
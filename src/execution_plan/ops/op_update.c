@@ -37,7 +37,10 @@ static void _QueueUpdate(OpUpdate *op, GraphEntity *entity, GraphEntityType type
     }
 
     uint i = op->pending_updates_count;
-    op->pending_updates[i].new_value = new_value;
+    /* Evaluated value might borrow a string held by an entity this very clause updates,
+     * e.g. SET a.v = 'x', a.w = a.v, the queued update holds its own interned reference. */
+    op->pending_updates[i].new_value = GraphContext_InternValue(op->gc, new_value);
+    SIValue_Free(&new_value);
     op->pending_updates[i].attribute = attribute;
     op->pending_updates[i].attr_id = GraphContext_GetAttributeID(op->gc, attribute);
     op->pending_updates[i].entity_type = type;
@@ -60,7 +63,7 @@ static void _UpdateIndex(EntityUpdateCtx *ctx, GraphContext *gc, Schema *s, SIVa
     Index *idx = Schema_GetIndex(s, ctx->attr_id);
     if(!idx) return;
 
-    if(old_value != PROPERTY_NOTFOUND) {
+    if(!SIValue_IsNull(*old_value)) {
         /* Updating an existing property.
          * remove entity from index using old value. */
         Index_DeleteNode(idx, node_id, old_value);
@@ -73,6 +76,38 @@ static void _UpdateIndex(EntityUpdateCtx *ctx, GraphContext *gc, Schema *s, SIVa
     Index_InsertNode(idx, node_id, new_value);
 }
 
+/* Introduce updated edge to its relation's index, if any. */
+static void _UpdateEdgeIndex(EntityUpdateCtx *ctx, Schema *s, SIValue *old_value, SIValue *new_value) {
+    if (s == NULL) return;
+    Edge *e = &ctx->e;
+
+    // See if there's an index on relation/property pair.
+    Index *idx = Schema_GetIndex(s, ctx->attr_id);
+    if(!idx) return;
+
+    // Remove entity from index using old value.
+    if(old_value != PROPERTY_NOTFOUND) Index_DeleteEdge(idx, ENTITY_GET_ID(e), old_value);
+
+    // Setting an attribute value to NULL remove that attribute.
+    if(SIValue_IsNull(*new_value)) return;
+
+    Index_InsertEdge(idx, e, new_value);
+}
+
+/* Composite keys are built from the node's properties,
+ * node is removed from the composite indices covering the attribute before it is updated
+ * and reintroduced once the update is done. */
+static void _UpdateCompositeIndices(Schema *s, EntityUpdateCtx *ctx, bool insert) {
+    if (s == NULL) return;
+    unsigned short index_count = Schema_CompositeIndexCount(s);
+    for(unsigned short i = 0; i < index_count; i++) {
+        CompositeIndex *idx = s->composite_indices[i];
+        if(!CompositeIndex_ContainsAttribute(idx, ctx->attr_id)) continue;
+        if(insert) CompositeIndex_InsertNode(idx, &ctx->n);
+        else CompositeIndex_DeleteNode(idx, &ctx->n);
+    }
+}
+
 static void _UpdateNode(OpUpdate *op, EntityUpdateCtx *ctx) {
     /* Retrieve GraphEntity:
      * Due to Record freeing we can't maintain the original pointer to GraphEntity object,
@@ -87,19 +122,28 @@ static void _UpdateNode(OpUpdate *op, EntityUpdateCtx *ctx) {
         s = GraphContext_GetSchemaByID(op->gc, label_id, SCHEMA_NODE);
     }
 
-    // Try to get current property value.
-    SIValue *old_value  = GraphEntity_GetProperty((GraphEntity*)node, ctx->attr_id);
+    // Try to get current property value, either from the node or its label's column.
+    SIValue old_value = GraphEntity_GetPropertyValue((GraphEntity*)node, ctx->attr_id);
 
-    // Update index for node entities.
-    _UpdateIndex(ctx, op->gc, s, old_value, &ctx->new_value);
+    // Node takes over the queued update's interned reference.
+    SIValue new_value = ctx->new_value;
 
-    if(old_value == PROPERTY_NOTFOUND) {
-        // Add new property.
-        GraphEntity_AddProperty((GraphEntity*)node, ctx->attr_id, ctx->new_value);
+    // Update index for node entities.
+    _UpdateIndex(ctx, op->gc, s, &old_value, &new_value);
+    _UpdateCompositeIndices(s, ctx, false);
+
+    if(s && Schema_SetColumnValue(s, node, ctx->attr_id, new_value)) {
+        // Column holds its own reference, node no longer holds the attribute itself.
+        SIValue_Free(&new_value);
+        GraphEntity_SetProperty((GraphEntity*)node, ctx->attr_id, SI_NullVal());
+    } else if(GraphEntity_GetProperty((GraphEntity*)node, ctx->attr_id) == PROPERTY_NOTFOUND) {
+        // Add new property, a NULL value might have removed it from a column.
+        if(!SIValue_IsNull(new_value)) GraphEntity_AddProperty((GraphEntity*)node, ctx->attr_id, new_value);
     } else {
         // Update property.
-        GraphEntity_SetProperty((GraphEntity*)node, ctx->attr_id, ctx->new_value);
+        GraphEntity_SetProperty((GraphEntity*)node, ctx->attr_id, new_value);
     }
+    _UpdateCompositeIndices(s, ctx, true);
 }
 
 static void _UpdateEdge(OpUpdate *op, EntityUpdateCtx *ctx) {
@@ -116,12 +160,18 @@ static void _UpdateEdge(OpUpdate *op, EntityUpdateCtx *ctx) {
     // Try to get current property value.
     SIValue *old_value = GraphEntity_GetProperty((GraphEntity*)edge, ctx->attr_id);
 
+    // Edge takes over the queued update's interned reference.
+    SIValue new_value = ctx->new_value;
+
+    // Update index for edge entities.
+    _UpdateEdgeIndex(ctx, s, old_value, &new_value);
+
     if(old_value == PROPERTY_NOTFOUND) {
         // Add new property.
-        GraphEntity_AddProperty((GraphEntity*)edge, ctx->attr_id, ctx->new_value);
+        GraphEntity_AddProperty((GraphEntity*)edge, ctx->attr_id, new_value);
     } else {
         // Update property.
-        GraphEntity_SetProperty((GraphEntity*)edge, ctx->attr_id, ctx->new_value);
+        GraphEntity_SetProperty((GraphEntity*)edge, ctx->attr_id, new_value);
     }
 }
 
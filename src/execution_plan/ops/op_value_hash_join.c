@@ -7,120 +7,324 @@
 #include "op_value_hash_join.h"
 #include "../../value.h"
 #include "../../util/arr.h"
-#include "../../util/qsort.h"
+#include "../../util/rmalloc.h"
 #include <assert.h>
 
-/* Determins order between two records by inspecting
- * element stored at postion idx. */
-static bool _record_islt(Record l, Record r, uint idx) {
-    SIValue lv = Record_GetScalar(l, idx);
-    SIValue rv = Record_GetScalar(r, idx);
-    return SIValue_Order(lv, rv) < 0;
+#define JOIN_TABLE_INITIAL_SLOTS 64
+#define JOIN_TABLE_MAX_LOAD 0.7
+#define JOIN_PARTITION(hash) (((hash) >> 32) % VALUE_HASH_JOIN_PARTITION_COUNT)
+
+static size_t _memory_limit = VALUE_HASH_JOIN_DEFAULT_MEMORY_LIMIT;
+
+void ValueHashJoin_SetMemoryLimit(size_t limit) {
+    _memory_limit = limit;
+}
+
+/* Spilled records are only read back by the query which wrote them,
+ * while it holds the graph lock, as such nodes, edges and values referring to
+ * graph owned allocations are written as is. Values owning their allocation
+ * are written by value and read back into allocations owned by the record read,
+ * such that they're released along with the partition or probe record holding them. */
+
+static inline bool _owns_allocation(SIValue v) {
+    return (v.type & (T_STRING | T_NODE | T_EDGE)) &&
+           (v.allocation == M_SELF || v.allocation == M_VOLATILE);
 }
 
-/* `idx` is an actual variable in the caller function.
- * Using it in a macro like this is rather ugly,
- * but the macro passed to QSORT must accept only 2 arguments. */
-#define RECORD_SORT_ON_ENTRY(a, b) (_record_islt((*a), (*b), idx))
-
-// Performs binary search, returns the leftmost index of a match.
-static int64_t _binarySearchLeftmost(Record *array, int join_key_idx, SIValue v) {    
-    int64_t recordCount = array_len(array);
-    int64_t pos;
-    int64_t left = 0;
-    int64_t right = recordCount;
-    while(left < right) {
-        pos = (right + left) / 2;
-        SIValue x = Record_GetScalar(array[pos], join_key_idx);
-        if(SIValue_Order(x, v) < 0) left = pos + 1;
-        else right = pos;
+static void _write_value(FILE *f, SIValue v) {
+    bool by_value = _owns_allocation(v);
+    fwrite(&v.type, sizeof(v.type), 1, f);
+    fwrite(&by_value, sizeof(by_value), 1, f);
+    if(!by_value) {
+        fwrite(&v.longval, sizeof(v.longval), 1, f);
+        return;
+    }
+
+    if(v.type == T_STRING) {
+        uint32_t len = strlen(v.stringval);
+        fwrite(&len, sizeof(len), 1, f);
+        fwrite(v.stringval, 1, len, f);
+    } else {
+        fwrite(v.ptrval, (v.type == T_NODE) ? sizeof(Node) : sizeof(Edge), 1, f);
     }
-    return left;
 }
 
-// Performs binary search, returns the rightmost index of a match.
-static int64_t _binarySearchRightmost(Record *array, int64_t array_len, int join_key_idx, SIValue v) {
-    int64_t pos;
-    int64_t left = 0;
-    int64_t right = array_len;
-    while(left < right) {
-        pos = (right + left) / 2;
-        SIValue x = Record_GetScalar(array[pos], join_key_idx);
-        if(SIValue_Order(v, x) < 0) right = pos;
-        else left = pos + 1;
+static SIValue _read_value(FILE *f) {
+    SIValue v = SI_NullVal();
+    bool by_value;
+    size_t read = fread(&v.type, sizeof(v.type), 1, f);
+    read += fread(&by_value, sizeof(by_value), 1, f);
+    assert(read == 2);
+
+    bool heap_type = (v.type & (T_STRING | T_NODE | T_EDGE));
+    v.allocation = heap_type ? M_CONST : M_NONE;
+    if(!by_value) {
+        read = fread(&v.longval, sizeof(v.longval), 1, f);
+        assert(read == 1);
+        return v;
     }
-    return right -1;
+
+    if(v.type == T_STRING) {
+        uint32_t len;
+        read = fread(&len, sizeof(len), 1, f);
+        assert(read == 1);
+        v.stringval = rm_malloc(len + 1);
+        read = fread(v.stringval, 1, len, f);
+        assert(read == len);
+        v.stringval[len] = '\0';
+    } else {
+        size_t size = (v.type == T_NODE) ? sizeof(Node) : sizeof(Edge);
+        v.ptrval = rm_malloc(size);
+        read = fread(v.ptrval, size, 1, f);
+        assert(read == 1);
+    }
+    v.allocation = M_SELF;
+    return v;
 }
 
-/* Retrive the next intersecting record
- * if such exists, otherwise returns NULL. */
-static Record _get_intersecting_record(OpValueHashJoin *op) {
-    // No more intersecting records.
-    if(op->intersect_idx == -1 ||
-       op->number_of_intersections == 0) return NULL;
+static void _write_record(FILE *f, Record r) {
+    uint32_t len = Record_length(r);
+    fwrite(&len, sizeof(len), 1, f);
+    for(uint32_t i = 0; i < len; i++) {
+        RecordEntryType t = Record_GetType(r, i);
+        fwrite(&t, sizeof(t), 1, f);
+        switch(t) {
+            case REC_TYPE_NODE:
+                fwrite(Record_GetNode(r, i), sizeof(Node), 1, f);
+                break;
+            case REC_TYPE_EDGE:
+                fwrite(Record_GetEdge(r, i), sizeof(Edge), 1, f);
+                break;
+            case REC_TYPE_SCALAR:
+                _write_value(f, Record_GetScalar(r, i));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// Reads the next spilled record, returns NULL once file is depleted.
+static Record _read_record(FILE *f) {
+    uint32_t len;
+    if(fread(&len, sizeof(len), 1, f) != 1) return NULL;
+
+    Record r = Record_New(len);
+    for(uint32_t i = 0; i < len; i++) {
+        RecordEntryType t;
+        size_t read = fread(&t, sizeof(t), 1, f);
+        assert(read == 1);
+        switch(t) {
+            case REC_TYPE_NODE:
+                read = fread(Record_GetNode(r, i), sizeof(Node), 1, f);
+                assert(read == 1);
+                break;
+            case REC_TYPE_EDGE:
+                read = fread(Record_GetEdge(r, i), sizeof(Edge), 1, f);
+                assert(read == 1);
+                break;
+            case REC_TYPE_SCALAR:
+                Record_AddScalar(r, i, _read_value(f));
+                break;
+            default:
+                break;
+        }
+    }
+    return r;
+}
 
-    Record cr = op->cached_records[op->intersect_idx];
-    
-    // Update intersection trackers.
-    op->intersect_idx++;
-    op->number_of_intersections--;
+// Number of bytes held by the payload of v, if the operation keeps it alive.
+static size_t _value_memory_usage(SIValue v) {
+    // Constant values are owned by someone else, e.g. the query's AST.
+    if(v.allocation == M_CONST || v.allocation == M_NONE) return 0;
+    switch(v.type) {
+        case T_STRING:
+            // Volatile strings are written by value once spilled,
+            // interned strings are referenced until the record is freed.
+            return strlen(v.stringval) + 1;
+        case T_NODE:
+            return sizeof(Node);
+        case T_EDGE:
+            return sizeof(Edge);
+        default:
+            return 0;
+    }
+}
 
-    return cr;
+// Approximates the number of bytes cached record r holds.
+static size_t _record_memory_usage(Record r) {
+    uint len = Record_length(r);
+    size_t usage = sizeof(Entry) * len;     // Entries.
+    usage += sizeof(Entry);                 // Header entry, holding length and pool.
+    usage += sizeof(Record);                // Slot within cached records.
+    usage += sizeof(int64_t);               // Slot within chain.
+    for(uint i = 0; i < len; i++) {
+        if(r[i].type == REC_TYPE_SCALAR) usage += _value_memory_usage(r[i].value.s);
+    }
+    return usage;
 }
 
-/* Look up first intersecting cached record CR position.
- * Returns false if intersecting record is found. */
-static bool _set_intersection_idx(OpValueHashJoin *op, SIValue v) {
-    op->intersect_idx = -1;
-    op->number_of_intersections = 0;
-    uint record_count = array_len(op->cached_records);
+// Replaces the payload v owns along with another holder with a copy of its own.
+static void _own_value(SIValue *v) {
+    if(v->allocation != M_SELF) return;
+    if(v->type == T_STRING) {
+        *v = SI_DuplicateStringVal(v->stringval);
+    } else if(v->type & (T_NODE | T_EDGE)) {
+        size_t size = (v->type == T_NODE) ? sizeof(Node) : sizeof(Edge);
+        v->ptrval = memcpy(rm_malloc(size), v->ptrval, size);
+    }
+}
 
-    int64_t leftmost_idx = _binarySearchLeftmost(op->cached_records, op->join_value_rec_idx, v);
-    if(leftmost_idx >= record_count) return false;
-
-    // Make sure value was found.
-    Record r = op->cached_records[leftmost_idx];
-    SIValue x = Record_GetScalar(r, op->join_value_rec_idx);
-    if(SIValue_Compare(x, v) != 0) return false; // Value wasn't found.
-
-    /* Value was found
-     * idx points to the first intersecting record.
-     * update number_of_intersections to count how many
-     * records share the same value. */
-    op->intersect_idx = leftmost_idx;
-
-    /* Count how many records share the same node.
-     * reduce search space by truncating left bound */
-    int64_t rightmost_idx = _binarySearchRightmost(op->cached_records + leftmost_idx,
-                                                   record_count - leftmost_idx,
-                                                   op->join_value_rec_idx,
-                                                   v);
-    // Compensate index.
-    rightmost_idx += leftmost_idx;
-    // +1 consider rightmost_idx == leftmost_idx.
-    op->number_of_intersections = rightmost_idx - leftmost_idx + 1;
-    assert(op->number_of_intersections > 0);
+/* Combines the cached record at idx with the right hand side record,
+ * the cached and right hand side records keep the values they own
+ * while the joined record owns copies of them. */
+static Record _join_records(OpValueHashJoin *op, int64_t idx) {
+    Record r = Record_Clone(op->cached_records[idx]);
+    Record_Merge(&r, op->rhs_rec);
 
-    return true;
+    uint len = Record_length(r);
+    for(uint i = 0; i < len; i++) {
+        if(r[i].type == REC_TYPE_SCALAR) _own_value(&r[i].value.s);
+    }
+    return r;
 }
 
-/* Sorts cached records by joined value. */
-void _sort_cached_records(OpValueHashJoin *op) {
-    uint idx = op->join_value_rec_idx;
-    QSORT(Record, op->cached_records,
-          array_len(op->cached_records), RECORD_SORT_ON_ENTRY);
+// NULLs (and pointers) never compare equal, records joining on them are dropped.
+static inline bool _joinable(SIValue v) {
+    return SI_TYPE(v) != T_NULL && SI_TYPE(v) != T_PTR;
 }
 
-/* Caches all records coming from left branch. */
-void _cache_records(OpValueHashJoin *op) {
-    assert(op->cached_records == NULL);
+static inline SIValue _cached_join_value(const OpValueHashJoin *op, int64_t idx) {
+    return Record_GetScalar(op->cached_records[idx], op->join_value_rec_idx);
+}
 
-    OpBase *left_child = op->op.children[0];
+static void _table_init(OpValueHashJoin *op) {
+    op->slot_count = JOIN_TABLE_INITIAL_SLOTS;
+    op->used_slots = 0;
+    op->slots = rm_malloc(sizeof(JoinTableSlot) * op->slot_count);
+    for(uint64_t i = 0; i < op->slot_count; i++) op->slots[i].head = -1;
     op->cached_records = array_new(Record, 32);
+    op->chain = array_new(int64_t, 32);
+    op->memory_usage = sizeof(JoinTableSlot) * op->slot_count;
+}
+
+// Frees cached records and hash table.
+static void _table_free(OpValueHashJoin *op) {
+    if(op->cached_records) {
+        uint record_count = array_len(op->cached_records);
+        for(uint i = 0; i < record_count; i++) Record_Free(op->cached_records[i]);
+        array_free(op->cached_records);
+        op->cached_records = NULL;
+    }
+    if(op->chain) {
+        array_free(op->chain);
+        op->chain = NULL;
+    }
+    if(op->slots) {
+        rm_free(op->slots);
+        op->slots = NULL;
+    }
+    op->slot_count = 0;
+    op->used_slots = 0;
+    op->memory_usage = 0;
+}
+
+// Locates the slot of join value v, or the empty slot it should occupy.
+static JoinTableSlot *_table_locate(OpValueHashJoin *op, SIValue v, uint64_t hash) {
+    uint64_t mask = op->slot_count - 1;
+    for(uint64_t i = hash & mask;; i = (i + 1) & mask) {
+        JoinTableSlot *slot = op->slots + i;
+        if(slot->head == -1) return slot;
+        if(slot->hash == hash && SIValue_Compare(_cached_join_value(op, slot->head), v) == 0) return slot;
+    }
+}
+
+static void _table_grow(OpValueHashJoin *op) {
+    JoinTableSlot *old_slots = op->slots;
+    uint64_t old_slot_count = op->slot_count;
+
+    op->memory_usage += sizeof(JoinTableSlot) * old_slot_count;
+    op->slot_count *= 2;
+    op->slots = rm_malloc(sizeof(JoinTableSlot) * op->slot_count);
+    for(uint64_t i = 0; i < op->slot_count; i++) op->slots[i].head = -1;
+
+    // Slots hold distinct values, reinsert by probing for a free slot.
+    uint64_t mask = op->slot_count - 1;
+    for(uint64_t i = 0; i < old_slot_count; i++) {
+        if(old_slots[i].head == -1) continue;
+        uint64_t j = old_slots[i].hash & mask;
+        while(op->slots[j].head != -1) j = (j + 1) & mask;
+        op->slots[j] = old_slots[i];
+    }
+    rm_free(old_slots);
+}
+
+// Adds record r, extended with its join value at join_value_rec_idx, to table.
+static void _table_insert(OpValueHashJoin *op, Record r, uint64_t hash) {
+    int64_t idx = array_len(op->cached_records);
+    op->cached_records = array_append(op->cached_records, r);
+    op->chain = array_append(op->chain, -1);
+    op->memory_usage += _record_memory_usage(r);
+
+    JoinTableSlot *slot = _table_locate(op, Record_GetScalar(r, op->join_value_rec_idx), hash);
+    if(slot->head != -1) {
+        // Value already present, prepend to its chain.
+        op->chain[idx] = slot->head;
+        slot->head = idx;
+        return;
+    }
+
+    slot->hash = hash;
+    slot->head = idx;
+    op->used_slots++;
+    if(op->used_slots > op->slot_count * JOIN_TABLE_MAX_LOAD) _table_grow(op);
+}
+
+// Returns the first cached record joining on v, -1 if there's none.
+static int64_t _table_lookup(OpValueHashJoin *op, SIValue v) {
+    if(op->used_slots == 0) return -1;
+    return _table_locate(op, v, SIValue_HashCode(v))->head;
+}
+
+// Moves cached records to on-disk partitions.
+static bool _spill(OpValueHashJoin *op) {
+    for(int i = 0; i < VALUE_HASH_JOIN_PARTITION_COUNT; i++) {
+        op->build_partitions[i] = tmpfile();
+        op->probe_partitions[i] = tmpfile();
+        if(!op->build_partitions[i] || !op->probe_partitions[i]) {
+            // Can't spill, keep on joining in memory.
+            for(int j = 0; j <= i; j++) {
+                if(op->build_partitions[j]) fclose(op->build_partitions[j]);
+                if(op->probe_partitions[j]) fclose(op->probe_partitions[j]);
+                op->build_partitions[j] = NULL;
+                op->probe_partitions[j] = NULL;
+            }
+            return false;
+        }
+    }
+
+    uint record_count = array_len(op->cached_records);
+    for(uint i = 0; i < record_count; i++) {
+        Record r = op->cached_records[i];
+        uint64_t hash = SIValue_HashCode(Record_GetScalar(r, op->join_value_rec_idx));
+        _write_record(op->build_partitions[JOIN_PARTITION(hash)], r);
+    }
+    _table_free(op);
+    op->spilled = true;
+    return true;
+}
+
+/* Caches all records coming from left branch,
+ * spilling to disk once memory limit is exceeded. */
+static void _build(OpValueHashJoin *op) {
+    OpBase *left_child = op->op.children[0];
+    bool can_spill = (_memory_limit > 0);
+    _table_init(op);
+    op->built = true;
 
     Record r = left_child->consume(left_child);
     if(!r) return;
-    
+
     op->join_value_rec_idx = Record_length(r);
     int extended_rec_len = Record_length(r) + 1;
 
@@ -128,23 +332,110 @@ void _cache_records(OpValueHashJoin *op) {
     do {
         // Evaluate joined expression.
         SIValue v = AR_EXP_Evaluate(op->lhs_exp, r);
+        if(!_joinable(v)) {
+            Record_Free(r);
+            continue;
+        }
+
+        // An alias evaluates to the value its record holds, the join value keeps a copy of its own.
+        if(op->lhs_exp->type == AR_EXP_OPERAND && op->lhs_exp->operand.type == AR_EXP_VARIADIC &&
+           op->lhs_exp->operand.variadic.entity_prop == NULL) _own_value(&v);
 
         // Add joined value to record.
         Record_Extend(&r, extended_rec_len);
         Record_AddScalar(r, op->join_value_rec_idx, v);
 
+        uint64_t hash = SIValue_HashCode(v);
+        if(op->spilled) {
+            _write_record(op->build_partitions[JOIN_PARTITION(hash)], r);
+            Record_Free(r);
+            continue;
+        }
+
         // Cache record.
-        op->cached_records = array_append(op->cached_records, r);
+        _table_insert(op, r, hash);
+        if(can_spill && op->memory_usage > _memory_limit) {
+            // Don't retry if spilling failed.
+            can_spill = _spill(op);
+        }
     } while((r = left_child->consume(left_child)));
+
+    if(!op->spilled) return;
+
+    // Partition right branch by join value.
+    OpBase *right_child = op->op.children[1];
+    while((r = right_child->consume(right_child))) {
+        SIValue v = AR_EXP_Evaluate(op->rhs_exp, r);
+        if(_joinable(v)) {
+            uint64_t hash = SIValue_HashCode(v);
+            _write_record(op->probe_partitions[JOIN_PARTITION(hash)], r);
+        }
+        Record_Free(r);
+    }
+    op->partition_idx = -1;
+}
+
+/* Loads the next spilled partition into memory,
+ * returns false once all partitions were joined. */
+static bool _load_next_partition(OpValueHashJoin *op) {
+    if(op->partition_idx >= 0) {
+        fclose(op->probe_partitions[op->partition_idx]);
+        op->probe_partitions[op->partition_idx] = NULL;
+    }
+
+    _table_free(op);
+    op->partition_idx++;
+    if(op->partition_idx == VALUE_HASH_JOIN_PARTITION_COUNT) return false;
+
+    _table_init(op);
+    FILE *build = op->build_partitions[op->partition_idx];
+    rewind(build);
+    Record r;
+    while((r = _read_record(build))) {
+        _table_insert(op, r, SIValue_HashCode(Record_GetScalar(r, op->join_value_rec_idx)));
+    }
+    fclose(build);
+    op->build_partitions[op->partition_idx] = NULL;
+
+    rewind(op->probe_partitions[op->partition_idx]);
+    return true;
+}
+
+// Retrieves the next right hand side record, NULL once depleted.
+static Record _next_probe_record(OpValueHashJoin *op) {
+    if(!op->spilled) {
+        OpBase *right_child = op->op.children[1];
+        return right_child->consume(right_child);
+    }
+
+    while(op->partition_idx < VALUE_HASH_JOIN_PARTITION_COUNT) {
+        if(op->partition_idx >= 0) {
+            Record r = _read_record(op->probe_partitions[op->partition_idx]);
+            if(r) return r;
+        }
+        if(!_load_next_partition(op)) break;
+    }
+    return NULL;
+}
+
+static void _close_partitions(OpValueHashJoin *op) {
+    for(int i = 0; i < VALUE_HASH_JOIN_PARTITION_COUNT; i++) {
+        if(op->build_partitions[i]) fclose(op->build_partitions[i]);
+        if(op->probe_partitions[i]) fclose(op->probe_partitions[i]);
+        op->build_partitions[i] = NULL;
+        op->probe_partitions[i] = NULL;
+    }
+    op->spilled = false;
 }
 
+
 /* String representation of operation */
 static int ValueHashJoinToString(const OpBase *ctx, char *buff, uint buff_len) {
     const OpValueHashJoin *op = (const OpValueHashJoin*)ctx;
-    
+
     char *exp_str = NULL;
-    
-    int offset = 0;    
+
+    int offset = 0;
     offset += snprintf(buff + offset, buff_len-offset, "%s | ", op->op.name);
 
     AR_EXP_ToString(op->lhs_exp, &exp_str);
@@ -162,14 +453,12 @@ static int ValueHashJoinToString(const OpBase *ctx, char *buff, uint buff_len) {
 
 /* Creates a new valueHashJoin operation */
 OpBase *NewValueHashJoin(AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp) {
-    OpValueHashJoin *valueHashJoin = malloc(sizeof(OpValueHashJoin));
+    OpValueHashJoin *valueHashJoin = calloc(1, sizeof(OpValueHashJoin));
     valueHashJoin->rhs_rec = NULL;
     valueHashJoin->lhs_exp = lhs_exp;
     valueHashJoin->rhs_exp = rhs_exp;
     valueHashJoin->intersect_idx = -1;
-    valueHashJoin->cached_records = NULL;
     valueHashJoin->join_value_rec_idx = -1;
-    valueHashJoin->number_of_intersections = 0;
 
     // Set our Op operations
     OpBase_Init(&valueHashJoin->op);
@@ -181,7 +470,7 @@ OpBase *NewValueHashJoin(AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp) {
     valueHashJoin->op.consume = ValueHashJoinConsume;
     valueHashJoin->op.toString = ValueHashJoinToString;
 
-    return (OpBase*)valueHashJoin;    
+    return (OpBase*)valueHashJoin;
 }
 
 OpResult ValueHashJoinInit(OpBase *ctx) {
@@ -189,71 +478,52 @@ OpResult ValueHashJoinInit(OpBase *ctx) {
     return OP_OK;
 }
 
-/* Produce a record by joining 
- * records coming from the left and right hand side 
+/* Produce a record by joining
+ * records coming from the left and right hand side
  * of this operation. */
 Record ValueHashJoinConsume(OpBase *opBase) {
     OpValueHashJoin *op = (OpValueHashJoin*)opBase;
-    OpBase *right_child = op->op.children[1];
 
     // Eager, pull from left branch until depleted.
-    if(op->cached_records == NULL) {
-        _cache_records(op);
-        // Sort cache on intersect node ID.
-        _sort_cached_records(op);
-    }
+    if(!op->built) _build(op);
 
     /* Try to produce a record:
      * given a right hand side record R,
      * evaluate V = exp on R,
-     * see if there are any cached records
-     * which V evaluated to V:
-     * X in cached_records and X[idx] = V
+     * lookup cached records X which joined on V,
      * return merged record:
      * X merged with R. */
+    while(true) {
+        if(op->intersect_idx != -1) {
+            int64_t idx = op->intersect_idx;
+            op->intersect_idx = op->chain[idx];
+            return _join_records(op, idx);
+        }
 
-    Record l;
-    if(op->number_of_intersections > 0) {
-        while((l = _get_intersecting_record(op))) {
-            /* Merge into cached records to avoid 
-             * record extension */
-            Record_Merge(&l, op->rhs_rec);            
-            return Record_Clone(l);
+        /* If we're here there are no more
+         * left hand side records which intersect with R
+         * discard R. */
+        if(op->rhs_rec) {
+            Record_Free(op->rhs_rec);
+            op->rhs_rec = NULL;
         }
-    }
 
-    /* If we're here there are no more
-     * left hand side records which intersect with R
-     * discard R. */
-    if(op->rhs_rec) Record_Free(op->rhs_rec);
+        // Nothing to join with.
+        if(!op->spilled && op->used_slots == 0) return NULL;
 
-    /* Try to get new right hand side record
-     * which intersect with a left hand side record. */
-    while(true) {
-        // Pull from right branch.
-        op->rhs_rec = right_child->consume(right_child);
+        op->rhs_rec = _next_probe_record(op);
         if(!op->rhs_rec) return NULL;
 
         // Get value on which we're intersecting.
         SIValue v = AR_EXP_Evaluate(op->rhs_exp, op->rhs_rec);
-
-        // No intersection, discard R.
-        if(!_set_intersection_idx(op, v)) {
-            Record_Free(op->rhs_rec);
-            continue;
-        }
-
-        // Found atleast one intersecting record.
-        l = _get_intersecting_record(op);
-        Record_Merge(&l, op->rhs_rec);
-        return Record_Clone(l);
+        if(_joinable(v)) op->intersect_idx = _table_lookup(op, v);
     }
 }
 
 OpResult ValueHashJoinReset(OpBase *ctx) {
     OpValueHashJoin *op = (OpValueHashJoin*)ctx;
     op->intersect_idx = -1;
-    op->number_of_intersections = 0;
+    op->built = false;
 
     // Clear cached records.
     if(op->rhs_rec) {
@@ -261,15 +531,8 @@ OpResult ValueHashJoinReset(OpBase *ctx) {
         op->rhs_rec = NULL;
     }
 
-    if(op->cached_records) {
-        uint record_count = array_len(op->cached_records);
-        for(uint i = 0; i < record_count; i++) {
-            Record r = op->cached_records[i];
-            Record_Free(r);
-        }
-        array_free(op->cached_records);
-        op->cached_records = NULL;
-    }
+    _table_free(op);
+    _close_partitions(op);
 
     return OP_OK;
 }
@@ -280,14 +543,8 @@ void ValueHashJoinFree(OpBase *ctx) {
     // Free cached records.
     if(op->rhs_rec) Record_Free(op->rhs_rec);
 
-    if(op->cached_records) {
-        uint record_count = array_len(op->cached_records);
-        for(uint i = 0; i < record_count; i++) {
-            Record r = op->cached_records[i];
-            Record_Free(r);
-        }
-        array_free(op->cached_records);
-    }
+    _table_free(op);
+    _close_partitions(op);
     if(op->lhs_exp) AR_EXP_Free(op->lhs_exp);
     if(op->rhs_exp) AR_EXP_Free(op->rhs_exp);
 }
@@ -6,20 +6,49 @@
 
 #pragma once
 
+#include <stdio.h>
 #include "op.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
+#define VALUE_HASH_JOIN_DEFAULT_MEMORY_LIMIT (256 << 20)   // Default number of bytes a join may cache.
+#define VALUE_HASH_JOIN_PARTITION_COUNT 32                 // Number of on-disk partitions once spilled.
+
+/* Open addressing hash table slot, one per distinct join value.
+ * Cached records sharing a join value are chained starting at head. */
+typedef struct {
+    uint64_t hash;      // Join value hash code.
+    int64_t head;       // First cached record joining on value, -1 if slot is empty.
+} JoinTableSlot;
+
+/* Joins left (build) and right (probe) streams on value equality.
+ * Left hand side records are cached in a hash table keyed by their join value,
+ * right hand side records probe it. Once the cache exceeds the join memory limit
+ * both streams are partitioned by join value hash into temporary files
+ * which are then joined one partition at a time (grace hash join). */
 typedef struct {
     OpBase op;
     Record rhs_rec;                     // Right hand side record.
     AR_ExpNode *lhs_exp;                // Left hand side expression to join on.
     AR_ExpNode *rhs_exp;                // Right hand side expression to join on.
-    int64_t intersect_idx;              // Current intersection, < number_of_intersections
-    Record *cached_records;             // Cached left hand side records.
     uint join_value_rec_idx;            // position on joined expression within record.
-    int64_t number_of_intersections;    // Number of intersections located.
+    bool built;                         // Has left hand side been consumed.
+    Record *cached_records;             // Cached left hand side records.
+    int64_t *chain;                     // Next cached record sharing join value, -1 terminated.
+    JoinTableSlot *slots;               // Hash table over cached records.
+    uint64_t slot_count;                // Number of slots, power of 2.
+    uint64_t used_slots;                // Number of occupied slots.
+    size_t memory_usage;                // Approximated number of bytes held by cache.
+    int64_t intersect_idx;              // Next cached record intersecting rhs_rec, -1 if none.
+    bool spilled;                       // Has cache been partitioned to disk.
+    int partition_idx;                  // Partition currently joined.
+    FILE *build_partitions[VALUE_HASH_JOIN_PARTITION_COUNT];    // Spilled left hand side records.
+    FILE *probe_partitions[VALUE_HASH_JOIN_PARTITION_COUNT];    // Spilled right hand side records.
 } OpValueHashJoin;
 
+/* Sets the number of bytes a single join may cache
+ * before spilling to disk, 0 disables spilling. */
+void ValueHashJoin_SetMemoryLimit(size_t limit);
+
 /* Creates a new ValueHashJoin operation */
 OpBase *NewValueHashJoin(AR_ExpNode *lhs_exp, AR_ExpNode *rhs_exp);
 
@@ -0,0 +1,254 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include <assert.h>
+
+#include "../../util/arr.h"
+#include "../../parser/ast.h"
+#include "../../graph/graphcontext.h"
+#include "./op_var_len_reach.h"
+
+static int VarLenReachToString(const OpBase *ctx, char *buff, uint buff_len) {
+    const VarLenReach *op = (const VarLenReach*)ctx;
+
+    int offset = 0;
+    offset += snprintf(buff + offset, buff_len-offset, "%s | ", op->op.name);
+    offset += Node_ToString(op->ae->src_node, buff + offset, buff_len - offset);
+    offset += snprintf(buff + offset, buff_len-offset, "-");
+    offset += Edge_ToString(op->ae->edge, buff + offset, buff_len - offset);
+    offset += snprintf(buff + offset, buff_len-offset, "->");
+    offset += Node_ToString(op->ae->dest_node, buff + offset, buff_len - offset);
+    if(op->op.stats) offset += TraverseBatch_ToString(&op->batch, buff + offset, buff_len - offset);
+    return offset;
+}
+
+// Grows records buffer and matrices to accommodate current batch size.
+static void _VarLenReach_FitBatch(VarLenReach *op) {
+    if(op->batch.size <= op->recordsCap) return;
+
+    GrB_Index ncols;
+    GrB_Matrix_ncols(&ncols, op->frontier);
+    op->recordsCap = op->batch.size;
+    op->records = rm_realloc(op->records, sizeof(Record) * op->recordsCap);
+    GxB_Matrix_resize(op->frontier, op->recordsCap, ncols);
+    GxB_Matrix_resize(op->next, op->recordsCap, ncols);
+    GxB_Matrix_resize(op->reached, op->recordsCap, ncols);
+}
+
+/* Computes the nodes reachable from each buffered source record,
+ * given frontier F holding a row per source, hop i computes
+ * N<!R> = F * A, R += N, F = N
+ * until maxHops hops were performed or no new nodes were discovered. */
+static void _VarLenReach_Expand(VarLenReach *op) {
+    AlgebraicExpressionOperand operand = op->ae->operands[0];
+    GrB_Matrix A = operand.operand;
+    bool transpose = operand.transpose;
+
+    // Prefer transposed matrix maintained by the graph.
+    if(transpose && !operand.free) {
+        GrB_Matrix T = Graph_GetTransposedMatrix(op->g, A);
+        if(T) {
+            A = T;
+            transpose = false;
+        }
+    }
+    GrB_Matrix DP = (operand.free) ? NULL : Graph_GetDeltaMatrix(op->g, A);
+
+    // Only produce nodes which weren't reached yet.
+    GrB_Descriptor desc;
+    GrB_Descriptor_new(&desc);
+    GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
+    GrB_Descriptor_set(desc, GrB_OUTP, GrB_REPLACE);
+    if(transpose) GrB_Descriptor_set(desc, GrB_INP1, GrB_TRAN);
+
+    GrB_Descriptor delta_desc = NULL;
+    if(DP) {
+        GrB_Descriptor_new(&delta_desc);
+        GrB_Descriptor_set(delta_desc, GrB_MASK, GrB_SCMP);
+        if(transpose) GrB_Descriptor_set(delta_desc, GrB_INP1, GrB_TRAN);
+    }
+
+    GrB_Index nvals;
+    GrB_Matrix_clear(op->reached);
+    for(unsigned int hop = 1; hop <= op->maxHops; hop++) {
+        GrB_mxm(op->next, op->reached, GrB_NULL, Rg_structured_bool, op->frontier, A, desc);
+        if(DP) GrB_mxm(op->next, op->reached, GrB_LOR, Rg_structured_bool, op->frontier, DP, delta_desc);
+
+        // Nothing new discovered.
+        GrB_Matrix_nvals(&nvals, op->next);
+        if(nvals == 0) break;
+
+        GrB_eWiseAdd_Matrix_Semiring(op->reached, GrB_NULL, GrB_NULL, Rg_structured_bool,
+                                     op->reached, op->next, GrB_NULL);
+
+        // Newly discovered nodes form the next frontier.
+        GrB_Matrix t = op->frontier;
+        op->frontier = op->next;
+        op->next = t;
+    }
+
+    GrB_Descriptor_free(&desc);
+    if(delta_desc) GrB_Descriptor_free(&delta_desc);
+    GrB_Matrix_clear(op->frontier);
+    GrB_Matrix_clear(op->next);
+
+    // Zero length paths reach their source.
+    if(op->minHops == 0) {
+        for(uint i = 0; i < op->recordsLen; i++) {
+            Node *src = Record_GetNode(op->records[i], op->srcNodeIdx);
+            GrB_Matrix_setElement_BOOL(op->reached, true, i, ENTITY_GET_ID(src));
+        }
+    }
+
+    GrB_Matrix_nvals(&nvals, op->reached);
+    TraverseBatch_Update(&op->batch, op->recordsLen, nvals);
+
+    if(op->iter == NULL) GxB_MatrixTupleIter_new(&op->iter, op->reached);
+    else GxB_MatrixTupleIter_reuse(op->iter, op->reached);
+    op->recordIdx = 0;
+}
+
+// Produces the next record out of the current batch, NULL if batch was depleted.
+static Record _VarLenReach_Emit(VarLenReach *op) {
+    if(op->expandInto) {
+        // Emit records whose destination is reachable from their source.
+        while(op->recordIdx < op->recordsLen) {
+            uint i = op->recordIdx++;
+            Record r = op->records[i];
+            Node *dest = Record_GetNode(r, op->destNodeIdx);
+            bool x;
+            if(GrB_Matrix_extractElement_BOOL(&x, op->reached, i, ENTITY_GET_ID(dest)) == GrB_SUCCESS) {
+                return Record_Clone(r);
+            }
+        }
+        return NULL;
+    }
+
+    if(!op->iter) return NULL;
+
+    bool depleted;
+    GrB_Index row;
+    GrB_Index col;
+    GxB_MatrixTupleIter_next(op->iter, &row, &col, &depleted);
+    if(depleted) return NULL;
+
+    Record r = op->records[row];
+    Graph_GetNode(op->g, col, Record_GetNode(r, op->destNodeIdx));
+    return Record_Clone(r);
+}
+
+OpBase* NewVarLenReachOp(AlgebraicExpression *ae, unsigned int minHops, unsigned int maxHops,
+                         bool expandInto, Graph *g, AST *ast) {
+    // Paths of two or more hops might reach a node only by reusing an edge.
+    assert(ae && ae->edge && ae->operand_count == 1 && minHops <= 1 && minHops <= maxHops);
+
+    VarLenReach *op = calloc(1, sizeof(VarLenReach));
+    op->g = g;
+    op->ae = ae;
+    op->expandInto = expandInto;
+    op->srcNodeIdx = AST_GetAliasID(ast, ae->src_node->alias);
+    op->destNodeIdx = AST_GetAliasID(ast, ae->dest_node->alias);
+    op->minHops = minHops;
+    op->maxHops = maxHops;
+    TraverseBatch_Init(&op->batch, ast->limitNode ? ast->limitNode->limit : 0);
+    op->recordsCap = op->batch.size;
+    op->records = rm_calloc(op->recordsCap, sizeof(Record));
+
+    // Set our Op operations
+    OpBase_Init(&op->op);
+    op->op.name = "Variable Length Reachability";
+    op->op.type = OPType_VAR_LEN_REACH;
+    op->op.init = VarLenReachInit;
+    op->op.consume = VarLenReachConsume;
+    op->op.reset = VarLenReachReset;
+    op->op.rebind = VarLenReachRebind;
+    op->op.toString = VarLenReachToString;
+    op->op.free = VarLenReachFree;
+
+    if(!expandInto) {
+        op->op.modifies = NewVector(char*, 1);
+        Vector_Push(op->op.modifies, ae->dest_node->alias);
+    }
+
+    return (OpBase*)op;
+}
+
+OpResult VarLenReachInit(OpBase *opBase) {
+    VarLenReach *op = (VarLenReach*)opBase;
+    size_t required_dim = Graph_RequiredMatrixDim(op->g);
+    GrB_Matrix_new(&op->frontier, GrB_BOOL, op->recordsCap, required_dim);
+    GrB_Matrix_new(&op->next, GrB_BOOL, op->recordsCap, required_dim);
+    GrB_Matrix_new(&op->reached, GrB_BOOL, op->recordsCap, required_dim);
+    return OP_OK;
+}
+
+Record VarLenReachConsume(OpBase *opBase) {
+    VarLenReach *op = (VarLenReach*)opBase;
+    OpBase *child = op->op.children[0];
+
+    Record r;
+    while(!(r = _VarLenReach_Emit(op))) {
+        // Current batch depleted, free its records.
+        for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+
+        // Ask child operation for a new batch of sources.
+        _VarLenReach_FitBatch(op);
+        for(op->recordsLen = 0; op->recordsLen < op->batch.size; op->recordsLen++) {
+            Record childRecord = OpBase_Consume(child);
+            if(!childRecord) break;
+
+            op->records[op->recordsLen] = childRecord;
+            // F[i, srcId] = true.
+            Node *n = Record_GetNode(childRecord, op->srcNodeIdx);
+            GrB_Matrix_setElement_BOOL(op->frontier, true, op->recordsLen, ENTITY_GET_ID(n));
+        }
+
+        // Depleted.
+        if(op->recordsLen == 0) return NULL;
+        _VarLenReach_Expand(op);
+    }
+
+    return r;
+}
+
+OpResult VarLenReachReset(OpBase *ctx) {
+    VarLenReach *op = (VarLenReach*)ctx;
+    for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+    op->recordsLen = 0;
+    op->recordIdx = 0;
+    if(op->iter) {
+        GxB_MatrixTupleIter_free(op->iter);
+        op->iter = NULL;
+    }
+    if(op->frontier) GrB_Matrix_clear(op->frontier);
+    if(op->reached) GrB_Matrix_clear(op->reached);
+    TraverseBatch_Reset(&op->batch);
+    return OP_OK;
+}
+
+void VarLenReachRebind(OpBase *ctx) {
+    VarLenReach *op = (VarLenReach*)ctx;
+    AlgebraicExpression_Rebind(op->ae);
+
+    // Graph might have grown since frontier matrices were created.
+    GrB_Index dim = Graph_RequiredMatrixDim(op->g);
+    if(op->frontier) GxB_Matrix_resize(op->frontier, op->recordsCap, dim);
+    if(op->next) GxB_Matrix_resize(op->next, op->recordsCap, dim);
+    if(op->reached) GxB_Matrix_resize(op->reached, op->recordsCap, dim);
+}
+
+void VarLenReachFree(OpBase *ctx) {
+    VarLenReach *op = (VarLenReach*)ctx;
+    if(op->iter) GxB_MatrixTupleIter_free(op->iter);
+    if(op->frontier) GrB_Matrix_free(&op->frontier);
+    if(op->next) GrB_Matrix_free(&op->next);
+    if(op->reached) GrB_Matrix_free(&op->reached);
+    if(op->ae) AlgebraicExpression_Free(op->ae);
+    if(op->records) {
+        for(uint i = 0; i < op->recordsLen; i++) Record_Free(op->records[i]);
+        rm_free(op->records);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __OP_VAR_LEN_REACH_H
+#define __OP_VAR_LEN_REACH_H
+
+#include "op.h"
+#include "../traverse_batch.h"
+#include "../../graph/graph.h"
+#include "../../arithmetic/algebraic_expression.h"
+
+/* Variable length traversal which only determines reachability:
+ * rather than enumerating every path from a source node
+ * it computes the set of nodes reachable within minHops..maxHops
+ * hops, expanding a frontier one hop at a time for a batch of
+ * source nodes at once. Each reachable node is produced once per
+ * source, as such this operation replaces a variable length traversal
+ * only when the number of paths leading to a node is irrelevant. */
+typedef struct {
+    OpBase op;
+    Graph *g;
+    AlgebraicExpression *ae;
+    bool expandInto;                /* Both src and dest already resolved. */
+    int srcNodeIdx;                 /* Node set by operation. */
+    int destNodeIdx;                /* Node set by operation. */
+    unsigned int minHops;           /* Minimum number of hops to perform. */
+    unsigned int maxHops;           /* Maximum number of hops to perform. */
+    GrB_Matrix frontier;            /* Nodes discovered at current hop, row per source. */
+    GrB_Matrix next;                /* Nodes discovered at next hop, row per source. */
+    GrB_Matrix reached;             /* Nodes reachable from each source. */
+    GxB_MatrixTupleIter *iter;      /* Iterator over reached. */
+    Record *records;                /* Buffered source records. */
+    uint recordsCap;                /* Number of records buffer and matrices can hold. */
+    uint recordsLen;                /* Number of buffered records. */
+    uint recordIdx;                 /* Next record to check, expand into only. */
+    TraverseBatch batch;            /* Number of source records to process at once. */
+} VarLenReach;
+
+/* Creates a reachability operation from expression ae,
+ * the single operand of ae is the traversed relation matrix. */
+OpBase* NewVarLenReachOp(AlgebraicExpression *ae, unsigned int minHops, unsigned int maxHops,
+                         bool expandInto, Graph *g, AST *ast);
+OpResult VarLenReachInit(OpBase *opBase);
+Record VarLenReachConsume(OpBase *opBase);
+OpResult VarLenReachReset(OpBase *ctx);
+void VarLenReachRebind(OpBase *ctx);
+void VarLenReachFree(OpBase *ctx);
+
+#endif
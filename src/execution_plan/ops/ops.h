@@ -14,6 +14,8 @@
 #include "op_filter.h"
 #include "op_node_by_label_scan.h"
 #include "op_index_scan.h"
+#include "op_ordered_index_scan.h"
+#include "op_edge_index_seek.h"
 #include "op_update.h"
 #include "op_traverse.h"
 #include "op_conditional_traverse.h"
@@ -31,3 +33,5 @@
 #include "op_node_by_id_seek.h"
 #include "op_procedure_call.h"
 #include "op_value_hash_join.h"
+#include "op_var_len_reach.h"
+#include "op_shortest_path.h"
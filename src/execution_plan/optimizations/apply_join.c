@@ -16,6 +16,17 @@ static bool _applicableFilter(const FT_FilterNode *f) {
     return (f->t == FT_N_PRED && f->pred.op == EQ);
 }
 
+/* Returns the planner's estimate of the number of records
+ * produced by branch, negative if branch wasn't estimated. */
+static double _estimated_rows(const OpBase *branch) {
+    if(branch->estimated_rows >= 0) return branch->estimated_rows;
+    for(int i = 0; i < branch->childCount; i++) {
+        double rows = _estimated_rows(branch->children[i]);
+        if(rows >= 0) return rows;
+    }
+    return -1;
+}
+
 // Collects all consecutive filters beneath given op.
 static Filter** _locate_filters(OpBase *cp) {
     OpBase *parent = cp->parent;
@@ -152,12 +163,21 @@ void applyJoin(ExecutionPlan *plan) {
 
                 /* In order to reduce value-hash-join cache size
                  * prefer to cache a branch which will produce the smallest number
-                 * of records, currently prefer a branch with a filter. */
+                 * of records, as estimated by the planner, when branches
+                 * were not estimated prefer a branch with a filter. */
                 OpBase *left_branch = cp->children[0];
                 OpBase *right_branch = cp->children[1];
-                bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
-                bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);                
-                if(!left_branch_filtered && right_branch_filtered) {
+                double left_rows = _estimated_rows(left_branch);
+                double right_rows = _estimated_rows(right_branch);
+                bool swap;
+                if(left_rows >= 0 && right_rows >= 0) {
+                    swap = (right_rows < left_rows);
+                } else {
+                    bool left_branch_filtered = (ExecutionPlan_LocateOp(left_branch, OPType_FILTER) != NULL);
+                    bool right_branch_filtered = (ExecutionPlan_LocateOp(right_branch, OPType_FILTER) != NULL);
+                    swap = (!left_branch_filtered && right_branch_filtered);
+                }
+                if(swap) {
                     // Swap branches!
                     cp->children[0] = right_branch;
                     cp->children[1] = left_branch;
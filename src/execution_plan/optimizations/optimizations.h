@@ -10,13 +10,14 @@
 #include "./reduce_filters.h"
 #include "./traverse_order.h"
 #include "./utilize_indices.h"
-#include "./select_entry_point.h"
+#include "./order_by_index.h"
 #include "./reduce_scans.h"
 #include "./relocate_op.h"
 #include "./reduce_count.h"
 #include "./reduce_distinct.h"
 #include "./seek_by_id.h"
 #include "./reduce_traversal.h"
+#include "./reduce_var_len_traversal.h"
 #include "./apply_join.h"
 
 #endif
@@ -28,9 +28,16 @@ void optimizePlan(ExecutionPlan *plan, AST *ast) {
      * into an expand into operation. */
     reduceTraversal(plan, ast);
 
+    /* Replace variable length traversals with reachability computations
+     * when the number of paths leading to a node is irrelevant. */
+    reduceVarLenTraversal(plan, ast);
+
     /* Relocate sort, skip, limit operations. */
     relocateOperations(plan);
 
+    /* Replace scan and sort with an index ordered scan. */
+    orderByIndex(plan, ast);
+
     /* Try to reduce distinct if it follows aggregation. */
     reduceDistinct(plan);
 
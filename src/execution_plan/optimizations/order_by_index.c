@@ -0,0 +1,89 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "order_by_index.h"
+#include "../ops/ops.h"
+#include "../../util/arr.h"
+
+/* Returns the scan operation feeding sort through its projection,
+ * as long as none of the operations in between reorders records. */
+static OpBase* _locateOrderedScan(OpBase *sort) {
+    OpBase *op = sort->children[0];
+    if(op->type == OPType_DISTINCT) op = op->children[0];
+    if(op->type != OPType_PROJECT) return NULL;
+
+    op = op->children[0];
+    while(op->type == OPType_FILTER) op = op->children[0];
+
+    if(op->type != OPType_NODE_BY_LABEL_SCAN && op->type != OPType_INDEX_SCAN) return NULL;
+    // Scan is fed by another stream.
+    if(op->childCount > 0) return NULL;
+    return op;
+}
+
+void orderByIndex(ExecutionPlan *plan, AST *ast) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+
+    // Return immediately if the graph has no indices
+    if(!GraphContext_HasIndices(gc)) return;
+
+    OpSort *sort = (OpSort*)ExecutionPlan_LocateOp(plan->root, OPType_SORT);
+    if(!sort) return;
+
+    // Expecting a single sort expression of the form n.property.
+    if(array_len(sort->expressions) != 1) return;
+    AR_ExpNode *exp = sort->expressions[0];
+    if(exp->type != AR_EXP_OPERAND || exp->operand.type != AR_EXP_VARIADIC) return;
+    const char *alias = exp->operand.variadic.entity_alias;
+    const char *prop = exp->operand.variadic.entity_prop;
+    if(!prop) return;
+
+    OpBase *scan = _locateOrderedScan((OpBase*)sort);
+    if(!scan) return;
+
+    if(scan->type == OPType_NODE_BY_LABEL_SCAN) {
+        NodeByLabelScan *labelScan = (NodeByLabelScan*)scan;
+        Node *n = labelScan->node;
+        if(strcmp(n->alias, alias) != 0) return;
+
+        // Hash indices are unordered.
+        Index *idx = GraphContext_GetIndex(gc, n->label, prop);
+        if(!idx || Index_IsHashIndex(idx)) return;
+
+        OpBase *orderedScan = NewOrderedIndexScanOp(labelScan->g, n, idx, sort->direction, ast);
+        orderedScan->estimated_rows = scan->estimated_rows;
+        ExecutionPlan_ReplaceOp(plan, scan, orderedScan);
+        OpBase_Free(scan);
+    } else {
+        /* Index scans already traverse a single skiplist or B+tree in ascending order,
+         * filters folded into the scan reject values of any other type.
+         * Hash index lookups are unordered. */
+        IndexScan *indexScan = (IndexScan*)scan;
+        Node *n = indexScan->n;
+        if(strcmp(n->alias, alias) != 0) return;
+        // Parameterised scans rebuild their iterator on reset.
+        if(indexScan->bounds) return;
+
+        Index *idx = GraphContext_GetIndex(gc, n->label, prop);
+        if(!idx) return;
+        IndexIter *iter = indexScan->iter;
+        if(iter->sl_iter) {
+            skiplist *sl = iter->sl_iter->sl;
+            if(sl != idx->string_sl && sl != idx->numeric_sl) return;
+        } else if(iter->bt_iter) {
+            const BPTree *bt = iter->bt_iter->tree;
+            if(bt != idx->string_bt && bt != idx->numeric_bt) return;
+        } else {
+            return;
+        }
+
+        if(sort->direction == DIR_DESC) IndexIter_Reverse(indexScan->iter);
+    }
+
+    // Records arrive ordered.
+    ExecutionPlan_RemoveOp(plan, (OpBase*)sort);
+    OpBase_Free((OpBase*)sort);
+}
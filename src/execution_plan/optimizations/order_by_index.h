@@ -0,0 +1,16 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* The orderByIndex optimization finds Sort operations ordering by a single
+ * indexed property of a scanned node, where the scan is the only stream feeding
+ * the projection. The scan is replaced by one producing nodes in index order
+ * and the Sort operation is removed, such that a following Limit stops
+ * the scan once enough records were produced. */
+void orderByIndex(ExecutionPlan *plan, AST *ast);
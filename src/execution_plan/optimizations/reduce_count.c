@@ -121,6 +121,8 @@ bool _reduceNodeCount(ExecutionPlan *plan, AST *ast){
     OpBase_Free((OpBase*)opAggregate);
 
     ExecutionPlan_AddOp((OpBase*)opResult, opProject);
+    // Count is computed once, plan can't be reused as the graph changes.
+    plan->disposable = true;
     return true;
 }
 
@@ -199,7 +201,11 @@ void _reduceEdgeCount(ExecutionPlan *plan, AST *ast) {
     if(condTraverse->edgeRelationTypes[0] != GRAPH_NO_RELATION) {
         uint64_t edges = 0;
         for (int i = 0; i < edgeRelationCount; i++) {
-            edges += _countRelationshipEdges(Graph_GetRelationMap(gc->g, condTraverse->edgeRelationTypes[i]));
+            GrB_Matrix relation_map = Graph_GetRelationMap(gc->g, condTraverse->edgeRelationTypes[i]);
+            edges += _countRelationshipEdges(relation_map);
+            // Count edges pending within the relation's delta map.
+            GrB_Matrix delta_map = Graph_GetDeltaMatrix(gc->g, relation_map);
+            if(delta_map) edges += _countRelationshipEdges(delta_map);
         }
         edgeCount = SI_LongVal(edges);
     } else {
@@ -233,6 +239,8 @@ void _reduceEdgeCount(ExecutionPlan *plan, AST *ast) {
     OpBase_Free((OpBase *)opAggregate);
 
     ExecutionPlan_AddOp((OpBase *)opResult, opProject);
+    // Count is computed once, plan can't be reused as the graph changes.
+    plan->disposable = true;
 }
 
 void reduceCount(ExecutionPlan *plan, AST *ast) {
@@ -85,6 +85,7 @@ void reduceTraversal(ExecutionPlan *plan, AST *ast) {
         if(op->type == OPType_CONDITIONAL_TRAVERSE) {
             CondTraverse *traverse = (CondTraverse*)op;
             OpBase *expand_into = NewExpandIntoOp(traverse->algebraic_expression, ast);                                                  
+            expand_into->estimated_rows = op->estimated_rows;
 
             // Set traverse algebraic_expression to NULL to avoid early free.
             traverse->algebraic_expression = NULL;
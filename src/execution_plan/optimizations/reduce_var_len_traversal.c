@@ -0,0 +1,50 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "reduce_var_len_traversal.h"
+
+#include "../../util/arr.h"
+#include "../ops/op_var_len_reach.h"
+#include "../ops/op_cond_var_len_traverse.h"
+
+// Returns true if query is indifferent to the number of times a row is produced.
+static bool _multiplicity_irrelevant(const AST *ast) {
+    if(ast->createNode || ast->mergeNode || ast->setNode || ast->deleteNode) return false;
+    if(!ast->returnNode || !ast->returnNode->distinct) return false;
+    return !ReturnClause_ContainsAggregation(ast->returnNode);
+}
+
+void reduceVarLenTraversal(ExecutionPlan *plan, AST *ast) {
+    if(!_multiplicity_irrelevant(ast)) return;
+
+    OPType t = OPType_CONDITIONAL_VAR_LEN_TRAVERSE | OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO;
+    OpBase **traversals = ExecutionPlan_LocateOps(plan->root, t);
+    uint traversals_count = array_len(traversals);
+
+    for(uint i = 0; i < traversals_count; i++) {
+        CondVarLenTraverse *traverse = (CondVarLenTraverse*)traversals[i];
+        // Traversal belongs to a different query segment.
+        if(traverse->ast != ast) continue;
+        // Nothing to traverse, traversal returns quickly.
+        if(traverse->relationIDsCount == 0) continue;
+        if(traverse->minHops > 1) continue;
+
+        OpBase *reach = NewVarLenReachOp(traverse->ae,
+                                         traverse->minHops,
+                                         traverse->maxHops,
+                                         traverse->expandInto,
+                                         traverse->g,
+                                         ast);
+        reach->estimated_rows = traverse->op.estimated_rows;
+
+        // Set traverse algebraic expression to NULL to avoid early free.
+        traverse->ae = NULL;
+        ExecutionPlan_ReplaceOp(plan, (OpBase*)traverse, reach);
+        OpBase_Free((OpBase*)traverse);
+    }
+
+    array_free(traversals);
+}
@@ -0,0 +1,27 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#pragma once
+
+#include "../execution_plan.h"
+
+/* Variable length traversals enumerate every path from their source,
+ * producing a record per path. When a query only returns distinct rows
+ * and performs no aggregations or updates, the number of paths reaching
+ * a node makes no difference, in which case the traversal is replaced
+ * by a reachability operation, computing the set of reachable nodes
+ * hop by hop.
+ *
+ * Consider the following query:
+ * MATCH (a)-[:KNOWS*1..4]->(b) RETURN DISTINCT b
+ * Conditional Variable Length Traverse produces b once for every path
+ * of length 1..4 connecting a to b, while Variable Length Reachability
+ * produces b once for every a.
+ *
+ * Paths may not repeat edges, with a minimum of 2 hops or more a node
+ * might only be reachable by reusing an edge, in which case
+ * the traversal is kept. */
+void reduceVarLenTraversal(ExecutionPlan *plan, AST *ast);
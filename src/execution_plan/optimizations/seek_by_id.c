@@ -8,11 +8,14 @@
 #include "../../util/arr.h"
 #include "../ops/op_filter.h"
 #include "../ops/op_index_scan.h"
+#include "../ops/op_ordered_index_scan.h"
 #include "../ops/op_all_node_scan.h"
 #include "../ops/op_node_by_id_seek.h"
 #include "../ops/op_node_by_label_scan.h"
 
-static bool _idFilter(FT_FilterNode *f, int *rel, EntityID *id, bool *reverse) {
+/* Matches filters comparing an entity ID against a constant or a query parameter,
+ * param is set to the parameter's name or NULL for constants. */
+static bool _idFilter(FT_FilterNode *f, int *rel, EntityID *id, const char **param, bool *reverse) {
     if(f->t == FT_N_COND) return false;
     if(f->pred.op == NE) return false;
     
@@ -37,10 +40,17 @@ static bool _idFilter(FT_FilterNode *f, int *rel, EntityID *id, bool *reverse) {
         return false;
     }
 
-    // Make sure ID is compared to a constant.
-    if(operand->type != AR_EXP_CONSTANT) return false;
-    if(SI_TYPE(operand->constant) != T_INT64) return false;
-    *id = SI_GET_NUMERIC(operand->constant);
+    // Make sure ID is compared to a constant or a parameter.
+    *param = NULL;
+    if(operand->type == AR_EXP_PARAM) {
+        *param = operand->param;
+    } else {
+        if(operand->type != AR_EXP_CONSTANT) return false;
+        if(SI_TYPE(operand->constant) != T_INT64) return false;
+        // Negative IDs can't be represented as a range.
+        if(operand->constant.longval < 0) return false;
+        *id = SI_GET_NUMERIC(operand->constant);
+    }
 
     // Make sure applied function is ID.
     if(strcasecmp(op->func_name, "id")) return false;
@@ -93,6 +103,9 @@ static void _setupIdRange(int rel, EntityID id, bool reverse, NodeID *minId, Nod
 }
 
 void _reduceTap(ExecutionPlan *plan, const AST *ast, OpBase *tap) {
+    // Edge index seeks resolve an edge along with its endpoints.
+    if(tap->type == OPType_EDGE_INDEX_SEEK) return;
+
     if(tap->type & OP_SCAN) {
         /* See if there's a filter of the form
          * ID(n) = X
@@ -104,9 +117,11 @@ void _reduceTap(ExecutionPlan *plan, const AST *ast, OpBase *tap) {
 
             int rel;
             EntityID id;
+            const char *param;
             bool reverse;
-            if(_idFilter(f, &rel, &id, &reverse)) {
+            if(_idFilter(f, &rel, &id, &param, &reverse)) {
                 int nodeRecIdx = -1;
+                Node *n = NULL;
                 NodeID minId = ID_RANGE_UNBOUND;
                 NodeID maxId = ID_RANGE_UNBOUND;
                 bool inclusiveMin = false;
@@ -119,21 +134,45 @@ void _reduceTap(ExecutionPlan *plan, const AST *ast, OpBase *tap) {
                         break;
                     case OPType_NODE_BY_LABEL_SCAN:                
                         nodeRecIdx = ((NodeByLabelScan*)tap)->nodeRecIdx;
+                        n = ((NodeByLabelScan*)tap)->node;
                         break;
                     case OPType_INDEX_SCAN:
                         nodeRecIdx = ((IndexScan*)tap)->nodeRecIdx;
+                        n = ((IndexScan*)tap)->n;
+                        break;
+                    case OPType_ORDERED_INDEX_SCAN:
+                        nodeRecIdx = ((OrderedIndexScan*)tap)->nodeRecIdx;
+                        n = ((OrderedIndexScan*)tap)->n;
                         break;
                     default:
                         assert(false);
                 }
 
+                // The seek replaces a scan over labeled nodes.
+                int label = GRAPH_NO_LABEL;
+                if(n && n->label) {
+                    Schema *s = GraphContext_GetSchema(GraphContext_GetFromTLS(), n->label, SCHEMA_NODE);
+                    label = s ? s->id : GRAPH_UNKNOWN_LABEL;
+                }
+
+                if(param) {
+                    /* Parameters are resolved whenever the seek is reset,
+                     * the filter is kept as values aren't necessarily integers. */
+                    opNodeByIdSeek = NewOpNodeByIdSeekParamOp(ast, nodeRecIdx, label, param, rel, reverse);
+                    ExecutionPlan_ReplaceOp(plan, tap, opNodeByIdSeek);
+                    OpBase_Free(tap);
+                    break;
+                }
+
                 _setupIdRange(rel, id, reverse, &minId, &maxId, &inclusiveMin, &inclusiveMax);
-                opNodeByIdSeek = NewOpNodeByIdSeekOp(ast, nodeRecIdx, minId, maxId,
+                opNodeByIdSeek = NewOpNodeByIdSeekOp(ast, nodeRecIdx, label, minId, maxId,
                     inclusiveMin, inclusiveMax);
 
                 // Managed to reduce!
                 ExecutionPlan_ReplaceOp(plan, tap, opNodeByIdSeek);
                 ExecutionPlan_RemoveOp(plan, (OpBase*)filter);
+                OpBase_Free(tap);
+                OpBase_Free((OpBase*)filter);
                 break;
             }
 
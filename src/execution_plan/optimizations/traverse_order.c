@@ -6,253 +6,544 @@
 
 #include "./traverse_order.h"
 #include "../../util/arr.h"
-#include "../../util/vector.h"
 #include "../../util/rmalloc.h"
+#include "../../index/index.h"
+#include "../../graph/graph_statistics.h"
+#include <float.h>
 #include <assert.h>
 
-#define T 1     // Transpose penalty.
-#define F 4 * T // Filter score.
-#define L 2 * T // Label score.
+/* Estimates used in the absence of graph statistics. */
+#define DEFAULT_NODE_COUNT 1            // Number of nodes.
+#define DEFAULT_FANOUT 1                // Number of connections per node.
+#define DEFAULT_LABEL_SELECTIVITY 0.5   // Fraction of nodes carrying a label.
+
+/* Fraction of entities expected to pass a filter. */
+#define EQ_SELECTIVITY 0.1              // Equality filter on a non indexed attribute.
+#define RANGE_SELECTIVITY 0.3           // Range filter.
+#define FILTER_SELECTIVITY 0.5          // Any other filter.
+
+#define VAR_LEN_MAX_HOPS 4              // Maximum number of hops accounted for in variable length traversals.
+#define TRANSPOSE_COST 0.001            // Cost of traversing an operand in reverse, breaks ties.
+
+/* Arrangements of up to DP_MAX_EXPRESSIONS expressions are searched exhaustively,
+ * longer traversals are arranged greedily. */
+#define DP_MAX_EXPRESSIONS 12
+
+// A conjunct of the filter tree, applied once all of its aliases are resolved.
+typedef struct {
+    rax *aliases;           // Aliases filter refers to.
+    double selectivity;     // Fraction of rows expected to pass filter.
+    bool applied;           // Filter applied in current arrangement.
+} TraversalFilter;
+
+// Cardinality estimator, built from graph statistics.
+typedef struct {
+    GraphContext *gc;               // Graph context, NULL if unavailable.
+    const GraphStatistics *stats;   // Graph statistics, NULL if unavailable.
+    TraversalFilter *filters;       // Filter conjuncts.
+    Node **nodes;                   // Nodes mentioned by expressions.
+    const char **resolved;          // Aliases resolved by current arrangement.
+} Estimator;
 
 typedef AlgebraicExpression** Arrangement;
 
-// Create a new arrangement.
-Arrangement Arrangement_New(uint size) {
-    return rm_malloc(sizeof(AlgebraicExpression*) * size);
+// Cheapest known arrangement of a subset of expressions.
+typedef struct {
+    double cost;            // Overall number of rows produced.
+    double rows;            // Number of rows produced by the last expression.
+    int last;               // Last expression evaluated, -1 if no arrangement is known.
+    bool enter_at_dest;     // First expression is entered at its destination.
+} SubsetPlan;
+
+/* A 1 hop traversals where either the source node
+ * or destination node is labeled, can't be the opening expression
+ * in an arrangement.
+ * Consider: MATCH (a:L0)-[:R*]->(b:L1)
+ * [L0] * [R] * [L1] but because R is a variable length traversal
+ * we're dealing with 3 different expressions:
+ * exp0: [L0]
+ * exp1: [R]
+ * exp2: [L1]
+ * the arrangement where [R] is the first expression:
+ * exp0: [R]
+ * exp1: [L0]
+ * exp2: [L1]
+ * Isn't valid, as currently the first expression is converted
+ * into a scan operation. */
+static bool _valid_opening(const AlgebraicExpression *exp) {
+    return !((exp->src_node->label || exp->dest_node->label) &&
+             exp->edge &&
+             exp->operand_count == 1);
 }
 
-// Clone arrangement.
-Arrangement Arrangement_Clone(const Arrangement arrangement, uint size) {
-    assert(arrangement);
-    Arrangement clone = Arrangement_New(size);
-    memcpy(clone, arrangement, sizeof(AlgebraicExpression*) * size);
-    return clone;
+// Returns node's label count.
+static double _Estimator_LabelCount(const Estimator *est, int label) {
+    // Label doesn't exists.
+    if(label == GRAPH_UNKNOWN_LABEL) return 0;
+    if(!est->stats || label == GRAPH_NO_LABEL || label >= array_len(est->stats->label_counts)) {
+        return DEFAULT_NODE_COUNT * DEFAULT_LABEL_SELECTIVITY;
+    }
+    return est->stats->label_counts[label];
 }
 
-// Print arrangement.
-void Arrangement_Print(Arrangement arrangement, uint size) {
-    printf("Arrangement_Print\n");
-    for(uint i = 0; i < size; i++) {
-        AlgebraicExpression *exp = arrangement[i];
-        printf("%d, src: %s, dest: %s\n", i, exp->src_node->alias, exp->dest_node->alias);
-    }
+// Returns number of nodes expected to match n, ignoring filters.
+static double _Estimator_NodeCardinality(const Estimator *est, const Node *n) {
+    if(n->label) return _Estimator_LabelCount(est, n->labelID);
+    return (est->stats) ? est->stats->node_count : DEFAULT_NODE_COUNT;
 }
 
-// Free arrangement.
-void Arrangement_Free(Arrangement arrangement) {
-    assert(arrangement);
-    rm_free(arrangement);
+// Returns the fraction of nodes carrying label.
+static double _Estimator_LabelSelectivity(const Estimator *est, int label) {
+    if(!est->stats) return DEFAULT_LABEL_SELECTIVITY;
+    if(est->stats->node_count == 0) return 0;
+    return _Estimator_LabelCount(est, label) / est->stats->node_count;
 }
 
-// Computes x!
-static unsigned long factorial(uint x) {
-    unsigned long res = 1;
-    for(int i = 2; i <= x; i++) res *= i;
-    return res;
+/* Returns the expected number of connections per node
+ * following relation operand, outgoing or incoming. */
+static double _Estimator_Fanout(const Estimator *est, int relation, bool outgoing) {
+    // Relation doesn't exists.
+    if(relation == GRAPH_UNKNOWN_RELATION) return 0;
+    if(!est->stats) return DEFAULT_FANOUT;
+
+    const RelationStatistics *stats = &est->stats->adjacency;
+    if(relation != GRAPH_NO_RELATION && relation < array_len(est->stats->relations)) {
+        stats = est->stats->relations + relation;
+    }
+    return (outgoing) ? RelationStatistics_AvgOutDegree(stats) : RelationStatistics_AvgInDegree(stats);
 }
 
-// Function to swap values at two pointers.
-static void swap(Arrangement exps, uint i, uint  j) {
-    AlgebraicExpression *temp;
-    temp = exps[i]; 
-    exps[i] = exps[j];
-    exps[j] = temp;
+// Locate node by alias.
+static const Node *_Estimator_GetNode(const Estimator *est, const char *alias) {
+    for(uint i = 0; i < array_len(est->nodes); i++) {
+        if(strcmp(est->nodes[i]->alias, alias) == 0) return est->nodes[i];
+    }
+    return NULL;
 }
 
-// Computes all permutations of set exps.
-void permute(Arrangement set, int l, int r, Arrangement **permutations) {
-    int i;
-    if (l == r) {
-        Arrangement permutation = Arrangement_Clone(set, r+1);
-        *permutations = array_append(*permutations, permutation);
-    } else {
-        for(i = l; i <= r; i++) {
-            swap(set, l, i);
-            permute(set, l + 1, r, permutations);
-            swap(set, l, i);   // backtrack.
-        }
+// Returns the fraction of rows expected to pass predicate.
+static double _Estimator_PredicateSelectivity(const Estimator *est, const FT_PredicateNode *pred) {
+    switch(pred->op) {
+        case EQ:
+            break;
+        case NE:
+            return 1 - EQ_SELECTIVITY;
+        case LT:
+        case LE:
+        case GT:
+        case GE:
+            return RANGE_SELECTIVITY;
+        default:
+            return FILTER_SELECTIVITY;
+    }
+
+    /* Equality filters of the form alias.attribute = constant
+     * are as selective as the attribute index suggests. */
+    AR_ExpNode *variadic = pred->lhs;
+    AR_ExpNode *constant = pred->rhs;
+    if(AR_EXP_GetOperandType(variadic) != AR_EXP_VARIADIC) {
+        variadic = pred->rhs;
+        constant = pred->lhs;
     }
+    if(!est->gc ||
+       AR_EXP_GetOperandType(variadic) != AR_EXP_VARIADIC ||
+       AR_EXP_GetOperandType(constant) == AR_EXP_VARIADIC ||
+       !variadic->operand.variadic.entity_prop) return EQ_SELECTIVITY;
+
+    const Node *n = _Estimator_GetNode(est, variadic->operand.variadic.entity_alias);
+    if(!n || !n->label) return EQ_SELECTIVITY;
+
+    Index *idx = GraphContext_GetIndex(est->gc, n->label, variadic->operand.variadic.entity_prop);
+    if(!idx) return EQ_SELECTIVITY;
+
+    uint64_t distinct = Index_DistinctCount(idx);
+    return (distinct > 0) ? 1.0 / distinct : 0;
 }
 
-// Computes all possible permutations of exps.
-static Arrangement* permutations(const Arrangement exps, uint exps_count) {
-    // Number of permutations of a set S is |S|!.    
-    unsigned long permutation_count = factorial(exps_count);
-    Arrangement *permutations = array_new(Arrangement, permutation_count);
+// Returns the fraction of rows expected to pass filter.
+static double _Estimator_FilterSelectivity(const Estimator *est, const FT_FilterNode *filter) {
+    if(IsNodePredicate(filter)) return _Estimator_PredicateSelectivity(est, &filter->pred);
+
+    double l = _Estimator_FilterSelectivity(est, filter->cond.left);
+    double r = _Estimator_FilterSelectivity(est, filter->cond.right);
+    if(filter->cond.op == AND) return l * r;
+    return MIN(1, l + r);
+}
 
-    // Compute permutations.
-    permute(exps, 0, exps_count-1, &permutations);
-    assert(array_len(permutations) == permutation_count);
+// Break filters into conjuncts, each applied once its aliases are resolved.
+static void _Estimator_CollectFilters(Estimator *est, const FT_FilterNode *filter) {
+    if(!filter) return;
+    if(!IsNodePredicate(filter) && filter->cond.op == AND) {
+        _Estimator_CollectFilters(est, filter->cond.left);
+        _Estimator_CollectFilters(est, filter->cond.right);
+        return;
+    }
 
-    return permutations;
+    TraversalFilter f;
+    f.aliases = FilterTree_CollectAliases(filter);
+    f.selectivity = _Estimator_FilterSelectivity(est, filter);
+    f.applied = false;
+    est->filters = array_append(est->filters, f);
 }
 
-/* A valid arrangement of expressions is one in which the ith expression
- * source or destination nodes appear in a previous expression k where k < i. */
-static bool valid_arrangement(const Arrangement arrangement, uint exps_count) {
-    AlgebraicExpression *exp = arrangement[0];
-    /* A 1 hop traversals where either the source node
-     * or destination node is labeled, can't be the opening expression
-     * in an arrangement.
-     * Consider: MATCH (a:L0)-[:R*]->(b:L1)
-     * [L0] * [R] * [L1] but because R is a variable length traversal
-     * we're dealing with 3 different expressions:
-     * exp0: [L0]
-     * exp1: [R]
-     * exp2: [L1]
-     * the arrangement where [R] is the first expression:
-     * exp0: [R]
-     * exp1: [L0]
-     * exp2: [L1]
-     * Isn't valid, as currently the first expression is converted
-     * into a scan operation. */
-    if((exp->src_node->label || exp->dest_node->label) &&
-        exp->edge &&
-        exp->operand_count == 1) return false;
-
-    for(int i = 1; i < exps_count; i++) {
-        exp = arrangement[i];
-        Node *src = exp->src_node;
-        Node *dest = exp->dest_node;
-        int j = i-1;
-
-        // Scan previous expressions.
-        for(; j >= 0; j--) {
-            AlgebraicExpression *prev_exp = arrangement[j];
-            if(prev_exp->src_node == src ||
-                prev_exp->dest_node == src ||
-                prev_exp->src_node == dest ||
-                prev_exp->dest_node == dest) break;
-        }
-        /* Nither src or dest nodes are mentioned in previous expressions
-         * as such the arrangement is invalid. */
-        if(j < 0) return false;
+static void _Estimator_AddNode(Estimator *est, Node *n) {
+    for(uint i = 0; i < array_len(est->nodes); i++) {
+        if(est->nodes[i] == n) return;
     }
-    return true;
+    est->nodes = array_append(est->nodes, n);
 }
 
-static int penalty_arrangement(Arrangement arrangement, uint exp_count) {
-    int penalty = 0;
-    AlgebraicExpression *exp;
-    
-    // Account for first expression transposes.
-    exp = arrangement[0];
-    for(uint i = 0; i < exp->operand_count; i++) {
-        if(arrangement[0]->operands[i].transpose) penalty += T;
+static Estimator *_Estimator_New(AlgebraicExpression **exps, uint exps_count,
+                                 const FT_FilterNode *filters, GraphContext *gc) {
+    Estimator *est = rm_malloc(sizeof(Estimator));
+    est->gc = gc;
+    est->stats = (gc) ? Graph_Statistics(gc->g) : NULL;
+    est->nodes = array_new(Node*, exps_count + 1);
+    est->resolved = array_new(const char*, exps_count * 3);
+    est->filters = array_new(TraversalFilter, 1);
+
+    for(uint i = 0; i < exps_count; i++) {
+        _Estimator_AddNode(est, exps[i]->src_node);
+        _Estimator_AddNode(est, exps[i]->dest_node);
     }
+    _Estimator_CollectFilters(est, filters);
+    return est;
+}
 
-    for(uint i = 1; i < exp_count; i++) {
-        exp = arrangement[i];
-        bool src_resolved = false;
-        Node *src = exp->src_node;
-
-        // See if source is already resolved.
-        for(int j = i-1; j >= 0; j--) {
-            AlgebraicExpression *prev_exp = arrangement[j];
-            if(prev_exp->src_node == src || prev_exp->dest_node == src) {
-                src_resolved = true;
-                break;
+static bool _Estimator_Resolved(const Estimator *est, const char *alias) {
+    for(uint i = 0; i < array_len(est->resolved); i++) {
+        if(strcmp(est->resolved[i], alias) == 0) return true;
+    }
+    return false;
+}
+
+/* Marks alias as resolved, returns the combined selectivity
+ * of every filter which can now be applied. */
+static double _Estimator_Resolve(Estimator *est, const char *alias) {
+    if(!alias || _Estimator_Resolved(est, alias)) return 1;
+    est->resolved = array_append(est->resolved, alias);
+
+    double selectivity = 1;
+    for(uint i = 0; i < array_len(est->filters); i++) {
+        TraversalFilter *f = est->filters + i;
+        if(f->applied) continue;
+
+        bool ready = true;
+        raxIterator it;
+        raxStart(&it, f->aliases);
+        raxSeek(&it, "^", NULL, 0);
+        while(ready && raxNext(&it)) {
+            ready = false;
+            for(uint j = 0; j < array_len(est->resolved); j++) {
+                const char *r = est->resolved[j];
+                if(strlen(r) == it.key_len && strncmp(r, (char*)it.key, it.key_len) == 0) {
+                    ready = true;
+                    break;
+                }
             }
         }
+        raxStop(&it);
 
-        // dest_node must be resolved as we're working with valid arrangemet.
-        if(src_resolved) {
-            // Count how many transposes are performed.
-            for(uint k = 0; k < exp->operand_count; k++) {
-                if(exp->operands[k].transpose) penalty += T;
-            }
-        } else {
-            // Count how many transposes we require to perform.
-            for(uint k = 0; k < exp->operand_count; k++) {
-                if(!exp->operands[k].transpose) penalty += T;
-            }
+        if(ready) {
+            f->applied = true;
+            selectivity *= f->selectivity;
         }
     }
-
-    return penalty;
+    return selectivity;
 }
 
-static int reward_arrangement(Arrangement arrangement, uint exp_count, const FT_FilterNode *filters) {
-    // Arrangement_Print(arrangement, exp_count);
-    int reward = 0;
-    rax *filtered_entities = FilterTree_CollectAliases(filters);
+static void _Estimator_Clear(Estimator *est) {
+    array_clear(est->resolved);
+    for(uint i = 0; i < array_len(est->filters); i++) est->filters[i].applied = false;
+}
 
-    // A bit naive at the moment.
-    for(uint i = 0; i < exp_count; i++) {
-        AlgebraicExpression *exp = arrangement[i];
-        char *src_alias = exp->src_node->alias;
-        char *dest_alias = exp->dest_node->alias;
+static void _Estimator_Free(Estimator *est) {
+    for(uint i = 0; i < array_len(est->filters); i++) raxFree(est->filters[i].aliases);
+    array_free(est->filters);
+    array_free(est->nodes);
+    array_free(est->resolved);
+    rm_free(est);
+}
 
-        if(raxFind(filtered_entities, (unsigned char*)src_alias, strlen(src_alias)) != raxNotFound) {
-            reward += F * (exp_count - i);
-            raxRemove(filtered_entities, (unsigned char*)src_alias, strlen(src_alias), NULL);
+/* Returns the expected number of destination nodes reached
+ * from a single source node by evaluating exp, forward from source
+ * to destination or in reverse, skip_entry_label excludes the label
+ * operand of the node we start from, as it was applied by a scan.
+ * transposes is incremented by the number of operands traversed in reverse. */
+static double _Estimator_ExpressionFanout(const Estimator *est, const AlgebraicExpression *exp,
+                                          bool forward, bool skip_entry_label, uint *transposes) {
+    double fanout = 1;
+    uint count = exp->operand_count;
+
+    for(uint i = 0; i < count; i++) {
+        const AlgebraicExpressionOperand *op = exp->operands + i;
+        if(op->diagonal) {
+            bool entry = (forward) ? (i == 0) : (i == count - 1);
+            if(!(entry && skip_entry_label)) fanout *= _Estimator_LabelSelectivity(est, op->schema_id);
+            continue;
         }
-        if(raxFind(filtered_entities, (unsigned char*)dest_alias, strlen(dest_alias)) != raxNotFound) {
-            reward += F * (exp_count - i);
-            raxRemove(filtered_entities, (unsigned char*)dest_alias, strlen(dest_alias), NULL);
+
+        // Traversing a transposed operand forward follows incoming connections.
+        bool outgoing = (forward != op->transpose);
+        if(!outgoing) (*transposes)++;
+        double f = _Estimator_Fanout(est, op->schema_id, outgoing);
+
+        if(exp->edge && Edge_VariableLength(exp->edge)) {
+            // Sum up nodes reached at each hop.
+            double reached = 0;
+            double hop = 1;
+            uint max_hops = MIN(exp->edge->maxHops, exp->edge->minHops + VAR_LEN_MAX_HOPS);
+            for(uint h = 0; h <= max_hops; h++) {
+                if(h >= exp->edge->minHops) reached += hop;
+                hop *= f;
+            }
+            f = reached;
         }
-        if(exp->src_node->label) reward += L * (exp_count - i);
+        fanout *= f;
     }
 
-    // printf("reward: %d\n", reward);
-    raxFree(filtered_entities);
-    return reward;
+    return fanout;
 }
 
-static int score_arrangement(Arrangement arrangement, uint exp_count, const FT_FilterNode *filters) {
-    int score = 0;
-    int penalty = penalty_arrangement(arrangement, exp_count);
-    int reward = reward_arrangement(arrangement, exp_count, filters);
-    score -= penalty;
-    score += reward;
-    return score;
+/* Starts a new arrangement at entry node,
+ * returns the number of rows produced by scanning entry. */
+static double _Estimator_Enter(Estimator *est, const Node *entry) {
+    _Estimator_Clear(est);
+    double rows = _Estimator_NodeCardinality(est, entry);
+    return rows * _Estimator_Resolve(est, entry->alias);
 }
 
-/* Given a set of algebraic expressions representing a graph traversal 
- * we pick the order in which the expressions will be evaluated 
- * taking into account filters and transposes. 
- * exps will reordered. */
-void orderExpressions(AlgebraicExpression **exps, uint exps_count, const FT_FilterNode *filters) {
-    assert(exps && exps_count > 0);
+/* Evaluates exp over rows, entry is set when exp is the opening expression
+ * entered at entry, returns the number of rows produced. */
+static double _Estimator_Step(Estimator *est, const AlgebraicExpression *exp, double rows,
+                              const Node *entry, uint *transposes) {
+    Node *src = exp->src_node;
+    Node *dest = exp->dest_node;
+    bool src_resolved = _Estimator_Resolved(est, src->alias);
+    bool dest_resolved = _Estimator_Resolved(est, dest->alias);
+    bool skip_entry_label = (entry && entry->label);
+
+    if(src != dest && src_resolved && dest_resolved) {
+        /* Both ends are known, the probability of a connection
+         * is the fraction of destinations reached from a source. */
+        double fanout = _Estimator_ExpressionFanout(est, exp, true, false, transposes);
+        double dests = _Estimator_NodeCardinality(est, dest);
+        rows *= (dests > 0) ? MIN(1, fanout / dests) : 0;
+    } else {
+        bool forward = (src_resolved || !dest_resolved);
+        rows *= _Estimator_ExpressionFanout(est, exp, forward, skip_entry_label, transposes);
+    }
+
+    rows *= _Estimator_Resolve(est, src->alias);
+    rows *= _Estimator_Resolve(est, dest->alias);
+    if(exp->edge) rows *= _Estimator_Resolve(est, exp->edge->alias);
+    return rows;
+}
 
-    // Single expression, return quickly.
-    if(exps_count == 1) return;
+/* Restores estimator state following the evaluation of
+ * the expressions at positions order[0..count) in any order. */
+static void _Estimator_Restore(Estimator *est, AlgebraicExpression **exps, const uint *order, uint count) {
+    _Estimator_Clear(est);
+    for(uint i = 0; i < count; i++) {
+        AlgebraicExpression *exp = exps[order[i]];
+        _Estimator_Resolve(est, exp->src_node->alias);
+        _Estimator_Resolve(est, exp->dest_node->alias);
+        if(exp->edge) _Estimator_Resolve(est, exp->edge->alias);
+    }
+}
+
+// Expression can follow evaluated expressions if either of its ends is resolved.
+static bool _Estimator_Connected(const Estimator *est, const AlgebraicExpression *exp) {
+    return (_Estimator_Resolved(est, exp->src_node->alias) ||
+            _Estimator_Resolved(est, exp->dest_node->alias));
+}
+
+/* Estimates the cost of evaluating arrangement, entering its first
+ * expression at either its source or destination node.
+ * Cost is the overall number of rows produced, estimates[0] is set to
+ * the number of rows produced by the entry scan, estimates[i+1] to the
+ * number of rows produced once arrangement[i] is evaluated. */
+static double _Estimator_ArrangementCost(Estimator *est, const Arrangement arrangement,
+                                         uint exps_count, bool enter_at_dest, double *estimates) {
+    uint transposes = 0;
+    AlgebraicExpression *exp = arrangement[0];
+    Node *entry = (enter_at_dest) ? exp->dest_node : exp->src_node;
+    double rows = _Estimator_Enter(est, entry);
+    double cost = rows;
+    if(estimates) estimates[0] = rows;
+
+    for(uint i = 0; i < exps_count; i++) {
+        rows = _Estimator_Step(est, arrangement[i], rows, (i == 0) ? entry : NULL, &transposes);
+        cost += rows;
+        if(estimates) estimates[i + 1] = rows;
+    }
+
+    return cost + transposes * TRANSPOSE_COST;
+}
+
+/* Opens a plan with exps[first], entered at its source or destination,
+ * records opening into plan if it is cheaper than the one recorded. */
+static void _OpenPlan(Estimator *est, AlgebraicExpression **exps, uint first, bool enter_at_dest,
+                      SubsetPlan *plan) {
+    uint transposes = 0;
+    AlgebraicExpression *exp = exps[first];
+    Node *entry = (enter_at_dest) ? exp->dest_node : exp->src_node;
+    double rows = _Estimator_Enter(est, entry);
+    double cost = rows;
+    rows = _Estimator_Step(est, exp, rows, entry, &transposes);
+    cost += rows + transposes * TRANSPOSE_COST;
+
+    if(cost < plan->cost) {
+        plan->cost = cost;
+        plan->rows = rows;
+        plan->last = first;
+        plan->enter_at_dest = enter_at_dest;
+    }
+}
+
+/* Finds the cheapest arrangement by dynamic programming over subsets
+ * of expressions, the cheapest arrangement of each subset is extended
+ * by every connected expression, exps_count <= DP_MAX_EXPRESSIONS.
+ * order is set to the chosen arrangement. */
+static bool _Arrange_DP(Estimator *est, AlgebraicExpression **exps, uint exps_count, uint *order) {
+    uint subset_count = 1 << exps_count;
+    SubsetPlan *plans = rm_malloc(sizeof(SubsetPlan) * subset_count);
+    for(uint s = 0; s < subset_count; s++) {
+        plans[s].cost = DBL_MAX;
+        plans[s].last = -1;
+        plans[s].enter_at_dest = false;
+    }
+
+    // Open with each expression.
+    for(uint i = 0; i < exps_count; i++) {
+        AlgebraicExpression *exp = exps[i];
+        if(!_valid_opening(exp)) continue;
+        _OpenPlan(est, exps, i, false, plans + (1 << i));
+        if(exp->src_node != exp->dest_node) _OpenPlan(est, exps, i, true, plans + (1 << i));
+    }
+
+    // Supersets are visited after their subsets.
+    uint members[exps_count];
+    for(uint s = 1; s < subset_count; s++) {
+        SubsetPlan *plan = plans + s;
+        if(plan->last == -1) continue;
 
-    // Compute all possible permutations of algebraic expressions.
-    Arrangement *arrangements = permutations(exps, exps_count);
-    uint arrangement_count = array_len(arrangements);
-    if(arrangement_count == 1) return;
+        uint member_count = 0;
+        for(uint i = 0; i < exps_count; i++) {
+            if(s & (1 << i)) members[member_count++] = i;
+        }
 
-    // Remove invalid arrangements.
-    Arrangement *valid_arrangements = array_new(Arrangement, arrangement_count);
-    for(int i = 0; i < arrangement_count; i++) {
-        if(valid_arrangement(arrangements[i], exps_count)) {
-            valid_arrangements = array_append(valid_arrangements, arrangements[i]);
+        for(uint i = 0; i < exps_count; i++) {
+            if(s & (1 << i)) continue;
+            _Estimator_Restore(est, exps, members, member_count);
+            if(!_Estimator_Connected(est, exps[i])) continue;
+
+            uint transposes = 0;
+            double rows = _Estimator_Step(est, exps[i], plan->rows, NULL, &transposes);
+            double cost = plan->cost + rows + transposes * TRANSPOSE_COST;
+            SubsetPlan *extended = plans + (s | (1 << i));
+            if(cost < extended->cost) {
+                extended->cost = cost;
+                extended->rows = rows;
+                extended->last = i;
+                extended->enter_at_dest = plan->enter_at_dest;
+            }
         }
     }
-    arrangement_count = array_len(valid_arrangements);
-    assert(arrangement_count > 0);
-
-    /* Score each arrangement, 
-     * keep track after arrangement with highest score. */
-    int max_score = INT_MIN;
-    Arrangement top_arrangement = valid_arrangements[0];
-
-    for(uint i = 0; i < arrangement_count; i++) {
-        Arrangement arrangement = valid_arrangements[i];
-        int score = score_arrangement(arrangement, exps_count, filters);
-        // printf("score: %d\n", score);
-        // Arrangement_Print(arrangement, exps_count);
-        if(max_score < score) {
-            max_score = score;
-            top_arrangement = arrangement;
+
+    // Walk back from the full set.
+    uint s = subset_count - 1;
+    bool enter_at_dest = plans[s].enter_at_dest;
+    bool found = (plans[s].last != -1);
+    for(int i = exps_count - 1; found && i >= 0; i--) {
+        order[i] = plans[s].last;
+        s &= ~(1 << order[i]);
+    }
+
+    rm_free(plans);
+    assert(found);
+    return enter_at_dest;
+}
+
+/* Finds an arrangement greedily, from each opening the expression
+ * producing the fewest rows is evaluated next, the cheapest of the
+ * resulting arrangements is chosen. order is set to the chosen arrangement. */
+static bool _Arrange_Greedy(Estimator *est, AlgebraicExpression **exps, uint exps_count, uint *order) {
+    double min_cost = DBL_MAX;
+    bool enter_at_dest = false;
+    uint candidate[exps_count];
+    bool evaluated[exps_count];
+
+    for(uint first = 0; first < exps_count; first++) {
+        AlgebraicExpression *exp = exps[first];
+        if(!_valid_opening(exp)) continue;
+
+        int entries = (exp->src_node == exp->dest_node) ? 1 : 2;
+        for(int j = 0; j < entries; j++) {
+            SubsetPlan plan = {DBL_MAX, 0, -1, false};
+            _OpenPlan(est, exps, first, j == 1, &plan);
+            memset(evaluated, 0, sizeof(evaluated));
+            evaluated[first] = true;
+            candidate[0] = first;
+
+            for(uint k = 1; k < exps_count; k++) {
+                int next = -1;
+                uint next_transposes = 0;
+                double next_rows = DBL_MAX;
+                for(uint i = 0; i < exps_count; i++) {
+                    if(evaluated[i]) continue;
+                    _Estimator_Restore(est, exps, candidate, k);
+                    if(!_Estimator_Connected(est, exps[i])) continue;
+
+                    uint transposes = 0;
+                    double rows = _Estimator_Step(est, exps[i], plan.rows, NULL, &transposes);
+                    if(rows < next_rows || (rows == next_rows && transposes < next_transposes)) {
+                        next = i;
+                        next_rows = rows;
+                        next_transposes = transposes;
+                    }
+                }
+                assert(next != -1);
+                evaluated[next] = true;
+                candidate[k] = next;
+                plan.rows = next_rows;
+                plan.cost += next_rows + next_transposes * TRANSPOSE_COST;
+            }
+
+            if(plan.cost < min_cost) {
+                min_cost = plan.cost;
+                enter_at_dest = plan.enter_at_dest;
+                memcpy(order, candidate, sizeof(uint) * exps_count);
+            }
         }
     }
 
-    // Update input.
-    for(uint i = 0; i < exps_count; i++) exps[i] = top_arrangement[i];
+    assert(min_cost < DBL_MAX);
+    return enter_at_dest;
+}
+
+/* Given a set of algebraic expressions representing a graph traversal
+ * we pick the order in which the expressions will be evaluated and the node
+ * the traversal starts at, minimizing the overall number of rows produced,
+ * as estimated from the graph statistics.
+ * exps will reordered. */
+void orderExpressions(AlgebraicExpression **exps, uint exps_count, const FT_FilterNode *filters,
+                      GraphContext *gc, double *estimates) {
+    assert(exps && exps_count > 0);
+
+    Estimator *est = _Estimator_New(exps, exps_count, filters, gc);
+
+    uint order[exps_count];
+    bool enter_at_dest;
+    if(exps_count <= DP_MAX_EXPRESSIONS) enter_at_dest = _Arrange_DP(est, exps, exps_count, order);
+    else enter_at_dest = _Arrange_Greedy(est, exps, exps_count, order);
+
+    // Update input, traversal starts at the first expression source.
+    AlgebraicExpression *arrangement[exps_count];
+    for(uint i = 0; i < exps_count; i++) arrangement[i] = exps[order[i]];
+    memcpy(exps, arrangement, sizeof(AlgebraicExpression*) * exps_count);
+    if(estimates) _Estimator_ArrangementCost(est, exps, exps_count, enter_at_dest, estimates);
+    if(enter_at_dest) AlgebraicExpression_Transpose(exps[0]);
 
-    // Clean up.
-    for(uint i = 0; i < arrangement_count; i++) Arrangement_Free(arrangements[i]);
-    array_free(arrangements);
+    _Estimator_Free(est);
 }
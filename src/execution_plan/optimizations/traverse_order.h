@@ -8,11 +8,20 @@
 
 #include "../execution_plan.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../graph/graphcontext.h"
 #include "../../arithmetic/algebraic_expression.h"
 
-/* Reorders exps such that exp[i] is the ith expression to evaluate. */
+/* Reorders exps such that exp[i] is the ith expression to evaluate,
+ * the first expression is transposed if it is cheaper to start
+ * traversing from its destination, arrangements are costed by estimating
+ * cardinalities from gc's graph statistics.
+ * If estimates is set, estimates[0] holds the number of rows expected from
+ * scanning exps[0] source, estimates[i+1] the number of rows expected
+ * once exps[i] is evaluated. */
 void orderExpressions(
     AlgebraicExpression **exps,     // Expressions to order.
     uint exps_count,                // Number of expressions.
-    const FT_FilterNode *filters    // Filters.
+    const FT_FilterNode *filters,   // Filters.
+    GraphContext *gc,               // Graph context, NULL to estimate without statistics.
+    double *estimates               // [optional] Estimated rows per step, exps_count + 1 entries.
 );
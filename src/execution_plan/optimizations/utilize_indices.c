@@ -19,7 +19,460 @@ int _reverseOp(int op) {
     }
 }
 
-void _locateScanFilters(NodeByLabelScan *scanOp, OpBase ***filterOps) {
+/* Extract the property, constant and relation of a filter of the form
+ * node.property [rel] constant or constant [rel] node.property,
+ * returns false if the filter doesn't compare a property against a constant. */
+static bool _filterBound(FT_FilterNode *ft, char **prop, SIValue *constVal, int *op) {
+  int lhsType = AR_EXP_GetOperandType(ft->pred.lhs);
+  int rhsType = AR_EXP_GetOperandType(ft->pred.rhs);
+  if (lhsType == AR_EXP_VARIADIC && rhsType == AR_EXP_CONSTANT) {
+    *prop = ft->pred.lhs->operand.variadic.entity_prop;
+    *constVal = ft->pred.rhs->operand.constant;
+    *op = ft->pred.op;
+  } else if (lhsType == AR_EXP_CONSTANT && rhsType == AR_EXP_VARIADIC) {
+    *constVal = ft->pred.lhs->operand.constant;
+    *prop = ft->pred.rhs->operand.variadic.entity_prop;
+    // When the constant is on the left, reverse the relation in the inequality
+    // to properly set the bounds.
+    *op = _reverseOp(ft->pred.op);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/* Extract the property, parameter and relation of a filter of the form
+ * node.property [rel] $param or $param [rel] node.property,
+ * returns false if the filter doesn't compare a property against a parameter. */
+static bool _filterParam(FT_FilterNode *ft, char **prop, const char **param, int *op) {
+  AR_ExpNode *lhs = ft->pred.lhs;
+  AR_ExpNode *rhs = ft->pred.rhs;
+  int lhsType = AR_EXP_GetOperandType(lhs);
+  int rhsType = AR_EXP_GetOperandType(rhs);
+  if (lhsType == AR_EXP_VARIADIC && rhsType == AR_EXP_PARAM) {
+    *prop = lhs->operand.variadic.entity_prop;
+    *param = rhs->operand.param;
+    *op = ft->pred.op;
+  } else if (lhsType == AR_EXP_PARAM && rhsType == AR_EXP_VARIADIC) {
+    *param = lhs->operand.param;
+    *prop = rhs->operand.variadic.entity_prop;
+    *op = _reverseOp(ft->pred.op);
+  } else {
+    return false;
+  }
+  return (*prop != NULL);
+}
+
+// Alias of the entity a filter matched by _filterBound or _filterParam refers to.
+static const char* _filterAlias(FT_FilterNode *ft) {
+  if (AR_EXP_GetOperandType(ft->pred.lhs) == AR_EXP_VARIADIC) {
+    return ft->pred.lhs->operand.variadic.entity_alias;
+  }
+  return ft->pred.rhs->operand.variadic.entity_alias;
+}
+
+/* Replace a traversal and the scan resolving its source with an edge index seek,
+ * the traversal should be fed by a node scan, possibly followed by filters on the scanned node,
+ * and traverse a single relationship type with an index matching a filter on the edge. */
+static void _utilizeEdgeIndex(ExecutionPlan *plan, AST *ast, GraphContext *gc, CondTraverse *traverse) {
+  AlgebraicExpression *ae = traverse->algebraic_expression;
+  Edge *e = ae->edge;
+  if (!e || traverse->edgeRelationCount != 1) return;
+  int relation_id = traverse->edgeRelationTypes[0];
+  if (relation_id == GRAPH_NO_RELATION) return;
+  Schema *s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
+  if (!s || Schema_IndexCount(s) == 0) return;
+
+  // Locate the scan resolving the traversal's source.
+  OpBase *scan = traverse->op.children[0];
+  while (scan->type == OPType_FILTER && scan->childCount == 1) scan = scan->children[0];
+  if (scan->childCount != 0) return;
+
+  Node *scanned;
+  if (scan->type == OPType_ALL_NODE_SCAN) scanned = ((AllNodeScan*)scan)->n;
+  else if (scan->type == OPType_NODE_BY_LABEL_SCAN) scanned = ((NodeByLabelScan*)scan)->node;
+  else return;
+  if (strcmp(scanned->alias, ae->src_node->alias)) return;
+
+  // Fold filters on the edge into an index iterator, see utilizeIndices.
+  char *filterProp = NULL;
+  SIValue constVal;
+  int op = 0;
+  Index *idx = NULL;
+  IndexIter *iter = NULL;
+
+  OpBase *current = traverse->op.parent;
+  while (current && current->type == OPType_FILTER) {
+    OpBase *next = current->parent;
+    FT_FilterNode *ft = ((Filter *)current)->filterTree;
+
+    if (IsNodePredicate(ft) &&
+        _filterBound(ft, &filterProp, &constVal, &op) &&
+        strcmp(_filterAlias(ft), e->alias) == 0 &&
+        !(idx && strcmp(idx->attribute, filterProp))) {
+
+      if (!idx) {
+        Attribute_ID attr_id = GraphContext_GetAttributeID(gc, filterProp);
+        Index *candidate = NULL;
+        if (attr_id != ATTRIBUTE_NOTFOUND) candidate = Schema_GetIndex(s, attr_id);
+        if (candidate && Index_IsHashIndex(candidate)) {
+          // Hash indices serve a single equality, see utilizeIndices.
+          if (op != EQ || !Index_SupportsValue(&constVal)) {
+            current = next;
+            continue;
+          }
+          idx = candidate;
+          iter = IndexIter_CreateLookup(idx, &constVal, 1);
+          ExecutionPlan_RemoveOp(plan, current);
+          OpBase_Free(current);
+          break;
+        }
+        idx = candidate;
+        if (idx) iter = IndexIter_Create(idx, SI_TYPE(constVal));
+      }
+
+      // Tighten the iterator range if possible
+      if (idx && IndexIter_ApplyBound(iter, &constVal, op)) {
+        // Remove filter operations that have been folded into the index seek iterator
+        ExecutionPlan_RemoveOp(plan, current);
+        OpBase_Free(current);
+      }
+    }
+
+    current = next;
+  }
+
+  // Otherwise seek by parameter filters on the edge, see _utilizeParamIndex.
+  IndexScanBound *bounds = NULL;
+  if (iter == NULL) {
+    const char *param;
+    for (current = traverse->op.parent; current && current->type == OPType_FILTER; current = current->parent) {
+      FT_FilterNode *ft = ((Filter *)current)->filterTree;
+      if (!IsNodePredicate(ft) || !_filterParam(ft, &filterProp, &param, &op)) continue;
+      if (strcmp(_filterAlias(ft), e->alias)) continue;
+      if (op != EQ && op != LT && op != LE && op != GT && op != GE) continue;
+      if (idx && strcmp(idx->attribute, filterProp)) continue;
+
+      if (!idx) {
+        Attribute_ID attr_id = GraphContext_GetAttributeID(gc, filterProp);
+        Index *candidate = NULL;
+        if (attr_id != ATTRIBUTE_NOTFOUND) candidate = Schema_GetIndex(s, attr_id);
+        if (!candidate || (Index_IsHashIndex(candidate) && op != EQ)) continue;
+        idx = candidate;
+        bounds = array_new(IndexScanBound, 1);
+      }
+
+      IndexScanBound bound = {.value = SI_NullVal(), .param = strdup(param), .op = op, .attr_idx = 0};
+      bounds = array_append(bounds, bound);
+      if (Index_IsHashIndex(idx)) break;
+    }
+    if (!idx) return;
+  }
+
+  // Edge index seek resolves the traversal's source, edge and destination.
+  OpBase *seekOp = bounds ? NewParamEdgeIndexSeekOp(gc->g, e, idx, bounds, ast) :
+                   NewEdgeIndexSeekOp(gc->g, e, idx, iter, ast);
+  seekOp->estimated_rows = traverse->op.estimated_rows;
+  ExecutionPlan_ReplaceOp(plan, scan, seekOp);
+  OpBase_Free(scan);
+  ExecutionPlan_RemoveOp(plan, (OpBase*)traverse);
+  OpBase_Free((OpBase*)traverse);
+}
+
+// Populate traverseOps array with execution plan conditional traversals.
+static void _locateTraverseOps(OpBase *root, CondTraverse ***traverseOps) {
+  if (root->type == OPType_CONDITIONAL_TRAVERSE) {
+    *traverseOps = array_append(*traverseOps, (CondTraverse*)root);
+  }
+
+  for (int i = 0; i < root->childCount; i++) {
+    _locateTraverseOps(root->children[i], traverseOps);
+  }
+}
+
+static void _utilizeEdgeIndices(ExecutionPlan *plan, AST *ast, GraphContext *gc) {
+  CondTraverse **traverseOps = array_new(CondTraverse*, 0);
+  _locateTraverseOps(plan->root, &traverseOps);
+
+  // A traversal is only replaced along with the scan feeding it.
+  uint traverseOpCount = array_len(traverseOps);
+  for (uint i = 0; i < traverseOpCount; i++) {
+    _utilizeEdgeIndex(plan, ast, gc, traverseOps[i]);
+  }
+
+  array_free(traverseOps);
+}
+
+/* Range of a composite index scan: equality filters on a prefix of the index attributes,
+ * optionally followed by an inequality filter on either side of the next attribute.
+ * Each value is either a constant or a query parameter, in which case its param is set. */
+typedef struct {
+  CompositeIndex *idx;
+  uint prefix_len;
+  SIValue prefix[COMPOSITE_INDEX_MAX_ATTRIBUTES];
+  const char *prefix_params[COMPOSITE_INDEX_MAX_ATTRIBUTES];
+  OpBase *prefix_filters[COMPOSITE_INDEX_MAX_ATTRIBUTES];
+  bool has_min;
+  bool has_max;
+  SIValue min;
+  SIValue max;
+  const char *min_param;
+  const char *max_param;
+  int min_op;
+  int max_op;
+} CompositeScanRange;
+
+// Number of index attributes constrained by range.
+static inline uint _compositeRangeWidth(const CompositeScanRange *range) {
+  return range->prefix_len + ((range->has_min || range->has_max) ? 1 : 0);
+}
+
+// Returns true if any of range's values is a query parameter.
+static bool _compositeRangeParameterised(const CompositeScanRange *range) {
+  for (uint i = 0; i < range->prefix_len; i++) {
+    if (range->prefix_params[i]) return true;
+  }
+  return ((range->has_min && range->min_param) || (range->has_max && range->max_param));
+}
+
+/* Match filters against a composite index, populating range.
+ * Only string and numeric constants can bound composite keys,
+ * parameters are checked once the scan resolves them. */
+static void _matchCompositeIndex(CompositeIndex *idx, OpBase **filterOps, CompositeScanRange *range) {
+  char *prop;
+  int op;
+  SIValue constVal;
+  const char *param;
+  uint filterOpsCount = array_len(filterOps);
+
+  range->idx = idx;
+  range->prefix_len = 0;
+  range->has_min = false;
+  range->has_max = false;
+
+  for (uint i = 0; i < idx->attr_count && i < COMPOSITE_INDEX_MAX_ATTRIBUTES; i++) {
+    const char *attribute = idx->attributes[i];
+    bool matched = false;
+
+    for (uint j = 0; j < filterOpsCount; j++) {
+      FT_FilterNode *ft = ((Filter *)filterOps[j])->filterTree;
+      param = NULL;
+      if (_filterParam(ft, &prop, &param, &op)) {
+        constVal = SI_NullVal();
+      } else if (!_filterBound(ft, &prop, &constVal, &op)) {
+        continue;
+      }
+      if (!prop || strcmp(prop, attribute)) continue;
+      if (!param && !(SI_TYPE(constVal) == T_STRING || (SI_TYPE(constVal) & SI_NUMERIC))) continue;
+
+      if (op == EQ) {
+        range->prefix[i] = constVal;
+        range->prefix_params[i] = param;
+        range->prefix_filters[i] = filterOps[j];
+        matched = true;
+        break;
+      }
+      // Range filters only apply to the attribute following the prefix.
+      if ((op == GT || op == GE) && !range->has_min) {
+        range->has_min = true;
+        range->min = constVal;
+        range->min_param = param;
+        range->min_op = op;
+      } else if ((op == LT || op == LE) && !range->has_max) {
+        range->has_max = true;
+        range->max = constVal;
+        range->max_param = param;
+        range->max_op = op;
+      }
+    }
+
+    if (!matched) return;
+    // Bounds collected on a prefix attribute are applied by their filters.
+    range->has_min = false;
+    range->has_max = false;
+    range->prefix_len++;
+  }
+}
+
+// Append a bound on a composite index attribute, constants are cloned.
+static IndexScanBound* _compositeBound(IndexScanBound *bounds, SIValue v, const char *param,
+                                       int op, uint attr_idx) {
+  IndexScanBound bound = {.value = SI_NullVal(), .param = NULL, .op = op, .attr_idx = attr_idx};
+  if (param) bound.param = strdup(param);
+  else bound.value = SI_Clone(v);
+  return array_append(bounds, bound);
+}
+
+/* Replace scan with a composite index scan resolving range's parameters
+ * whenever it is reset, filters are kept, see NewParamIndexScanOp. */
+static void _utilizeParamCompositeIndex(ExecutionPlan *plan, AST *ast, NodeByLabelScan *scanOp,
+                                        const CompositeScanRange *range) {
+  IndexScanBound *bounds = array_new(IndexScanBound, _compositeRangeWidth(range) + 1);
+  for (uint i = 0; i < range->prefix_len; i++) {
+    bounds = _compositeBound(bounds, range->prefix[i], range->prefix_params[i], EQ, i);
+  }
+  if (range->has_min) {
+    bounds = _compositeBound(bounds, range->min, range->min_param, range->min_op, range->prefix_len);
+  }
+  if (range->has_max) {
+    bounds = _compositeBound(bounds, range->max, range->max_param, range->max_op, range->prefix_len);
+  }
+
+  // The replaced label scan is owned by the index scan.
+  OpBase *indexOp = NewParamCompositeIndexScanOp(scanOp->g, scanOp->node, range->idx, bounds,
+                                                 (OpBase*)scanOp, ast);
+  indexOp->estimated_rows = scanOp->op.estimated_rows;
+  ExecutionPlan_ReplaceOp(plan, (OpBase*)scanOp, indexOp);
+}
+
+/* Replace scan with a composite index scan if a composite index
+ * constrains more attributes than a single attribute index could,
+ * or constrains any attribute if use_single is set. */
+static bool _utilizeCompositeIndex(ExecutionPlan *plan, AST *ast, GraphContext *gc,
+                                   NodeByLabelScan *scanOp, OpBase **filterOps, bool use_single) {
+  Schema *s = GraphContext_GetSchema(gc, scanOp->node->label, SCHEMA_NODE);
+  if (!s) return false;
+  unsigned short index_count = Schema_CompositeIndexCount(s);
+  if (index_count == 0) return false;
+
+  CompositeScanRange best = {0};
+  CompositeScanRange candidate;
+  for (unsigned short i = 0; i < index_count; i++) {
+    _matchCompositeIndex(s->composite_indices[i], filterOps, &candidate);
+    if (_compositeRangeWidth(&candidate) > _compositeRangeWidth(&best)) best = candidate;
+  }
+
+  uint width = _compositeRangeWidth(&best);
+  if (width == 0 || (width == 1 && !use_single)) return false;
+
+  if (_compositeRangeParameterised(&best)) {
+    _utilizeParamCompositeIndex(plan, ast, scanOp, &best);
+    return true;
+  }
+
+  // Iterator bounds are cloned, filters holding the constants can be freed.
+  IndexIter *iter = CompositeIndexIter_Create(best.idx, best.prefix, best.prefix_len,
+                                              best.has_min ? &best.min : NULL, best.min_op == GT,
+                                              best.has_max ? &best.max : NULL, best.max_op == LT);
+
+  /* Equality filters are folded into the scan,
+   * range filters are kept as the range admits values of other types. */
+  for (uint i = 0; i < best.prefix_len; i++) {
+    ExecutionPlan_RemoveOp(plan, best.prefix_filters[i]);
+    OpBase_Free(best.prefix_filters[i]);
+  }
+
+  OpBase *indexOp = NewIndexScanOp(scanOp->g, scanOp->node, iter, ast);
+  indexOp->estimated_rows = scanOp->op.estimated_rows;
+  ExecutionPlan_ReplaceOp(plan, (OpBase*)scanOp, indexOp);
+  return true;
+}
+
+/* Collect the constants of a disjunction of equalities on a single entity property,
+ * e.g. n.v = 1 OR n.v = 'a' OR 2 = n.v, returns false if filter takes any other form.
+ * This is the form IN predicates over a list of constants take. */
+static bool _disjunctionValues(FT_FilterNode *ft, const char **alias, char **prop, SIValue **values) {
+  if (ft->t == FT_N_COND) {
+    if (ft->cond.op != OR) return false;
+    return (_disjunctionValues(ft->cond.left, alias, prop, values) &&
+            _disjunctionValues(ft->cond.right, alias, prop, values));
+  }
+
+  char *filterProp;
+  SIValue constVal;
+  int op;
+  if (!_filterBound(ft, &filterProp, &constVal, &op) || op != EQ || !filterProp) return false;
+  // Values of types indices don't hold would be missed by a lookup.
+  if (!Index_SupportsValue(&constVal)) return false;
+
+  const char *filterAlias = _filterAlias(ft);
+  if (*alias == NULL) {
+    *alias = filterAlias;
+    *prop = filterProp;
+  } else if (strcmp(*alias, filterAlias) || strcmp(*prop, filterProp)) {
+    return false;
+  }
+  *values = array_append(*values, constVal);
+  return true;
+}
+
+/* Replace scan with a lookup of every constant of a disjunction of equalities,
+ * if the disjunction constrains a hash indexed property of the scanned node. */
+static bool _utilizeHashIndexDisjunction(ExecutionPlan *plan, AST *ast, GraphContext *gc,
+                                         NodeByLabelScan *scanOp, OpBase **disjunctionOps) {
+  SIValue *values = array_new(SIValue, 2);
+  uint disjunctionOpsCount = array_len(disjunctionOps);
+
+  for (uint i = 0; i < disjunctionOpsCount; i++) {
+    OpBase *opFilter = disjunctionOps[i];
+    const char *alias = NULL;
+    char *prop = NULL;
+    array_clear(values);
+    if (!_disjunctionValues(((Filter *)opFilter)->filterTree, &alias, &prop, &values)) continue;
+    if (strcmp(alias, scanOp->node->alias)) continue;
+
+    Index *idx = GraphContext_GetIndex(gc, scanOp->node->label, prop);
+    if (!idx || !Index_IsHashIndex(idx)) continue;
+
+    // Looked up values are cloned, the filter holding them can be freed.
+    IndexIter *iter = IndexIter_CreateLookup(idx, values, array_len(values));
+    ExecutionPlan_RemoveOp(plan, opFilter);
+    OpBase_Free(opFilter);
+
+    OpBase *indexOp = NewIndexScanOp(scanOp->g, scanOp->node, iter, ast);
+    indexOp->estimated_rows = scanOp->op.estimated_rows;
+    ExecutionPlan_ReplaceOp(plan, (OpBase*)scanOp, indexOp);
+    array_free(values);
+    return true;
+  }
+
+  array_free(values);
+  return false;
+}
+
+/* Replace scan with an index scan bounded by query parameters, resolved whenever
+ * the scan is reset such that a cached plan serves any parameter values.
+ * The first parameter filter on an indexed property selects the index, hash indices
+ * serve that single equality while ordered indices are bounded by every parameter
+ * filter on the property. Filters are kept, see NewParamIndexScanOp. */
+static bool _utilizeParamIndex(ExecutionPlan *plan, AST *ast, GraphContext *gc,
+                               NodeByLabelScan *scanOp, OpBase **filterOps) {
+  Index *idx = NULL;
+  IndexScanBound *bounds = NULL;
+  char *prop;
+  const char *param;
+  int op;
+
+  uint filterOpsCount = array_len(filterOps);
+  for (uint i = 0; i < filterOpsCount; i++) {
+    FT_FilterNode *ft = ((Filter *)filterOps[i])->filterTree;
+    if (!_filterParam(ft, &prop, &param, &op)) continue;
+    if (strcmp(_filterAlias(ft), scanOp->node->alias)) continue;
+    if (op != EQ && op != LT && op != LE && op != GT && op != GE) continue;
+    if (idx && strcmp(idx->attribute, prop)) continue;
+
+    if (!idx) {
+      Index *candidate = GraphContext_GetIndex(gc, scanOp->node->label, prop);
+      if (!candidate || (Index_IsHashIndex(candidate) && op != EQ)) continue;
+      idx = candidate;
+      bounds = array_new(IndexScanBound, 1);
+    }
+
+    IndexScanBound bound = {.value = SI_NullVal(), .param = strdup(param), .op = op, .attr_idx = 0};
+    bounds = array_append(bounds, bound);
+    if (Index_IsHashIndex(idx)) break;
+  }
+
+  if (!idx) return false;
+
+  // The replaced label scan is owned by the index scan.
+  OpBase *indexOp = NewParamIndexScanOp(scanOp->g, scanOp->node, idx, bounds, (OpBase*)scanOp, ast);
+  indexOp->estimated_rows = scanOp->op.estimated_rows;
+  ExecutionPlan_ReplaceOp(plan, (OpBase*)scanOp, indexOp);
+  return true;
+}
+
+void _locateScanFilters(NodeByLabelScan *scanOp, OpBase ***filterOps, OpBase ***disjunctionOps) {
   /* We begin with a LabelScan, and want to find predicate filters that modify
    * the active entity. */
   OpBase *current = scanOp->op.parent;
@@ -33,6 +486,8 @@ void _locateScanFilters(NodeByLabelScan *scanOp, OpBase ***filterOps) {
      * no filter tree in this sequence can invalidate another. */
     if (IsNodePredicate(filterTree)) {
       *filterOps = array_append(*filterOps, current);
+    } else if (filterTree->cond.op == OR) {
+      *disjunctionOps = array_append(*disjunctionOps, current);
     }
 
     // Advance to the next operation.
@@ -60,6 +515,9 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
   // Return immediately if the graph has no indices
   if (!GraphContext_HasIndices(gc)) return;
 
+  // Edge index seeks replace scans, resolve them before collecting label scans.
+  _utilizeEdgeIndices(plan, ast, gc);
+
   // Collect all label scans
   NodeByLabelScan **scanOps = array_new(NodeByLabelScan*, 0);
   _locateScanOp(plan->root, &scanOps);
@@ -67,13 +525,13 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
   // Collect all filters on scanned entities
   NodeByLabelScan *scanOp;
   OpBase **filterOps = array_new(OpBase*, 0);
+  OpBase **disjunctionOps = array_new(OpBase*, 0);
   FT_FilterNode *ft;
   char *label;
 
   // Variables to be used when comparing filters against available indices
   char *filterProp = NULL;
   SIValue constVal;
-  int lhsType, rhsType;
   int op = 0;
 
   int scanOpCount = array_len(scanOps);
@@ -87,10 +545,14 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
      * The label will be used to retrieve the index. */
     label = scanOp->node->label;
     array_clear(filterOps);
-    _locateScanFilters(scanOp, &filterOps);
+    array_clear(disjunctionOps);
+    _locateScanFilters(scanOp, &filterOps, &disjunctionOps);
 
-    // No filters.
-    if(array_len(filterOps) == 0) continue;
+    // No predicate filters, a disjunction of equalities may still be served by a hash index.
+    if(array_len(filterOps) == 0) {
+      _utilizeHashIndexDisjunction(plan, ast, gc, scanOp, disjunctionOps);
+      continue;
+    }
 
     /* At this point we have all the filter ops (and thus, filter trees) associated
      * with the scanned entity. If there are valid indices on any filter and no
@@ -100,6 +562,9 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
      * that property. A later optimization would be to find the index with the
      * most filters, or use some heuristic for trying to select the minimal range. */
 
+    // Composite indices constraining several attributes take precedence.
+    if (_utilizeCompositeIndex(plan, ast, gc, scanOp, filterOps, false)) continue;
+
     int filterOpsCount = array_len(filterOps);
     for (int i = 0; i < filterOpsCount; i ++) {
       OpBase *opFilter = filterOps[i];
@@ -109,29 +574,26 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
        * constant [rel] node.property
        * If we are not comparing against a constant, then we cannot pre-define useful bounds
        * for the index iterator, which diminishes their utility. */
-      lhsType = AR_EXP_GetOperandType(ft->pred.lhs);
-      rhsType = AR_EXP_GetOperandType(ft->pred.rhs);
-      if (lhsType == AR_EXP_VARIADIC && rhsType == AR_EXP_CONSTANT) {
-        filterProp = ft->pred.lhs->operand.variadic.entity_prop;
-        constVal = ft->pred.rhs->operand.constant;
-        op = ft->pred.op;
-      } else if (lhsType == AR_EXP_CONSTANT && rhsType == AR_EXP_VARIADIC) {
-        constVal = ft->pred.lhs->operand.constant;
-        filterProp = ft->pred.rhs->operand.variadic.entity_prop;
-        // When the constant is on the left, reverse the relation in the inequality
-        // to properly set the bounds.
-        op = _reverseOp(ft->pred.op);
-      } else {
-        continue;
-      }
+      if (!_filterBound(ft, &filterProp, &constVal, &op)) continue;
 
       // If we've already selected an index on a different property, continue
       if (idx && strcmp(idx->attribute, filterProp)) continue;
 
       // Try to retrieve an index if one has not been selected yet
       if (!idx) {
-        idx = GraphContext_GetIndex(gc, label, filterProp);
-        if (!idx) continue;
+        Index *candidate = GraphContext_GetIndex(gc, label, filterProp);
+        if (!candidate) continue;
+        if (Index_IsHashIndex(candidate)) {
+          /* Hash indices only serve equalities, a single equality filter
+           * is folded into the lookup while any other filter is applied as usual. */
+          if (op != EQ || !Index_SupportsValue(&constVal)) continue;
+          idx = candidate;
+          iter = IndexIter_CreateLookup(idx, &constVal, 1);
+          ExecutionPlan_RemoveOp(plan, opFilter);
+          OpBase_Free(opFilter);
+          break;
+        }
+        idx = candidate;
         iter = IndexIter_Create(idx, SI_TYPE(constVal));
       }
 
@@ -145,11 +607,17 @@ void utilizeIndices(ExecutionPlan *plan, AST *ast) {
 
     if (iter != NULL) {
       OpBase *indexOp = NewIndexScanOp(scanOp->g, scanOp->node, iter, ast);
+      indexOp->estimated_rows = scanOp->op.estimated_rows;
       ExecutionPlan_ReplaceOp(plan, (OpBase*)scanOp, indexOp);
+    } else if (!_utilizeHashIndexDisjunction(plan, ast, gc, scanOp, disjunctionOps) &&
+               !_utilizeParamIndex(plan, ast, gc, scanOp, filterOps)) {
+      // No single attribute index applies, fall back to a composite index prefix.
+      _utilizeCompositeIndex(plan, ast, gc, scanOp, filterOps, true);
     }
   }
 
   // Cleanup
+  array_free(disjunctionOps);
   array_free(filterOps);
   array_free(scanOps);
 }
@@ -14,7 +14,12 @@
 /* The utilizeIndices optimization finds Label Scan operations with Filter parents and, if
  * any constant predicate filter matches a viable index, replaces the Label Scan and Filter
  * with an Index Scan. This allows for the consideration of fewer candidate nodes and
- * significantly increases the speed of the operation. */
+ * significantly increases the speed of the operation.
+ * Similarly, a scan followed by a traversal over a single indexed relationship type is
+ * replaced by an Edge Index Seek if a constant or parameter predicate filter on the edge matches an index.
+ * Hash indices only serve equality filters, or disjunctions of equalities on a single property.
+ * Filters comparing an indexed property against a query parameter are served by
+ * index scans and edge index seeks resolving the parameter whenever they are reset, these filters are kept. */
 void utilizeIndices(ExecutionPlan *plan, AST *ast);
 
 #endif
\ No newline at end of file
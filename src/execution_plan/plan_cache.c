@@ -0,0 +1,137 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "plan_cache.h"
+#include "../util/rmalloc.h"
+#include <string.h>
+#include <assert.h>
+
+static uint64_t _capacity = PLAN_CACHE_DEFAULT_CAP;
+
+void PlanCache_SetCapacity(uint64_t capacity) {
+    _capacity = capacity;
+}
+
+uint64_t PlanCache_Capacity(void) {
+    return _capacity;
+}
+
+// Unlink entry from recency list.
+static void _PlanCache_Unlink(PlanCache *cache, PlanCacheEntry *entry) {
+    if(entry->prev) entry->prev->next = entry->next;
+    else cache->head = entry->next;
+    if(entry->next) entry->next->prev = entry->prev;
+    else cache->tail = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+// Link entry as the most recently used entry.
+static void _PlanCache_LinkHead(PlanCache *cache, PlanCacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if(cache->head) cache->head->prev = entry;
+    cache->head = entry;
+    if(!cache->tail) cache->tail = entry;
+}
+
+// Remove entry from cache.
+static void _PlanCache_Remove(PlanCache *cache, PlanCacheEntry *entry) {
+    raxRemove(cache->entries, (unsigned char *)entry->query, strlen(entry->query), NULL);
+    _PlanCache_Unlink(cache, entry);
+}
+
+PlanCache *PlanCache_New(void) {
+    PlanCache *cache = rm_malloc(sizeof(PlanCache));
+    cache->entries = raxNew();
+    cache->head = NULL;
+    cache->tail = NULL;
+    cache->epoch = 0;
+    int res = pthread_mutex_init(&cache->mutex, NULL);
+    assert(res == 0);
+    return cache;
+}
+
+bool PlanCache_Contains(PlanCache *cache, const char *query) {
+    pthread_mutex_lock(&cache->mutex);
+    bool found = (raxFind(cache->entries, (unsigned char *)query, strlen(query)) != raxNotFound);
+    pthread_mutex_unlock(&cache->mutex);
+    return found;
+}
+
+PlanCacheEntry *PlanCache_Acquire(PlanCache *cache, const char *query) {
+    pthread_mutex_lock(&cache->mutex);
+    PlanCacheEntry *entry = raxFind(cache->entries, (unsigned char *)query, strlen(query));
+    if(entry != raxNotFound) {
+        _PlanCache_Remove(cache, entry);
+    } else {
+        entry = rm_calloc(1, sizeof(PlanCacheEntry));
+        entry->query = rm_strdup(query);
+    }
+    entry->epoch = cache->epoch;
+    pthread_mutex_unlock(&cache->mutex);
+    return entry;
+}
+
+void PlanCache_Release(PlanCache *cache, PlanCacheEntry *entry) {
+    PlanCacheEntry *evicted = NULL;
+
+    pthread_mutex_lock(&cache->mutex);
+    // Entries of queries which failed validation have no AST.
+    if(!entry->ast || entry->epoch != cache->epoch || _capacity == 0 ||
+       !raxTryInsert(cache->entries, (unsigned char *)entry->query, strlen(entry->query), entry, NULL)) {
+        evicted = entry;
+    } else {
+        _PlanCache_LinkHead(cache, entry);
+        if(raxSize(cache->entries) > _capacity) {
+            evicted = cache->tail;
+            _PlanCache_Remove(cache, evicted);
+        }
+    }
+    pthread_mutex_unlock(&cache->mutex);
+
+    // Free outside of the critical section.
+    if(evicted) PlanCacheEntry_Free(evicted);
+}
+
+void PlanCache_Clear(PlanCache *cache) {
+    pthread_mutex_lock(&cache->mutex);
+    cache->epoch++;
+    PlanCacheEntry *entry = cache->head;
+    raxFree(cache->entries);
+    cache->entries = raxNew();
+    cache->head = NULL;
+    cache->tail = NULL;
+    pthread_mutex_unlock(&cache->mutex);
+
+    while(entry) {
+        PlanCacheEntry *next = entry->next;
+        PlanCacheEntry_Free(entry);
+        entry = next;
+    }
+}
+
+uint64_t PlanCache_Size(PlanCache *cache) {
+    pthread_mutex_lock(&cache->mutex);
+    uint64_t size = raxSize(cache->entries);
+    pthread_mutex_unlock(&cache->mutex);
+    return size;
+}
+
+void PlanCacheEntry_Free(PlanCacheEntry *entry) {
+    if(entry->plan) ExecutionPlanFree(entry->plan);
+    if(entry->ast) AST_Free(entry->ast);
+    rm_free(entry->query);
+    rm_free(entry);
+}
+
+void PlanCache_Free(PlanCache *cache) {
+    if(!cache) return;
+    PlanCache_Clear(cache);
+    raxFree(cache->entries);
+    pthread_mutex_destroy(&cache->mutex);
+    rm_free(cache);
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __PLAN_CACHE_H__
+#define __PLAN_CACHE_H__
+
+#include <stdint.h>
+#include <pthread.h>
+#include "./execution_plan.h"
+#include "../parser/ast.h"
+#include "../../deps/rax/rax.h"
+
+#define PLAN_CACHE_DEFAULT_CAP 64   // Default number of cached queries per graph.
+
+/* Cached query, keyed by query text (excluding parameters).
+ * Holds the validated and modified AST and an idle execution plan,
+ * a plan is reusable as long as no label or relation type was introduced
+ * since it was built, index changes clear the cache altogether. */
+typedef struct PlanCacheEntry {
+    char *query;                    // Query text.
+    AST **ast;                      // Query AST, NULL until parsed.
+    ExecutionPlan *plan;            // Idle execution plan, NULL until built.
+    uint64_t schema_version;        // Graph context schema version plan was built against.
+    uint64_t epoch;                 // Cache epoch entry was acquired within.
+    struct PlanCacheEntry *prev;    // More recently used entry.
+    struct PlanCacheEntry *next;    // Less recently used entry.
+} PlanCacheEntry;
+
+/* PlanCache, a per graph LRU of cached queries.
+ * Entries are checked out by the thread executing the query
+ * and returned once execution is done, such that a plan is never
+ * shared by concurrent queries. */
+typedef struct PlanCache {
+    rax *entries;                   // Maps query text to entry.
+    PlanCacheEntry *head;           // Most recently used entry.
+    PlanCacheEntry *tail;           // Least recently used entry.
+    uint64_t epoch;                 // Advanced whenever cache is cleared.
+    pthread_mutex_t mutex;          // Guards cache.
+} PlanCache;
+
+// Set maximum number of entries held by each cache, 0 disables caching.
+void PlanCache_SetCapacity(uint64_t capacity);
+
+// Returns maximum number of entries held by each cache.
+uint64_t PlanCache_Capacity(void);
+
+// Create a new empty cache.
+PlanCache *PlanCache_New(void);
+
+// Returns true if query is cached.
+bool PlanCache_Contains(PlanCache *cache, const char *query);
+
+/* Checks out query's entry, removing it from cache.
+ * If query isn't cached, returns a new empty entry. */
+PlanCacheEntry *PlanCache_Acquire(PlanCache *cache, const char *query);
+
+/* Returns a checked out entry to cache as its most recently used entry,
+ * evicting the least recently used entry if cache is full.
+ * Entry is freed if it has no AST, if cache was cleared since entry
+ * was checked out or if query was cached meanwhile. */
+void PlanCache_Release(PlanCache *cache, PlanCacheEntry *entry);
+
+// Discard all cached entries, checked out entries will not be returned.
+void PlanCache_Clear(PlanCache *cache);
+
+// Returns number of cached entries.
+uint64_t PlanCache_Size(PlanCache *cache);
+
+// Free entry along with its AST and plan.
+void PlanCacheEntry_Free(PlanCacheEntry *entry);
+
+// Free cache along with all of its entries.
+void PlanCache_Free(PlanCache *cache);
+
+#endif
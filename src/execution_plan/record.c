@@ -5,6 +5,7 @@
 */
 
 #include "./record.h"
+#include "./record_pool.h"
 #include "../util/rmalloc.h"
 #include <assert.h>
 
@@ -13,15 +14,23 @@
 #define RECORD_HEADER(r) (r-1)
 #define RECORD_HEADER_ENTRY(r) *(RECORD_HEADER((r)))
 
-Record Record_New(int entries) {
-    Record r = rm_calloc((entries + 1), sizeof(Entry));
-
-    // First entry holds records length.
-    r[0].type = REC_TYPE_HEADER;
-    r[0].value.s = SI_LongVal(entries);
+static Record _Record_Init(Entry *block, int entries, struct RecordPool *pool) {
+    // First entry holds records length and owning pool.
+    block[0].type = REC_TYPE_HEADER;
+    block[0].value.header.length = entries;
+    block[0].value.header.pool = pool;
 
     // Skip header entry.
-    return r+1;
+    return block+1;
+}
+
+Record Record_New(int entries) {
+    return _Record_Init(rm_calloc((entries + 1), sizeof(Entry)), entries, NULL);
+}
+
+Record Record_NewPooled(struct RecordPool *pool, int entries) {
+    if(!pool) return Record_New(entries);
+    return _Record_Init(RecordPool_Acquire(pool, entries), entries, pool);
 }
 
 void Record_Extend(Record *r, int len) {
@@ -29,7 +38,7 @@ void Record_Extend(Record *r, int len) {
     if(rec_len >= len) return;
 
     Record header = RECORD_HEADER(*r);
-    header->value.s.longval = len;
+    header->value.header.length = len;
     header = rm_realloc(header, sizeof(Entry) * (len+1));
 
     // Skip header entry.
@@ -38,13 +47,13 @@ void Record_Extend(Record *r, int len) {
 
 unsigned int Record_length(const Record r) {
     Entry header = RECORD_HEADER_ENTRY(r);
-    int recordLength = header.value.s.longval;
+    int recordLength = header.value.header.length;
     return recordLength;
 }
 
 Record Record_Clone(const Record r) {
     int recordLength = Record_length(r);
-    Record clone = Record_New(recordLength);
+    Record clone = Record_NewPooled(RECORD_HEADER(r)->value.header.pool, recordLength);
     memcpy(clone, r, sizeof(Entry) * recordLength);
     return clone;
 }
@@ -240,5 +249,8 @@ void Record_Free(Record r) {
             SIValue_Free(&r[i].value.s);
         }
     }
-    rm_free((r-1));
+
+    struct RecordPool *pool = RECORD_HEADER(r)->value.header.pool;
+    if(pool) RecordPool_Release(pool, RECORD_HEADER(r), length);
+    else rm_free(RECORD_HEADER(r));
 }
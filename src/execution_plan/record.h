@@ -19,11 +19,17 @@ typedef enum  {
     REC_TYPE_HEADER,
 } RecordEntryType;
 
+struct RecordPool;
+
 typedef struct {
     union {
         SIValue s;
         Node n;
         Edge e;
+        struct {
+            int length;                 // Number of entries in record.
+            struct RecordPool *pool;    // Pool record was allocated from, NULL if none.
+        } header;
     } value;
     RecordEntryType type;    
 } Entry;
@@ -33,10 +39,14 @@ typedef Entry *Record;
 // Create a new record capable of holding N entries.
 Record Record_New(int entries);
 
+// Create a new record capable of holding N entries, allocated from pool.
+// Falls back to Record_New if pool is NULL.
+Record Record_NewPooled(struct RecordPool *pool, int entries);
+
 // Extands record to given length.
 void Record_Extend(Record *r, int len);
 
-// Clones record.
+// Clones record, clone is allocated from the same pool as r.
 Record Record_Clone(const Record r);
 
 // Merge record b into a.
@@ -81,7 +91,7 @@ size_t Record_ToString(const Record r, char **buf, size_t *buf_cap);
 // 64-bit hash of record
 unsigned long long Record_Hash64(const Record r);
 
-// Free record.
+// Free record, pooled records are returned to their pool.
 void Record_Free(Record r);
 
 #endif
@@ -0,0 +1,27 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./record_batch.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+RecordBatch *RecordBatch_New(void) {
+    RecordBatch *batch = rm_malloc(sizeof(RecordBatch));
+    batch->count = 0;
+    return batch;
+}
+
+void RecordBatch_Clear(RecordBatch *batch) {
+    assert(batch);
+    for(uint i = 0; i < batch->count; i++) Record_Free(batch->records[i]);
+    batch->count = 0;
+}
+
+void RecordBatch_Free(RecordBatch *batch) {
+    if(!batch) return;
+    RecordBatch_Clear(batch);
+    rm_free(batch);
+}
@@ -0,0 +1,36 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __RECORD_BATCH_H_
+#define __RECORD_BATCH_H_
+
+#include "./record.h"
+
+#define RECORD_BATCH_CAP 1024   // Maximum number of records in a batch.
+
+/* RecordBatch is a fixed capacity array of records passed between
+ * operations, records within a batch are owned by the batch holder. */
+typedef struct {
+    uint count;                         // Number of records in batch.
+    Record records[RECORD_BATCH_CAP];   // Records.
+} RecordBatch;
+
+// Create a new empty batch.
+RecordBatch *RecordBatch_New(void);
+
+// Returns true if batch can't hold additional records.
+#define RecordBatch_Full(batch) ((batch)->count == RECORD_BATCH_CAP)
+
+// Appends record to batch, batch must not be full.
+#define RecordBatch_Add(batch, r) ((batch)->records[(batch)->count++] = (r))
+
+// Free all records within batch and empty it.
+void RecordBatch_Clear(RecordBatch *batch);
+
+// Free batch along with its records.
+void RecordBatch_Free(RecordBatch *batch);
+
+#endif
@@ -0,0 +1,61 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./record_pool.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+
+// Free blocks are linked through their first bytes.
+#define NEXT_FREE(block) (*(Entry**)(block))
+
+RecordPool *RecordPool_New(void) {
+    RecordPool *pool = rm_malloc(sizeof(RecordPool));
+    pool->free_lists = array_new(Entry*, 16);
+    pool->allocated = 0;
+    pool->reused = 0;
+    return pool;
+}
+
+Entry *RecordPool_Acquire(RecordPool *pool, uint entries) {
+    assert(pool);
+    size_t size = sizeof(Entry) * (entries + 1);
+
+    if(entries < array_len(pool->free_lists) && pool->free_lists[entries]) {
+        Entry *block = pool->free_lists[entries];
+        pool->free_lists[entries] = NEXT_FREE(block);
+        memset(block, 0, size);
+        pool->reused++;
+        return block;
+    }
+
+    pool->allocated++;
+    return rm_calloc(entries + 1, sizeof(Entry));
+}
+
+void RecordPool_Release(RecordPool *pool, Entry *block, uint entries) {
+    assert(pool && block);
+    while(array_len(pool->free_lists) <= entries) {
+        pool->free_lists = array_append(pool->free_lists, NULL);
+    }
+    NEXT_FREE(block) = pool->free_lists[entries];
+    pool->free_lists[entries] = block;
+}
+
+void RecordPool_Free(RecordPool *pool) {
+    if(!pool) return;
+    uint len = array_len(pool->free_lists);
+    for(uint i = 0; i < len; i++) {
+        Entry *block = pool->free_lists[i];
+        while(block) {
+            Entry *next = NEXT_FREE(block);
+            rm_free(block);
+            block = next;
+        }
+    }
+    array_free(pool->free_lists);
+    rm_free(pool);
+}
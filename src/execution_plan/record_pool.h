@@ -0,0 +1,35 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __RECORD_POOL_H_
+#define __RECORD_POOL_H_
+
+#include <stdint.h>
+#include "./record.h"
+
+/* RecordPool recycles record allocations within an execution plan,
+ * freed records are kept on a free-list per record length and handed
+ * out again by later allocations of the same length.
+ * A pool is accessed by a single thread, the one executing its plan. */
+typedef struct RecordPool {
+    Entry **free_lists;     // Head of free-list per record length.
+    uint64_t allocated;     // Number of records allocated from the heap.
+    uint64_t reused;        // Number of records served from free-lists.
+} RecordPool;
+
+// Create a new empty pool.
+RecordPool *RecordPool_New(void);
+
+// Returns a zeroed block able to hold entries + 1 (header) entries.
+Entry *RecordPool_Acquire(RecordPool *pool, uint entries);
+
+// Returns block to pool, entries is the number of entries block was acquired with.
+void RecordPool_Release(RecordPool *pool, Entry *block, uint entries);
+
+// Free pool along with all of its free records.
+void RecordPool_Free(RecordPool *pool);
+
+#endif
@@ -0,0 +1,52 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "./traverse_batch.h"
+#include <stdio.h>
+#include <sys/param.h>
+
+static uint _cap = TRAVERSE_BATCH_DEFAULT_CAP;
+
+void TraverseBatch_SetCap(uint cap) {
+    _cap = MAX(cap, 1);
+}
+
+void TraverseBatch_Init(TraverseBatch *batch, uint limit) {
+    batch->cap = _cap;
+    batch->initial = MIN(TRAVERSE_BATCH_INITIAL_SIZE, batch->cap);
+    if(limit > 0) batch->initial = MIN(batch->initial, limit);
+    TraverseBatch_Reset(batch);
+}
+
+void TraverseBatch_Update(TraverseBatch *batch, uint rows, uint64_t result_entries) {
+    batch->batches++;
+    batch->max_used = MAX(batch->max_used, rows);
+
+    // Result too big, back off.
+    if(result_entries > TRAVERSE_BATCH_RESULT_BUDGET) {
+        batch->size = MAX(batch->size / 2, 1);
+        return;
+    }
+
+    // Child didn't fill batch, it's about to deplete.
+    if(rows < batch->size) return;
+
+    // Grow as long as a doubled batch is expected to fit within budget.
+    if(result_entries * 2 <= TRAVERSE_BATCH_RESULT_BUDGET) {
+        batch->size = MIN(batch->size * 2, batch->cap);
+    }
+}
+
+void TraverseBatch_Reset(TraverseBatch *batch) {
+    batch->size = batch->initial;
+    batch->max_used = 0;
+    batch->batches = 0;
+}
+
+int TraverseBatch_ToString(const TraverseBatch *batch, char *buff, uint buff_len) {
+    return snprintf(buff, buff_len, " | Batches: %u, Max batch size: %u",
+                    batch->batches, batch->max_used);
+}
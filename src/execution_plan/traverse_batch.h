@@ -0,0 +1,47 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __TRAVERSE_BATCH_H_
+#define __TRAVERSE_BATCH_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#define TRAVERSE_BATCH_INITIAL_SIZE 16          // Number of source nodes in first batch.
+#define TRAVERSE_BATCH_DEFAULT_CAP 4096         // Default maximum number of source nodes in a batch.
+#define TRAVERSE_BATCH_RESULT_BUDGET (1 << 20)  // Maximum number of entries in a batch result matrix.
+
+/* Number of child records a traversal evaluates with a single
+ * matrix multiplication. Batches start small, favouring latency,
+ * and grow geometrically as long as the child fills them
+ * and the result matrix stays within TRAVERSE_BATCH_RESULT_BUDGET. */
+typedef struct {
+    uint size;          // Current batch size.
+    uint cap;           // Maximum batch size.
+    uint initial;       // First batch size.
+    uint max_used;      // Largest batch size used.
+    uint batches;       // Number of batches evaluated.
+} TraverseBatch;
+
+/* Sets the maximum number of source nodes
+ * a traversal evaluates at once. */
+void TraverseBatch_SetCap(uint cap);
+
+/* Initialize batch sizing, limit is the query's LIMIT, 0 if unbounded,
+ * batches never start bigger than limit. */
+void TraverseBatch_Init(TraverseBatch *batch, uint limit);
+
+/* Update batch size after evaluating a batch of rows records
+ * whose result matrix holds result_entries entries. */
+void TraverseBatch_Update(TraverseBatch *batch, uint rows, uint64_t result_entries);
+
+// Restart sizing from the initial batch size.
+void TraverseBatch_Reset(TraverseBatch *batch);
+
+// Writes the batch sizes used, for profiling.
+int TraverseBatch_ToString(const TraverseBatch *batch, char *buff, uint buff_len);
+
+#endif
@@ -163,6 +163,27 @@ int FilterTree_applyFilters(const FT_FilterNode* root, const Record r) {
     return pass;
 }
 
+static void _FilterTree_Compile(const FT_FilterNode *root, AR_Program *p) {
+    if(IsNodePredicate(root)) {
+        AR_Program_CompileComparison(p, root->pred.lhs, root->pred.rhs, root->pred.op);
+        return;
+    }
+
+    /* Short circuit, skip right subtree when left subtree
+     * fails an AND or passes an OR. */
+    _FilterTree_Compile(LeftChild(root), p);
+    AR_Instr jump = {.code = (root->cond.op == AND) ? AR_INSTR_JUMP_IF_FAIL : AR_INSTR_JUMP_IF_PASS};
+    uint jump_offset = AR_Program_Emit(p, jump);
+    _FilterTree_Compile(RightChild(root), p);
+    p->code[jump_offset].target = AR_Program_Offset(p);
+}
+
+AR_Program* FilterTree_Compile(const FT_FilterNode *root) {
+    AR_Program *p = AR_Program_New();
+    _FilterTree_Compile(root, p);
+    return p;
+}
+
 void _FilterTree_CollectAliases(const FT_FilterNode *root, rax *aliases) {
     if(root == NULL) return;
 
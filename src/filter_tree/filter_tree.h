@@ -12,6 +12,7 @@
 #include "../../deps/rax/rax.h"
 #include "../execution_plan/record.h"
 #include "../arithmetic/arithmetic_expression.h"
+#include "../arithmetic/arithmetic_program.h"
 
 #define FILTER_FAIL 0
 #define FILTER_PASS 1
@@ -61,6 +62,10 @@ FT_FilterNode* AppendRightChild(FT_FilterNode *root, FT_FilterNode *child);
 /* Runs val through the filter tree. */
 int FilterTree_applyFilters(const FT_FilterNode* root, const Record r);
 
+/* Compiles filter tree into a program, whose pass flag
+ * is set to the result of running a record through the tree. */
+AR_Program* FilterTree_Compile(const FT_FilterNode *root);
+
 /* Extract every alias mentioned in the tree
  * without duplications. */
 rax* FilterTree_CollectAliases(const FT_FilterNode *root);
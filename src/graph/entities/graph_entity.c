@@ -5,9 +5,12 @@
 */
 
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include "graph_entity.h"
+#include "../../util/arr.h"
 #include "../../util/rmalloc.h"
+#include "../graphcontext.h"
 
 SIValue *PROPERTY_NOTFOUND = &(SIValue){.longval = 0, .type = T_NULL};
 
@@ -68,6 +71,50 @@ SIValue* GraphEntity_GetProperty(const GraphEntity *e, Attribute_ID attr_id) {
 	return PROPERTY_NOTFOUND;
 }
 
+// Schema whose columns hold entity's properties, NULL if entity holds all of them.
+static Schema *_GraphEntity_ColumnSchema(const GraphEntity *e) {
+	if(e->entity->column_schema == NO_COLUMN_SCHEMA) return NULL;
+	GraphContext *gc = GraphContext_GetFromTLS();
+	return GraphContext_GetSchemaByID(gc, e->entity->column_schema, SCHEMA_NODE);
+}
+
+SIValue GraphEntity_GetPropertyValue(const GraphEntity *e, Attribute_ID attr_id) {
+	SIValue *prop = GraphEntity_GetProperty(e, attr_id);
+	if(prop != PROPERTY_NOTFOUND) return *prop;
+
+	SIValue v;
+	Schema *s = _GraphEntity_ColumnSchema(e);
+	if(s && PropertyColumn_Get(Schema_GetColumn(s, attr_id), ENTITY_GET_ID(e), &v)) return v;
+	return SI_NullVal();
+}
+
+int GraphEntity_PropertyCount(const GraphEntity *e) {
+	int count = e->entity->prop_count;
+	Schema *s = _GraphEntity_ColumnSchema(e);
+	if(!s || !s->columns) return count;
+
+	SIValue v;
+	EntityID id = ENTITY_GET_ID(e);
+	uint32_t column_count = array_len(s->columns);
+	for(uint32_t i = 0; i < column_count; i++) {
+		if(PropertyColumn_Get(s->columns[i], id, &v)) count++;
+	}
+	return count;
+}
+
+void GraphEntity_GetProperties(const GraphEntity *e, EntityProperty *props) {
+	int count = e->entity->prop_count;
+	if(count) memcpy(props, e->entity->properties, sizeof(EntityProperty) * count);
+	Schema *s = _GraphEntity_ColumnSchema(e);
+	if(!s || !s->columns) return;
+
+	EntityID id = ENTITY_GET_ID(e);
+	uint32_t column_count = array_len(s->columns);
+	for(uint32_t i = 0; i < column_count; i++) {
+		if(PropertyColumn_Get(s->columns[i], id, &props[count].value)) props[count++].id = i;
+	}
+}
+
 // Updates existing property value.
 void GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value) {
 	assert(e);
@@ -79,6 +126,7 @@ void GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue
 
 	SIValue *prop = GraphEntity_GetProperty(e, attr_id);
 	assert(prop != PROPERTY_NOTFOUND);
+	SIValue_Free(prop);
 	*prop = value;
 }
 
@@ -14,10 +14,9 @@
 
 #define ENTITY_ID_ISLT(a,b) ((*a)<(*b))
 #define INVALID_ENTITY_ID -1l
+#define NO_COLUMN_SCHEMA -1
 
 #define ENTITY_GET_ID(graphEntity) ((graphEntity)->entity ? (graphEntity)->entity->id : INVALID_ENTITY_ID)
-#define ENTITY_PROP_COUNT(graphEntity) ((graphEntity)->entity->prop_count)
-#define ENTITY_PROPS(graphEntity) ((graphEntity)->entity->properties)
 
 // Defined in graph_entity.c
 extern SIValue *PROPERTY_NOTFOUND;
@@ -41,7 +40,8 @@ typedef struct {
 // TODO: see if pragma pack 0 will cause memory access violation on ARM.
 typedef struct {
     EntityID id;                    // Unique id
-    int prop_count;                 // Number of properties.
+    int prop_count;                 // Number of properties held by entity.
+    int column_schema;              // Schema whose property columns hold the rest, NO_COLUMN_SCHEMA if none.
     EntityProperty *properties;     // Key value pair of attributes.
 } Entity;
 
@@ -54,11 +54,26 @@ typedef struct {
  * returns - reference to newly added property. */
 SIValue* GraphEntity_AddProperty(GraphEntity *e, Attribute_ID attr_id, SIValue value);
 
-/* Retrieves entity's property
+/* Retrieves property held by entity itself
  * NOTE: If the key does not exist, we return the special
- * constant value PROPERTY_NOTFOUND. */
+ * constant value PROPERTY_NOTFOUND.
+ * Labeled nodes store their properties in their schema's columns
+ * when the columnar layout is enabled, use GraphEntity_GetPropertyValue
+ * unless the entity is known to hold all of its properties. */
 SIValue* GraphEntity_GetProperty(const GraphEntity *e, Attribute_ID attr_id);
 
+/* Retrieves entity's property wherever it is stored,
+ * returns a NULL value if entity doesn't have the attribute.
+ * The returned value is owned by the entity or its column. */
+SIValue GraphEntity_GetPropertyValue(const GraphEntity *e, Attribute_ID attr_id);
+
+/* Returns the number of entity's properties, including those stored in columns. */
+int GraphEntity_PropertyCount(const GraphEntity *e);
+
+/* Populates props with entity's properties, including those stored in columns,
+ * props must accommodate GraphEntity_PropertyCount entries. */
+void GraphEntity_GetProperties(const GraphEntity *e, EntityProperty *props);
+
 /* Updates existing attribute value. */
 void GraphEntity_SetProperty(const GraphEntity *e, Attribute_ID attr_id, SIValue value);
 
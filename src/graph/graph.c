@@ -14,8 +14,36 @@
 
 static GrB_BinaryOp _graph_edge_accum = NULL;
 
+/* Matrices readers are pinned to, entities aren't versioned (see graph.h).
+ * (matrix, delta) pairs are laid out as
+ * _Graph_DeltaPairs: adjacency matrix, its transpose, label matrices,
+ * followed by each relation's matrix, transposed matrix and mapping matrix. */
+struct GraphVersion {
+    uint label_count;
+    uint relation_count;
+    uint pair_count;
+    GrB_Matrix *matrices;   // Each matrix followed by its delta.
+};
+
+#define VERSION_ADJACENCY 0
+#define VERSION_T_ADJACENCY 1
+#define VERSION_LABEL(i) (2 + (i))
+#define VERSION_RELATION(v, i) (2 + (v)->label_count + 3 * (i))
+#define VERSION_T_RELATION(v, i) (VERSION_RELATION(v, i) + 1)
+#define VERSION_RELATION_MAP(v, i) (VERSION_RELATION(v, i) + 2)
+#define VERSION_MATRIX(v, pair) ((v)->matrices[2 * (pair)])
+
+// Graph read by the calling thread, the epoch and version it is pinned to.
+static __thread const Graph *_reader_graph = NULL;
+static __thread uint _reader_epoch = 0;
+static __thread const GraphVersion *_reader_version = NULL;
+
 /* ========================= Forward declarations  ========================= */
 void _MatrixResizeToCapacity(const Graph *g, GrB_Matrix m);
+void _MatrixNOP(const Graph *g, GrB_Matrix m);
+static void _Graph_FlushPending(Graph *g);
+static void _Graph_UpdateStatistics(Graph *g);
+static GrB_Index _Graph_PendingAdditions(Graph *g);
 
 
 /* ========================= GraphBLAS functions ========================= */
@@ -70,30 +98,86 @@ static inline void _Graph_LeaveCriticalSection(Graph *g) {
     pthread_mutex_unlock(&g->_mutex);
 }
 
+/* Register reader with the current epoch, matrices replaced
+ * during this epoch won't be freed until the reader leaves. */
+static void _Graph_EnterEpoch(Graph *g) {
+    while(true) {
+        uint64_t epoch = __atomic_load_n(&g->_epoch, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&g->_epoch_readers[epoch & 1], 1, __ATOMIC_SEQ_CST);
+        // Make sure epoch didn't advance while registering.
+        if(__atomic_load_n(&g->_epoch, __ATOMIC_SEQ_CST) == epoch) {
+            _reader_graph = g;
+            _reader_epoch = epoch & 1;
+            _reader_version = __atomic_load_n(&g->_published, __ATOMIC_SEQ_CST);
+            return;
+        }
+        __atomic_sub_fetch(&g->_epoch_readers[epoch & 1], 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+static void _Graph_LeaveEpoch(Graph *g) {
+    if(_reader_graph != g) return;
+    __atomic_sub_fetch(&g->_epoch_readers[_reader_epoch], 1, __ATOMIC_SEQ_CST);
+    _reader_graph = NULL;
+    _reader_version = NULL;
+}
+
+GraphReader Graph_CurrentReader(void) {
+    GraphReader reader = {_reader_graph, _reader_epoch, _reader_version};
+    return reader;
+}
+
+void Graph_BindReader(GraphReader reader) {
+    _reader_graph = reader.g;
+    _reader_epoch = reader.epoch;
+    _reader_version = reader.version;
+}
+
+// Version the calling thread is pinned to, NULL unless it is reading g.
+static inline const GraphVersion *_Graph_PinnedVersion(const Graph *g) {
+    return (_reader_graph == g) ? _reader_version : NULL;
+}
+
 /* Acquire a lock that does not restrict access from additional reader threads */
 void Graph_AcquireReadLock(Graph *g) {
     pthread_rwlock_rdlock(&g->_rwlock);
+    _Graph_EnterEpoch(g);
 }
 
 /* Acquire a lock for exclusive access to this graph's data */
 void Graph_AcquireWriteLock(Graph *g) {
     pthread_rwlock_wrlock(&g->_rwlock);
     g->_writelocked = true;
+    /* Deltas might have been folded since the writer got pinned, commit against
+     * the current matrices. Folding is postponed while the writer stays registered
+     * with its epoch, keeping both old and current matrices alive. */
+    if(_reader_graph == g) _reader_version = g->_published;
 }
 
 /* Release the held lock */
 void Graph_ReleaseLock(Graph *g) {
+    /* Writer is handing the graph back to readers,
+     * flush pending operations such that readers won't have to. */
+    if(g->_writelocked && g->SynchronizeMatrix != _MatrixNOP) {
+        _Graph_FlushPending(g);
+        _Graph_UpdateStatistics(g);
+        g->_pending = _Graph_PendingAdditions(g);
+    } else if(!g->_writelocked) _Graph_LeaveEpoch(g);
     g->_writelocked = false;
     pthread_rwlock_unlock(&g->_rwlock);
 }
 
-/* Writer request access to graph. */
+/* Writer request access to graph, writer reads without holding the lock
+ * and is therefore pinned to the current matrices like any other reader. */
 void Graph_WriterEnter(Graph *g) {
     pthread_mutex_lock(&g->_writers_mutex);
+    _Graph_EnterEpoch(g);
 }
 
 /* Writer release access to graph. */
 void Graph_WriterLeave(Graph *g) {
+    _Graph_LeaveEpoch(g);
+    Graph_ScheduleFold(g);
     pthread_mutex_unlock(&g->_writers_mutex);
 }
 
@@ -108,7 +192,8 @@ static inline void _Graph_ApplyPending(GrB_Matrix m) {
 // Get the transposed adjacency matrix.
 static GrB_Matrix _Graph_Get_Transposed_AdjacencyMatrix(const Graph *g) {
     assert(g);
-    GrB_Matrix m = g->_t_adjacency_matrix;
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    GrB_Matrix m = v ? VERSION_MATRIX(v, VERSION_T_ADJACENCY) : g->_t_adjacency_matrix;
     g->SynchronizeMatrix(g, m);
     return m;
 }
@@ -123,11 +208,25 @@ size_t _Graph_EdgeCap(const Graph *g) {
     return g->edges->itemCap;
 }
 
+// Make sure node label mapping can hold node ID id.
+static void _Graph_NodeLabelsAccommodate(Graph *g, NodeID id) {
+    if(id < g->_node_labels_cap) return;
+
+    size_t cap = MAX(id + 1, g->_node_labels_cap * 2);
+    g->_node_labels = rm_realloc(g->_node_labels, sizeof(int) * cap);
+    for(size_t i = g->_node_labels_cap; i < cap; i++) g->_node_labels[i] = GRAPH_NO_LABEL;
+    g->_node_labels_cap = cap;
+}
+
 // Retrieve a relation mapping matrix coresponding to relation_idx
 // Make sure matrix is synchronized.
 GrB_Matrix Graph_GetRelationMap(const Graph *g, int relation_idx) {
     assert(g && relation_idx >= 0 && relation_idx < array_len(g->_relations_map));
-    GrB_Matrix m = g->_relations_map[relation_idx];
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    // Relation introduced after reader got pinned has no edges.
+    if(v && relation_idx >= v->relation_count) return Graph_GetZeroMatrix(g);
+    GrB_Matrix m = v ? VERSION_MATRIX(v, VERSION_RELATION_MAP(v, relation_idx)) :
+                   g->_relations_map[relation_idx];
     g->SynchronizeMatrix(g, m);
     return m;
 }
@@ -140,6 +239,10 @@ void _Graph_AddRelationMap(Graph *g) {
     GrB_Info res = GrB_Matrix_new(&mapper, GrB_UINT64, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
     assert(res == GrB_SUCCESS);
     g->_relations_map = array_append(g->_relations_map, mapper);
+
+    res = GrB_Matrix_new(&mapper, GrB_UINT64, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+    assert(res == GrB_SUCCESS);
+    g->_relations_map_dp = array_append(g->_relations_map_dp, mapper);
 }
 
 // Locates edges connecting src to destination.
@@ -156,6 +259,12 @@ void _Graph_GetEdgesConnectingNodes(const Graph *g, NodeID src, NodeID dest, int
     GrB_Matrix relationMap = Graph_GetRelationMap(g, r);
     GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, relationMap, src, dest);
 
+    // Entry might be pending within the delta map.
+    if(res == GrB_NO_VALUE) {
+        relationMap = Graph_GetDeltaMatrix(g, relationMap);
+        if(relationMap) res = GrB_Matrix_extractElement_UINT64(&edgeId, relationMap, src, dest);
+    }
+
     // No entry at [dest, src], src is not connected to dest with relation R.
     if(res == GrB_NO_VALUE) return;
 
@@ -185,7 +294,13 @@ bool Graph_EdgeExists(const Graph *g, NodeID srcID, NodeID destID, int r) {
     assert(g);
     EdgeID edgeId;
     GrB_Matrix M = Graph_GetRelationMatrix(g, r);
-    GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, M, destID, srcID);
+    GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, M, srcID, destID);
+    if(res == GrB_SUCCESS) return true;
+
+    // Entry might be pending within the delta matrix.
+    M = Graph_GetDeltaMatrix(g, M);
+    if(M == NULL) return false;
+    res = GrB_Matrix_extractElement_UINT64(&edgeId, M, srcID, destID);
     return res == GrB_SUCCESS;
 }
 
@@ -267,24 +382,409 @@ void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy) {
     }
 }
 
+/* ============================ Delta matrices ============================== */
+
+/* Additions to a graph matrix M are introduced to a delta matrix DP,
+ * M's entries are the union of M and DP. Readers merge DP while
+ * scanning M, sparing them from flushing pending updates into M,
+ * DP is folded into M once it grows large enough (Graph_FoldDeltas).
+ * There's no deletions delta, deletions clear entries of M (or DP) in place
+ * under the exclusive write lock, which keeps readers and folding away. */
+
+// Pairs a graph matrix with its delta matrix.
+typedef struct {
+    GrB_Matrix *M;      // Graph matrix.
+    GrB_Matrix *DP;     // Pending additions to M.
+    GrB_BinaryOp op;    // Operator merging M and DP entries.
+} _DeltaPair;
+
+// Collects every (matrix, delta) pair maintained by the graph.
+static _DeltaPair *_Graph_DeltaPairs(Graph *g) {
+    uint label_count = array_len(g->labels);
+    uint relation_count = array_len(g->relations);
+    _DeltaPair *pairs = array_new(_DeltaPair, 2 + label_count + relation_count * 3);
+
+    _DeltaPair p = {&g->adjacency_matrix, &g->_adjacency_dp, GrB_LOR};
+    pairs = array_append(pairs, p);
+    p = (_DeltaPair){&g->_t_adjacency_matrix, &g->_t_adjacency_dp, GrB_LOR};
+    pairs = array_append(pairs, p);
+
+    for(uint i = 0; i < label_count; i++) {
+        p = (_DeltaPair){g->labels + i, g->_labels_dp + i, GrB_LOR};
+        pairs = array_append(pairs, p);
+    }
+
+    for(uint i = 0; i < relation_count; i++) {
+        p = (_DeltaPair){g->relations + i, g->_relations_dp + i, GrB_LOR};
+        pairs = array_append(pairs, p);
+        p = (_DeltaPair){g->_t_relations + i, g->_t_relations_dp + i, GrB_LOR};
+        pairs = array_append(pairs, p);
+        // Map entries are disjoint from their delta entries.
+        p = (_DeltaPair){g->_relations_map + i, g->_relations_map_dp + i, GrB_FIRST_UINT64};
+        pairs = array_append(pairs, p);
+    }
+
+    return pairs;
+}
+
+// Captures the graph's current matrices.
+static GraphVersion *_Graph_NewVersion(Graph *g) {
+    _DeltaPair *pairs = _Graph_DeltaPairs(g);
+    GraphVersion *v = rm_malloc(sizeof(GraphVersion));
+    v->label_count = array_len(g->labels);
+    v->relation_count = array_len(g->relations);
+    v->pair_count = array_len(pairs);
+    v->matrices = rm_malloc(sizeof(GrB_Matrix) * v->pair_count * 2);
+    for(uint i = 0; i < v->pair_count; i++) {
+        v->matrices[2 * i] = *pairs[i].M;
+        v->matrices[2 * i + 1] = *pairs[i].DP;
+    }
+    array_free(pairs);
+    return v;
+}
+
+static void _Graph_FreeVersion(GraphVersion *v) {
+    rm_free(v->matrices);
+    rm_free(v);
+}
+
+/* Pins new readers to the graph's current matrices, the replaced version
+ * is retired as readers of the current epoch might be pinned to it.
+ * Caller must be the graph's writer. */
+static void _Graph_PublishVersion(Graph *g) {
+    GraphVersion *v = _Graph_NewVersion(g);
+    GraphVersion *prev = __atomic_exchange_n(&g->_published, v, __ATOMIC_SEQ_CST);
+    if(prev == NULL) return;
+
+    uint epoch = g->_epoch & 1;
+    if(g->_retired_versions[epoch] == NULL) g->_retired_versions[epoch] = array_new(GraphVersion*, 1);
+    g->_retired_versions[epoch] = array_append(g->_retired_versions[epoch], prev);
+}
+
+// Folds DP into M in place, caller must have exclusive access to M.
+static void _Graph_FoldDelta(GrB_Matrix M, GrB_Matrix DP, GrB_BinaryOp op) {
+    GrB_Index nvals;
+    GrB_Matrix_nvals(&nvals, DP);
+    if(nvals == 0) return;
+
+    GrB_Info info = GrB_eWiseAdd_Matrix_BinaryOp(M, GrB_NULL, GrB_NULL, op, M, DP, GrB_NULL);
+    assert(info == GrB_SUCCESS);
+    GrB_Matrix_clear(DP);
+    _Graph_ApplyPending(M);
+}
+
+// Folds every delta matrix in place, caller must have exclusive access to g.
+static void _Graph_FoldAllDeltas(Graph *g) {
+    _DeltaPair *pairs = _Graph_DeltaPairs(g);
+    uint pair_count = array_len(pairs);
+    for(uint i = 0; i < pair_count; i++) {
+        g->SynchronizeMatrix(g, *pairs[i].M);
+        g->SynchronizeMatrix(g, *pairs[i].DP);
+        _Graph_FoldDelta(*pairs[i].M, *pairs[i].DP, pairs[i].op);
+    }
+    array_free(pairs);
+}
+
+// Resize and flush pending operations of every graph matrix.
+static void _Graph_FlushPending(Graph *g) {
+    _DeltaPair *pairs = _Graph_DeltaPairs(g);
+    uint pair_count = array_len(pairs);
+    for(uint i = 0; i < pair_count; i++) {
+        g->SynchronizeMatrix(g, *pairs[i].M);
+        g->SynchronizeMatrix(g, *pairs[i].DP);
+        _Graph_ApplyPending(*pairs[i].M);
+        _Graph_ApplyPending(*pairs[i].DP);
+    }
+    array_free(pairs);
+}
+
+// Number of additions pending within delta matrices.
+static GrB_Index _Graph_PendingAdditions(Graph *g) {
+    GrB_Index nvals;
+    GrB_Index pending = 0;
+    _DeltaPair *pairs = _Graph_DeltaPairs(g);
+    uint pair_count = array_len(pairs);
+    for(uint i = 0; i < pair_count; i++) {
+        GrB_Matrix_nvals(&nvals, *pairs[i].DP);
+        pending += nvals;
+    }
+    array_free(pairs);
+    return pending;
+}
+
+/* Refresh graph statistics, label and relation counts are read off
+ * matrices, relation degrees are resampled only once stale.
+ * Caller must have exclusive access to the graph. */
+static void _Graph_UpdateStatistics(Graph *g) {
+    GraphStatistics *stats = &g->_stats;
+    stats->node_count = Graph_NodeCount(g);
+
+    uint label_count = array_len(g->labels);
+    for(uint i = 0; i < label_count; i++) {
+        GrB_Index nvals;
+        GrB_Index pending;
+        GrB_Matrix_nvals(&nvals, g->labels[i]);
+        GrB_Matrix_nvals(&pending, g->_labels_dp[i]);
+        stats->label_counts[i] = nvals + pending;
+    }
+
+    uint relation_count = array_len(g->relations);
+    for(uint i = 0; i < relation_count; i++) {
+        RelationStatistics_Update(stats->relations + i, g->relations[i], g->_relations_dp[i],
+                                  g->_t_relations[i], g->_t_relations_dp[i]);
+    }
+    RelationStatistics_Update(&stats->adjacency, g->adjacency_matrix, g->_adjacency_dp,
+                              g->_t_adjacency_matrix, g->_t_adjacency_dp);
+}
+
+/* Sets M[i,j], entry is introduced to M's delta matrix
+ * unless M already contains it. */
+static void _Graph_SetDeltaElement(const Graph *g, GrB_Matrix M, GrB_Matrix DP, GrB_Index i, GrB_Index j) {
+    bool x;
+    g->SynchronizeMatrix(g, M);
+    g->SynchronizeMatrix(g, DP);
+    if(GrB_Matrix_extractElement_BOOL(&x, M, i, j) == GrB_SUCCESS) return;
+
+    GrB_Info info = GrB_Matrix_setElement_BOOL(DP, true, i, j);
+    assert(info == GrB_SUCCESS);
+}
+
+/* Maps (src, dest) to edge id within relation r mapping matrix,
+ * existing mappings are updated in place, new mappings
+ * are introduced to the delta map. */
+static void _Graph_MapEdge(const Graph *g, int r, NodeID src, NodeID dest, EdgeID id) {
+    GrB_Info info;
+    EdgeID current;
+    GrB_Matrix M = g->_relations_map[r];
+    GrB_Matrix DP = g->_relations_map_dp[r];
+    g->SynchronizeMatrix(g, M);
+    g->SynchronizeMatrix(g, DP);
+
+    id = SET_MSB(id);
+    info = GrB_Matrix_extractElement_UINT64(&current, M, src, dest);
+    if(info == GrB_SUCCESS) {
+        _edge_accum(&current, &current, &id);
+        info = GrB_Matrix_setElement_UINT64(M, current, src, dest);
+        assert(info == GrB_SUCCESS);
+        return;
+    }
+
+    GrB_Index I = src;
+    GrB_Index J = dest;
+    info = GxB_Matrix_subassign_UINT64   // C(I,J)<Mask> = accum (C(I,J),x)
+    (
+        DP,                 // input/output matrix for results
+        GrB_NULL,           // optional mask for C(I,J), unused if NULL
+        _graph_edge_accum,  // optional accum for Z=accum(C(I,J),x)
+        id,                 // scalar to assign to C(I,J)
+        &I,                 // row indices
+        1,                  // number of row indices
+        &J,                 // column indices
+        1,                  // number of column indices
+        GrB_NULL            // descriptor for C(I,J) and Mask
+    );
+    assert(info == GrB_SUCCESS);
+}
+
+/* Clears M[i,j], an entry lives either within M or within its delta matrix,
+ * never both, such that deletions don't require folding pending additions. */
+static void _Graph_DeleteDeltaElement(const Graph *g, GrB_Matrix M, GrB_Matrix DP, GrB_Index i, GrB_Index j) {
+    bool x;
+    g->SynchronizeMatrix(g, M);
+    g->SynchronizeMatrix(g, DP);
+    if(GrB_Matrix_extractElement_BOOL(&x, M, i, j) != GrB_SUCCESS) M = DP;
+
+    GrB_Info info = GxB_Matrix_Delete(M, i, j);
+    assert(info == GrB_SUCCESS);
+}
+
+/* Locates relation r's mapping matrix holding (src, dest), either the relation
+ * map or its delta, and sets id to the mapped edge(s).
+ * Returns NULL if src isn't connected to dest by r. */
+static GrB_Matrix _Graph_LocateEdgeMapping(const Graph *g, int r, NodeID src, NodeID dest, EdgeID *id) {
+    GrB_Matrix M = g->_relations_map[r];
+    GrB_Matrix DP = g->_relations_map_dp[r];
+    g->SynchronizeMatrix(g, M);
+    g->SynchronizeMatrix(g, DP);
+
+    if(GrB_Matrix_extractElement_UINT64(id, M, src, dest) == GrB_SUCCESS) return M;
+    if(GrB_Matrix_extractElement_UINT64(id, DP, src, dest) == GrB_SUCCESS) return DP;
+    return NULL;
+}
+
 /* Synchronize and resize all matrices in graph. */
 void Graph_ApplyAllPending(Graph *g) {
-    GrB_Matrix M;
+    _Graph_FoldAllDeltas(g);
+    // Entities introduced without a write lock (e.g. RDB load) aren't counted yet.
+    _Graph_UpdateStatistics(g);
+}
 
-    for(int i = 0; i < array_len(g->labels); i ++) {
-      M = g->labels[i];
-      g->SynchronizeMatrix(g, M);
+// Frees matrices and versions retired within given epoch.
+static void _Graph_ReclaimRetired(Graph *g, uint epoch) {
+    if(g->_retired_versions[epoch]) {
+        uint version_count = array_len(g->_retired_versions[epoch]);
+        for(uint i = 0; i < version_count; i++) _Graph_FreeVersion(g->_retired_versions[epoch][i]);
+        array_free(g->_retired_versions[epoch]);
+        g->_retired_versions[epoch] = NULL;
     }
 
-    for(int i = 0; i < array_len(g->relations); i ++) {
-      M = g->relations[i];
-      g->SynchronizeMatrix(g, M);
+    if(g->_retired[epoch] == NULL) return;
+    for(uint i = 0; i < g->_retired_count[epoch]; i++) GrB_Matrix_free(g->_retired[epoch] + i);
+    rm_free(g->_retired[epoch]);
+    g->_retired[epoch] = NULL;
+    g->_retired_count[epoch] = 0;
+}
+
+void Graph_FoldDeltas(Graph *g) {
+    assert(g);
+    // Folding thread registers with the current epoch, it mustn't be pinned already.
+    assert(_reader_graph != g);
+
+    /* A read lock keeps committing writers and exclusive lockers
+     * (bulk insert, graph deletion) away, readers and writers yet
+     * to commit carry on reading their pinned matrices. */
+    Graph_AcquireReadLock(g);
+
+    /* Matrices replaced by the previous fold are reclaimed once
+     * no reader is pinned to them, postpone folding otherwise. */
+    uint epoch = g->_epoch & 1;
+    uint prev_epoch = !epoch;
+    if(__atomic_load_n(&g->_epoch_readers[prev_epoch], __ATOMIC_SEQ_CST) > 0) goto cleanup;
+    _Graph_ReclaimRetired(g, prev_epoch);
+
+    GrB_Index nvals;
+    _DeltaPair *pairs = _Graph_DeltaPairs(g);
+    uint pair_count = array_len(pairs);
+
+    if(_Graph_PendingAdditions(g) >= GRAPH_DELTA_FOLD_THRESHOLD) {
+        /* Build folded matrices aside, readers keep on
+         * reading from both graph and delta matrices. */
+        GrB_Matrix folded[pair_count];
+        GrB_Matrix deltas[pair_count];
+        for(uint i = 0; i < pair_count; i++) {
+            folded[i] = NULL;
+            GrB_Matrix M = *pairs[i].M;
+            GrB_Matrix DP = *pairs[i].DP;
+            GrB_Matrix_nvals(&nvals, DP);
+            if(nvals == 0) continue;
+
+            GrB_Type type;
+            GrB_Index nrows;
+            GrB_Index ncols;
+            GxB_Matrix_type(&type, M);
+            GrB_Matrix_nrows(&nrows, M);
+            GrB_Matrix_ncols(&ncols, M);
+            GrB_Matrix_new(&folded[i], type, nrows, ncols);
+            GrB_Matrix_new(&deltas[i], type, nrows, ncols);
+            GrB_Info info = GrB_eWiseAdd_Matrix_BinaryOp(folded[i], GrB_NULL, GrB_NULL, pairs[i].op, M, DP, GrB_NULL);
+            assert(info == GrB_SUCCESS);
+            _Graph_ApplyPending(folded[i]);
+        }
+
+        /* Replaced matrices are retired as readers of the current epoch
+         * might be pinned to them, readers only access the graph's matrices
+         * through their pinned version, which is swapped as a whole. */
+        g->_retired[epoch] = rm_malloc(sizeof(GrB_Matrix) * pair_count * 2);
+        for(uint i = 0; i < pair_count; i++) {
+            if(folded[i] == NULL) continue;
+            uint count = g->_retired_count[epoch];
+            g->_retired[epoch][count] = *pairs[i].M;
+            g->_retired[epoch][count + 1] = *pairs[i].DP;
+            g->_retired_count[epoch] = count + 2;
+            *pairs[i].DP = deltas[i];
+            *pairs[i].M = folded[i];
+        }
+        _Graph_PublishVersion(g);
+
+        // New readers are pinned to the published matrices.
+        __atomic_add_fetch(&g->_epoch, 1, __ATOMIC_SEQ_CST);
+        g->_pending = 0;
     }
 
-    for(int i = 0; i < array_len(g->_relations_map); i ++) {
-      M = g->_relations_map[i];
-      g->SynchronizeMatrix(g, M);
+    array_free(pairs);
+
+cleanup:
+    Graph_ReleaseLock(g);
+}
+
+static void *_Graph_FoldTask(void *arg) {
+    Graph *g = (Graph*)arg;
+    Graph_FoldDeltas(g);
+
+    _Graph_EnterCriticalSection(g);
+    g->_folding = false;
+    pthread_cond_broadcast(&g->_fold_done);
+    _Graph_LeaveCriticalSection(g);
+    return NULL;
+}
+
+void Graph_ScheduleFold(Graph *g) {
+    assert(g);
+    // Graph is being deleted or no fold is due.
+    if(g->SynchronizeMatrix == _MatrixNOP) return;
+    if(g->_pending < GRAPH_DELTA_FOLD_THRESHOLD) return;
+
+    _Graph_EnterCriticalSection(g);
+    if(!g->_folding) {
+        /* A dedicated thread rather than the module's thread pool,
+         * which might be occupied by writers waiting on the fold. */
+        pthread_t t;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        g->_folding = (pthread_create(&t, &attr, _Graph_FoldTask, g) == 0);
+        pthread_attr_destroy(&attr);
     }
+    _Graph_LeaveCriticalSection(g);
+}
+
+void Graph_AwaitFold(Graph *g) {
+    assert(g);
+    _Graph_EnterCriticalSection(g);
+    while(g->_folding) pthread_cond_wait(&g->_fold_done, &g->_mutex);
+    _Graph_LeaveCriticalSection(g);
+}
+
+// Locates m's delta matrix, NULL if m isn't maintained by g.
+static GrB_Matrix _Graph_LookupDelta(const Graph *g, const GrB_Matrix m) {
+    // Reader might be holding matrices replaced since it got pinned.
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    if(v) {
+        for(uint i = 0; i < v->pair_count; i++) {
+            if(m == VERSION_MATRIX(v, i)) return v->matrices[2 * i + 1];
+        }
+        return NULL;
+    }
+
+    if(m == g->adjacency_matrix) return g->_adjacency_dp;
+    if(m == g->_t_adjacency_matrix) return g->_t_adjacency_dp;
+
+    uint label_count = array_len(g->labels);
+    for(uint i = 0; i < label_count; i++) {
+        if(m == g->labels[i]) return g->_labels_dp[i];
+    }
+
+    uint relation_count = array_len(g->relations);
+    for(uint i = 0; i < relation_count; i++) {
+        if(m == g->relations[i]) return g->_relations_dp[i];
+        if(m == g->_t_relations[i]) return g->_t_relations_dp[i];
+        if(m == g->_relations_map[i]) return g->_relations_map_dp[i];
+    }
+
+    // m isn't maintained by the graph.
+    return NULL;
+}
+
+GrB_Matrix Graph_GetDeltaMatrix(const Graph *g, const GrB_Matrix m) {
+    assert(g && m);
+
+    GrB_Matrix dp = _Graph_LookupDelta(g, m);
+    if(!dp) return NULL;
+
+    GrB_Index nvals;
+    g->SynchronizeMatrix(g, dp);
+    GrB_Matrix_nvals(&nvals, dp);
+    return (nvals > 0) ? dp : NULL;
 }
 
 /* ================================ Graph API ================================ */
@@ -296,15 +796,39 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
     g->nodes = DataBlock_New(node_cap, sizeof(Entity), (fpDestructor)FreeEntity);
     g->edges = DataBlock_New(edge_cap, sizeof(Entity), (fpDestructor)FreeEntity);
     g->labels = array_new(GrB_Matrix, GRAPH_DEFAULT_LABEL_CAP);
+    g->_node_labels = NULL;
+    g->_node_labels_cap = 0;
+    _Graph_NodeLabelsAccommodate(g, node_cap - 1);
     g->relations = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+    g->_t_relations = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
     g->_relations_map = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+    g->_labels_dp = array_new(GrB_Matrix, GRAPH_DEFAULT_LABEL_CAP);
+    g->_relations_dp = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+    g->_t_relations_dp = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+    g->_relations_map_dp = array_new(GrB_Matrix, GRAPH_DEFAULT_RELATION_TYPE_CAP);
     GrB_Matrix_new(&g->adjacency_matrix, GrB_BOOL, node_cap, node_cap);
     GrB_Matrix_new(&g->_t_adjacency_matrix, GrB_BOOL, node_cap, node_cap);
+    GrB_Matrix_new(&g->_adjacency_dp, GrB_BOOL, node_cap, node_cap);
+    GrB_Matrix_new(&g->_t_adjacency_dp, GrB_BOOL, node_cap, node_cap);
     GrB_Matrix_new(&g->_zero_matrix, GrB_BOOL, node_cap, node_cap);
 
+    // No matrices were replaced yet.
+    g->_epoch = 0;
+    for(int i = 0; i < 2; i++) {
+        g->_epoch_readers[i] = 0;
+        g->_retired[i] = NULL;
+        g->_retired_count[i] = 0;
+        g->_retired_versions[i] = NULL;
+    }
+    g->_published = NULL;
+    _Graph_PublishVersion(g);
+    g->_pending = 0;
+    g->_folding = false;
+
     // Initialize a read-write lock scoped to the individual graph
     assert(pthread_rwlock_init(&g->_rwlock, NULL) == 0);
     g->_writelocked = false;
+    GraphStatistics_Init(&g->_stats);
 
     // Force GraphBLAS updates and resize matrices to node count by default
     Graph_SetMatrixPolicy(g, SYNC_AND_MINIMIZE_SPACE);
@@ -314,6 +838,7 @@ Graph *Graph_New(size_t node_cap, size_t edge_cap) {
      * another thread could be resizing matrix B. */
     assert(pthread_mutex_init(&g->_mutex, NULL) == 0);
     assert(pthread_mutex_init(&g->_writers_mutex, NULL) == 0);
+    assert(pthread_cond_init(&g->_fold_done, NULL) == 0);
 
     // Create edge accumulator binary function
     if(!_graph_edge_accum) {
@@ -340,9 +865,17 @@ size_t Graph_NodeCount(const Graph *g) {
 
 size_t Graph_LabeledNodeCount(const Graph *g, int label) {
     GrB_Index nvals = 0;
+    GrB_Index pending = 0;
     GrB_Matrix m = Graph_GetLabelMatrix(g, label);
     if(m) GrB_Matrix_nvals(&nvals, m);
-    return nvals;
+    GrB_Matrix dp = Graph_GetDeltaMatrix(g, m);
+    if(dp) GrB_Matrix_nvals(&pending, dp);
+    return nvals + pending;
+}
+
+const GraphStatistics *Graph_Statistics(const Graph *g) {
+    assert(g);
+    return &g->_stats;
 }
 
 size_t Graph_EdgeCount(const Graph *g) {
@@ -361,6 +894,7 @@ int Graph_LabelTypeCount(const Graph *g) {
 void Graph_AllocateNodes(Graph* g, size_t n) {
     assert(g);
     DataBlock_Accommodate(g->nodes, n);
+    _Graph_NodeLabelsAccommodate(g, _Graph_NodeCap(g) - 1);
 }
 
 void Graph_AllocateEdges(Graph *g, size_t n) {
@@ -382,18 +916,8 @@ int Graph_GetEdge(const Graph *g, EdgeID id, Edge *e) {
 
 int Graph_GetNodeLabel(const Graph *g, NodeID nodeID) {
     assert(g);
-    int label = GRAPH_NO_LABEL;
-    for(int i = 0; i < array_len(g->labels); i++) {
-        bool x = false;
-        GrB_Matrix M = Graph_GetLabelMatrix(g, i);
-        GrB_Info res = GrB_Matrix_extractElement_BOOL(&x, M, nodeID, nodeID);
-        if(res == GrB_SUCCESS && x == true) {
-            label = i;
-            break;
-        }
-    }
-
-    return label;
+    if(nodeID >= g->_node_labels_cap) return GRAPH_NO_LABEL;
+    return g->_node_labels[nodeID];
 }
 
 int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
@@ -408,6 +932,10 @@ int Graph_GetEdgeRelation(const Graph *g, Edge *e) {
         EdgeID edgeId = 0;
         GrB_Matrix M = Graph_GetRelationMap(g, i);
         GrB_Info res = GrB_Matrix_extractElement_UINT64(&edgeId, M, srcNodeID, destNodeID);
+        if(res == GrB_NO_VALUE) {
+            M = Graph_GetDeltaMatrix(g, M);
+            if(M) res = GrB_Matrix_extractElement_UINT64(&edgeId, M, srcNodeID, destNodeID);
+        }
         if(res != GrB_SUCCESS) continue;
 
         if(SINGLE_EDGE(edgeId)) {
@@ -461,13 +989,17 @@ void Graph_CreateNode(Graph* g, int label, Node *n) {
     Entity *en = DataBlock_AllocateItem(g->nodes, &id);
     en->id = id;
     en->prop_count = 0;
+    en->column_schema = NO_COLUMN_SCHEMA;
     en->properties = NULL;
     n->entity = en;
 
+    _Graph_NodeLabelsAccommodate(g, id);
+    g->_node_labels[id] = label;
+
     if(label != GRAPH_NO_LABEL) {
-        // Try to set matrix at position [id, id]
+        // Try to set delta matrix at position [id, id]
         // incase of a failure, scale matrix.
-        GrB_Matrix m = g->labels[label];
+        GrB_Matrix m = g->_labels_dp[label];
         GrB_Info res = GrB_Matrix_setElement_BOOL(m, true, id, id);
         if(res != GrB_SUCCESS) {
             _MatrixResizeToCapacity(g, m);
@@ -477,7 +1009,6 @@ void Graph_CreateNode(Graph* g, int label, Node *n) {
 }
 
 int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
-    GrB_Info info;
     Node srcNode;
     Node destNode;
 
@@ -489,37 +1020,21 @@ int Graph_ConnectNodes(Graph *g, NodeID src, NodeID dest, int r, Edge *e) {
     Entity *en = DataBlock_AllocateItem(g->edges, &id);
     en->id = id;
     en->prop_count = 0;
+    en->column_schema = NO_COLUMN_SCHEMA;
     en->properties = NULL;
     e->entity = en;
     e->relationID = r;
     e->srcNodeID = src;
     e->destNodeID = dest;
 
-    GrB_Matrix adj = Graph_GetAdjacencyMatrix(g);
-    GrB_Matrix relationMat = Graph_GetRelationMatrix(g, r);
-    GrB_Matrix relationMapMat = Graph_GetRelationMap(g, r);
-    GrB_Matrix tadj = _Graph_Get_Transposed_AdjacencyMatrix(g);
-
-    // Rows represent source nodes, columns represent destination nodes.
-    GrB_Matrix_setElement_BOOL(adj, true, src, dest);
-    GrB_Matrix_setElement_BOOL(tadj, true, dest, src);
-    GrB_Matrix_setElement_BOOL(relationMat, true, src, dest);
-    GrB_Index I = src;
-    GrB_Index J = dest;
-    id = SET_MSB(id);
-    info = GxB_Matrix_subassign_UINT64   // C(I,J)<Mask> = accum (C(I,J),x)
-    (
-        relationMapMat,     // input/output matrix for results
-        GrB_NULL,           // optional mask for C(I,J), unused if NULL
-        _graph_edge_accum,  // optional accum for Z=accum(C(I,J),x)
-        id,                 // scalar to assign to C(I,J)
-        &I,                 // row indices
-        1,                  // number of row indices
-        &J,                 // column indices
-        1,                  // number of column indices
-        GrB_NULL            // descriptor for C(I,J) and Mask
-    );
-    assert(info == GrB_SUCCESS);
+    /* Rows represent source nodes, columns represent destination nodes.
+     * New connections are introduced to delta matrices, leaving
+     * graph matrices untouched for concurrent readers. */
+    _Graph_SetDeltaElement(g, g->adjacency_matrix, g->_adjacency_dp, src, dest);
+    _Graph_SetDeltaElement(g, g->_t_adjacency_matrix, g->_t_adjacency_dp, dest, src);
+    _Graph_SetDeltaElement(g, g->relations[r], g->_relations_dp[r], src, dest);
+    _Graph_SetDeltaElement(g, g->_t_relations[r], g->_t_relations_dp[r], dest, src);
+    _Graph_MapEdge(g, r, src, dest, id);
 
     return 1;
 }
@@ -541,92 +1056,89 @@ void Graph_GetNodeEdges(const Graph *g, const Node *n, GRAPH_EDGE_DIR dir, int e
         else M = Graph_GetRelationMatrix(g, edgeType);
 
         /* Construct an iterator to traverse the source node's row, which contains
-         * all outgoing edges. */
-        GxB_MatrixTupleIter_new(&tupleIter, M);
+         * all outgoing edges, followed by the node's row within M's delta matrix. */
         srcNodeID = ENTITY_GET_ID(n);
-        GxB_MatrixTupleIter_iterate_row(tupleIter, srcNodeID);
-        while (true)
-        {
-            bool depleted = false;
-            GxB_MatrixTupleIter_next(tupleIter, NULL, &destNodeID, &depleted);
-            if(depleted) break;
-            // Collect all edges connecting this source node to each of its destinations.
-            Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
+        GrB_Matrix DP = Graph_GetDeltaMatrix(g, M);
+        for(; M; M = DP, DP = NULL) {
+            GxB_MatrixTupleIter_new(&tupleIter, M);
+            GxB_MatrixTupleIter_iterate_row(tupleIter, srcNodeID);
+            while (true)
+            {
+                bool depleted = false;
+                GxB_MatrixTupleIter_next(tupleIter, NULL, &destNodeID, &depleted);
+                if(depleted) break;
+                // Collect all edges connecting this source node to each of its destinations.
+                Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
+            }
+            GxB_MatrixTupleIter_free(tupleIter);
         }
-        GxB_MatrixTupleIter_free(tupleIter);
     }
 
     // Incoming.
     if(dir == GRAPH_EDGE_DIR_INCOMING || dir == GRAPH_EDGE_DIR_BOTH) {
-        /* Retrieve the transposed adjacency matrix, regardless of whether or not
-         * a relationship type is specified. */
-        M = _Graph_Get_Transposed_AdjacencyMatrix(g);
+        /* If a relationship type is specified, retrieve the appropriate
+         * transposed relation matrix; otherwise use the transposed adjacency matrix. */
+        if(edgeType == GRAPH_NO_RELATION) M = _Graph_Get_Transposed_AdjacencyMatrix(g);
+        else M = Graph_GetTransposedRelationMatrix(g, edgeType);
 
         /* Construct an iterator to traverse the node's row, which in the transposed
-         * adjacency matrix contains all incoming edges. */
-        GxB_MatrixTupleIter_new(&tupleIter, M);
+         * adjacency matrix contains all incoming edges, followed by the node's row
+         * within M's delta matrix. */
         destNodeID = ENTITY_GET_ID(n);
-        GxB_MatrixTupleIter_iterate_row(tupleIter, destNodeID);
+        GrB_Matrix DP = Graph_GetDeltaMatrix(g, M);
+        for(; M; M = DP, DP = NULL) {
+            GxB_MatrixTupleIter_new(&tupleIter, M);
+            GxB_MatrixTupleIter_iterate_row(tupleIter, destNodeID);
+
+            while(true) {
+                bool depleted = false;
+                GxB_MatrixTupleIter_next(tupleIter, NULL, &srcNodeID, &depleted);
+                if(depleted) break;
+                /* Collect all edges connecting this destination node to each of its sources.
+                 * This call will only collect edges of the appropriate relationship type,
+                 * if one is specified. */
+                Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
+            }
 
-        while(true) {
-            bool depleted = false;
-            GxB_MatrixTupleIter_next(tupleIter, NULL, &srcNodeID, &depleted);
-            if(depleted) break;
-            /* Collect all edges connecting this destination node to each of its sources.
-             * This call will only collect edges of the appropriate relationship type,
-             * if one is specified. */
-            Graph_GetEdgesConnectingNodes(g, srcNodeID, destNodeID, edgeType, edges);
+            // Clean up
+            GxB_MatrixTupleIter_free(tupleIter);
         }
-
-        // Clean up
-        GxB_MatrixTupleIter_free(tupleIter);
     }
 }
 
 /* Removes an edge from Graph and updates graph relevent matrices. */
 int Graph_DeleteEdge(Graph *g, Edge *e) {
-    bool x;
     GrB_Matrix R;
-    GrB_Matrix M;
-    GrB_Info info;
     EdgeID edge_id;
     int r = Edge_GetRelationID(e);
     NodeID src_id = Edge_GetSrcNodeID(e);
     NodeID dest_id = Edge_GetDestNodeID(e);
 
-    R = Graph_GetRelationMap(g, r);
-    M = Graph_GetRelationMatrix(g, r);
-
     // Test to see if edge exists.
-    info = GrB_Matrix_extractElement_BOOL(&x, M, src_id, dest_id);
-    if(info != GrB_SUCCESS) return 0;
-
-    GrB_Matrix_extractElement_UINT64(&edge_id, R, src_id, dest_id);
+    R = _Graph_LocateEdgeMapping(g, r, src_id, dest_id, &edge_id);
+    if(R == NULL) return 0;
 
     if(SINGLE_EDGE(edge_id)) {
         /* Single edge of type R connecting src to dest.
-         * delete entry from both M and R. */
-        assert(GxB_Matrix_Delete(M, src_id, dest_id) == GrB_SUCCESS);        
-        assert(GxB_Matrix_Delete(R, src_id, dest_id )== GrB_SUCCESS);
-    
+         * delete entry from M, its transpose and R. */
+        _Graph_DeleteDeltaElement(g, g->relations[r], g->_relations_dp[r], src_id, dest_id);
+        _Graph_DeleteDeltaElement(g, g->_t_relations[r], g->_t_relations_dp[r], dest_id, src_id);
+        assert(GxB_Matrix_Delete(R, src_id, dest_id) == GrB_SUCCESS);
+
         // See if source is connected to destination with additional edges.
         bool connected = false;
         int relationCount = Graph_RelationTypeCount(g);
         for(int i = 0; i < relationCount; i++) {
             if(i == r) continue;
-            M = Graph_GetRelationMatrix(g, i);
-            info = GrB_Matrix_extractElement_BOOL(&connected, M, src_id, dest_id);
-            if(info == GrB_SUCCESS) break;
+            connected = Graph_EdgeExists(g, src_id, dest_id, i);
+            if(connected) break;
         }
 
         /* There are no additional edges connecting source to destination
          * Remove edge from THE adjacency matrix. */
         if(!connected) {
-            M = Graph_GetAdjacencyMatrix(g);
-            assert(GxB_Matrix_Delete(M, src_id, dest_id) == GrB_SUCCESS);
-
-            M = _Graph_Get_Transposed_AdjacencyMatrix(g);
-            assert(GxB_Matrix_Delete(M, dest_id, src_id) == GrB_SUCCESS);
+            _Graph_DeleteDeltaElement(g, g->adjacency_matrix, g->_adjacency_dp, src_id, dest_id);
+            _Graph_DeleteDeltaElement(g, g->_t_adjacency_matrix, g->_t_adjacency_dp, dest_id, src_id);
         }
     } else {
         /* Multiple edges connecting src to dest
@@ -670,12 +1182,13 @@ void Graph_DeleteNode(Graph *g, Node *n) {
      * there are no incoming nor outgoing edges
      * leading to / from node. */
     assert(g && n);
-    
+
     // Clear label matrix at position node ID.
-    uint32_t label_count = array_len(g->labels);
-    for(int i = 0; i < label_count; i++) {
-        GrB_Matrix M = Graph_GetLabelMatrix(g, i);
-        GxB_Matrix_Delete(M, ENTITY_GET_ID(n), ENTITY_GET_ID(n));
+    NodeID id = ENTITY_GET_ID(n);
+    int label = Graph_GetNodeLabel(g, id);
+    if(label != GRAPH_NO_LABEL) {
+        _Graph_DeleteDeltaElement(g, g->labels[label], g->_labels_dp[label], id, id);
+        g->_node_labels[id] = GRAPH_NO_LABEL;
     }
 
     DataBlock_DeleteItem(g->nodes, ENTITY_GET_ID(n));
@@ -686,27 +1199,34 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
     assert(g && g->_writelocked && nodes && node_count > 0);
 
     /* Create a matrix M where M[j,i] = 1 where:
-     * Node i in is connected to node j. */
-    
+     * Node i in is connected to node j.
+     * Entries live either within a matrix or within its delta matrix,
+     * both are scanned and both are cleared. */
+
     GrB_Matrix A;                       // A = R(M) masked relation matrix.
     GrB_Index nvals;                    // Number of elements in mask.
     GrB_Matrix Mask;                    // Mask noteing all implicitly deleted edges.
+    GrB_Matrix TMask;                   // Transposed Mask.
     GrB_Matrix Nodes;                   // Mask noteing each node marked for deletion.
-    GrB_Matrix adj;                     // Adjacency matrix.
-    GrB_Matrix tadj;                    // Transposed adjacency matrix.
     GrB_Descriptor desc;                // GraphBLAS descriptor.
     GxB_SelectOp selectop;              // GraphBLAS select operator, used to free edges.
-    GxB_MatrixTupleIter *adj_iter;      // iterator over the adjacency matrix.
-    GxB_MatrixTupleIter *tadj_iter;     // iterator over the transposed adjacency matrix.
+    GxB_MatrixTupleIter *adj_iter[2];   // iterators over the adjacency matrix and its delta.
+    GxB_MatrixTupleIter *tadj_iter[2];  // iterators over the transposed adjacency matrix and its delta.
+
+    GrB_Matrix adj[2] = {g->adjacency_matrix, g->_adjacency_dp};
+    GrB_Matrix tadj[2] = {g->_t_adjacency_matrix, g->_t_adjacency_dp};
+    for(int k = 0; k < 2; k++) {
+        g->SynchronizeMatrix(g, adj[k]);
+        g->SynchronizeMatrix(g, tadj[k]);
+        GxB_MatrixTupleIter_new(&adj_iter[k], adj[k]);
+        GxB_MatrixTupleIter_new(&tadj_iter[k], tadj[k]);
+    }
 
     GrB_Descriptor_new(&desc);
-    adj = Graph_GetAdjacencyMatrix(g);
-    tadj = _Graph_Get_Transposed_AdjacencyMatrix(g);
-    GxB_MatrixTupleIter_new(&adj_iter, adj);
-    GxB_MatrixTupleIter_new(&tadj_iter, tadj);
     GxB_SelectOp_new(&selectop, _select_op_free_edge, GrB_UINT64);
     GrB_Matrix_new(&A, GrB_UINT64, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
     GrB_Matrix_new(&Mask, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));    
+    GrB_Matrix_new(&TMask, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
     GrB_Matrix_new(&Nodes, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
 
     // Populate mask with implicit edges, take note of deleted nodes.
@@ -714,25 +1234,30 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
         GrB_Index src;
         GrB_Index dest;
         Node *n = nodes + i;
-        bool depleted = false;
         NodeID ID = ENTITY_GET_ID(n);
 
-        // Outgoing edges.
-        GxB_MatrixTupleIter_iterate_row(adj_iter, ID);
-        while(true) {
-            GxB_MatrixTupleIter_next(adj_iter, NULL,  &dest, &depleted);
-            if(depleted) break;
-            GrB_Matrix_setElement_BOOL(Mask, true, ID, dest);
-        }
+        for(int k = 0; k < 2; k++) {
+            bool depleted = false;
+
+            // Outgoing edges.
+            GxB_MatrixTupleIter_iterate_row(adj_iter[k], ID);
+            while(true) {
+                GxB_MatrixTupleIter_next(adj_iter[k], NULL,  &dest, &depleted);
+                if(depleted) break;
+                GrB_Matrix_setElement_BOOL(Mask, true, ID, dest);
+                GrB_Matrix_setElement_BOOL(TMask, true, dest, ID);
+            }
 
-        depleted = false;
+            depleted = false;
 
-        // Incoming edges.
-        GxB_MatrixTupleIter_iterate_row(tadj_iter, ID);
-        while(true) {
-            GxB_MatrixTupleIter_next(tadj_iter, NULL, &src, &depleted);
-            if(depleted) break;
-            GrB_Matrix_setElement_BOOL(Mask, true, src, ID);
+            // Incoming edges.
+            GxB_MatrixTupleIter_iterate_row(tadj_iter[k], ID);
+            while(true) {
+                GxB_MatrixTupleIter_next(tadj_iter[k], NULL, &src, &depleted);
+                if(depleted) break;
+                GrB_Matrix_setElement_BOOL(Mask, true, src, ID);
+                GrB_Matrix_setElement_BOOL(TMask, true, ID, src);
+            }
         }
 
         GrB_Matrix_setElement_BOOL(Nodes, true, ID, ID);
@@ -750,28 +1275,39 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
     // Free and remove implicit edges from relation matrices.
     int relation_count = Graph_RelationTypeCount(g);
     for(int i = 0; i < relation_count; i++) {
-        GrB_Matrix R = Graph_GetRelationMap(g, i);
-        
-        // Reset mask descriptor.
-        GrB_Descriptor_set(desc, GrB_MASK, GxB_DEFAULT);
-
-        /* Isolate implicit edges.
-         * A will contain all implicitly deleted edges from R. */
-        GrB_Matrix_apply(A, Mask, NULL, GrB_IDENTITY_UINT64, R, desc);
-        
-        /* Free each multi edge array entry in A
-         * Call _select_op_free_edge on each entry of A. */
-        GxB_select(A, GrB_NULL, GrB_NULL, selectop, A, g, GrB_NULL);
+        GrB_Matrix maps[2] = {g->_relations_map[i], g->_relations_map_dp[i]};
+        GrB_Matrix relations[4] = {g->relations[i], g->_relations_dp[i], maps[0], maps[1]};
+        GrB_Matrix t_relations[2] = {g->_t_relations[i], g->_t_relations_dp[i]};
+
+        for(int k = 0; k < 2; k++) {
+            g->SynchronizeMatrix(g, maps[k]);
+
+            // Reset mask descriptor.
+            GrB_Descriptor_set(desc, GrB_MASK, GxB_DEFAULT);
+
+            /* Isolate implicit edges.
+             * A will contain all implicitly deleted edges from R. */
+            GrB_Matrix_apply(A, Mask, NULL, GrB_IDENTITY_UINT64, maps[k], desc);
+
+            /* Free each multi edge array entry in A
+             * Call _select_op_free_edge on each entry of A. */
+            GxB_select(A, GrB_NULL, GrB_NULL, selectop, A, g, GrB_NULL);
+        }
 
         // Clear both relation matrix and its coresponding relation mapping matrix.
         GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
 
         // Remove every entry of R marked by Mask.
-        GrB_Matrix_apply(R, Mask, NULL, GrB_IDENTITY_UINT64, R, desc);
+        for(int k = 0; k < 4; k++) {
+            g->SynchronizeMatrix(g, relations[k]);
+            GrB_Matrix_apply(relations[k], Mask, NULL, GrB_IDENTITY_UINT64, relations[k], desc);
+        }
 
-        R = Graph_GetRelationMatrix(g, i);
-        // Remove every entry of R marked by Mask.
-        GrB_Matrix_apply(R, Mask, NULL, GrB_IDENTITY_UINT64, R, desc);
+        // Remove every entry of transposed R marked by transposed Mask.
+        for(int k = 0; k < 2; k++) {
+            g->SynchronizeMatrix(g, t_relations[k]);
+            GrB_Matrix_apply(t_relations[k], TMask, NULL, GrB_IDENTITY_UINT64, t_relations[k], desc);
+        }
     }
 
     /* Descriptor:
@@ -780,49 +1316,56 @@ void _BulkDeleteNodes(Graph *g, Node *nodes, uint node_count,
     GrB_Descriptor_set(desc, GrB_MASK, GrB_SCMP);
 
     // Update Adjacency and transposed adjacency matrices.
-    GrB_Matrix_apply(adj, Mask, NULL, GrB_IDENTITY_UINT64, adj, desc);
-    GrB_Matrix_apply(tadj, Mask, NULL, GrB_IDENTITY_UINT64, tadj, desc);
-
-    /* Delete nodes
-     * All nodes marked for deleteion are detected, no incoming / outgoing edges. */
-    int node_type_count = Graph_LabelTypeCount(g);
-    for(int i = 0; i < node_type_count; i++) {
-        GrB_Matrix L = Graph_GetLabelMatrix(g, i);
-        GrB_Matrix_apply(L, Nodes, NULL, GrB_IDENTITY_BOOL, L, desc);
+    for(int k = 0; k < 2; k++) {
+        GrB_Matrix_apply(adj[k], Mask, NULL, GrB_IDENTITY_UINT64, adj[k], desc);
+        GrB_Matrix_apply(tadj[k], TMask, NULL, GrB_IDENTITY_UINT64, tadj[k], desc);
     }
 
+    /* Delete nodes
+     * All nodes marked for deleteion are detected, no incoming / outgoing edges.
+     * Only the label matrices of deleted nodes are modified. */
     for(uint i = 0; i < node_count; i++) {
         Node *n = nodes + i;
-        DataBlock_DeleteItem(g->nodes, ENTITY_GET_ID(n));
+        NodeID id = ENTITY_GET_ID(n);
+        int label = Graph_GetNodeLabel(g, id);
+        if(label != GRAPH_NO_LABEL) {
+            _Graph_DeleteDeltaElement(g, g->labels[label], g->_labels_dp[label], id, id);
+            g->_node_labels[id] = GRAPH_NO_LABEL;
+        }
+        DataBlock_DeleteItem(g->nodes, id);
     }
 
     // Clean up.
     GrB_free(&A);
     GrB_free(&desc);
     GrB_free(&Mask);
+    GrB_free(&TMask);
     GrB_free(&Nodes);
     GrB_free(&selectop);
-    GxB_MatrixTupleIter_free(adj_iter);
-    GxB_MatrixTupleIter_free(tadj_iter);
+    for(int k = 0; k < 2; k++) {
+        GxB_MatrixTupleIter_free(adj_iter[k]);
+        GxB_MatrixTupleIter_free(tadj_iter[k]);
+    }
 }
 
 void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
     assert(g && g->_writelocked && edges && edge_count > 0);
 
-    // Describe a matrix entry deletion.
+    /* Describe a matrix entry deletion,
+     * entry lives either within M or within its delta matrix DP. */
     typedef struct {
         GrB_Matrix M;   // Matrix being modified.
+        GrB_Matrix DP;  // M's delta matrix.
         GrB_Index row;  // Row index
         GrB_Index col;  // Column index.
     } PendingDeletion;
 
-    GrB_Matrix R;   // Relation matrix.
-    GrB_Matrix M;   // Relation mapping matrix.
-    GrB_Info info;
+    GrB_Matrix M;   // Relation mapping matrix holding the edge.
     EdgeID edge_id;
     
     PendingDeletion deletion;
     PendingDeletion *deletions = array_new(PendingDeletion, edge_count*2);
+    PendingDeletion *t_deletions = array_new(PendingDeletion, edge_count);
 
     for(int i = 0; i < edge_count; i++) {
         Edge *e = edges + i;
@@ -830,21 +1373,29 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
         NodeID src_id = Edge_GetSrcNodeID(e);
         NodeID dest_id = Edge_GetDestNodeID(e);
 
-        M = Graph_GetRelationMap(g, r);
-        R = Graph_GetRelationMatrix(g, r);
-
-        GrB_Matrix_extractElement_UINT64(&edge_id, M, src_id, dest_id);
+        M = _Graph_LocateEdgeMapping(g, r, src_id, dest_id, &edge_id);
+        assert(M);
 
         if(SINGLE_EDGE(edge_id)) {
             /* Single edge of type R connecting src to dest.
              * delete entry from both M and R. */
-            deletion.M = R;
+            deletion.M = g->relations[r];
+            deletion.DP = g->_relations_dp[r];
             deletion.row = src_id;
             deletion.col = dest_id;
             deletions = array_append(deletions, deletion);
 
-            deletion.M = M;
+            deletion.M = g->_relations_map[r];
+            deletion.DP = g->_relations_map_dp[r];
             deletions = array_append(deletions, deletion);
+
+            /* Transposed relation matrix entries are kept apart
+             * as their coordinates are swapped. */
+            deletion.M = g->_t_relations[r];
+            deletion.DP = g->_t_relations_dp[r];
+            deletion.row = dest_id;
+            deletion.col = src_id;
+            t_deletions = array_append(t_deletions, deletion);
         } else {
             /* Multiple edges connecting src to dest
              * locate specific edge and remove it
@@ -884,7 +1435,12 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
     // Delete entries.
     for(int i = 0; i < array_len(deletions); i++) {
         deletion = deletions[i];
-        assert(GxB_Matrix_Delete(deletion.M, deletion.row, deletion.col) == GrB_SUCCESS);
+        _Graph_DeleteDeltaElement(g, deletion.M, deletion.DP, deletion.row, deletion.col);
+    }
+
+    for(int i = 0; i < array_len(t_deletions); i++) {
+        deletion = t_deletions[i];
+        _Graph_DeleteDeltaElement(g, deletion.M, deletion.DP, deletion.row, deletion.col);
     }
 
     int relationCount = Graph_RelationTypeCount(g);
@@ -897,9 +1453,8 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
         // See if source is connected to destination with additional edges.
         bool connected = false;
         for(int i = 0; i < relationCount; i++) {
-            R = Graph_GetRelationMatrix(g, i);
-            info = GrB_Matrix_extractElement_BOOL(&connected, R, src, dest);
-            if(info == GrB_SUCCESS) break;
+            connected = Graph_EdgeExists(g, src, dest, i);
+            if(connected) break;
         }
 
         /* There are no additional edges connecting source to destination
@@ -907,16 +1462,14 @@ void _BulkDeleteEdges(Graph *g, Edge *edges, size_t edge_count) {
          * It is OK to remove entries from the adjacency matrix, as we're 
          * not trying to extract entries from it. */
         if(!connected) {
-            M = Graph_GetAdjacencyMatrix(g);
-            assert(GxB_Matrix_Delete(M, src, dest) == GrB_SUCCESS);
-
-            M = _Graph_Get_Transposed_AdjacencyMatrix(g);
-            assert(GxB_Matrix_Delete(M, dest, src) == GrB_SUCCESS);
+            _Graph_DeleteDeltaElement(g, g->adjacency_matrix, g->_adjacency_dp, src, dest);
+            _Graph_DeleteDeltaElement(g, g->_t_adjacency_matrix, g->_t_adjacency_dp, dest, src);
         }
     }
 
     // Clean up.
     array_free(deletions);
+    array_free(t_deletions);
 }
 
 /* Removes both nodes and edges from graph. */
@@ -988,6 +1541,14 @@ int Graph_AddLabel(Graph *g) {
     GrB_Matrix m;
     GrB_Matrix_new(&m, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
     array_append(g->labels, m);
+
+    GrB_Matrix dp;
+    GrB_Matrix_new(&dp, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+    array_append(g->_labels_dp, dp);
+    GraphStatistics_AddLabel(&g->_stats);
+    _Graph_PublishVersion(g);
+    // A pinned writer introducing the schema goes on to populate its matrices.
+    if(_reader_graph == g) _reader_version = g->_published;
     return array_len(g->labels)-1;
 }
 
@@ -998,7 +1559,21 @@ int Graph_AddRelationType(Graph *g) {
     GrB_Matrix_new(&m, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
     g->relations = array_append(g->relations, m);
 
+    GrB_Matrix tm;
+    GrB_Matrix_new(&tm, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+    g->_t_relations = array_append(g->_t_relations, tm);
+
+    GrB_Matrix_new(&m, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+    g->_relations_dp = array_append(g->_relations_dp, m);
+
+    GrB_Matrix_new(&tm, GrB_BOOL, Graph_RequiredMatrixDim(g), Graph_RequiredMatrixDim(g));
+    g->_t_relations_dp = array_append(g->_t_relations_dp, tm);
+
     _Graph_AddRelationMap(g);
+    GraphStatistics_AddRelation(&g->_stats);
+    _Graph_PublishVersion(g);
+    // See Graph_AddLabel.
+    if(_reader_graph == g) _reader_version = g->_published;
 
     // Edge mapping for relation K is at _relations_map[K].
     assert(array_len(g->_relations_map) == Graph_RelationTypeCount(g));
@@ -1008,14 +1583,18 @@ int Graph_AddRelationType(Graph *g) {
 
 GrB_Matrix Graph_GetAdjacencyMatrix(const Graph *g) {
     assert(g);
-    GrB_Matrix m = g->adjacency_matrix;
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    GrB_Matrix m = v ? VERSION_MATRIX(v, VERSION_ADJACENCY) : g->adjacency_matrix;
     g->SynchronizeMatrix(g, m);
     return m;
 }
 
 GrB_Matrix Graph_GetLabelMatrix(const Graph *g, int label_idx) {
     assert(g && label_idx < array_len(g->labels));
-    GrB_Matrix m = g->labels[label_idx];
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    // Label introduced after reader got pinned has no nodes.
+    if(v && label_idx >= v->label_count) return Graph_GetZeroMatrix(g);
+    GrB_Matrix m = v ? VERSION_MATRIX(v, VERSION_LABEL(label_idx)) : g->labels[label_idx];
     g->SynchronizeMatrix(g, m);
     return m;
 }
@@ -1027,12 +1606,56 @@ GrB_Matrix Graph_GetRelationMatrix(const Graph *g, int relation_idx) {
     if(relation_idx == GRAPH_NO_RELATION) {
         m = Graph_GetAdjacencyMatrix(g);
     } else {
-        m = g->relations[relation_idx];
+        const GraphVersion *v = _Graph_PinnedVersion(g);
+        if(v && relation_idx >= v->relation_count) return Graph_GetZeroMatrix(g);
+        m = v ? VERSION_MATRIX(v, VERSION_RELATION(v, relation_idx)) : g->relations[relation_idx];
         g->SynchronizeMatrix(g, m);
     }
     return m;
 }
 
+GrB_Matrix Graph_GetTransposedRelationMatrix(const Graph *g, int relation_idx) {
+    assert(g && (relation_idx == GRAPH_NO_RELATION || relation_idx < Graph_RelationTypeCount(g)));
+    GrB_Matrix m;
+
+    if(relation_idx == GRAPH_NO_RELATION) {
+        m = _Graph_Get_Transposed_AdjacencyMatrix(g);
+    } else {
+        const GraphVersion *v = _Graph_PinnedVersion(g);
+        if(v && relation_idx >= v->relation_count) return Graph_GetZeroMatrix(g);
+        m = v ? VERSION_MATRIX(v, VERSION_T_RELATION(v, relation_idx)) : g->_t_relations[relation_idx];
+        g->SynchronizeMatrix(g, m);
+    }
+    return m;
+}
+
+GrB_Matrix Graph_GetTransposedMatrix(const Graph *g, const GrB_Matrix m) {
+    assert(g && m);
+
+    const GraphVersion *v = _Graph_PinnedVersion(g);
+    if(v) {
+        if(m == VERSION_MATRIX(v, VERSION_ADJACENCY)) return _Graph_Get_Transposed_AdjacencyMatrix(g);
+        if(m == VERSION_MATRIX(v, VERSION_T_ADJACENCY)) return Graph_GetAdjacencyMatrix(g);
+        for(uint i = 0; i < v->relation_count; i++) {
+            if(m == VERSION_MATRIX(v, VERSION_RELATION(v, i))) return Graph_GetTransposedRelationMatrix(g, i);
+            if(m == VERSION_MATRIX(v, VERSION_T_RELATION(v, i))) return Graph_GetRelationMatrix(g, i);
+        }
+        return NULL;
+    }
+
+    if(m == g->adjacency_matrix) return _Graph_Get_Transposed_AdjacencyMatrix(g);
+    if(m == g->_t_adjacency_matrix) return Graph_GetAdjacencyMatrix(g);
+
+    int relationCount = Graph_RelationTypeCount(g);
+    for(int i = 0; i < relationCount; i++) {
+        if(m == g->relations[i]) return Graph_GetTransposedRelationMatrix(g, i);
+        if(m == g->_t_relations[i]) return Graph_GetRelationMatrix(g, i);
+    }
+
+    // m isn't maintained by the graph.
+    return NULL;
+}
+
 GrB_Matrix Graph_GetZeroMatrix(const Graph *g) {
     GrB_Index nvals;
     GrB_Matrix z = g->_zero_matrix;
@@ -1046,6 +1669,14 @@ GrB_Matrix Graph_GetZeroMatrix(const Graph *g) {
 
 void Graph_Free(Graph *g) {
     assert(g);
+    /* A background fold reads the graph's matrices, exclusive lockers
+     * drain folds before acquiring the lock (Graph_AwaitFold). */
+    if(!g->_writelocked) Graph_AwaitFold(g);
+    assert(!g->_folding);
+
+    // Matrices are about to be freed, avoid any further updates.
+    Graph_SetMatrixPolicy(g, DISABLED);
+
     // Free matrices.
     Entity *en;
     DataBlockIterator *it;
@@ -1055,23 +1686,45 @@ void Graph_Free(Graph *g) {
     GrB_Matrix_free(&m);
     GrB_Matrix_free(&z);
     GrB_Matrix_free(&tm);
+    GrB_Matrix_free(&g->_adjacency_dp);
+    GrB_Matrix_free(&g->_t_adjacency_dp);
+    _Graph_ReclaimRetired(g, 0);
+    _Graph_ReclaimRetired(g, 1);
+    _Graph_FreeVersion(g->_published);
 
     uint32_t relationCount = Graph_RelationTypeCount(g);
     for(int i = 0; i < relationCount; i++) {
         m = g->relations[i];
         GrB_Matrix_free(&m);
+        m = g->_t_relations[i];
+        GrB_Matrix_free(&m);
         m = g->_relations_map[i];
         GrB_Matrix_free(&m);
+        m = g->_relations_dp[i];
+        GrB_Matrix_free(&m);
+        m = g->_t_relations_dp[i];
+        GrB_Matrix_free(&m);
+        m = g->_relations_map_dp[i];
+        GrB_Matrix_free(&m);
     }
     array_free(g->relations);
+    array_free(g->_t_relations);
     array_free(g->_relations_map);
+    array_free(g->_relations_dp);
+    array_free(g->_t_relations_dp);
+    array_free(g->_relations_map_dp);
 
     uint32_t labelCount = array_len(g->labels);
     for(int i = 0; i < labelCount; i++) {
         m = g->labels[i];
         GrB_Matrix_free(&m);
+        m = g->_labels_dp[i];
+        GrB_Matrix_free(&m);
     }
     array_free(g->labels);
+    array_free(g->_labels_dp);
+    rm_free(g->_node_labels);
+    GraphStatistics_Free(&g->_stats);
 
     it = Graph_ScanNodes(g);
     while ((en = (Entity*)DataBlockIterator_Next(it)) != NULL)
@@ -1092,6 +1745,7 @@ void Graph_Free(Graph *g) {
     // Destroy graph-scoped locks.
     assert(pthread_mutex_destroy(&g->_mutex) == 0);
     assert(pthread_mutex_destroy(&g->_writers_mutex) == 0);
+    assert(pthread_cond_destroy(&g->_fold_done) == 0);
 
     if(g->_writelocked) Graph_ReleaseLock(g);
     assert(pthread_rwlock_destroy(&g->_rwlock) == 0);
@@ -11,6 +11,7 @@
 
 #include "entities/node.h"
 #include "entities/edge.h"
+#include "graph_statistics.h"
 #include "../redismodule.h"
 #include "../util/triemap/triemap.h"
 #include "../util/datablock/datablock.h"
@@ -25,6 +26,7 @@
 #define GRAPH_UNKNOWN_LABEL -2                  // Labels are numbered [0-N], -2 represents an unknown relation.
 #define GRAPH_NO_RELATION -1                    // Relations are numbered [0-N], -1 represents no relation.
 #define GRAPH_UNKNOWN_RELATION -2               // Relations are numbered [0-N], -2 represents an unknown relation.
+#define GRAPH_DELTA_FOLD_THRESHOLD 10000        // Number of pending matrix additions which triggers folding.
 
 // Mask with most significat bit on 10000...
 #define MSB_MASK (1UL << (sizeof(EntityID) * 8 - 1))
@@ -53,6 +55,8 @@ typedef enum {
 
 // Forward declaration of Graph struct
 typedef struct Graph Graph;
+// Set of matrices readers are pinned to, see graph.c.
+typedef struct GraphVersion GraphVersion;
 // typedef for synchronization function pointer
 typedef void (*SyncMatrixFunc)(const Graph*, GrB_Matrix);
 
@@ -62,29 +66,73 @@ struct Graph {
     GrB_Matrix adjacency_matrix;        // Adjacency matrix, holds all graph connections.
     GrB_Matrix _t_adjacency_matrix;     // Transposed Adjacency matrix.
     GrB_Matrix *labels;                 // Label matrices.
+    int *_node_labels;                  // Maps node ID to its label.
+    size_t _node_labels_cap;            // Number of node IDs _node_labels can hold.
     GrB_Matrix *relations;              // Relation matrices.
+    GrB_Matrix *_t_relations;           // Transposed relation matrices.
     GrB_Matrix *_relations_map;         // Maps from (relation, row, col) to edge id.
+    GrB_Matrix _adjacency_dp;           // Additions to the adjacency matrix yet to be folded.
+    GrB_Matrix _t_adjacency_dp;         // Additions to the transposed adjacency matrix yet to be folded.
+    GrB_Matrix *_labels_dp;             // Additions to label matrices yet to be folded.
+    GrB_Matrix *_relations_dp;          // Additions to relation matrices yet to be folded.
+    GrB_Matrix *_t_relations_dp;        // Additions to transposed relation matrices yet to be folded.
+    GrB_Matrix *_relations_map_dp;      // Additions to relation mapping matrices yet to be folded.
     GrB_Matrix _zero_matrix;            // Zero matrix.
+    uint64_t _epoch;                    // Matrices version, advanced whenever deltas are folded.
+    uint64_t _epoch_readers[2];         // Number of active readers within the current and previous epochs.
+    GraphVersion *_published;           // Matrices new readers are pinned to.
+    GrB_Matrix *_retired[2];            // (matrix, delta) pairs replaced within the current and previous epochs.
+    uint _retired_count[2];             // Number of retired matrices.
+    GraphVersion **_retired_versions[2];  // Versions replaced within the current and previous epochs.
+    GrB_Index _pending;                 // Number of pending additions as of the last commit.
+    bool _folding;                      // true while deltas are folded in the background.
+    pthread_cond_t _fold_done;          // Signaled once a background fold is done.
     pthread_mutex_t _writers_mutex;     // Mutex restrict single writer.
     pthread_mutex_t _mutex;             // Mutex for accessing critical sections.
     pthread_rwlock_t _rwlock;           // Read-write lock scoped to this specific graph
     bool _writelocked;                  // true if the read-write lock was acquired by a writer
+    GraphStatistics _stats;             // Cardinality statistics, updated as writers release the graph and on load.
     SyncMatrixFunc SynchronizeMatrix;   // Function pointer to matrix synchronization routine.
 };
 
 /* Graph synchronization functions
  * The graph is initialized with a read-write lock allowing
- * concurrent access from one writer or N readers. */
-/* Acquire a lock that does not restrict access from additional reader threads */
+ * concurrent access from one writer or N readers.
+ * Readers are pinned to matrix versions only, this isn't snapshot isolation:
+ * entities (DataBlocks), their properties and matrix contents aren't versioned,
+ * as such committing writers, bulk insert and graph deletion hold the lock
+ * exclusively and block readers for the duration of their commit.
+ * Matrices are replaced (rather than modified) only when deltas are folded or
+ * labels and relations are introduced, such that a reader sees a single set of
+ * matrices for the duration of its read lock.
+ * Writers are pinned the same way from Graph_WriterEnter until Graph_WriterLeave,
+ * deltas are folded on a background thread holding a read lock only. */
+/* Acquire a lock that does not restrict access from additional reader threads,
+ * reader is pinned to the current matrices version until the lock is released. */
 void Graph_AcquireReadLock(Graph *g);
 
 /* Acquire a lock for exclusive access to this graph's data */
 void Graph_AcquireWriteLock(Graph *g);
 
-/* Writer request access to graph. */
+/* Reader state of a thread: graph it reads, epoch and matrices version it is pinned to. */
+typedef struct {
+    const Graph *g;
+    uint epoch;
+    const GraphVersion *version;
+} GraphReader;
+
+/* Returns the calling thread's reader state. */
+GraphReader Graph_CurrentReader(void);
+
+/* Binds reader state captured by Graph_CurrentReader to the calling thread,
+ * such that threads working on behalf of a reader see the matrices it is pinned to.
+ * Valid as long as the capturing thread holds its read lock. */
+void Graph_BindReader(GraphReader reader);
+
+/* Writer request access to graph, pins writer to the current matrices version. */
 void Graph_WriterEnter(Graph *g);
 
-/* Writer release access to graph. */
+/* Writer release access to graph, schedules a fold if enough additions are pending. */
 void Graph_WriterLeave(Graph *g);
 
 /* Release the held lock */
@@ -93,9 +141,27 @@ void Graph_ReleaseLock(Graph *g);
 /* Choose the current matrix synchronization policy. */
 void Graph_SetMatrixPolicy(Graph *g, MATRIX_POLICY policy);
 
-/* Synchronize and resize all matrices in graph. */
+/* Synchronize and resize all matrices in graph,
+ * folding pending additions into their matrices and refreshing statistics.
+ * Caller must have exclusive access to the graph. */
 void Graph_ApplyAllPending(Graph *g);
 
+/* Folds pending additions into their matrices once their number
+ * passes GRAPH_DELTA_FOLD_THRESHOLD, folded matrices are published as a new
+ * version without blocking readers, replaced matrices are reclaimed
+ * once readers pinned to them are done.
+ * Caller must not be pinned to the graph (reader or writer). */
+void Graph_FoldDeltas(Graph *g);
+
+/* Folds deltas on a background thread unless a fold is already running
+ * or too few additions are pending, called as writers leave the graph. */
+void Graph_ScheduleFold(Graph *g);
+
+/* Waits for a background fold to finish, callers about to lock the graph
+ * exclusively and free it must hold writer access (Graph_WriterEnter)
+ * such that no further folds are scheduled. */
+void Graph_AwaitFold(Graph *g);
+
 // Create a new graph.
 Graph *Graph_New (
     size_t node_cap,    // Allocation size for node datablocks and matrix dimensions.
@@ -194,6 +260,11 @@ size_t Graph_LabeledNodeCount (
     int label
 );
 
+// Returns graph statistics, valid as long as the graph is locked.
+const GraphStatistics *Graph_Statistics (
+    const Graph *g
+);
+
 // Returns number of edges in the graph.
 size_t Graph_EdgeCount (
     const Graph *g
@@ -289,6 +360,28 @@ GrB_Matrix Graph_GetRelationMatrix (
     int relation        // Relation described by matrix.
 );
 
+// Retrieves a transposed typed adjacency matrix.
+// Matrix is resized if its size doesn't match graph's node count.
+GrB_Matrix Graph_GetTransposedRelationMatrix (
+    const Graph *g,     // Graph from which to get adjacency matrix.
+    int relation        // Relation described by matrix.
+);
+
+// Retrieves the transposed version of a relation or adjacency matrix
+// maintained by the graph, returns NULL if m isn't maintained by g.
+GrB_Matrix Graph_GetTransposedMatrix (
+    const Graph *g,     // Graph from which to get adjacency matrix.
+    const GrB_Matrix m  // Matrix to transpose.
+);
+
+// Retrieves the matrix holding additions to m which were not yet folded into it,
+// returns NULL if there are none or if m isn't maintained by g.
+// Entries of m are the union of m and its delta matrix.
+GrB_Matrix Graph_GetDeltaMatrix (
+    const Graph *g,     // Graph maintaining m.
+    const GrB_Matrix m  // Graph matrix.
+);
+
 // Retrieve a relation mapping matrix coresponding to relation_idx
 GrB_Matrix Graph_GetRelationMap (
     const Graph *g,     // Graph from which to get mapping matrix.
@@ -0,0 +1,81 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "graph_statistics.h"
+#include "../util/arr.h"
+#include <string.h>
+
+void GraphStatistics_Init(GraphStatistics *stats) {
+    stats->node_count = 0;
+    stats->label_counts = array_new(uint64_t, 16);
+    stats->relations = array_new(RelationStatistics, 16);
+    memset(&stats->adjacency, 0, sizeof(RelationStatistics));
+}
+
+void GraphStatistics_AddLabel(GraphStatistics *stats) {
+    stats->label_counts = array_append(stats->label_counts, 0);
+}
+
+void GraphStatistics_AddRelation(GraphStatistics *stats) {
+    RelationStatistics r;
+    memset(&r, 0, sizeof(RelationStatistics));
+    stats->relations = array_append(stats->relations, r);
+}
+
+static GrB_Index _nvals(GrB_Matrix M) {
+    GrB_Index nvals = 0;
+    if(M) GrB_Matrix_nvals(&nvals, M);
+    return nvals;
+}
+
+/* Computes the number of non empty rows in M + DP
+ * and the number of entries in the fullest row. */
+static void _RelationStatistics_RowDegrees(GrB_Matrix M, GrB_Matrix DP, uint64_t *rows, uint64_t *max) {
+    GrB_Index n;
+    GrB_Vector degrees;
+    GrB_Matrix_nrows(&n, M);
+    GrB_Vector_new(&degrees, GrB_UINT64, n);
+
+    // Boolean entries are typecasted to 1 and summed up per row.
+    GrB_Matrix_reduce_BinaryOp(degrees, GrB_NULL, GrB_NULL, GrB_PLUS_UINT64, M, GrB_NULL);
+    if(DP) GrB_Matrix_reduce_BinaryOp(degrees, GrB_NULL, GrB_PLUS_UINT64, GrB_PLUS_UINT64, DP, GrB_NULL);
+
+    GrB_Index nvals;
+    GrB_Vector_nvals(&nvals, degrees);
+    *rows = nvals;
+    *max = 0;
+    GrB_Vector_reduce_UINT64(max, GrB_NULL, GxB_MAX_UINT64_MONOID, degrees, GrB_NULL);
+    GrB_Vector_free(&degrees);
+}
+
+void RelationStatistics_Update(RelationStatistics *stats, GrB_Matrix R, GrB_Matrix DP, GrB_Matrix TR, GrB_Matrix TDP) {
+    stats->edge_count = _nvals(R) + _nvals(DP);
+
+    // Skip resampling as long as the number of connections is about the same.
+    uint64_t sampled = stats->sampled_edge_count;
+    uint64_t drift = (stats->edge_count > sampled) ?
+                     stats->edge_count - sampled : sampled - stats->edge_count;
+    if(sampled > 0 && drift <= sampled * STATS_DEGREE_RESAMPLE_RATIO) return;
+
+    _RelationStatistics_RowDegrees(R, DP, &stats->src_count, &stats->max_out_degree);
+    _RelationStatistics_RowDegrees(TR, TDP, &stats->dest_count, &stats->max_in_degree);
+    stats->sampled_edge_count = stats->edge_count;
+}
+
+double RelationStatistics_AvgOutDegree(const RelationStatistics *stats) {
+    if(stats->src_count == 0) return 0;
+    return (double)stats->edge_count / stats->src_count;
+}
+
+double RelationStatistics_AvgInDegree(const RelationStatistics *stats) {
+    if(stats->dest_count == 0) return 0;
+    return (double)stats->edge_count / stats->dest_count;
+}
+
+void GraphStatistics_Free(GraphStatistics *stats) {
+    array_free(stats->label_counts);
+    array_free(stats->relations);
+}
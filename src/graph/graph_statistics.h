@@ -0,0 +1,65 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef GRAPH_STATISTICS_H
+#define GRAPH_STATISTICS_H
+
+#include <stdint.h>
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+/* Relative change in a relation's number of connections
+ * since its degrees were last sampled which triggers resampling. */
+#define STATS_DEGREE_RESAMPLE_RATIO 0.1
+
+// Cardinality statistics of a single relation (or of all relations).
+typedef struct {
+    uint64_t edge_count;            // Number of connected (src, dest) pairs.
+    uint64_t src_count;             // Number of nodes with outgoing connections.
+    uint64_t dest_count;            // Number of nodes with incoming connections.
+    uint64_t max_out_degree;        // Maximum number of outgoing connections of a single node.
+    uint64_t max_in_degree;         // Maximum number of incoming connections of a single node.
+    uint64_t sampled_edge_count;    // Number of connections when degrees were last sampled.
+} RelationStatistics;
+
+/* Graph statistics, maintained by the graph whenever a writer
+ * releases it, used by the planner to estimate cardinalities. */
+typedef struct {
+    uint64_t node_count;            // Number of nodes.
+    uint64_t *label_counts;         // Number of nodes per label.
+    RelationStatistics *relations;  // Statistics per relation type.
+    RelationStatistics adjacency;   // Statistics across all relation types.
+} GraphStatistics;
+
+// Initialize empty statistics.
+void GraphStatistics_Init(GraphStatistics *stats);
+
+// Introduce a new label.
+void GraphStatistics_AddLabel(GraphStatistics *stats);
+
+// Introduce a new relation type.
+void GraphStatistics_AddRelation(GraphStatistics *stats);
+
+/* Update relation statistics from relation matrix R, its transpose TR
+ * and their pending additions (DP, TDP), degrees are only resampled once
+ * the number of connections drifted by STATS_DEGREE_RESAMPLE_RATIO. */
+void RelationStatistics_Update (
+    RelationStatistics *stats,
+    GrB_Matrix R,
+    GrB_Matrix DP,
+    GrB_Matrix TR,
+    GrB_Matrix TDP
+);
+
+// Average number of outgoing connections of a node with outgoing connections.
+double RelationStatistics_AvgOutDegree(const RelationStatistics *stats);
+
+// Average number of incoming connections of a node with incoming connections.
+double RelationStatistics_AvgInDegree(const RelationStatistics *stats);
+
+// Free statistics internals.
+void GraphStatistics_Free(GraphStatistics *stats);
+
+#endif
@@ -7,6 +7,7 @@
 #include <sys/param.h>
 #include "graphcontext.h"
 #include "serializers/graphcontext_type.h"
+#include "../execution_plan/plan_cache.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
 #include "../redismodule.h"
@@ -32,6 +33,7 @@ GraphContext* GraphContext_New(RedisModuleCtx *ctx, const char *graphname,
 
   // No indicies.
   gc->index_count = 0;
+  gc->schema_version = 0;
 
   // Initialize the graph's matrices and datablock storage
   gc->g = Graph_New(node_cap, edge_cap);
@@ -42,6 +44,8 @@ GraphContext* GraphContext_New(RedisModuleCtx *ctx, const char *graphname,
 
   gc->string_mapping = array_new(char*, 64);
   gc->attributes = NewTrieMap();
+  gc->string_pool = StringPool_New();
+  gc->plan_cache = PlanCache_New();
 
   pthread_setspecific(_tlsGCKey, gc);
 
@@ -119,14 +123,16 @@ Schema* GraphContext_AddSchema(GraphContext *gc, const char *label, SchemaType t
 
   if(t == SCHEMA_NODE) {
     label_id = Graph_AddLabel(gc->g);
-    schema = Schema_New(label, label_id);
+    schema = Schema_New(label, label_id, t);
     gc->node_schemas = array_append(gc->node_schemas, schema);
   } else {
     label_id = Graph_AddRelationType(gc->g);
-    schema = Schema_New(label, label_id);
+    schema = Schema_New(label, label_id, t);
     gc->relation_schemas = array_append(gc->relation_schemas, schema);
   }
 
+  // Cached plans might refer to the new schema as an unknown label or relation.
+  __atomic_add_fetch(&gc->schema_version, 1, __ATOMIC_SEQ_CST);
   return schema;
 }
 
@@ -142,6 +148,15 @@ const char* GraphContext_GetEdgeRelationType(const GraphContext *gc, Edge *e) {
     return gc->relation_schemas[reltype_id]->name;
 }
 
+SIValue GraphContext_InternValue(GraphContext *gc, SIValue v) {
+  if(!(v.type & (T_STRING | T_CONSTSTRING))) return v;
+  SIValue interned = v;
+  interned.type = T_STRING;
+  interned.stringval = StringPool_Intern(gc->string_pool, v.stringval);
+  interned.allocation = M_INTERNED;
+  return interned;
+}
+
 uint GraphContext_AttributeCount(GraphContext *gc) {
     return gc->attributes->cardinality;
 }
@@ -185,9 +200,9 @@ bool GraphContext_HasIndices(GraphContext *gc) {
   return (gc->index_count > 0);
 }
 
-Index* GraphContext_GetIndex(const GraphContext *gc, const char *label, const char *attribute) {
+static Index* _GraphContext_GetIndex(const GraphContext *gc, const char *label, const char *attribute, SchemaType t) {
   // Retrieve the schema for this label
-  Schema *schema = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  Schema *schema = GraphContext_GetSchema(gc, label, t);
   if (schema == NULL) return NULL;
 
   Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
@@ -196,26 +211,29 @@ Index* GraphContext_GetIndex(const GraphContext *gc, const char *label, const ch
   return Schema_GetIndex(schema, attr_id);
 }
 
-int GraphContext_AddIndex(GraphContext *gc, const char *label, const char *attribute) {
+static int _GraphContext_AddIndex(GraphContext *gc, const char *label, const char *attribute,
+                                  SchemaType t, IndexType type) {
   // Retrieve the schema for this label
-  Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  Schema *s = GraphContext_GetSchema(gc, label, t);
   if (s == NULL) return INDEX_FAIL;
 
   Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
   if (attr_id == ATTRIBUTE_NOTFOUND) return INDEX_FAIL;
 
   // Associate the new index with the attribute in the schema.
-  if (Schema_AddIndex(s, attr_id) == INDEX_OK) {
+  if (Schema_AddIndex(s, attr_id, type) == INDEX_OK) {
       gc->index_count++;
+      // Cached plans might benefit from the new index.
+      PlanCache_Clear(gc->plan_cache);
       return INDEX_OK;
   }
 
   return INDEX_FAIL;
 }
 
-int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *attribute) {
+static int _GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *attribute, SchemaType t) {
   // Retrieve the schema for this label
-  Schema *schema = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  Schema *schema = GraphContext_GetSchema(gc, label, t);
   if (schema == NULL) return INDEX_FAIL;
 
   Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
@@ -223,6 +241,97 @@ int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *at
   // Remove the index association from the label schema
   if (Schema_RemoveIndex(schema, attr_id) == INDEX_OK) {
       gc->index_count--;
+      // Cached plans might scan the removed index.
+      PlanCache_Clear(gc->plan_cache);
+      return INDEX_OK;
+  }
+
+  return INDEX_FAIL;
+}
+
+Index* GraphContext_GetIndex(const GraphContext *gc, const char *label, const char *attribute) {
+  return _GraphContext_GetIndex(gc, label, attribute, SCHEMA_NODE);
+}
+
+int GraphContext_AddIndex(GraphContext *gc, const char *label, const char *attribute, IndexType type) {
+  return _GraphContext_AddIndex(gc, label, attribute, SCHEMA_NODE, type);
+}
+
+int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *attribute) {
+  return _GraphContext_DeleteIndex(gc, label, attribute, SCHEMA_NODE);
+}
+
+Index* GraphContext_GetEdgeIndex(const GraphContext *gc, const char *relation, const char *attribute) {
+  return _GraphContext_GetIndex(gc, relation, attribute, SCHEMA_EDGE);
+}
+
+int GraphContext_AddEdgeIndex(GraphContext *gc, const char *relation, const char *attribute, IndexType type) {
+  return _GraphContext_AddIndex(gc, relation, attribute, SCHEMA_EDGE, type);
+}
+
+int GraphContext_DeleteEdgeIndex(GraphContext *gc, const char *relation, const char *attribute) {
+  return _GraphContext_DeleteIndex(gc, relation, attribute, SCHEMA_EDGE);
+}
+
+/* Resolves attribute IDs of a composite index,
+ * returns false if any of the attributes doesn't exist. */
+static bool _GraphContext_CompositeAttributeIDs(const GraphContext *gc, const char **attributes,
+                                                uint attr_count, Attribute_ID *attr_ids) {
+  for (uint i = 0; i < attr_count; i++) {
+    attr_ids[i] = GraphContext_GetAttributeID(gc, attributes[i]);
+    if (attr_ids[i] == ATTRIBUTE_NOTFOUND) return false;
+  }
+  return true;
+}
+
+CompositeIndex* GraphContext_GetCompositeIndex(const GraphContext *gc, const char *label, const char **attributes, uint attr_count) {
+  Schema *schema = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  if (schema == NULL) return NULL;
+
+  Attribute_ID attr_ids[attr_count];
+  if (!_GraphContext_CompositeAttributeIDs(gc, attributes, attr_count, attr_ids)) return NULL;
+
+  return Schema_GetCompositeIndex(schema, attr_ids, attr_count);
+}
+
+int GraphContext_AddCompositeIndex(GraphContext *gc, const char *label, const char **attributes, uint attr_count,
+                                   IndexType type) {
+  if (attr_count < 2 || attr_count > COMPOSITE_INDEX_MAX_ATTRIBUTES) return INDEX_FAIL;
+  if (type == IDX_HASH) return INDEX_FAIL;
+  Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  if (s == NULL) return INDEX_FAIL;
+
+  Attribute_ID attr_ids[attr_count];
+  if (!_GraphContext_CompositeAttributeIDs(gc, attributes, attr_count, attr_ids)) return INDEX_FAIL;
+
+  // An attribute can appear only once within a key.
+  for (uint i = 0; i < attr_count; i++) {
+    for (uint j = i + 1; j < attr_count; j++) {
+      if (attr_ids[i] == attr_ids[j]) return INDEX_FAIL;
+    }
+  }
+
+  if (Schema_AddCompositeIndex(s, attr_ids, attr_count, type) == INDEX_OK) {
+      gc->index_count++;
+      // Cached plans might benefit from the new index.
+      PlanCache_Clear(gc->plan_cache);
+      return INDEX_OK;
+  }
+
+  return INDEX_FAIL;
+}
+
+int GraphContext_DeleteCompositeIndex(GraphContext *gc, const char *label, const char **attributes, uint attr_count) {
+  Schema *schema = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+  if (schema == NULL) return INDEX_FAIL;
+
+  Attribute_ID attr_ids[attr_count];
+  if (!_GraphContext_CompositeAttributeIDs(gc, attributes, attr_count, attr_ids)) return INDEX_FAIL;
+
+  if (Schema_RemoveCompositeIndex(schema, attr_ids, attr_count) == INDEX_OK) {
+      gc->index_count--;
+      // Cached plans might scan the removed index.
+      PlanCache_Clear(gc->plan_cache);
       return INDEX_OK;
   }
 
@@ -230,8 +339,11 @@ int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *at
 }
 
 // Add references to a node to all indices built upon its properties
+// and store its properties in the schema's columns.
 void GraphContext_AddNodeToIndices(GraphContext *gc, Schema *s, Node *n) {
-  if(!s || !GraphContext_HasIndices(gc)) return;
+  if(!s) return;
+  Schema_AddNodeToColumns(s, n);
+  if(!GraphContext_HasIndices(gc)) return;
 
   /* For each index in schema, see if node 
    * contains indexed attribute. */
@@ -240,14 +352,20 @@ void GraphContext_AddNodeToIndices(GraphContext *gc, Schema *s, Node *n) {
     Index *idx = s->indices[i];
     Attribute_ID attr_id = GraphContext_GetAttributeID(gc, idx->attribute);
     // See if node contains current property.
-    SIValue *v = GraphEntity_GetProperty((GraphEntity*)n, attr_id);
-    if(v == PROPERTY_NOTFOUND) continue;
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)n, attr_id);
+    if(SIValue_IsNull(v)) continue;
 
-    Index_InsertNode(idx, n->entity->id, v);
+    Index_InsertNode(idx, n->entity->id, &v);
+  }
+
+  index_count = Schema_CompositeIndexCount(s);
+  for(unsigned int i = 0; i < index_count; i++) {
+    CompositeIndex_InsertNode(s->composite_indices[i], n);
   }
 }
 
 // Delete all references to a node from any indices built upon its properties
+// and from the schema's columns.
 void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n) {
   Schema *s = NULL;
   EntityID node_id = ENTITY_GET_ID(n);
@@ -261,15 +379,61 @@ void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n) {
     if (schema_id == GRAPH_NO_LABEL) return;
     s = GraphContext_GetSchemaByID(gc, schema_id, SCHEMA_NODE);
   }
+  if(!s) return;
 
   // Update any indices this entity is represented in
   unsigned short idx_count = Schema_IndexCount(s);
   for(unsigned short i = 0; i < idx_count; i++) {
     Index *idx = s->indices[i];
     // See if node contains current property.
-    SIValue *v = GraphEntity_GetProperty((GraphEntity*)n, idx->attr_id);
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)n, idx->attr_id);
+    if(SIValue_IsNull(v)) continue;
+    Index_DeleteNode(idx, node_id, &v);
+  }
+
+  idx_count = Schema_CompositeIndexCount(s);
+  for(unsigned short i = 0; i < idx_count; i++) {
+    CompositeIndex_DeleteNode(s->composite_indices[i], n);
+  }
+
+  // Index keys are read from columns, release node's column values last.
+  Schema_RemoveNodeFromColumns(s, node_id);
+}
+
+// Add references to an edge to all indices built upon its relation's properties.
+void GraphContext_AddEdgeToIndices(GraphContext *gc, Schema *s, Edge *e) {
+  if(!s || !GraphContext_HasIndices(gc)) return;
+
+  unsigned short index_count = Schema_IndexCount(s);
+  for(unsigned short i = 0; i < index_count; i++) {
+    Index *idx = s->indices[i];
+    // See if edge contains current property.
+    SIValue *v = GraphEntity_GetProperty((GraphEntity*)e, idx->attr_id);
     if(v == PROPERTY_NOTFOUND) continue;
-    Index_DeleteNode(idx, node_id, v);
+    Index_InsertEdge(idx, e, v);
+  }
+}
+
+// Delete all references to an edge from any indices built upon its properties.
+void GraphContext_DeleteEdgeFromIndices(GraphContext *gc, Edge *e) {
+  if(!GraphContext_HasIndices(gc)) return;
+
+  int relation_id = Edge_GetRelationID(e);
+  // Relation is unknown for edges matched without a relation type.
+  if(relation_id == GRAPH_UNKNOWN_RELATION || relation_id == GRAPH_NO_RELATION) {
+    relation_id = Graph_GetEdgeRelation(gc->g, e);
+  }
+  Schema *s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
+  if(!s) return;
+
+  EdgeID edge_id = ENTITY_GET_ID(e);
+  unsigned short index_count = Schema_IndexCount(s);
+  for(unsigned short i = 0; i < index_count; i++) {
+    Index *idx = s->indices[i];
+    // See if edge contains current property.
+    SIValue *v = GraphEntity_GetProperty((GraphEntity*)e, idx->attr_id);
+    if(v == PROPERTY_NOTFOUND) continue;
+    Index_DeleteEdge(idx, edge_id, v);
   }
 }
 
@@ -279,6 +443,8 @@ void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n) {
 
 // Free all data associated with graph
 void GraphContext_Free(GraphContext *gc) {
+  // Cached plans refer to graph data.
+  if(gc->plan_cache) PlanCache_Free(gc->plan_cache);
   Graph_Free(gc->g);
   rm_free(gc->graph_name);
 
@@ -312,5 +478,8 @@ void GraphContext_Free(GraphContext *gc) {
     array_free(gc->string_mapping);
   }
 
+  // Entities were freed along with the graph, releasing their strings.
+  if(gc->string_pool) StringPool_Free(gc->string_pool);
+
   rm_free(gc);
 }
@@ -12,6 +12,7 @@
 #include "../index/index.h"
 #include "../schema/schema.h"
 #include "graph.h"
+#include "../util/string_pool.h"
 
 typedef struct {
   char *graph_name;                 // String associated with graph
@@ -23,7 +24,12 @@ typedef struct {
   Schema **node_schemas;            // Array of schemas for each node label 
   Schema **relation_schemas;        // Array of schemas for each relation type
 
-  unsigned short index_count;       // Number of indicies.
+  unsigned short index_count;       // Number of indicies, composite and edge indices included.
+  uint64_t schema_version;          // Advanced whenever a label or relation type is introduced.
+
+  StringPool *string_pool;          // Interned string property values
+
+  struct PlanCache *plan_cache;     // Cached queries, see execution_plan/plan_cache.h
 } GraphContext;
 
 /* GraphContext API */
@@ -52,6 +58,11 @@ const char* GraphContext_GetNodeLabel(const GraphContext *gc, Node *n);
 // Retrieve the relation type string for a given Edge object
 const char* GraphContext_GetEdgeRelationType(const GraphContext *gc, Edge *e);
 
+// Returns a copy of v to be stored as an entity property,
+// string values are interned within the graph's string pool.
+// v itself is left untouched.
+SIValue GraphContext_InternValue(GraphContext *gc, SIValue v);
+
 // Retrieve number of unique attribute keys
 uint GraphContext_AttributeCount(GraphContext *gc);
 
@@ -68,15 +79,32 @@ Attribute_ID GraphContext_GetAttributeID(const GraphContext *gc, const char *str
 bool GraphContext_HasIndices(GraphContext *gc);
 // Attempt to retrieve an index on the given label and attribute
 Index* GraphContext_GetIndex(const GraphContext *gc, const char *label, const char *attribute);
-// Create and populate an index for the given label and attribute
-int GraphContext_AddIndex(GraphContext *gc, const char *label, const char *attribute);
+// Create and populate an index of the given type for the given label and attribute
+int GraphContext_AddIndex(GraphContext *gc, const char *label, const char *attribute, IndexType type);
 // Remove and free an index
 int GraphContext_DeleteIndex(GraphContext *gc, const char *label, const char *attribute);
-
-// Add a single node to all indices its properties match
+// Attempt to retrieve an edge index on the given relation and attribute
+Index* GraphContext_GetEdgeIndex(const GraphContext *gc, const char *relation, const char *attribute);
+// Create and populate an edge index of the given type for the given relation and attribute
+int GraphContext_AddEdgeIndex(GraphContext *gc, const char *relation, const char *attribute, IndexType type);
+// Remove and free an edge index
+int GraphContext_DeleteEdgeIndex(GraphContext *gc, const char *relation, const char *attribute);
+// Attempt to retrieve a composite index on the given label and ordered attributes
+CompositeIndex* GraphContext_GetCompositeIndex(const GraphContext *gc, const char *label, const char **attributes, uint attr_count);
+// Create and populate a composite index of the given type for the given label and ordered attributes
+int GraphContext_AddCompositeIndex(GraphContext *gc, const char *label, const char **attributes, uint attr_count,
+                                   IndexType type);
+// Remove and free a composite index
+int GraphContext_DeleteCompositeIndex(GraphContext *gc, const char *label, const char **attributes, uint attr_count);
+
+// Add a single node to all indices its properties match and to its schema's columns
 void GraphContext_AddNodeToIndices(GraphContext *gc, Schema *s, Node *n);
-// Remove a single node from all indices that refer to it
+// Remove a single node from all indices and columns that refer to it
 void GraphContext_DeleteNodeFromIndices(GraphContext *gc, Node *n);
+// Add a single edge to all indices its properties match, edge endpoints must be set
+void GraphContext_AddEdgeToIndices(GraphContext *gc, Schema *s, Edge *e);
+// Remove a single edge from all indices that refer to it
+void GraphContext_DeleteEdgeFromIndices(GraphContext *gc, Edge *e);
 
 // Free the GraphContext and all associated graph data
 void GraphContext_Free(GraphContext *gc);
@@ -197,6 +197,9 @@ void BuildQueryGraph(const GraphContext *gc, QueryGraph *qg, Vector *entities) {
         AST_GraphEntity *entity;
         Vector_Get(entities, i, &entity);
         if(entity->t != N_LINK) continue;
+        /* Shortest paths aren't traversed, they're computed
+         * once both of their endpoints are resolved. */
+        if(((AST_LinkEntity*)entity)->selector != N_PATH_ALL) continue;
         AST_GraphEntity *l_entity;
         AST_GraphEntity *r_entity;
         Vector_Get(entities, i-1, &l_entity);
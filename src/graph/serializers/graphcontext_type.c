@@ -11,6 +11,7 @@
 #include "serialize_index.h"
 #include "../../util/arr.h"
 #include "../../util/rmalloc.h"
+#include "../../execution_plan/plan_cache.h"
 #include "../../version.h"
 
 /* Thread local storage graph context key. */
@@ -20,9 +21,15 @@ extern pthread_key_t _tlsGCKey;
 RedisModuleType *GraphContextRedisModuleType;
 
 void static _GraphContextType_SerializeIndicies(RedisModuleIO *rdb, GraphContext *gc) {
-  // Currently indicies are only defined on nodes.
   unsigned short schema_count = GraphContext_SchemaCount(gc, SCHEMA_NODE);
 
+  // #Indices.
+  uint32_t count = 0;
+  for (unsigned short i = 0; i < schema_count; i ++) {
+    count += Schema_IndexCount(gc->node_schemas[i]);
+  }
+  RedisModule_SaveUnsigned(rdb, count);
+
   for (unsigned short i = 0; i < schema_count; i ++) {
     Schema *s = gc->node_schemas[i];
     unsigned short index_count = Schema_IndexCount(s);
@@ -32,6 +39,39 @@ void static _GraphContextType_SerializeIndicies(RedisModuleIO *rdb, GraphContext
       RdbSaveIndex(rdb, idx);
     }
   }
+
+  // #Composite indices.
+  count = 0;
+  for (unsigned short i = 0; i < schema_count; i ++) {
+    count += Schema_CompositeIndexCount(gc->node_schemas[i]);
+  }
+  RedisModule_SaveUnsigned(rdb, count);
+
+  for (unsigned short i = 0; i < schema_count; i ++) {
+    Schema *s = gc->node_schemas[i];
+    unsigned short index_count = Schema_CompositeIndexCount(s);
+
+    for(unsigned short j = 0; j < index_count; j++) {
+      RdbSaveCompositeIndex(rdb, s->composite_indices[j]);
+    }
+  }
+
+  // #Edge indices.
+  schema_count = GraphContext_SchemaCount(gc, SCHEMA_EDGE);
+  count = 0;
+  for (unsigned short i = 0; i < schema_count; i ++) {
+    count += Schema_IndexCount(gc->relation_schemas[i]);
+  }
+  RedisModule_SaveUnsigned(rdb, count);
+
+  for (unsigned short i = 0; i < schema_count; i ++) {
+    Schema *s = gc->relation_schemas[i];
+    unsigned short index_count = Schema_IndexCount(s);
+
+    for(unsigned short j = 0; j < index_count; j++) {
+      RdbSaveIndex(rdb, s->indices[j]);
+    }
+  }
 }
 
 void GraphContextType_RdbSave(RedisModuleIO *rdb, void *value) {
@@ -45,7 +85,11 @@ void GraphContextType_RdbSave(RedisModuleIO *rdb, void *value) {
    * relation schema X #relation schemas
    * graph object
    * #indices
-   * (index label, index property) X #indices
+   * (index label, index property, index type) X #indices
+   * #composite indices
+   * (index label, #properties, index property X #properties, index type) X #composite indices
+   * #edge indices
+   * (index relation, index property, index type) X #edge indices
    */
 
   GraphContext *gc = value;
@@ -82,13 +126,11 @@ void GraphContextType_RdbSave(RedisModuleIO *rdb, void *value) {
     RdbSaveSchema(rdb, s);
   }
 
-  // Serialize graph object
+  // Serialize graph object,
+  // node properties stored in columns are resolved through the thread's graph context.
+  pthread_setspecific(_tlsGCKey, gc);
   RdbSaveGraph(rdb, gc);
 
-  // #Indices.
-  uint32_t index_count = gc->index_count;
-  RedisModule_SaveUnsigned(rdb, index_count);
-
   // Serialize each index
   _GraphContextType_SerializeIndicies(rdb, gc);
 
@@ -107,7 +149,11 @@ void *GraphContextType_RdbLoad(RedisModuleIO *rdb, int encver) {
    * relation schema X #relation schemas
    * graph object
    * #indices
-   * (index label, index property) X #indices
+   * (index label, index property, index type (in encver 7)) X #indices
+   * #composite indices (in encver 5)
+   * (index label, #properties, index property X #properties, index type (in encver 8)) X #composite indices
+   * #edge indices (in encver 6)
+   * (index relation, index property, index type (in encver 7)) X #edge indices
    */
 
   if (encver > GRAPHCONTEXT_TYPE_ENCODING_VERSION) {
@@ -134,6 +180,8 @@ void *GraphContextType_RdbLoad(RedisModuleIO *rdb, int encver) {
   // Initialize property mappings
   gc->attributes = NewTrieMap();
   gc->string_mapping = array_new(char*, 64);
+  gc->string_pool = StringPool_New();
+  gc->plan_cache = PlanCache_New();
 
   // Load the full attribute mapping (or the attributes from
   // the unified node schema, if encoding version is < 4)
@@ -164,10 +212,28 @@ void *GraphContextType_RdbLoad(RedisModuleIO *rdb, int encver) {
   RdbLoadGraph(rdb, gc);
 
   // #Indices
-  // (index label, index property) X #indices
+  // (index label, index property, index type) X #indices
   uint32_t index_count = RedisModule_LoadUnsigned(rdb);
   for (uint32_t i = 0; i < index_count; i ++) {
-    RdbLoadIndex(rdb, gc);
+    RdbLoadIndex(rdb, gc, encver);
+  }
+
+  if (encver >= 5) {
+    // #Composite indices
+    // (index label, #properties, index property X #properties, index type) X #composite indices
+    index_count = RedisModule_LoadUnsigned(rdb);
+    for (uint32_t i = 0; i < index_count; i ++) {
+      RdbLoadCompositeIndex(rdb, gc, encver);
+    }
+  }
+
+  if (encver >= 6) {
+    // #Edge indices
+    // (index relation, index property, index type) X #edge indices
+    index_count = RedisModule_LoadUnsigned(rdb);
+    for (uint32_t i = 0; i < index_count; i ++) {
+      RdbLoadEdgeIndex(rdb, gc, encver);
+    }
   }
 
   return gc;
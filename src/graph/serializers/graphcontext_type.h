@@ -11,7 +11,7 @@
 
 extern RedisModuleType *GraphContextRedisModuleType;
 
-#define GRAPHCONTEXT_TYPE_ENCODING_VERSION 4
+#define GRAPHCONTEXT_TYPE_ENCODING_VERSION 8
 
 /* Commands related to the RedisGraph module registration */
 int GraphContextType_Register(RedisModuleCtx *ctx);
@@ -47,7 +47,7 @@ static NodeID _updatedID(uint64_t *array, NodeID id) {
     }
 }
 
-SIValue _RdbLoadSIValue(RedisModuleIO *rdb) {
+SIValue _RdbLoadSIValue(RedisModuleIO *rdb, GraphContext *gc) {
     /* Format:
      * SIType
      * Value */
@@ -58,10 +58,13 @@ SIValue _RdbLoadSIValue(RedisModuleIO *rdb) {
         case T_DOUBLE:
             return SI_DoubleVal(RedisModule_LoadDouble(rdb));
         case T_STRING:
-        case T_CONSTSTRING:
-            // Transfer ownership of the heap-allocated string to the
-            // newly-created SIValue
-            return SI_TransferStringVal(RedisModule_LoadStringBuffer(rdb, NULL));
+        case T_CONSTSTRING: {
+            // Intern loaded string within the graph's string pool.
+            char *s = RedisModule_LoadStringBuffer(rdb, NULL);
+            SIValue v = GraphContext_InternValue(gc, SI_ConstStringVal(s));
+            RedisModule_Free(s);
+            return v;
+        }
         case T_BOOL:
             return SI_BoolVal(RedisModule_LoadSigned(rdb));
         case T_NULL:
@@ -80,7 +83,7 @@ void _RdbLoadEntity(RedisModuleIO *rdb, GraphContext *gc, GraphEntity *e) {
 
     for(int i = 0; i < propCount; i++) {
         char *attr_name = RedisModule_LoadStringBuffer(rdb, NULL);
-        SIValue attr_value = _RdbLoadSIValue(rdb);
+        SIValue attr_value = _RdbLoadSIValue(rdb, gc);
         Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr_name);
         assert(attr_id != ATTRIBUTE_NOTFOUND);
         GraphEntity_AddProperty(e, attr_id, attr_value);
@@ -116,6 +119,12 @@ void _RdbLoadNodes(RedisModuleIO *rdb, GraphContext *gc) {
         Graph_CreateNode(gc->g, l, &n);
 
         _RdbLoadEntity(rdb, gc, (GraphEntity*)&n);
+
+        // Populate label's property columns.
+        if(nodeLabelCount) {
+            Schema *s = GraphContext_GetSchemaByID(gc, l, SCHEMA_NODE);
+            Schema_AddNodeToColumns(s, &n);
+        }
     }
 }
 
@@ -169,15 +178,19 @@ void _RdbSaveSIValue(RedisModuleIO *rdb, const SIValue *v) {
     }
 }
 
-void _RdbSaveEntity(RedisModuleIO *rdb, const Entity *e,  char **attr_map) {
+void _RdbSaveEntity(RedisModuleIO *rdb, const GraphEntity *e,  char **attr_map) {
     /* Format:
      * #attributes N
      * (name, value type, value) X N  */
 
-    RedisModule_SaveUnsigned(rdb, e->prop_count);
+    // Node properties might be stored in their label's columns.
+    int prop_count = GraphEntity_PropertyCount(e);
+    EntityProperty props[prop_count];
+    GraphEntity_GetProperties(e, props);
+    RedisModule_SaveUnsigned(rdb, prop_count);
 
-    for(int i = 0; i < e->prop_count; i++) {
-        EntityProperty attr = e->properties[i];
+    for(int i = 0; i < prop_count; i++) {
+        EntityProperty attr = props[i];
         const char *attr_name = attr_map[attr.id];
         RedisModule_SaveStringBuffer(rdb, attr_name, strlen(attr_name) + 1);
         _RdbSaveSIValue(rdb, &attr.value);
@@ -215,7 +228,8 @@ void _RdbSaveNodes(RedisModuleIO *rdb, const Graph *g,  char **string_mapping) {
         
         // properties N
         // (name, value type, value) X N
-        _RdbSaveEntity(rdb, e, string_mapping);
+        GraphEntity ge = {.entity = e};
+        _RdbSaveEntity(rdb, &ge, string_mapping);
     }
 
     DataBlockIterator_Free(iter);
@@ -253,7 +267,7 @@ void _RdbSaveEdge(RedisModuleIO *rdb, const Graph *g, const Edge *e,
     RedisModule_SaveUnsigned(rdb, r);
     
     // Edge properties.
-    _RdbSaveEntity(rdb, e->entity, string_mapping);
+    _RdbSaveEntity(rdb, (const GraphEntity*)e, string_mapping);
 }
 
 void _RdbSaveEdges(RedisModuleIO *rdb, const Graph *g, char **string_mapping) {
@@ -278,35 +292,39 @@ void _RdbSaveEdges(RedisModuleIO *rdb, const Graph *g, char **string_mapping) {
         NodeID src;
         NodeID dest;
         EdgeID edgeID;
-        GrB_Matrix M = g->_relations_map[r];
-        GxB_MatrixTupleIter *it;
-        GxB_MatrixTupleIter_new(&it, M);
-
-        while(true) {
-            bool depleted = false;
-            GxB_MatrixTupleIter_next(it, &src, &dest, &depleted);
-            e.srcNodeID = src;
-            e.destNodeID = dest;
-
-            if(depleted) break;
-
-            GrB_Matrix_extractElement_UINT64(&edgeID, M, src, dest);
-            if(SINGLE_EDGE(edgeID)) {
-                edgeID = SINGLE_EDGE_ID(edgeID);
-                Graph_GetEdge(g, edgeID, &e);
-                _RdbSaveEdge(rdb, g, &e, r, string_mapping);
-            } else {
-                EdgeID *edgeIDs = (EdgeID*)edgeID;
-                int edgeCount = array_len(edgeIDs);
-                for(int i = 0; i < edgeCount; i++) {
-                    edgeID = edgeIDs[i];
+        // Mappings yet to be folded are held within the relation's delta map.
+        GrB_Matrix M = Graph_GetRelationMap(g, r);
+        GrB_Matrix DP = Graph_GetDeltaMatrix(g, M);
+        for(; M; M = DP, DP = NULL) {
+            GxB_MatrixTupleIter *it;
+            GxB_MatrixTupleIter_new(&it, M);
+
+            while(true) {
+                bool depleted = false;
+                GxB_MatrixTupleIter_next(it, &src, &dest, &depleted);
+                e.srcNodeID = src;
+                e.destNodeID = dest;
+
+                if(depleted) break;
+
+                GrB_Matrix_extractElement_UINT64(&edgeID, M, src, dest);
+                if(SINGLE_EDGE(edgeID)) {
+                    edgeID = SINGLE_EDGE_ID(edgeID);
                     Graph_GetEdge(g, edgeID, &e);
                     _RdbSaveEdge(rdb, g, &e, r, string_mapping);
+                } else {
+                    EdgeID *edgeIDs = (EdgeID*)edgeID;
+                    int edgeCount = array_len(edgeIDs);
+                    for(int i = 0; i < edgeCount; i++) {
+                        edgeID = edgeIDs[i];
+                        Graph_GetEdge(g, edgeID, &e);
+                        _RdbSaveEdge(rdb, g, &e, r, string_mapping);
+                    }
                 }
             }
-        }
 
-        GxB_MatrixTupleIter_free(it);
+            GxB_MatrixTupleIter_free(it);
+        }
     }
 }
 
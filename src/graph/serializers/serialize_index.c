@@ -6,16 +6,58 @@
 
 #include "serialize_index.h"
 
-void RdbLoadIndex(RedisModuleIO *rdb, GraphContext *gc) {
+// Index type is saved as of encoding version 7, earlier indices are range indices.
+static IndexType _RdbLoadIndexType(RedisModuleIO *rdb, int encver) {
+    if(encver < 7) return IDX_SKIPLIST;
+    return (IndexType)RedisModule_LoadUnsigned(rdb);
+}
+
+void RdbLoadIndex(RedisModuleIO *rdb, GraphContext *gc, int encver) {
     char *label = RedisModule_LoadStringBuffer(rdb, NULL);
     char *property = RedisModule_LoadStringBuffer(rdb, NULL);
-    GraphContext_AddIndex(gc, label, property);
+    IndexType type = _RdbLoadIndexType(rdb, encver);
+    GraphContext_AddIndex(gc, label, property, type);
     RedisModule_Free(label);
     RedisModule_Free(property);
 }
 
+void RdbLoadEdgeIndex(RedisModuleIO *rdb, GraphContext *gc, int encver) {
+    char *relation = RedisModule_LoadStringBuffer(rdb, NULL);
+    char *property = RedisModule_LoadStringBuffer(rdb, NULL);
+    IndexType type = _RdbLoadIndexType(rdb, encver);
+    GraphContext_AddEdgeIndex(gc, relation, property, type);
+    RedisModule_Free(relation);
+    RedisModule_Free(property);
+}
+
 void RdbSaveIndex(RedisModuleIO *rdb, void *value) {
     Index *idx = (Index*)value;
     RedisModule_SaveStringBuffer(rdb, idx->label, strlen(idx->label) + 1);
     RedisModule_SaveStringBuffer(rdb, idx->attribute, strlen(idx->attribute) + 1);
+    RedisModule_SaveUnsigned(rdb, idx->type);
+}
+
+void RdbLoadCompositeIndex(RedisModuleIO *rdb, GraphContext *gc, int encver) {
+    char *label = RedisModule_LoadStringBuffer(rdb, NULL);
+    uint attr_count = RedisModule_LoadUnsigned(rdb);
+    char *attributes[attr_count];
+    for(uint i = 0; i < attr_count; i++) {
+        attributes[i] = RedisModule_LoadStringBuffer(rdb, NULL);
+    }
+    // Composite index type is saved as of encoding version 8, earlier indices are skiplists.
+    IndexType type = IDX_SKIPLIST;
+    if(encver >= 8) type = (IndexType)RedisModule_LoadUnsigned(rdb);
+    GraphContext_AddCompositeIndex(gc, label, (const char**)attributes, attr_count, type);
+    RedisModule_Free(label);
+    for(uint i = 0; i < attr_count; i++) RedisModule_Free(attributes[i]);
+}
+
+void RdbSaveCompositeIndex(RedisModuleIO *rdb, void *value) {
+    CompositeIndex *idx = (CompositeIndex*)value;
+    RedisModule_SaveStringBuffer(rdb, idx->label, strlen(idx->label) + 1);
+    RedisModule_SaveUnsigned(rdb, idx->attr_count);
+    for(uint i = 0; i < idx->attr_count; i++) {
+        RedisModule_SaveStringBuffer(rdb, idx->attributes[i], strlen(idx->attributes[i]) + 1);
+    }
+    RedisModule_SaveUnsigned(rdb, idx->type);
 }
@@ -11,7 +11,10 @@
 #include "../../index/index.h"
 #include "../graphcontext.h"
 
-void RdbLoadIndex(RedisModuleIO *rdb, GraphContext *gc);
+void RdbLoadIndex(RedisModuleIO *rdb, GraphContext *gc, int encver);
 void RdbSaveIndex(RedisModuleIO *rdb, void *value);
+void RdbLoadEdgeIndex(RedisModuleIO *rdb, GraphContext *gc, int encver);
+void RdbLoadCompositeIndex(RedisModuleIO *rdb, GraphContext *gc, int encver);
+void RdbSaveCompositeIndex(RedisModuleIO *rdb, void *value);
 
 #endif
@@ -62,7 +62,7 @@ Schema* RdbLoadSchema(RedisModuleIO *rdb, SchemaType type) {
 
   int id = RedisModule_LoadUnsigned(rdb);
   char *name = RedisModule_LoadStringBuffer(rdb, NULL);
-  Schema *s = Schema_New(name, id);
+  Schema *s = Schema_New(name, id, type);
 
   uint64_t attrCount = RedisModule_LoadUnsigned(rdb);
 
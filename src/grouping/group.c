@@ -9,29 +9,58 @@
 #include "../redismodule.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../graph/entities/graph_entity.h"
 
-// Creates a new group
-// arguments specify group's key.
-Group* NewGroup(int key_count, SIValue* keys, AR_ExpNode** funcs, Record r) {
-    Group* g = rm_malloc(sizeof(Group));
+void InitGroup(Group *g, int key_count, SIValue* keys, AR_ExpNode** funcs, Record r) {
     g->keys = keys;
     g->key_count = key_count;
     g->aggregationFunctions = funcs;
     if(r) g->r = Record_Clone(r);
     else g->r = NULL;
-    return g;
 }
 
-void Group_KeyStr(const Group *g, char **group_key) {
-    if(g->key_count == 0) {
-        *group_key = rm_strdup("SINGLE_GROUP");
-        return;
+uint64_t Group_HashKeys(const SIValue *keys, int key_count) {
+    uint64_t hash = 0;
+    for(int i = 0; i < key_count; i++) {
+        // NULLs might not share a payload.
+        uint64_t h = (keys[i].type == T_NULL) ? T_NULL : SIValue_HashCode(keys[i]);
+        hash = (hash ^ h) * 0x100000001b3ULL + (hash >> 29);
+    }
+    return hash;
+}
+
+static bool _Group_KeyEqual(SIValue a, SIValue b) {
+    if(a.type == b.type) {
+        switch(a.type) {
+            case T_NULL:
+                return true;
+            case T_INT64:
+            case T_BOOL:
+                return a.longval == b.longval;
+            case T_DOUBLE:
+                return a.doubleval == b.doubleval;
+            case T_STRING:
+                return a.stringval == b.stringval || strcmp(a.stringval, b.stringval) == 0;
+            case T_NODE:
+            case T_EDGE:
+                return ENTITY_GET_ID((GraphEntity*)a.ptrval) == ENTITY_GET_ID((GraphEntity*)b.ptrval);
+            default:
+                return a.ptrval == b.ptrval;
+        }
     }
 
-    // Determine required size for group key string representation.
-    size_t group_len_key = SIValue_StringConcatLen(g->keys, g->key_count);
-    *group_key = rm_malloc(sizeof(char) * group_len_key);
-    SIValue_StringConcat(g->keys, g->key_count, *group_key, group_len_key);
+    // Numerics of different types, e.g. 1 and 1.0.
+    if(SI_TYPE(a) & SI_NUMERIC && SI_TYPE(b) & SI_NUMERIC) {
+        return SI_GET_NUMERIC(a) == SI_GET_NUMERIC(b);
+    }
+    return false;
+}
+
+bool Group_KeysEqual(const SIValue *a, const SIValue *b, int key_count) {
+    for(int i = 0; i < key_count; i++) {
+        if(!_Group_KeyEqual(a[i], b[i])) return false;
+    }
+    return true;
 }
 
 void FreeGroup(Group* g) {
@@ -50,5 +79,4 @@ void FreeGroup(Group* g) {
         }
         array_free(g->aggregationFunctions);
     }
-    rm_free(g);
 }
@@ -17,13 +17,17 @@ typedef struct {
     Record r;   /* Representative record for all aggregated records in group. */
 } Group;
 
-/* Creates a new group */
-Group* NewGroup(int key_count, SIValue* keys, AR_ExpNode** funcs, Record r);
+/* Initialize group g, group takes ownership over keys and funcs. */
+void InitGroup(Group *g, int key_count, SIValue* keys, AR_ExpNode** funcs, Record r);
 
-/* Compute group key string representation, it is the callers 
- * responsibility to free returned string. */
-void Group_KeyStr(const Group *g, char **group_key);
+/* Hash group keys, keys which are equal share the same hash code. */
+uint64_t Group_HashKeys(const SIValue *keys, int key_count);
 
+/* Returns true if both key sets are equal, unlike SIValue_Compare
+ * NULLs are considered equal to one another. */
+bool Group_KeysEqual(const SIValue *a, const SIValue *b, int key_count);
+
+/* Free group's content. */
 void FreeGroup(Group* group);
 
 #endif
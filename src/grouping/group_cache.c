@@ -5,42 +5,103 @@
 */
 
 #include "group_cache.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#define GROUP_CACHE_INITIAL_SLOTS 64
+#define GROUP_CACHE_MAX_LOAD 0.7
+
+static CacheGroupSlot* _CacheGroup_NewSlots(uint64_t slot_count) {
+    CacheGroupSlot *slots = rm_malloc(sizeof(CacheGroupSlot) * slot_count);
+    for(uint64_t i = 0; i < slot_count; i++) slots[i].group = -1;
+    return slots;
+}
 
 CacheGroup* CacheGroupNew() {
-    return NewTrieMap();
+    CacheGroup *groups = rm_malloc(sizeof(CacheGroup));
+    groups->groups = array_new(Group, 1);
+    groups->slot_count = GROUP_CACHE_INITIAL_SLOTS;
+    groups->slots = _CacheGroup_NewSlots(groups->slot_count);
+    return groups;
 }
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group) {
-    TrieMap_Add(groups, key, strlen(key), group, NULL);
+// Locates the slot of keys, or the empty slot they should occupy.
+static CacheGroupSlot* _CacheGroup_Locate(CacheGroup *groups, uint64_t hash,
+                                          const SIValue *keys, int key_count) {
+    uint64_t mask = groups->slot_count - 1;
+    for(uint64_t i = hash & mask;; i = (i + 1) & mask) {
+        CacheGroupSlot *slot = groups->slots + i;
+        if(slot->group == -1) return slot;
+        if(slot->hash == hash &&
+           Group_KeysEqual(groups->groups[slot->group].keys, keys, key_count)) return slot;
+    }
+}
+
+static void _CacheGroup_Grow(CacheGroup *groups) {
+    CacheGroupSlot *old_slots = groups->slots;
+    uint64_t old_slot_count = groups->slot_count;
+
+    groups->slot_count *= 2;
+    groups->slots = _CacheGroup_NewSlots(groups->slot_count);
+
+    // Slots hold distinct keys, reinsert by probing for a free slot.
+    uint64_t mask = groups->slot_count - 1;
+    for(uint64_t i = 0; i < old_slot_count; i++) {
+        if(old_slots[i].group == -1) continue;
+        uint64_t j = old_slots[i].hash & mask;
+        while(groups->slots[j].group != -1) j = (j + 1) & mask;
+        groups->slots[j] = old_slots[i];
+    }
+    rm_free(old_slots);
+}
+
+Group* CacheGroupAdd(CacheGroup *groups, uint64_t hash, int key_count, SIValue *keys,
+                     AR_ExpNode **funcs, Record r) {
+    int64_t idx = array_len(groups->groups);
+    Group g;
+    InitGroup(&g, key_count, keys, funcs, r);
+    groups->groups = array_append(groups->groups, g);
+
+    CacheGroupSlot *slot = _CacheGroup_Locate(groups, hash, keys, key_count);
+    slot->hash = hash;
+    slot->group = idx;
+    if(array_len(groups->groups) > groups->slot_count * GROUP_CACHE_MAX_LOAD) _CacheGroup_Grow(groups);
+
+    return groups->groups + idx;
 }
 
-// Retrives a group,
-// Sets group to NULL if key is missing.
-Group* CacheGroupGet(CacheGroup *groups, char *key) {
-    Group *g = TrieMap_Find(groups, key, strlen(key));
-    if (g == TRIEMAP_NOTFOUND) return NULL;
-    return g;
+Group* CacheGroupGet(CacheGroup *groups, uint64_t hash, const SIValue *keys, int key_count) {
+    CacheGroupSlot *slot = _CacheGroup_Locate(groups, hash, keys, key_count);
+    if(slot->group == -1) return NULL;
+    return groups->groups + slot->group;
 }
 
 void FreeGroupCache(CacheGroup *groups) {
-    TrieMap_Free(groups, (void (*)(void *))FreeGroup);
+    uint64_t group_count = array_len(groups->groups);
+    for(uint64_t i = 0; i < group_count; i++) FreeGroup(groups->groups + i);
+    array_free(groups->groups);
+    rm_free(groups->slots);
+    rm_free(groups);
 }
 
-// Returns an iterator to scan entire group cache
+// Returns an iterator to scan groups by order of creation
 CacheGroupIterator* CacheGroupIter(CacheGroup *groups) {
-    return TrieMap_Iterate(groups, "", 0);
+    CacheGroupIterator *iter = rm_malloc(sizeof(CacheGroupIterator));
+    iter->groups = groups;
+    iter->idx = 0;
+    return iter;
 }
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group) {
-    tm_len_t len = 0;
-    int res = TrieMapIterator_Next(iter, key, &len, (void**)group);
-    if(res == 0) {
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group) {
+    if(iter->idx == array_len(iter->groups->groups)) {
         *group = NULL;
+        return 0;
     }
-    return res;
+    *group = iter->groups->groups + iter->idx++;
+    return 1;
 }
 
 void CacheGroupIterator_Free(CacheGroupIterator* iter) {
-    if(iter) TrieMapIterator_Free(iter);
+    if(iter) rm_free(iter);
 }
@@ -8,27 +8,45 @@
 #define GROUP_CACHE_H_
 
 #include "group.h"
-#include "../util/triemap/triemap.h"
 
-typedef TrieMapIterator CacheGroupIterator;
-typedef TrieMap CacheGroup;
+/* Group cache is an open addressing hash table mapping group keys
+ * to groups, groups are stored contiguously in order of creation. */
+
+typedef struct {
+    uint64_t hash;      /* Hash of group keys. */
+    int64_t group;      /* Index into groups, -1 for an empty slot. */
+} CacheGroupSlot;
+
+typedef struct {
+    Group *groups;          /* Array of groups. */
+    CacheGroupSlot *slots;  /* Hash table over groups. */
+    uint64_t slot_count;    /* Number of slots, a power of 2. */
+} CacheGroup;
+
+typedef struct {
+    CacheGroup *groups;
+    uint64_t idx;           /* Next group to return. */
+} CacheGroupIterator;
 
 CacheGroup* CacheGroupNew();
 
-void CacheGroupAdd(CacheGroup *groups, char *key, Group *group);
+/* Adds a group under keys whose hash is hash, group takes ownership over
+ * keys and funcs. Returned group is valid up until next addition. */
+Group* CacheGroupAdd(CacheGroup *groups, uint64_t hash, int key_count, SIValue *keys,
+                     AR_ExpNode **funcs, Record r);
 
 // Retrives a group,
-// Sets group to NULL if key is missing.
-Group* CacheGroupGet(CacheGroup *groups, char *key);
+// Returns NULL if keys are missing.
+Group* CacheGroupGet(CacheGroup *groups, uint64_t hash, const SIValue *keys, int key_count);
 
 void FreeGroupCache(CacheGroup *groups);
 
-// Returns an iterator to scan hashtable
+// Returns an iterator to scan groups by order of creation
 CacheGroupIterator* CacheGroupIter(CacheGroup *groups);
 
-// Advance iterator and returns key & value in current position.
-int CacheGroupIterNext(CacheGroupIterator *iter, char **key, Group **group);
+// Advance iterator and returns group in current position.
+int CacheGroupIterNext(CacheGroupIterator *iter, Group **group);
 
 void CacheGroupIterator_Free(CacheGroupIterator* iter);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,192 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+/* Compares the B+trees backing indices with the skiplists backing indices created USING SKIPLIST,
+ * reporting insert, point lookup and range scan throughput and memory consumption
+ * for numeric keys, generated string keys sharing long prefixes and random UUIDs.
+ * Usage: ./benchmark [entity count] */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <malloc.h>
+#include <time.h>
+#include "../../util/rmalloc.h"
+#include "../../util/skiplist.h"
+#include "../bptree.h"
+
+#define DEFAULT_ENTITY_COUNT 1000000
+#define RANGE_SCAN_LENGTH 100
+
+// Skiplist routines of range indices, see index.c.
+int compareNodes(NodeID a, NodeID b);
+int compareStrings(SIValue *a, SIValue *b);
+int compareNumerics(SIValue *a, SIValue *b);
+SIValue* cloneKey(SIValue *property);
+void freeKey(SIValue *key);
+
+typedef struct {
+  const char *name;
+  bool strings;
+  SIValue *keys;      // Indexed value of entity i.
+  uint64_t *probes;   // Entities whose values are looked up, or scanned from.
+  uint64_t n;
+} Workload;
+
+typedef struct {
+  double insert;      // Operations per second.
+  double lookup;
+  double range;
+  size_t memory;      // Bytes.
+  uint64_t checksum;  // Sum of produced IDs, identical for both structures.
+} Result;
+
+static double _now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static size_t _heapUsage(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+static uint64_t _rand64(void) {
+  return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+// Values are drawn from a range 4 times the entity count, some are shared.
+static Workload _workload(const char *name, int kind, uint64_t n) {
+  Workload w = {name, kind != 0, rm_malloc(sizeof(SIValue) * n), rm_malloc(sizeof(uint64_t) * n), n};
+  char buf[64];
+  for (uint64_t i = 0; i < n; i++) {
+    uint64_t r = _rand64();
+    switch (kind) {
+      case 0:
+        w.keys[i] = SI_LongVal(r % (4 * n));
+        break;
+      case 1:
+        snprintf(buf, 64, "user:%012llu", (unsigned long long)(r % (4 * n)));
+        w.keys[i] = SI_DuplicateStringVal(buf);
+        break;
+      default:
+        snprintf(buf, 64, "%08llx-%04llx-4%03llx-%04llx-%012llx",
+                 (unsigned long long)(r & 0xffffffff), (unsigned long long)((r >> 32) & 0xffff),
+                 (unsigned long long)((r >> 48) & 0xfff), (unsigned long long)(_rand64() & 0xffff),
+                 (unsigned long long)(_rand64() & 0xffffffffffff));
+        w.keys[i] = SI_DuplicateStringVal(buf);
+    }
+  }
+  for (uint64_t i = 0; i < n; i++) w.probes[i] = _rand64() % n;
+  return w;
+}
+
+static void _freeWorkload(Workload *w) {
+  for (uint64_t i = 0; i < w->n; i++) SIValue_Free(w->keys + i);
+  rm_free(w->keys);
+  rm_free(w->probes);
+}
+
+static Result _benchmarkSkiplist(const Workload *w) {
+  Result r = {0};
+  size_t baseline = _heapUsage();
+
+  double start = _now();
+  skiplist *sl = w->strings ? skiplistCreate(compareStrings, compareNodes, cloneKey, freeKey) :
+                 skiplistCreate(compareNumerics, compareNodes, cloneKey, freeKey);
+  for (uint64_t i = 0; i < w->n; i++) skiplistInsert(sl, w->keys + i, i);
+  r.insert = w->n / (_now() - start);
+  r.memory = _heapUsage() - baseline;
+
+  start = _now();
+  for (uint64_t i = 0; i < w->n; i++) {
+    skiplistNode *node = skiplistFind(sl, w->keys + w->probes[i]);
+    for (unsigned int j = 0; j < node->numVals; j++) r.checksum += node->vals[j];
+  }
+  r.lookup = w->n / (_now() - start);
+
+  uint64_t scans = w->n / RANGE_SCAN_LENGTH;
+  start = _now();
+  for (uint64_t i = 0; i < scans; i++) {
+    skiplistIterator *iter = skiplistIterateAll(sl);
+    skiplistIter_UpdateBound(iter, w->keys + w->probes[i], GE);
+    skiplistVal *id;
+    for (int j = 0; j < RANGE_SCAN_LENGTH && (id = skiplistIterator_Next(iter)); j++) r.checksum += *id;
+    skiplistIterate_Free(iter);
+  }
+  r.range = scans / (_now() - start);
+
+  skiplistFree(sl);
+  return r;
+}
+
+static Result _benchmarkBPTree(const Workload *w) {
+  Result r = {0};
+  size_t baseline = _heapUsage();
+
+  double start = _now();
+  BPTree *tree = BPTree_New(w->strings);
+  for (uint64_t i = 0; i < w->n; i++) BPTree_Insert(tree, w->keys + i, i);
+  r.insert = w->n / (_now() - start);
+  r.memory = _heapUsage() - baseline;
+
+  start = _now();
+  for (uint64_t i = 0; i < w->n; i++) {
+    uint64_t count;
+    const NodeID *ids = BPTree_Lookup(tree, w->keys + w->probes[i], &count);
+    for (uint64_t j = 0; j < count; j++) r.checksum += ids[j];
+  }
+  r.lookup = w->n / (_now() - start);
+
+  uint64_t scans = w->n / RANGE_SCAN_LENGTH;
+  start = _now();
+  for (uint64_t i = 0; i < scans; i++) {
+    BPTreeIterator *iter = BPTree_IterateAll(tree);
+    BPTreeIterator_UpdateBound(iter, w->keys + w->probes[i], GE);
+    NodeID *id;
+    for (int j = 0; j < RANGE_SCAN_LENGTH && (id = BPTreeIterator_Next(iter)); j++) r.checksum += *id;
+    BPTreeIterator_Free(iter);
+  }
+  r.range = scans / (_now() - start);
+
+  BPTree_Free(tree);
+  return r;
+}
+
+static void _report(const char *workload, const char *structure, const Result *r) {
+  printf("%-10s %-9s %14.0f %14.0f %14.0f %12.1f\n", workload, structure, r->insert,
+         r->lookup, r->range, r->memory / (1024.0 * 1024.0));
+}
+
+int main(int argc, char **argv) {
+  Alloc_Reset();
+  srand(1);
+  uint64_t n = (argc > 1) ? strtoull(argv[1], NULL, 10) : DEFAULT_ENTITY_COUNT;
+  if (n < RANGE_SCAN_LENGTH) n = RANGE_SCAN_LENGTH;
+
+  printf("%llu entities, range scans produce %d entities\n", (unsigned long long)n, RANGE_SCAN_LENGTH);
+  printf("%-10s %-9s %14s %14s %14s %12s\n", "workload", "structure", "inserts/s",
+         "lookups/s", "scans/s", "memory (MB)");
+
+  const char *names[3] = {"numeric", "prefixed", "uuid"};
+  for (int kind = 0; kind < 3; kind++) {
+    Workload w = _workload(names[kind], kind, n);
+    Result sl = _benchmarkSkiplist(&w);
+    Result bt = _benchmarkBPTree(&w);
+    _report(w.name, "skiplist", &sl);
+    _report(w.name, "bptree", &bt);
+    if (sl.checksum != bt.checksum) {
+      fprintf(stderr, "%s: skiplist and B+tree produced different entities\n", w.name);
+      return 1;
+    }
+    _freeWorkload(&w);
+  }
+  return 0;
+}
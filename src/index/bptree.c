@@ -0,0 +1,774 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "bptree.h"
+#include <assert.h>
+#include <string.h>
+#include "../util/rmalloc.h"
+
+// A leaf's integer keys are flagged by a 64 bit mask, leaves can't grow any wider.
+#define BPTREE_LEAF_CAPACITY 64
+#define BPTREE_INNER_CAPACITY 64
+#define BPTREE_HEAP_MIN_CAP 64
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+typedef struct BPTreeNode {
+  bool leaf;
+  uint16_t count;   // Keys held by a leaf, separators held by an inner node.
+} BPTreeNode;
+
+typedef union {
+  int64_t i;
+  double d;
+} BPTreeNumeric;
+
+typedef struct BPTreeLeaf {
+  BPTreeNode node;
+  struct BPTreeLeaf *prev;
+  struct BPTreeLeaf *next;
+  union {
+    struct {
+      uint64_t int_mask;                        // Bit i is set if key i is an integer.
+      BPTreeNumeric keys[BPTREE_LEAF_CAPACITY];
+    } numeric;
+    struct {
+      char *heap;                               // Prefix shared by all keys, followed by key suffixes.
+      uint32_t heap_used;
+      uint32_t heap_cap;
+      uint32_t garbage;                         // Bytes held by suffixes of removed keys.
+      uint32_t prefix_len;
+      uint32_t offsets[BPTREE_LEAF_CAPACITY];   // Suffix offsets within heap.
+      uint32_t lens[BPTREE_LEAF_CAPACITY];      // Suffix lengths.
+    } string;
+  };
+  PostingList postings[BPTREE_LEAF_CAPACITY];
+} BPTreeLeaf;
+
+/* Keys of children[i] are smaller than separator i, and no smaller than separator i - 1.
+ * Separators are copies of keys, and might outlive them. */
+typedef struct {
+  BPTreeNode node;
+  SIValue keys[BPTREE_INNER_CAPACITY];
+  BPTreeNode *children[BPTREE_INNER_CAPACITY + 1];
+} BPTreeInner;
+
+//------------------------------------------------------------------------------
+// Key comparison
+//------------------------------------------------------------------------------
+
+/* Integers are compared exactly, as their difference might overflow,
+ * integers and doubles are compared as doubles. */
+static inline int _compareNumerics(const SIValue *a, const SIValue *b) {
+  if (a->type & b->type & T_INT64) return (a->longval > b->longval) - (a->longval < b->longval);
+  double x = SI_GET_NUMERIC(*a);
+  double y = SI_GET_NUMERIC(*b);
+  return (x > y) - (x < y);
+}
+
+// Compares probe a against key b, a probe of a prefix matching tree matches the keys it is a prefix of.
+static inline int _compareKeys(const BPTree *tree, const SIValue *a, const SIValue *b) {
+  if (tree->prefixes) return strncmp(a->stringval, b->stringval, strlen(a->stringval));
+  if (tree->strings) return strcmp(a->stringval, b->stringval);
+  return _compareNumerics(a, b);
+}
+
+static inline SIValue _leafNumericKey(const BPTreeLeaf *leaf, int i) {
+  if (leaf->numeric.int_mask & (1ULL << i)) return SI_LongVal(leaf->numeric.keys[i].i);
+  return SI_DoubleVal(leaf->numeric.keys[i].d);
+}
+
+static inline const char* _leafSuffix(const BPTreeLeaf *leaf, int i) {
+  return leaf->string.heap + leaf->string.offsets[i];
+}
+
+static inline uint32_t _leafKeyLength(const BPTreeLeaf *leaf, int i) {
+  return leaf->string.prefix_len + leaf->string.lens[i];
+}
+
+// Returns true if s ends within the first n bytes and matches them up to its end.
+static inline bool _isPrefix(const char *s, const char *bytes, uint32_t n) {
+  size_t len = strnlen(s, n);
+  return (len < n && memcmp(s, bytes, len) == 0);
+}
+
+// Compares key against leaf's i'th key.
+static int _compareLeafKey(const BPTree *tree, const BPTreeLeaf *leaf, int i, const SIValue *key) {
+  if (!tree->strings) {
+    SIValue k = _leafNumericKey(leaf, i);
+    return _compareNumerics(key, &k);
+  }
+
+  const char *s = key->stringval;
+  const char *bytes = leaf->string.heap;
+  uint32_t n = leaf->string.prefix_len;
+  int c = strncmp(s, bytes, n);
+  if (c == 0) {
+    // s holds the prefix, compare its remainder against the key's suffix.
+    s += n;
+    bytes = _leafSuffix(leaf, i);
+    n = leaf->string.lens[i];
+    c = strncmp(s, bytes, n);
+    if (c == 0) return (s[n] != '\0');
+  }
+  if (c < 0 && tree->prefixes && _isPrefix(s, bytes, n)) return 0;
+  return c;
+}
+
+// Position of the first key in leaf which is not less than key, found is set if it equals key.
+static int _leafLowerBound(const BPTree *tree, const BPTreeLeaf *leaf, const SIValue *key, bool *found) {
+  int lo = 0;
+  int hi = leaf->node.count;
+  int c = 1;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    int mid_c = _compareLeafKey(tree, leaf, mid, key);
+    if (mid_c > 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+      c = mid_c;
+    }
+  }
+  *found = (lo < leaf->node.count && c == 0);
+  return lo;
+}
+
+/* Position of the first key in leaf which is greater than key if after is set,
+ * which is not less than key otherwise. */
+static int _leafSearch(const BPTree *tree, const BPTreeLeaf *leaf, const SIValue *key, bool after) {
+  int lo = 0;
+  int hi = leaf->node.count;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    int c = _compareLeafKey(tree, leaf, mid, key);
+    if (c > 0 || (after && c == 0)) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/* Number of separators not greater than key if after is set, less than key otherwise.
+ * The former is the position of the child whose subtree covers key. */
+static int _innerSearch(const BPTree *tree, const BPTreeInner *inner, const SIValue *key, bool after) {
+  int lo = 0;
+  int hi = inner->node.count;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    int c = _compareKeys(tree, key, inner->keys + mid);
+    if (c > 0 || (after && c == 0)) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+static BPTreeLeaf* _findLeaf(const BPTree *tree, const SIValue *key) {
+  BPTreeNode *node = tree->root;
+  while (!node->leaf) {
+    BPTreeInner *inner = (BPTreeInner*)node;
+    node = inner->children[_innerSearch(tree, inner, key, true)];
+  }
+  return (BPTreeLeaf*)node;
+}
+
+//------------------------------------------------------------------------------
+// String leaves
+//------------------------------------------------------------------------------
+
+static void _heapReserve(BPTreeLeaf *leaf, uint32_t len) {
+  uint32_t required = leaf->string.heap_used + len;
+  if (leaf->string.heap && required <= leaf->string.heap_cap) return;
+  uint32_t cap = leaf->string.heap_cap ? leaf->string.heap_cap : BPTREE_HEAP_MIN_CAP;
+  while (cap < required) cap *= 2;
+  leaf->string.heap = rm_realloc(leaf->string.heap, cap);
+  leaf->string.heap_cap = cap;
+}
+
+// Copies bytes [from, to) of leaf's i'th key to dst.
+static void _copyKey(const BPTreeLeaf *leaf, int i, uint32_t from, uint32_t to, char *dst) {
+  uint32_t prefix_len = leaf->string.prefix_len;
+  if (from < prefix_len) {
+    uint32_t n = MIN(to, prefix_len) - from;
+    memcpy(dst, leaf->string.heap + from, n);
+    dst += n;
+    from += n;
+  }
+  if (from < to) memcpy(dst, _leafSuffix(leaf, i) + from - prefix_len, to - from);
+}
+
+// Length of the prefix shared by leaf's keys a and b.
+static uint32_t _commonPrefix(const BPTreeLeaf *leaf, int a, int b) {
+  const char *x = _leafSuffix(leaf, a);
+  const char *y = _leafSuffix(leaf, b);
+  uint32_t n = MIN(leaf->string.lens[a], leaf->string.lens[b]);
+  uint32_t i = 0;
+  while (i < n && x[i] == y[i]) i++;
+  return leaf->string.prefix_len + i;
+}
+
+/* Rewrites src's keys [from, from + count) into a new heap for dst, sharing a prefix
+ * of prefix_len bytes which all of these keys hold. src and dst may be the same leaf,
+ * in which case from must be 0. Removed keys' suffixes are dropped along the way. */
+static void _packStrings(BPTreeLeaf *dst, BPTreeLeaf *src, int from, int count, uint32_t prefix_len) {
+  assert(dst != src || from == 0);
+  uint32_t size = prefix_len;
+  for (int i = 0; i < count; i++) size += _leafKeyLength(src, from + i) - prefix_len;
+  uint32_t cap = BPTREE_HEAP_MIN_CAP;
+  while (cap < size) cap *= 2;
+  char *heap = rm_malloc(cap);
+
+  // The prefix is taken from the first key.
+  uint32_t used = 0;
+  if (count > 0) {
+    _copyKey(src, from, 0, prefix_len, heap);
+    used = prefix_len;
+  }
+  for (int i = 0; i < count; i++) {
+    uint32_t len = _leafKeyLength(src, from + i) - prefix_len;
+    _copyKey(src, from + i, prefix_len, prefix_len + len, heap + used);
+    dst->string.offsets[i] = used;
+    dst->string.lens[i] = len;
+    used += len;
+  }
+
+  if (dst->string.heap) rm_free(dst->string.heap);
+  dst->string.heap = heap;
+  dst->string.heap_used = used;
+  dst->string.heap_cap = cap;
+  dst->string.garbage = 0;
+  dst->string.prefix_len = prefix_len;
+}
+
+// Stores s as leaf's key at position pos, shrinking the shared prefix if s doesn't hold it.
+static void _leafInsertString(BPTreeLeaf *leaf, int pos, const char *s) {
+  uint32_t len = strlen(s);
+  int count = leaf->node.count;
+
+  if (count == 0) {
+    // A lone key is entirely prefix.
+    leaf->string.heap_used = 0;
+    leaf->string.garbage = 0;
+    leaf->string.prefix_len = 0;
+    _heapReserve(leaf, len);
+    memcpy(leaf->string.heap, s, len);
+    leaf->string.heap_used = len;
+    leaf->string.prefix_len = len;
+  } else {
+    uint32_t common = 0;
+    while (common < leaf->string.prefix_len && s[common] == leaf->string.heap[common]) common++;
+    if (common < leaf->string.prefix_len) _packStrings(leaf, leaf, 0, count, common);
+  }
+
+  uint32_t suffix_len = len - leaf->string.prefix_len;
+  _heapReserve(leaf, suffix_len);
+  memcpy(leaf->string.heap + leaf->string.heap_used, s + leaf->string.prefix_len, suffix_len);
+  memmove(leaf->string.offsets + pos + 1, leaf->string.offsets + pos, sizeof(uint32_t) * (count - pos));
+  memmove(leaf->string.lens + pos + 1, leaf->string.lens + pos, sizeof(uint32_t) * (count - pos));
+  leaf->string.offsets[pos] = leaf->string.heap_used;
+  leaf->string.lens[pos] = suffix_len;
+  leaf->string.heap_used += suffix_len;
+}
+
+static void _leafRemoveString(BPTreeLeaf *leaf, int pos) {
+  int count = leaf->node.count;
+  leaf->string.garbage += leaf->string.lens[pos];
+  memmove(leaf->string.offsets + pos, leaf->string.offsets + pos + 1, sizeof(uint32_t) * (count - pos - 1));
+  memmove(leaf->string.lens + pos, leaf->string.lens + pos + 1, sizeof(uint32_t) * (count - pos - 1));
+  // Compact once most of the heap is held by removed keys.
+  if (count > 1 && leaf->string.garbage > leaf->string.heap_used / 2) {
+    _packStrings(leaf, leaf, 0, count - 1, leaf->string.prefix_len);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Leaves
+//------------------------------------------------------------------------------
+
+static BPTreeLeaf* _newLeaf(void) {
+  BPTreeLeaf *leaf = rm_calloc(1, sizeof(BPTreeLeaf));
+  leaf->node.leaf = true;
+  return leaf;
+}
+
+static void _freeLeaf(const BPTree *tree, BPTreeLeaf *leaf) {
+  for (int i = 0; i < leaf->node.count; i++) PostingList_Free(leaf->postings + i);
+  if (tree->strings && leaf->string.heap) rm_free(leaf->string.heap);
+  rm_free(leaf);
+}
+
+// Materializes leaf's i'th key, strings are allocated.
+static SIValue _leafKey(const BPTree *tree, const BPTreeLeaf *leaf, int i) {
+  if (!tree->strings) return _leafNumericKey(leaf, i);
+  uint32_t len = _leafKeyLength(leaf, i);
+  char *s = rm_malloc(len + 1);
+  _copyKey(leaf, i, 0, len, s);
+  s[len] = '\0';
+  return SI_TransferStringVal(s);
+}
+
+// Stores key at position pos of a leaf which isn't full, listing id as its only entity.
+static void _leafInsert(const BPTree *tree, BPTreeLeaf *leaf, int pos, const SIValue *key, NodeID id) {
+  int count = leaf->node.count;
+  assert(count < BPTREE_LEAF_CAPACITY);
+
+  if (tree->strings) {
+    _leafInsertString(leaf, pos, key->stringval);
+  } else {
+    memmove(leaf->numeric.keys + pos + 1, leaf->numeric.keys + pos, sizeof(BPTreeNumeric) * (count - pos));
+    uint64_t mask = leaf->numeric.int_mask;
+    uint64_t low = mask & ((1ULL << pos) - 1);
+    uint64_t high = (pos + 1 < 64) ? ((mask >> pos) << (pos + 1)) : 0;
+    if (key->type == T_INT64) {
+      leaf->numeric.keys[pos].i = key->longval;
+      low |= (1ULL << pos);
+    } else {
+      leaf->numeric.keys[pos].d = key->doubleval;
+    }
+    leaf->numeric.int_mask = low | high;
+  }
+
+  memmove(leaf->postings + pos + 1, leaf->postings + pos, sizeof(PostingList) * (count - pos));
+  leaf->postings[pos].count = 0;
+  PostingList_Add(leaf->postings + pos, id);
+  leaf->node.count++;
+}
+
+// Drops leaf's key at position pos, its posting list must be empty.
+static void _leafRemove(const BPTree *tree, BPTreeLeaf *leaf, int pos) {
+  int count = leaf->node.count;
+
+  if (tree->strings) {
+    _leafRemoveString(leaf, pos);
+  } else {
+    memmove(leaf->numeric.keys + pos, leaf->numeric.keys + pos + 1, sizeof(BPTreeNumeric) * (count - pos - 1));
+    uint64_t mask = leaf->numeric.int_mask;
+    uint64_t low = mask & ((1ULL << pos) - 1);
+    uint64_t high = (pos + 1 < 64) ? ((mask >> (pos + 1)) << pos) : 0;
+    leaf->numeric.int_mask = low | high;
+  }
+
+  memmove(leaf->postings + pos, leaf->postings + pos + 1, sizeof(PostingList) * (count - pos - 1));
+  leaf->node.count--;
+}
+
+// Moves the upper half of a full leaf to a new right sibling.
+static BPTreeLeaf* _splitLeaf(const BPTree *tree, BPTreeLeaf *leaf) {
+  BPTreeLeaf *right = _newLeaf();
+  int count = leaf->node.count;
+  int mid = count / 2;
+  int moved = count - mid;
+
+  if (tree->strings) {
+    // Keys are sorted, the prefix shared by a range of keys is that of its first and last keys.
+    _packStrings(right, leaf, mid, moved, _commonPrefix(leaf, mid, count - 1));
+    _packStrings(leaf, leaf, 0, mid, _commonPrefix(leaf, 0, mid - 1));
+  } else {
+    memcpy(right->numeric.keys, leaf->numeric.keys + mid, sizeof(BPTreeNumeric) * moved);
+    right->numeric.int_mask = leaf->numeric.int_mask >> mid;
+    leaf->numeric.int_mask &= (1ULL << mid) - 1;
+  }
+
+  memcpy(right->postings, leaf->postings + mid, sizeof(PostingList) * moved);
+  right->node.count = moved;
+  leaf->node.count = mid;
+
+  right->prev = leaf;
+  right->next = leaf->next;
+  if (leaf->next) leaf->next->prev = right;
+  leaf->next = right;
+  return right;
+}
+
+//------------------------------------------------------------------------------
+// Inner nodes
+//------------------------------------------------------------------------------
+
+static BPTreeInner* _newInner(void) {
+  BPTreeInner *inner = rm_malloc(sizeof(BPTreeInner));
+  inner->node.leaf = false;
+  inner->node.count = 0;
+  return inner;
+}
+
+// Places separator at position pos of an inner node which isn't full, followed by child.
+static void _innerInsert(BPTreeInner *inner, int pos, SIValue separator, BPTreeNode *child) {
+  int count = inner->node.count;
+  memmove(inner->keys + pos + 1, inner->keys + pos, sizeof(SIValue) * (count - pos));
+  memmove(inner->children + pos + 2, inner->children + pos + 1, sizeof(BPTreeNode*) * (count - pos));
+  inner->keys[pos] = separator;
+  inner->children[pos + 1] = child;
+  inner->node.count++;
+}
+
+/* Places separator at position pos of a full inner node, followed by child,
+ * and moves the upper half of the node to a new right sibling.
+ * The median separator moves up, it is returned through up. */
+static BPTreeInner* _splitInner(BPTreeInner *inner, int pos, SIValue separator, BPTreeNode *child,
+                                SIValue *up) {
+  SIValue keys[BPTREE_INNER_CAPACITY + 1];
+  BPTreeNode *children[BPTREE_INNER_CAPACITY + 2];
+  int count = inner->node.count;
+
+  memcpy(keys, inner->keys, sizeof(SIValue) * pos);
+  keys[pos] = separator;
+  memcpy(keys + pos + 1, inner->keys + pos, sizeof(SIValue) * (count - pos));
+  memcpy(children, inner->children, sizeof(BPTreeNode*) * (pos + 1));
+  children[pos + 1] = child;
+  memcpy(children + pos + 2, inner->children + pos + 1, sizeof(BPTreeNode*) * (count - pos));
+  count++;
+
+  int mid = count / 2;
+  memcpy(inner->keys, keys, sizeof(SIValue) * mid);
+  memcpy(inner->children, children, sizeof(BPTreeNode*) * (mid + 1));
+  inner->node.count = mid;
+  *up = keys[mid];
+
+  BPTreeInner *right = _newInner();
+  right->node.count = count - mid - 1;
+  memcpy(right->keys, keys + mid + 1, sizeof(SIValue) * right->node.count);
+  memcpy(right->children, children + mid + 1, sizeof(BPTreeNode*) * (right->node.count + 1));
+  return right;
+}
+
+static void _freeNode(const BPTree *tree, BPTreeNode *node) {
+  if (node->leaf) {
+    _freeLeaf(tree, (BPTreeLeaf*)node);
+    return;
+  }
+  BPTreeInner *inner = (BPTreeInner*)node;
+  for (int i = 0; i <= inner->node.count; i++) _freeNode(tree, inner->children[i]);
+  for (int i = 0; i < inner->node.count; i++) SIValue_Free(inner->keys + i);
+  rm_free(inner);
+}
+
+//------------------------------------------------------------------------------
+// Tree operations
+//------------------------------------------------------------------------------
+
+BPTree* BPTree_New(bool strings) {
+  BPTree *tree = rm_malloc(sizeof(BPTree));
+  tree->root = (BPTreeNode*)_newLeaf();
+  tree->strings = strings;
+  tree->prefixes = false;
+  tree->key_count = 0;
+  return tree;
+}
+
+BPTree* BPTree_NewPrefixMatching(void) {
+  BPTree *tree = BPTree_New(true);
+  tree->prefixes = true;
+  return tree;
+}
+
+bool BPTree_SupportsKey(const BPTree *tree, const SIValue *key) {
+  if (tree->strings) return (key->type == T_STRING);
+  return (key->type & SI_NUMERIC);
+}
+
+/* Lists id under key within node's subtree, inserted is set if id wasn't listed yet.
+ * Should node split, its new right sibling is returned
+ * and separator is set to the smallest key of the sibling's subtree. */
+static BPTreeNode* _insert(BPTree *tree, BPTreeNode *node, const SIValue *key, NodeID id,
+                           SIValue *separator, bool *inserted) {
+  if (node->leaf) {
+    BPTreeLeaf *leaf = (BPTreeLeaf*)node;
+    bool found;
+    int pos = _leafLowerBound(tree, leaf, key, &found);
+    if (found) {
+      *inserted = PostingList_Add(leaf->postings + pos, id);
+      return NULL;
+    }
+
+    *inserted = true;
+    tree->key_count++;
+    if (leaf->node.count < BPTREE_LEAF_CAPACITY) {
+      _leafInsert(tree, leaf, pos, key, id);
+      return NULL;
+    }
+
+    BPTreeLeaf *right = _splitLeaf(tree, leaf);
+    if (pos <= leaf->node.count) _leafInsert(tree, leaf, pos, key, id);
+    else _leafInsert(tree, right, pos - leaf->node.count, key, id);
+    *separator = _leafKey(tree, right, 0);
+    return (BPTreeNode*)right;
+  }
+
+  BPTreeInner *inner = (BPTreeInner*)node;
+  int child = _innerSearch(tree, inner, key, true);
+  SIValue child_separator;
+  BPTreeNode *sibling = _insert(tree, inner->children[child], key, id, &child_separator, inserted);
+  if (!sibling) return NULL;
+
+  if (inner->node.count < BPTREE_INNER_CAPACITY) {
+    _innerInsert(inner, child, child_separator, sibling);
+    return NULL;
+  }
+  return (BPTreeNode*)_splitInner(inner, child, child_separator, sibling, separator);
+}
+
+bool BPTree_Insert(BPTree *tree, const SIValue *key, NodeID id) {
+  assert(BPTree_SupportsKey(tree, key));
+  bool inserted;
+  SIValue separator;
+  BPTreeNode *sibling = _insert(tree, tree->root, key, id, &separator, &inserted);
+  if (sibling) {
+    // Root was split, grow the tree by a level.
+    BPTreeInner *root = _newInner();
+    root->node.count = 1;
+    root->keys[0] = separator;
+    root->children[0] = tree->root;
+    root->children[1] = sibling;
+    tree->root = (BPTreeNode*)root;
+  }
+  return inserted;
+}
+
+/* Removes id from key's posting list within node's subtree, deleted is set if id was listed.
+ * Nodes left empty are unlinked and freed, returns true if node was freed. */
+static bool _delete(BPTree *tree, BPTreeNode *node, const SIValue *key, NodeID id, bool *deleted) {
+  if (node->leaf) {
+    BPTreeLeaf *leaf = (BPTreeLeaf*)node;
+    bool found;
+    int pos = _leafLowerBound(tree, leaf, key, &found);
+    *deleted = (found && PostingList_Remove(leaf->postings + pos, id));
+    if (!*deleted || leaf->postings[pos].count > 0) return false;
+
+    _leafRemove(tree, leaf, pos);
+    tree->key_count--;
+    // A root leaf remains, even if empty.
+    if (leaf->node.count > 0 || node == tree->root) return false;
+
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    _freeLeaf(tree, leaf);
+    return true;
+  }
+
+  BPTreeInner *inner = (BPTreeInner*)node;
+  int child = _innerSearch(tree, inner, key, true);
+  if (!_delete(tree, inner->children[child], key, id, deleted)) return false;
+
+  if (inner->node.count == 0) {
+    rm_free(inner);
+    return true;
+  }
+
+  // Drop the freed child along with a separator bounding it.
+  int count = inner->node.count;
+  int sep = (child > 0) ? child - 1 : 0;
+  SIValue_Free(inner->keys + sep);
+  memmove(inner->keys + sep, inner->keys + sep + 1, sizeof(SIValue) * (count - sep - 1));
+  memmove(inner->children + child, inner->children + child + 1, sizeof(BPTreeNode*) * (count - child));
+  inner->node.count--;
+  return false;
+}
+
+bool BPTree_Delete(BPTree *tree, const SIValue *key, NodeID id) {
+  if (!BPTree_SupportsKey(tree, key)) return false;
+  bool deleted;
+  if (_delete(tree, tree->root, key, id, &deleted)) {
+    // Every key was removed.
+    tree->root = (BPTreeNode*)_newLeaf();
+  }
+
+  // Shrink the tree while its root has a single child.
+  while (!tree->root->leaf && tree->root->count == 0) {
+    BPTreeInner *root = (BPTreeInner*)tree->root;
+    tree->root = root->children[0];
+    rm_free(root);
+  }
+  return deleted;
+}
+
+const NodeID* BPTree_Lookup(const BPTree *tree, const SIValue *key, uint64_t *count) {
+  *count = 0;
+  if (!BPTree_SupportsKey(tree, key)) return NULL;
+  BPTreeLeaf *leaf = _findLeaf(tree, key);
+  bool found;
+  int pos = _leafLowerBound(tree, leaf, key, &found);
+  if (!found) return NULL;
+  *count = leaf->postings[pos].count;
+  return PostingList_IDs(leaf->postings + pos);
+}
+
+uint64_t BPTree_KeyCount(const BPTree *tree) {
+  return tree->key_count;
+}
+
+void BPTree_Free(BPTree *tree) {
+  _freeNode(tree, tree->root);
+  rm_free(tree);
+}
+
+//------------------------------------------------------------------------------
+// Iterator
+//------------------------------------------------------------------------------
+
+BPTreeIterator* BPTree_IterateAll(const BPTree *tree) {
+  BPTreeIterator *iter = rm_calloc(1, sizeof(BPTreeIterator));
+  iter->tree = tree;
+  iter->min = SI_NullVal();
+  iter->max = SI_NullVal();
+  return iter;
+}
+
+// Replaces the lower bound if the new one is narrower.
+static void _updateLowerBound(BPTreeIterator *iter, const SIValue *bound, bool exclusive) {
+  if (iter->min.type != T_NULL) {
+    int c = _compareKeys(iter->tree, bound, &iter->min);
+    if (c < 0 || (c == 0 && (iter->min_exclusive || !exclusive))) return;
+    SIValue_Free(&iter->min);
+  }
+  iter->min = SI_Clone(*bound);
+  iter->min_exclusive = exclusive;
+}
+
+// Replaces the upper bound if the new one is narrower.
+static void _updateUpperBound(BPTreeIterator *iter, const SIValue *bound, bool exclusive) {
+  if (iter->max.type != T_NULL) {
+    int c = _compareKeys(iter->tree, bound, &iter->max);
+    if (c > 0 || (c == 0 && (iter->max_exclusive || !exclusive))) return;
+    SIValue_Free(&iter->max);
+  }
+  iter->max = SI_Clone(*bound);
+  iter->max_exclusive = exclusive;
+}
+
+bool BPTreeIterator_UpdateBound(BPTreeIterator *iter, const SIValue *bound, int op) {
+  assert(!iter->reverse);
+  if (!BPTree_SupportsKey(iter->tree, bound)) return false;
+
+  switch(op) {
+    case EQ:
+      _updateLowerBound(iter, bound, false);
+      _updateUpperBound(iter, bound, false);
+      break;
+    case LT:
+      _updateUpperBound(iter, bound, true);
+      break;
+    case LE:
+      _updateUpperBound(iter, bound, false);
+      break;
+    case GT:
+      _updateLowerBound(iter, bound, true);
+      break;
+    case GE:
+      _updateLowerBound(iter, bound, false);
+      break;
+    default:
+      return false;
+  }
+  // Bounds take effect once the cursor is repositioned.
+  iter->positioned = false;
+  return true;
+}
+
+void BPTreeIterator_Reverse(BPTreeIterator *iter) {
+  iter->reverse = true;
+  iter->positioned = false;
+}
+
+void BPTreeIterator_Reset(BPTreeIterator *iter) {
+  iter->positioned = false;
+}
+
+/* Positions the cursor at the first key greater than key if after is set,
+ * at the first key not less than key otherwise.
+ * The cursor might be left past its leaf's last key, keys equal to a separator
+ * are all found within the separator's right subtree. */
+static void _seek(BPTreeIterator *iter, const SIValue *key, bool after) {
+  const BPTree *tree = iter->tree;
+  BPTreeNode *node = tree->root;
+  while (!node->leaf) {
+    BPTreeInner *inner = (BPTreeInner*)node;
+    node = inner->children[_innerSearch(tree, inner, key, after)];
+  }
+  iter->leaf = (BPTreeLeaf*)node;
+  iter->pos = _leafSearch(tree, iter->leaf, key, after);
+}
+
+// Positions the cursor at the first key within range.
+static void _seekFirst(BPTreeIterator *iter) {
+  if (iter->min.type != T_NULL) {
+    _seek(iter, &iter->min, iter->min_exclusive);
+    return;
+  }
+  BPTreeNode *node = iter->tree->root;
+  while (!node->leaf) node = ((BPTreeInner*)node)->children[0];
+  iter->leaf = (BPTreeLeaf*)node;
+  iter->pos = 0;
+}
+
+// Positions the cursor at the last key within range.
+static void _seekLast(BPTreeIterator *iter) {
+  if (iter->max.type != T_NULL) {
+    // Step back from the first key past the range.
+    _seek(iter, &iter->max, !iter->max_exclusive);
+    iter->pos--;
+    return;
+  }
+  BPTreeNode *node = iter->tree->root;
+  while (!node->leaf) node = ((BPTreeInner*)node)->children[node->count];
+  iter->leaf = (BPTreeLeaf*)node;
+  iter->pos = iter->leaf->node.count - 1;
+}
+
+// Returns true if the cursor's key lies within the bound iteration advances towards.
+static bool _withinRange(const BPTreeIterator *iter) {
+  if (iter->reverse) {
+    if (iter->min.type == T_NULL) return true;
+    int c = _compareLeafKey(iter->tree, iter->leaf, iter->pos, &iter->min);
+    return (c < 0 || (c == 0 && !iter->min_exclusive));
+  }
+  if (iter->max.type == T_NULL) return true;
+  int c = _compareLeafKey(iter->tree, iter->leaf, iter->pos, &iter->max);
+  return (c > 0 || (c == 0 && !iter->max_exclusive));
+}
+
+NodeID* BPTreeIterator_Next(BPTreeIterator *iter) {
+  if (!iter->positioned) {
+    if (iter->reverse) _seekLast(iter);
+    else _seekFirst(iter);
+    iter->posting_idx = 0;
+    iter->positioned = true;
+  }
+
+  while (iter->leaf) {
+    BPTreeLeaf *leaf = iter->leaf;
+    // Step to a sibling once the current leaf is exhausted.
+    if (iter->pos < 0) {
+      iter->leaf = leaf->prev;
+      if (iter->leaf) iter->pos = iter->leaf->node.count - 1;
+      continue;
+    }
+    if (iter->pos >= leaf->node.count) {
+      iter->leaf = leaf->next;
+      iter->pos = 0;
+      continue;
+    }
+
+    // Bounds are checked upon entering a key.
+    if (iter->posting_idx == 0 && !_withinRange(iter)) {
+      iter->leaf = NULL;
+      return NULL;
+    }
+
+    const PostingList *pl = leaf->postings + iter->pos;
+    NodeID *id = (NodeID*)PostingList_IDs(pl) + iter->posting_idx++;
+    if (iter->posting_idx == pl->count) {
+      iter->posting_idx = 0;
+      iter->pos += iter->reverse ? -1 : 1;
+    }
+    return id;
+  }
+  return NULL;
+}
+
+void BPTreeIterator_Free(BPTreeIterator *iter) {
+  SIValue_Free(&iter->min);
+  SIValue_Free(&iter->max);
+  rm_free(iter);
+}
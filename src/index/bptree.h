@@ -0,0 +1,98 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __BPTREE_H__
+#define __BPTREE_H__
+
+#include "../value.h"
+#include "../parser/grammar.h"
+#include "posting_list.h"
+
+/* B+tree mapping indexed values of a single kind, either strings or numerics,
+ * to posting lists of the entities holding them.
+ * Nodes are wide (64 entries) such that a probe visits a handful of nodes,
+ * numeric keys are stored inline within leaves while a leaf's string keys
+ * share a single allocation holding their common prefix once, followed by
+ * each key's suffix. Leaves are linked to their siblings for range iteration.
+ * Numerics which compare equal (e.g. 1 and 1.0) form a single key.
+ * Prefix matching trees hold strings encoding compound keys, where a probe
+ * matches every key it is a prefix of. */
+
+struct BPTreeNode;
+struct BPTreeLeaf;
+
+typedef struct {
+  struct BPTreeNode *root;  // Leaf, until the tree outgrows a single node.
+  bool strings;             // Keyed by strings, numerics otherwise.
+  bool prefixes;            // Probes match the string keys they are a prefix of.
+  uint64_t key_count;       // Number of distinct keys.
+} BPTree;
+
+/* Iterators traverse keys within a range in ascending or descending order,
+ * producing the entities of each key's posting list by ascending ID.
+ * The cursor is positioned once iteration begins, such that bounds are cheap
+ * to update and a reset iterator reflects updates made since its creation. */
+typedef struct {
+  const BPTree *tree;
+  struct BPTreeLeaf *leaf;  // Current leaf, NULL once depleted.
+  int pos;                  // Current key within leaf.
+  uint64_t posting_idx;     // Next entity within the current key's posting list.
+  SIValue min;              // Lower bound, T_NULL if unbounded.
+  SIValue max;              // Upper bound, T_NULL if unbounded.
+  bool min_exclusive;
+  bool max_exclusive;
+  bool reverse;             // Traverse keys in descending order.
+  bool positioned;          // Cursor was positioned.
+} BPTreeIterator;
+
+/* Creates an empty tree over either string or numeric keys. */
+BPTree* BPTree_New(bool strings);
+
+/* Creates an empty tree over string keys, probes match the keys they are a prefix of,
+ * such that bounds select every key starting with them.
+ * Stored keys must not be prefixes of one another. */
+BPTree* BPTree_NewPrefixMatching(void);
+
+/* Returns true if values of key's type can be stored in tree. */
+bool BPTree_SupportsKey(const BPTree *tree, const SIValue *key);
+
+/* Adds id to key's posting list, key is copied if it isn't stored yet.
+ * Returns false if id was already listed under key. */
+bool BPTree_Insert(BPTree *tree, const SIValue *key, NodeID id);
+
+/* Removes id from key's posting list, dropping key once no entity holds it.
+ * Returns false if id wasn't listed under key. */
+bool BPTree_Delete(BPTree *tree, const SIValue *key, NodeID id);
+
+/* Retrieves key's posting list, sorted by ID, and sets count to its length.
+ * Returns NULL if key isn't stored, posting lists are valid up until the next update. */
+const NodeID* BPTree_Lookup(const BPTree *tree, const SIValue *key, uint64_t *count);
+
+/* Returns the number of distinct keys. */
+uint64_t BPTree_KeyCount(const BPTree *tree);
+
+void BPTree_Free(BPTree *tree);
+
+/* Creates an iterator over all of tree's keys. */
+BPTreeIterator* BPTree_IterateAll(const BPTree *tree);
+
+/* Narrows the iterator's range by a comparison against bound, returns false if
+ * op can't be translated into a bound ('!=') or bound is of a type tree doesn't hold.
+ * Bounds should be updated before reversing. */
+bool BPTreeIterator_UpdateBound(BPTreeIterator *iter, const SIValue *bound, int op);
+
+/* Traverse keys in descending order. */
+void BPTreeIterator_Reverse(BPTreeIterator *iter);
+
+/* Returns a pointer to the next entity ID, or NULL once the iterator is depleted. */
+NodeID* BPTreeIterator_Next(BPTreeIterator *iter);
+
+/* Restarts iteration from the first key within range. */
+void BPTreeIterator_Reset(BPTreeIterator *iter);
+
+void BPTreeIterator_Free(BPTreeIterator *iter);
+
+#endif
@@ -0,0 +1,342 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "composite_index.h"
+#include <string.h>
+#include "../util/rmalloc.h"
+
+/* Keys are SIValue arrays, the first element holds the number of values which follow.
+ * Stored keys hold a value for every indexed attribute, where missing values are NULL,
+ * while iterator bounds may be shorter, matching every key they are a prefix of. */
+#define KEY_LEN(key) ((key)[0].longval)
+
+// Order of value types within a key position.
+static inline int _typeRank(const SIValue *v) {
+  if (v->type == T_STRING) return 0;
+  if (v->type & SI_NUMERIC) return 1;
+  return 2;
+}
+
+static int _compareValues(const SIValue *a, const SIValue *b) {
+  int rank_a = _typeRank(a);
+  int rank_b = _typeRank(b);
+  if (rank_a != rank_b) return rank_a - rank_b;
+
+  switch (rank_a) {
+    case 0:
+      return strcmp(a->stringval, b->stringval);
+    case 1:
+      if (a->type & b->type & T_INT64) {
+        return (a->longval > b->longval) - (a->longval < b->longval);
+      } else {
+        double diff = SI_GET_NUMERIC(*a) - SI_GET_NUMERIC(*b);
+        return SAFE_COMPARISON_RESULT(diff);
+      }
+    default:
+      return 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Function pointers for skiplist routines
+//------------------------------------------------------------------------------
+
+// Lexicographic comparison, a key compares equal to any key it is a prefix of.
+static int _compareKeys(SIValue *a, SIValue *b) {
+  int64_t len = KEY_LEN(a) < KEY_LEN(b) ? KEY_LEN(a) : KEY_LEN(b);
+  for (int64_t i = 1; i <= len; i++) {
+    int c = _compareValues(a + i, b + i);
+    if (c) return c;
+  }
+  return 0;
+}
+
+static int _compareNodeIDs(NodeID a, NodeID b) {
+  return (a > b) - (a < b);
+}
+
+static SIValue* _cloneKey(SIValue *key) {
+  int64_t len = KEY_LEN(key);
+  SIValue *clone = rm_malloc(sizeof(SIValue) * (len + 1));
+  clone[0] = key[0];
+  for (int64_t i = 1; i <= len; i++) clone[i] = SI_Clone(key[i]);
+  return clone;
+}
+
+static void _freeKey(SIValue *key) {
+  int64_t len = KEY_LEN(key);
+  for (int64_t i = 1; i <= len; i++) SIValue_Free(key + i);
+  rm_free(key);
+}
+
+//------------------------------------------------------------------------------
+// Key encoding for B+tree indices
+//------------------------------------------------------------------------------
+
+/* Encoded keys are strings whose byte order is the order of the keys they encode.
+ * Each value is led by a tag ranking its type, a string follows escaped and terminated,
+ * a numeric follows as a fixed number of bytes. No byte is NUL and no value's
+ * encoding is a prefix of another's, such that the encoding of leading values
+ * is a prefix of the encoding of every key they lead. */
+#define KEY_TAG_STRING 0x01
+#define KEY_TAG_NUMERIC 0x02
+#define KEY_TAG_MISSING 0x03
+#define KEY_STRING_ESCAPE 0x01  // Followed by 0x01 to terminate a string, by 0x02 for a 0x01 byte.
+#define KEY_NUMERIC_BYTES 12
+
+// Maps a double to an unsigned integer of the same order.
+static uint64_t _orderedBits(double d) {
+  if (d == 0) d = 0; // -0.0 equals 0.0.
+  uint64_t u;
+  memcpy(&u, &d, sizeof(u));
+  return (u & (1ULL << 63)) ? ~u : (u | (1ULL << 63));
+}
+
+/* Numerics are ordered by their double value, such that 1 and 1.0 encode alike.
+ * Integers a double can't represent exactly are then ordered by their difference from it,
+ * which is within half a unit of the double's last place, 2^10 at most.
+ * Each byte holds 7 bits, with its high bit set. */
+static unsigned char* _encodeNumeric(const SIValue *v, unsigned char *buf) {
+  double d = SI_GET_NUMERIC(*v);
+  int64_t residue = 0;
+  if (v->type == T_INT64) {
+    // Integers close to INT64_MAX round to 2^63, which int64_t can't hold.
+    if (d >= 0x1p63) residue = (v->longval - INT64_MAX) - 1;
+    else residue = v->longval - (int64_t)d;
+  }
+
+  uint64_t u = _orderedBits(d);
+  *buf++ = 0x80 | (u >> 63);
+  for (int shift = 56; shift >= 0; shift -= 7) *buf++ = 0x80 | ((u >> shift) & 0x7F);
+  uint16_t r = residue + 0x2000;
+  *buf++ = 0x80 | (r >> 7);
+  *buf++ = 0x80 | (r & 0x7F);
+  return buf;
+}
+
+// Number of bytes encoding v.
+static size_t _encodedLength(const SIValue *v) {
+  switch (_typeRank(v)) {
+    case 0: {
+      size_t len = 3; // Tag and terminator.
+      for (const char *c = v->stringval; *c; c++) len += (*c == KEY_STRING_ESCAPE) ? 2 : 1;
+      return len;
+    }
+    case 1:
+      return 1 + KEY_NUMERIC_BYTES;
+    default:
+      return 1;
+  }
+}
+
+// Encodes v to buf, returns the position following its encoding.
+static unsigned char* _encodeValue(const SIValue *v, unsigned char *buf) {
+  switch (_typeRank(v)) {
+    case 0:
+      *buf++ = KEY_TAG_STRING;
+      for (const char *c = v->stringval; *c; c++) {
+        if (*c == KEY_STRING_ESCAPE) {
+          *buf++ = KEY_STRING_ESCAPE;
+          *buf++ = 0x02;
+        } else {
+          *buf++ = *c;
+        }
+      }
+      *buf++ = KEY_STRING_ESCAPE;
+      *buf++ = 0x01;
+      return buf;
+    case 1:
+      *buf++ = KEY_TAG_NUMERIC;
+      return _encodeNumeric(v, buf);
+    default:
+      *buf++ = KEY_TAG_MISSING;
+      return buf;
+  }
+}
+
+// Encodes count values as a string value, which the caller should free.
+static SIValue _encodeKey(const SIValue *values, uint count) {
+  size_t len = 1;
+  for (uint i = 0; i < count; i++) len += _encodedLength(values + i);
+  unsigned char *key = rm_malloc(len);
+  unsigned char *buf = key;
+  for (uint i = 0; i < count; i++) buf = _encodeValue(values + i, buf);
+  *buf = '\0';
+  return SI_TransferStringVal((char*)key);
+}
+
+//------------------------------------------------------------------------------
+// Key construction
+//------------------------------------------------------------------------------
+
+/* Populate key with node's values for the indexed attributes,
+ * returns false if node shouldn't be indexed. */
+static bool _buildKey(const CompositeIndex *idx, const Node *n, SIValue *key) {
+  key[0] = SI_LongVal(idx->attr_count);
+  for (uint i = 0; i < idx->attr_count; i++) {
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)n, idx->attr_ids[i]);
+    if (SIValue_IsNull(v) || _typeRank(&v) == 2) {
+      key[i + 1] = SI_NullVal();
+    } else {
+      key[i + 1] = v;
+    }
+  }
+  // Keys are only matched by their leading values, which must be indexable.
+  return !SIValue_IsNull(key[1]);
+}
+
+//------------------------------------------------------------------------------
+// Index creation functions
+//------------------------------------------------------------------------------
+
+CompositeIndex* CompositeIndex_Create(Graph *g, const char *label, int label_id,
+                                      const char **attr_strs, const Attribute_ID *attr_ids, uint attr_count,
+                                      IndexType type) {
+  assert(attr_count > 1 && attr_count <= COMPOSITE_INDEX_MAX_ATTRIBUTES);
+  assert(type != IDX_HASH);
+  const GrB_Matrix label_matrix = Graph_GetLabelMatrix(g, label_id);
+  // Label's pending additions are scanned once label matrix is depleted.
+  GrB_Matrix delta_matrix = Graph_GetDeltaMatrix(g, label_matrix);
+  GxB_MatrixTupleIter *it;
+  GxB_MatrixTupleIter_new(&it, label_matrix);
+
+  CompositeIndex *idx = rm_malloc(sizeof(CompositeIndex));
+  idx->label = rm_strdup(label);
+  idx->attr_count = attr_count;
+  idx->attributes = rm_malloc(sizeof(char*) * attr_count);
+  idx->attr_ids = rm_malloc(sizeof(Attribute_ID) * attr_count);
+  for (uint i = 0; i < attr_count; i++) {
+    idx->attributes[i] = rm_strdup(attr_strs[i]);
+    idx->attr_ids[i] = attr_ids[i];
+  }
+  idx->entity_count = 0;
+  idx->type = type;
+  idx->bt = NULL;
+  idx->sl = NULL;
+  if (type == IDX_BTREE) idx->bt = BPTree_NewPrefixMatching();
+  else idx->sl = skiplistCreate(_compareKeys, _compareNodeIDs, _cloneKey, _freeKey);
+
+  Node node;
+  NodeID node_id;
+  while(true) {
+    bool depleted = false;
+    GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
+    if(depleted) {
+      if(!delta_matrix) break;
+      GxB_MatrixTupleIter_reuse(it, delta_matrix);
+      delta_matrix = NULL;
+      continue;
+    }
+    Graph_GetNode(g, node_id, &node);
+    CompositeIndex_InsertNode(idx, &node);
+  }
+
+  GxB_MatrixTupleIter_free(it);
+
+  return idx;
+}
+
+//------------------------------------------------------------------------------
+// Index updates
+//------------------------------------------------------------------------------
+
+void CompositeIndex_InsertNode(CompositeIndex *idx, const Node *n) {
+  SIValue key[idx->attr_count + 1];
+  if (!_buildKey(idx, n, key)) return;
+  if (idx->bt) {
+    // Encoded key is copied if it isn't stored yet.
+    SIValue encoded = _encodeKey(key + 1, idx->attr_count);
+    if (BPTree_Insert(idx->bt, &encoded, ENTITY_GET_ID(n))) idx->entity_count++;
+    SIValue_Free(&encoded);
+    return;
+  }
+  // Key values are cloned within the skiplistInsert routine if necessary.
+  skiplistInsert(idx->sl, key, ENTITY_GET_ID(n));
+  idx->entity_count++;
+}
+
+void CompositeIndex_DeleteNode(CompositeIndex *idx, const Node *n) {
+  SIValue key[idx->attr_count + 1];
+  if (!_buildKey(idx, n, key)) return;
+  NodeID node_id = ENTITY_GET_ID(n);
+  if (idx->bt) {
+    SIValue encoded = _encodeKey(key + 1, idx->attr_count);
+    if (BPTree_Delete(idx->bt, &encoded, node_id)) idx->entity_count--;
+    SIValue_Free(&encoded);
+    return;
+  }
+  if (skiplistDelete(idx->sl, key, &node_id)) idx->entity_count--;
+}
+
+bool CompositeIndex_ContainsAttribute(const CompositeIndex *idx, Attribute_ID attr_id) {
+  for (uint i = 0; i < idx->attr_count; i++) {
+    if (idx->attr_ids[i] == attr_id) return true;
+  }
+  return false;
+}
+
+uint64_t CompositeIndex_EntityCount(const CompositeIndex *idx) {
+  return idx->entity_count;
+}
+
+//------------------------------------------------------------------------------
+// Index iterator functions
+//------------------------------------------------------------------------------
+
+// Builds a bound key from prefix, followed by value if specified.
+static SIValue* _boundKey(const SIValue *prefix, uint prefix_len, const SIValue *value) {
+  uint len = prefix_len + (value ? 1 : 0);
+  if (len == 0) return NULL;
+
+  SIValue key[len + 1];
+  key[0] = SI_LongVal(len);
+  for (uint i = 0; i < prefix_len; i++) key[i + 1] = prefix[i];
+  if (value) key[len] = *value;
+  return _cloneKey(key);
+}
+
+/* Bounds a B+tree iterator by the encoding of prefix, followed by value if specified,
+ * which matches every key it is a prefix of. */
+static void _applyEncodedBound(BPTreeIterator *iter, const SIValue *prefix, uint prefix_len,
+                               const SIValue *value, int op) {
+  uint len = prefix_len + (value ? 1 : 0);
+  if (len == 0) return;
+
+  SIValue values[len];
+  for (uint i = 0; i < prefix_len; i++) values[i] = prefix[i];
+  if (value) values[prefix_len] = *value;
+  SIValue bound = _encodeKey(values, len);
+  BPTreeIterator_UpdateBound(iter, &bound, op);
+  SIValue_Free(&bound);
+}
+
+IndexIter* CompositeIndexIter_Create(CompositeIndex *idx, const SIValue *prefix, uint prefix_len,
+                                     const SIValue *min, int minExclusive,
+                                     const SIValue *max, int maxExclusive) {
+  assert(prefix_len + (min || max ? 1 : 0) <= idx->attr_count);
+  // Without a bound on the following attribute, the prefix itself is an inclusive bound.
+  if (!min) minExclusive = 0;
+  if (!max) maxExclusive = 0;
+  if (idx->bt) {
+    BPTreeIterator *iter = BPTree_IterateAll(idx->bt);
+    _applyEncodedBound(iter, prefix, prefix_len, min, minExclusive ? GT : GE);
+    _applyEncodedBound(iter, prefix, prefix_len, max, maxExclusive ? LT : LE);
+    return IndexIter_FromBPTree(iter);
+  }
+  SIValue *min_key = _boundKey(prefix, prefix_len, min);
+  SIValue *max_key = _boundKey(prefix, prefix_len, max);
+  return IndexIter_FromSkiplist(skiplistIterateRange(idx->sl, min_key, max_key, minExclusive, maxExclusive));
+}
+
+void CompositeIndex_Free(CompositeIndex *idx) {
+  if (idx->bt) BPTree_Free(idx->bt);
+  else skiplistFree(idx->sl);
+  for (uint i = 0; i < idx->attr_count; i++) rm_free(idx->attributes[i]);
+  rm_free(idx->attributes);
+  rm_free(idx->attr_ids);
+  rm_free(idx->label);
+  rm_free(idx);
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __COMPOSITE_INDEX_H__
+#define __COMPOSITE_INDEX_H__
+
+#include "index.h"
+#include "../graph/entities/node.h"
+
+#define COMPOSITE_INDEX_MAX_ATTRIBUTES 16
+
+/* A composite index covers a label and an ordered list of attributes.
+ * Entities are keyed by the values of all attributes, compared lexicographically,
+ * such that entities sharing leading values are adjacent in the index.
+ * Within each key position strings precede numerics, and entities missing
+ * an attribute (or holding a value of an unsupported type) follow both.
+ * Entities which lack a string or numeric value for the first attribute are not indexed.
+ * B+tree indices store each key as a single string whose bytes order as the key,
+ * sharing the leading values of neighbouring keys, skiplist indices store value arrays. */
+typedef struct {
+  char *label;
+  char **attributes;      // Indexed attributes, in key order.
+  Attribute_ID *attr_ids; // Attribute IDs, in key order.
+  uint attr_count;        // Number of indexed attributes.
+  IndexType type;         // IDX_BTREE or IDX_SKIPLIST.
+  BPTree *bt;             // NULL for skiplist indices.
+  skiplist *sl;           // NULL for B+tree indices.
+  uint64_t entity_count;  // Number of indexed entities.
+} CompositeIndex;
+
+/* CompositeIndex_Create builds an index over a label and several attributes
+ * (at most COMPOSITE_INDEX_MAX_ATTRIBUTES), populated with all labeled nodes.
+ * Hash indices are not supported. */
+CompositeIndex* CompositeIndex_Create(Graph *g, const char *label, int label_id,
+                                      const char **attr_strs, const Attribute_ID *attr_ids, uint attr_count,
+                                      IndexType type);
+
+/* Insert a single entity into the index, keyed by its current property values. */
+void CompositeIndex_InsertNode(CompositeIndex *idx, const Node *n);
+
+/* Delete a single entity from the index if it is present,
+ * must be called before any of its indexed properties change. */
+void CompositeIndex_DeleteNode(CompositeIndex *idx, const Node *n);
+
+/* Returns true if attribute is one of the index's key attributes. */
+bool CompositeIndex_ContainsAttribute(const CompositeIndex *idx, Attribute_ID attr_id);
+
+/* Returns the number of indexed entities. */
+uint64_t CompositeIndex_EntityCount(const CompositeIndex *idx);
+
+/* Build an iterator over entities whose first prefix_len attributes equal prefix,
+ * the attribute following the prefix is optionally bounded by min and max.
+ * Values should be strings or numerics. */
+IndexIter* CompositeIndexIter_Create(CompositeIndex *idx, const SIValue *prefix, uint prefix_len,
+                                     const SIValue *min, int minExclusive,
+                                     const SIValue *max, int maxExclusive);
+
+/* Free an index object and all its members. */
+void CompositeIndex_Free(CompositeIndex *idx);
+
+#endif
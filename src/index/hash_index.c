@@ -0,0 +1,131 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "hash_index.h"
+#include "../util/rmalloc.h"
+
+#define HASH_INDEX_INITIAL_SLOTS 64
+#define HASH_INDEX_MAX_LOAD 0.7
+
+static HashIndexSlot* _HashIndex_NewSlots(uint64_t slot_count) {
+  HashIndexSlot *slots = rm_malloc(sizeof(HashIndexSlot) * slot_count);
+  for (uint64_t i = 0; i < slot_count; i++) slots[i].postings.count = 0;
+  return slots;
+}
+
+HashIndex* HashIndex_New(void) {
+  HashIndex *h = rm_malloc(sizeof(HashIndex));
+  h->slot_count = HASH_INDEX_INITIAL_SLOTS;
+  h->slots = _HashIndex_NewSlots(h->slot_count);
+  h->key_count = 0;
+  return h;
+}
+
+bool HashIndex_SupportsKey(const SIValue *key) {
+  return (key->type == T_STRING || (key->type & SI_NUMERIC));
+}
+
+bool HashIndex_KeysEqual(const SIValue *a, const SIValue *b) {
+  if (a->type == T_STRING || b->type == T_STRING) {
+    return (a->type == b->type && strcmp(a->stringval, b->stringval) == 0);
+  }
+  if (a->type & b->type & T_INT64) return (a->longval == b->longval);
+  return (SI_GET_NUMERIC(*a) == SI_GET_NUMERIC(*b));
+}
+
+// Locates the slot of key, or the empty slot it should occupy.
+static HashIndexSlot* _HashIndex_Locate(const HashIndex *h, uint64_t hash, const SIValue *key) {
+  uint64_t mask = h->slot_count - 1;
+  for (uint64_t i = hash & mask;; i = (i + 1) & mask) {
+    HashIndexSlot *slot = h->slots + i;
+    if (slot->postings.count == 0) return slot;
+    if (slot->hash == hash && HashIndex_KeysEqual(&slot->key, key)) return slot;
+  }
+}
+
+static void _HashIndex_Grow(HashIndex *h) {
+  HashIndexSlot *old_slots = h->slots;
+  uint64_t old_slot_count = h->slot_count;
+
+  h->slot_count *= 2;
+  h->slots = _HashIndex_NewSlots(h->slot_count);
+
+  // Slots hold distinct keys, reinsert by probing for a free slot.
+  uint64_t mask = h->slot_count - 1;
+  for (uint64_t i = 0; i < old_slot_count; i++) {
+    if (old_slots[i].postings.count == 0) continue;
+    uint64_t j = old_slots[i].hash & mask;
+    while (h->slots[j].postings.count != 0) j = (j + 1) & mask;
+    h->slots[j] = old_slots[i];
+  }
+  rm_free(old_slots);
+}
+
+/* Empties slot, shifting back entries of its probe sequence
+ * such that lookups never stop short at the vacated slot. */
+static void _HashIndex_Vacate(HashIndex *h, HashIndexSlot *slot) {
+  uint64_t mask = h->slot_count - 1;
+  uint64_t hole = slot - h->slots;
+  for (uint64_t j = (hole + 1) & mask; h->slots[j].postings.count != 0; j = (j + 1) & mask) {
+    uint64_t home = h->slots[j].hash & mask;
+    // Entry may fill the hole if its home slot doesn't lie between the hole and itself.
+    if (((j - home) & mask) >= ((j - hole) & mask)) {
+      h->slots[hole] = h->slots[j];
+      hole = j;
+    }
+  }
+  h->slots[hole].postings.count = 0;
+}
+
+bool HashIndex_Insert(HashIndex *h, const SIValue *key, NodeID id) {
+  uint64_t hash = SIValue_HashCode(*key);
+  HashIndexSlot *slot = _HashIndex_Locate(h, hash, key);
+
+  if (slot->postings.count == 0) {
+    slot->hash = hash;
+    slot->key = SI_Clone(*key);
+    PostingList_Add(&slot->postings, id);
+    h->key_count++;
+    if (h->key_count > h->slot_count * HASH_INDEX_MAX_LOAD) _HashIndex_Grow(h);
+    return true;
+  }
+
+  return PostingList_Add(&slot->postings, id);
+}
+
+bool HashIndex_Delete(HashIndex *h, const SIValue *key, NodeID id) {
+  HashIndexSlot *slot = _HashIndex_Locate(h, SIValue_HashCode(*key), key);
+  if (!PostingList_Remove(&slot->postings, id)) return false;
+
+  if (slot->postings.count == 0) {
+    SIValue_Free(&slot->key);
+    h->key_count--;
+    _HashIndex_Vacate(h, slot);
+  }
+  return true;
+}
+
+const NodeID* HashIndex_Lookup(const HashIndex *h, const SIValue *key, uint64_t *count) {
+  HashIndexSlot *slot = _HashIndex_Locate(h, SIValue_HashCode(*key), key);
+  *count = slot->postings.count;
+  if (slot->postings.count == 0) return NULL;
+  return PostingList_IDs(&slot->postings);
+}
+
+uint64_t HashIndex_KeyCount(const HashIndex *h) {
+  return h->key_count;
+}
+
+void HashIndex_Free(HashIndex *h) {
+  for (uint64_t i = 0; i < h->slot_count; i++) {
+    HashIndexSlot *slot = h->slots + i;
+    if (slot->postings.count == 0) continue;
+    SIValue_Free(&slot->key);
+    PostingList_Free(&slot->postings);
+  }
+  rm_free(h->slots);
+  rm_free(h);
+}
@@ -0,0 +1,55 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __HASH_INDEX_H__
+#define __HASH_INDEX_H__
+
+#include "../value.h"
+#include "posting_list.h"
+
+/* Hash index is an open addressing hash table mapping indexed values
+ * to posting lists of the entities holding them, serving equality lookups only.
+ * Each distinct value is stored once, strings and numerics share a single table
+ * where numerics which compare equal (e.g. 1 and 1.0) form a single key. */
+
+typedef struct {
+  uint64_t hash;      // Hash of key.
+  SIValue key;        // Indexed value, owned by the table.
+  PostingList postings; // Entities holding key, empty for an empty slot.
+} HashIndexSlot;
+
+typedef struct {
+  HashIndexSlot *slots;   // Hash table over keys.
+  uint64_t slot_count;    // Number of slots, a power of 2.
+  uint64_t key_count;     // Number of distinct keys.
+} HashIndex;
+
+HashIndex* HashIndex_New(void);
+
+/* Returns true if values of key's type can be indexed. */
+bool HashIndex_SupportsKey(const SIValue *key);
+
+/* Returns true if both keys are equal under index semantics. */
+bool HashIndex_KeysEqual(const SIValue *a, const SIValue *b);
+
+/* Adds id to key's posting list, key is cloned if it isn't indexed yet.
+ * Returns false if id was already listed under key. */
+bool HashIndex_Insert(HashIndex *h, const SIValue *key, NodeID id);
+
+/* Removes id from key's posting list, dropping key once no entity holds it.
+ * Returns false if id wasn't listed under key. */
+bool HashIndex_Delete(HashIndex *h, const SIValue *key, NodeID id);
+
+/* Retrieves key's posting list, sorted by ID, and sets count to its length.
+ * Returns NULL if key isn't indexed, posting lists are valid up until the next update. */
+const NodeID* HashIndex_Lookup(const HashIndex *h, const SIValue *key, uint64_t *count);
+
+/* Returns the number of distinct keys. */
+uint64_t HashIndex_KeyCount(const HashIndex *h);
+
+void HashIndex_Free(HashIndex *h);
+
+#endif
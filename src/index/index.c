@@ -5,6 +5,7 @@
 */
 
 #include "index.h"
+#include "../util/arr.h"
 #include "../util/rmalloc.h"
 
 // Given a value type, return the matching skiplist from an index.
@@ -57,10 +58,74 @@ void initializeSkiplists(Index *index) {
   index->numeric_sl = skiplistCreate(compareNumerics, compareNodes, cloneKey, freeKey);
 }
 
+// Allocate the data structure backing an index of the given type.
+static void _initializeStorage(Index *index, IndexType type) {
+  index->type = type;
+  index->string_sl = NULL;
+  index->numeric_sl = NULL;
+  index->hash = NULL;
+  index->string_bt = NULL;
+  index->numeric_bt = NULL;
+  if (type == IDX_HASH) {
+    index->hash = HashIndex_New();
+  } else if (type == IDX_BTREE) {
+    index->string_bt = BPTree_New(true);
+    index->numeric_bt = BPTree_New(false);
+  } else {
+    initializeSkiplists(index);
+  }
+}
+
+// Given a value type, return the matching B+tree from an index.
+static inline BPTree* _select_bptree(const Index *idx, const SIType t) {
+  if (t == T_STRING) {
+    return idx->string_bt;
+  } else if (t & SI_NUMERIC) {
+    return idx->numeric_bt;
+  }
+  return NULL;
+}
+
+// Add entity to the index under val, returns false if val can't be indexed.
+static bool _insert(Index *idx, SIValue *val, NodeID id) {
+  if (idx->type == IDX_HASH) {
+    if (!HashIndex_SupportsKey(val)) return false;
+    return HashIndex_Insert(idx->hash, val, id);
+  }
+  if (idx->type == IDX_BTREE) {
+    BPTree *bt = _select_bptree(idx, val->type);
+    if (!bt) return false;
+    return BPTree_Insert(bt, val, id);
+  }
+  skiplist *sl = _select_skiplist(idx, val->type);
+  if (!sl) return false; // Value was of a type not supported by indices.
+  // This value will be cloned within the skiplistInsert routine if necessary
+  skiplistInsert(sl, val, id);
+  return true;
+}
+
+// Remove entity from the index, returns false if it wasn't indexed under val.
+static bool _delete(Index *idx, SIValue *val, NodeID id) {
+  if (idx->type == IDX_HASH) {
+    if (!HashIndex_SupportsKey(val)) return false;
+    return HashIndex_Delete(idx->hash, val, id);
+  }
+  if (idx->type == IDX_BTREE) {
+    BPTree *bt = _select_bptree(idx, val->type);
+    if (!bt) return false;
+    return BPTree_Delete(bt, val, id);
+  }
+  skiplist *sl = _select_skiplist(idx, val->type);
+  if (!sl) return false; // Value was of a type not supported by indices.
+  return skiplistDelete(sl, val, &id);
+}
+
 /* Index_Create allocates an Index object and populates it with all unique IDs and values
  * that possess the provided label and property. */
-Index* Index_Create(Graph *g, const char *label, int label_id, const char *attr_str, Attribute_ID attr_id) {
+Index* Index_Create(Graph *g, const char *label, int label_id, const char *attr_str, Attribute_ID attr_id, IndexType type) {
   const GrB_Matrix label_matrix = Graph_GetLabelMatrix(g, label_id);
+  // Label's pending additions are scanned once label matrix is depleted.
+  GrB_Matrix delta_matrix = Graph_GetDeltaMatrix(g, label_matrix);
   GxB_MatrixTupleIter *it;
   GxB_MatrixTupleIter_new(&it, label_matrix);
 
@@ -69,79 +134,202 @@ Index* Index_Create(Graph *g, const char *label, int label_id, const char *attr_
   index->label = rm_strdup(label);
   index->attribute = rm_strdup(attr_str);
   index->attr_id = attr_id;
+  index->entity_count = 0;
+  index->endpoints = NULL;
 
-  initializeSkiplists(index);
+  _initializeStorage(index, type);
 
   Node node;
-  EntityProperty *prop;
-
-  skiplist *sl;
   NodeID node_id;
-  GraphEntity *entity;
-
-  int found;
-  int prop_index = 0;
 
   while(true) {
     bool depleted = false;
     GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
-    if(depleted) break;
-    Graph_GetNode(g, node_id, &node);
-    // If the sought property is at a different offset than it occupied in the previous node,
-    // then seek and update
-    if (attr_id != ENTITY_PROPS(&node)[prop_index].id) {
-      found = 0;
-      for (int i = 0; i < ENTITY_PROP_COUNT(&node); i ++) {
-        prop = ENTITY_PROPS(&node) + i;
-        if (attr_id == prop->id) {
-          prop_index = i;
-          found = 1;
-          break;
-        }
-      }
-    } else {
-      found = 1;
+    if(depleted) {
+      if(!delta_matrix) break;
+      GxB_MatrixTupleIter_reuse(it, delta_matrix);
+      delta_matrix = NULL;
+      continue;
     }
+    Graph_GetNode(g, node_id, &node);
+    // Property might be stored on the node or in its label's column.
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)&node, attr_id);
     // The targeted property does not exist on this node
-    if (!found) continue;
+    if (SIValue_IsNull(v)) continue;
+
+    Index_InsertNode(index, node_id, &v);
+  }
+
+  GxB_MatrixTupleIter_free(it);
+
+  return index;
+}
+
+/* Index_CreateEdgeIndex allocates an Index object and populates it with all edges
+ * of the provided relation which possess the property. */
+Index* Index_CreateEdgeIndex(Graph *g, const char *relation, int relation_id, const char *attr_str, Attribute_ID attr_id, IndexType type) {
+  const GrB_Matrix relation_matrix = Graph_GetRelationMatrix(g, relation_id);
+  // Relation's pending additions are scanned once relation matrix is depleted.
+  GrB_Matrix delta_matrix = Graph_GetDeltaMatrix(g, relation_matrix);
+  GxB_MatrixTupleIter *it;
+  GxB_MatrixTupleIter_new(&it, relation_matrix);
+
+  Index *index = rm_malloc(sizeof(Index));
+
+  index->label = rm_strdup(relation);
+  index->attribute = rm_strdup(attr_str);
+  index->attr_id = attr_id;
+  index->entity_count = 0;
+  index->endpoints = array_new(EdgeEndpoints, 0);
+
+  _initializeStorage(index, type);
+
+  NodeID src_id;
+  NodeID dest_id;
+  Edge *edges = array_new(Edge, 1);
 
-    prop = ENTITY_PROPS(&node) + prop_index;
-    // This value will be cloned within the skiplistInsert routine if necessary
-    SIValue *key = &prop->value;
+  while(true) {
+    bool depleted = false;
+    GxB_MatrixTupleIter_next(it, &src_id, &dest_id, &depleted);
+    if(depleted) {
+      if(!delta_matrix) break;
+      GxB_MatrixTupleIter_reuse(it, delta_matrix);
+      delta_matrix = NULL;
+      continue;
+    }
 
-    sl = _select_skiplist(index, key->type);
-    if (!sl) continue; // Value was of a type not supported by indices.
-    skiplistInsert(sl, key, node_id);
+    // Collect all edges of relation connecting src to dest.
+    array_clear(edges);
+    Graph_GetEdgesConnectingNodes(g, src_id, dest_id, relation_id, &edges);
+    uint32_t edge_count = array_len(edges);
+    for(uint32_t i = 0; i < edge_count; i++) {
+      SIValue *v = GraphEntity_GetProperty((GraphEntity*)(edges + i), attr_id);
+      if(v == PROPERTY_NOTFOUND) continue;
+      Index_InsertEdge(index, edges + i, v);
+    }
   }
 
+  array_free(edges);
   GxB_MatrixTupleIter_free(it);
 
   return index;
 }
 
+bool Index_IsEdgeIndex(const Index *idx) {
+  return (idx->endpoints != NULL);
+}
+
+bool Index_IsHashIndex(const Index *idx) {
+  return (idx->type == IDX_HASH);
+}
+
+bool Index_SupportsValue(const SIValue *val) {
+  return (val->type == T_STRING || (val->type & SI_NUMERIC));
+}
+
 //------------------------------------------------------------------------------
 // Index updates
 //------------------------------------------------------------------------------
 
 void Index_DeleteNode(Index *idx, NodeID node, SIValue *val) {
-  skiplist *sl = _select_skiplist(idx, val->type);
-  if (!sl) return; // Value was of a type not supported by indices.
-  skiplistDelete(sl, val, &node);
+  if (_delete(idx, val, node)) idx->entity_count--;
 }
- void Index_InsertNode(Index *idx, NodeID node, SIValue *val) {
-  skiplist *sl = _select_skiplist(idx, val->type);
-  if (!sl) return; // Value was of a type not supported by indices.
-  skiplistInsert(sl, val, node);
+
+void Index_InsertNode(Index *idx, NodeID node, SIValue *val) {
+  if (_insert(idx, val, node)) idx->entity_count++;
+}
+
+void Index_InsertEdge(Index *idx, const Edge *e, SIValue *val) {
+  assert(Index_IsEdgeIndex(idx));
+  EdgeID edge_id = ENTITY_GET_ID(e);
+  if (!_insert(idx, val, edge_id)) return;
+  idx->entity_count++;
+
+  // Grow endpoints table to accommodate edge.
+  EdgeEndpoints unset = {INVALID_ENTITY_ID, INVALID_ENTITY_ID};
+  while(array_len(idx->endpoints) <= edge_id) {
+    idx->endpoints = array_append(idx->endpoints, unset);
+  }
+  idx->endpoints[edge_id].src = Edge_GetSrcNodeID(e);
+  idx->endpoints[edge_id].dest = Edge_GetDestNodeID(e);
+}
+
+void Index_DeleteEdge(Index *idx, EdgeID edge, SIValue *val) {
+  assert(Index_IsEdgeIndex(idx));
+  if (!_delete(idx, val, edge)) return;
+
+  idx->entity_count--;
+  // Edge ID might be reused by an edge of a different relation.
+  idx->endpoints[edge].src = INVALID_ENTITY_ID;
+  idx->endpoints[edge].dest = INVALID_ENTITY_ID;
+}
+
+bool Index_EdgeEndpoints(const Index *idx, EdgeID edge, NodeID *src, NodeID *dest) {
+  assert(Index_IsEdgeIndex(idx));
+  if (edge >= array_len(idx->endpoints)) return false;
+  if (idx->endpoints[edge].src == INVALID_ENTITY_ID) return false;
+  *src = idx->endpoints[edge].src;
+  *dest = idx->endpoints[edge].dest;
+  return true;
+}
+
+/* Number of distinct indexed values, skiplists, hash tables and B+trees keep
+ * a single key per value, maintained as the index is updated. */
+uint64_t Index_DistinctCount(const Index *idx) {
+  if (idx->type == IDX_HASH) return HashIndex_KeyCount(idx->hash);
+  if (idx->type == IDX_BTREE) {
+    return BPTree_KeyCount(idx->string_bt) + BPTree_KeyCount(idx->numeric_bt);
+  }
+  return idx->string_sl->length + idx->numeric_sl->length;
+}
+
+uint64_t Index_EntityCount(const Index *idx) {
+  return idx->entity_count;
 }
 
 //------------------------------------------------------------------------------
 // Index iterator functions
 //------------------------------------------------------------------------------
 
+IndexIter* IndexIter_FromSkiplist(skiplistIterator *sl_iter) {
+  IndexIter *iter = rm_calloc(1, sizeof(IndexIter));
+  iter->sl_iter = sl_iter;
+  return iter;
+}
+
+IndexIter* IndexIter_FromBPTree(BPTreeIterator *bt_iter) {
+  IndexIter *iter = rm_calloc(1, sizeof(IndexIter));
+  iter->bt_iter = bt_iter;
+  return iter;
+}
+
 /* Generate an iterator with no lower or upper bound. */
 IndexIter* IndexIter_Create(Index *idx, SIType type) {
+  assert(idx->type != IDX_HASH);
+  if (idx->type == IDX_BTREE) {
+    BPTree *bt = (type == T_STRING) ? idx->string_bt : idx->numeric_bt;
+    return IndexIter_FromBPTree(BPTree_IterateAll(bt));
+  }
   skiplist *sl = (type == T_STRING) ? idx->string_sl : idx->numeric_sl;
-  return skiplistIterateAll(sl);
+  return IndexIter_FromSkiplist(skiplistIterateAll(sl));
+}
+
+/* Posting lists are resolved as the iterator reaches each value,
+ * such that a reset iterator reflects updates made since its creation. */
+IndexIter* IndexIter_CreateLookup(Index *idx, const SIValue *values, uint value_count) {
+  assert(idx->type == IDX_HASH);
+  IndexIter *iter = rm_calloc(1, sizeof(IndexIter));
+  iter->hash = idx->hash;
+  iter->keys = rm_malloc(sizeof(SIValue) * value_count);
+  for (uint i = 0; i < value_count; i++) {
+    // Equal values would list the same entities twice.
+    bool duplicate = false;
+    for (uint j = 0; j < iter->key_count && !duplicate; j++) {
+      duplicate = HashIndex_KeysEqual(iter->keys + j, values + i);
+    }
+    if (!duplicate) iter->keys[iter->key_count++] = SI_Clone(values[i]);
+  }
+  return iter;
 }
 
 /* Apply a filter to an iterator, modifying the appropriate bound if
@@ -149,24 +337,64 @@ IndexIter* IndexIter_Create(Index *idx, SIType type) {
  * Returns 1 if the filter was a comparison type that can be translated into a bound
  * (effectively, any type but '!='), which indicates that it is now redundant. */
 bool IndexIter_ApplyBound(IndexIter *iter, SIValue *bound, int op) {
-  return skiplistIter_UpdateBound(iter, bound, op);
+  if (iter->bt_iter) return BPTreeIterator_UpdateBound(iter->bt_iter, bound, op);
+  if (!iter->sl_iter) return false;
+  return skiplistIter_UpdateBound(iter->sl_iter, bound, op);
+}
+
+void IndexIter_Reverse(IndexIter *iter) {
+  if (iter->sl_iter) skiplistIterate_Reverse(iter->sl_iter);
+  if (iter->bt_iter) BPTreeIterator_Reverse(iter->bt_iter);
 }
 
 NodeID* IndexIter_Next(IndexIter *iter) {
-  return skiplistIterator_Next(iter);
+  if (iter->sl_iter) return skiplistIterator_Next(iter->sl_iter);
+  if (iter->bt_iter) return BPTreeIterator_Next(iter->bt_iter);
+
+  // Advance to the next looked up value holding unvisited entities.
+  while (iter->posting_idx >= iter->posting_count) {
+    if (iter->key_idx == iter->key_count) return NULL;
+    iter->postings = HashIndex_Lookup(iter->hash, iter->keys + iter->key_idx, &iter->posting_count);
+    iter->key_idx++;
+    iter->posting_idx = 0;
+  }
+  return (NodeID*)iter->postings + iter->posting_idx++;
 }
 
 void IndexIter_Reset(IndexIter *iter) {
-  skiplistIterate_Reset(iter);
+  if (iter->sl_iter) {
+    skiplistIterate_Reset(iter->sl_iter);
+    return;
+  }
+  if (iter->bt_iter) {
+    BPTreeIterator_Reset(iter->bt_iter);
+    return;
+  }
+  iter->key_idx = 0;
+  iter->postings = NULL;
+  iter->posting_count = 0;
+  iter->posting_idx = 0;
 }
 
 void IndexIter_Free(IndexIter *iter) {
-  skiplistIterate_Free(iter);
+  if (iter->sl_iter) skiplistIterate_Free(iter->sl_iter);
+  if (iter->bt_iter) BPTreeIterator_Free(iter->bt_iter);
+  for (uint i = 0; i < iter->key_count; i++) SIValue_Free(iter->keys + i);
+  if (iter->keys) rm_free(iter->keys);
+  rm_free(iter);
 }
 
 void Index_Free(Index *idx) {
-  skiplistFree(idx->string_sl);
-  skiplistFree(idx->numeric_sl);
+  if (idx->type == IDX_HASH) {
+    HashIndex_Free(idx->hash);
+  } else if (idx->type == IDX_BTREE) {
+    BPTree_Free(idx->string_bt);
+    BPTree_Free(idx->numeric_bt);
+  } else {
+    skiplistFree(idx->string_sl);
+    skiplistFree(idx->numeric_sl);
+  }
+  if (idx->endpoints) array_free(idx->endpoints);
   rm_free(idx->label);
   rm_free(idx->attribute);
   rm_free(idx);
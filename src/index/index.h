@@ -11,30 +11,84 @@
 #include "../redismodule.h"
 #include "../graph/graph.h"
 #include "../graph/entities/graph_entity.h"
+#include "../graph/entities/edge.h"
 #include "../util/skiplist.h"
+#include "hash_index.h"
+#include "bptree.h"
 #include "../../deps/GraphBLAS/Include/GraphBLAS.h"
 
 #define INDEX_OK 1
 #define INDEX_FAIL 0
 
-typedef skiplistIterator IndexIter;
+/* Index data structure, B+tree and skiplist indices are ordered and serve both
+ * equalities and inequalities, hash indices serve equalities only.
+ * B+trees are the default, holding the same data as skiplists in a fraction of the memory,
+ * skiplists remain for indices created USING SKIPLIST and those loaded from older versions.
+ * Values are persisted, their order must not change. */
+typedef enum {
+  IDX_SKIPLIST,
+  IDX_HASH,
+  IDX_BTREE,
+} IndexType;
+
+/* Index iterators either traverse a skiplist or B+tree range,
+ * or the posting lists of a set of values looked up in a hash index. */
+typedef struct {
+  skiplistIterator *sl_iter;  // Skiplist range iterator, NULL for other index types.
+  BPTreeIterator *bt_iter;    // B+tree range iterator, NULL for other index types.
+  const HashIndex *hash;      // Looked up hash index.
+  SIValue *keys;              // Looked up values, distinct.
+  uint key_count;             // Number of looked up values.
+  uint key_idx;               // Next value to look up.
+  const NodeID *postings;     // Posting list of the current value.
+  uint64_t posting_count;     // Length of the current posting list.
+  uint64_t posting_idx;       // Next entity within the current posting list.
+} IndexIter;
+
+/* Endpoints of an indexed edge, edge entities don't hold their endpoints
+ * which would otherwise have to be looked up through the relation maps. */
+typedef struct {
+  NodeID src;
+  NodeID dest;
+} EdgeEndpoints;
 
 /* Properties are not required to be of a consistent type, and index construction
- * will store values in separate string and numeric skiplists with different comparator
- * functions if necessary.
+ * will store values in separate string and numeric B+trees (or skiplists)
+ * with different comparator functions if necessary.
  * When building Index Scan operations, the types of values described by filters will
- * specify which skiplist should be traversed. */
+ * specify which B+tree or skiplist should be traversed.
+ * Edge indices are built for a relation-property pair, their B+trees hold edge IDs.
+ * Hash indices replace both B+trees with a single hash table. */
 typedef struct {
   char *label;
   char *attribute;
   Attribute_ID attr_id;
-  skiplist *string_sl;
-  skiplist *numeric_sl;
+  IndexType type;
+  skiplist *string_sl;    // NULL for hash and B+tree indices.
+  skiplist *numeric_sl;   // NULL for hash and B+tree indices.
+  HashIndex *hash;        // NULL for range and B+tree indices.
+  BPTree *string_bt;      // NULL for range and hash indices.
+  BPTree *numeric_bt;     // NULL for range and hash indices.
+  uint64_t entity_count;  // Number of indexed entities.
+  EdgeEndpoints *endpoints; // Endpoints of indexed edges by edge ID, NULL for node indices.
 } Index;
 
 /* Index_Create builds an index for a label-property pair so that queries reliant
  * on these entities can use expedited scan logic. */
-Index* Index_Create(Graph *g, const char *label, int label_id, const char *attr_str, Attribute_ID attr_id);
+Index* Index_Create(Graph *g, const char *label, int label_id, const char *attr_str, Attribute_ID attr_id, IndexType type);
+
+/* Index_CreateEdgeIndex builds an index for a relation-property pair,
+ * populated with every edge of the relation. */
+Index* Index_CreateEdgeIndex(Graph *g, const char *relation, int relation_id, const char *attr_str, Attribute_ID attr_id, IndexType type);
+
+/* Returns true if index is built upon edges. */
+bool Index_IsEdgeIndex(const Index *idx);
+
+/* Returns true if index is a hash index. */
+bool Index_IsHashIndex(const Index *idx);
+
+/* Returns true if index can hold values of val's type. */
+bool Index_SupportsValue(const SIValue *val);
 
 /* Delete a single entity from an index if it is present. */
 void Index_DeleteNode(Index *idx, NodeID node, SIValue *val);
@@ -42,14 +96,48 @@ void Index_DeleteNode(Index *idx, NodeID node, SIValue *val);
 /* Insert a single entity into an index. */
 void Index_InsertNode(Index *idx, NodeID node, SIValue *val);
 
-/* Build a new iterator to traverse all indexed values of the specified type. */
+/* Insert a single edge into an edge index, recording its endpoints,
+ * edge's srcNodeID and destNodeID must be set. */
+void Index_InsertEdge(Index *idx, const Edge *e, SIValue *val);
+
+/* Delete a single edge from an edge index if it is present. */
+void Index_DeleteEdge(Index *idx, EdgeID edge, SIValue *val);
+
+/* Retrieves the endpoints of an indexed edge,
+ * returns false if edge isn't indexed. */
+bool Index_EdgeEndpoints(const Index *idx, EdgeID edge, NodeID *src, NodeID *dest);
+
+/* Returns the number of distinct values indexed. */
+uint64_t Index_DistinctCount(const Index *idx);
+
+/* Returns the number of indexed entities,
+ * entities holding values of types indices don't support are not counted. */
+uint64_t Index_EntityCount(const Index *idx);
+
+/* Build a new iterator to traverse all indexed values of the specified type,
+ * range and B+tree indices only. */
 IndexIter* IndexIter_Create(Index *idx, SIType type);
 
+/* Build an iterator over entities holding any of the specified values,
+ * values are cloned and looked up as the iterator advances. Hash indices only. */
+IndexIter* IndexIter_CreateLookup(Index *idx, const SIValue *values, uint value_count);
+
+/* Wrap a skiplist range iterator, which the index iterator takes ownership of. */
+IndexIter* IndexIter_FromSkiplist(skiplistIterator *sl_iter);
+
+/* Wrap a B+tree range iterator, which the index iterator takes ownership of. */
+IndexIter* IndexIter_FromBPTree(BPTreeIterator *bt_iter);
+
 /* Update the lower or upper bound of an index iterator based on a constant predicate filter
- * (if that filter represents a narrower bound than the current one). */
+ * (if that filter represents a narrower bound than the current one).
+ * Hash index lookups have no bounds to update. */
 bool IndexIter_ApplyBound(IndexIter *iter, SIValue *bound, int op);
 
-/* Returns a pointer to the next Node ID in the index, or NULL if the iterator has been depleted. */
+/* Traverse indexed values in descending order,
+ * bounds should be applied before reversing. Hash index lookups are unordered. */
+void IndexIter_Reverse(IndexIter *iter);
+
+/* Returns a pointer to the next entity ID (Node or Edge) in the index, or NULL if the iterator has been depleted. */
 GrB_Index* IndexIter_Next(IndexIter *iter);
 
 /* Reset an iterator to its original position. */
@@ -58,7 +146,7 @@ void IndexIter_Reset(IndexIter *iter);
 /* Free an index iterator. */
 void IndexIter_Free(IndexIter *iter);
 
-/* Free an index object and all its members (skiplists and strings) */
+/* Free an index object and all its members (B+trees, hash table or skiplists, and strings) */
 void Index_Free(Index *idx);
 
 #endif
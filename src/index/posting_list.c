@@ -0,0 +1,82 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "posting_list.h"
+#include <string.h>
+#include "../util/rmalloc.h"
+
+static inline bool _isPowerOf2(uint64_t n) {
+  return (n & (n - 1)) == 0;
+}
+
+// Position of the first ID in ids which is not less than id.
+static uint64_t _lowerBound(const NodeID *ids, uint64_t count, NodeID id) {
+  uint64_t lo = 0;
+  uint64_t hi = count;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    if (ids[mid] < id) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+bool PostingList_Add(PostingList *pl, NodeID id) {
+  if (pl->count == 0) {
+    pl->id = id;
+    pl->count = 1;
+    return true;
+  }
+
+  if (pl->count == 1) {
+    if (pl->id == id) return false;
+    NodeID first = pl->id;
+    pl->ids = rm_malloc(sizeof(NodeID) * 2);
+    pl->ids[0] = (first < id) ? first : id;
+    pl->ids[1] = (first < id) ? id : first;
+    pl->count = 2;
+    return true;
+  }
+
+  uint64_t pos = _lowerBound(pl->ids, pl->count, id);
+  if (pos < pl->count && pl->ids[pos] == id) return false;
+  // A full list holds a power of 2 IDs.
+  if (_isPowerOf2(pl->count)) {
+    pl->ids = rm_realloc(pl->ids, sizeof(NodeID) * pl->count * 2);
+  }
+  memmove(pl->ids + pos + 1, pl->ids + pos, sizeof(NodeID) * (pl->count - pos));
+  pl->ids[pos] = id;
+  pl->count++;
+  return true;
+}
+
+bool PostingList_Remove(PostingList *pl, NodeID id) {
+  if (pl->count == 0) return false;
+
+  if (pl->count == 1) {
+    if (pl->id != id) return false;
+    pl->count = 0;
+    return true;
+  }
+
+  uint64_t pos = _lowerBound(pl->ids, pl->count, id);
+  if (pos == pl->count || pl->ids[pos] != id) return false;
+  pl->count--;
+  memmove(pl->ids + pos, pl->ids + pos + 1, sizeof(NodeID) * (pl->count - pos));
+
+  // A single remaining ID is stored inline.
+  if (pl->count == 1) {
+    NodeID remaining = pl->ids[0];
+    rm_free(pl->ids);
+    pl->id = remaining;
+  }
+  return true;
+}
+
+void PostingList_Free(PostingList *pl) {
+  if (pl->count > 1) rm_free(pl->ids);
+  pl->count = 0;
+}
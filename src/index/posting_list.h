@@ -0,0 +1,38 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __POSTING_LIST_H__
+#define __POSTING_LIST_H__
+
+#include <stdbool.h>
+#include "../graph/entities/graph_entity.h"
+
+/* A posting list holds the sorted IDs of the entities sharing an indexed value.
+ * Unique values are common, so a single ID is stored inline,
+ * longer lists are allocated in powers of 2. */
+typedef struct {
+  uint64_t count;     // Number of IDs, 0 for an empty list.
+  union {
+    NodeID id;        // Single ID, stored inline.
+    NodeID *ids;      // Sorted IDs, when the list holds more than one.
+  };
+} PostingList;
+
+/* Adds id to list, returns false if id was already listed. */
+bool PostingList_Add(PostingList *pl, NodeID id);
+
+/* Removes id from list, returns false if id wasn't listed. */
+bool PostingList_Remove(PostingList *pl, NodeID id);
+
+/* Returns the list's IDs in ascending order, valid up until the next update. */
+static inline const NodeID* PostingList_IDs(const PostingList *pl) {
+  return (pl->count == 1) ? &pl->id : pl->ids;
+}
+
+/* Frees list's IDs, leaving it empty. */
+void PostingList_Free(PostingList *pl);
+
+#endif
@@ -14,6 +14,12 @@
 #include "util/thpool/thpool.h"
 #include "arithmetic/agg_funcs.h"
 #include "procedures/procedure.h"
+#include "schema/schema.h"
+#include "execution_plan/plan_cache.h"
+#include "execution_plan/ops/op_value_hash_join.h"
+#include "execution_plan/traverse_batch.h"
+#include "execution_plan/ops/op_aggregate.h"
+#include "execution_plan/ops/op_distinct.h"
 #include "arithmetic/arithmetic_expression.h"
 #include "graph/serializers/graphcontext_type.h"
 
@@ -92,6 +98,39 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
     if (!_Setup_ThreadPOOL(threadCount)) return REDISMODULE_ERR;
     RedisModule_Log(ctx, "notice", "Thread pool created, using %d threads.", threadCount);
 
+    if(Config_GetColumnarLayout(ctx, argv, argc)) {
+        Schema_SetColumnarLayout(true);
+        RedisModule_Log(ctx, "notice", "Storing node properties in columnar layout.");
+    }
+
+    long long queryCacheSize = Config_GetQueryCacheSize(ctx, argv, argc);
+    PlanCache_SetCapacity(queryCacheSize);
+    RedisModule_Log(ctx, "notice", "Caching up to %lld queries per graph.", queryCacheSize);
+
+    long long joinMemoryLimit = Config_GetJoinMemoryLimit(ctx, argv, argc);
+    ValueHashJoin_SetMemoryLimit(joinMemoryLimit);
+    if(joinMemoryLimit > 0) {
+        RedisModule_Log(ctx, "notice", "Joins spill to disk beyond %lld bytes.", joinMemoryLimit);
+    }
+
+    long long traverseBatchCap = Config_GetTraverseBatchCap(ctx, argv, argc);
+    TraverseBatch_SetCap(traverseBatchCap);
+    RedisModule_Log(ctx, "notice", "Traversals expand up to %lld nodes at once.", traverseBatchCap);
+
+    long long aggregateThreadCount = Config_GetAggregateThreadCount(ctx, argv, argc);
+    long long parallelAggregateThreshold = Config_GetParallelAggregateThreshold(ctx, argv, argc);
+    Aggregate_SetParallelism(aggregateThreadCount, parallelAggregateThreshold);
+    if(aggregateThreadCount > 1) {
+        RedisModule_Log(ctx, "notice", "Aggregating scans of over %lld nodes using %lld threads.",
+                        parallelAggregateThreshold, aggregateThreadCount);
+    }
+
+    long long distinctMemoryLimit = Config_GetDistinctMemoryLimit(ctx, argv, argc);
+    Distinct_SetMemoryLimit(distinctMemoryLimit);
+    if(distinctMemoryLimit > 0) {
+        RedisModule_Log(ctx, "notice", "Distinct spills to disk beyond %lld bytes.", distinctMemoryLimit);
+    }
+
     if (_RegisterDataTypes(ctx) != REDISMODULE_OK) return REDISMODULE_ERR;
 
     if(RedisModule_CreateCommand(ctx, "graph.QUERY", MGraph_Query, "write deny-oom", 1, 1, 1) == REDISMODULE_ERR) {
@@ -158,6 +158,20 @@ static AST_Validation _Validate_MATCH_Clause(const AST *ast, char **reason) {
       }
     }
 
+    if(edge->selector != N_PATH_ALL) {
+      if(edge->length && edge->length->minHops > 1) {
+        asprintf(reason, "shortestPath(...) does not support a minimal length different from 0 or 1.");
+        res = AST_INVALID;
+        break;
+      }
+      // Shortest paths only bind their endpoints.
+      if((entity->alias && !entity->anonymous) || entity->properties) {
+        asprintf(reason, "shortestPath(...) does not support relationship variables or properties.");
+        res = AST_INVALID;
+        break;
+      }
+    }
+
     char *alias = entity->alias;
     /* The query is validated before and after aliasing anonymous entities,
      * so alias may be NULL at this time. */
@@ -334,6 +348,7 @@ AST *AST_New(AST_MatchNode *matchNode, AST_WhereNode *whereNode,
   ast->callNode = callNode;
   ast->withNode = NULL;
   ast->_aliasIDMapping = NULL;
+  ast->params = NULL;
   return ast;
 }
 
@@ -507,6 +522,10 @@ bool AST_ReadOnly(AST **ast) {
   return true;
 }
 
+char **AST_Params(AST **ast) {
+  return ast[0]->params;
+}
+
 void AST_Free(AST **ast) {
   for (uint i = 0; i < array_len(ast); i++) {
     Free_AST_MatchNode(ast[i]->matchNode);
@@ -525,6 +544,10 @@ void AST_Free(AST **ast) {
     Free_AST_IndexNode(ast[i]->indexNode);
 
     if(ast[i]->_aliasIDMapping) TrieMap_Free(ast[i]->_aliasIDMapping, NULL);
+    if(ast[i]->params) {
+      for(int j = 0; j < array_len(ast[i]->params); j++) free(ast[i]->params[j]);
+      array_free(ast[i]->params);
+    }
     rm_free(ast[i]);
   }
   array_free(ast);
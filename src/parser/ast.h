@@ -35,6 +35,7 @@ typedef struct {
 	AST_WithNode *withNode;
 	AST_ProcedureCallNode *callNode;
 	TrieMap *_aliasIDMapping;	// Mapping between aliases and IDs.
+	char **params;				// Parameters referred to by query, tracked by first AST.
 } AST;
 
 AST* AST_New(AST_MatchNode *matchNode, AST_WhereNode *whereNode,
@@ -74,6 +75,9 @@ bool AST_Empty(const AST *ast);
 // Checks if AST represent a read only query.
 bool AST_ReadOnly(AST **ast);
 
+// Returns names of parameters referred to by query.
+char **AST_Params(AST **ast);
+
 void AST_Free(AST **ast);
 
 #endif
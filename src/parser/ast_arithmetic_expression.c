@@ -31,6 +31,14 @@ AST_ArithmeticExpressionNode* New_AST_AR_EXP_ConstOperandNode(SIValue constant)
 	return node;
 }
 
+AST_ArithmeticExpressionNode* New_AST_AR_EXP_ParamOperandNode(const char *param) {
+	AST_ArithmeticExpressionNode *node = rm_malloc(sizeof(AST_ArithmeticExpressionNode));
+	node->type = AST_AR_EXP_OPERAND;
+	node->operand.type = AST_AR_EXP_PARAM;
+	node->operand.param = rm_strdup(param);
+	return node;
+}
+
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_OpNode(char *func, Vector *args) {
 	AST_ArithmeticExpressionNode *node = rm_malloc(sizeof(AST_ArithmeticExpressionNode));
 	node->type = AST_AR_EXP_OP;
@@ -103,6 +111,8 @@ void Free_AST_ArithmeticExpressionNode(AST_ArithmeticExpressionNode *arExpNode)
 		if(arExpNode->operand.type == AST_AR_EXP_VARIADIC) {
 			rm_free(arExpNode->operand.variadic.alias);
 			rm_free(arExpNode->operand.variadic.property);
+		} else if(arExpNode->operand.type == AST_AR_EXP_PARAM) {
+			rm_free(arExpNode->operand.param);
 		}
 	}
 	/* Finally we can free the node. */
@@ -28,6 +28,7 @@ typedef enum {
 typedef enum {
     AST_AR_EXP_CONSTANT,
     AST_AR_EXP_VARIADIC,
+    AST_AR_EXP_PARAM,
 } AST_ArithmeticExpression_OperandNodeType;
 
 typedef struct {
@@ -36,7 +37,7 @@ typedef struct {
 } AST_ArithmeticExpressionOP;
 
 /* OperandNode represents either a constant numeric value, 
- * or a graph entity property. */
+ * a graph entity property or a query parameter. */
 typedef struct {
     union {
         SIValue constant;
@@ -44,6 +45,7 @@ typedef struct {
 			char *alias;
 			char *property;
 		} variadic;
+        char *param;    /* Parameter name. */
     };
     AST_ArithmeticExpression_OperandNodeType type;
 } AST_ArithmeticExpressionOperand;
@@ -58,6 +60,7 @@ typedef struct {
 
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_VariableOperandNode(char* alias, char *property);
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_ConstOperandNode(SIValue constant);
+AST_ArithmeticExpressionNode* New_AST_AR_EXP_ParamOperandNode(const char *param);
 AST_ArithmeticExpressionNode* New_AST_AR_EXP_OpNode(char *func, Vector *args);
 
 /* Find all the aliases in expression */
@@ -7,6 +7,8 @@
 #include "./ast_common.h"
 #include "../util/arr.h"
 #include "../value.h"
+#include "../query_params.h"
+#include <string.h>
 
 AST_Variable* New_AST_Variable(char *alias, char *property) {
 	AST_Variable *v = malloc(sizeof(AST_Variable));
@@ -40,6 +42,7 @@ static AST_LinkEntity* _AST_Clone_LinkEntity(const AST_LinkEntity *src) {
 	_AST_Clone_BaseEntity((AST_GraphEntity*)clone, (const AST_GraphEntity*)src);
 
 	clone->direction = src->direction;
+	clone->selector = src->selector;
 	
 	clone->length = NULL;
 	if(src->length) {
@@ -81,6 +84,7 @@ AST_LinkEntity* New_AST_LinkEntity(char *alias, char **labels, Vector *propertie
 	le->ge.t = N_LINK;
 	le->ge.properties = properties;
 	le->labels = NULL;
+	le->selector = N_PATH_ALL;
 
 	if(labels) {
 		le->ge.label = labels[0];
@@ -122,6 +126,7 @@ void Free_AST_GraphEntity(AST_GraphEntity *graphEntity) {
 	if(graphEntity->properties != NULL) {
 		SIValue *val;
 		while(Vector_Pop(graphEntity->properties, &val)) {
+			if(val->type == T_PTR) free(val->ptrval); // Parameter name.
 			SIValue_Free(val);
 			free(val); // SIValues in property map literals are heap-allocated
 		}
@@ -139,6 +144,23 @@ void Free_AST_GraphEntity(AST_GraphEntity *graphEntity) {
 	free(graphEntity);
 }
 
+SIValue AST_InlineParam(const char *param) {
+	return SI_PtrVal(strdup(param));
+}
+
+const char* AST_InlineValueParam(const SIValue *v) {
+	return (v->type == T_PTR) ? v->ptrval : NULL;
+}
+
+SIValue AST_InlineValue(const SIValue *v) {
+	const char *param = AST_InlineValueParam(v);
+	if(!param) return *v;
+
+	SIValue value;
+	if(!QueryParams_Get(QueryParams_Bound(), param, &value)) return SI_NullVal();
+	return value;
+}
+
 void Free_AST_Variable(AST_Variable *v) {
 	if(v != NULL) {
 		if(v->alias != NULL) free(v->alias);
@@ -8,6 +8,7 @@
 #define _AST_COMMON_H
 
 #include <stdbool.h>
+#include "../value.h"
 #include "../util/vector.h"
 
 typedef enum {
@@ -22,10 +23,16 @@ typedef enum {
 	N_DIR_UNKNOWN,
 } AST_LinkDirection;
 
+typedef enum {
+	N_PATH_ALL,				// Every path matching the pattern.
+	N_PATH_SHORTEST,		// shortestPath, a single shortest path.
+	N_PATH_ALL_SHORTEST,	// allShortestPaths, every shortest path.
+} AST_PathSelector;
+
 typedef struct {
 	char *alias;			// Alias given to entity.
 	char *label;			// Label of entity.
-	Vector *properties;		// Array of attributes.
+	Vector *properties;		// Array of attributes, key value pairs of SIValue pointers.
 	AST_GraphEntityType t;	// Type of entity.
 	bool anonymous;			// Entity isn't referenced.
 } AST_GraphEntity;
@@ -47,6 +54,7 @@ typedef struct {
 	AST_LinkDirection direction;
 	AST_LinkLength *length;			// NULL If edge is of length 1.
 	char **labels;
+	AST_PathSelector selector;		// Paths matched by link.
 } AST_LinkEntity;
 
 AST_NodeEntity* New_AST_NodeEntity(char *alias, char *label, Vector *properties);
@@ -59,5 +67,17 @@ int AST_LinkEntity_LabelCount(const AST_LinkEntity* edge);
 void Free_AST_GraphEntity(AST_GraphEntity *entity);
 void Free_AST_Variable(AST_Variable *v);
 
+/* Inline property maps hold constants, a query parameter ({name: $p})
+ * is held as a pointer value referring to a copy of the parameter's name. */
+SIValue AST_InlineParam(const char *param);
+
+/* Returns the parameter name of an inline property value,
+ * NULL if the value is a constant. */
+const char* AST_InlineValueParam(const SIValue *v);
+
+/* Resolves an inline property value, parameters are read
+ * from the bound query parameters and are NULL if missing. */
+SIValue AST_InlineValue(const SIValue *v);
+
 #endif
 
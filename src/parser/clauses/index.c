@@ -1,16 +1,21 @@
 #include "./index.h"
 #include "../ast_common.h"
+#include "../../util/arr.h"
 
-AST_IndexNode* New_AST_IndexNode(const char *label, const char *property, AST_IndexOpType optype) {
+AST_IndexNode* New_AST_IndexNode(const char *label, char **properties, AST_GraphEntityType entity_type,
+                                 AST_IndexOpType optype, AST_IndexType index_type) {
   AST_IndexNode *indexOp = malloc(sizeof(AST_IndexNode));
   indexOp->label = label;
-  indexOp->property = property;
+  indexOp->properties = properties;
+  indexOp->entity_type = entity_type;
   indexOp->operation = optype;
+  indexOp->index_type = index_type;
   return indexOp;
 }
 
 void Free_AST_IndexNode(AST_IndexNode *indexNode) {
   if(indexNode != NULL) {
+    array_free(indexNode->properties);
     free(indexNode);
   }
 }
@@ -1,18 +1,29 @@
 #ifndef _CLAUSE_INDEX_H
 #define _CLAUSE_INDEX_H
 
+#include "../ast_common.h"
+
 typedef enum {
   DROP_INDEX,
   CREATE_INDEX
 } AST_IndexOpType;
 
+typedef enum {
+  BTREE_INDEX,
+  HASH_INDEX,
+  SKIPLIST_INDEX
+} AST_IndexType;
+
 typedef struct {
   const char *label;
-  const char *property;
+  char **properties;  // Indexed properties, more than one for a composite index.
+  AST_GraphEntityType entity_type; // N_ENTITY for a label index, N_LINK for a relationship type index.
   AST_IndexOpType operation;
+  AST_IndexType index_type; // Index data structure, BTREE_INDEX unless created USING HASH or SKIPLIST.
 } AST_IndexNode;
 
-AST_IndexNode* New_AST_IndexNode(const char *label, const char *property, AST_IndexOpType optype);
+AST_IndexNode* New_AST_IndexNode(const char *label, char **properties, AST_GraphEntityType entity_type,
+                                 AST_IndexOpType optype, AST_IndexType index_type);
 void Free_AST_IndexNode(AST_IndexNode *indexNode);
 
 #endif
@@ -5,15 +5,35 @@
 */
 
 #include "./limit.h"
+#include "../../query_params.h"
+#include <string.h>
 
 AST_LimitNode* New_AST_LimitNode(int limit) {
 	AST_LimitNode* limitNode = (AST_LimitNode*)malloc(sizeof(AST_LimitNode));
 	limitNode->limit = limit;
+	limitNode->param = NULL;
 	return limitNode;
 }
 
+AST_LimitNode* New_AST_LimitParamNode(const char *param) {
+	AST_LimitNode* limitNode = New_AST_LimitNode(0);
+	limitNode->param = strdup(param);
+	return limitNode;
+}
+
+unsigned int AST_LimitNode_Value(const AST_LimitNode *limitNode) {
+	if(!limitNode->param) return limitNode->limit;
+
+	// Parameter values are validated before execution.
+	SIValue v;
+	if(!QueryParams_Get(QueryParams_Bound(), limitNode->param, &v)) return 0;
+	if(v.type != T_INT64 || v.longval < 0) return 0;
+	return v.longval;
+}
+
 void Free_AST_LimitNode(AST_LimitNode* limitNode) {
 	if(limitNode) {
+		free(limitNode->param);
 		free(limitNode);
 	}
 }
@@ -10,10 +10,14 @@
 #include "../../util/vector.h"
 
 typedef struct {
-	int limit;
+	int limit;		// Constant limit, 0 when read from a parameter.
+	char *param;	// Parameter limit is read from, NULL if constant.
 } AST_LimitNode;
 
 AST_LimitNode* New_AST_LimitNode(int limit);
+AST_LimitNode* New_AST_LimitParamNode(const char *param);
+/* Returns limit, parameters are read from the bound query parameters. */
+unsigned int AST_LimitNode_Value(const AST_LimitNode *limitNode);
 void Free_AST_LimitNode(AST_LimitNode *limitNode);
 
 #endif
@@ -5,13 +5,35 @@
 */
 
 #include "./skip.h"
+#include "../../query_params.h"
+#include <string.h>
 
 AST_SkipNode* New_AST_SkipNode(size_t n) {
     AST_SkipNode* skipNode = malloc(sizeof(AST_SkipNode));
     skipNode->skip = n;
+    skipNode->param = NULL;
     return skipNode;
 }
 
+AST_SkipNode* New_AST_SkipParamNode(const char *param) {
+    AST_SkipNode* skipNode = New_AST_SkipNode(0);
+    skipNode->param = strdup(param);
+    return skipNode;
+}
+
+size_t AST_SkipNode_Value(const AST_SkipNode *skipNode) {
+    if(!skipNode->param) return skipNode->skip;
+
+    // Parameter values are validated before execution.
+    SIValue v;
+    if(!QueryParams_Get(QueryParams_Bound(), skipNode->param, &v)) return 0;
+    if(v.type != T_INT64 || v.longval < 0) return 0;
+    return v.longval;
+}
+
 void Free_AST_SkipNode(AST_SkipNode *skipNode) {
-    if(skipNode) free(skipNode);
+    if(skipNode) {
+        free(skipNode->param);
+        free(skipNode);
+    }
 }
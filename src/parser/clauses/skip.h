@@ -10,10 +10,15 @@
 #include <stdlib.h>
 
 typedef struct {
-	size_t skip; // Number of records to skip.
+	size_t skip; // Number of records to skip, 0 when read from a parameter.
+	char *param; // Parameter skip is read from, NULL if constant.
 } AST_SkipNode;
 
 AST_SkipNode* New_AST_SkipNode(size_t n);
+AST_SkipNode* New_AST_SkipParamNode(const char *param);
+/* Returns the number of records to skip,
+ * parameters are read from the bound query parameters. */
+size_t AST_SkipNode_Value(const AST_SkipNode *skipNode);
 void Free_AST_SkipNode(AST_SkipNode *skipNode);
 
 #endif
@@ -31,6 +31,7 @@
 	#include <stdint.h>
 	#include <assert.h>
 	#include <limits.h>
+	#include <strings.h>
 	#include "token.h"	
 	#include "grammar.h"
 	#include "ast.h"
@@ -47,7 +48,7 @@
 	*/
 	// Increase depth from 100 to 1000 to handel deep recursion.
 	#define YYSTACKDEPTH 1000
-#line 51 "grammar.c"
+#line 52 "grammar.c"
 /**************** End of %include directives **********************************/
 /* These constants specify the various numeric values for terminal symbols
 ** in a format understandable to "makeheaders".  This section is blank unless
@@ -109,45 +110,46 @@
 #endif
 /************* Begin control #defines *****************************************/
 #define YYCODETYPE unsigned char
-#define YYNOCODE 109
+#define YYNOCODE 114
 #define YYACTIONTYPE unsigned short int
 #define ParseTOKENTYPE Token
 typedef union {
   int yyinit;
   ParseTOKENTYPE yy0;
-  AST_WhereNode* yy3;
-  AST_CreateNode* yy4;
-  char** yy5;
-  int yy6;
-  AST_FilterNode* yy10;
-  AST* yy31;
-  AST_LimitNode* yy39;
-  AST_SetNode* yy44;
-  AST_DeleteNode * yy47;
-  AST_LinkEntity* yy69;
-  AST_UnwindNode* yy97;
-  AST_WithElementNode* yy98;
-  AST_WithElementNode** yy112;
-  AST_NodeEntity* yy117;
-  AST_ReturnNode* yy120;
-  AST** yy121;
-  AST_ReturnElementNode** yy122;
-  char* yy129;
-  AST_LinkLength* yy138;
-  AST_ReturnElementNode* yy139;
-  AST_SkipNode* yy147;
+  AST_WithElementNode* yy14;
+  AST_LimitNode* yy19;
+  AST_ReturnElementNode* yy26;
+  AST* yy27;
+  AST_LinkEntity* yy37;
+  AST_SetNode* yy46;
+  AST_IndexType yy47;
+  AST_IndexOpType yy49;
+  AST_LinkLength* yy50;
+  AST_IndexNode* yy58;
+  AST_DeleteNode * yy59;
+  Vector* yy60;
+  AST_UnwindNode* yy63;
+  AST** yy65;
+  AST_SkipNode* yy71;
+  AST_WhereNode* yy81;
+  int yy86;
+  AST_ArithmeticExpressionNode* yy90;
+  AST_Variable* yy92;
+  AST_SetElement* yy96;
+  AST_ReturnNode* yy98;
+  AST_ProcedureCallNode* yy111;
+  AST_MatchNode* yy119;
+  char** yy145;
   SIValue yy150;
-  AST_ArithmeticExpressionNode* yy154;
-  AST_Variable* yy156;
-  AST_ProcedureCallNode* yy157;
-  AST_MergeNode* yy164;
-  AST_WithNode* yy168;
-  AST_IndexNode* yy169;
-  AST_SetElement* yy170;
-  AST_MatchNode* yy173;
-  AST_IndexOpType yy177;
-  AST_OrderNode* yy196;
-  Vector* yy210;
+  AST_CreateNode* yy154;
+  AST_OrderNode* yy160;
+  AST_MergeNode* yy166;
+  AST_ReturnElementNode** yy168;
+  AST_NodeEntity* yy181;
+  AST_FilterNode* yy190;
+  AST_WithNode* yy210;
+  char* yy219;
+  AST_WithElementNode** yy224;
 } YYMINORTYPE;
 #ifndef YYSTACKDEPTH
 #define YYSTACKDEPTH 100
@@ -156,17 +158,17 @@ typedef union {
 #define ParseARG_PDECL , parseCtx *ctx 
 #define ParseARG_FETCH  parseCtx *ctx  = yypParser->ctx 
 #define ParseARG_STORE yypParser->ctx  = ctx 
-#define YYNSTATE             164
-#define YYNRULE              139
-#define YYNTOKEN             55
-#define YY_MAX_SHIFT         163
-#define YY_MIN_SHIFTREDUCE   258
-#define YY_MAX_SHIFTREDUCE   396
-#define YY_ERROR_ACTION      397
-#define YY_ACCEPT_ACTION     398
-#define YY_NO_ACTION         399
-#define YY_MIN_REDUCE        400
-#define YY_MAX_REDUCE        538
+#define YYNSTATE             184
+#define YYNRULE              152
+#define YYNTOKEN             56
+#define YY_MAX_SHIFT         183
+#define YY_MIN_SHIFTREDUCE   289
+#define YY_MAX_SHIFTREDUCE   440
+#define YY_ERROR_ACTION      441
+#define YY_ACCEPT_ACTION     442
+#define YY_NO_ACTION         443
+#define YY_MIN_REDUCE        444
+#define YY_MAX_REDUCE        595
 /************* End control #defines *******************************************/
 
 /* Define the yytestcase() macro to be a no-op if is not already defined
@@ -232,161 +234,173 @@ typedef union {
 **  yy_default[]       Default action for each state.
 **
 *********** Begin parsing tables **********************************************/
-#define YY_ACTTAB_COUNT (441)
+#define YY_ACTTAB_COUNT (476)
 static const YYACTIONTYPE yy_action[] = {
- /*     0 */   403,   17,  402,   32,   95,   42,   91,   98,   96,   88,
- /*    10 */   146,  416,   16,  418,   66,   15,   41,   43,  510,   99,
- /*    20 */    56,  437,  455,   79,  442,  125,  398,   51,  401,  509,
- /*    30 */   156,  452,  155,  421,  117,  500,  129,   88,   44,  416,
- /*    40 */    16,  418,   66,   15,   73,   29,   34,   71,   56,  437,
- /*    50 */    76,   79,  442,  125,   29,   28,  111,  351,  305,   27,
- /*    60 */    33,  516,  516,   11,  485,   24,  154,  134,  391,  113,
- /*    70 */    69,    8,   10,    2,  510,   99,  290,  163,   76,  510,
- /*    80 */   100,  157,  158,  120,  346,  509,  389,  111,  352,    2,
- /*    90 */   509,  501,    3,  161,  496,   30,   24,  126,  158,  391,
- /*   100 */   113,   31,   89,  392,  394,  395,  396,   23,   22,   21,
- /*   110 */    20,  383,  384,  387,  385,  386,  142,  389,  361,   23,
- /*   120 */    22,   21,   20,  383,  384,  387,  385,  386,  408,  111,
- /*   130 */   409,  410,  510,  100,  392,  394,  395,  396,   24,  111,
- /*   140 */   128,  391,  113,  509,  292,  293,  159,  496,    9,   68,
- /*   150 */    78,  391,  113,  111,  388,  417,   83,  413,   93,  389,
- /*   160 */    87,   23,   22,   21,   20,  391,  388,   79,  442,  389,
- /*   170 */   510,  100,   79,  442,   30,   50,  392,  394,  395,  396,
- /*   180 */   455,  509,   34,  389,  127,  495,  392,  394,  395,  396,
- /*   190 */    29,   28,    2,   70,  305,  135,   33,  510,  105,  116,
- /*   200 */   392,  394,  395,  396,   23,   22,   21,   20,  509,    2,
- /*   210 */    23,   22,   21,   20,  145,  108,  510,   38,  400,  120,
- /*   220 */   134,  361,  510,   37,    1,  510,   38,  509,  131,  510,
- /*   230 */    38,   76,  123,  509,  106,  110,  509,  489,   61,   65,
- /*   240 */   509,  109,  160,  510,  105,  445,  510,  105,  121,   56,
- /*   250 */   437,  510,  102,   45,  509,  453,  155,  509,  510,  103,
- /*   260 */     4,  112,  509,   71,  107,   23,   22,   21,   20,  509,
- /*   270 */   150,  510,  104,  510,  507,  510,  506,  510,  114,  510,
- /*   280 */   115,   76,  509,   40,  509,  366,  509,   19,  509,   19,
- /*   290 */   509,  510,  101,   72,   31,   89,   47,  473,   19,   13,
- /*   300 */   136,  119,  509,   48,  473,  162,    2,  151,  130,   49,
- /*   310 */   390,  163,  288,   46,   46,  516,  516,  144,  455,  455,
- /*   320 */    52,  292,  293,    8,   10,  376,  377,  393,   76,  139,
- /*   330 */   137,   21,   20,   29,  438,  158,  425,  157,   57,   58,
- /*   340 */   163,    2,   59,   11,  424,   62,   60,   63,   64,   25,
- /*   350 */    31,  422,   67,  420,  132,   76,  134,  133,  474,  110,
- /*   360 */   140,  141,  147,   30,  143,   81,  415,   80,    5,   84,
- /*   370 */    82,  484,  148,  411,   85,  149,  443,   86,  318,   26,
- /*   380 */   405,   90,  360,  407,  456,   92,    6,  382,   94,  118,
- /*   390 */    97,  153,  406,  404,    7,  306,  307,  122,   53,  124,
- /*   400 */   289,   54,  291,   55,   10,   35,  328,  325,  330,  323,
- /*   410 */   336,  329,  321,  327,   74,  322,   77,  334,   75,   39,
- /*   420 */   320,  326,  324,  138,  319,   18,  152,  356,  162,  340,
- /*   430 */    36,   12,  373,  399,  399,  399,  399,  399,  379,  381,
- /*   440 */    14,
+ /*     0 */   447,   18,  446,   34,  103,   43,   99,   69,   73,   96,
+ /*    10 */   142,  460,   17,  462,   74,   15,  565,  107,   64,  481,
+ /*    20 */    64,  481,  442,   55,  445,  173,  563,   87,  490,  465,
+ /*    30 */   141,  128,  554,   96,   31,  460,   17,  462,   74,   15,
+ /*    40 */    42,   36,   32,   97,   64,  481,  565,  110,  321,   16,
+ /*    50 */    30,   87,  490,   31,  141,  343,  563,   35,  571,  571,
+ /*    60 */    91,  457,  122,  392,   95,   24,   23,   22,   21,    2,
+ /*    70 */   160,   25,    2,  183,  435,  124,  402,  120,  121,  131,
+ /*    80 */    87,  490,   24,   23,   22,   21,  427,  428,  431,  429,
+ /*    90 */   430,  122,  433,  402,   80,   29,  182,   51,  525,    3,
+ /*   100 */    25,   50,  507,  435,  124,  152,  170,  565,  107,  152,
+ /*   110 */   436,  438,  439,  440,   84,  122,  393,  563,   84,  101,
+ /*   120 */   122,  433,   42,  555,   25,  182,  147,  435,  124,    9,
+ /*   130 */   432,   86,  435,  124,  565,  108,  145,   16,   46,  436,
+ /*   140 */   438,  439,  440,   57,  563,  433,  132,  180,  550,  182,
+ /*   150 */   433,  485,   49,  507,  182,  122,   11,  539,  119,   24,
+ /*   160 */    23,   22,   21,  436,  438,  439,  440,  435,  436,  438,
+ /*   170 */   439,  440,   24,   23,   22,   21,  427,  428,  431,  429,
+ /*   180 */   430,  165,  537,   36,  154,  433,   79,   52,  525,  164,
+ /*   190 */    20,   16,   30,   24,   23,   22,   21,  343,  127,   35,
+ /*   200 */   565,  108,  143,  436,  438,  439,  440,  565,  113,   79,
+ /*   210 */   563,    2,   84,  178,  550,  106,  104,  563,  418,  419,
+ /*   220 */   432,  131,   32,   97,  116,  565,   40,   20,  565,   39,
+ /*   230 */   565,   40,  179,    2,  130,  563,  149,  139,  563,  114,
+ /*   240 */   563,  543,   62,  565,   40,  565,  108,  175,  504,  174,
+ /*   250 */   565,  113,    1,  563,  118,  563,  565,  113,   81,  549,
+ /*   260 */   563,  148,  484,   49,  507,   76,  563,  123,   78,  565,
+ /*   270 */   111,  461,  138,  115,    2,   24,   23,   22,   21,  563,
+ /*   280 */   144,  565,  112,  121,  323,  324,   77,   87,  490,  565,
+ /*   290 */   561,  563,  565,  560,  565,  125,  153,  565,  126,  563,
+ /*   300 */   565,  109,  563,  452,  563,  453,  454,  563,   53,  183,
+ /*   310 */   563,    8,   10,  571,  571,   44,  507,  444,  162,   54,
+ /*   320 */   507,  505,  174,  169,  387,  323,  324,   84,  434,   58,
+ /*   330 */    22,   21,   84,  137,    8,   10,  157,  155,  421,  424,
+ /*   340 */   407,   13,  176,  177,   20,  163,  437,  181,  494,  132,
+ /*   350 */   136,  493,  345,  117,   47,  319,   41,  146,   48,  482,
+ /*   360 */     4,   16,  121,  469,  120,   65,   66,  183,   68,    2,
+ /*   370 */    67,   11,  468,   70,   32,   26,   84,   71,   72,  152,
+ /*   380 */   150,  151,  466,   75,  464,  119,  526,  158,  159,  166,
+ /*   390 */   161,  536,  508,  167,   31,  168,   89,  459,   88,    5,
+ /*   400 */    92,   90,  357,  401,  426,  455,   98,  491,   93,  100,
+ /*   410 */    94,   27,  451,    6,    7,  449,  129,  102,  344,  450,
+ /*   420 */   448,  172,  105,   56,  133,  134,   45,  135,  346,   59,
+ /*   430 */   341,  320,  140,   60,  322,   61,   10,  332,   63,   28,
+ /*   440 */   364,  369,  375,  379,  367,  368,  362,  360,  373,   83,
+ /*   450 */    14,  366,   82,  365,  361,  383,  359,   33,   85,   19,
+ /*   460 */   363,   37,  156,  358,  181,  171,   38,  422,  443,  443,
+ /*   470 */   425,  443,   12,  397,  415,  409,
 };
 static const YYCODETYPE yy_lookahead[] = {
- /*     0 */    58,  102,   60,   61,   62,   63,   64,   62,   63,   67,
- /*    10 */   100,   69,   70,   71,   72,   73,   13,   86,   89,   90,
- /*    20 */    78,   79,   91,   81,   82,   83,   56,   57,   58,  100,
- /*    30 */    87,   88,   89,   63,  105,  106,   74,   67,   76,   69,
- /*    40 */    70,   71,   72,   73,    4,   20,   12,   33,   78,   79,
- /*    50 */    36,   81,   82,   83,   20,   21,    4,    5,   24,   17,
- /*    60 */    26,   27,   28,   38,   39,   13,   17,   25,   16,   17,
- /*    70 */    30,    1,    2,   39,   89,   90,   17,   43,   36,   89,
- /*    80 */    90,   47,   48,   49,   14,  100,   34,    4,    5,   39,
- /*    90 */   100,  106,   40,  103,  104,   21,   13,   77,   48,   16,
- /*   100 */    17,   27,   28,   51,   52,   53,   54,    3,    4,    5,
- /*   110 */     6,    7,    8,    9,   10,   11,   94,   34,   14,    3,
- /*   120 */     4,    5,    6,    7,    8,    9,   10,   11,   63,    4,
- /*   130 */    65,   66,   89,   90,   51,   52,   53,   54,   13,    4,
- /*   140 */    14,   16,   17,  100,   18,   19,  103,  104,   13,   63,
- /*   150 */    92,   16,   17,    4,   50,   69,   65,   66,   64,   34,
- /*   160 */    69,    3,    4,    5,    6,   16,   50,   81,   82,   34,
- /*   170 */    89,   90,   81,   82,   21,   86,   51,   52,   53,   54,
- /*   180 */    91,  100,   12,   34,   77,  104,   51,   52,   53,   54,
- /*   190 */    20,   21,   39,   96,   24,   94,   26,   89,   90,   41,
- /*   200 */    51,   52,   53,   54,    3,    4,    5,    6,  100,   39,
- /*   210 */     3,    4,    5,    6,   94,  107,   89,   90,    0,   49,
- /*   220 */    25,   14,   89,   90,   59,   89,   90,  100,  101,   89,
- /*   230 */    90,   36,   13,  100,  101,    5,  100,  101,   67,   68,
- /*   240 */   100,  101,   41,   89,   90,   85,   89,   90,   25,   78,
- /*   250 */    79,   89,   90,   76,  100,   88,   89,  100,   89,   90,
- /*   260 */    42,  107,  100,   33,  107,    3,    4,    5,    6,  100,
- /*   270 */    25,   89,   90,   89,   90,   89,   90,   89,   90,   89,
- /*   280 */    90,   36,  100,   75,  100,   14,  100,   18,  100,   18,
- /*   290 */   100,   89,   90,   94,   27,   28,   97,   98,   18,   13,
- /*   300 */    94,   32,  100,   97,   98,   19,   39,   80,   80,   17,
- /*   310 */    34,   43,   16,   86,   86,   47,   48,   25,   91,   91,
- /*   320 */    84,   18,   19,    1,    2,   45,   46,   51,   36,   34,
- /*   330 */    35,    5,    6,   20,   79,   48,   62,   47,   61,   64,
- /*   340 */    43,   39,   63,   38,   62,   61,   68,   64,   63,   31,
- /*   350 */    27,   62,   61,   65,   95,   36,   25,   94,   98,    5,
- /*   360 */    96,   95,   17,   21,   94,   64,   62,   61,   68,   61,
- /*   370 */    63,   99,   99,   62,   64,   94,   82,   63,   17,   62,
- /*   380 */    64,   61,   17,   62,   91,   61,   18,   17,   63,   41,
- /*   390 */    63,   93,   64,   64,   31,   17,   14,   17,   23,   22,
- /*   400 */    16,   15,   17,   13,    2,   18,   32,    4,   17,   14,
- /*   410 */    34,   32,   14,   32,   17,   14,   17,   34,   18,   25,
- /*   420 */    14,   32,   29,   35,   17,    7,   18,   17,   19,   37,
- /*   430 */    18,   18,   17,  108,  108,  108,  108,  108,   34,   34,
- /*   440 */    44,  108,  108,  108,  108,  108,  108,  108,  108,  108,
- /*   450 */   108,  108,  108,  108,  108,  108,  108,  108,  108,  108,
- /*   460 */   108,  108,  108,  108,  108,  108,  108,  108,  108,  108,
- /*   470 */   108,  108,  108,  108,  108,  108,  108,  108,  108,  108,
- /*   480 */   108,  108,  108,  108,  108,  108,  108,  108,  108,  108,
- /*   490 */   108,  108,  108,  108,  108,  108,
+ /*     0 */    59,  107,   61,   62,   63,   64,   65,   68,   69,   68,
+ /*    10 */    78,   70,   71,   72,   73,   74,   95,   96,   79,   80,
+ /*    20 */    79,   80,   57,   58,   59,   17,  105,   86,   87,   64,
+ /*    30 */    89,  110,  111,   68,   21,   70,   71,   72,   73,   74,
+ /*    40 */    13,   12,   29,   30,   79,   80,   95,   96,   17,   20,
+ /*    50 */    21,   86,   87,   21,   89,   26,  105,   28,   29,   30,
+ /*    60 */    66,   67,    4,    5,   70,    3,    4,    5,    6,   40,
+ /*    70 */    98,   13,   40,   44,   16,   17,   14,   48,   49,   50,
+ /*    80 */    86,   87,    3,    4,    5,    6,    7,    8,    9,   10,
+ /*    90 */    11,    4,   34,   14,   98,   17,   38,  101,  102,   41,
+ /*   100 */    13,   83,   84,   16,   17,   27,   88,   95,   96,   27,
+ /*   110 */    52,   53,   54,   55,   36,    4,    5,  105,   36,   65,
+ /*   120 */     4,   34,   13,  111,   13,   38,   17,   16,   17,   13,
+ /*   130 */    51,   85,   16,   17,   95,   96,   75,   20,   77,   52,
+ /*   140 */    53,   54,   55,   24,  105,   34,   27,  108,  109,   38,
+ /*   150 */    34,   82,   83,   84,   38,    4,   39,   40,    5,    3,
+ /*   160 */     4,    5,    6,   52,   53,   54,   55,   16,   52,   53,
+ /*   170 */    54,   55,    3,    4,    5,    6,    7,    8,    9,   10,
+ /*   180 */    11,  104,  105,   12,   98,   34,   33,  101,  102,   38,
+ /*   190 */    18,   20,   21,    3,    4,    5,    6,   26,   42,   28,
+ /*   200 */    95,   96,   78,   52,   53,   54,   55,   95,   96,   33,
+ /*   210 */   105,   40,   36,  108,  109,   63,   64,  105,   46,   47,
+ /*   220 */    51,   50,   29,   30,  112,   95,   96,   18,   95,   96,
+ /*   230 */    95,   96,   42,   40,   25,  105,  106,   90,  105,  106,
+ /*   240 */   105,  106,   85,   95,   96,   95,   96,   93,   94,   95,
+ /*   250 */    95,   96,   60,  105,  106,  105,   95,   96,    4,  109,
+ /*   260 */   105,   81,   82,   83,   84,   64,  105,  112,  100,   95,
+ /*   270 */    96,   70,   17,  112,   40,    3,    4,    5,    6,  105,
+ /*   280 */    14,   95,   96,   49,   18,   19,   32,   86,   87,   95,
+ /*   290 */    96,  105,   95,   96,   95,   96,   98,   95,   96,  105,
+ /*   300 */    95,   96,  105,   64,  105,   66,   67,  105,   17,   44,
+ /*   310 */   105,    1,    2,   48,   49,   83,   84,    0,   27,   83,
+ /*   320 */    84,   94,   95,   27,   14,   18,   19,   36,   34,   14,
+ /*   330 */     5,    6,   36,   18,    1,    2,   34,   35,   34,   34,
+ /*   340 */    14,   13,   38,   38,   18,   98,   52,   19,   92,   27,
+ /*   350 */    90,   92,   17,   91,   77,   16,   76,   84,   84,   80,
+ /*   360 */    43,   20,   49,   63,   48,   62,   65,   44,   69,   40,
+ /*   370 */    64,   39,   63,   62,   29,   24,   36,   65,   64,   27,
+ /*   380 */    99,   98,   63,   62,   66,    5,  102,  100,   99,   17,
+ /*   390 */    98,  103,   84,  103,   21,   98,   65,   63,   62,   69,
+ /*   400 */    62,   64,   17,   17,   17,   63,   62,   87,   65,   62,
+ /*   410 */    64,   63,   63,   18,   24,   65,   42,   64,   17,   65,
+ /*   420 */    65,   97,   64,   14,   17,   13,   23,   25,   17,   13,
+ /*   430 */    17,   16,   22,   15,   17,   13,    2,   14,   13,   18,
+ /*   440 */     4,   17,   34,   37,   25,   25,   14,   14,   34,   18,
+ /*   450 */    45,   25,   17,   25,   14,   17,   14,   27,   17,    7,
+ /*   460 */    31,   18,   35,   17,   19,   18,   18,   17,  113,  113,
+ /*   470 */    17,  113,   18,   17,   17,   17,  113,  113,  113,  113,
+ /*   480 */   113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+ /*   490 */   113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+ /*   500 */   113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+ /*   510 */   113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+ /*   520 */   113,  113,  113,  113,  113,  113,  113,  113,  113,  113,
+ /*   530 */   113,  113,
 };
-#define YY_SHIFT_COUNT    (163)
+#define YY_SHIFT_COUNT    (183)
 #define YY_SHIFT_MIN      (0)
-#define YY_SHIFT_MAX      (418)
+#define YY_SHIFT_MAX      (458)
 static const unsigned short int yy_shift_ofst[] = {
- /*     0 */   170,   34,   52,   83,  125,   74,  125,  125,  135,  135,
- /*    10 */   135,  135,  125,  125,  125,   25,  153,  125,  125,  125,
- /*    20 */   125,  125,  125,  125,  125,   42,  267,  195,    3,    3,
- /*    30 */     3,   49,   50,    3,   59,    3,   49,  104,  116,  149,
- /*    40 */   126,  292,  268,   40,  303,  303,   40,  230,   14,  245,
- /*    50 */    40,  218,  219,  223,   59,  296,  313,  287,  290,  297,
- /*    60 */   302,  305,  287,  290,  297,  302,  323,  287,  290,  318,
- /*    70 */   319,  331,  354,  318,  319,  345,  345,  319,    3,  342,
- /*    80 */   287,  290,  297,  302,  287,  290,  297,  302,  305,  361,
- /*    90 */   287,  290,  287,  290,  297,  302,  297,  297,  302,  158,
- /*   100 */   201,  207,  262,  262,  262,  262,   70,  280,  269,  322,
- /*   110 */   295,  276,  271,  286,  326,  326,  365,  368,  370,  348,
- /*   120 */   363,  378,  382,  380,  375,  377,  384,  385,  386,  390,
- /*   130 */   387,  402,  403,  374,  391,  379,  381,  376,  383,  388,
- /*   140 */   389,  393,  395,  398,  397,  401,  400,  394,  392,  406,
- /*   150 */   399,  387,  407,  408,  409,  418,  412,  404,  405,  413,
- /*   160 */   410,  413,  415,  396,
+ /*     0 */   171,   29,   58,  111,   87,   13,   87,   87,  116,  116,
+ /*    10 */   116,  116,   87,   87,   87,  117,  109,   32,   87,   87,
+ /*    20 */    87,   87,   87,   87,   87,   87,   78,  193,  109,   82,
+ /*    30 */    27,   27,    8,  151,  234,   27,   31,   27,    8,   79,
+ /*    40 */   169,  266,  291,  265,  254,  119,  307,  307,  254,  254,
+ /*    50 */   254,  153,  176,  296,  254,  317,  255,  322,  255,  335,
+ /*    60 */    31,  339,   27,   27,  341,  313,  316,  323,  329,  332,
+ /*    70 */   313,  316,  323,  329,  345,  313,  316,  351,  340,  352,
+ /*    80 */   380,  351,  340,  372,  372,  340,   27,  373,  313,  316,
+ /*    90 */   323,  329,  313,  316,  323,  329,  332,  385,  313,  316,
+ /*   100 */   313,  316,  323,  329,  323,  323,  329,  156,  190,   62,
+ /*   110 */   272,  272,  272,  272,  310,  172,  209,  315,  333,  302,
+ /*   120 */   304,  305,  294,  326,  328,  325,  325,  386,  395,  387,
+ /*   130 */   374,  390,  401,  409,  407,  412,  402,  411,  413,  416,
+ /*   140 */   403,  410,  415,  417,  418,  422,  423,  425,  421,  434,
+ /*   150 */   436,  419,  424,  420,  426,  408,  414,  427,  428,  429,
+ /*   160 */   432,  433,  435,  440,  438,  431,  430,  406,  442,  441,
+ /*   170 */   443,  446,  447,  445,  452,  448,  450,  453,  454,  456,
+ /*   180 */   454,  457,  458,  405,
 };
-#define YY_REDUCE_COUNT (98)
-#define YY_REDUCE_MIN   (-101)
-#define YY_REDUCE_MAX   (329)
+#define YY_REDUCE_COUNT (106)
+#define YY_REDUCE_MIN   (-106)
+#define YY_REDUCE_MAX   (358)
 static const short yy_reduce_ofst[] = {
- /*     0 */   -30,  -58,  -10,   43,  -71,   91,  -15,  108,  127,  133,
- /*    10 */   136,  140,   81,  154,  157,  171,   86,  162,  169,  182,
- /*    20 */   184,  186,  188,  190,  202,  199,   65,  206,  227,  228,
- /*    30 */   227,  -57,  -55,  -69,  -38,   89,  167, -101, -101,  -90,
- /*    40 */    20,   22,   94,   58,  107,  107,   58,   97,  101,  120,
- /*    50 */    58,  165,  160,  236,  177,  208,  255,  274,  277,  275,
- /*    60 */   279,  278,  282,  284,  283,  285,  288,  289,  291,  259,
- /*    70 */   263,  260,  264,  266,  270,  272,  273,  281,  293,  294,
- /*    80 */   304,  306,  301,  307,  311,  308,  310,  314,  300,  298,
- /*    90 */   317,  320,  321,  324,  316,  325,  328,  329,  327,
+ /*     0 */   -35,  -59,   39,  105,  -79,   -6,   12,  112,  130,  133,
+ /*    10 */   135,  148,  150,  155,  161,  -61,  180,  201,  -49,  174,
+ /*    20 */   186,  194,  197,  199,  202,  205,   -4,  239,   69,   86,
+ /*    30 */    18,   18,  154,   77,  152,  232,   61,  236,  227, -106,
+ /*    40 */  -106,  -68,  -28,   54,   46,  147,  124,  124,  157,   46,
+ /*    50 */    46,  168,  198,  247,   46,  192,  256,  260,  259,  262,
+ /*    60 */   277,  280,  273,  274,  279,  300,  303,  301,  306,  299,
+ /*    70 */   309,  311,  312,  314,  318,  319,  321,  281,  283,  284,
+ /*    80 */   287,  289,  292,  288,  290,  297,  308,  320,  334,  336,
+ /*    90 */   331,  337,  342,  338,  343,  346,  330,  324,  348,  344,
+ /*   100 */   349,  347,  350,  353,  354,  355,  358,
 };
 static const YYACTIONTYPE yy_default[] = {
- /*     0 */   440,  440,  397,  397,  397,  440,  397,  511,  397,  397,
- /*    10 */   397,  397,  397,  511,  511,  423,  440,  397,  397,  397,
- /*    20 */   397,  397,  397,  397,  397,  481,  397,  481,  446,  397,
- /*    30 */   397,  397,  397,  397,  397,  397,  397,  397,  397,  397,
- /*    40 */   397,  481,  421,  450,  428,  426,  457,  475,  481,  481,
- /*    50 */   458,  397,  397,  397,  397,  429,  436,  522,  520,  516,
- /*    60 */   397,  485,  522,  520,  516,  397,  419,  522,  520,  397,
- /*    70 */   481,  397,  475,  397,  481,  397,  397,  481,  397,  441,
- /*    80 */   522,  520,  516,  414,  522,  520,  516,  412,  485,  397,
- /*    90 */   522,  520,  522,  520,  516,  397,  516,  516,  397,  397,
- /*   100 */   497,  397,  487,  454,  512,  513,  397,  517,  397,  486,
- /*   110 */   480,  397,  397,  514,  505,  504,  397,  499,  397,  397,
- /*   120 */   397,  397,  397,  397,  397,  397,  397,  397,  427,  397,
- /*   130 */   439,  490,  397,  397,  397,  397,  397,  397,  477,  479,
- /*   140 */   397,  397,  397,  397,  397,  397,  483,  397,  397,  397,
- /*   150 */   397,  444,  397,  459,  514,  397,  451,  397,  397,  492,
- /*   160 */   397,  491,  397,  397,
+ /*     0 */   488,  488,  441,  441,  441,  488,  441,  566,  441,  441,
+ /*    10 */   441,  441,  441,  566,  566,  467,  441,  488,  441,  441,
+ /*    20 */   441,  441,  441,  441,  441,  441,  533,  441,  441,  533,
+ /*    30 */   497,  441,  441,  441,  441,  441,  441,  441,  441,  441,
+ /*    40 */   441,  441,  533,  465,  502,  441,  472,  470,  441,  486,
+ /*    50 */   509,  527,  533,  533,  510,  441,  495,  441,  495,  441,
+ /*    60 */   441,  473,  441,  441,  480,  578,  575,  571,  441,  539,
+ /*    70 */   578,  575,  571,  441,  463,  578,  575,  441,  533,  441,
+ /*    80 */   527,  441,  533,  441,  441,  533,  441,  489,  578,  575,
+ /*    90 */   571,  458,  578,  575,  571,  456,  539,  441,  578,  575,
+ /*   100 */   578,  575,  571,  441,  571,  571,  441,  441,  551,  441,
+ /*   110 */   541,  506,  567,  568,  441,  572,  441,  441,  540,  532,
+ /*   120 */   441,  441,  441,  441,  569,  559,  558,  441,  553,  441,
+ /*   130 */   441,  441,  441,  441,  441,  441,  441,  441,  441,  441,
+ /*   140 */   441,  441,  441,  441,  471,  441,  441,  441,  483,  544,
+ /*   150 */   441,  441,  441,  441,  441,  441,  529,  531,  441,  441,
+ /*   160 */   441,  441,  441,  441,  441,  535,  441,  441,  441,  441,
+ /*   170 */   492,  441,  511,  569,  441,  503,  441,  441,  546,  441,
+ /*   180 */   545,  441,  441,  441,
 };
 /********** End of lemon-generated parsing tables *****************************/
 
@@ -516,90 +530,95 @@ static const char *const yyTokenName[] = {
   /*   21 */ "CREATE",
   /*   22 */ "INDEX",
   /*   23 */ "ON",
-  /*   24 */ "DROP",
-  /*   25 */ "COLON",
-  /*   26 */ "MERGE",
-  /*   27 */ "SET",
-  /*   28 */ "DELETE",
-  /*   29 */ "RIGHT_ARROW",
-  /*   30 */ "LEFT_ARROW",
-  /*   31 */ "LEFT_BRACKET",
-  /*   32 */ "RIGHT_BRACKET",
+  /*   24 */ "LEFT_BRACKET",
+  /*   25 */ "RIGHT_BRACKET",
+  /*   26 */ "DROP",
+  /*   27 */ "COLON",
+  /*   28 */ "MERGE",
+  /*   29 */ "SET",
+  /*   30 */ "DELETE",
+  /*   31 */ "RIGHT_ARROW",
+  /*   32 */ "LEFT_ARROW",
   /*   33 */ "PIPE",
   /*   34 */ "INTEGER",
   /*   35 */ "DOTDOT",
   /*   36 */ "LEFT_CURLY_BRACKET",
   /*   37 */ "RIGHT_CURLY_BRACKET",
-  /*   38 */ "WHERE",
-  /*   39 */ "RETURN",
-  /*   40 */ "DISTINCT",
-  /*   41 */ "AS",
-  /*   42 */ "WITH",
-  /*   43 */ "ORDER",
-  /*   44 */ "BY",
-  /*   45 */ "ASC",
-  /*   46 */ "DESC",
-  /*   47 */ "SKIP",
-  /*   48 */ "LIMIT",
-  /*   49 */ "UNWIND",
-  /*   50 */ "NE",
-  /*   51 */ "FLOAT",
-  /*   52 */ "TRUE",
-  /*   53 */ "FALSE",
-  /*   54 */ "NULLVAL",
-  /*   55 */ "error",
-  /*   56 */ "query",
-  /*   57 */ "expressions",
-  /*   58 */ "expr",
-  /*   59 */ "withClause",
-  /*   60 */ "singlePartQuery",
-  /*   61 */ "skipClause",
-  /*   62 */ "limitClause",
-  /*   63 */ "returnClause",
-  /*   64 */ "orderClause",
-  /*   65 */ "setClause",
-  /*   66 */ "deleteClause",
-  /*   67 */ "multipleMatchClause",
-  /*   68 */ "whereClause",
-  /*   69 */ "multipleCreateClause",
-  /*   70 */ "unwindClause",
-  /*   71 */ "indexClause",
-  /*   72 */ "mergeClause",
-  /*   73 */ "procedureCallClause",
-  /*   74 */ "procedureName",
-  /*   75 */ "stringList",
-  /*   76 */ "unquotedStringList",
-  /*   77 */ "delimiter",
-  /*   78 */ "matchClauses",
-  /*   79 */ "matchClause",
-  /*   80 */ "chains",
-  /*   81 */ "createClauses",
-  /*   82 */ "createClause",
-  /*   83 */ "indexOpToken",
-  /*   84 */ "indexLabel",
-  /*   85 */ "indexProp",
-  /*   86 */ "chain",
-  /*   87 */ "setList",
-  /*   88 */ "setElement",
-  /*   89 */ "variable",
-  /*   90 */ "arithmetic_expression",
-  /*   91 */ "node",
-  /*   92 */ "link",
-  /*   93 */ "deleteExpression",
-  /*   94 */ "properties",
-  /*   95 */ "edge",
-  /*   96 */ "edgeLength",
-  /*   97 */ "edgeLabels",
-  /*   98 */ "edgeLabel",
-  /*   99 */ "mapLiteral",
-  /*  100 */ "value",
-  /*  101 */ "cond",
-  /*  102 */ "relation",
-  /*  103 */ "returnElements",
-  /*  104 */ "returnElement",
-  /*  105 */ "withElements",
-  /*  106 */ "withElement",
-  /*  107 */ "arithmetic_expression_list",
+  /*   38 */ "DOLLAR",
+  /*   39 */ "WHERE",
+  /*   40 */ "RETURN",
+  /*   41 */ "DISTINCT",
+  /*   42 */ "AS",
+  /*   43 */ "WITH",
+  /*   44 */ "ORDER",
+  /*   45 */ "BY",
+  /*   46 */ "ASC",
+  /*   47 */ "DESC",
+  /*   48 */ "SKIP",
+  /*   49 */ "LIMIT",
+  /*   50 */ "UNWIND",
+  /*   51 */ "NE",
+  /*   52 */ "FLOAT",
+  /*   53 */ "TRUE",
+  /*   54 */ "FALSE",
+  /*   55 */ "NULLVAL",
+  /*   56 */ "error",
+  /*   57 */ "query",
+  /*   58 */ "expressions",
+  /*   59 */ "expr",
+  /*   60 */ "withClause",
+  /*   61 */ "singlePartQuery",
+  /*   62 */ "skipClause",
+  /*   63 */ "limitClause",
+  /*   64 */ "returnClause",
+  /*   65 */ "orderClause",
+  /*   66 */ "setClause",
+  /*   67 */ "deleteClause",
+  /*   68 */ "multipleMatchClause",
+  /*   69 */ "whereClause",
+  /*   70 */ "multipleCreateClause",
+  /*   71 */ "unwindClause",
+  /*   72 */ "indexClause",
+  /*   73 */ "mergeClause",
+  /*   74 */ "procedureCallClause",
+  /*   75 */ "procedureName",
+  /*   76 */ "stringList",
+  /*   77 */ "unquotedStringList",
+  /*   78 */ "delimiter",
+  /*   79 */ "matchClauses",
+  /*   80 */ "matchClause",
+  /*   81 */ "matchChains",
+  /*   82 */ "matchChain",
+  /*   83 */ "chain",
+  /*   84 */ "node",
+  /*   85 */ "link",
+  /*   86 */ "createClauses",
+  /*   87 */ "createClause",
+  /*   88 */ "chains",
+  /*   89 */ "indexOpToken",
+  /*   90 */ "indexLabel",
+  /*   91 */ "indexProps",
+  /*   92 */ "indexType",
+  /*   93 */ "setList",
+  /*   94 */ "setElement",
+  /*   95 */ "variable",
+  /*   96 */ "arithmetic_expression",
+  /*   97 */ "deleteExpression",
+  /*   98 */ "properties",
+  /*   99 */ "edge",
+  /*  100 */ "edgeLength",
+  /*  101 */ "edgeLabels",
+  /*  102 */ "edgeLabel",
+  /*  103 */ "mapLiteral",
+  /*  104 */ "mapValue",
+  /*  105 */ "value",
+  /*  106 */ "cond",
+  /*  107 */ "relation",
+  /*  108 */ "returnElements",
+  /*  109 */ "returnElement",
+  /*  110 */ "withElements",
+  /*  111 */ "withElement",
+  /*  112 */ "arithmetic_expression_list",
 };
 #endif /* defined(YYCOVERAGE) || !defined(NDEBUG) */
 
@@ -646,106 +665,119 @@ static const char *const yyRuleName[] = {
  /*  36 */ "multipleMatchClause ::= matchClauses",
  /*  37 */ "matchClauses ::= matchClause",
  /*  38 */ "matchClauses ::= matchClauses matchClause",
- /*  39 */ "matchClause ::= MATCH chains",
- /*  40 */ "multipleCreateClause ::=",
- /*  41 */ "multipleCreateClause ::= createClauses",
- /*  42 */ "createClauses ::= createClause",
- /*  43 */ "createClauses ::= createClauses createClause",
- /*  44 */ "createClause ::= CREATE chains",
- /*  45 */ "indexClause ::= indexOpToken INDEX ON indexLabel indexProp",
- /*  46 */ "indexOpToken ::= CREATE",
- /*  47 */ "indexOpToken ::= DROP",
- /*  48 */ "indexLabel ::= COLON UQSTRING",
- /*  49 */ "indexProp ::= LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS",
- /*  50 */ "mergeClause ::= MERGE chain",
- /*  51 */ "setClause ::= SET setList",
- /*  52 */ "setList ::= setElement",
- /*  53 */ "setList ::= setList COMMA setElement",
- /*  54 */ "setElement ::= variable EQ arithmetic_expression",
- /*  55 */ "chain ::= node",
- /*  56 */ "chain ::= chain link node",
- /*  57 */ "chains ::= chain",
- /*  58 */ "chains ::= chains COMMA chain",
- /*  59 */ "deleteClause ::= DELETE deleteExpression",
- /*  60 */ "deleteExpression ::= UQSTRING",
- /*  61 */ "deleteExpression ::= deleteExpression COMMA UQSTRING",
- /*  62 */ "node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS",
- /*  63 */ "node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS",
- /*  64 */ "node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS",
- /*  65 */ "node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS",
- /*  66 */ "link ::= DASH edge RIGHT_ARROW",
- /*  67 */ "link ::= LEFT_ARROW edge DASH",
- /*  68 */ "edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET",
- /*  69 */ "edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET",
- /*  70 */ "edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET",
- /*  71 */ "edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET",
- /*  72 */ "edgeLabel ::= COLON UQSTRING",
- /*  73 */ "edgeLabels ::= edgeLabel",
- /*  74 */ "edgeLabels ::= edgeLabels PIPE edgeLabel",
- /*  75 */ "edgeLength ::=",
- /*  76 */ "edgeLength ::= MUL INTEGER DOTDOT INTEGER",
- /*  77 */ "edgeLength ::= MUL INTEGER DOTDOT",
- /*  78 */ "edgeLength ::= MUL DOTDOT INTEGER",
- /*  79 */ "edgeLength ::= MUL INTEGER",
- /*  80 */ "edgeLength ::= MUL",
- /*  81 */ "properties ::=",
- /*  82 */ "properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET",
- /*  83 */ "mapLiteral ::= UQSTRING COLON value",
- /*  84 */ "mapLiteral ::= UQSTRING COLON value COMMA mapLiteral",
- /*  85 */ "whereClause ::=",
- /*  86 */ "whereClause ::= WHERE cond",
- /*  87 */ "cond ::= arithmetic_expression relation arithmetic_expression",
- /*  88 */ "cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS",
- /*  89 */ "cond ::= cond AND cond",
- /*  90 */ "cond ::= cond OR cond",
- /*  91 */ "returnClause ::= RETURN returnElements",
- /*  92 */ "returnClause ::= RETURN DISTINCT returnElements",
- /*  93 */ "returnClause ::= RETURN MUL",
- /*  94 */ "returnClause ::= RETURN DISTINCT MUL",
- /*  95 */ "returnElements ::= returnElements COMMA returnElement",
- /*  96 */ "returnElements ::= returnElement",
- /*  97 */ "returnElement ::= arithmetic_expression",
- /*  98 */ "returnElement ::= arithmetic_expression AS UQSTRING",
- /*  99 */ "withClause ::= WITH withElements",
- /* 100 */ "withElements ::= withElement",
- /* 101 */ "withElements ::= withElements COMMA withElement",
- /* 102 */ "withElement ::= arithmetic_expression AS UQSTRING",
- /* 103 */ "arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS",
- /* 104 */ "arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression",
- /* 105 */ "arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression",
- /* 106 */ "arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression",
- /* 107 */ "arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression",
- /* 108 */ "arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS",
- /* 109 */ "arithmetic_expression ::= value",
- /* 110 */ "arithmetic_expression ::= variable",
- /* 111 */ "arithmetic_expression_list ::=",
- /* 112 */ "arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression",
- /* 113 */ "arithmetic_expression_list ::= arithmetic_expression",
- /* 114 */ "variable ::= UQSTRING",
- /* 115 */ "variable ::= UQSTRING DOT UQSTRING",
- /* 116 */ "orderClause ::=",
- /* 117 */ "orderClause ::= ORDER BY arithmetic_expression_list",
- /* 118 */ "orderClause ::= ORDER BY arithmetic_expression_list ASC",
- /* 119 */ "orderClause ::= ORDER BY arithmetic_expression_list DESC",
- /* 120 */ "skipClause ::=",
- /* 121 */ "skipClause ::= SKIP INTEGER",
- /* 122 */ "limitClause ::=",
- /* 123 */ "limitClause ::= LIMIT INTEGER",
- /* 124 */ "unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING",
- /* 125 */ "relation ::= EQ",
- /* 126 */ "relation ::= GT",
- /* 127 */ "relation ::= LT",
- /* 128 */ "relation ::= LE",
- /* 129 */ "relation ::= GE",
- /* 130 */ "relation ::= NE",
- /* 131 */ "value ::= INTEGER",
- /* 132 */ "value ::= DASH INTEGER",
- /* 133 */ "value ::= STRING",
- /* 134 */ "value ::= FLOAT",
- /* 135 */ "value ::= DASH FLOAT",
- /* 136 */ "value ::= TRUE",
- /* 137 */ "value ::= FALSE",
- /* 138 */ "value ::= NULLVAL",
+ /*  39 */ "matchClause ::= MATCH matchChains",
+ /*  40 */ "matchChains ::= matchChain",
+ /*  41 */ "matchChains ::= matchChains COMMA matchChain",
+ /*  42 */ "matchChain ::= chain",
+ /*  43 */ "matchChain ::= UQSTRING LEFT_PARENTHESIS node link node RIGHT_PARENTHESIS",
+ /*  44 */ "multipleCreateClause ::=",
+ /*  45 */ "multipleCreateClause ::= createClauses",
+ /*  46 */ "createClauses ::= createClause",
+ /*  47 */ "createClauses ::= createClauses createClause",
+ /*  48 */ "createClause ::= CREATE chains",
+ /*  49 */ "indexClause ::= indexOpToken INDEX ON indexLabel LEFT_PARENTHESIS indexProps RIGHT_PARENTHESIS indexType",
+ /*  50 */ "indexClause ::= indexOpToken INDEX ON LEFT_BRACKET indexLabel RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS indexType",
+ /*  51 */ "indexType ::=",
+ /*  52 */ "indexType ::= UQSTRING UQSTRING",
+ /*  53 */ "indexOpToken ::= CREATE",
+ /*  54 */ "indexOpToken ::= DROP",
+ /*  55 */ "indexLabel ::= COLON UQSTRING",
+ /*  56 */ "indexProps ::= UQSTRING",
+ /*  57 */ "indexProps ::= indexProps COMMA UQSTRING",
+ /*  58 */ "mergeClause ::= MERGE chain",
+ /*  59 */ "setClause ::= SET setList",
+ /*  60 */ "setList ::= setElement",
+ /*  61 */ "setList ::= setList COMMA setElement",
+ /*  62 */ "setElement ::= variable EQ arithmetic_expression",
+ /*  63 */ "chain ::= node",
+ /*  64 */ "chain ::= chain link node",
+ /*  65 */ "chains ::= chain",
+ /*  66 */ "chains ::= chains COMMA chain",
+ /*  67 */ "deleteClause ::= DELETE deleteExpression",
+ /*  68 */ "deleteExpression ::= UQSTRING",
+ /*  69 */ "deleteExpression ::= deleteExpression COMMA UQSTRING",
+ /*  70 */ "node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS",
+ /*  71 */ "node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS",
+ /*  72 */ "node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS",
+ /*  73 */ "node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS",
+ /*  74 */ "link ::= DASH edge RIGHT_ARROW",
+ /*  75 */ "link ::= LEFT_ARROW edge DASH",
+ /*  76 */ "edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET",
+ /*  77 */ "edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET",
+ /*  78 */ "edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET",
+ /*  79 */ "edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET",
+ /*  80 */ "edgeLabel ::= COLON UQSTRING",
+ /*  81 */ "edgeLabels ::= edgeLabel",
+ /*  82 */ "edgeLabels ::= edgeLabels PIPE edgeLabel",
+ /*  83 */ "edgeLength ::=",
+ /*  84 */ "edgeLength ::= MUL INTEGER DOTDOT INTEGER",
+ /*  85 */ "edgeLength ::= MUL INTEGER DOTDOT",
+ /*  86 */ "edgeLength ::= MUL DOTDOT INTEGER",
+ /*  87 */ "edgeLength ::= MUL INTEGER",
+ /*  88 */ "edgeLength ::= MUL",
+ /*  89 */ "properties ::=",
+ /*  90 */ "properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET",
+ /*  91 */ "mapLiteral ::= UQSTRING COLON mapValue",
+ /*  92 */ "mapLiteral ::= UQSTRING COLON mapValue COMMA mapLiteral",
+ /*  93 */ "mapValue ::= value",
+ /*  94 */ "mapValue ::= DOLLAR UQSTRING",
+ /*  95 */ "whereClause ::=",
+ /*  96 */ "whereClause ::= WHERE cond",
+ /*  97 */ "cond ::= arithmetic_expression relation arithmetic_expression",
+ /*  98 */ "cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS",
+ /*  99 */ "cond ::= cond AND cond",
+ /* 100 */ "cond ::= cond OR cond",
+ /* 101 */ "returnClause ::= RETURN returnElements",
+ /* 102 */ "returnClause ::= RETURN DISTINCT returnElements",
+ /* 103 */ "returnClause ::= RETURN MUL",
+ /* 104 */ "returnClause ::= RETURN DISTINCT MUL",
+ /* 105 */ "returnElements ::= returnElements COMMA returnElement",
+ /* 106 */ "returnElements ::= returnElement",
+ /* 107 */ "returnElement ::= arithmetic_expression",
+ /* 108 */ "returnElement ::= arithmetic_expression AS UQSTRING",
+ /* 109 */ "withClause ::= WITH withElements",
+ /* 110 */ "withElements ::= withElement",
+ /* 111 */ "withElements ::= withElements COMMA withElement",
+ /* 112 */ "withElement ::= arithmetic_expression AS UQSTRING",
+ /* 113 */ "arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS",
+ /* 114 */ "arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression",
+ /* 115 */ "arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression",
+ /* 116 */ "arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression",
+ /* 117 */ "arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression",
+ /* 118 */ "arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS",
+ /* 119 */ "arithmetic_expression ::= value",
+ /* 120 */ "arithmetic_expression ::= DOLLAR UQSTRING",
+ /* 121 */ "arithmetic_expression ::= variable",
+ /* 122 */ "arithmetic_expression_list ::=",
+ /* 123 */ "arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression",
+ /* 124 */ "arithmetic_expression_list ::= arithmetic_expression",
+ /* 125 */ "variable ::= UQSTRING",
+ /* 126 */ "variable ::= UQSTRING DOT UQSTRING",
+ /* 127 */ "orderClause ::=",
+ /* 128 */ "orderClause ::= ORDER BY arithmetic_expression_list",
+ /* 129 */ "orderClause ::= ORDER BY arithmetic_expression_list ASC",
+ /* 130 */ "orderClause ::= ORDER BY arithmetic_expression_list DESC",
+ /* 131 */ "skipClause ::=",
+ /* 132 */ "skipClause ::= SKIP INTEGER",
+ /* 133 */ "skipClause ::= SKIP DOLLAR UQSTRING",
+ /* 134 */ "limitClause ::=",
+ /* 135 */ "limitClause ::= LIMIT INTEGER",
+ /* 136 */ "limitClause ::= LIMIT DOLLAR UQSTRING",
+ /* 137 */ "unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING",
+ /* 138 */ "relation ::= EQ",
+ /* 139 */ "relation ::= GT",
+ /* 140 */ "relation ::= LT",
+ /* 141 */ "relation ::= LE",
+ /* 142 */ "relation ::= GE",
+ /* 143 */ "relation ::= NE",
+ /* 144 */ "value ::= INTEGER",
+ /* 145 */ "value ::= DASH INTEGER",
+ /* 146 */ "value ::= STRING",
+ /* 147 */ "value ::= FLOAT",
+ /* 148 */ "value ::= DASH FLOAT",
+ /* 149 */ "value ::= TRUE",
+ /* 150 */ "value ::= FALSE",
+ /* 151 */ "value ::= NULLVAL",
 };
 #endif /* NDEBUG */
 
@@ -866,11 +898,11 @@ static void yy_destructor(
     ** inside the C code.
     */
 /********* Begin destructor definitions ***************************************/
-    case 101: /* cond */
+    case 106: /* cond */
 {
-#line 519 "grammar.y"
- Free_AST_FilterNode((yypminor->yy10)); 
-#line 874 "grammar.c"
+#line 599 "grammar.y"
+ Free_AST_FilterNode((yypminor->yy190)); 
+#line 906 "grammar.c"
 }
       break;
 /********* End destructor definitions *****************************************/
@@ -1165,145 +1197,158 @@ static const struct {
   YYCODETYPE lhs;       /* Symbol on the left-hand side of the rule */
   signed char nrhs;     /* Negative of the number of RHS symbols in the rule */
 } yyRuleInfo[] = {
-  {   56,   -1 }, /* (0) query ::= expressions */
-  {   57,   -1 }, /* (1) expressions ::= expr */
-  {   57,   -3 }, /* (2) expressions ::= expressions withClause singlePartQuery */
-  {   60,   -1 }, /* (3) singlePartQuery ::= expr */
-  {   60,   -4 }, /* (4) singlePartQuery ::= skipClause limitClause returnClause orderClause */
-  {   60,   -3 }, /* (5) singlePartQuery ::= limitClause returnClause orderClause */
-  {   60,   -3 }, /* (6) singlePartQuery ::= skipClause returnClause orderClause */
-  {   60,   -4 }, /* (7) singlePartQuery ::= returnClause orderClause skipClause limitClause */
-  {   60,   -4 }, /* (8) singlePartQuery ::= orderClause skipClause limitClause returnClause */
-  {   60,   -4 }, /* (9) singlePartQuery ::= orderClause skipClause limitClause setClause */
-  {   60,   -4 }, /* (10) singlePartQuery ::= orderClause skipClause limitClause deleteClause */
-  {   58,   -7 }, /* (11) expr ::= multipleMatchClause whereClause multipleCreateClause returnClause orderClause skipClause limitClause */
-  {   58,   -3 }, /* (12) expr ::= multipleMatchClause whereClause multipleCreateClause */
-  {   58,   -3 }, /* (13) expr ::= multipleMatchClause whereClause deleteClause */
-  {   58,   -3 }, /* (14) expr ::= multipleMatchClause whereClause setClause */
-  {   58,   -7 }, /* (15) expr ::= multipleMatchClause whereClause setClause returnClause orderClause skipClause limitClause */
-  {   58,   -1 }, /* (16) expr ::= multipleCreateClause */
-  {   58,   -2 }, /* (17) expr ::= unwindClause multipleCreateClause */
-  {   58,   -1 }, /* (18) expr ::= indexClause */
-  {   58,   -1 }, /* (19) expr ::= mergeClause */
-  {   58,   -2 }, /* (20) expr ::= mergeClause setClause */
-  {   58,   -1 }, /* (21) expr ::= returnClause */
-  {   58,   -4 }, /* (22) expr ::= unwindClause returnClause skipClause limitClause */
-  {   58,   -1 }, /* (23) expr ::= procedureCallClause */
-  {   58,   -6 }, /* (24) expr ::= procedureCallClause whereClause returnClause orderClause skipClause limitClause */
-  {   58,   -7 }, /* (25) expr ::= procedureCallClause multipleMatchClause whereClause returnClause orderClause skipClause limitClause */
-  {   73,   -7 }, /* (26) procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS YIELD unquotedStringList */
-  {   73,   -5 }, /* (27) procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS */
-  {   74,   -1 }, /* (28) procedureName ::= unquotedStringList */
-  {   75,    0 }, /* (29) stringList ::= */
-  {   75,   -1 }, /* (30) stringList ::= STRING */
-  {   75,   -3 }, /* (31) stringList ::= stringList delimiter STRING */
-  {   76,   -1 }, /* (32) unquotedStringList ::= UQSTRING */
-  {   76,   -3 }, /* (33) unquotedStringList ::= unquotedStringList delimiter UQSTRING */
-  {   77,   -1 }, /* (34) delimiter ::= COMMA */
-  {   77,   -1 }, /* (35) delimiter ::= DOT */
-  {   67,   -1 }, /* (36) multipleMatchClause ::= matchClauses */
-  {   78,   -1 }, /* (37) matchClauses ::= matchClause */
-  {   78,   -2 }, /* (38) matchClauses ::= matchClauses matchClause */
-  {   79,   -2 }, /* (39) matchClause ::= MATCH chains */
-  {   69,    0 }, /* (40) multipleCreateClause ::= */
-  {   69,   -1 }, /* (41) multipleCreateClause ::= createClauses */
-  {   81,   -1 }, /* (42) createClauses ::= createClause */
-  {   81,   -2 }, /* (43) createClauses ::= createClauses createClause */
-  {   82,   -2 }, /* (44) createClause ::= CREATE chains */
-  {   71,   -5 }, /* (45) indexClause ::= indexOpToken INDEX ON indexLabel indexProp */
-  {   83,   -1 }, /* (46) indexOpToken ::= CREATE */
-  {   83,   -1 }, /* (47) indexOpToken ::= DROP */
-  {   84,   -2 }, /* (48) indexLabel ::= COLON UQSTRING */
-  {   85,   -3 }, /* (49) indexProp ::= LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
-  {   72,   -2 }, /* (50) mergeClause ::= MERGE chain */
-  {   65,   -2 }, /* (51) setClause ::= SET setList */
-  {   87,   -1 }, /* (52) setList ::= setElement */
-  {   87,   -3 }, /* (53) setList ::= setList COMMA setElement */
-  {   88,   -3 }, /* (54) setElement ::= variable EQ arithmetic_expression */
-  {   86,   -1 }, /* (55) chain ::= node */
-  {   86,   -3 }, /* (56) chain ::= chain link node */
-  {   80,   -1 }, /* (57) chains ::= chain */
-  {   80,   -3 }, /* (58) chains ::= chains COMMA chain */
-  {   66,   -2 }, /* (59) deleteClause ::= DELETE deleteExpression */
-  {   93,   -1 }, /* (60) deleteExpression ::= UQSTRING */
-  {   93,   -3 }, /* (61) deleteExpression ::= deleteExpression COMMA UQSTRING */
-  {   91,   -6 }, /* (62) node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
-  {   91,   -5 }, /* (63) node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
-  {   91,   -4 }, /* (64) node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
-  {   91,   -3 }, /* (65) node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
-  {   92,   -3 }, /* (66) link ::= DASH edge RIGHT_ARROW */
-  {   92,   -3 }, /* (67) link ::= LEFT_ARROW edge DASH */
-  {   95,   -4 }, /* (68) edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET */
-  {   95,   -4 }, /* (69) edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
-  {   95,   -5 }, /* (70) edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET */
-  {   95,   -5 }, /* (71) edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET */
-  {   98,   -2 }, /* (72) edgeLabel ::= COLON UQSTRING */
-  {   97,   -1 }, /* (73) edgeLabels ::= edgeLabel */
-  {   97,   -3 }, /* (74) edgeLabels ::= edgeLabels PIPE edgeLabel */
-  {   96,    0 }, /* (75) edgeLength ::= */
-  {   96,   -4 }, /* (76) edgeLength ::= MUL INTEGER DOTDOT INTEGER */
-  {   96,   -3 }, /* (77) edgeLength ::= MUL INTEGER DOTDOT */
-  {   96,   -3 }, /* (78) edgeLength ::= MUL DOTDOT INTEGER */
-  {   96,   -2 }, /* (79) edgeLength ::= MUL INTEGER */
-  {   96,   -1 }, /* (80) edgeLength ::= MUL */
-  {   94,    0 }, /* (81) properties ::= */
-  {   94,   -3 }, /* (82) properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
-  {   99,   -3 }, /* (83) mapLiteral ::= UQSTRING COLON value */
-  {   99,   -5 }, /* (84) mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
-  {   68,    0 }, /* (85) whereClause ::= */
-  {   68,   -2 }, /* (86) whereClause ::= WHERE cond */
-  {  101,   -3 }, /* (87) cond ::= arithmetic_expression relation arithmetic_expression */
-  {  101,   -3 }, /* (88) cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
-  {  101,   -3 }, /* (89) cond ::= cond AND cond */
-  {  101,   -3 }, /* (90) cond ::= cond OR cond */
-  {   63,   -2 }, /* (91) returnClause ::= RETURN returnElements */
-  {   63,   -3 }, /* (92) returnClause ::= RETURN DISTINCT returnElements */
-  {   63,   -2 }, /* (93) returnClause ::= RETURN MUL */
-  {   63,   -3 }, /* (94) returnClause ::= RETURN DISTINCT MUL */
-  {  103,   -3 }, /* (95) returnElements ::= returnElements COMMA returnElement */
-  {  103,   -1 }, /* (96) returnElements ::= returnElement */
-  {  104,   -1 }, /* (97) returnElement ::= arithmetic_expression */
-  {  104,   -3 }, /* (98) returnElement ::= arithmetic_expression AS UQSTRING */
-  {   59,   -2 }, /* (99) withClause ::= WITH withElements */
-  {  105,   -1 }, /* (100) withElements ::= withElement */
-  {  105,   -3 }, /* (101) withElements ::= withElements COMMA withElement */
-  {  106,   -3 }, /* (102) withElement ::= arithmetic_expression AS UQSTRING */
-  {   90,   -3 }, /* (103) arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
-  {   90,   -3 }, /* (104) arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
-  {   90,   -3 }, /* (105) arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
-  {   90,   -3 }, /* (106) arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
-  {   90,   -3 }, /* (107) arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
-  {   90,   -4 }, /* (108) arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
-  {   90,   -1 }, /* (109) arithmetic_expression ::= value */
-  {   90,   -1 }, /* (110) arithmetic_expression ::= variable */
-  {  107,    0 }, /* (111) arithmetic_expression_list ::= */
-  {  107,   -3 }, /* (112) arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
-  {  107,   -1 }, /* (113) arithmetic_expression_list ::= arithmetic_expression */
-  {   89,   -1 }, /* (114) variable ::= UQSTRING */
-  {   89,   -3 }, /* (115) variable ::= UQSTRING DOT UQSTRING */
-  {   64,    0 }, /* (116) orderClause ::= */
-  {   64,   -3 }, /* (117) orderClause ::= ORDER BY arithmetic_expression_list */
-  {   64,   -4 }, /* (118) orderClause ::= ORDER BY arithmetic_expression_list ASC */
-  {   64,   -4 }, /* (119) orderClause ::= ORDER BY arithmetic_expression_list DESC */
-  {   61,    0 }, /* (120) skipClause ::= */
-  {   61,   -2 }, /* (121) skipClause ::= SKIP INTEGER */
-  {   62,    0 }, /* (122) limitClause ::= */
-  {   62,   -2 }, /* (123) limitClause ::= LIMIT INTEGER */
-  {   70,   -6 }, /* (124) unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING */
-  {  102,   -1 }, /* (125) relation ::= EQ */
-  {  102,   -1 }, /* (126) relation ::= GT */
-  {  102,   -1 }, /* (127) relation ::= LT */
-  {  102,   -1 }, /* (128) relation ::= LE */
-  {  102,   -1 }, /* (129) relation ::= GE */
-  {  102,   -1 }, /* (130) relation ::= NE */
-  {  100,   -1 }, /* (131) value ::= INTEGER */
-  {  100,   -2 }, /* (132) value ::= DASH INTEGER */
-  {  100,   -1 }, /* (133) value ::= STRING */
-  {  100,   -1 }, /* (134) value ::= FLOAT */
-  {  100,   -2 }, /* (135) value ::= DASH FLOAT */
-  {  100,   -1 }, /* (136) value ::= TRUE */
-  {  100,   -1 }, /* (137) value ::= FALSE */
-  {  100,   -1 }, /* (138) value ::= NULLVAL */
+  {   57,   -1 }, /* (0) query ::= expressions */
+  {   58,   -1 }, /* (1) expressions ::= expr */
+  {   58,   -3 }, /* (2) expressions ::= expressions withClause singlePartQuery */
+  {   61,   -1 }, /* (3) singlePartQuery ::= expr */
+  {   61,   -4 }, /* (4) singlePartQuery ::= skipClause limitClause returnClause orderClause */
+  {   61,   -3 }, /* (5) singlePartQuery ::= limitClause returnClause orderClause */
+  {   61,   -3 }, /* (6) singlePartQuery ::= skipClause returnClause orderClause */
+  {   61,   -4 }, /* (7) singlePartQuery ::= returnClause orderClause skipClause limitClause */
+  {   61,   -4 }, /* (8) singlePartQuery ::= orderClause skipClause limitClause returnClause */
+  {   61,   -4 }, /* (9) singlePartQuery ::= orderClause skipClause limitClause setClause */
+  {   61,   -4 }, /* (10) singlePartQuery ::= orderClause skipClause limitClause deleteClause */
+  {   59,   -7 }, /* (11) expr ::= multipleMatchClause whereClause multipleCreateClause returnClause orderClause skipClause limitClause */
+  {   59,   -3 }, /* (12) expr ::= multipleMatchClause whereClause multipleCreateClause */
+  {   59,   -3 }, /* (13) expr ::= multipleMatchClause whereClause deleteClause */
+  {   59,   -3 }, /* (14) expr ::= multipleMatchClause whereClause setClause */
+  {   59,   -7 }, /* (15) expr ::= multipleMatchClause whereClause setClause returnClause orderClause skipClause limitClause */
+  {   59,   -1 }, /* (16) expr ::= multipleCreateClause */
+  {   59,   -2 }, /* (17) expr ::= unwindClause multipleCreateClause */
+  {   59,   -1 }, /* (18) expr ::= indexClause */
+  {   59,   -1 }, /* (19) expr ::= mergeClause */
+  {   59,   -2 }, /* (20) expr ::= mergeClause setClause */
+  {   59,   -1 }, /* (21) expr ::= returnClause */
+  {   59,   -4 }, /* (22) expr ::= unwindClause returnClause skipClause limitClause */
+  {   59,   -1 }, /* (23) expr ::= procedureCallClause */
+  {   59,   -6 }, /* (24) expr ::= procedureCallClause whereClause returnClause orderClause skipClause limitClause */
+  {   59,   -7 }, /* (25) expr ::= procedureCallClause multipleMatchClause whereClause returnClause orderClause skipClause limitClause */
+  {   74,   -7 }, /* (26) procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS YIELD unquotedStringList */
+  {   74,   -5 }, /* (27) procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS */
+  {   75,   -1 }, /* (28) procedureName ::= unquotedStringList */
+  {   76,    0 }, /* (29) stringList ::= */
+  {   76,   -1 }, /* (30) stringList ::= STRING */
+  {   76,   -3 }, /* (31) stringList ::= stringList delimiter STRING */
+  {   77,   -1 }, /* (32) unquotedStringList ::= UQSTRING */
+  {   77,   -3 }, /* (33) unquotedStringList ::= unquotedStringList delimiter UQSTRING */
+  {   78,   -1 }, /* (34) delimiter ::= COMMA */
+  {   78,   -1 }, /* (35) delimiter ::= DOT */
+  {   68,   -1 }, /* (36) multipleMatchClause ::= matchClauses */
+  {   79,   -1 }, /* (37) matchClauses ::= matchClause */
+  {   79,   -2 }, /* (38) matchClauses ::= matchClauses matchClause */
+  {   80,   -2 }, /* (39) matchClause ::= MATCH matchChains */
+  {   81,   -1 }, /* (40) matchChains ::= matchChain */
+  {   81,   -3 }, /* (41) matchChains ::= matchChains COMMA matchChain */
+  {   82,   -1 }, /* (42) matchChain ::= chain */
+  {   82,   -6 }, /* (43) matchChain ::= UQSTRING LEFT_PARENTHESIS node link node RIGHT_PARENTHESIS */
+  {   70,    0 }, /* (44) multipleCreateClause ::= */
+  {   70,   -1 }, /* (45) multipleCreateClause ::= createClauses */
+  {   86,   -1 }, /* (46) createClauses ::= createClause */
+  {   86,   -2 }, /* (47) createClauses ::= createClauses createClause */
+  {   87,   -2 }, /* (48) createClause ::= CREATE chains */
+  {   72,   -8 }, /* (49) indexClause ::= indexOpToken INDEX ON indexLabel LEFT_PARENTHESIS indexProps RIGHT_PARENTHESIS indexType */
+  {   72,  -10 }, /* (50) indexClause ::= indexOpToken INDEX ON LEFT_BRACKET indexLabel RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS indexType */
+  {   92,    0 }, /* (51) indexType ::= */
+  {   92,   -2 }, /* (52) indexType ::= UQSTRING UQSTRING */
+  {   89,   -1 }, /* (53) indexOpToken ::= CREATE */
+  {   89,   -1 }, /* (54) indexOpToken ::= DROP */
+  {   90,   -2 }, /* (55) indexLabel ::= COLON UQSTRING */
+  {   91,   -1 }, /* (56) indexProps ::= UQSTRING */
+  {   91,   -3 }, /* (57) indexProps ::= indexProps COMMA UQSTRING */
+  {   73,   -2 }, /* (58) mergeClause ::= MERGE chain */
+  {   66,   -2 }, /* (59) setClause ::= SET setList */
+  {   93,   -1 }, /* (60) setList ::= setElement */
+  {   93,   -3 }, /* (61) setList ::= setList COMMA setElement */
+  {   94,   -3 }, /* (62) setElement ::= variable EQ arithmetic_expression */
+  {   83,   -1 }, /* (63) chain ::= node */
+  {   83,   -3 }, /* (64) chain ::= chain link node */
+  {   88,   -1 }, /* (65) chains ::= chain */
+  {   88,   -3 }, /* (66) chains ::= chains COMMA chain */
+  {   67,   -2 }, /* (67) deleteClause ::= DELETE deleteExpression */
+  {   97,   -1 }, /* (68) deleteExpression ::= UQSTRING */
+  {   97,   -3 }, /* (69) deleteExpression ::= deleteExpression COMMA UQSTRING */
+  {   84,   -6 }, /* (70) node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
+  {   84,   -5 }, /* (71) node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
+  {   84,   -4 }, /* (72) node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
+  {   84,   -3 }, /* (73) node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
+  {   85,   -3 }, /* (74) link ::= DASH edge RIGHT_ARROW */
+  {   85,   -3 }, /* (75) link ::= LEFT_ARROW edge DASH */
+  {   99,   -4 }, /* (76) edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET */
+  {   99,   -4 }, /* (77) edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
+  {   99,   -5 }, /* (78) edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET */
+  {   99,   -5 }, /* (79) edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET */
+  {  102,   -2 }, /* (80) edgeLabel ::= COLON UQSTRING */
+  {  101,   -1 }, /* (81) edgeLabels ::= edgeLabel */
+  {  101,   -3 }, /* (82) edgeLabels ::= edgeLabels PIPE edgeLabel */
+  {  100,    0 }, /* (83) edgeLength ::= */
+  {  100,   -4 }, /* (84) edgeLength ::= MUL INTEGER DOTDOT INTEGER */
+  {  100,   -3 }, /* (85) edgeLength ::= MUL INTEGER DOTDOT */
+  {  100,   -3 }, /* (86) edgeLength ::= MUL DOTDOT INTEGER */
+  {  100,   -2 }, /* (87) edgeLength ::= MUL INTEGER */
+  {  100,   -1 }, /* (88) edgeLength ::= MUL */
+  {   98,    0 }, /* (89) properties ::= */
+  {   98,   -3 }, /* (90) properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
+  {  103,   -3 }, /* (91) mapLiteral ::= UQSTRING COLON mapValue */
+  {  103,   -5 }, /* (92) mapLiteral ::= UQSTRING COLON mapValue COMMA mapLiteral */
+  {  104,   -1 }, /* (93) mapValue ::= value */
+  {  104,   -2 }, /* (94) mapValue ::= DOLLAR UQSTRING */
+  {   69,    0 }, /* (95) whereClause ::= */
+  {   69,   -2 }, /* (96) whereClause ::= WHERE cond */
+  {  106,   -3 }, /* (97) cond ::= arithmetic_expression relation arithmetic_expression */
+  {  106,   -3 }, /* (98) cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
+  {  106,   -3 }, /* (99) cond ::= cond AND cond */
+  {  106,   -3 }, /* (100) cond ::= cond OR cond */
+  {   64,   -2 }, /* (101) returnClause ::= RETURN returnElements */
+  {   64,   -3 }, /* (102) returnClause ::= RETURN DISTINCT returnElements */
+  {   64,   -2 }, /* (103) returnClause ::= RETURN MUL */
+  {   64,   -3 }, /* (104) returnClause ::= RETURN DISTINCT MUL */
+  {  108,   -3 }, /* (105) returnElements ::= returnElements COMMA returnElement */
+  {  108,   -1 }, /* (106) returnElements ::= returnElement */
+  {  109,   -1 }, /* (107) returnElement ::= arithmetic_expression */
+  {  109,   -3 }, /* (108) returnElement ::= arithmetic_expression AS UQSTRING */
+  {   60,   -2 }, /* (109) withClause ::= WITH withElements */
+  {  110,   -1 }, /* (110) withElements ::= withElement */
+  {  110,   -3 }, /* (111) withElements ::= withElements COMMA withElement */
+  {  111,   -3 }, /* (112) withElement ::= arithmetic_expression AS UQSTRING */
+  {   96,   -3 }, /* (113) arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
+  {   96,   -3 }, /* (114) arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
+  {   96,   -3 }, /* (115) arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
+  {   96,   -3 }, /* (116) arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
+  {   96,   -3 }, /* (117) arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
+  {   96,   -4 }, /* (118) arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
+  {   96,   -1 }, /* (119) arithmetic_expression ::= value */
+  {   96,   -2 }, /* (120) arithmetic_expression ::= DOLLAR UQSTRING */
+  {   96,   -1 }, /* (121) arithmetic_expression ::= variable */
+  {  112,    0 }, /* (122) arithmetic_expression_list ::= */
+  {  112,   -3 }, /* (123) arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
+  {  112,   -1 }, /* (124) arithmetic_expression_list ::= arithmetic_expression */
+  {   95,   -1 }, /* (125) variable ::= UQSTRING */
+  {   95,   -3 }, /* (126) variable ::= UQSTRING DOT UQSTRING */
+  {   65,    0 }, /* (127) orderClause ::= */
+  {   65,   -3 }, /* (128) orderClause ::= ORDER BY arithmetic_expression_list */
+  {   65,   -4 }, /* (129) orderClause ::= ORDER BY arithmetic_expression_list ASC */
+  {   65,   -4 }, /* (130) orderClause ::= ORDER BY arithmetic_expression_list DESC */
+  {   62,    0 }, /* (131) skipClause ::= */
+  {   62,   -2 }, /* (132) skipClause ::= SKIP INTEGER */
+  {   62,   -3 }, /* (133) skipClause ::= SKIP DOLLAR UQSTRING */
+  {   63,    0 }, /* (134) limitClause ::= */
+  {   63,   -2 }, /* (135) limitClause ::= LIMIT INTEGER */
+  {   63,   -3 }, /* (136) limitClause ::= LIMIT DOLLAR UQSTRING */
+  {   71,   -6 }, /* (137) unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING */
+  {  107,   -1 }, /* (138) relation ::= EQ */
+  {  107,   -1 }, /* (139) relation ::= GT */
+  {  107,   -1 }, /* (140) relation ::= LT */
+  {  107,   -1 }, /* (141) relation ::= LE */
+  {  107,   -1 }, /* (142) relation ::= GE */
+  {  107,   -1 }, /* (143) relation ::= NE */
+  {  105,   -1 }, /* (144) value ::= INTEGER */
+  {  105,   -2 }, /* (145) value ::= DASH INTEGER */
+  {  105,   -1 }, /* (146) value ::= STRING */
+  {  105,   -1 }, /* (147) value ::= FLOAT */
+  {  105,   -2 }, /* (148) value ::= DASH FLOAT */
+  {  105,   -1 }, /* (149) value ::= TRUE */
+  {  105,   -1 }, /* (150) value ::= FALSE */
+  {  105,   -1 }, /* (151) value ::= NULLVAL */
 };
 
 static void yy_accept(yyParser*);  /* Forward Declaration */
@@ -1384,243 +1429,243 @@ static void yy_reduce(
 /********** Begin reduce actions **********************************************/
         YYMINORTYPE yylhsminor;
       case 0: /* query ::= expressions */
-#line 43 "grammar.y"
-{ ctx->root = yymsp[0].minor.yy121; }
-#line 1390 "grammar.c"
+#line 44 "grammar.y"
+{ ctx->root = yymsp[0].minor.yy65; }
+#line 1435 "grammar.c"
         break;
       case 1: /* expressions ::= expr */
-#line 47 "grammar.y"
+#line 48 "grammar.y"
 {
-	yylhsminor.yy121 = array_new(AST*, 1);
-	yylhsminor.yy121 = array_append(yylhsminor.yy121, yymsp[0].minor.yy31);
+	yylhsminor.yy65 = array_new(AST*, 1);
+	yylhsminor.yy65 = array_append(yylhsminor.yy65, yymsp[0].minor.yy27);
 }
-#line 1398 "grammar.c"
-  yymsp[0].minor.yy121 = yylhsminor.yy121;
+#line 1443 "grammar.c"
+  yymsp[0].minor.yy65 = yylhsminor.yy65;
         break;
       case 2: /* expressions ::= expressions withClause singlePartQuery */
-#line 52 "grammar.y"
+#line 53 "grammar.y"
 {
-	AST *ast = yymsp[-2].minor.yy121[array_len(yymsp[-2].minor.yy121)-1];
-	ast->withNode = yymsp[-1].minor.yy168;
-	yylhsminor.yy121 = array_append(yymsp[-2].minor.yy121, yymsp[0].minor.yy31);
-	yylhsminor.yy121=yymsp[-2].minor.yy121;
+	AST *ast = yymsp[-2].minor.yy65[array_len(yymsp[-2].minor.yy65)-1];
+	ast->withNode = yymsp[-1].minor.yy210;
+	yylhsminor.yy65 = array_append(yymsp[-2].minor.yy65, yymsp[0].minor.yy27);
+	yylhsminor.yy65=yymsp[-2].minor.yy65;
 }
-#line 1409 "grammar.c"
-  yymsp[-2].minor.yy121 = yylhsminor.yy121;
+#line 1454 "grammar.c"
+  yymsp[-2].minor.yy65 = yylhsminor.yy65;
         break;
       case 3: /* singlePartQuery ::= expr */
-#line 60 "grammar.y"
+#line 61 "grammar.y"
 {
-	yylhsminor.yy31 = yymsp[0].minor.yy31;
+	yylhsminor.yy27 = yymsp[0].minor.yy27;
 }
-#line 1417 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1462 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 4: /* singlePartQuery ::= skipClause limitClause returnClause orderClause */
-#line 64 "grammar.y"
+#line 65 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy120, yymsp[0].minor.yy196, yymsp[-3].minor.yy147, yymsp[-2].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy98, yymsp[0].minor.yy160, yymsp[-3].minor.yy71, yymsp[-2].minor.yy19, NULL, NULL, NULL);
 }
-#line 1425 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1470 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 5: /* singlePartQuery ::= limitClause returnClause orderClause */
-#line 68 "grammar.y"
+#line 69 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy120, yymsp[0].minor.yy196, NULL, yymsp[-2].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy98, yymsp[0].minor.yy160, NULL, yymsp[-2].minor.yy19, NULL, NULL, NULL);
 }
-#line 1433 "grammar.c"
-  yymsp[-2].minor.yy31 = yylhsminor.yy31;
+#line 1478 "grammar.c"
+  yymsp[-2].minor.yy27 = yylhsminor.yy27;
         break;
       case 6: /* singlePartQuery ::= skipClause returnClause orderClause */
-#line 72 "grammar.y"
+#line 73 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy120, yymsp[0].minor.yy196, yymsp[-2].minor.yy147, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy98, yymsp[0].minor.yy160, yymsp[-2].minor.yy71, NULL, NULL, NULL, NULL);
 }
-#line 1441 "grammar.c"
-  yymsp[-2].minor.yy31 = yylhsminor.yy31;
+#line 1486 "grammar.c"
+  yymsp[-2].minor.yy27 = yylhsminor.yy27;
         break;
       case 7: /* singlePartQuery ::= returnClause orderClause skipClause limitClause */
-#line 76 "grammar.y"
+#line 77 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy120, yymsp[-2].minor.yy196, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy98, yymsp[-2].minor.yy160, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, NULL, NULL);
 }
-#line 1449 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1494 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 8: /* singlePartQuery ::= orderClause skipClause limitClause returnClause */
-#line 80 "grammar.y"
+#line 81 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy120, yymsp[-3].minor.yy196, yymsp[-2].minor.yy147, yymsp[-1].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy98, yymsp[-3].minor.yy160, yymsp[-2].minor.yy71, yymsp[-1].minor.yy19, NULL, NULL, NULL);
 }
-#line 1457 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1502 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 9: /* singlePartQuery ::= orderClause skipClause limitClause setClause */
-#line 84 "grammar.y"
+#line 85 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, yymsp[0].minor.yy44, NULL, NULL, yymsp[-3].minor.yy196, yymsp[-2].minor.yy147, yymsp[-1].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, yymsp[0].minor.yy46, NULL, NULL, yymsp[-3].minor.yy160, yymsp[-2].minor.yy71, yymsp[-1].minor.yy19, NULL, NULL, NULL);
 }
-#line 1465 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1510 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 10: /* singlePartQuery ::= orderClause skipClause limitClause deleteClause */
-#line 88 "grammar.y"
+#line 89 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy47, NULL, yymsp[-3].minor.yy196, yymsp[-2].minor.yy147, yymsp[-1].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy59, NULL, yymsp[-3].minor.yy160, yymsp[-2].minor.yy71, yymsp[-1].minor.yy19, NULL, NULL, NULL);
 }
-#line 1473 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1518 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 11: /* expr ::= multipleMatchClause whereClause multipleCreateClause returnClause orderClause skipClause limitClause */
-#line 93 "grammar.y"
+#line 94 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-6].minor.yy173, yymsp[-5].minor.yy3, yymsp[-4].minor.yy4, NULL, NULL, NULL, yymsp[-3].minor.yy120, yymsp[-2].minor.yy196, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(yymsp[-6].minor.yy119, yymsp[-5].minor.yy81, yymsp[-4].minor.yy154, NULL, NULL, NULL, yymsp[-3].minor.yy98, yymsp[-2].minor.yy160, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, NULL, NULL);
 }
-#line 1481 "grammar.c"
-  yymsp[-6].minor.yy31 = yylhsminor.yy31;
+#line 1526 "grammar.c"
+  yymsp[-6].minor.yy27 = yylhsminor.yy27;
         break;
       case 12: /* expr ::= multipleMatchClause whereClause multipleCreateClause */
-#line 97 "grammar.y"
+#line 98 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-2].minor.yy173, yymsp[-1].minor.yy3, yymsp[0].minor.yy4, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(yymsp[-2].minor.yy119, yymsp[-1].minor.yy81, yymsp[0].minor.yy154, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1489 "grammar.c"
-  yymsp[-2].minor.yy31 = yylhsminor.yy31;
+#line 1534 "grammar.c"
+  yymsp[-2].minor.yy27 = yylhsminor.yy27;
         break;
       case 13: /* expr ::= multipleMatchClause whereClause deleteClause */
-#line 101 "grammar.y"
+#line 102 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-2].minor.yy173, yymsp[-1].minor.yy3, NULL, NULL, NULL, yymsp[0].minor.yy47, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(yymsp[-2].minor.yy119, yymsp[-1].minor.yy81, NULL, NULL, NULL, yymsp[0].minor.yy59, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1497 "grammar.c"
-  yymsp[-2].minor.yy31 = yylhsminor.yy31;
+#line 1542 "grammar.c"
+  yymsp[-2].minor.yy27 = yylhsminor.yy27;
         break;
       case 14: /* expr ::= multipleMatchClause whereClause setClause */
-#line 105 "grammar.y"
+#line 106 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-2].minor.yy173, yymsp[-1].minor.yy3, NULL, NULL, yymsp[0].minor.yy44, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(yymsp[-2].minor.yy119, yymsp[-1].minor.yy81, NULL, NULL, yymsp[0].minor.yy46, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1505 "grammar.c"
-  yymsp[-2].minor.yy31 = yylhsminor.yy31;
+#line 1550 "grammar.c"
+  yymsp[-2].minor.yy27 = yylhsminor.yy27;
         break;
       case 15: /* expr ::= multipleMatchClause whereClause setClause returnClause orderClause skipClause limitClause */
-#line 109 "grammar.y"
+#line 110 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-6].minor.yy173, yymsp[-5].minor.yy3, NULL, NULL, yymsp[-4].minor.yy44, NULL, yymsp[-3].minor.yy120, yymsp[-2].minor.yy196, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(yymsp[-6].minor.yy119, yymsp[-5].minor.yy81, NULL, NULL, yymsp[-4].minor.yy46, NULL, yymsp[-3].minor.yy98, yymsp[-2].minor.yy160, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, NULL, NULL);
 }
-#line 1513 "grammar.c"
-  yymsp[-6].minor.yy31 = yylhsminor.yy31;
+#line 1558 "grammar.c"
+  yymsp[-6].minor.yy27 = yylhsminor.yy27;
         break;
       case 16: /* expr ::= multipleCreateClause */
-#line 113 "grammar.y"
+#line 114 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, yymsp[0].minor.yy4, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, yymsp[0].minor.yy154, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1521 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1566 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 17: /* expr ::= unwindClause multipleCreateClause */
-#line 117 "grammar.y"
+#line 118 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, yymsp[0].minor.yy4, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy97, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, yymsp[0].minor.yy154, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-1].minor.yy63, NULL);
 }
-#line 1529 "grammar.c"
-  yymsp[-1].minor.yy31 = yylhsminor.yy31;
+#line 1574 "grammar.c"
+  yymsp[-1].minor.yy27 = yylhsminor.yy27;
         break;
       case 18: /* expr ::= indexClause */
-#line 121 "grammar.y"
+#line 122 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy169, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy58, NULL, NULL);
 }
-#line 1537 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1582 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 19: /* expr ::= mergeClause */
-#line 125 "grammar.y"
+#line 126 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, yymsp[0].minor.yy164, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, yymsp[0].minor.yy166, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1545 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1590 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 20: /* expr ::= mergeClause setClause */
-#line 129 "grammar.y"
+#line 130 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, yymsp[-1].minor.yy164, yymsp[0].minor.yy44, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, yymsp[-1].minor.yy166, yymsp[0].minor.yy46, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1553 "grammar.c"
-  yymsp[-1].minor.yy31 = yylhsminor.yy31;
+#line 1598 "grammar.c"
+  yymsp[-1].minor.yy27 = yylhsminor.yy27;
         break;
       case 21: /* expr ::= returnClause */
-#line 133 "grammar.y"
+#line 134 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy120, NULL, NULL, NULL, NULL, NULL, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy98, NULL, NULL, NULL, NULL, NULL, NULL);
 }
-#line 1561 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1606 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 22: /* expr ::= unwindClause returnClause skipClause limitClause */
-#line 137 "grammar.y"
+#line 138 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-2].minor.yy120, NULL, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, yymsp[-3].minor.yy97, NULL);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, yymsp[-2].minor.yy98, NULL, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, yymsp[-3].minor.yy63, NULL);
 }
-#line 1569 "grammar.c"
-  yymsp[-3].minor.yy31 = yylhsminor.yy31;
+#line 1614 "grammar.c"
+  yymsp[-3].minor.yy27 = yylhsminor.yy27;
         break;
       case 23: /* expr ::= procedureCallClause */
-#line 143 "grammar.y"
+#line 144 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy157);
+	yylhsminor.yy27 = AST_New(NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, yymsp[0].minor.yy111);
 }
-#line 1577 "grammar.c"
-  yymsp[0].minor.yy31 = yylhsminor.yy31;
+#line 1622 "grammar.c"
+  yymsp[0].minor.yy27 = yylhsminor.yy27;
         break;
       case 24: /* expr ::= procedureCallClause whereClause returnClause orderClause skipClause limitClause */
-#line 147 "grammar.y"
+#line 148 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(NULL, yymsp[-4].minor.yy3, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy120, yymsp[-2].minor.yy196, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, NULL, yymsp[-5].minor.yy157);
+	yylhsminor.yy27 = AST_New(NULL, yymsp[-4].minor.yy81, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy98, yymsp[-2].minor.yy160, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, NULL, yymsp[-5].minor.yy111);
 }
-#line 1585 "grammar.c"
-  yymsp[-5].minor.yy31 = yylhsminor.yy31;
+#line 1630 "grammar.c"
+  yymsp[-5].minor.yy27 = yylhsminor.yy27;
         break;
       case 25: /* expr ::= procedureCallClause multipleMatchClause whereClause returnClause orderClause skipClause limitClause */
-#line 151 "grammar.y"
+#line 152 "grammar.y"
 {
-	yylhsminor.yy31 = AST_New(yymsp[-5].minor.yy173, yymsp[-4].minor.yy3, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy120, yymsp[-2].minor.yy196, yymsp[-1].minor.yy147, yymsp[0].minor.yy39, NULL, NULL, yymsp[-6].minor.yy157);
+	yylhsminor.yy27 = AST_New(yymsp[-5].minor.yy119, yymsp[-4].minor.yy81, NULL, NULL, NULL, NULL, yymsp[-3].minor.yy98, yymsp[-2].minor.yy160, yymsp[-1].minor.yy71, yymsp[0].minor.yy19, NULL, NULL, yymsp[-6].minor.yy111);
 }
-#line 1593 "grammar.c"
-  yymsp[-6].minor.yy31 = yylhsminor.yy31;
+#line 1638 "grammar.c"
+  yymsp[-6].minor.yy27 = yylhsminor.yy27;
         break;
       case 26: /* procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS YIELD unquotedStringList */
-#line 156 "grammar.y"
+#line 157 "grammar.y"
 {
-	yymsp[-6].minor.yy157 = New_AST_ProcedureCallNode(yymsp[-5].minor.yy129, yymsp[-3].minor.yy5, yymsp[0].minor.yy5);
+	yymsp[-6].minor.yy111 = New_AST_ProcedureCallNode(yymsp[-5].minor.yy219, yymsp[-3].minor.yy145, yymsp[0].minor.yy145);
 }
-#line 1601 "grammar.c"
+#line 1646 "grammar.c"
         break;
       case 27: /* procedureCallClause ::= CALL procedureName LEFT_PARENTHESIS stringList RIGHT_PARENTHESIS */
-#line 160 "grammar.y"
+#line 161 "grammar.y"
 {	
-	yymsp[-4].minor.yy157 = New_AST_ProcedureCallNode(yymsp[-3].minor.yy129, yymsp[-1].minor.yy5, NULL);
+	yymsp[-4].minor.yy111 = New_AST_ProcedureCallNode(yymsp[-3].minor.yy219, yymsp[-1].minor.yy145, NULL);
 }
-#line 1608 "grammar.c"
+#line 1653 "grammar.c"
         break;
       case 28: /* procedureName ::= unquotedStringList */
-#line 165 "grammar.y"
+#line 166 "grammar.y"
 {
 	// Concatenate strings with dots.
 	// Determine required string length.
 	int buffLen = 0;
-	for(int i = 0; i < array_len(yymsp[0].minor.yy5); i++) {
-		buffLen += strlen(yymsp[0].minor.yy5[i]) + 1;
+	for(int i = 0; i < array_len(yymsp[0].minor.yy145); i++) {
+		buffLen += strlen(yymsp[0].minor.yy145[i]) + 1;
 	}
 
 	int offset = 0;
 	char *procedure_name = malloc(buffLen);
-	for(int i = 0; i < array_len(yymsp[0].minor.yy5); i++) {
-		int n = strlen(yymsp[0].minor.yy5[i]);
-		memcpy(procedure_name + offset, yymsp[0].minor.yy5[i], n);
+	for(int i = 0; i < array_len(yymsp[0].minor.yy145); i++) {
+		int n = strlen(yymsp[0].minor.yy145[i]);
+		memcpy(procedure_name + offset, yymsp[0].minor.yy145[i], n);
 		offset += n;
 		procedure_name[offset] = '.';
 		offset++;
@@ -1629,804 +1674,912 @@ static void yy_reduce(
 	// Discard last dot and trerminate string.
 	offset--;
 	procedure_name[offset] = '\0';
-	yylhsminor.yy129 = procedure_name;
+	yylhsminor.yy219 = procedure_name;
 }
-#line 1635 "grammar.c"
-  yymsp[0].minor.yy129 = yylhsminor.yy129;
+#line 1680 "grammar.c"
+  yymsp[0].minor.yy219 = yylhsminor.yy219;
         break;
       case 29: /* stringList ::= */
-#line 190 "grammar.y"
+#line 191 "grammar.y"
 {
-	yymsp[1].minor.yy5 = array_new(char*, 0);
+	yymsp[1].minor.yy145 = array_new(char*, 0);
 }
-#line 1643 "grammar.c"
+#line 1688 "grammar.c"
         break;
       case 30: /* stringList ::= STRING */
       case 32: /* unquotedStringList ::= UQSTRING */ yytestcase(yyruleno==32);
-#line 194 "grammar.y"
+#line 195 "grammar.y"
 {
-	yylhsminor.yy5 = array_new(char*, 1);
-	yylhsminor.yy5 = array_append(yylhsminor.yy5, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy145 = array_new(char*, 1);
+	yylhsminor.yy145 = array_append(yylhsminor.yy145, yymsp[0].minor.yy0.strval);
 }
-#line 1652 "grammar.c"
-  yymsp[0].minor.yy5 = yylhsminor.yy5;
+#line 1697 "grammar.c"
+  yymsp[0].minor.yy145 = yylhsminor.yy145;
         break;
       case 31: /* stringList ::= stringList delimiter STRING */
       case 33: /* unquotedStringList ::= unquotedStringList delimiter UQSTRING */ yytestcase(yyruleno==33);
-#line 200 "grammar.y"
+#line 201 "grammar.y"
 {
-	yymsp[-2].minor.yy5 = array_append(yymsp[-2].minor.yy5, yymsp[0].minor.yy0.strval);
-	yylhsminor.yy5 = yymsp[-2].minor.yy5;
+	yymsp[-2].minor.yy145 = array_append(yymsp[-2].minor.yy145, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy145 = yymsp[-2].minor.yy145;
 }
-#line 1662 "grammar.c"
-  yymsp[-2].minor.yy5 = yylhsminor.yy5;
+#line 1707 "grammar.c"
+  yymsp[-2].minor.yy145 = yylhsminor.yy145;
         break;
       case 34: /* delimiter ::= COMMA */
-#line 218 "grammar.y"
-{ yymsp[0].minor.yy6 = COMMA; }
-#line 1668 "grammar.c"
+#line 219 "grammar.y"
+{ yymsp[0].minor.yy86 = COMMA; }
+#line 1713 "grammar.c"
         break;
       case 35: /* delimiter ::= DOT */
-#line 219 "grammar.y"
-{ yymsp[0].minor.yy6 = DOT; }
-#line 1673 "grammar.c"
+#line 220 "grammar.y"
+{ yymsp[0].minor.yy86 = DOT; }
+#line 1718 "grammar.c"
         break;
       case 36: /* multipleMatchClause ::= matchClauses */
-#line 222 "grammar.y"
+#line 223 "grammar.y"
 {
-	yylhsminor.yy173 = New_AST_MatchNode(yymsp[0].minor.yy210);
+	yylhsminor.yy119 = New_AST_MatchNode(yymsp[0].minor.yy60);
 }
-#line 1680 "grammar.c"
-  yymsp[0].minor.yy173 = yylhsminor.yy173;
+#line 1725 "grammar.c"
+  yymsp[0].minor.yy119 = yylhsminor.yy119;
         break;
       case 37: /* matchClauses ::= matchClause */
-      case 42: /* createClauses ::= createClause */ yytestcase(yyruleno==42);
-#line 228 "grammar.y"
+      case 42: /* matchChain ::= chain */ yytestcase(yyruleno==42);
+      case 46: /* createClauses ::= createClause */ yytestcase(yyruleno==46);
+#line 229 "grammar.y"
 {
-	yylhsminor.yy210 = yymsp[0].minor.yy210;
+	yylhsminor.yy60 = yymsp[0].minor.yy60;
 }
-#line 1689 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 1735 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
       case 38: /* matchClauses ::= matchClauses matchClause */
-      case 43: /* createClauses ::= createClauses createClause */ yytestcase(yyruleno==43);
-#line 232 "grammar.y"
+      case 47: /* createClauses ::= createClauses createClause */ yytestcase(yyruleno==47);
+#line 233 "grammar.y"
 {
 	Vector *v;
-	while(Vector_Pop(yymsp[0].minor.yy210, &v)) Vector_Push(yymsp[-1].minor.yy210, v);
-	Vector_Free(yymsp[0].minor.yy210);
-	yylhsminor.yy210 = yymsp[-1].minor.yy210;
+	while(Vector_Pop(yymsp[0].minor.yy60, &v)) Vector_Push(yymsp[-1].minor.yy60, v);
+	Vector_Free(yymsp[0].minor.yy60);
+	yylhsminor.yy60 = yymsp[-1].minor.yy60;
 }
-#line 1701 "grammar.c"
-  yymsp[-1].minor.yy210 = yylhsminor.yy210;
+#line 1747 "grammar.c"
+  yymsp[-1].minor.yy60 = yylhsminor.yy60;
         break;
-      case 39: /* matchClause ::= MATCH chains */
-      case 44: /* createClause ::= CREATE chains */ yytestcase(yyruleno==44);
-#line 241 "grammar.y"
+      case 39: /* matchClause ::= MATCH matchChains */
+      case 48: /* createClause ::= CREATE chains */ yytestcase(yyruleno==48);
+#line 242 "grammar.y"
 {
-	yymsp[-1].minor.yy210 = yymsp[0].minor.yy210;
+	yymsp[-1].minor.yy60 = yymsp[0].minor.yy60;
 }
-#line 1710 "grammar.c"
+#line 1756 "grammar.c"
         break;
-      case 40: /* multipleCreateClause ::= */
-#line 246 "grammar.y"
+      case 40: /* matchChains ::= matchChain */
+      case 65: /* chains ::= chain */ yytestcase(yyruleno==65);
+#line 248 "grammar.y"
 {
-	yymsp[1].minor.yy4 = NULL;
+	yylhsminor.yy60 = NewVector(Vector*, 1);
+	Vector_Push(yylhsminor.yy60, yymsp[0].minor.yy60);
 }
-#line 1717 "grammar.c"
+#line 1765 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
-      case 41: /* multipleCreateClause ::= createClauses */
-#line 250 "grammar.y"
+      case 41: /* matchChains ::= matchChains COMMA matchChain */
+      case 66: /* chains ::= chains COMMA chain */ yytestcase(yyruleno==66);
+#line 253 "grammar.y"
 {
-	yylhsminor.yy4 = New_AST_CreateNode(yymsp[0].minor.yy210);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[0].minor.yy60);
+	yylhsminor.yy60 = yymsp[-2].minor.yy60;
 }
-#line 1724 "grammar.c"
-  yymsp[0].minor.yy4 = yylhsminor.yy4;
+#line 1775 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 45: /* indexClause ::= indexOpToken INDEX ON indexLabel indexProp */
-#line 276 "grammar.y"
+      case 43: /* matchChain ::= UQSTRING LEFT_PARENTHESIS node link node RIGHT_PARENTHESIS */
+#line 264 "grammar.y"
 {
-  yylhsminor.yy169 = New_AST_IndexNode(yymsp[-1].minor.yy0.strval, yymsp[0].minor.yy0.strval, yymsp[-4].minor.yy177);
+	if(strcasecmp(yymsp[-5].minor.yy0.strval, "shortestPath") == 0) {
+		yymsp[-2].minor.yy37->selector = N_PATH_SHORTEST;
+	} else if(strcasecmp(yymsp[-5].minor.yy0.strval, "allShortestPaths") == 0) {
+		yymsp[-2].minor.yy37->selector = N_PATH_ALL_SHORTEST;
+	} else if(ctx->ok) {
+		ctx->ok = 0;
+		asprintf(&ctx->errorMsg, "Unknown path function '%s'", yymsp[-5].minor.yy0.strval);
+	}
+	free(yymsp[-5].minor.yy0.strval);
+
+	yylhsminor.yy60 = NewVector(AST_GraphEntity*, 3);
+	Vector_Push(yylhsminor.yy60, yymsp[-3].minor.yy181);
+	Vector_Push(yylhsminor.yy60, yymsp[-2].minor.yy37);
+	Vector_Push(yylhsminor.yy60, yymsp[-1].minor.yy181);
 }
-#line 1732 "grammar.c"
-  yymsp[-4].minor.yy169 = yylhsminor.yy169;
+#line 1796 "grammar.c"
+  yymsp[-5].minor.yy60 = yylhsminor.yy60;
         break;
-      case 46: /* indexOpToken ::= CREATE */
+      case 44: /* multipleCreateClause ::= */
 #line 282 "grammar.y"
-{ yymsp[0].minor.yy177 = CREATE_INDEX; }
-#line 1738 "grammar.c"
+{
+	yymsp[1].minor.yy154 = NULL;
+}
+#line 1804 "grammar.c"
         break;
-      case 47: /* indexOpToken ::= DROP */
-#line 283 "grammar.y"
-{ yymsp[0].minor.yy177 = DROP_INDEX; }
-#line 1743 "grammar.c"
+      case 45: /* multipleCreateClause ::= createClauses */
+#line 286 "grammar.y"
+{
+	yylhsminor.yy154 = New_AST_CreateNode(yymsp[0].minor.yy60);
+}
+#line 1811 "grammar.c"
+  yymsp[0].minor.yy154 = yylhsminor.yy154;
         break;
-      case 48: /* indexLabel ::= COLON UQSTRING */
-#line 285 "grammar.y"
+      case 49: /* indexClause ::= indexOpToken INDEX ON indexLabel LEFT_PARENTHESIS indexProps RIGHT_PARENTHESIS indexType */
+#line 312 "grammar.y"
 {
-  yymsp[-1].minor.yy0 = yymsp[0].minor.yy0;
+  yylhsminor.yy58 = New_AST_IndexNode(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy145, N_ENTITY, yymsp[-7].minor.yy49, yymsp[0].minor.yy47);
 }
-#line 1750 "grammar.c"
+#line 1819 "grammar.c"
+  yymsp[-7].minor.yy58 = yylhsminor.yy58;
         break;
-      case 49: /* indexProp ::= LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS */
-#line 289 "grammar.y"
+      case 50: /* indexClause ::= indexOpToken INDEX ON LEFT_BRACKET indexLabel RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING RIGHT_PARENTHESIS indexType */
+#line 317 "grammar.y"
 {
-  yymsp[-2].minor.yy0 = yymsp[-1].minor.yy0;
+  char **properties = array_new(char*, 1);
+  properties = array_append(properties, yymsp[-2].minor.yy0.strval);
+  yylhsminor.yy58 = New_AST_IndexNode(yymsp[-5].minor.yy0.strval, properties, N_LINK, yymsp[-9].minor.yy49, yymsp[0].minor.yy47);
 }
-#line 1757 "grammar.c"
+#line 1829 "grammar.c"
+  yymsp[-9].minor.yy58 = yylhsminor.yy58;
         break;
-      case 50: /* mergeClause ::= MERGE chain */
-#line 295 "grammar.y"
+      case 51: /* indexType ::= */
+#line 325 "grammar.y"
+{ yymsp[1].minor.yy47 = BTREE_INDEX; }
+#line 1835 "grammar.c"
+        break;
+      case 52: /* indexType ::= UQSTRING UQSTRING */
+#line 328 "grammar.y"
 {
-	yymsp[-1].minor.yy164 = New_AST_MergeNode(yymsp[0].minor.yy210);
+	yylhsminor.yy47 = BTREE_INDEX;
+	if(strcasecmp(yymsp[-1].minor.yy0.strval, "USING") == 0 && strcasecmp(yymsp[0].minor.yy0.strval, "BTREE") == 0) {
+		yylhsminor.yy47 = BTREE_INDEX;
+	} else if(strcasecmp(yymsp[-1].minor.yy0.strval, "USING") == 0 && strcasecmp(yymsp[0].minor.yy0.strval, "HASH") == 0) {
+		yylhsminor.yy47 = HASH_INDEX;
+	} else if(strcasecmp(yymsp[-1].minor.yy0.strval, "USING") == 0 && strcasecmp(yymsp[0].minor.yy0.strval, "SKIPLIST") == 0) {
+		yylhsminor.yy47 = SKIPLIST_INDEX;
+	} else if(ctx->ok) {
+		ctx->ok = 0;
+		asprintf(&ctx->errorMsg, "Unknown index type '%s %s'", yymsp[-1].minor.yy0.strval, yymsp[0].minor.yy0.strval);
+	}
+	free(yymsp[-1].minor.yy0.strval);
+	free(yymsp[0].minor.yy0.strval);
 }
-#line 1764 "grammar.c"
+#line 1854 "grammar.c"
+  yymsp[-1].minor.yy47 = yylhsminor.yy47;
+        break;
+      case 53: /* indexOpToken ::= CREATE */
+#line 346 "grammar.y"
+{ yymsp[0].minor.yy49 = CREATE_INDEX; }
+#line 1860 "grammar.c"
         break;
-      case 51: /* setClause ::= SET setList */
-#line 300 "grammar.y"
+      case 54: /* indexOpToken ::= DROP */
+#line 347 "grammar.y"
+{ yymsp[0].minor.yy49 = DROP_INDEX; }
+#line 1865 "grammar.c"
+        break;
+      case 55: /* indexLabel ::= COLON UQSTRING */
+#line 349 "grammar.y"
 {
-	yymsp[-1].minor.yy44 = New_AST_SetNode(yymsp[0].minor.yy210);
+  yymsp[-1].minor.yy0 = yymsp[0].minor.yy0;
 }
-#line 1771 "grammar.c"
+#line 1872 "grammar.c"
         break;
-      case 52: /* setList ::= setElement */
-#line 305 "grammar.y"
+      case 56: /* indexProps ::= UQSTRING */
+#line 354 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(AST_SetElement*, 1);
-	Vector_Push(yylhsminor.yy210, yymsp[0].minor.yy170);
+  yylhsminor.yy145 = array_new(char*, 1);
+  yylhsminor.yy145 = array_append(yylhsminor.yy145, yymsp[0].minor.yy0.strval);
 }
-#line 1779 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 1880 "grammar.c"
+  yymsp[0].minor.yy145 = yylhsminor.yy145;
         break;
-      case 53: /* setList ::= setList COMMA setElement */
-#line 309 "grammar.y"
+      case 57: /* indexProps ::= indexProps COMMA UQSTRING */
+#line 360 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[0].minor.yy170);
-	yylhsminor.yy210 = yymsp[-2].minor.yy210;
+  yymsp[-2].minor.yy145 = array_append(yymsp[-2].minor.yy145, yymsp[0].minor.yy0.strval);
+  yylhsminor.yy145 = yymsp[-2].minor.yy145;
 }
-#line 1788 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 1889 "grammar.c"
+  yymsp[-2].minor.yy145 = yylhsminor.yy145;
         break;
-      case 54: /* setElement ::= variable EQ arithmetic_expression */
-#line 315 "grammar.y"
+      case 58: /* mergeClause ::= MERGE chain */
+#line 367 "grammar.y"
 {
-	yylhsminor.yy170 = New_AST_SetElement(yymsp[-2].minor.yy156, yymsp[0].minor.yy154);
+	yymsp[-1].minor.yy166 = New_AST_MergeNode(yymsp[0].minor.yy60);
 }
-#line 1796 "grammar.c"
-  yymsp[-2].minor.yy170 = yylhsminor.yy170;
+#line 1897 "grammar.c"
         break;
-      case 55: /* chain ::= node */
-#line 321 "grammar.y"
+      case 59: /* setClause ::= SET setList */
+#line 372 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(AST_GraphEntity*, 1);
-	Vector_Push(yylhsminor.yy210, yymsp[0].minor.yy117);
+	yymsp[-1].minor.yy46 = New_AST_SetNode(yymsp[0].minor.yy60);
 }
-#line 1805 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 1904 "grammar.c"
         break;
-      case 56: /* chain ::= chain link node */
-#line 326 "grammar.y"
+      case 60: /* setList ::= setElement */
+#line 377 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[-1].minor.yy69);
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[0].minor.yy117);
-	yylhsminor.yy210 = yymsp[-2].minor.yy210;
+	yylhsminor.yy60 = NewVector(AST_SetElement*, 1);
+	Vector_Push(yylhsminor.yy60, yymsp[0].minor.yy96);
 }
-#line 1815 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 1912 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
-      case 57: /* chains ::= chain */
-#line 334 "grammar.y"
+      case 61: /* setList ::= setList COMMA setElement */
+#line 381 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(Vector*, 1);
-	Vector_Push(yylhsminor.yy210, yymsp[0].minor.yy210);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[0].minor.yy96);
+	yylhsminor.yy60 = yymsp[-2].minor.yy60;
 }
-#line 1824 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 1921 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 58: /* chains ::= chains COMMA chain */
-#line 339 "grammar.y"
+      case 62: /* setElement ::= variable EQ arithmetic_expression */
+#line 387 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[0].minor.yy210);
-	yylhsminor.yy210 = yymsp[-2].minor.yy210;
+	yylhsminor.yy96 = New_AST_SetElement(yymsp[-2].minor.yy92, yymsp[0].minor.yy90);
 }
-#line 1833 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 1929 "grammar.c"
+  yymsp[-2].minor.yy96 = yylhsminor.yy96;
         break;
-      case 59: /* deleteClause ::= DELETE deleteExpression */
-#line 347 "grammar.y"
+      case 63: /* chain ::= node */
+#line 393 "grammar.y"
 {
-	yymsp[-1].minor.yy47 = New_AST_DeleteNode(yymsp[0].minor.yy210);
+	yylhsminor.yy60 = NewVector(AST_GraphEntity*, 1);
+	Vector_Push(yylhsminor.yy60, yymsp[0].minor.yy181);
 }
-#line 1841 "grammar.c"
+#line 1938 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
-      case 60: /* deleteExpression ::= UQSTRING */
-#line 353 "grammar.y"
+      case 64: /* chain ::= chain link node */
+#line 398 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(char*, 1);
-	Vector_Push(yylhsminor.yy210, yymsp[0].minor.yy0.strval);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[-1].minor.yy37);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[0].minor.yy181);
+	yylhsminor.yy60 = yymsp[-2].minor.yy60;
 }
-#line 1849 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 1948 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 61: /* deleteExpression ::= deleteExpression COMMA UQSTRING */
-#line 358 "grammar.y"
+      case 67: /* deleteClause ::= DELETE deleteExpression */
+#line 419 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[0].minor.yy0.strval);
-	yylhsminor.yy210 = yymsp[-2].minor.yy210;
+	yymsp[-1].minor.yy59 = New_AST_DeleteNode(yymsp[0].minor.yy60);
 }
-#line 1858 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 1956 "grammar.c"
         break;
-      case 62: /* node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
-#line 366 "grammar.y"
+      case 68: /* deleteExpression ::= UQSTRING */
+#line 425 "grammar.y"
 {
-	yymsp[-5].minor.yy117 = New_AST_NodeEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy210);
+	yylhsminor.yy60 = NewVector(char*, 1);
+	Vector_Push(yylhsminor.yy60, yymsp[0].minor.yy0.strval);
 }
-#line 1866 "grammar.c"
+#line 1964 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
-      case 63: /* node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
-#line 371 "grammar.y"
+      case 69: /* deleteExpression ::= deleteExpression COMMA UQSTRING */
+#line 430 "grammar.y"
 {
-	yymsp[-4].minor.yy117 = New_AST_NodeEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy210);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy60 = yymsp[-2].minor.yy60;
 }
-#line 1873 "grammar.c"
+#line 1973 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 64: /* node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
-#line 376 "grammar.y"
+      case 70: /* node ::= LEFT_PARENTHESIS UQSTRING COLON UQSTRING properties RIGHT_PARENTHESIS */
+#line 438 "grammar.y"
 {
-	yymsp[-3].minor.yy117 = New_AST_NodeEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy210);
+	yymsp[-5].minor.yy181 = New_AST_NodeEntity(yymsp[-4].minor.yy0.strval, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy60);
 }
-#line 1880 "grammar.c"
+#line 1981 "grammar.c"
         break;
-      case 65: /* node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
-#line 381 "grammar.y"
+      case 71: /* node ::= LEFT_PARENTHESIS COLON UQSTRING properties RIGHT_PARENTHESIS */
+#line 443 "grammar.y"
+{
+	yymsp[-4].minor.yy181 = New_AST_NodeEntity(NULL, yymsp[-2].minor.yy0.strval, yymsp[-1].minor.yy60);
+}
+#line 1988 "grammar.c"
+        break;
+      case 72: /* node ::= LEFT_PARENTHESIS UQSTRING properties RIGHT_PARENTHESIS */
+#line 448 "grammar.y"
+{
+	yymsp[-3].minor.yy181 = New_AST_NodeEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy60);
+}
+#line 1995 "grammar.c"
+        break;
+      case 73: /* node ::= LEFT_PARENTHESIS properties RIGHT_PARENTHESIS */
+#line 453 "grammar.y"
 {
-	yymsp[-2].minor.yy117 = New_AST_NodeEntity(NULL, NULL, yymsp[-1].minor.yy210);
+	yymsp[-2].minor.yy181 = New_AST_NodeEntity(NULL, NULL, yymsp[-1].minor.yy60);
 }
-#line 1887 "grammar.c"
+#line 2002 "grammar.c"
         break;
-      case 66: /* link ::= DASH edge RIGHT_ARROW */
-#line 388 "grammar.y"
+      case 74: /* link ::= DASH edge RIGHT_ARROW */
+#line 460 "grammar.y"
 {
-	yymsp[-2].minor.yy69 = yymsp[-1].minor.yy69;
-	yymsp[-2].minor.yy69->direction = N_LEFT_TO_RIGHT;
+	yymsp[-2].minor.yy37 = yymsp[-1].minor.yy37;
+	yymsp[-2].minor.yy37->direction = N_LEFT_TO_RIGHT;
 }
-#line 1895 "grammar.c"
+#line 2010 "grammar.c"
         break;
-      case 67: /* link ::= LEFT_ARROW edge DASH */
-#line 394 "grammar.y"
+      case 75: /* link ::= LEFT_ARROW edge DASH */
+#line 466 "grammar.y"
 {
-	yymsp[-2].minor.yy69 = yymsp[-1].minor.yy69;
-	yymsp[-2].minor.yy69->direction = N_RIGHT_TO_LEFT;
+	yymsp[-2].minor.yy37 = yymsp[-1].minor.yy37;
+	yymsp[-2].minor.yy37->direction = N_RIGHT_TO_LEFT;
 }
-#line 1903 "grammar.c"
+#line 2018 "grammar.c"
         break;
-      case 68: /* edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET */
-#line 401 "grammar.y"
+      case 76: /* edge ::= LEFT_BRACKET properties edgeLength RIGHT_BRACKET */
+#line 473 "grammar.y"
 { 
-	yymsp[-3].minor.yy69 = New_AST_LinkEntity(NULL, NULL, yymsp[-2].minor.yy210, N_DIR_UNKNOWN, yymsp[-1].minor.yy138);
+	yymsp[-3].minor.yy37 = New_AST_LinkEntity(NULL, NULL, yymsp[-2].minor.yy60, N_DIR_UNKNOWN, yymsp[-1].minor.yy50);
 }
-#line 1910 "grammar.c"
+#line 2025 "grammar.c"
         break;
-      case 69: /* edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
-#line 406 "grammar.y"
+      case 77: /* edge ::= LEFT_BRACKET UQSTRING properties RIGHT_BRACKET */
+#line 478 "grammar.y"
 { 
-	yymsp[-3].minor.yy69 = New_AST_LinkEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy210, N_DIR_UNKNOWN, NULL);
+	yymsp[-3].minor.yy37 = New_AST_LinkEntity(yymsp[-2].minor.yy0.strval, NULL, yymsp[-1].minor.yy60, N_DIR_UNKNOWN, NULL);
 }
-#line 1917 "grammar.c"
+#line 2032 "grammar.c"
         break;
-      case 70: /* edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET */
-#line 411 "grammar.y"
+      case 78: /* edge ::= LEFT_BRACKET edgeLabels edgeLength properties RIGHT_BRACKET */
+#line 483 "grammar.y"
 { 
-	yymsp[-4].minor.yy69 = New_AST_LinkEntity(NULL, yymsp[-3].minor.yy5, yymsp[-1].minor.yy210, N_DIR_UNKNOWN, yymsp[-2].minor.yy138);
+	yymsp[-4].minor.yy37 = New_AST_LinkEntity(NULL, yymsp[-3].minor.yy145, yymsp[-1].minor.yy60, N_DIR_UNKNOWN, yymsp[-2].minor.yy50);
 }
-#line 1924 "grammar.c"
+#line 2039 "grammar.c"
         break;
-      case 71: /* edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET */
-#line 416 "grammar.y"
+      case 79: /* edge ::= LEFT_BRACKET UQSTRING edgeLabels properties RIGHT_BRACKET */
+#line 488 "grammar.y"
 { 
-	yymsp[-4].minor.yy69 = New_AST_LinkEntity(yymsp[-3].minor.yy0.strval, yymsp[-2].minor.yy5, yymsp[-1].minor.yy210, N_DIR_UNKNOWN, NULL);
+	yymsp[-4].minor.yy37 = New_AST_LinkEntity(yymsp[-3].minor.yy0.strval, yymsp[-2].minor.yy145, yymsp[-1].minor.yy60, N_DIR_UNKNOWN, NULL);
 }
-#line 1931 "grammar.c"
+#line 2046 "grammar.c"
         break;
-      case 72: /* edgeLabel ::= COLON UQSTRING */
-#line 423 "grammar.y"
+      case 80: /* edgeLabel ::= COLON UQSTRING */
+#line 495 "grammar.y"
 {
-	yymsp[-1].minor.yy129 = yymsp[0].minor.yy0.strval;
+	yymsp[-1].minor.yy219 = yymsp[0].minor.yy0.strval;
 }
-#line 1938 "grammar.c"
+#line 2053 "grammar.c"
         break;
-      case 73: /* edgeLabels ::= edgeLabel */
-#line 428 "grammar.y"
+      case 81: /* edgeLabels ::= edgeLabel */
+#line 500 "grammar.y"
 {
-	yylhsminor.yy5 = array_new(char*, 1);
-	yylhsminor.yy5 = array_append(yylhsminor.yy5, yymsp[0].minor.yy129);
+	yylhsminor.yy145 = array_new(char*, 1);
+	yylhsminor.yy145 = array_append(yylhsminor.yy145, yymsp[0].minor.yy219);
 }
-#line 1946 "grammar.c"
-  yymsp[0].minor.yy5 = yylhsminor.yy5;
+#line 2061 "grammar.c"
+  yymsp[0].minor.yy145 = yylhsminor.yy145;
         break;
-      case 74: /* edgeLabels ::= edgeLabels PIPE edgeLabel */
-#line 434 "grammar.y"
+      case 82: /* edgeLabels ::= edgeLabels PIPE edgeLabel */
+#line 506 "grammar.y"
 {
-	char *label = yymsp[0].minor.yy129;
-	yymsp[-2].minor.yy5 = array_append(yymsp[-2].minor.yy5, label);
-	yylhsminor.yy5 = yymsp[-2].minor.yy5;
+	char *label = yymsp[0].minor.yy219;
+	yymsp[-2].minor.yy145 = array_append(yymsp[-2].minor.yy145, label);
+	yylhsminor.yy145 = yymsp[-2].minor.yy145;
 }
-#line 1956 "grammar.c"
-  yymsp[-2].minor.yy5 = yylhsminor.yy5;
+#line 2071 "grammar.c"
+  yymsp[-2].minor.yy145 = yylhsminor.yy145;
         break;
-      case 75: /* edgeLength ::= */
-#line 443 "grammar.y"
+      case 83: /* edgeLength ::= */
+#line 515 "grammar.y"
 {
-	yymsp[1].minor.yy138 = NULL;
+	yymsp[1].minor.yy50 = NULL;
 }
-#line 1964 "grammar.c"
+#line 2079 "grammar.c"
         break;
-      case 76: /* edgeLength ::= MUL INTEGER DOTDOT INTEGER */
-#line 448 "grammar.y"
+      case 84: /* edgeLength ::= MUL INTEGER DOTDOT INTEGER */
+#line 520 "grammar.y"
 {
-	yymsp[-3].minor.yy138 = New_AST_LinkLength(yymsp[-2].minor.yy0.longval, yymsp[0].minor.yy0.longval);
+	yymsp[-3].minor.yy50 = New_AST_LinkLength(yymsp[-2].minor.yy0.longval, yymsp[0].minor.yy0.longval);
 }
-#line 1971 "grammar.c"
+#line 2086 "grammar.c"
         break;
-      case 77: /* edgeLength ::= MUL INTEGER DOTDOT */
-#line 453 "grammar.y"
+      case 85: /* edgeLength ::= MUL INTEGER DOTDOT */
+#line 525 "grammar.y"
 {
-	yymsp[-2].minor.yy138 = New_AST_LinkLength(yymsp[-1].minor.yy0.longval, UINT_MAX-2);
+	yymsp[-2].minor.yy50 = New_AST_LinkLength(yymsp[-1].minor.yy0.longval, UINT_MAX-2);
 }
-#line 1978 "grammar.c"
+#line 2093 "grammar.c"
         break;
-      case 78: /* edgeLength ::= MUL DOTDOT INTEGER */
-#line 458 "grammar.y"
+      case 86: /* edgeLength ::= MUL DOTDOT INTEGER */
+#line 530 "grammar.y"
 {
-	yymsp[-2].minor.yy138 = New_AST_LinkLength(1, yymsp[0].minor.yy0.longval);
+	yymsp[-2].minor.yy50 = New_AST_LinkLength(1, yymsp[0].minor.yy0.longval);
 }
-#line 1985 "grammar.c"
+#line 2100 "grammar.c"
         break;
-      case 79: /* edgeLength ::= MUL INTEGER */
-#line 463 "grammar.y"
+      case 87: /* edgeLength ::= MUL INTEGER */
+#line 535 "grammar.y"
 {
-	yymsp[-1].minor.yy138 = New_AST_LinkLength(yymsp[0].minor.yy0.longval, yymsp[0].minor.yy0.longval);
+	yymsp[-1].minor.yy50 = New_AST_LinkLength(yymsp[0].minor.yy0.longval, yymsp[0].minor.yy0.longval);
 }
-#line 1992 "grammar.c"
+#line 2107 "grammar.c"
         break;
-      case 80: /* edgeLength ::= MUL */
-#line 468 "grammar.y"
+      case 88: /* edgeLength ::= MUL */
+#line 540 "grammar.y"
 {
-	yymsp[0].minor.yy138 = New_AST_LinkLength(1, UINT_MAX-2);
+	yymsp[0].minor.yy50 = New_AST_LinkLength(1, UINT_MAX-2);
 }
-#line 1999 "grammar.c"
+#line 2114 "grammar.c"
         break;
-      case 81: /* properties ::= */
-#line 474 "grammar.y"
+      case 89: /* properties ::= */
+#line 546 "grammar.y"
 {
-	yymsp[1].minor.yy210 = NULL;
+	yymsp[1].minor.yy60 = NULL;
 }
-#line 2006 "grammar.c"
+#line 2121 "grammar.c"
         break;
-      case 82: /* properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
-#line 478 "grammar.y"
+      case 90: /* properties ::= LEFT_CURLY_BRACKET mapLiteral RIGHT_CURLY_BRACKET */
+#line 550 "grammar.y"
 {
-	yymsp[-2].minor.yy210 = yymsp[-1].minor.yy210;
+	yymsp[-2].minor.yy60 = yymsp[-1].minor.yy60;
 }
-#line 2013 "grammar.c"
+#line 2128 "grammar.c"
         break;
-      case 83: /* mapLiteral ::= UQSTRING COLON value */
-#line 484 "grammar.y"
+      case 91: /* mapLiteral ::= UQSTRING COLON mapValue */
+#line 556 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(SIValue*, 2);
+	yylhsminor.yy60 = NewVector(SIValue*, 2);
 
 	SIValue *key = malloc(sizeof(SIValue));
 	*key = SI_ConstStringVal(yymsp[-2].minor.yy0.strval);
-	Vector_Push(yylhsminor.yy210, key);
+	Vector_Push(yylhsminor.yy60, key);
 
 	SIValue *val = malloc(sizeof(SIValue));
 	*val = yymsp[0].minor.yy150;
-	Vector_Push(yylhsminor.yy210, val);
+	Vector_Push(yylhsminor.yy60, val);
 }
-#line 2028 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 2143 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 84: /* mapLiteral ::= UQSTRING COLON value COMMA mapLiteral */
-#line 496 "grammar.y"
+      case 92: /* mapLiteral ::= UQSTRING COLON mapValue COMMA mapLiteral */
+#line 568 "grammar.y"
 {
 	SIValue *key = malloc(sizeof(SIValue));
 	*key = SI_ConstStringVal(yymsp[-4].minor.yy0.strval);
-	Vector_Push(yymsp[0].minor.yy210, key);
+	Vector_Push(yymsp[0].minor.yy60, key);
 
 	SIValue *val = malloc(sizeof(SIValue));
 	*val = yymsp[-2].minor.yy150;
-	Vector_Push(yymsp[0].minor.yy210, val);
+	Vector_Push(yymsp[0].minor.yy60, val);
 	
-	yylhsminor.yy210 = yymsp[0].minor.yy210;
+	yylhsminor.yy60 = yymsp[0].minor.yy60;
+}
+#line 2159 "grammar.c"
+  yymsp[-4].minor.yy60 = yylhsminor.yy60;
+        break;
+      case 93: /* mapValue ::= value */
+#line 581 "grammar.y"
+{ yylhsminor.yy150 = yymsp[0].minor.yy150; }
+#line 2165 "grammar.c"
+  yymsp[0].minor.yy150 = yylhsminor.yy150;
+        break;
+      case 94: /* mapValue ::= DOLLAR UQSTRING */
+#line 583 "grammar.y"
+{
+	yymsp[-1].minor.yy150 = AST_InlineParam(yymsp[0].minor.yy0.strval);
+	ctx->params = array_append(ctx->params, yymsp[0].minor.yy0.strval);
 }
-#line 2044 "grammar.c"
-  yymsp[-4].minor.yy210 = yylhsminor.yy210;
+#line 2174 "grammar.c"
         break;
-      case 85: /* whereClause ::= */
-#line 510 "grammar.y"
+      case 95: /* whereClause ::= */
+#line 590 "grammar.y"
 { 
-	yymsp[1].minor.yy3 = NULL;
+	yymsp[1].minor.yy81 = NULL;
 }
-#line 2052 "grammar.c"
+#line 2181 "grammar.c"
         break;
-      case 86: /* whereClause ::= WHERE cond */
-#line 513 "grammar.y"
+      case 96: /* whereClause ::= WHERE cond */
+#line 593 "grammar.y"
 {
-	yymsp[-1].minor.yy3 = New_AST_WhereNode(yymsp[0].minor.yy10);
+	yymsp[-1].minor.yy81 = New_AST_WhereNode(yymsp[0].minor.yy190);
 }
-#line 2059 "grammar.c"
+#line 2188 "grammar.c"
         break;
-      case 87: /* cond ::= arithmetic_expression relation arithmetic_expression */
-#line 522 "grammar.y"
-{ yylhsminor.yy10 = New_AST_PredicateNode(yymsp[-2].minor.yy154, yymsp[-1].minor.yy6, yymsp[0].minor.yy154); }
-#line 2064 "grammar.c"
-  yymsp[-2].minor.yy10 = yylhsminor.yy10;
+      case 97: /* cond ::= arithmetic_expression relation arithmetic_expression */
+#line 602 "grammar.y"
+{ yylhsminor.yy190 = New_AST_PredicateNode(yymsp[-2].minor.yy90, yymsp[-1].minor.yy86, yymsp[0].minor.yy90); }
+#line 2193 "grammar.c"
+  yymsp[-2].minor.yy190 = yylhsminor.yy190;
         break;
-      case 88: /* cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
-#line 524 "grammar.y"
-{ yymsp[-2].minor.yy10 = yymsp[-1].minor.yy10; }
-#line 2070 "grammar.c"
+      case 98: /* cond ::= LEFT_PARENTHESIS cond RIGHT_PARENTHESIS */
+#line 604 "grammar.y"
+{ yymsp[-2].minor.yy190 = yymsp[-1].minor.yy190; }
+#line 2199 "grammar.c"
         break;
-      case 89: /* cond ::= cond AND cond */
-#line 525 "grammar.y"
-{ yylhsminor.yy10 = New_AST_ConditionNode(yymsp[-2].minor.yy10, AND, yymsp[0].minor.yy10); }
-#line 2075 "grammar.c"
-  yymsp[-2].minor.yy10 = yylhsminor.yy10;
+      case 99: /* cond ::= cond AND cond */
+#line 605 "grammar.y"
+{ yylhsminor.yy190 = New_AST_ConditionNode(yymsp[-2].minor.yy190, AND, yymsp[0].minor.yy190); }
+#line 2204 "grammar.c"
+  yymsp[-2].minor.yy190 = yylhsminor.yy190;
         break;
-      case 90: /* cond ::= cond OR cond */
-#line 526 "grammar.y"
-{ yylhsminor.yy10 = New_AST_ConditionNode(yymsp[-2].minor.yy10, OR, yymsp[0].minor.yy10); }
-#line 2081 "grammar.c"
-  yymsp[-2].minor.yy10 = yylhsminor.yy10;
+      case 100: /* cond ::= cond OR cond */
+#line 606 "grammar.y"
+{ yylhsminor.yy190 = New_AST_ConditionNode(yymsp[-2].minor.yy190, OR, yymsp[0].minor.yy190); }
+#line 2210 "grammar.c"
+  yymsp[-2].minor.yy190 = yylhsminor.yy190;
         break;
-      case 91: /* returnClause ::= RETURN returnElements */
-#line 530 "grammar.y"
+      case 101: /* returnClause ::= RETURN returnElements */
+#line 610 "grammar.y"
 {
-	yymsp[-1].minor.yy120 = New_AST_ReturnNode(yymsp[0].minor.yy122, 0);
+	yymsp[-1].minor.yy98 = New_AST_ReturnNode(yymsp[0].minor.yy168, 0);
 }
-#line 2089 "grammar.c"
+#line 2218 "grammar.c"
         break;
-      case 92: /* returnClause ::= RETURN DISTINCT returnElements */
-#line 533 "grammar.y"
+      case 102: /* returnClause ::= RETURN DISTINCT returnElements */
+#line 613 "grammar.y"
 {
-	yymsp[-2].minor.yy120 = New_AST_ReturnNode(yymsp[0].minor.yy122, 1);
+	yymsp[-2].minor.yy98 = New_AST_ReturnNode(yymsp[0].minor.yy168, 1);
 }
-#line 2096 "grammar.c"
+#line 2225 "grammar.c"
         break;
-      case 93: /* returnClause ::= RETURN MUL */
-#line 537 "grammar.y"
+      case 103: /* returnClause ::= RETURN MUL */
+#line 617 "grammar.y"
 {
-	yymsp[-1].minor.yy120 = New_AST_ReturnNode(NULL, 0);
+	yymsp[-1].minor.yy98 = New_AST_ReturnNode(NULL, 0);
 }
-#line 2103 "grammar.c"
+#line 2232 "grammar.c"
         break;
-      case 94: /* returnClause ::= RETURN DISTINCT MUL */
-#line 540 "grammar.y"
+      case 104: /* returnClause ::= RETURN DISTINCT MUL */
+#line 620 "grammar.y"
 {
-	yymsp[-2].minor.yy120 = New_AST_ReturnNode(NULL, 1);
+	yymsp[-2].minor.yy98 = New_AST_ReturnNode(NULL, 1);
 }
-#line 2110 "grammar.c"
+#line 2239 "grammar.c"
         break;
-      case 95: /* returnElements ::= returnElements COMMA returnElement */
-#line 546 "grammar.y"
+      case 105: /* returnElements ::= returnElements COMMA returnElement */
+#line 626 "grammar.y"
 {
-	yylhsminor.yy122 = array_append(yymsp[-2].minor.yy122, yymsp[0].minor.yy139);
+	yylhsminor.yy168 = array_append(yymsp[-2].minor.yy168, yymsp[0].minor.yy26);
 }
-#line 2117 "grammar.c"
-  yymsp[-2].minor.yy122 = yylhsminor.yy122;
+#line 2246 "grammar.c"
+  yymsp[-2].minor.yy168 = yylhsminor.yy168;
         break;
-      case 96: /* returnElements ::= returnElement */
-#line 550 "grammar.y"
+      case 106: /* returnElements ::= returnElement */
+#line 630 "grammar.y"
 {
-	yylhsminor.yy122 = array_new(AST_ReturnElementNode*, 1);
-	array_append(yylhsminor.yy122, yymsp[0].minor.yy139);
+	yylhsminor.yy168 = array_new(AST_ReturnElementNode*, 1);
+	array_append(yylhsminor.yy168, yymsp[0].minor.yy26);
 }
-#line 2126 "grammar.c"
-  yymsp[0].minor.yy122 = yylhsminor.yy122;
+#line 2255 "grammar.c"
+  yymsp[0].minor.yy168 = yylhsminor.yy168;
         break;
-      case 97: /* returnElement ::= arithmetic_expression */
-#line 557 "grammar.y"
+      case 107: /* returnElement ::= arithmetic_expression */
+#line 637 "grammar.y"
 {
-	yylhsminor.yy139 = New_AST_ReturnElementNode(yymsp[0].minor.yy154, NULL);
+	yylhsminor.yy26 = New_AST_ReturnElementNode(yymsp[0].minor.yy90, NULL);
 }
-#line 2134 "grammar.c"
-  yymsp[0].minor.yy139 = yylhsminor.yy139;
+#line 2263 "grammar.c"
+  yymsp[0].minor.yy26 = yylhsminor.yy26;
         break;
-      case 98: /* returnElement ::= arithmetic_expression AS UQSTRING */
-#line 561 "grammar.y"
+      case 108: /* returnElement ::= arithmetic_expression AS UQSTRING */
+#line 641 "grammar.y"
 {
-	yylhsminor.yy139 = New_AST_ReturnElementNode(yymsp[-2].minor.yy154, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy26 = New_AST_ReturnElementNode(yymsp[-2].minor.yy90, yymsp[0].minor.yy0.strval);
 }
-#line 2142 "grammar.c"
-  yymsp[-2].minor.yy139 = yylhsminor.yy139;
+#line 2271 "grammar.c"
+  yymsp[-2].minor.yy26 = yylhsminor.yy26;
         break;
-      case 99: /* withClause ::= WITH withElements */
-#line 566 "grammar.y"
+      case 109: /* withClause ::= WITH withElements */
+#line 646 "grammar.y"
 {
-	yymsp[-1].minor.yy168 = New_AST_WithNode(yymsp[0].minor.yy112);
+	yymsp[-1].minor.yy210 = New_AST_WithNode(yymsp[0].minor.yy224);
 }
-#line 2150 "grammar.c"
+#line 2279 "grammar.c"
         break;
-      case 100: /* withElements ::= withElement */
-#line 571 "grammar.y"
+      case 110: /* withElements ::= withElement */
+#line 651 "grammar.y"
 {
-	yylhsminor.yy112 = array_new(AST_WithElementNode*, 1);
-	array_append(yylhsminor.yy112, yymsp[0].minor.yy98);
+	yylhsminor.yy224 = array_new(AST_WithElementNode*, 1);
+	array_append(yylhsminor.yy224, yymsp[0].minor.yy14);
 }
-#line 2158 "grammar.c"
-  yymsp[0].minor.yy112 = yylhsminor.yy112;
+#line 2287 "grammar.c"
+  yymsp[0].minor.yy224 = yylhsminor.yy224;
         break;
-      case 101: /* withElements ::= withElements COMMA withElement */
-#line 575 "grammar.y"
+      case 111: /* withElements ::= withElements COMMA withElement */
+#line 655 "grammar.y"
 {
-	yylhsminor.yy112 = array_append(yymsp[-2].minor.yy112, yymsp[0].minor.yy98);
+	yylhsminor.yy224 = array_append(yymsp[-2].minor.yy224, yymsp[0].minor.yy14);
 }
-#line 2166 "grammar.c"
-  yymsp[-2].minor.yy112 = yylhsminor.yy112;
+#line 2295 "grammar.c"
+  yymsp[-2].minor.yy224 = yylhsminor.yy224;
         break;
-      case 102: /* withElement ::= arithmetic_expression AS UQSTRING */
-#line 580 "grammar.y"
+      case 112: /* withElement ::= arithmetic_expression AS UQSTRING */
+#line 660 "grammar.y"
 {
-	yylhsminor.yy98 = New_AST_WithElementNode(yymsp[-2].minor.yy154, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy14 = New_AST_WithElementNode(yymsp[-2].minor.yy90, yymsp[0].minor.yy0.strval);
 }
-#line 2174 "grammar.c"
-  yymsp[-2].minor.yy98 = yylhsminor.yy98;
+#line 2303 "grammar.c"
+  yymsp[-2].minor.yy14 = yylhsminor.yy14;
         break;
-      case 103: /* arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
-#line 587 "grammar.y"
+      case 113: /* arithmetic_expression ::= LEFT_PARENTHESIS arithmetic_expression RIGHT_PARENTHESIS */
+#line 667 "grammar.y"
 {
-	yymsp[-2].minor.yy154 = yymsp[-1].minor.yy154;
+	yymsp[-2].minor.yy90 = yymsp[-1].minor.yy90;
 }
-#line 2182 "grammar.c"
+#line 2311 "grammar.c"
         break;
-      case 104: /* arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
-#line 593 "grammar.y"
+      case 114: /* arithmetic_expression ::= arithmetic_expression ADD arithmetic_expression */
+#line 673 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy154);
-	Vector_Push(args, yymsp[0].minor.yy154);
-	yylhsminor.yy154 = New_AST_AR_EXP_OpNode("ADD", args);
+	Vector_Push(args, yymsp[-2].minor.yy90);
+	Vector_Push(args, yymsp[0].minor.yy90);
+	yylhsminor.yy90 = New_AST_AR_EXP_OpNode("ADD", args);
 }
-#line 2192 "grammar.c"
-  yymsp[-2].minor.yy154 = yylhsminor.yy154;
+#line 2321 "grammar.c"
+  yymsp[-2].minor.yy90 = yylhsminor.yy90;
         break;
-      case 105: /* arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
-#line 600 "grammar.y"
+      case 115: /* arithmetic_expression ::= arithmetic_expression DASH arithmetic_expression */
+#line 680 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy154);
-	Vector_Push(args, yymsp[0].minor.yy154);
-	yylhsminor.yy154 = New_AST_AR_EXP_OpNode("SUB", args);
+	Vector_Push(args, yymsp[-2].minor.yy90);
+	Vector_Push(args, yymsp[0].minor.yy90);
+	yylhsminor.yy90 = New_AST_AR_EXP_OpNode("SUB", args);
 }
-#line 2203 "grammar.c"
-  yymsp[-2].minor.yy154 = yylhsminor.yy154;
+#line 2332 "grammar.c"
+  yymsp[-2].minor.yy90 = yylhsminor.yy90;
         break;
-      case 106: /* arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
-#line 607 "grammar.y"
+      case 116: /* arithmetic_expression ::= arithmetic_expression MUL arithmetic_expression */
+#line 687 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy154);
-	Vector_Push(args, yymsp[0].minor.yy154);
-	yylhsminor.yy154 = New_AST_AR_EXP_OpNode("MUL", args);
+	Vector_Push(args, yymsp[-2].minor.yy90);
+	Vector_Push(args, yymsp[0].minor.yy90);
+	yylhsminor.yy90 = New_AST_AR_EXP_OpNode("MUL", args);
 }
-#line 2214 "grammar.c"
-  yymsp[-2].minor.yy154 = yylhsminor.yy154;
+#line 2343 "grammar.c"
+  yymsp[-2].minor.yy90 = yylhsminor.yy90;
         break;
-      case 107: /* arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
-#line 614 "grammar.y"
+      case 117: /* arithmetic_expression ::= arithmetic_expression DIV arithmetic_expression */
+#line 694 "grammar.y"
 {
 	Vector *args = NewVector(AST_ArithmeticExpressionNode*, 2);
-	Vector_Push(args, yymsp[-2].minor.yy154);
-	Vector_Push(args, yymsp[0].minor.yy154);
-	yylhsminor.yy154 = New_AST_AR_EXP_OpNode("DIV", args);
+	Vector_Push(args, yymsp[-2].minor.yy90);
+	Vector_Push(args, yymsp[0].minor.yy90);
+	yylhsminor.yy90 = New_AST_AR_EXP_OpNode("DIV", args);
 }
-#line 2225 "grammar.c"
-  yymsp[-2].minor.yy154 = yylhsminor.yy154;
+#line 2354 "grammar.c"
+  yymsp[-2].minor.yy90 = yylhsminor.yy90;
         break;
-      case 108: /* arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
-#line 622 "grammar.y"
+      case 118: /* arithmetic_expression ::= UQSTRING LEFT_PARENTHESIS arithmetic_expression_list RIGHT_PARENTHESIS */
+#line 702 "grammar.y"
 {
-	yylhsminor.yy154 = New_AST_AR_EXP_OpNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy210);
+	yylhsminor.yy90 = New_AST_AR_EXP_OpNode(yymsp[-3].minor.yy0.strval, yymsp[-1].minor.yy60);
 }
-#line 2233 "grammar.c"
-  yymsp[-3].minor.yy154 = yylhsminor.yy154;
+#line 2362 "grammar.c"
+  yymsp[-3].minor.yy90 = yylhsminor.yy90;
         break;
-      case 109: /* arithmetic_expression ::= value */
-#line 627 "grammar.y"
+      case 119: /* arithmetic_expression ::= value */
+#line 707 "grammar.y"
 {
-	yylhsminor.yy154 = New_AST_AR_EXP_ConstOperandNode(yymsp[0].minor.yy150);
+	yylhsminor.yy90 = New_AST_AR_EXP_ConstOperandNode(yymsp[0].minor.yy150);
 }
-#line 2241 "grammar.c"
-  yymsp[0].minor.yy154 = yylhsminor.yy154;
+#line 2370 "grammar.c"
+  yymsp[0].minor.yy90 = yylhsminor.yy90;
         break;
-      case 110: /* arithmetic_expression ::= variable */
-#line 632 "grammar.y"
+      case 120: /* arithmetic_expression ::= DOLLAR UQSTRING */
+#line 712 "grammar.y"
 {
-	yylhsminor.yy154 = New_AST_AR_EXP_VariableOperandNode(yymsp[0].minor.yy156->alias, yymsp[0].minor.yy156->property);
-	free(yymsp[0].minor.yy156->alias);
-	free(yymsp[0].minor.yy156->property);
-	free(yymsp[0].minor.yy156);
+	yymsp[-1].minor.yy90 = New_AST_AR_EXP_ParamOperandNode(yymsp[0].minor.yy0.strval);
+	ctx->params = array_append(ctx->params, yymsp[0].minor.yy0.strval);
 }
-#line 2252 "grammar.c"
-  yymsp[0].minor.yy154 = yylhsminor.yy154;
+#line 2379 "grammar.c"
         break;
-      case 111: /* arithmetic_expression_list ::= */
-#line 641 "grammar.y"
+      case 121: /* arithmetic_expression ::= variable */
+#line 718 "grammar.y"
 {
-	yymsp[1].minor.yy210 = NewVector(AST_ArithmeticExpressionNode*, 0);
+	yylhsminor.yy90 = New_AST_AR_EXP_VariableOperandNode(yymsp[0].minor.yy92->alias, yymsp[0].minor.yy92->property);
+	free(yymsp[0].minor.yy92->alias);
+	free(yymsp[0].minor.yy92->property);
+	free(yymsp[0].minor.yy92);
 }
-#line 2260 "grammar.c"
+#line 2389 "grammar.c"
+  yymsp[0].minor.yy90 = yylhsminor.yy90;
         break;
-      case 112: /* arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
-#line 644 "grammar.y"
+      case 122: /* arithmetic_expression_list ::= */
+#line 727 "grammar.y"
 {
-	Vector_Push(yymsp[-2].minor.yy210, yymsp[0].minor.yy154);
-	yylhsminor.yy210 = yymsp[-2].minor.yy210;
+	yymsp[1].minor.yy60 = NewVector(AST_ArithmeticExpressionNode*, 0);
 }
-#line 2268 "grammar.c"
-  yymsp[-2].minor.yy210 = yylhsminor.yy210;
+#line 2397 "grammar.c"
         break;
-      case 113: /* arithmetic_expression_list ::= arithmetic_expression */
-#line 648 "grammar.y"
+      case 123: /* arithmetic_expression_list ::= arithmetic_expression_list COMMA arithmetic_expression */
+#line 730 "grammar.y"
 {
-	yylhsminor.yy210 = NewVector(AST_ArithmeticExpressionNode*, 1);
-	Vector_Push(yylhsminor.yy210, yymsp[0].minor.yy154);
+	Vector_Push(yymsp[-2].minor.yy60, yymsp[0].minor.yy90);
+	yylhsminor.yy60 = yymsp[-2].minor.yy60;
 }
-#line 2277 "grammar.c"
-  yymsp[0].minor.yy210 = yylhsminor.yy210;
+#line 2405 "grammar.c"
+  yymsp[-2].minor.yy60 = yylhsminor.yy60;
         break;
-      case 114: /* variable ::= UQSTRING */
-#line 655 "grammar.y"
+      case 124: /* arithmetic_expression_list ::= arithmetic_expression */
+#line 734 "grammar.y"
 {
-	yylhsminor.yy156 = New_AST_Variable(yymsp[0].minor.yy0.strval, NULL);
+	yylhsminor.yy60 = NewVector(AST_ArithmeticExpressionNode*, 1);
+	Vector_Push(yylhsminor.yy60, yymsp[0].minor.yy90);
 }
-#line 2285 "grammar.c"
-  yymsp[0].minor.yy156 = yylhsminor.yy156;
+#line 2414 "grammar.c"
+  yymsp[0].minor.yy60 = yylhsminor.yy60;
         break;
-      case 115: /* variable ::= UQSTRING DOT UQSTRING */
-#line 659 "grammar.y"
+      case 125: /* variable ::= UQSTRING */
+#line 741 "grammar.y"
 {
-	yylhsminor.yy156 = New_AST_Variable(yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval);
+	yylhsminor.yy92 = New_AST_Variable(yymsp[0].minor.yy0.strval, NULL);
 }
-#line 2293 "grammar.c"
-  yymsp[-2].minor.yy156 = yylhsminor.yy156;
+#line 2422 "grammar.c"
+  yymsp[0].minor.yy92 = yylhsminor.yy92;
         break;
-      case 116: /* orderClause ::= */
-#line 665 "grammar.y"
+      case 126: /* variable ::= UQSTRING DOT UQSTRING */
+#line 745 "grammar.y"
 {
-	yymsp[1].minor.yy196 = NULL;
+	yylhsminor.yy92 = New_AST_Variable(yymsp[-2].minor.yy0.strval, yymsp[0].minor.yy0.strval);
 }
-#line 2301 "grammar.c"
+#line 2430 "grammar.c"
+  yymsp[-2].minor.yy92 = yylhsminor.yy92;
         break;
-      case 117: /* orderClause ::= ORDER BY arithmetic_expression_list */
-#line 668 "grammar.y"
+      case 127: /* orderClause ::= */
+#line 751 "grammar.y"
 {
-	yymsp[-2].minor.yy196 = New_AST_OrderNode(yymsp[0].minor.yy210, ORDER_DIR_ASC);
+	yymsp[1].minor.yy160 = NULL;
 }
-#line 2308 "grammar.c"
+#line 2438 "grammar.c"
         break;
-      case 118: /* orderClause ::= ORDER BY arithmetic_expression_list ASC */
-#line 671 "grammar.y"
+      case 128: /* orderClause ::= ORDER BY arithmetic_expression_list */
+#line 754 "grammar.y"
 {
-	yymsp[-3].minor.yy196 = New_AST_OrderNode(yymsp[-1].minor.yy210, ORDER_DIR_ASC);
+	yymsp[-2].minor.yy160 = New_AST_OrderNode(yymsp[0].minor.yy60, ORDER_DIR_ASC);
 }
-#line 2315 "grammar.c"
+#line 2445 "grammar.c"
         break;
-      case 119: /* orderClause ::= ORDER BY arithmetic_expression_list DESC */
-#line 674 "grammar.y"
+      case 129: /* orderClause ::= ORDER BY arithmetic_expression_list ASC */
+#line 757 "grammar.y"
 {
-	yymsp[-3].minor.yy196 = New_AST_OrderNode(yymsp[-1].minor.yy210, ORDER_DIR_DESC);
+	yymsp[-3].minor.yy160 = New_AST_OrderNode(yymsp[-1].minor.yy60, ORDER_DIR_ASC);
 }
-#line 2322 "grammar.c"
+#line 2452 "grammar.c"
         break;
-      case 120: /* skipClause ::= */
-#line 680 "grammar.y"
+      case 130: /* orderClause ::= ORDER BY arithmetic_expression_list DESC */
+#line 760 "grammar.y"
 {
-	yymsp[1].minor.yy147 = NULL;
+	yymsp[-3].minor.yy160 = New_AST_OrderNode(yymsp[-1].minor.yy60, ORDER_DIR_DESC);
 }
-#line 2329 "grammar.c"
+#line 2459 "grammar.c"
         break;
-      case 121: /* skipClause ::= SKIP INTEGER */
-#line 683 "grammar.y"
+      case 131: /* skipClause ::= */
+#line 766 "grammar.y"
 {
-	yymsp[-1].minor.yy147 = New_AST_SkipNode(yymsp[0].minor.yy0.longval);
+	yymsp[1].minor.yy71 = NULL;
 }
-#line 2336 "grammar.c"
+#line 2466 "grammar.c"
         break;
-      case 122: /* limitClause ::= */
-#line 689 "grammar.y"
+      case 132: /* skipClause ::= SKIP INTEGER */
+#line 769 "grammar.y"
 {
-	yymsp[1].minor.yy39 = NULL;
+	yymsp[-1].minor.yy71 = New_AST_SkipNode(yymsp[0].minor.yy0.longval);
 }
-#line 2343 "grammar.c"
+#line 2473 "grammar.c"
         break;
-      case 123: /* limitClause ::= LIMIT INTEGER */
-#line 692 "grammar.y"
+      case 133: /* skipClause ::= SKIP DOLLAR UQSTRING */
+#line 772 "grammar.y"
 {
-	yymsp[-1].minor.yy39 = New_AST_LimitNode(yymsp[0].minor.yy0.longval);
+	yymsp[-2].minor.yy71 = New_AST_SkipParamNode(yymsp[0].minor.yy0.strval);
+	ctx->params = array_append(ctx->params, yymsp[0].minor.yy0.strval);
 }
-#line 2350 "grammar.c"
+#line 2481 "grammar.c"
         break;
-      case 124: /* unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING */
-#line 698 "grammar.y"
+      case 134: /* limitClause ::= */
+#line 779 "grammar.y"
 {
-	yymsp[-5].minor.yy97 = New_AST_UnwindNode(yymsp[-3].minor.yy210, yymsp[0].minor.yy0.strval);
+	yymsp[1].minor.yy19 = NULL;
 }
-#line 2357 "grammar.c"
+#line 2488 "grammar.c"
         break;
-      case 125: /* relation ::= EQ */
-#line 703 "grammar.y"
-{ yymsp[0].minor.yy6 = EQ; }
-#line 2362 "grammar.c"
+      case 135: /* limitClause ::= LIMIT INTEGER */
+#line 782 "grammar.y"
+{
+	yymsp[-1].minor.yy19 = New_AST_LimitNode(yymsp[0].minor.yy0.longval);
+}
+#line 2495 "grammar.c"
+        break;
+      case 136: /* limitClause ::= LIMIT DOLLAR UQSTRING */
+#line 785 "grammar.y"
+{
+	yymsp[-2].minor.yy19 = New_AST_LimitParamNode(yymsp[0].minor.yy0.strval);
+	ctx->params = array_append(ctx->params, yymsp[0].minor.yy0.strval);
+}
+#line 2503 "grammar.c"
+        break;
+      case 137: /* unwindClause ::= UNWIND LEFT_BRACKET arithmetic_expression_list RIGHT_BRACKET AS UQSTRING */
+#line 792 "grammar.y"
+{
+	yymsp[-5].minor.yy63 = New_AST_UnwindNode(yymsp[-3].minor.yy60, yymsp[0].minor.yy0.strval);
+}
+#line 2510 "grammar.c"
         break;
-      case 126: /* relation ::= GT */
-#line 704 "grammar.y"
-{ yymsp[0].minor.yy6 = GT; }
-#line 2367 "grammar.c"
+      case 138: /* relation ::= EQ */
+#line 797 "grammar.y"
+{ yymsp[0].minor.yy86 = EQ; }
+#line 2515 "grammar.c"
         break;
-      case 127: /* relation ::= LT */
-#line 705 "grammar.y"
-{ yymsp[0].minor.yy6 = LT; }
-#line 2372 "grammar.c"
+      case 139: /* relation ::= GT */
+#line 798 "grammar.y"
+{ yymsp[0].minor.yy86 = GT; }
+#line 2520 "grammar.c"
         break;
-      case 128: /* relation ::= LE */
-#line 706 "grammar.y"
-{ yymsp[0].minor.yy6 = LE; }
-#line 2377 "grammar.c"
+      case 140: /* relation ::= LT */
+#line 799 "grammar.y"
+{ yymsp[0].minor.yy86 = LT; }
+#line 2525 "grammar.c"
         break;
-      case 129: /* relation ::= GE */
-#line 707 "grammar.y"
-{ yymsp[0].minor.yy6 = GE; }
-#line 2382 "grammar.c"
+      case 141: /* relation ::= LE */
+#line 800 "grammar.y"
+{ yymsp[0].minor.yy86 = LE; }
+#line 2530 "grammar.c"
         break;
-      case 130: /* relation ::= NE */
-#line 708 "grammar.y"
-{ yymsp[0].minor.yy6 = NE; }
-#line 2387 "grammar.c"
+      case 142: /* relation ::= GE */
+#line 801 "grammar.y"
+{ yymsp[0].minor.yy86 = GE; }
+#line 2535 "grammar.c"
         break;
-      case 131: /* value ::= INTEGER */
-#line 713 "grammar.y"
+      case 143: /* relation ::= NE */
+#line 802 "grammar.y"
+{ yymsp[0].minor.yy86 = NE; }
+#line 2540 "grammar.c"
+        break;
+      case 144: /* value ::= INTEGER */
+#line 807 "grammar.y"
 {  yylhsminor.yy150 = SI_LongVal(yymsp[0].minor.yy0.longval); }
-#line 2392 "grammar.c"
+#line 2545 "grammar.c"
   yymsp[0].minor.yy150 = yylhsminor.yy150;
         break;
-      case 132: /* value ::= DASH INTEGER */
-#line 714 "grammar.y"
+      case 145: /* value ::= DASH INTEGER */
+#line 808 "grammar.y"
 {  yymsp[-1].minor.yy150 = SI_LongVal(-yymsp[0].minor.yy0.longval); }
-#line 2398 "grammar.c"
+#line 2551 "grammar.c"
         break;
-      case 133: /* value ::= STRING */
-#line 715 "grammar.y"
+      case 146: /* value ::= STRING */
+#line 809 "grammar.y"
 {  yylhsminor.yy150 = SI_ConstStringVal(yymsp[0].minor.yy0.strval); }
-#line 2403 "grammar.c"
+#line 2556 "grammar.c"
   yymsp[0].minor.yy150 = yylhsminor.yy150;
         break;
-      case 134: /* value ::= FLOAT */
-#line 716 "grammar.y"
+      case 147: /* value ::= FLOAT */
+#line 810 "grammar.y"
 {  yylhsminor.yy150 = SI_DoubleVal(yymsp[0].minor.yy0.dval); }
-#line 2409 "grammar.c"
+#line 2562 "grammar.c"
   yymsp[0].minor.yy150 = yylhsminor.yy150;
         break;
-      case 135: /* value ::= DASH FLOAT */
-#line 717 "grammar.y"
+      case 148: /* value ::= DASH FLOAT */
+#line 811 "grammar.y"
 {  yymsp[-1].minor.yy150 = SI_DoubleVal(-yymsp[0].minor.yy0.dval); }
-#line 2415 "grammar.c"
+#line 2568 "grammar.c"
         break;
-      case 136: /* value ::= TRUE */
-#line 718 "grammar.y"
+      case 149: /* value ::= TRUE */
+#line 812 "grammar.y"
 { yymsp[0].minor.yy150 = SI_BoolVal(1); }
-#line 2420 "grammar.c"
+#line 2573 "grammar.c"
         break;
-      case 137: /* value ::= FALSE */
-#line 719 "grammar.y"
+      case 150: /* value ::= FALSE */
+#line 813 "grammar.y"
 { yymsp[0].minor.yy150 = SI_BoolVal(0); }
-#line 2425 "grammar.c"
+#line 2578 "grammar.c"
         break;
-      case 138: /* value ::= NULLVAL */
-#line 720 "grammar.y"
+      case 151: /* value ::= NULLVAL */
+#line 814 "grammar.y"
 { yymsp[0].minor.yy150 = SI_NullVal(); }
-#line 2430 "grammar.c"
+#line 2583 "grammar.c"
         break;
       default:
         break;
@@ -2484,14 +2637,14 @@ static void yy_syntax_error(
   ParseARG_FETCH;
 #define TOKEN yyminor
 /************ Begin %syntax_error code ****************************************/
-#line 33 "grammar.y"
+#line 34 "grammar.y"
 
 	char buf[256];
 	snprintf(buf, 256, "Syntax error at offset %d near '%s'", TOKEN.pos, TOKEN.s);
 
 	ctx->ok = 0;
 	ctx->errorMsg = strdup(buf);
-#line 2495 "grammar.c"
+#line 2648 "grammar.c"
 /************ End %syntax_error code ******************************************/
   ParseARG_STORE; /* Suppress warning about unused %extra_argument variable */
 }
@@ -2705,7 +2858,7 @@ void Parse(
 #endif
   return;
 }
-#line 722 "grammar.y"
+#line 816 "grammar.y"
 
 
 	/* Definitions of flex stuff */
@@ -2724,7 +2877,7 @@ void Parse(
   		void* pParser = ParseAlloc(malloc);
   		int t = 0;
 
-		parseCtx ctx = {.root = NULL, .ok = 1, .errorMsg = NULL};
+		parseCtx ctx = {.root = NULL, .ok = 1, .errorMsg = NULL, .params = array_new(char*, 0)};
 
 		while( (t = yylex()) != 0) {
 			Parse(pParser, t, tok, &ctx);
@@ -2733,10 +2886,22 @@ void Parse(
 			Parse(pParser, 0, tok, &ctx);
   		}
 		ParseFree(pParser, free);
+		if (ctx.root && !ctx.ok) {
+			// Query was rejected while reducing its final rules.
+			AST_Free(ctx.root);
+			ctx.root = NULL;
+		}
+		if (ctx.root) {
+			// Referred parameters are tracked by the first AST.
+			ctx.root[0]->params = ctx.params;
+		} else {
+			for(int i = 0; i < array_len(ctx.params); i++) free(ctx.params[i]);
+			array_free(ctx.params);
+		}
 		if (err) {
 			*err = ctx.errorMsg;
 		}
 		yylex_destroy();
 		return ctx.root;
 	}
-#line 2743 "grammar.c"
+#line 2908 "grammar.c"
@@ -21,34 +21,35 @@
 #define CREATE                          21
 #define INDEX                           22
 #define ON                              23
-#define DROP                            24
-#define COLON                           25
-#define MERGE                           26
-#define SET                             27
-#define DELETE                          28
-#define RIGHT_ARROW                     29
-#define LEFT_ARROW                      30
-#define LEFT_BRACKET                    31
-#define RIGHT_BRACKET                   32
+#define LEFT_BRACKET                    24
+#define RIGHT_BRACKET                   25
+#define DROP                            26
+#define COLON                           27
+#define MERGE                           28
+#define SET                             29
+#define DELETE                          30
+#define RIGHT_ARROW                     31
+#define LEFT_ARROW                      32
 #define PIPE                            33
 #define INTEGER                         34
 #define DOTDOT                          35
 #define LEFT_CURLY_BRACKET              36
 #define RIGHT_CURLY_BRACKET             37
-#define WHERE                           38
-#define RETURN                          39
-#define DISTINCT                        40
-#define AS                              41
-#define WITH                            42
-#define ORDER                           43
-#define BY                              44
-#define ASC                             45
-#define DESC                            46
-#define SKIP                            47
-#define LIMIT                           48
-#define UNWIND                          49
-#define NE                              50
-#define FLOAT                           51
-#define TRUE                            52
-#define FALSE                           53
-#define NULLVAL                         54
+#define DOLLAR                          38
+#define WHERE                           39
+#define RETURN                          40
+#define DISTINCT                        41
+#define AS                              42
+#define WITH                            43
+#define ORDER                           44
+#define BY                              45
+#define ASC                             46
+#define DESC                            47
+#define SKIP                            48
+#define LIMIT                           49
+#define UNWIND                          50
+#define NE                              51
+#define FLOAT                           52
+#define TRUE                            53
+#define FALSE                           54
+#define NULLVAL                         55
@@ -12,6 +12,7 @@
 	#include <stdint.h>
 	#include <assert.h>
 	#include <limits.h>
+	#include <strings.h>
 	#include "token.h"	
 	#include "grammar.h"
 	#include "ast.h"
@@ -238,10 +239,45 @@ matchClauses(A) ::= matchClauses(B) matchClause(C). {
 
 // Vector of vectors.
 %type matchClause { Vector* }
-matchClause(A) ::= MATCH chains(B). {
+matchClause(A) ::= MATCH matchChains(B). {
 	A = B;
 }
 
+// Vector of Vectors, each representing a single chain.
+%type matchChains {Vector*}
+matchChains(A) ::= matchChain(B). {
+	A = NewVector(Vector*, 1);
+	Vector_Push(A, B);
+}
+
+matchChains(A) ::= matchChains(B) COMMA matchChain(C). {
+	Vector_Push(B, C);
+	A = B;
+}
+
+%type matchChain {Vector*}
+matchChain(A) ::= chain(B). {
+	A = B;
+}
+
+// shortestPath((a)-[:R*]->(b)), allShortestPaths((a)-[:R*]->(b))
+matchChain(A) ::= UQSTRING(B) LEFT_PARENTHESIS node(C) link(D) node(E) RIGHT_PARENTHESIS. {
+	if(strcasecmp(B.strval, "shortestPath") == 0) {
+		D->selector = N_PATH_SHORTEST;
+	} else if(strcasecmp(B.strval, "allShortestPaths") == 0) {
+		D->selector = N_PATH_ALL_SHORTEST;
+	} else if(ctx->ok) {
+		ctx->ok = 0;
+		asprintf(&ctx->errorMsg, "Unknown path function '%s'", B.strval);
+	}
+	free(B.strval);
+
+	A = NewVector(AST_GraphEntity*, 3);
+	Vector_Push(A, C);
+	Vector_Push(A, D);
+	Vector_Push(A, E);
+}
+
 %type multipleCreateClause { AST_CreateNode* }
 multipleCreateClause(A) ::= . {
 	A = NULL;
@@ -273,8 +309,36 @@ createClause(A) ::= CREATE chains(B). {
 
 %type indexClause { AST_IndexNode* }
 
-indexClause(A) ::= indexOpToken(B) INDEX ON indexLabel(C) indexProp(D) . {
-  A = New_AST_IndexNode(C.strval, D.strval, B);
+indexClause(A) ::= indexOpToken(B) INDEX ON indexLabel(C) LEFT_PARENTHESIS indexProps(D) RIGHT_PARENTHESIS indexType(E) . {
+  A = New_AST_IndexNode(C.strval, D, N_ENTITY, B, E);
+}
+
+// Edge indices cover a single relationship type and property.
+indexClause(A) ::= indexOpToken(B) INDEX ON LEFT_BRACKET indexLabel(C) RIGHT_BRACKET LEFT_PARENTHESIS UQSTRING(D) RIGHT_PARENTHESIS indexType(E) . {
+  char **properties = array_new(char*, 1);
+  properties = array_append(properties, D.strval);
+  A = New_AST_IndexNode(C.strval, properties, N_LINK, B, E);
+}
+
+%type indexType { AST_IndexType }
+
+indexType(A) ::= . { A = BTREE_INDEX; }
+
+// USING BTREE, USING HASH or USING SKIPLIST, none of these words are reserved keywords.
+indexType(A) ::= UQSTRING(B) UQSTRING(C) . {
+	A = BTREE_INDEX;
+	if(strcasecmp(B.strval, "USING") == 0 && strcasecmp(C.strval, "BTREE") == 0) {
+		A = BTREE_INDEX;
+	} else if(strcasecmp(B.strval, "USING") == 0 && strcasecmp(C.strval, "HASH") == 0) {
+		A = HASH_INDEX;
+	} else if(strcasecmp(B.strval, "USING") == 0 && strcasecmp(C.strval, "SKIPLIST") == 0) {
+		A = SKIPLIST_INDEX;
+	} else if(ctx->ok) {
+		ctx->ok = 0;
+		asprintf(&ctx->errorMsg, "Unknown index type '%s %s'", B.strval, C.strval);
+	}
+	free(B.strval);
+	free(C.strval);
 }
 
 %type indexOpToken { AST_IndexOpType }
@@ -286,7 +350,15 @@ indexLabel(A) ::= COLON UQSTRING(B) . {
   A = B;
 }
 
-indexProp(A) ::= LEFT_PARENTHESIS UQSTRING(B) RIGHT_PARENTHESIS . {
+%type indexProps {char**}
+indexProps(A) ::= UQSTRING(B) . {
+  A = array_new(char*, 1);
+  A = array_append(A, B.strval);
+}
+
+// Multiple properties form a composite index.
+indexProps(A) ::= indexProps(B) COMMA UQSTRING(C) . {
+  B = array_append(B, C.strval);
   A = B;
 }
 
@@ -481,7 +553,7 @@ properties(A) ::= LEFT_CURLY_BRACKET mapLiteral(B) RIGHT_CURLY_BRACKET. {
 
 %type mapLiteral {Vector*}
 // key:value
-mapLiteral(A) ::= UQSTRING(B) COLON value(C). {
+mapLiteral(A) ::= UQSTRING(B) COLON mapValue(C). {
 	A = NewVector(SIValue*, 2);
 
 	SIValue *key = malloc(sizeof(SIValue));
@@ -493,7 +565,7 @@ mapLiteral(A) ::= UQSTRING(B) COLON value(C). {
 	Vector_Push(A, val);
 }
 
-mapLiteral(A) ::= UQSTRING(B) COLON value(C) COMMA mapLiteral(D). {
+mapLiteral(A) ::= UQSTRING(B) COLON mapValue(C) COMMA mapLiteral(D). {
 	SIValue *key = malloc(sizeof(SIValue));
 	*key = SI_ConstStringVal(B.strval);
 	Vector_Push(D, key);
@@ -505,6 +577,14 @@ mapLiteral(A) ::= UQSTRING(B) COLON value(C) COMMA mapLiteral(D). {
 	A = D;
 }
 
+%type mapValue {SIValue}
+mapValue(A) ::= value(B). { A = B; }
+// $name
+mapValue(A) ::= DOLLAR UQSTRING(B). {
+	A = AST_InlineParam(B.strval);
+	ctx->params = array_append(ctx->params, B.strval);
+}
+
 %type whereClause {AST_WhereNode*}
 
 whereClause(A) ::= . { 
@@ -628,6 +708,12 @@ arithmetic_expression(A) ::= value(B). {
 	A = New_AST_AR_EXP_ConstOperandNode(B);
 }
 
+// $name
+arithmetic_expression(A) ::= DOLLAR UQSTRING(B). {
+	A = New_AST_AR_EXP_ParamOperandNode(B.strval);
+	ctx->params = array_append(ctx->params, B.strval);
+}
+
 // a.name
 arithmetic_expression(A) ::= variable(B). {
 	A = New_AST_AR_EXP_VariableOperandNode(B->alias, B->property);
@@ -683,6 +769,10 @@ skipClause(A) ::= . {
 skipClause(A) ::= SKIP INTEGER(B). {
 	A = New_AST_SkipNode(B.longval);
 }
+skipClause(A) ::= SKIP DOLLAR UQSTRING(B). {
+	A = New_AST_SkipParamNode(B.strval);
+	ctx->params = array_append(ctx->params, B.strval);
+}
 
 %type limitClause {AST_LimitNode*}
 
@@ -692,6 +782,10 @@ limitClause(A) ::= . {
 limitClause(A) ::= LIMIT INTEGER(B). {
 	A = New_AST_LimitNode(B.longval);
 }
+limitClause(A) ::= LIMIT DOLLAR UQSTRING(B). {
+	A = New_AST_LimitParamNode(B.strval);
+	ctx->params = array_append(ctx->params, B.strval);
+}
 
 %type unwindClause {AST_UnwindNode*}
 
@@ -737,7 +831,7 @@ value(A) ::= NULLVAL. { A = SI_NullVal(); }
   		void* pParser = ParseAlloc(malloc);
   		int t = 0;
 
-		parseCtx ctx = {.root = NULL, .ok = 1, .errorMsg = NULL};
+		parseCtx ctx = {.root = NULL, .ok = 1, .errorMsg = NULL, .params = array_new(char*, 0)};
 
 		while( (t = yylex()) != 0) {
 			Parse(pParser, t, tok, &ctx);
@@ -746,6 +840,18 @@ value(A) ::= NULLVAL. { A = SI_NullVal(); }
 			Parse(pParser, 0, tok, &ctx);
   		}
 		ParseFree(pParser, free);
+		if (ctx.root && !ctx.ok) {
+			// Query was rejected while reducing its final rules.
+			AST_Free(ctx.root);
+			ctx.root = NULL;
+		}
+		if (ctx.root) {
+			// Referred parameters are tracked by the first AST.
+			ctx.root[0]->params = ctx.params;
+		} else {
+			for(int i = 0; i < array_len(ctx.params); i++) free(ctx.params[i]);
+			array_free(ctx.params);
+		}
 		if (err) {
 			*err = ctx.errorMsg;
 		}
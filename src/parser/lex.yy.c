@@ -1183,7 +1183,7 @@ YY_RULE_SETUP
 case 58:
 YY_RULE_SETUP
 #line 114 "lexer.l"
-ECHO;
+if(yytext[0] == '$') return DOLLAR; ECHO;
 	YY_BREAK
 #line 1189 "lex.yy.c"
 case YY_STATE_EOF(INITIAL):
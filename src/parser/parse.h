@@ -13,6 +13,7 @@ typedef struct {
     AST **root;
     int ok;
     char *errorMsg;
+    char **params;  // Names of parameters referred to by query.
 } parseCtx;
 
 #endif
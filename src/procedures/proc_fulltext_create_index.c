@@ -37,12 +37,19 @@ static void _populateIndex (
     EntityProperty *prop;
     GxB_MatrixTupleIter *it;
     const GrB_Matrix label_matrix = Graph_GetLabelMatrix(g, label_id);
+    // Label's pending additions are scanned once label matrix is depleted.
+    GrB_Matrix delta_matrix = Graph_GetDeltaMatrix(g, label_matrix);
     GxB_MatrixTupleIter_new(&it, label_matrix);
 
     while(true) {
         bool depleted = false;
         GxB_MatrixTupleIter_next(it, NULL, &node_id, &depleted);
-        if(depleted) break;
+        if(depleted) {
+            if(!delta_matrix) break;
+            GxB_MatrixTupleIter_reuse(it, delta_matrix);
+            delta_matrix = NULL;
+            continue;
+        }
         
         double score = 0;
         const char* lang = NULL;
@@ -51,10 +58,10 @@ static void _populateIndex (
 
         for(uint i = 0; i < fields_count; i++) {
             RedisModuleString* s;
-            SIValue *v = GraphEntity_GetProperty((GraphEntity*)&node, fields_ids[i]);
-            if(v == PROPERTY_NOTFOUND) continue;
-            if(v->type != T_STRING) continue;
-            RediSearch_DocumentAddFieldString(doc, fields[i], v->stringval, strlen(v->stringval), RSFLDTYPE_FULLTEXT);
+            SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)&node, fields_ids[i]);
+            if(SIValue_IsNull(v)) continue;
+            if(v.type != T_STRING) continue;
+            RediSearch_DocumentAddFieldString(doc, fields[i], v.stringval, strlen(v.stringval), RSFLDTYPE_FULLTEXT);
         }
 
         RediSearch_SpecAddDocument(idx, doc);
@@ -73,15 +80,15 @@ static int _getNodeAttribute(void* ctx, const char* fieldName, const void* id, c
     
     Graph_GetNode(g, nId, &n);
     Attribute_ID attrId = GraphContext_GetAttributeID(gc, fieldName);
-    SIValue *v = GraphEntity_GetProperty((GraphEntity*)&n, attrId);
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)&n, attrId);
     int ret;
-    if(v == PROPERTY_NOTFOUND) {
+    if(SIValue_IsNull(v)) {
         ret = RSVALTYPE_NOTFOUND;
-    } else if(v->type & T_STRING) {
-        *strVal = v->stringval;
+    } else if(v.type & T_STRING) {
+        *strVal = v.stringval;
         ret = RSVALTYPE_STRING;
-    } else if(v->type & SI_NUMERIC) {
-        *doubleVal = SI_GET_NUMERIC(*v);
+    } else if(v.type & SI_NUMERIC) {
+        *doubleVal = SI_GET_NUMERIC(v);
         ret = RSVALTYPE_DOUBLE;
     } else {
         // Skiping booleans.
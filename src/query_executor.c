@@ -5,6 +5,7 @@
 */
 
 #include <assert.h>
+#include <pthread.h>
 #include "query_executor.h"
 #include "util/arr.h"
 #include "graph/graph.h"
@@ -50,11 +51,13 @@ static void _inlineProperties(AST *ast) {
             property = key->stringval;
             lhs = New_AST_AR_EXP_VariableOperandNode(alias, property);
 
-            // Build the right-hand filter value from the specified constant
+            // Build the right-hand filter value from the specified constant or parameter
             // TODO can update grammar so that this constant is already an ExpressionNode
             // instead of an SIValue
             Vector_Get(properties, j+1, &val);
-            rhs = New_AST_AR_EXP_ConstOperandNode(*val);
+            const char *param = AST_InlineValueParam(val);
+            if(param) rhs = New_AST_AR_EXP_ParamOperandNode(param);
+            else rhs = New_AST_AR_EXP_ConstOperandNode(*val);
 
             AST_FilterNode *filterNode = New_AST_PredicateNode(lhs, EQ, rhs);
             
@@ -160,8 +163,13 @@ static void _populateReturnAll(AST *ast) {
     ast->returnNode->returnElements = entities;
 }
 
+// Parser state is global, queries are parsed one at a time.
+static pthread_mutex_t _parser_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 AST** ParseQuery(const char *query, size_t qLen, char **errMsg) {
+    pthread_mutex_lock(&_parser_mutex);
     AST **asts = Query_Parse(query, qLen, errMsg);
+    pthread_mutex_unlock(&_parser_mutex);
     if(asts) {
         for(int i = 0; i < array_len(asts); i++) {
             /* Create match clause which will try to match against pattern specified within merge clause. */
@@ -181,6 +189,37 @@ AST** ParseQuery(const char *query, size_t qLen, char **errMsg) {
     return asts;
 }
 
+AST_Validation AST_ValidateParams(RedisModuleCtx *ctx, AST **ast, const QueryParams *params) {
+    const char *missing = QueryParams_Missing(params, AST_Params(ast));
+    if(missing) {
+        char *reason;
+        asprintf(&reason, "Missing value for query parameter $%s", missing);
+        RedisModule_ReplyWithError(ctx, reason);
+        free(reason);
+        return AST_INVALID;
+    }
+
+    // LIMIT and SKIP parameters must be non-negative integers.
+    for(uint i = 0; i < array_len(ast); i++) {
+        const char *clause[2] = {"LIMIT", "SKIP"};
+        const char *names[2] = {
+            ast[i]->limitNode ? ast[i]->limitNode->param : NULL,
+            ast[i]->skipNode ? ast[i]->skipNode->param : NULL
+        };
+        for(int j = 0; j < 2; j++) {
+            SIValue v;
+            if(!names[j] || !QueryParams_Get(params, names[j], &v)) continue;
+            if(v.type == T_INT64 && v.longval >= 0) continue;
+            char *reason;
+            asprintf(&reason, "Query parameter $%s must be a non-negative integer in %s", names[j], clause[j]);
+            RedisModule_ReplyWithError(ctx, reason);
+            free(reason);
+            return AST_INVALID;
+        }
+    }
+    return AST_VALID;
+}
+
 AST_Validation AST_PerformValidations(RedisModuleCtx *ctx, AST **ast) {
     char *reason;
     int ast_count = array_len(ast);
@@ -9,6 +9,7 @@
 
 #include "redismodule.h"
 #include "parser/ast.h"
+#include "query_params.h"
 #include "graph/query_graph.h"
 #include "arithmetic/arithmetic_expression.h"
 
@@ -18,6 +19,9 @@ AST **ParseQuery(const char *query, size_t qLen, char **errMsg);
 /* Make sure AST is valid. */
 AST_Validation AST_PerformValidations(RedisModuleCtx *ctx, AST **ast);
 
+/* Make sure every parameter referred to by query is specified. */
+AST_Validation AST_ValidateParams(RedisModuleCtx *ctx, AST **ast, const QueryParams *params);
+
 /* Performs a number of adjustments to given AST. */
 void ModifyAST(AST **ast);
 
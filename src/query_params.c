@@ -0,0 +1,174 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "query_params.h"
+#include "util/arr.h"
+#include "util/rmalloc.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#define PARAMS_PREFIX "CYPHER"
+
+// Parameters of the query executed by the current thread.
+static __thread QueryParams *_bound_params = NULL;
+
+static inline const char *_skipSpaces(const char *p) {
+    while(isspace(*p)) p++;
+    return p;
+}
+
+// Returns length of identifier starting at p, 0 if p doesn't start an identifier.
+static size_t _identifierLen(const char *p) {
+    if(!(isalpha(*p) || *p == '_')) return 0;
+    size_t len = 1;
+    while(isalnum(p[len]) || p[len] == '_') len++;
+    return len;
+}
+
+// Matches keyword at p, keyword must not be followed by an identifier character.
+static bool _matchKeyword(const char *p, const char *keyword) {
+    size_t len = strlen(keyword);
+    return (strncasecmp(p, keyword, len) == 0 && _identifierLen(p) == len);
+}
+
+// Parses a quoted string, backslash escapes the following character.
+static const char *_parseString(const char *p, SIValue *v) {
+    char quote = *p++;
+    const char *end = p;
+    while(*end && *end != quote) {
+        if(*end == '\\' && end[1]) end++;
+        end++;
+    }
+    if(*end != quote) return NULL;
+
+    char *s = rm_malloc(end - p + 1);
+    size_t len = 0;
+    for(; p < end; p++) {
+        if(*p == '\\') p++;
+        s[len++] = *p;
+    }
+    s[len] = '\0';
+
+    *v = SI_TransferStringVal(s);
+    return end + 1;
+}
+
+// Parses a numeric value, doubles are identified by a decimal point or exponent.
+static const char *_parseNumber(const char *p, SIValue *v) {
+    char *end;
+    size_t len = strspn(p, "+-0123456789.eE");
+    if(len == 0) return NULL;
+
+    if(strcspn(p, ".eE") < len) {
+        double d = strtod(p, &end);
+        *v = SI_DoubleVal(d);
+    } else {
+        long long l = strtoll(p, &end, 10);
+        *v = SI_LongVal(l);
+    }
+    if(end == p || isalpha(*end) || *end == '_') return NULL;
+    return end;
+}
+
+// Parses a single parameter value, returns position following value or NULL.
+static const char *_parseValue(const char *p, SIValue *v) {
+    if(*p == '\'' || *p == '"') return _parseString(p, v);
+    if(_matchKeyword(p, "true")) {
+        *v = SI_BoolVal(true);
+        return p + 4;
+    }
+    if(_matchKeyword(p, "false")) {
+        *v = SI_BoolVal(false);
+        return p + 5;
+    }
+    if(_matchKeyword(p, "null")) {
+        *v = SI_NullVal();
+        return p + 4;
+    }
+    return _parseNumber(p, v);
+}
+
+static void _QueryParams_Set(QueryParams *params, const char *name, size_t len, SIValue v) {
+    SIValue *value = rm_malloc(sizeof(SIValue));
+    *value = v;
+    SIValue *prev = NULL;
+    // Last specification of a parameter wins.
+    if(!raxInsert(params->values, (unsigned char *)name, len, value, (void **)&prev)) {
+        SIValue_Free(prev);
+        rm_free(prev);
+    }
+}
+
+const char *QueryParams_Parse(const char *query, QueryParams **params, char **err) {
+    *params = NULL;
+    const char *p = _skipSpaces(query);
+    if(!_matchKeyword(p, PARAMS_PREFIX)) return query;
+
+    QueryParams *qp = rm_malloc(sizeof(QueryParams));
+    qp->values = raxNew();
+    p += strlen(PARAMS_PREFIX);
+
+    while(true) {
+        p = _skipSpaces(p);
+        const char *name = p;
+        size_t len = _identifierLen(name);
+        if(len == 0) break;
+
+        // Prefix ends once we reach a token which isn't followed by '='.
+        const char *eq = _skipSpaces(name + len);
+        if(*eq != '=') break;
+
+        SIValue v;
+        p = _parseValue(_skipSpaces(eq + 1), &v);
+        if(!p) {
+            asprintf(err, "Invalid value for query parameter '%.*s'", (int)len, name);
+            QueryParams_Free(qp);
+            return NULL;
+        }
+        _QueryParams_Set(qp, name, len, v);
+    }
+
+    *params = qp;
+    return p;
+}
+
+bool QueryParams_Get(const QueryParams *params, const char *name, SIValue *v) {
+    if(!params) return false;
+    SIValue *value = raxFind(params->values, (unsigned char *)name, strlen(name));
+    if(value == raxNotFound) return false;
+    *v = SI_ShallowCopy(*value);
+    return true;
+}
+
+const char *QueryParams_Missing(const QueryParams *params, char **names) {
+    if(!names) return NULL;
+    SIValue v;
+    for(int i = 0; i < array_len(names); i++) {
+        if(!QueryParams_Get(params, names[i], &v)) return names[i];
+    }
+    return NULL;
+}
+
+void QueryParams_Bind(QueryParams *params) {
+    _bound_params = params;
+}
+
+QueryParams *QueryParams_Bound(void) {
+    return _bound_params;
+}
+
+static void _QueryParams_FreeValue(void *value) {
+    SIValue_Free(value);
+    rm_free(value);
+}
+
+void QueryParams_Free(QueryParams *params) {
+    if(!params) return;
+    raxFreeWithCallback(params->values, _QueryParams_FreeValue);
+    rm_free(params);
+}
@@ -0,0 +1,45 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __QUERY_PARAMS_H__
+#define __QUERY_PARAMS_H__
+
+#include <stdbool.h>
+#include "value.h"
+#include "../deps/rax/rax.h"
+
+/* QueryParams holds the values of parameters passed along a query
+ * through a "CYPHER name=value ..." prefix, for example:
+ * CYPHER name='Roi' age=33 MATCH (p:Person) WHERE p.name = $name RETURN p
+ * Supported values are integers, doubles, quoted strings, true, false and null.
+ * Parameters are bound to the thread executing the query,
+ * parameter references ($name) are resolved against the bound parameters. */
+typedef struct {
+    rax *values;    // Maps parameter name to its SIValue.
+} QueryParams;
+
+/* Splits query into its parameters and body.
+ * Returns a pointer into query at which the query body starts, sets params
+ * to NULL if query has no parameters prefix.
+ * On a malformed prefix returns NULL and sets err, caller should free err. */
+const char *QueryParams_Parse(const char *query, QueryParams **params, char **err);
+
+/* Retrieves parameter value, returns false if parameter is missing. */
+bool QueryParams_Get(const QueryParams *params, const char *name, SIValue *v);
+
+/* Returns the first of names missing from params, NULL if all are specified. */
+const char *QueryParams_Missing(const QueryParams *params, char **names);
+
+/* Binds params to the calling thread, NULL unbinds. */
+void QueryParams_Bind(QueryParams *params);
+
+/* Returns parameters bound to the calling thread. */
+QueryParams *QueryParams_Bound(void);
+
+/* Free params. */
+void QueryParams_Free(QueryParams *params);
+
+#endif
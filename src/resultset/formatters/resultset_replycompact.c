@@ -57,13 +57,16 @@ static void _ResultSet_CompactReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 }
 
 static void _ResultSet_CompactReplyWithProperties(RedisModuleCtx *ctx, GraphContext *gc, const GraphEntity *e) {
-    int prop_count = ENTITY_PROP_COUNT(e);
+    // Node properties might be stored in their label's columns.
+    int prop_count = GraphEntity_PropertyCount(e);
+    EntityProperty props[prop_count];
+    GraphEntity_GetProperties(e, props);
     RedisModule_ReplyWithArray(ctx, prop_count);
-    // Iterate over all properties stored on entity
+    // Iterate over all of entity's properties
     for (int i = 0; i < prop_count; i ++) {
         // Compact replies include the value's type; verbose replies do not
         RedisModule_ReplyWithArray(ctx, 3);
-        EntityProperty prop = ENTITY_PROPS(e)[i];
+        EntityProperty prop = props[i];
         // Emit the string index
         RedisModule_ReplyWithLongLong(ctx, prop.id);
         // Emit the value
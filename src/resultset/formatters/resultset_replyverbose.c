@@ -36,12 +36,15 @@ static void _ResultSet_VerboseReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 }
 
 static void _ResultSet_VerboseReplyWithProperties(RedisModuleCtx *ctx, GraphContext *gc, const GraphEntity *e) {
-    int prop_count = ENTITY_PROP_COUNT(e);
+    // Node properties might be stored in their label's columns.
+    int prop_count = GraphEntity_PropertyCount(e);
+    EntityProperty props[prop_count];
+    GraphEntity_GetProperties(e, props);
     RedisModule_ReplyWithArray(ctx, prop_count);
-    // Iterate over all properties stored on entity
+    // Iterate over all of entity's properties
     for (int i = 0; i < prop_count; i ++) {
         RedisModule_ReplyWithArray(ctx, 2);
-        EntityProperty prop = ENTITY_PROPS(e)[i];
+        EntityProperty prop = props[i];
         // Emit the actual string
         const char *prop_str = GraphContext_GetAttributeString(gc, prop.id);
         RedisModule_ReplyWithStringBuffer(ctx, prop_str, strlen(prop_str));
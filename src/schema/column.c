@@ -0,0 +1,220 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "column.h"
+#include "../util/rmalloc.h"
+#include <assert.h>
+#include <string.h>
+
+#define COLUMN_DEFAULT_CAP 64
+#define BITMAP_WORDS(n) (((n) + 63) / 64)
+
+static size_t _PropertyColumn_ValueSize(SIType t) {
+    switch(t) {
+        case T_INT64:
+            return sizeof(int64_t);
+        case T_DOUBLE:
+            return sizeof(double);
+        case T_BOOL:
+            return sizeof(bool);
+        case T_STRING:
+            return sizeof(char*);
+        default:
+            assert(false);
+            return 0;
+    }
+}
+
+// Column holds strings regardless of how they were allocated.
+static SIType _PropertyColumn_TypeOf(SIValue v) {
+    return (v.type == T_CONSTSTRING) ? T_STRING : v.type;
+}
+
+static inline bool _BitIsSet(const uint64_t *bitmap, NodeID id) {
+    return bitmap[id / 64] & (1ULL << (id % 64));
+}
+
+static inline void _BitSet(uint64_t *bitmap, NodeID id, bool set) {
+    if(set) bitmap[id / 64] |= (1ULL << (id % 64));
+    else bitmap[id / 64] &= ~(1ULL << (id % 64));
+}
+
+static inline bool _PropertyColumn_IsSet(const PropertyColumn *c, NodeID id) {
+    return id < c->cap && _BitIsSet(c->validity, id);
+}
+
+// Returns true if l converts to a double and back unchanged.
+static inline bool _ExactDouble(int64_t l) {
+    double d = (double)l;
+    return d >= -9223372036854775808.0 && d < 9223372036854775808.0 && (int64_t)d == l;
+}
+
+static uint64_t *_ReallocBitmap(uint64_t *bitmap, NodeID prev_cap, NodeID cap) {
+    size_t prev_words = BITMAP_WORDS(prev_cap);
+    size_t words = BITMAP_WORDS(cap);
+    bitmap = rm_realloc(bitmap, words * sizeof(uint64_t));
+    memset(bitmap + prev_words, 0, (words - prev_words) * sizeof(uint64_t));
+    return bitmap;
+}
+
+// Make sure column can hold node id.
+static void _PropertyColumn_Accommodate(PropertyColumn *c, NodeID id) {
+    if(id < c->cap) return;
+
+    NodeID cap = (c->cap) ? c->cap : COLUMN_DEFAULT_CAP;
+    while(cap <= id) cap *= 2;
+
+    c->validity = _ReallocBitmap(c->validity, c->cap, cap);
+    if(c->integral) c->integral = _ReallocBitmap(c->integral, c->cap, cap);
+    if(c->type != T_NULL) {
+        c->values = rm_realloc(c->values, cap * _PropertyColumn_ValueSize(c->type));
+    }
+    c->cap = cap;
+}
+
+// Marks which nodes hold integers, setting all present nodes if mark_present.
+static void _PropertyColumn_TrackIntegers(PropertyColumn *c, bool mark_present) {
+    size_t words = BITMAP_WORDS(c->cap);
+    c->integral = rm_malloc(words * sizeof(uint64_t));
+    if(mark_present) memcpy(c->integral, c->validity, words * sizeof(uint64_t));
+    else memset(c->integral, 0, words * sizeof(uint64_t));
+}
+
+// Converts an integer column to doubles in place,
+// fails if a stored integer can't be represented exactly.
+static bool _PropertyColumn_Widen(PropertyColumn *c) {
+    assert(c->type == T_INT64);
+    for(NodeID i = 0; i < c->cap; i++) {
+        if(_BitIsSet(c->validity, i) && !_ExactDouble(c->longs[i])) return false;
+    }
+    for(NodeID i = 0; i < c->cap; i++) {
+        if(_BitIsSet(c->validity, i)) c->doubles[i] = (double)c->longs[i];
+    }
+    c->type = T_DOUBLE;
+    _PropertyColumn_TrackIntegers(c, true);
+    return true;
+}
+
+// Prepares column to hold a value of type t, returns false if it can't.
+static bool _PropertyColumn_Admit(PropertyColumn *c, SIType t, SIValue v) {
+    if(!(t & (T_INT64 | T_DOUBLE | T_BOOL | T_STRING))) return false;
+
+    if(c->type == T_NULL) {
+        // First value determines column type.
+        c->type = t;
+        if(c->cap) c->values = rm_malloc(c->cap * _PropertyColumn_ValueSize(t));
+        return true;
+    }
+
+    if(c->type == t) return true;
+    if(c->type == T_DOUBLE && t == T_INT64) {
+        if(!_ExactDouble(v.longval)) return false;
+        if(!c->integral) _PropertyColumn_TrackIntegers(c, false);
+        return true;
+    }
+    if(c->type == T_INT64 && t == T_DOUBLE) return _PropertyColumn_Widen(c);
+    return false;
+}
+
+PropertyColumn *PropertyColumn_New(Attribute_ID attr_id, StringPool *pool) {
+    PropertyColumn *c = rm_malloc(sizeof(PropertyColumn));
+    c->attr_id = attr_id;
+    c->type = T_NULL;
+    c->cap = 0;
+    c->validity = NULL;
+    c->integral = NULL;
+    c->values = NULL;
+    c->pool = pool;
+    return c;
+}
+
+bool PropertyColumn_Set(PropertyColumn *c, NodeID id, SIValue v) {
+    assert(c);
+    SIType t = _PropertyColumn_TypeOf(v);
+    if(SIValue_IsNull(v) || !_PropertyColumn_Admit(c, t, v)) {
+        PropertyColumn_Unset(c, id);
+        return false;
+    }
+
+    _PropertyColumn_Accommodate(c, id);
+    switch(c->type) {
+        case T_INT64:
+            c->longs[id] = v.longval;
+            break;
+        case T_DOUBLE:
+            c->doubles[id] = SI_GET_NUMERIC(v);
+            if(c->integral) _BitSet(c->integral, id, t == T_INT64);
+            break;
+        case T_BOOL:
+            c->bools[id] = v.longval;
+            break;
+        case T_STRING: {
+            // Acquire before releasing, overwriting a value with itself keeps its string.
+            char *s = (v.allocation == M_INTERNED) ? StringPool_Retain(v.stringval) :
+                      StringPool_Intern(c->pool, v.stringval);
+            if(_PropertyColumn_IsSet(c, id)) StringPool_Release(c->strings[id]);
+            c->strings[id] = s;
+            break;
+        }
+        default:
+            assert(false);
+    }
+    _BitSet(c->validity, id, true);
+    return true;
+}
+
+void PropertyColumn_Unset(PropertyColumn *c, NodeID id) {
+    assert(c);
+    if(!_PropertyColumn_IsSet(c, id)) return;
+    if(c->type == T_STRING) StringPool_Release(c->strings[id]);
+    _BitSet(c->validity, id, false);
+}
+
+bool PropertyColumn_Get(const PropertyColumn *c, NodeID id, SIValue *v) {
+    if(!c || !_PropertyColumn_IsSet(c, id)) return false;
+
+    switch(c->type) {
+        case T_INT64:
+            *v = SI_LongVal(c->longs[id]);
+            break;
+        case T_DOUBLE:
+            if(c->integral && _BitIsSet(c->integral, id)) *v = SI_LongVal((int64_t)c->doubles[id]);
+            else *v = SI_DoubleVal(c->doubles[id]);
+            break;
+        case T_BOOL:
+            *v = SI_BoolVal(c->bools[id]);
+            break;
+        case T_STRING:
+            *v = SI_ConstStringVal(c->strings[id]);
+            break;
+        default:
+            assert(false);
+    }
+    return true;
+}
+
+size_t PropertyColumn_MemoryUsage(const PropertyColumn *c) {
+    size_t usage = sizeof(PropertyColumn);
+    if(c->cap) {
+        usage += BITMAP_WORDS(c->cap) * sizeof(uint64_t);
+        if(c->integral) usage += BITMAP_WORDS(c->cap) * sizeof(uint64_t);
+        if(c->type != T_NULL) usage += c->cap * _PropertyColumn_ValueSize(c->type);
+    }
+    return usage;
+}
+
+void PropertyColumn_Free(PropertyColumn *c) {
+    assert(c);
+    if(c->type == T_STRING) {
+        for(NodeID i = 0; i < c->cap; i++) {
+            if(_BitIsSet(c->validity, i)) StringPool_Release(c->strings[i]);
+        }
+    }
+    rm_free(c->validity);
+    rm_free(c->integral);
+    rm_free(c->values);
+    rm_free(c);
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __PROPERTY_COLUMN_H__
+#define __PROPERTY_COLUMN_H__
+
+#include <stdbool.h>
+#include "../value.h"
+#include "../util/string_pool.h"
+#include "../graph/entities/graph_entity.h"
+
+/* PropertyColumn holds a single attribute of all nodes sharing a label
+ * in a dense vector indexed by node ID, alongside a bitmap marking which
+ * nodes hold a value. The column is the storage of record for the values
+ * it holds, nodes keep no copy of them.
+ *
+ * Values are stored by type: integers, doubles and booleans in typed arrays,
+ * strings as references into the graph's StringPool, shared with every other
+ * holder of the same string. A column is typed by the first value stored in it.
+ * Integer columns widen to doubles once a double is introduced, a widened
+ * column marks which nodes hold integers such that they read back as such;
+ * integers a double can't represent exactly are refused by double columns.
+ * Values of any other type are refused, PropertyColumn_Set reports so
+ * and the caller stores them on the node itself.
+ *
+ * A column costs its value size (8 bytes for integers, doubles and string
+ * references, 1 for booleans) plus a validity bit per node ID up to
+ * the highest ID stored, and a second bit once widened. */
+typedef struct {
+    Attribute_ID attr_id;   /* Attribute held by column. */
+    SIType type;            /* Type of values, T_NULL until a value is stored. */
+    NodeID cap;             /* Number of node IDs column can accommodate. */
+    uint64_t *validity;     /* Bit per node ID, set if node holds a value. */
+    uint64_t *integral;     /* Double columns, bit per node ID set if node holds an integer. */
+    union {
+        int64_t *longs;
+        double *doubles;
+        bool *bools;
+        char **strings;     /* Interned within pool. */
+        void *values;
+    };
+    StringPool *pool;       /* Pool strings are interned in. */
+} PropertyColumn;
+
+/* Creates a new, empty column for attribute, interning strings within pool. */
+PropertyColumn *PropertyColumn_New(Attribute_ID attr_id, StringPool *pool);
+
+/* Sets node's value, returns true if column holds v.
+ * Values the column can't hold, as well as NULL, remove node from column. */
+bool PropertyColumn_Set(PropertyColumn *c, NodeID id, SIValue v);
+
+/* Removes node from column. */
+void PropertyColumn_Unset(PropertyColumn *c, NodeID id);
+
+/* Retrieves node's value, returns false if column doesn't hold a value for node.
+ * Strings are returned as constant references to the interned string. */
+bool PropertyColumn_Get(const PropertyColumn *c, NodeID id, SIValue *v);
+
+/* Returns the number of bytes allocated by column. */
+size_t PropertyColumn_MemoryUsage(const PropertyColumn *c);
+
+/* Free column, releasing its strings. */
+void PropertyColumn_Free(PropertyColumn *c);
+
+#endif /* __PROPERTY_COLUMN_H__ */
@@ -9,13 +9,28 @@
 #include "../util/rmalloc.h"
 #include "../graph/graphcontext.h"
 #include <assert.h>
+#include <string.h>
 
-Schema* Schema_New(const char *name, int id) {
+// Process-wide switch, set once on module load.
+static bool _columnar_layout = false;
+
+void Schema_SetColumnarLayout(bool enabled) {
+    _columnar_layout = enabled;
+}
+
+bool Schema_ColumnarLayout(void) {
+    return _columnar_layout;
+}
+
+Schema* Schema_New(const char *name, int id, SchemaType type) {
     Schema *schema = rm_malloc(sizeof(Schema));
     schema->id = id;
     schema->name = rm_strdup(name);
+    schema->type = type;
     schema->indices = array_new(Index*, 4);
+    schema->composite_indices = array_new(CompositeIndex*, 0);
     schema->fulltextIdx = NULL;
+    schema->columns = NULL;
     return schema;
 }
 
@@ -55,14 +70,16 @@ RSIndex *Schema_GetFullTextIndex(const Schema *s) {
     return s->fulltextIdx;
 }
 
-int Schema_AddIndex(Schema *s, Attribute_ID attr_id) {
+int Schema_AddIndex(Schema *s, Attribute_ID attr_id, IndexType type) {
     // Make sure attribute isn't already indexed.
     if(Schema_GetIndex(s, attr_id) != NULL) return INDEX_FAIL;
 
     // Populate an index for the label-attribute pair using the Graph interfaces.
     GraphContext *gc = GraphContext_GetFromTLS();
     const char *attribute = GraphContext_GetAttributeString(gc, attr_id);
-    Index *idx = Index_Create(gc->g, s->name, s->id, attribute, attr_id);
+    Index *idx;
+    if(s->type == SCHEMA_EDGE) idx = Index_CreateEdgeIndex(gc->g, s->name, s->id, attribute, attr_id, type);
+    else idx = Index_Create(gc->g, s->name, s->id, attribute, attr_id, type);
 
     // Add index to schema.
     s->indices = array_append(s->indices, idx);
@@ -90,6 +107,120 @@ int Schema_RemoveIndex(Schema *s, Attribute_ID attr_id) {
     return INDEX_FAIL;
 }
 
+unsigned short Schema_CompositeIndexCount(const Schema *s) {
+    assert(s);
+    return (unsigned short)array_len(s->composite_indices);
+}
+
+// Returns the position of the composite index over the ordered attributes, or -1.
+static int _Schema_CompositeIndexOffset(const Schema *s, const Attribute_ID *attr_ids, uint attr_count) {
+    unsigned short index_count = (unsigned short)array_len(s->composite_indices);
+    for(unsigned short i = 0; i < index_count; i++) {
+        CompositeIndex *idx = s->composite_indices[i];
+        if(idx->attr_count != attr_count) continue;
+        if(memcmp(idx->attr_ids, attr_ids, sizeof(Attribute_ID) * attr_count) == 0) return i;
+    }
+    return -1;
+}
+
+CompositeIndex* Schema_GetCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count) {
+    int i = _Schema_CompositeIndexOffset(s, attr_ids, attr_count);
+    return (i == -1) ? NULL : s->composite_indices[i];
+}
+
+int Schema_AddCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count, IndexType type) {
+    // Make sure attributes aren't already indexed in this order.
+    if(Schema_GetCompositeIndex(s, attr_ids, attr_count) != NULL) return INDEX_FAIL;
+
+    GraphContext *gc = GraphContext_GetFromTLS();
+    const char *attributes[attr_count];
+    for(uint i = 0; i < attr_count; i++) {
+        attributes[i] = GraphContext_GetAttributeString(gc, attr_ids[i]);
+    }
+    CompositeIndex *idx = CompositeIndex_Create(gc->g, s->name, s->id, attributes, attr_ids, attr_count, type);
+
+    // Add index to schema.
+    s->composite_indices = array_append(s->composite_indices, idx);
+
+    return INDEX_OK;
+}
+
+int Schema_RemoveCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count) {
+    int i = _Schema_CompositeIndexOffset(s, attr_ids, attr_count);
+    if(i == -1) return INDEX_FAIL;
+
+    CompositeIndex *idx = s->composite_indices[i];
+    // Swap the last stored index into the emptied position.
+    CompositeIndex *last_idx = array_pop(s->composite_indices);
+    if(idx != last_idx) s->composite_indices[i] = last_idx;
+    CompositeIndex_Free(idx);
+    return INDEX_OK;
+}
+
+PropertyColumn *Schema_GetColumn(const Schema *s, Attribute_ID attr_id) {
+    if(!s->columns || attr_id >= array_len(s->columns)) return NULL;
+    return s->columns[attr_id];
+}
+
+// Retrieves column for attribute, creating it if missing.
+static PropertyColumn *_Schema_GetOrAddColumn(Schema *s, Attribute_ID attr_id) {
+    if(!s->columns) s->columns = array_new(PropertyColumn*, attr_id + 1);
+    while(array_len(s->columns) <= attr_id) {
+        s->columns = array_append(s->columns, NULL);
+    }
+    if(!s->columns[attr_id]) {
+        // Columns share the graph's interned strings.
+        GraphContext *gc = GraphContext_GetFromTLS();
+        s->columns[attr_id] = PropertyColumn_New(attr_id, gc->string_pool);
+    }
+    return s->columns[attr_id];
+}
+
+void Schema_AddNodeToColumns(Schema *s, Node *n) {
+    if(!_columnar_layout) return;
+    NodeID id = ENTITY_GET_ID(n);
+    Entity *e = n->entity;
+    e->column_schema = s->id;
+
+    // Keep the properties columns refuse, compacting them in place.
+    int kept = 0;
+    for(int i = 0; i < e->prop_count; i++) {
+        EntityProperty *prop = e->properties + i;
+        if(PropertyColumn_Set(_Schema_GetOrAddColumn(s, prop->id), id, prop->value)) {
+            SIValue_Free(&prop->value);
+        } else {
+            e->properties[kept++] = *prop;
+        }
+    }
+
+    if(kept == e->prop_count) return;
+    e->prop_count = kept;
+    if(kept == 0) {
+        rm_free(e->properties);
+        e->properties = NULL;
+    } else {
+        e->properties = rm_realloc(e->properties, sizeof(EntityProperty) * kept);
+    }
+}
+
+bool Schema_SetColumnValue(Schema *s, const Node *n, Attribute_ID attr_id, SIValue v) {
+    if(n->entity->column_schema != s->id) return false;
+    if(SIValue_IsNull(v)) {
+        PropertyColumn *c = Schema_GetColumn(s, attr_id);
+        if(c) PropertyColumn_Unset(c, ENTITY_GET_ID(n));
+        return false;
+    }
+    return PropertyColumn_Set(_Schema_GetOrAddColumn(s, attr_id), ENTITY_GET_ID(n), v);
+}
+
+void Schema_RemoveNodeFromColumns(Schema *s, NodeID id) {
+    if(!s->columns) return;
+    uint32_t column_count = array_len(s->columns);
+    for(uint32_t i = 0; i < column_count; i++) {
+        if(s->columns[i]) PropertyColumn_Unset(s->columns[i], id);
+    }
+}
+
 void Schema_Free(Schema *schema) {
     if(schema->name) rm_free(schema->name);
 
@@ -97,6 +228,17 @@ void Schema_Free(Schema *schema) {
     uint32_t index_count = array_len(schema->indices);
     for(int i = 0; i < index_count; i++) Index_Free(schema->indices[i]);
     array_free(schema->indices);
+    index_count = array_len(schema->composite_indices);
+    for(int i = 0; i < index_count; i++) CompositeIndex_Free(schema->composite_indices[i]);
+    array_free(schema->composite_indices);
     if(schema->fulltextIdx) RediSearch_DropIndex(schema->fulltextIdx);
+    // Free columns.
+    if(schema->columns) {
+        uint32_t column_count = array_len(schema->columns);
+        for(uint32_t i = 0; i < column_count; i++) {
+            if(schema->columns[i]) PropertyColumn_Free(schema->columns[i]);
+        }
+        array_free(schema->columns);
+    }
     rm_free(schema);
 }
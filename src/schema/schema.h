@@ -9,9 +9,12 @@
 
 #include "../redismodule.h"
 #include "../index/index.h"
+#include "../index/composite_index.h"
 #include "../util/triemap/triemap.h"
 #include "../graph/entities/graph_entity.h"
+#include "../graph/entities/node.h"
 #include "../redisearch_api.h"
+#include "column.h"
 
 typedef enum {
   SCHEMA_NODE,
@@ -24,12 +27,22 @@ typedef enum {
 typedef struct {
   int id;                 /* Internal ID to a matrix within the graph. */
   char *name;             /* Schema name. */
+  SchemaType type;        /* Schema entity type, node or edge. */
   Index** indices;        /* Indices applicable to schema. */
+  CompositeIndex** composite_indices; /* Multi-attribute indices applicable to schema. */
   RSIndex* fulltextIdx;   /* Full-text index. */
+  PropertyColumn **columns; /* Property columns by attribute ID, NULL where missing. */
 } Schema;
 
+/* Enables or disables the columnar property layout, when enabled node
+ * schemas store the properties of their nodes in a column per attribute. */
+void Schema_SetColumnarLayout(bool enabled);
+
+/* Returns true if schemas maintain property columns. */
+bool Schema_ColumnarLayout(void);
+
 /* Creates a new schema. */
-Schema* Schema_New(const char *label, int id);
+Schema* Schema_New(const char *label, int id, SchemaType type);
 
 const char *Schema_GetName(const Schema *s);
 
@@ -46,13 +59,45 @@ void Schema_SetFullTextIndex(Schema *s, RSIndex *idx);
 /* Retrieves schema full-text index, returns NULL if index doesn't exists. */
 RSIndex *Schema_GetFullTextIndex(const Schema *s);
 
-/* Assign a new index to attribute
+/* Assign a new index of the given type to attribute, edge schemas are assigned edge indices,
  * attribute must already exists and not associated with an index. */
-int Schema_AddIndex(Schema *s, Attribute_ID attr_id);
+int Schema_AddIndex(Schema *s, Attribute_ID attr_id, IndexType type);
 
 /* Removes index. */
 int Schema_RemoveIndex(Schema *s, Attribute_ID attr_id);
 
+/* Returns number of composite indices in schema. */
+unsigned short Schema_CompositeIndexCount(const Schema *s);
+
+/* Retrieves composite index over the ordered attributes.
+ * Returns NULL if index wasn't found. */
+CompositeIndex* Schema_GetCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count);
+
+/* Assign a new composite index of the given type to the ordered attributes,
+ * attributes must already exist and not be associated with an identical index. */
+int Schema_AddCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count, IndexType type);
+
+/* Removes composite index. */
+int Schema_RemoveCompositeIndex(Schema *s, const Attribute_ID *attr_ids, uint attr_count);
+
+/* Retrieves column for attribute,
+ * returns NULL if attribute isn't stored in a column. */
+PropertyColumn *Schema_GetColumn(const Schema *s, Attribute_ID attr_id);
+
+/* Moves node's properties into schema columns, introducing columns
+ * for attributes seen for the first time. From here on node's columns
+ * hold its properties, values a column refuses remain on the node. */
+void Schema_AddNodeToColumns(Schema *s, Node *n);
+
+/* Sets a single node property within schema columns, returns true if
+ * the column holds v. Returns false if node's properties aren't stored in
+ * schema's columns, the column refused v or v is NULL, in which case
+ * node doesn't hold the attribute in a column. */
+bool Schema_SetColumnValue(Schema *s, const Node *n, Attribute_ID attr_id, SIValue v);
+
+/* Removes node from all schema columns. */
+void Schema_RemoveNodeFromColumns(Schema *s, NodeID id);
+
 /* Free schema. */
 void Schema_Free(Schema *s);
 
@@ -0,0 +1,47 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "hll.h"
+#include <math.h>
+#include <string.h>
+
+void HLL_Init(HLL *hll) {
+  memset(hll->registers, 0, sizeof(hll->registers));
+}
+
+void HLL_Add(HLL *hll, uint64_t hash) {
+  // Leading bits select a register, the rest are scanned for leading zeros.
+  uint64_t idx = hash >> (64 - HLL_PRECISION);
+  // Guard bit bounds the rank when all remaining bits are zero.
+  uint64_t bits = (hash << HLL_PRECISION) | ((uint64_t)1 << (HLL_PRECISION - 1));
+  uint8_t rank = __builtin_clzll(bits) + 1;
+  if(rank > hll->registers[idx]) hll->registers[idx] = rank;
+}
+
+void HLL_Merge(HLL *hll, const HLL *other) {
+  for(int i = 0; i < HLL_REGISTERS; i++) {
+    if(other->registers[i] > hll->registers[i]) hll->registers[i] = other->registers[i];
+  }
+}
+
+uint64_t HLL_Count(const HLL *hll) {
+  double m = HLL_REGISTERS;
+  double alpha = 0.7213 / (1 + 1.079 / m);
+  double sum = 0;
+  int zeros = 0;
+
+  for(int i = 0; i < HLL_REGISTERS; i++) {
+    sum += ldexp(1.0, -hll->registers[i]);
+    if(hll->registers[i] == 0) zeros++;
+  }
+
+  double estimate = alpha * m * m / sum;
+
+  // Small cardinalities are better estimated by the number of empty registers.
+  if(estimate <= 2.5 * m && zeros > 0) estimate = m * log(m / zeros);
+
+  return (uint64_t)(estimate + 0.5);
+}
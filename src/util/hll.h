@@ -0,0 +1,37 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __HLL_H__
+#define __HLL_H__
+
+#include <stdint.h>
+
+#define HLL_PRECISION 14                        // Number of hash bits selecting a register.
+#define HLL_REGISTERS (1 << HLL_PRECISION)      // Number of registers.
+
+/* HyperLogLog estimates the number of distinct items added to it
+ * using a fixed amount of memory, a byte per register, with a
+ * standard error of 1.04 / sqrt(HLL_REGISTERS), about 0.8%.
+ * Items are added by their 64 bit hash, two sketches are merged
+ * by keeping the maximum of each register. */
+
+typedef struct {
+  uint8_t registers[HLL_REGISTERS];   /* Longest run of leading zeros seen per register. */
+} HLL;
+
+/* Resets sketch to the empty set. */
+void HLL_Init(HLL *hll);
+
+/* Adds item with the given hash to sketch. */
+void HLL_Add(HLL *hll, uint64_t hash);
+
+/* Adds the items of other to hll. */
+void HLL_Merge(HLL *hll, const HLL *other);
+
+/* Estimates the number of distinct items added to sketch. */
+uint64_t HLL_Count(const HLL *hll);
+
+#endif /* __HLL_H__ */
@@ -42,6 +42,7 @@
 
 #include "skiplist.h"
 
+#include <assert.h>
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -357,6 +358,28 @@ skiplistNode* skiplistFindAtLeast(skiplist *sl, skiplistKey key, int exclusive)
   return x;
 }
 
+/*
+ * Search for the last element whose key is smaller than (exclusive)
+ * or equal to the given key, NULL is returned if there's no such element.
+ */
+skiplistNode* skiplistFindAtMost(skiplist *sl, skiplistKey key, int exclusive) {
+  skiplistNode *x = sl->header;
+  int i;
+
+  for (i = sl->level - 1; i >= 0; i--) {
+    while (x->level[i].forward) {
+      int rc = sl->compare(x->level[i].forward->key, key);
+      if (rc < 0 || (rc == 0 && !exclusive)) {
+        x = x->level[i].forward;
+      } else {
+        break;
+      }
+    }
+  }
+
+  return (x == sl->header) ? NULL : x;
+}
+
 /*
  * If the skip list is empty, NULL is returned, otherwise the element
  * at head is removed and its pointed object returned.
@@ -424,6 +447,9 @@ void _update_upper_bound(skiplistIterator *iter, skiplistKey bound, int exclusiv
  * Update skiplist bounds according to specified op - returns 1 if filter was applicable
  * (regardless of whether it improves upon original bound) and 0 otherwise. */
 bool skiplistIter_UpdateBound(skiplistIterator *iter, skiplistKey bound, int op) {
+  // Bounds are tracked by the iterator's position when iterating forward.
+  assert(!iter->reverse);
+
   /* If the iterator is already depleted, the resulting index scan will return nothing, which
    * is a valid result (contradictory filters, specifying incorrect property types). */
   if (iter->current == NULL) return 1;
@@ -477,6 +503,7 @@ skiplistIterator* skiplistIterateRange(skiplist *sl, skiplistKey min, skiplistKe
   iter->minExclusive = minExclusive;
   iter->rangeMax = max;
   iter->maxExclusive = maxExclusive;
+  iter->reverse = 0;
   iter->sl = sl;
 
   return iter;
@@ -489,10 +516,22 @@ skiplistIterator* skiplistIterateAll(skiplist *sl) {
   return iter;
 }
 
+void skiplistIterate_Reverse(skiplistIterator *iter) {
+  iter->reverse = 1;
+  skiplistIterate_Reset(iter);
+}
+
 void skiplistIterate_Reset(skiplistIterator *iter) {
-  // If this iterator was built with a minimum value, we will traverse the skiplist
-  // to initialize it properly.
-  if (iter->rangeMin == NULL) {
+  if (iter->reverse) {
+    // Reversed iterators start at the last element within the upper bound.
+    if (iter->rangeMax == NULL) {
+      iter->current = iter->sl->tail;
+    } else {
+      iter->current = skiplistFindAtMost(iter->sl, iter->rangeMax, iter->maxExclusive);
+    }
+  } else if (iter->rangeMin == NULL) {
+    // If this iterator was built with a minimum value, we will traverse the skiplist
+    // to initialize it properly.
     iter->current = iter->sl->header->level[0].forward;
   } else {
     iter->current = skiplistFindAtLeast(iter->sl, iter->rangeMin, iter->minExclusive);
@@ -518,8 +557,17 @@ skiplistVal* skiplistIterator_Next(skiplistIterator *it) {
     return NULL;
   }
 
-  // make sure we don't pass the range max. NULL means +inf
-  if (it->currentValOffset == 0 && it->rangeMax) {
+  if (it->reverse) {
+    // make sure we don't pass the range min. NULL means -inf
+    if (it->currentValOffset == 0 && it->rangeMin) {
+      int c = it->sl->compare(it->current->key, it->rangeMin);
+      if (c < 0 || (c == 0 && it->minExclusive)) {
+        it->current = NULL;
+        return NULL;
+      }
+    }
+  } else if (it->currentValOffset == 0 && it->rangeMax) {
+    // make sure we don't pass the range max. NULL means +inf
     int c = it->sl->compare(it->current->key, it->rangeMax);
     if (c > 0 || (c == 0 && it->maxExclusive)) {
       it->current = NULL;
@@ -534,7 +582,7 @@ skiplistVal* skiplistIterator_Next(skiplistIterator *it) {
   }
 
   if (it->currentValOffset == it->current->numVals) {
-    it->current = it->current->level[0].forward;
+    it->current = it->reverse ? it->current->backward : it->current->level[0].forward;
     it->currentValOffset = 0;
   }
 
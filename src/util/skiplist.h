@@ -81,6 +81,7 @@ skiplistNode *skiplistInsert(skiplist *sl, skiplistKey key, skiplistVal val);
 int skiplistDelete(skiplist *sl, skiplistKey key, skiplistVal *val);
 skiplistNode *skiplistFind(skiplist *sl, skiplistKey key);
 skiplistNode *skiplistFindAtLeast(skiplist *sl, skiplistKey key, int exclusive);
+skiplistNode *skiplistFindAtMost(skiplist *sl, skiplistKey key, int exclusive);
 skiplistKey skiplistPopHead(skiplist *sl);
 skiplistKey skiplistPopTail(skiplist *sl);
 
@@ -91,6 +92,7 @@ typedef struct {
   skiplistKey rangeMax;
   int minExclusive;
   int maxExclusive;
+  int reverse;          // Iterate from rangeMax down to rangeMin.
   skiplist *sl;
 } skiplistIterator;
 
@@ -99,6 +101,9 @@ skiplistIterator* skiplistIterateRange(skiplist *sl, skiplistKey min, skiplistKe
                                        int minExclusive, int maxExclusive);
 skiplistIterator* skiplistIterateAll(skiplist *sl);
 
+/* Reverse iteration order, such that keys are visited in descending order.
+ * Bounds should be applied before reversing. */
+void skiplistIterate_Reverse(skiplistIterator *iter);
 void skiplistIterate_Reset(skiplistIterator *iter);
 void skiplistIterate_Free(skiplistIterator *iter);
 
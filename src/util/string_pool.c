@@ -0,0 +1,68 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "string_pool.h"
+#include "rmalloc.h"
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+#define POOLED_STRING(s) ((PooledString*)((s) - offsetof(PooledString, str)))
+
+StringPool *StringPool_New(void) {
+  StringPool *pool = rm_malloc(sizeof(StringPool));
+  pool->strings = raxNew();
+  return pool;
+}
+
+char *StringPool_Intern(StringPool *pool, const char *s) {
+  assert(pool && s);
+  size_t len = strlen(s);
+  PooledString *ps = raxFind(pool->strings, (unsigned char*)s, len);
+
+  if(ps == raxNotFound) {
+    ps = rm_malloc(sizeof(PooledString) + len + 1);
+    ps->pool = pool;
+    ps->refcount = 0;
+    memcpy(ps->str, s, len + 1);
+    raxInsert(pool->strings, (unsigned char*)ps->str, len, ps, NULL);
+  }
+
+  ps->refcount++;
+  return ps->str;
+}
+
+char *StringPool_Retain(char *s) {
+  assert(s);
+  POOLED_STRING(s)->refcount++;
+  return s;
+}
+
+void StringPool_Release(char *s) {
+  assert(s);
+  PooledString *ps = POOLED_STRING(s);
+  assert(ps->refcount > 0);
+  if(--ps->refcount > 0) return;
+
+  // Last holder, remove string from its pool.
+  raxRemove(ps->pool->strings, (unsigned char*)ps->str, strlen(ps->str), NULL);
+  rm_free(ps);
+}
+
+uint64_t StringPool_Size(const StringPool *pool) {
+  assert(pool);
+  return raxSize(pool->strings);
+}
+
+static void _StringPool_FreeString(void *ps) {
+  rm_free(ps);
+}
+
+void StringPool_Free(StringPool *pool) {
+  assert(pool);
+  raxFreeWithCallback(pool->strings, _StringPool_FreeString);
+  rm_free(pool);
+}
@@ -0,0 +1,49 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __STRING_POOL_H__
+#define __STRING_POOL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../../deps/rax/rax.h"
+
+/* StringPool interns string values, such that each distinct string
+ * is stored once and shared by all of its holders.
+ * Interned strings are reference counted, the last holder to release
+ * a string removes it from its pool.
+ * Pools are not thread-safe, strings should only be interned and
+ * released while holding the graph's write lock. */
+
+typedef struct {
+  rax *strings;           /* Maps string content to its PooledString. */
+} StringPool;
+
+typedef struct {
+  StringPool *pool;       /* Pool owning string. */
+  uint32_t refcount;      /* Number of holders. */
+  char str[];             /* String content. */
+} PooledString;
+
+/* Creates a new, empty string pool. */
+StringPool *StringPool_New(void);
+
+/* Returns pooled copy of s, adding it to the pool if missing. */
+char *StringPool_Intern(StringPool *pool, const char *s);
+
+/* Acquires an additional reference to a string returned by StringPool_Intern. */
+char *StringPool_Retain(char *s);
+
+/* Releases a string returned by StringPool_Intern or StringPool_Retain. */
+void StringPool_Release(char *s);
+
+/* Number of distinct strings in pool. */
+uint64_t StringPool_Size(const StringPool *pool);
+
+/* Free pool along with all of its strings. */
+void StringPool_Free(StringPool *pool);
+
+#endif /* __STRING_POOL_H__ */
@@ -0,0 +1,114 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "tdigest.h"
+#include "qsort.h"
+#include <math.h>
+#include <assert.h>
+
+#define CENTROID_LT(a, b) ((a)->mean < (b)->mean)
+
+/* Scale function k(q) = delta / (2 * PI) * asin(2q - 1),
+ * a compressed centroid spans at most a single unit of k,
+ * which is narrow near the tails and wide around the median. */
+static double _TDigest_K(double q) {
+  return TDIGEST_COMPRESSION / (2 * M_PI) * asin(2 * q - 1);
+}
+
+/* Returns the quantile up to which a centroid starting at quantile q may extend. */
+static double _TDigest_Limit(double q) {
+  double k = _TDigest_K(q) + 1;
+  if(k >= TDIGEST_COMPRESSION / 4.0) return 1;
+  return (sin(k * 2 * M_PI / TDIGEST_COMPRESSION) + 1) / 2;
+}
+
+/* Sorts compressed and buffered centroids by mean, then greedily merges
+ * neighbouring centroids as long as they fit within the scale limit. */
+static void _TDigest_Compress(TDigest *td) {
+  if(td->buffered == 0) return;
+
+  TDigestCentroid *c = td->centroids;
+  uint32_t n = td->compressed + td->buffered;
+  QSORT(TDigestCentroid, c, n, CENTROID_LT);
+
+  uint32_t out = 0;
+  double preceding = 0;   // Weight of centroids preceding c[out].
+  double limit = td->count * _TDigest_Limit(0);
+
+  for(uint32_t i = 1; i < n; i++) {
+    double proposed = c[out].count + c[i].count;
+    if(preceding + proposed <= limit) {
+      c[out].mean += (c[i].mean - c[out].mean) * c[i].count / proposed;
+      c[out].count = proposed;
+    } else {
+      preceding += c[out].count;
+      limit = td->count * _TDigest_Limit(preceding / td->count);
+      c[++out] = c[i];
+    }
+  }
+
+  td->compressed = out + 1;
+  td->buffered = 0;
+  assert(td->compressed < TDIGEST_CAPACITY);
+}
+
+static void _TDigest_AddCentroid(TDigest *td, TDigestCentroid centroid) {
+  if(td->compressed + td->buffered == TDIGEST_CAPACITY) _TDigest_Compress(td);
+  td->centroids[td->compressed + td->buffered] = centroid;
+  td->buffered++;
+  td->count += centroid.count;
+}
+
+void TDigest_Init(TDigest *td) {
+  td->compressed = 0;
+  td->buffered = 0;
+  td->count = 0;
+  td->min = INFINITY;
+  td->max = -INFINITY;
+}
+
+void TDigest_Add(TDigest *td, double value) {
+  TDigestCentroid centroid = {.mean = value, .count = 1};
+  _TDigest_AddCentroid(td, centroid);
+  if(value < td->min) td->min = value;
+  if(value > td->max) td->max = value;
+}
+
+void TDigest_Merge(TDigest *td, const TDigest *other) {
+  uint32_t n = other->compressed + other->buffered;
+  for(uint32_t i = 0; i < n; i++) _TDigest_AddCentroid(td, other->centroids[i]);
+  if(other->min < td->min) td->min = other->min;
+  if(other->max > td->max) td->max = other->max;
+}
+
+double TDigest_Quantile(TDigest *td, double q) {
+  if(td->count == 0) return NAN;
+  _TDigest_Compress(td);
+
+  TDigestCentroid *c = td->centroids;
+  uint32_t n = td->compressed;
+  double index = q * td->count;
+
+  // Before first centroid's center, interpolate from minimum.
+  if(index < c[0].count / 2) {
+    return td->min + (c[0].mean - td->min) * index / (c[0].count / 2);
+  }
+
+  // Interpolate between the centers of the centroids surrounding index.
+  double preceding = 0;
+  for(uint32_t i = 0; i + 1 < n; i++) {
+    double center = preceding + c[i].count / 2;
+    double next_center = preceding + c[i].count + c[i + 1].count / 2;
+    if(index <= next_center) {
+      return c[i].mean + (c[i + 1].mean - c[i].mean) * (index - center) / (next_center - center);
+    }
+    preceding += c[i].count;
+  }
+
+  // Past last centroid's center, interpolate towards maximum.
+  double center = td->count - c[n - 1].count / 2;
+  return c[n - 1].mean + (td->max - c[n - 1].mean) * (index - center) / (c[n - 1].count / 2);
+}
@@ -0,0 +1,49 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#ifndef __TDIGEST_H__
+#define __TDIGEST_H__
+
+#include <stdint.h>
+
+#define TDIGEST_COMPRESSION 100                         // Bounds the number of compressed centroids.
+#define TDIGEST_CAPACITY (6 * TDIGEST_COMPRESSION)      // Compressed centroids and buffered points.
+
+/* TDigest approximates the distribution of the values added to it
+ * by a bounded number of weighted centroids (merging t-digest).
+ * Centroids near the tails hold few values, such that extreme
+ * quantiles remain accurate.
+ * Values are buffered and compressed into centroids once the buffer
+ * fills up, two digests are merged by compressing their centroids together. */
+
+typedef struct {
+  double mean;
+  double count;
+} TDigestCentroid;
+
+typedef struct {
+  TDigestCentroid centroids[TDIGEST_CAPACITY];  /* Compressed centroids, followed by buffered ones. */
+  uint32_t compressed;                          /* Number of compressed centroids. */
+  uint32_t buffered;                            /* Number of centroids pending compression. */
+  double count;                                 /* Total number of values. */
+  double min;
+  double max;
+} TDigest;
+
+/* Resets digest to an empty distribution. */
+void TDigest_Init(TDigest *td);
+
+/* Adds value to digest. */
+void TDigest_Add(TDigest *td, double value);
+
+/* Adds the values of other to td. */
+void TDigest_Merge(TDigest *td, const TDigest *other);
+
+/* Estimates the q quantile, 0 <= q <= 1, of the values added to digest,
+ * NAN if digest is empty. */
+double TDigest_Quantile(TDigest *td, double q);
+
+#endif /* __TDIGEST_H__ */
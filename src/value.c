@@ -15,6 +15,8 @@
 #include <sys/param.h>
 #include <assert.h>
 #include "util/rmalloc.h"
+#include "util/string_pool.h"
+#include "xxhash/xxhash.h"
 
 SIValue SI_LongVal(int64_t i) {
   return (SIValue){.longval = i, .type = T_INT64};
@@ -69,7 +71,7 @@ SIValue SI_Clone(SIValue v) {
 SIValue SI_ShallowCopy(SIValue v) {
   SIValue dup = v;
   // If the original value owns an allocation, mark that the duplicate shares it
-  if (v.allocation == M_SELF) dup.allocation = M_CONST;
+  if (v.allocation & (M_SELF | M_INTERNED)) dup.allocation = M_CONST;
   return dup;
 }
 
@@ -212,6 +214,8 @@ int SIValue_Compare(const SIValue a, const SIValue b) {
         case T_DOUBLE:
             return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
         case T_STRING:
+            // Interned strings share a single copy.
+            if(a.stringval == b.stringval) return 0;
             return strcmp(a.stringval, b.stringval);
         case T_NODE:
         case T_EDGE:
@@ -258,6 +262,31 @@ int SIValue_Order(const SIValue a, const SIValue b) {
   return 0;
 }
 
+uint64_t SIValue_HashCode(const SIValue v) {
+  int64_t l;
+  switch (v.type) {
+    case T_STRING:
+      return XXH64(v.stringval, strlen(v.stringval), v.type);
+    case T_DOUBLE:
+      // Integral doubles are hashed as integers, as they compare equal.
+      if (v.doubleval >= INT64_MIN && v.doubleval < (double)INT64_MAX &&
+          v.doubleval == (int64_t)v.doubleval) {
+        l = (int64_t)v.doubleval;
+        return XXH64(&l, sizeof(l), T_INT64);
+      }
+      return XXH64(&v.doubleval, sizeof(v.doubleval), v.type);
+    case T_INT64:
+    case T_BOOL:
+      return XXH64(&v.longval, sizeof(v.longval), v.type);
+    case T_NODE:
+    case T_EDGE:
+      l = ENTITY_GET_ID((GraphEntity*)v.ptrval);
+      return XXH64(&l, sizeof(l), v.type);
+    default:
+      return XXH64(&v.ptrval, sizeof(v.ptrval), v.type);
+  }
+}
+
 void SIValue_Persist(SIValue *v) {
   if (v->allocation == M_VOLATILE) {
     size_t size;
@@ -276,6 +305,12 @@ void SIValue_Persist(SIValue *v) {
 }
 
 void SIValue_Free(SIValue *v) {
+  // Interned strings are released back to their pool.
+  if (v->allocation == M_INTERNED) {
+    StringPool_Release(v->stringval);
+    v->stringval = NULL;
+    return;
+  }
   // The free routine only performs work if it owns a heap allocation.
   if (v->allocation == M_SELF) {
     switch (v->type) {
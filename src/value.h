@@ -36,7 +36,8 @@ typedef enum {
   M_NONE = 0,        // SIValue is not heap-allocated
   M_SELF = 0x1,      // SIValue is responsible for freeing its reference
   M_VOLATILE = 0x2,  // SIValue does not own its reference and may go out of scope
-  M_CONST = 0x4      // SIValue does not own its allocation, but its access is safe
+  M_CONST = 0x4,     // SIValue does not own its allocation, but its access is safe
+  M_INTERNED = 0x8   // SIValue holds a reference to a string within a StringPool
 } SIAllocation;
 
 #define SI_NUMERIC (T_INT64 | T_DOUBLE)
@@ -122,6 +123,10 @@ int SIValue_Compare(const SIValue a, const SIValue b);
  * Under Cypher's orderability, where string < boolean < numeric < NULL. */
 int SIValue_Order(const SIValue a, const SIValue b);
 
+/* 64-bit hash of an SIValue, consistent with SIValue_Compare:
+ * values which compare equal (e.g. 1 and 1.0) share the same hash code. */
+uint64_t SIValue_HashCode(const SIValue v);
+
 /* If an SIValue holds a pointer to a volatile memory region, copy that memory
  * so that it is held by the SIValue. */
 void SIValue_Persist(SIValue *v);
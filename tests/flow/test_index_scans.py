@@ -72,3 +72,173 @@ class testIndexScanFlow(FlowTestsBase):
         result = redis_graph.query(query)
 
         self.env.assertEquals(result.result_set, expected_result)
+
+    # Validate that ordering by an indexed property scans the index in order rather than sorting
+    def test04_index_ordered_scan(self):
+        for direction in ['ASC', 'DESC']:
+            query = "MATCH (p:person) RETURN p.name, p.age ORDER BY p.age %s LIMIT 5" % direction
+            plan = redis_graph.execution_plan(query)
+            self.env.assertIn('Ordered Index Scan', plan)
+            self.env.assertNotIn('Sort', plan)
+            indexed_result = redis_graph.query(query)
+
+            # Ordering by an expression can't be served by the index
+            query = "MATCH (p:person) RETURN p.name, p.age ORDER BY p.age + 0 %s LIMIT 5" % direction
+            plan = redis_graph.execution_plan(query)
+            self.env.assertIn('Sort', plan)
+            self.env.assertNotIn('Index Scan', plan)
+            sorted_result = redis_graph.query(query)
+
+            # Names of persons sharing an age might differ, compare ages.
+            indexed_ages = [row[1] for row in indexed_result.result_set]
+            sorted_ages = [row[1] for row in sorted_result.result_set]
+            self.env.assertEquals(indexed_ages, sorted_ages)
+
+    # Validate that composite indices seed scans with equality prefixes and ranges
+    def test05_composite_index_scan(self):
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "CREATE INDEX ON :person(gender, status, age)")
+
+        # Each query is paired with an equivalent one filtering on expressions, which can't be served by an index
+        queries = [("MATCH (p:person) WHERE p.gender = 'female' AND p.status = 'single' RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.gender + '' = 'female' AND p.status + '' = 'single' RETURN p.name ORDER BY p.name"),
+                   ("MATCH (p:person {gender: 'male', status: 'married'}) RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.gender + '' = 'male' AND p.status + '' = 'married' RETURN p.name ORDER BY p.name"),
+                   ("MATCH (p:person) WHERE p.gender = 'male' AND p.status = 'single' AND p.age > 30 RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.gender + '' = 'male' AND p.status + '' = 'single' AND p.age + 0 > 30 RETURN p.name ORDER BY p.name"),
+                   ("MATCH (p:person) WHERE p.gender = 'female' AND p.status = 'married' AND p.age <= 40 RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.gender + '' = 'female' AND p.status + '' = 'married' AND p.age + 0 <= 40 RETURN p.name ORDER BY p.name")]
+        for indexed_query, unindexed_query in queries:
+            plan = redis_graph.execution_plan(indexed_query)
+            self.env.assertIn('Index Scan', plan)
+            self.env.assertNotIn('Label Scan', plan)
+            indexed_result = redis_graph.query(indexed_query)
+
+            plan = redis_graph.execution_plan(unindexed_query)
+            self.env.assertNotIn('Index Scan', plan)
+            unindexed_result = redis_graph.query(unindexed_query)
+
+            self.env.assertEquals(indexed_result.result_set, unindexed_result.result_set)
+
+        # Created, updated and deleted entities are reflected in the index
+        query = "MATCH (p:person) WHERE p.gender = 'other' AND p.status = 'single' RETURN p.name, p.age ORDER BY p.name"
+        redis_graph.query("CREATE (:person {name: 'Composite', gender: 'other', status: 'single', age: 20})")
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Composite', 20]])
+
+        redis_graph.query("MATCH (p:person {name: 'Composite'}) SET p.age = 21")
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Composite', 21]])
+
+        redis_graph.query("MATCH (p:person {name: 'Composite'}) SET p.status = 'married'")
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+
+        redis_graph.query("MATCH (p:person {name: 'Composite'}) DELETE p")
+        query = "MATCH (p:person) WHERE p.gender = 'other' AND p.status = 'married' RETURN p.name"
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "DROP INDEX ON :person(gender, status, age)")
+
+    def test06_edge_index_seek(self):
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "CREATE INDEX ON [:visited](purpose)")
+
+        # Each query is paired with an equivalent one filtering on expressions, which can't be served by an index
+        queries = [("MATCH (p:person)-[v:visited {purpose: 'business'}]->(c:country) RETURN p.name, c.name ORDER BY p.name, c.name",
+                    "MATCH (p:person)-[v:visited]->(c:country) WHERE v.purpose + '' = 'business' RETURN p.name, c.name ORDER BY p.name, c.name"),
+                   ("MATCH (c:country)<-[v:visited]-(p) WHERE v.purpose = 'pleasure' RETURN p.name, c.name ORDER BY p.name, c.name",
+                    "MATCH (c:country)<-[v:visited]-(p) WHERE v.purpose + '' = 'pleasure' RETURN p.name, c.name ORDER BY p.name, c.name"),
+                   ("MATCH (p:person)-[v:visited {purpose: 'business'}]->(c:country) WHERE p.age > 30 RETURN p.name, c.name ORDER BY p.name, c.name",
+                    "MATCH (p:person)-[v:visited]->(c:country) WHERE v.purpose + '' = 'business' AND p.age > 30 RETURN p.name, c.name ORDER BY p.name, c.name")]
+        for indexed_query, unindexed_query in queries:
+            plan = redis_graph.execution_plan(indexed_query)
+            self.env.assertIn('Edge Index Seek', plan)
+            self.env.assertNotIn('Conditional Traverse', plan)
+            indexed_result = redis_graph.query(indexed_query)
+
+            plan = redis_graph.execution_plan(unindexed_query)
+            self.env.assertNotIn('Edge Index Seek', plan)
+            unindexed_result = redis_graph.query(unindexed_query)
+
+            self.env.assertEquals(indexed_result.result_set, unindexed_result.result_set)
+            self.env.assertGreater(len(indexed_result.result_set), 0)
+
+        # Created, updated and deleted edges are reflected in the index
+        query = "MATCH (p:person)-[v:visited {purpose: 'research'}]->(c:country) RETURN p.name, c.name"
+        redis_graph.query("MATCH (p:person {name: 'Roi Lipman'}), (c:country {name: 'Japan'}) CREATE (p)-[:visited {purpose: 'research'}]->(c)")
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Roi Lipman', 'Japan']])
+
+        redis_graph.query("MATCH (p:person {name: 'Roi Lipman'})-[v:visited {purpose: 'research'}]->(c:country) SET v.purpose = 'conference'")
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+        query = "MATCH (p:person)-[v:visited {purpose: 'conference'}]->(c:country) RETURN p.name, c.name"
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Roi Lipman', 'Japan']])
+
+        redis_graph.query("MATCH (p:person)-[v:visited {purpose: 'conference'}]->(c:country) DELETE v")
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "DROP INDEX ON [:visited](purpose)")
+
+    def test07_hash_index_lookup(self):
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "CREATE INDEX ON :person(name) USING HASH")
+
+        # Each query is paired with an equivalent one filtering on expressions, which can't be served by an index
+        queries = [("MATCH (p:person {name: 'Roi Lipman'}) RETURN p.name, p.age",
+                    "MATCH (p:person) WHERE p.name + '' = 'Roi Lipman' RETURN p.name, p.age"),
+                   ("MATCH (p:person) WHERE p.name = 'Roi Lipman' OR p.name = 'Alon Fital' OR p.name = 'Roi Lipman' RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.name + '' = 'Roi Lipman' OR p.name + '' = 'Alon Fital' RETURN p.name ORDER BY p.name")]
+        for indexed_query, unindexed_query in queries:
+            plan = redis_graph.execution_plan(indexed_query)
+            self.env.assertIn('Index Scan', plan)
+            indexed_result = redis_graph.query(indexed_query)
+
+            plan = redis_graph.execution_plan(unindexed_query)
+            self.env.assertNotIn('Index Scan', plan)
+            unindexed_result = redis_graph.query(unindexed_query)
+
+            self.env.assertEquals(indexed_result.result_set, unindexed_result.result_set)
+            self.env.assertGreater(len(indexed_result.result_set), 0)
+
+        # Hash indices don't serve ranges
+        plan = redis_graph.execution_plan("MATCH (p:person) WHERE p.name > 'Roi' RETURN p.name")
+        self.env.assertNotIn('Index Scan', plan)
+
+        # Created nodes are reflected in the index
+        query = "MATCH (p:person {name: 'Hash Lookup'}) RETURN p.name"
+        redis_graph.query("CREATE (:person {name: 'Hash Lookup'})")
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Hash Lookup']])
+        redis_graph.query("MATCH (p:person {name: 'Hash Lookup'}) DELETE p")
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "DROP INDEX ON :person(name)")
+
+    def test08_skiplist_index_scans(self):
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "CREATE INDEX ON :person(name) USING SKIPLIST")
+
+        # Each query is paired with an equivalent one filtering on expressions, which can't be served by an index
+        queries = [("MATCH (p:person {name: 'Roi Lipman'}) RETURN p.name, p.age",
+                    "MATCH (p:person) WHERE p.name + '' = 'Roi Lipman' RETURN p.name, p.age"),
+                   ("MATCH (p:person) WHERE p.name > 'B' AND p.name <= 'Roi Lipman' RETURN p.name ORDER BY p.name",
+                    "MATCH (p:person) WHERE p.name + '' > 'B' AND p.name + '' <= 'Roi Lipman' RETURN p.name ORDER BY p.name")]
+        for indexed_query, unindexed_query in queries:
+            plan = redis_graph.execution_plan(indexed_query)
+            self.env.assertIn('Index Scan', plan)
+            indexed_result = redis_graph.query(indexed_query)
+
+            plan = redis_graph.execution_plan(unindexed_query)
+            self.env.assertNotIn('Index Scan', plan)
+            unindexed_result = redis_graph.query(unindexed_query)
+
+            self.env.assertEquals(indexed_result.result_set, unindexed_result.result_set)
+            self.env.assertGreater(len(indexed_result.result_set), 0)
+
+        # Skiplist indices are ordered, descending sorts traverse them in reverse
+        query = "MATCH (p:person) WHERE p.name > '' RETURN p.name ORDER BY p.name DESC"
+        plan = redis_graph.execution_plan(query)
+        self.env.assertNotIn('Sort', plan)
+        names = [row[0] for row in redis_graph.query(query).result_set]
+        self.env.assertEquals(names, sorted(names, reverse=True))
+
+        # Created nodes are reflected in the index
+        query = "MATCH (p:person {name: 'Skiplist Lookup'}) RETURN p.name"
+        redis_graph.query("CREATE (:person {name: 'Skiplist Lookup'})")
+        self.env.assertEquals(redis_graph.query(query).result_set, [['Skiplist Lookup']])
+        redis_graph.query("MATCH (p:person {name: 'Skiplist Lookup'}) DELETE p")
+        self.env.assertEquals(redis_graph.query(query).result_set, [])
+
+        redis_graph.redis_con.execute_command("GRAPH.QUERY", "social", "DROP INDEX ON :person(name)")
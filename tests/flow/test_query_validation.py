@@ -65,3 +65,23 @@ class testQueryValidationFlow(FlowTestsBase):
        expected_result = [["single ' char", 'double " char', 'mixed \' and " chars']]
 
        self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # LIMIT and SKIP parameters must be non-negative integers.
+    def test05_invalid_limit_param(self):
+        for query in ["CYPHER l='a' MATCH (n) RETURN n LIMIT $l",
+                      "CYPHER s=-1 MATCH (n) RETURN n SKIP $s"]:
+            try:
+                redis_graph.query(query)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                # Expecting an error.
+                pass
+
+    def test06_inline_params(self):
+        query = "CYPHER name='param' age=21 CREATE (:person {name:$name, age:$age})"
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.nodes_created, 1)
+
+        query = "CYPHER name='param' l=1 MATCH (p:person {name:$name}) RETURN p.age LIMIT $l"
+        actual_result = redis_graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [[21]])
@@ -237,3 +237,145 @@ TEST_F(AggregateTest, PartialCountTest) {
 //   ASSERT_EQ(result.doubleval, pop_result);
 //   AR_EXP_Free(stdevp);
 // }
+
+// Merging partial aggregations agrees with aggregating all values at once.
+TEST_F(AggregateTest, MergeTest) {
+  const char *queries[] = {
+    "RETURN sum(1)",
+    "RETURN avg(1)",
+    "RETURN max(1)",
+    "RETURN min(1)",
+    "RETURN count(1)",
+    "RETURN percentileDisc(1, 0.3)",
+    "RETURN percentileCont(1, 0.7)",
+    "RETURN stDev(1)",
+    "RETURN stDevP(1)",
+    "RETURN approxCountDistinct(1)",
+  };
+  // Out of order values, split unevenly between partial aggregations.
+  double values[] = {5, 1, 9, 3, 7, 2, 8, 4, 6, 10, 0.5};
+  int value_count = sizeof(values) / sizeof(values[0]);
+  int split = 4;
+  Record r = Record_New(0);
+
+  for(int i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+    AR_ExpNode *whole = _exp_from_query(queries[i]);
+    AR_ExpNode *a = _exp_from_query(queries[i]);
+    AR_ExpNode *b = _exp_from_query(queries[i]);
+
+    for(int j = 0; j < value_count; j++) {
+      AR_ExpNode *partial = (j < split) ? a : b;
+      whole->op.children[0]->operand.constant = SI_DoubleVal(values[j]);
+      partial->op.children[0]->operand.constant = SI_DoubleVal(values[j]);
+      AR_EXP_Aggregate(whole, r);
+      AR_EXP_Aggregate(partial, r);
+    }
+
+    AR_EXP_Merge(a, b);
+    AR_EXP_Reduce(whole);
+    AR_EXP_Reduce(a);
+    SIValue expected = AR_EXP_Evaluate(whole, r);
+    SIValue merged = AR_EXP_Evaluate(a, r);
+    ASSERT_DOUBLE_EQ(SI_GET_NUMERIC(merged), SI_GET_NUMERIC(expected)) << queries[i];
+
+    AR_EXP_Free(whole);
+    AR_EXP_Free(a);
+    AR_EXP_Free(b);
+  }
+
+  Record_Free(r);
+}
+
+TEST_F(AggregateTest, ApproxCountDistinctTest) {
+  Record r = Record_New(0);
+  AR_ExpNode *whole = _exp_from_query("RETURN approxCountDistinct(1)");
+  AR_ExpNode *a = _exp_from_query("RETURN approxCountDistinct(1)");
+  AR_ExpNode *b = _exp_from_query("RETURN approxCountDistinct(1)");
+
+  // 100000 distinct values, each added three times, once as a double.
+  int distinct = 100000;
+  for(int i = 0; i < distinct; i++) {
+    SIValue values[3] = {SI_LongVal(i), SI_DoubleVal(i), SI_LongVal(i)};
+    for(int j = 0; j < 3; j++) {
+      AR_ExpNode *partial = (i % 2) ? a : b;
+      whole->op.children[0]->operand.constant = values[j];
+      partial->op.children[0]->operand.constant = values[j];
+      AR_EXP_Aggregate(whole, r);
+      AR_EXP_Aggregate(partial, r);
+    }
+  }
+
+  AR_EXP_Merge(a, b);
+  AR_EXP_Reduce(whole);
+  AR_EXP_Reduce(a);
+  int64_t estimate = AR_EXP_Evaluate(whole, r).longval;
+  ASSERT_NEAR(estimate, distinct, distinct * 0.03);
+  ASSERT_EQ(AR_EXP_Evaluate(a, r).longval, estimate);
+
+  AR_EXP_Free(whole);
+  AR_EXP_Free(a);
+  AR_EXP_Free(b);
+
+  // Small sets are counted exactly.
+  AR_ExpNode *small = _exp_from_query("RETURN approxCountDistinct(1)");
+  for(int i = 0; i < 20; i++) {
+    small->op.children[0]->operand.constant = SI_LongVal(i % 10);
+    AR_EXP_Aggregate(small, r);
+  }
+  AR_EXP_Reduce(small);
+  ASSERT_EQ(AR_EXP_Evaluate(small, r).longval, 10);
+  AR_EXP_Free(small);
+
+  Record_Free(r);
+}
+
+TEST_F(AggregateTest, ApproxPercentileTest) {
+  Record r = Record_New(0);
+  const char *queries[] = {
+    "RETURN approxPercentile(1, 0)",
+    "RETURN approxPercentile(1, 0.01)",
+    "RETURN approxPercentile(1, 0.25)",
+    "RETURN approxPercentile(1, 0.5)",
+    "RETURN approxPercentile(1, 0.99)",
+    "RETURN approxPercentile(1, 1)",
+  };
+  double percentiles[] = {0, 0.01, 0.25, 0.5, 0.99, 1};
+  // Values 0..count-1, added in a scattered order and split between partial aggregations.
+  int count = 100000;
+
+  for(int i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+    AR_ExpNode *whole = _exp_from_query(queries[i]);
+    AR_ExpNode *a = _exp_from_query(queries[i]);
+    AR_ExpNode *b = _exp_from_query(queries[i]);
+
+    for(int j = 0; j < count; j++) {
+      SIValue v = SI_LongVal(((int64_t)j * 7919) % count);
+      AR_ExpNode *partial = (j < count / 3) ? a : b;
+      whole->op.children[0]->operand.constant = v;
+      partial->op.children[0]->operand.constant = v;
+      AR_EXP_Aggregate(whole, r);
+      AR_EXP_Aggregate(partial, r);
+    }
+
+    AR_EXP_Merge(a, b);
+    AR_EXP_Reduce(whole);
+    AR_EXP_Reduce(a);
+
+    // Rank error is bounded, tails are more accurate than the median.
+    double expected = percentiles[i] * (count - 1);
+    ASSERT_NEAR(AR_EXP_Evaluate(whole, r).doubleval, expected, count * 0.005) << queries[i];
+    ASSERT_NEAR(AR_EXP_Evaluate(a, r).doubleval, expected, count * 0.005) << queries[i];
+
+    AR_EXP_Free(whole);
+    AR_EXP_Free(a);
+    AR_EXP_Free(b);
+  }
+
+  // Empty group.
+  AR_ExpNode *empty = _exp_from_query("RETURN approxPercentile(1, 0.5)");
+  AR_EXP_Reduce(empty);
+  ASSERT_EQ(AR_EXP_Evaluate(empty, r).type, T_NULL);
+  AR_EXP_Free(empty);
+
+  Record_Free(r);
+}
@@ -0,0 +1,248 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/parser/grammar.h"
+#include "../../src/arithmetic/arithmetic_program.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/filter_tree/filter_tree.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/util/simple_timer.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 1000
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class ArithmeticProgramTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = NULL;
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    // Node i has age i % 100, score i / 10 and name 'n<i % 7>'.
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+        Attribute_ID score = GraphContext_FindOrAddAttribute(gc, "score");
+        Attribute_ID name = GraphContext_FindOrAddAttribute(gc, "name");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, GRAPH_NO_LABEL, &n);
+            snprintf(buf, 16, "n%d", i % 7);
+            GraphEntity_AddProperty((GraphEntity*)&n, age, SI_LongVal(i % 100));
+            GraphEntity_AddProperty((GraphEntity*)&n, score, SI_DoubleVal(i / 10.0));
+            GraphEntity_AddProperty((GraphEntity*)&n, name, SI_ConstStringVal(buf));
+        }
+        Graph_ReleaseLock(gc->g);
+    }
+
+    static AST** _build_ast(const char *query) {
+        char *errMsg = NULL;
+        AST **ast = ParseQuery(query, strlen(query), &errMsg);
+        if(!ast) fprintf(stderr, "%s: %s\n", query, errMsg);
+        assert(ast);
+        AST_NameAnonymousNodes(ast[0]);
+        return ast;
+    }
+
+    static Record _node_record(AST *ast, NodeID id) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Node n;
+        Graph_GetNode(gc->g, id, &n);
+        Record r = Record_New(AST_AliasCount(ast));
+        Record_AddNode(r, AST_GetAliasID(ast, (char*)"n"), n);
+        return r;
+    }
+
+    // Validates compiled filter agrees with the filter tree on every node.
+    static void _validate_filter(const char *query) {
+        AST **asts = _build_ast(query);
+        AST *ast = asts[0];
+        FT_FilterNode *tree = BuildFiltersTree(ast, ast->whereNode->filters);
+        AR_Program *p = FilterTree_Compile(tree);
+
+        for(NodeID i = 0; i < NODE_COUNT; i++) {
+            Record r = _node_record(ast, i);
+            bool pass = AR_Program_Test(p, r);
+            ASSERT_EQ(pass, FilterTree_applyFilters(tree, r) == FILTER_PASS) << query << " node " << i;
+            Record_Free(r);
+        }
+
+        AR_Program_Free(p);
+        FilterTree_Free(tree);
+        AST_Free(asts);
+    }
+
+    static AR_ExpNode* _build_exp(AST *ast) {
+        return AR_EXP_BuildFromAST(ast, ast->returnNode->returnElements[0]->exp);
+    }
+};
+
+TEST_F(ArithmeticProgramTest, ConstantFolding) {
+    AST **asts = _build_ast("RETURN 2 * 3 + 1");
+    AST *ast = asts[0];
+    AR_ExpNode *exp = _build_exp(ast);
+    AR_Program *p = AR_EXP_Compile(exp);
+    // Folded into a single constant.
+    ASSERT_EQ(array_len(p->code), 1);
+    ASSERT_EQ(p->code[0].code, AR_INSTR_PUSH_CONST);
+    ASSERT_EQ(AR_Program_Evaluate(p, NULL).longval, 7);
+    AR_Program_Free(p);
+    AR_EXP_Free(exp);
+    AST_Free(asts);
+
+    asts = _build_ast("RETURN toUpper('x')");
+    ast = asts[0];
+    exp = _build_exp(ast);
+    p = AR_EXP_Compile(exp);
+    ASSERT_EQ(array_len(p->code), 1);
+    SIValue v = AR_Program_Evaluate(p, NULL);
+    ASSERT_STREQ(v.stringval, "X");
+    ASSERT_EQ(v.allocation, M_CONST);
+    AR_Program_Free(p);
+    AR_EXP_Free(exp);
+    AST_Free(asts);
+
+    // Properties and rand are evaluated per record.
+    asts = _build_ast("MATCH (n) RETURN n.age * (2 + 3) + rand() * 0");
+    ast = asts[0];
+    exp = _build_exp(ast);
+    p = AR_EXP_Compile(exp);
+    Record r = _node_record(ast, 42);
+    ASSERT_EQ(AR_Program_Evaluate(p, r).doubleval, 42 * 5);
+    // n.age, 5, MUL, rand, 0, MUL, ADD
+    ASSERT_EQ(array_len(p->code), 7);
+    Record_Free(r);
+    AR_Program_Free(p);
+    AR_EXP_Free(exp);
+    AST_Free(asts);
+}
+
+TEST_F(ArithmeticProgramTest, ResolveAttributes) {
+    AST **asts = _build_ast("MATCH (n) RETURN n.later");
+    AST *ast = asts[0];
+    AR_ExpNode *exp = _build_exp(ast);
+    AR_Program *p = AR_EXP_Compile(exp);
+    ASSERT_EQ(p->code[0].prop.attr_id, ATTRIBUTE_NOTFOUND);
+
+    Record r = _node_record(ast, 0);
+    ASSERT_EQ(AR_Program_Evaluate(p, r).type, T_NULL);
+
+    // Attribute introduced after compilation.
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Attribute_ID later = GraphContext_FindOrAddAttribute(gc, "later");
+    GraphEntity_AddProperty(Record_GetGraphEntity(r, AST_GetAliasID(ast, (char*)"n")), later, SI_LongVal(5));
+    ASSERT_EQ(AR_Program_Evaluate(p, r).longval, 5);
+    ASSERT_EQ(p->code[0].prop.attr_id, later);
+
+    Record_Free(r);
+    AR_Program_Free(p);
+    AR_EXP_Free(exp);
+    AST_Free(asts);
+}
+
+TEST_F(ArithmeticProgramTest, CompiledFilters) {
+    const char *queries[] = {
+        "MATCH (n) WHERE n.age > 50 RETURN n",
+        "MATCH (n) WHERE 50 >= n.age RETURN n",
+        "MATCH (n) WHERE n.score < 20.5 AND n.age != 3 RETURN n",
+        "MATCH (n) WHERE n.age = 7 OR n.score >= 90 OR n.name = 'n3' RETURN n",
+        "MATCH (n) WHERE (n.age < 10 OR n.age > 90) AND (n.name != 'n1' OR n.score < 5) RETURN n",
+        "MATCH (n) WHERE n.age * 2 + 1 > n.score RETURN n",
+        "MATCH (n) WHERE n.age > 2.5 * 4 AND n.name < toUpper('n') RETURN n",
+        "MATCH (n) WHERE n.name = 4 RETURN n",
+        "MATCH (n) WHERE n.name != 4 RETURN n",
+        "MATCH (n) WHERE n.missing = 1 OR 1 = 1 RETURN n",
+        "MATCH (n) WHERE 1 > 2 OR n.age <= 1 RETURN n",
+    };
+
+    for(int i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+        _validate_filter(queries[i]);
+    }
+}
+
+TEST_F(ArithmeticProgramTest, FilterBenchmark) {
+    const char *query = "MATCH (n) WHERE n.age > 10 AND n.score < 90.5 AND n.age * 2 != 3 * 7 RETURN n";
+    AST **asts = _build_ast(query);
+    AST *ast = asts[0];
+    FT_FilterNode *tree = BuildFiltersTree(ast, ast->whereNode->filters);
+    AR_Program *p = FilterTree_Compile(tree);
+
+    Record records[NODE_COUNT];
+    for(NodeID i = 0; i < NODE_COUNT; i++) records[i] = _node_record(ast, i);
+
+    int rounds = 1000;
+    int tree_passed = 0;
+    int program_passed = 0;
+    double tic[2];
+
+    simple_tic(tic);
+    for(int j = 0; j < rounds; j++) {
+        for(int i = 0; i < NODE_COUNT; i++) tree_passed += FilterTree_applyFilters(tree, records[i]);
+    }
+    double tree_time = simple_toc(tic);
+
+    simple_tic(tic);
+    for(int j = 0; j < rounds; j++) {
+        for(int i = 0; i < NODE_COUNT; i++) program_passed += AR_Program_Test(p, records[i]);
+    }
+    double program_time = simple_toc(tic);
+
+    printf("Filtered %d records, filter tree: %.6f sec, compiled: %.6f sec\n",
+           rounds * NODE_COUNT, tree_time, program_time);
+    ASSERT_EQ(tree_passed, program_passed);
+
+    for(NodeID i = 0; i < NODE_COUNT; i++) Record_Free(records[i]);
+    AR_Program_Free(p);
+    FilterTree_Free(tree);
+    AST_Free(asts);
+}
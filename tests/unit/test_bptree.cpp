@@ -0,0 +1,382 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/graph/graph.h"
+#include "../../src/index/index.h"
+#include "../../src/index/bptree.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class BPTreeTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        srand(0);
+    }
+
+    // Consumes iterator, returns the entities it produced in order.
+    static std::vector<NodeID> _collect(BPTreeIterator *iter) {
+        std::vector<NodeID> ids;
+        NodeID *id;
+        while((id = BPTreeIterator_Next(iter))) ids.push_back(*id);
+        return ids;
+    }
+
+    // Entities of reference keys within [lo, hi], in key order.
+    template<typename K>
+    static std::vector<NodeID> _expected(const std::map<K, std::set<NodeID>> &ref, const K &lo,
+                                         const K &hi, bool reverse) {
+        std::vector<std::vector<NodeID>> keys;
+        for(auto it = ref.lower_bound(lo); it != ref.end() && !(hi < it->first); it++) {
+            keys.push_back(std::vector<NodeID>(it->second.begin(), it->second.end()));
+        }
+        if(reverse) std::reverse(keys.begin(), keys.end());
+        std::vector<NodeID> ids;
+        for(auto &k : keys) ids.insert(ids.end(), k.begin(), k.end());
+        return ids;
+    }
+
+    // Zero padded keys share long prefixes, as UUIDs and other generated keys do.
+    static std::string _stringKey(int i) {
+        char buf[32];
+        snprintf(buf, 32, "device:%08d", i);
+        return std::string(buf);
+    }
+};
+
+TEST_F(BPTreeTest, NumericKeys) {
+    BPTree *tree = BPTree_New(false);
+    std::map<double, std::set<NodeID>> ref;
+    std::vector<int> keys;
+
+    // Enough keys for a multi level tree, integers and doubles alike.
+    for(NodeID id = 0; id < 20000; id++) {
+        int k = rand() % 5000;
+        SIValue key = (id % 2) ? SI_LongVal(k) : SI_DoubleVal(k);
+        ASSERT_TRUE(BPTree_Insert(tree, &key, id));
+        ASSERT_FALSE(BPTree_Insert(tree, &key, id));
+        ref[k].insert(id);
+        keys.push_back(k);
+    }
+    ASSERT_EQ(BPTree_KeyCount(tree), ref.size());
+
+    // Remove most entities, emptying most keys.
+    for(NodeID id = 0; id < 20000; id++) {
+        if(id % 7 == 0) continue;
+        double k = keys[id];
+        SIValue key = SI_DoubleVal(k);
+        ASSERT_TRUE(BPTree_Delete(tree, &key, id));
+        ASSERT_FALSE(BPTree_Delete(tree, &key, id));
+        ref[k].erase(id);
+        if(ref[k].empty()) ref.erase(k);
+    }
+    ASSERT_EQ(BPTree_KeyCount(tree), ref.size());
+
+    uint64_t count;
+    for(auto &e : ref) {
+        SIValue key = SI_LongVal((int64_t)e.first);
+        const NodeID *ids = BPTree_Lookup(tree, &key, &count);
+        ASSERT_EQ(count, e.second.size());
+        ASSERT_TRUE(std::equal(e.second.begin(), e.second.end(), ids));
+    }
+
+    BPTreeIterator *iter = BPTree_IterateAll(tree);
+    ASSERT_EQ(_collect(iter), _expected(ref, -1.0, 5000.0, false));
+    BPTreeIterator_Reverse(iter);
+    ASSERT_EQ(_collect(iter), _expected(ref, -1.0, 5000.0, true));
+    BPTreeIterator_Free(iter);
+
+    // Large integers are compared exactly.
+    SIValue big = SI_LongVal(INT64_MAX);
+    SIValue big_neighbour = SI_LongVal(INT64_MAX - 1);
+    ASSERT_TRUE(BPTree_Insert(tree, &big, 1));
+    ASSERT_TRUE(BPTree_Insert(tree, &big_neighbour, 2));
+    ASSERT_EQ(*BPTree_Lookup(tree, &big, &count), 1);
+    ASSERT_EQ(*BPTree_Lookup(tree, &big_neighbour, &count), 2);
+
+    // Strings aren't stored by numeric trees.
+    SIValue s = SI_ConstStringVal((char*)"1");
+    ASSERT_FALSE(BPTree_SupportsKey(tree, &s));
+    ASSERT_TRUE(BPTree_Lookup(tree, &s, &count) == NULL);
+
+    BPTree_Free(tree);
+}
+
+TEST_F(BPTreeTest, StringKeys) {
+    BPTree *tree = BPTree_New(true);
+    std::map<std::string, std::set<NodeID>> ref;
+
+    std::vector<int> order;
+    for(int i = 0; i < 10000; i++) order.push_back(i);
+    std::random_shuffle(order.begin(), order.end());
+
+    for(int i : order) {
+        std::string k = _stringKey(i);
+        SIValue key = SI_ConstStringVal((char*)k.c_str());
+        ASSERT_TRUE(BPTree_Insert(tree, &key, i));
+        ref[k].insert(i);
+    }
+    // Keys sharing a prefix with stored keys, and keys which are prefixes of stored keys.
+    const char *extra[] = {"", "device:", "device:0000", "device:00001234x", "devicf", "a", "z"};
+    for(int i = 0; i < 7; i++) {
+        SIValue key = SI_ConstStringVal((char*)extra[i]);
+        ASSERT_TRUE(BPTree_Insert(tree, &key, 20000 + i));
+        ref[extra[i]].insert(20000 + i);
+    }
+    ASSERT_EQ(BPTree_KeyCount(tree), ref.size());
+
+    uint64_t count;
+    for(auto &e : ref) {
+        SIValue key = SI_ConstStringVal((char*)e.first.c_str());
+        const NodeID *ids = BPTree_Lookup(tree, &key, &count);
+        ASSERT_EQ(count, 1);
+        ASSERT_EQ(ids[0], *e.second.begin());
+    }
+    SIValue missing = SI_ConstStringVal((char*)"device:000012345");
+    ASSERT_TRUE(BPTree_Lookup(tree, &missing, &count) == NULL);
+
+    BPTreeIterator *iter = BPTree_IterateAll(tree);
+    ASSERT_EQ(_collect(iter), _expected(ref, std::string(""), std::string("zz"), false));
+    BPTreeIterator_Free(iter);
+
+    // Remove keys in random order until the tree is empty, validating ranges along the way.
+    std::random_shuffle(order.begin(), order.end());
+    for(size_t n = 0; n < order.size(); n++) {
+        std::string k = _stringKey(order[n]);
+        SIValue key = SI_ConstStringVal((char*)k.c_str());
+        ASSERT_TRUE(BPTree_Delete(tree, &key, order[n]));
+        ref.erase(k);
+
+        if(n % 1000 == 0) {
+            std::string lo = _stringKey(rand() % 10000);
+            std::string hi = _stringKey(rand() % 10000);
+            SIValue lo_key = SI_ConstStringVal((char*)lo.c_str());
+            SIValue hi_key = SI_ConstStringVal((char*)hi.c_str());
+            iter = BPTree_IterateAll(tree);
+            BPTreeIterator_UpdateBound(iter, &lo_key, GE);
+            BPTreeIterator_UpdateBound(iter, &hi_key, LE);
+            ASSERT_EQ(_collect(iter), _expected(ref, lo, hi, false));
+            BPTreeIterator_Reverse(iter);
+            ASSERT_EQ(_collect(iter), _expected(ref, lo, hi, true));
+            BPTreeIterator_Free(iter);
+        }
+    }
+    for(int i = 0; i < 7; i++) {
+        SIValue key = SI_ConstStringVal((char*)extra[i]);
+        ASSERT_TRUE(BPTree_Delete(tree, &key, 20000 + i));
+    }
+    ASSERT_EQ(BPTree_KeyCount(tree), 0);
+
+    iter = BPTree_IterateAll(tree);
+    ASSERT_TRUE(BPTreeIterator_Next(iter) == NULL);
+    BPTreeIterator_Reverse(iter);
+    ASSERT_TRUE(BPTreeIterator_Next(iter) == NULL);
+    BPTreeIterator_Free(iter);
+
+    // An emptied tree can be refilled.
+    SIValue key = SI_ConstStringVal((char*)"again");
+    ASSERT_TRUE(BPTree_Insert(tree, &key, 3));
+    ASSERT_EQ(*BPTree_Lookup(tree, &key, &count), 3);
+
+    BPTree_Free(tree);
+}
+
+TEST_F(BPTreeTest, IteratorBounds) {
+    BPTree *tree = BPTree_New(false);
+    // Keys 0 to 999, each held by two entities.
+    for(int i = 0; i < 1000; i++) {
+        SIValue key = SI_LongVal(i);
+        BPTree_Insert(tree, &key, 2 * i + 1);
+        BPTree_Insert(tree, &key, 2 * i);
+    }
+
+    SIValue lo = SI_LongVal(100);
+    SIValue hi = SI_DoubleVal(200);
+    SIValue narrower = SI_LongVal(150);
+    SIValue s = SI_ConstStringVal((char*)"150");
+
+    BPTreeIterator *iter = BPTree_IterateAll(tree);
+    ASSERT_TRUE(BPTreeIterator_UpdateBound(iter, &lo, GT));
+    ASSERT_TRUE(BPTreeIterator_UpdateBound(iter, &hi, LE));
+    // A wider bound leaves the range as is.
+    ASSERT_TRUE(BPTreeIterator_UpdateBound(iter, &lo, GE));
+    // Inequalities and values of other types aren't translated into bounds.
+    ASSERT_FALSE(BPTreeIterator_UpdateBound(iter, &narrower, NE));
+    ASSERT_FALSE(BPTreeIterator_UpdateBound(iter, &s, LT));
+
+    std::vector<NodeID> ids = _collect(iter);
+    ASSERT_EQ(ids.size(), 200);
+    ASSERT_EQ(ids.front(), 202);
+    ASSERT_EQ(ids.back(), 401);
+
+    // Within a key entities are produced by ascending ID, in either direction.
+    BPTreeIterator_Reverse(iter);
+    ids = _collect(iter);
+    ASSERT_EQ(ids.size(), 200);
+    ASSERT_EQ(ids[0], 400);
+    ASSERT_EQ(ids[1], 401);
+    ASSERT_EQ(ids.back(), 203);
+    BPTreeIterator_Free(iter);
+
+    iter = BPTree_IterateAll(tree);
+    BPTreeIterator_UpdateBound(iter, &lo, GE);
+    BPTreeIterator_UpdateBound(iter, &narrower, EQ);
+    ids = _collect(iter);
+    ASSERT_EQ(ids.size(), 2);
+    ASSERT_EQ(ids[0], 300);
+
+    // Contradicting bounds produce nothing.
+    BPTreeIterator_UpdateBound(iter, &lo, LT);
+    ASSERT_EQ(_collect(iter).size(), 0);
+    BPTreeIterator_Free(iter);
+
+    // Reset iterators reflect updates.
+    iter = BPTree_IterateAll(tree);
+    BPTreeIterator_UpdateBound(iter, &narrower, GE);
+    BPTreeIterator_UpdateBound(iter, &narrower, LE);
+    ASSERT_EQ(_collect(iter).size(), 2);
+    BPTree_Delete(tree, &narrower, 300);
+    BPTreeIterator_Reset(iter);
+    ids = _collect(iter);
+    ASSERT_EQ(ids.size(), 1);
+    ASSERT_EQ(ids[0], 301);
+    BPTreeIterator_Free(iter);
+
+    BPTree_Free(tree);
+}
+
+TEST_F(BPTreeTest, PrefixMatching) {
+    BPTree *tree = BPTree_NewPrefixMatching();
+    // Keys sharing a group prefix span many leaves, groups are a, b and c.
+    char buf[32];
+    const char groups[3] = {'a', 'b', 'c'};
+    for(NodeID id = 0; id < 3000; id++) {
+        snprintf(buf, 32, "%c/%04d", groups[id % 3], (int)id);
+        SIValue key = SI_ConstStringVal(buf);
+        ASSERT_TRUE(BPTree_Insert(tree, &key, id));
+    }
+
+    // A probe matches every key it is a prefix of.
+    uint64_t count;
+    SIValue full = SI_ConstStringVal((char*)"b/0001");
+    ASSERT_TRUE(BPTree_Lookup(tree, &full, &count) != NULL);
+    ASSERT_EQ(count, 1);
+
+    SIValue group = SI_ConstStringVal((char*)"b/");
+    const int ops[4] = {GE, GT, LE, LT};
+    for(int reverse = 0; reverse < 2; reverse++) {
+        for(int o = 0; o < 4; o++) {
+            BPTreeIterator *iter = BPTree_IterateAll(tree);
+            ASSERT_TRUE(BPTreeIterator_UpdateBound(iter, &group, ops[o]));
+            if(reverse) BPTreeIterator_Reverse(iter);
+            std::vector<NodeID> ids = _collect(iter);
+            BPTreeIterator_Free(iter);
+
+            // Exclusive bounds leave out the whole group, inclusive bounds take it whole.
+            std::vector<NodeID> expected;
+            for(int g = 0; g < 3; g++) {
+                bool within = (ops[o] == GE) ? g >= 1 : (ops[o] == GT) ? g > 1 : (ops[o] == LE) ? g <= 1 : g < 1;
+                if(!within) continue;
+                // Keys are zero padded, IDs grow with keys within a group.
+                for(NodeID id = g; id < 3000; id += 3) expected.push_back(id);
+            }
+            if(reverse) std::reverse(expected.begin(), expected.end());
+            ASSERT_EQ(ids, expected) << o << " " << reverse;
+        }
+    }
+
+    BPTree_Free(tree);
+}
+
+TEST_F(BPTreeTest, Index) {
+    ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+    size_t n = 1000;
+    Graph *g = Graph_New(n, n);
+    Graph_AcquireWriteLock(g);
+    int label_id = Graph_AddLabel(g);
+    Graph_AllocateNodes(g, n);
+
+    // Node i holds value i % 100, as a string for every tenth node.
+    Node node;
+    char buf[16];
+    for(int i = 0; i < n; i++) {
+        Graph_CreateNode(g, label_id, &node);
+        SIValue v = SI_LongVal(i % 100);
+        if(i % 10 == 0) {
+            snprintf(buf, 16, "%03d", i % 100);
+            v = SI_DuplicateStringVal(buf);
+        }
+        GraphEntity_AddProperty((GraphEntity*)&node, 0, v);
+    }
+    Graph_ReleaseLock(g);
+
+    Index *idx = Index_Create(g, "L", label_id, "v", 0, IDX_BTREE);
+    ASSERT_FALSE(Index_IsHashIndex(idx));
+    ASSERT_TRUE(idx->string_sl == NULL);
+    ASSERT_EQ(Index_EntityCount(idx), n);
+    ASSERT_EQ(Index_DistinctCount(idx), 100);
+
+    IndexIter *iter = IndexIter_Create(idx, T_INT64);
+    SIValue lo = SI_LongVal(10);
+    SIValue hi = SI_LongVal(20);
+    ASSERT_TRUE(IndexIter_ApplyBound(iter, &lo, GE));
+    ASSERT_TRUE(IndexIter_ApplyBound(iter, &hi, LT));
+    // Values 11 to 19, each held by 10 nodes.
+    int count = 0;
+    NodeID *id;
+    while((id = IndexIter_Next(iter))) {
+        ASSERT_GE(*id % 100, 11);
+        ASSERT_LT(*id % 100, 20);
+        count++;
+    }
+    ASSERT_EQ(count, 90);
+    IndexIter_Free(iter);
+
+    // Strings are iterated in descending order once reversed.
+    iter = IndexIter_Create(idx, T_STRING);
+    IndexIter_Reverse(iter);
+    NodeID prev = n;
+    count = 0;
+    while((id = IndexIter_Next(iter))) {
+        ASSERT_EQ(*id % 10, 0);
+        if(prev < n) {
+            ASSERT_LE(*id % 100, prev % 100);
+        }
+        prev = *id;
+        count++;
+    }
+    ASSERT_EQ(count, 100);
+
+    // Updates are reflected once the iterator is reset.
+    SIValue v = SI_ConstStringVal((char*)"090");
+    Index_DeleteNode(idx, 90, &v);
+    IndexIter_Reset(iter);
+    id = IndexIter_Next(iter);
+    ASSERT_EQ(*id, 190);
+    IndexIter_Free(iter);
+
+    Index_Free(idx);
+    Graph_Free(g);
+    GrB_finalize();
+}
@@ -0,0 +1,331 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "../../src/value.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/index/composite_index.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 100
+#define READING_COUNT 40
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class CompositeIndexTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->schema_version = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* User i belongs to tenant "t<i % 5>" unless i is a multiple of 11,
+     * has email "u<i>" unless i is a multiple of 7, and age i % 10. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "User", SCHEMA_NODE);
+        Attribute_ID tenant = GraphContext_FindOrAddAttribute(gc, "tenant");
+        Attribute_ID email = GraphContext_FindOrAddAttribute(gc, "email");
+        Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, s->id, &n);
+            if(i % 11 != 0) {
+                snprintf(buf, 16, "t%d", i % 5);
+                GraphEntity_AddProperty((GraphEntity*)&n, tenant, SI_DuplicateStringVal(buf));
+            }
+            if(i % 7 != 0) {
+                snprintf(buf, 16, "u%d", i);
+                GraphEntity_AddProperty((GraphEntity*)&n, email, SI_DuplicateStringVal(buf));
+            }
+            GraphEntity_AddProperty((GraphEntity*)&n, age, SI_LongVal(i % 10));
+        }
+        Graph_ReleaseLock(gc->g);
+    }
+
+    // Replaces the composite indices over users by indices of the given type.
+    static void _reindex(IndexType type) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        const char *tenant_email[2] = {"tenant", "email"};
+        const char *tenant_age[2] = {"tenant", "age"};
+        GraphContext_DeleteCompositeIndex(gc, "User", tenant_email, 2);
+        GraphContext_DeleteCompositeIndex(gc, "User", tenant_age, 2);
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", tenant_email, 2, type), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", tenant_age, 2, type), INDEX_OK);
+        ASSERT_EQ(_index("email")->type, type);
+    }
+
+    static CompositeIndex *_index(const char *second) {
+        const char *attributes[2] = {"tenant", second};
+        return GraphContext_GetCompositeIndex(GraphContext_GetFromTLS(), "User", attributes, 2);
+    }
+
+    // Consumes iterator, returns the number of nodes it produced.
+    static int _count(IndexIter *iter, bool *seen) {
+        int count = 0;
+        NodeID *id;
+        while((id = IndexIter_Next(iter))) {
+            if(seen) {
+                EXPECT_FALSE(seen[*id]);
+                seen[*id] = true;
+            }
+            count++;
+        }
+        return count;
+    }
+};
+
+static const IndexType types[2] = {IDX_BTREE, IDX_SKIPLIST};
+
+TEST_F(CompositeIndexTest, Lookup) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    const char *attributes[2] = {"tenant", "email"};
+    // Composite indices are ordered.
+    ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", attributes, 2, IDX_HASH), INDEX_FAIL);
+
+    for(int t = 0; t < 2; t++) {
+        _reindex(types[t]);
+        // Identical indices can't coexist.
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", attributes, 2, IDX_BTREE), INDEX_FAIL);
+        // Attributes of a composite index are ordered.
+        const char *reversed[2] = {"email", "tenant"};
+        ASSERT_TRUE(GraphContext_GetCompositeIndex(gc, "User", reversed, 2) == NULL);
+
+        // Users without a tenant aren't indexed.
+        CompositeIndex *idx = _index("email");
+        ASSERT_TRUE(idx != NULL);
+        ASSERT_EQ(CompositeIndex_EntityCount(idx), NODE_COUNT - 10);
+    }
+}
+
+TEST_F(CompositeIndexTest, PrefixMatch) {
+    for(int t = 0; t < 2; t++) {
+        _reindex(types[t]);
+        CompositeIndex *idx = _index("email");
+
+        // Full key.
+        SIValue key[2] = {SI_ConstStringVal((char*)"t1"), SI_ConstStringVal((char*)"u6")};
+        IndexIter *iter = CompositeIndexIter_Create(idx, key, 2, NULL, 0, NULL, 0);
+        bool seen[NODE_COUNT] = {false};
+        ASSERT_EQ(_count(iter, seen), 1);
+        ASSERT_TRUE(seen[6]);
+        IndexIter_Free(iter);
+
+        // Tenant prefix, including users without an email.
+        iter = CompositeIndexIter_Create(idx, key, 1, NULL, 0, NULL, 0);
+        memset(seen, 0, sizeof(seen));
+        int expected = 0;
+        for(int i = 0; i < NODE_COUNT; i++) {
+            if(i % 5 == 1 && i % 11 != 0) expected++;
+        }
+        ASSERT_EQ(_count(iter, seen), expected);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            ASSERT_EQ(seen[i], i % 5 == 1 && i % 11 != 0);
+        }
+
+        // Reset restarts the scan.
+        IndexIter_Reset(iter);
+        ASSERT_EQ(_count(iter, NULL), expected);
+        IndexIter_Free(iter);
+
+        // Unknown tenant.
+        SIValue missing = SI_ConstStringVal((char*)"t9");
+        iter = CompositeIndexIter_Create(idx, &missing, 1, NULL, 0, NULL, 0);
+        ASSERT_EQ(_count(iter, NULL), 0);
+        IndexIter_Free(iter);
+    }
+}
+
+TEST_F(CompositeIndexTest, RangeMatch) {
+    for(int t = 0; t < 2; t++) {
+        _reindex(types[t]);
+        CompositeIndex *idx = _index("age");
+
+        // tenant = "t2" AND 3 < age <= 7
+        SIValue tenant = SI_ConstStringVal((char*)"t2");
+        SIValue min = SI_LongVal(3);
+        SIValue max = SI_DoubleVal(7.0);
+        IndexIter *iter = CompositeIndexIter_Create(idx, &tenant, 1, &min, 1, &max, 0);
+        bool seen[NODE_COUNT] = {false};
+        _count(iter, seen);
+        IndexIter_Free(iter);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            bool match = (i % 5 == 2 && i % 11 != 0 && i % 10 > 3 && i % 10 <= 7);
+            ASSERT_EQ(seen[i], match) << i;
+        }
+
+        // tenant >= "t3", a bound on the leading attribute alone.
+        SIValue low = SI_ConstStringVal((char*)"t3");
+        iter = CompositeIndexIter_Create(idx, NULL, 0, &low, 0, NULL, 0);
+        memset(seen, 0, sizeof(seen));
+        _count(iter, seen);
+        IndexIter_Free(iter);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            ASSERT_EQ(seen[i], i % 5 >= 3 && i % 11 != 0) << i;
+        }
+    }
+}
+
+TEST_F(CompositeIndexTest, Maintenance) {
+    for(int t = 0; t < 2; t++) {
+        _reindex(types[t]);
+        GraphContext *gc = GraphContext_GetFromTLS();
+        CompositeIndex *idx = _index("email");
+        Attribute_ID email = GraphContext_GetAttributeID(gc, "email");
+        uint64_t count = CompositeIndex_EntityCount(idx);
+
+        SIValue key[2] = {SI_ConstStringVal((char*)"t3"), SI_ConstStringVal((char*)"changed")};
+        IndexIter *iter = CompositeIndexIter_Create(idx, key, 2, NULL, 0, NULL, 0);
+        ASSERT_EQ(_count(iter, NULL), 0);
+
+        // Update user 8's email, removing the old key and introducing the new one.
+        Node n;
+        Graph_GetNode(gc->g, 8, &n);
+        CompositeIndex_DeleteNode(idx, &n);
+        ASSERT_EQ(CompositeIndex_EntityCount(idx), count - 1);
+        GraphEntity_SetProperty((GraphEntity*)&n, email, SI_DuplicateStringVal("changed"));
+        CompositeIndex_InsertNode(idx, &n);
+        ASSERT_EQ(CompositeIndex_EntityCount(idx), count);
+
+        IndexIter_Reset(iter);
+        bool seen[NODE_COUNT] = {false};
+        ASSERT_EQ(_count(iter, seen), 1);
+        ASSERT_TRUE(seen[8]);
+        IndexIter_Free(iter);
+
+        // Old key is gone.
+        key[1] = SI_ConstStringVal((char*)"u8");
+        iter = CompositeIndexIter_Create(idx, key, 2, NULL, 0, NULL, 0);
+        ASSERT_EQ(_count(iter, NULL), 0);
+        IndexIter_Free(iter);
+
+        // Restore user 8's email.
+        CompositeIndex_DeleteNode(idx, &n);
+        GraphEntity_SetProperty((GraphEntity*)&n, email, SI_DuplicateStringVal("u8"));
+        CompositeIndex_InsertNode(idx, &n);
+    }
+}
+
+/* Readings hold sensor names sharing prefixes and escaped bytes,
+ * and values of either numeric type, far apart and close together. */
+static const char *sensors[5] = {"s", "s\x01", "s\x01x", "s\x02", "sx"};
+static const SIValue readings[14] = {
+    SI_DoubleVal(-1e300), SI_LongVal(INT64_MIN), SI_LongVal(-5), SI_DoubleVal(-2.5),
+    SI_DoubleVal(-0.0), SI_LongVal(0), SI_DoubleVal(0.5), SI_LongVal(1), SI_DoubleVal(1.0),
+    SI_LongVal(2), SI_LongVal(9007199254740993), SI_LongVal(INT64_MAX - 1),
+    SI_LongVal(INT64_MAX), SI_DoubleVal(1e300)
+};
+
+// Numerics compared exactly, integers beyond double precision included.
+static int _compareReadings(const SIValue *a, const SIValue *b) {
+    long double x = (a->type == T_INT64) ? (long double)a->longval : a->doubleval;
+    long double y = (b->type == T_INT64) ? (long double)b->longval : b->doubleval;
+    return (x > y) - (x < y);
+}
+
+TEST_F(CompositeIndexTest, EncodedOrder) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Schema *s = GraphContext_AddSchema(gc, "Reading", SCHEMA_NODE);
+    Attribute_ID sensor = GraphContext_FindOrAddAttribute(gc, "sensor");
+    Attribute_ID value = GraphContext_FindOrAddAttribute(gc, "value");
+
+    // Reading i is node NODE_COUNT + i.
+    Node n;
+    Graph_AcquireWriteLock(gc->g);
+    for(int i = 0; i < READING_COUNT; i++) {
+        Graph_CreateNode(gc->g, s->id, &n);
+        GraphEntity_AddProperty((GraphEntity*)&n, sensor, SI_DuplicateStringVal(sensors[i % 5]));
+        GraphEntity_AddProperty((GraphEntity*)&n, value, readings[i % 14]);
+    }
+    Graph_ReleaseLock(gc->g);
+
+    const char *attributes[2] = {"sensor", "value"};
+    for(int t = 0; t < 2; t++) {
+        GraphContext_DeleteCompositeIndex(gc, "Reading", attributes, 2);
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "Reading", attributes, 2, types[t]), INDEX_OK);
+        CompositeIndex *idx = GraphContext_GetCompositeIndex(gc, "Reading", attributes, 2);
+
+        for(int p = 0; p < 5; p++) {
+            SIValue prefix = SI_ConstStringVal((char*)sensors[p]);
+            for(int b = 0; b < 14 * 4; b++) {
+                // Every reading as a lower or upper bound, either exclusive or inclusive.
+                const SIValue *bound = readings + b / 4;
+                bool upper = b % 2;
+                int exclusive = (b / 2) % 2;
+                IndexIter *iter = CompositeIndexIter_Create(idx, &prefix, 1,
+                                                            upper ? NULL : bound, exclusive,
+                                                            upper ? bound : NULL, exclusive);
+                bool seen[NODE_COUNT + READING_COUNT] = {false};
+                _count(iter, seen);
+                IndexIter_Free(iter);
+
+                for(int i = 0; i < READING_COUNT; i++) {
+                    int c = _compareReadings(readings + i % 14, bound);
+                    bool within = upper ? (c < 0 || (c == 0 && !exclusive)) : (c > 0 || (c == 0 && !exclusive));
+                    bool match = (i % 5 == p) && within;
+                    ASSERT_EQ(seen[NODE_COUNT + i], match) << "type " << types[t] << " sensor " << p
+                                                            << " bound " << b << " reading " << i;
+                }
+            }
+
+            // Sensor names following the prefix, which none of the other names start with.
+            IndexIter *iter = CompositeIndexIter_Create(idx, NULL, 0, &prefix, 1, NULL, 0);
+            bool seen[NODE_COUNT + READING_COUNT] = {false};
+            _count(iter, seen);
+            IndexIter_Free(iter);
+            for(int i = 0; i < READING_COUNT; i++) {
+                ASSERT_EQ(seen[NODE_COUNT + i], strcmp(sensors[i % 5], sensors[p]) > 0) << p << " " << i;
+            }
+        }
+    }
+}
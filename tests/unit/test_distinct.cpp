@@ -0,0 +1,147 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_distinct.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Produces records holding two values,
+ * generated by the test's value function. */
+typedef struct {
+    OpBase op;
+    int count;                          // Number of records to produce.
+    int produced;                       // Number of records produced.
+    void (*value)(int i, SIValue *v);   // Values of the i'th record.
+} ValueStream;
+
+static Record ValueStreamConsume(OpBase *opBase) {
+    ValueStream *op = (ValueStream*)opBase;
+    if(op->produced == op->count) return NULL;
+    SIValue v[2];
+    op->value(op->produced++, v);
+    Record r = Record_New(2);
+    Record_AddScalar(r, 0, v[0]);
+    Record_AddScalar(r, 1, v[1]);
+    return r;
+}
+
+static void ValueStreamFree(OpBase *) {
+}
+
+static OpBase *NewValueStream(int count, void (*value)(int i, SIValue *v)) {
+    ValueStream *op = (ValueStream*)malloc(sizeof(ValueStream));
+    OpBase_Init(&op->op);
+    op->op.consume = ValueStreamConsume;
+    op->op.free = ValueStreamFree;
+    op->count = count;
+    op->produced = 0;
+    op->value = value;
+    return (OpBase*)op;
+}
+
+// Strings referring to external storage, similar to property values.
+static char _strings[1000][16];
+
+// Values which compare equal to 1 and differ in type, each appearing twice.
+static void _mixed_values(int i, SIValue *v) {
+    v[1] = SI_LongVal(1);
+    switch(i / 2) {
+        case 0: v[0] = SI_LongVal(1); break;
+        case 1: v[0] = SI_BoolVal(true); break;
+        case 2: v[0] = SI_DoubleVal(1.0); break;
+        case 3: v[0] = SI_ConstStringVal((char*)"1"); break;
+        default: v[0] = SI_NullVal(); break;
+    }
+}
+
+// 500 distinct numerics, appearing as integers then as integral doubles.
+static void _numeric_values(int i, SIValue *v) {
+    int j = i % 500;
+    v[0] = (i < 1000) ? SI_LongVal(j) : SI_DoubleVal(j);
+    v[1] = SI_LongVal(j);
+}
+
+// 1000 distinct string, int pairs, each appearing three times.
+static void _repeated_values(int i, SIValue *v) {
+    int j = (i * 7) % 1000;
+    v[0] = SI_ConstStringVal(_strings[j]);
+    v[1] = SI_LongVal(j);
+}
+
+class DistinctTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        for(int i = 0; i < 1000; i++) snprintf(_strings[i], sizeof(_strings[i]), "value %d", i);
+    }
+
+    static void TearDownTestCase() {
+        Distinct_SetMemoryLimit(DISTINCT_DEFAULT_MEMORY_LIMIT);
+    }
+
+    /* Passes count records through distinct,
+     * returns the number of records it produced,
+     * setting seen[j] for each record holding integer j at position 1. */
+    static int _distinct(int count, void (*value)(int, SIValue*), int *seen) {
+        OpBase *distinct = NewDistinctOp();
+        OpBase *stream = NewValueStream(count, value);
+        ExecutionPlan_AddOp(distinct, stream);
+
+        int produced = 0;
+        Record r;
+        while((r = distinct->consume(distinct))) {
+            if(seen) seen[Record_GetScalar(r, 1).longval]++;
+            produced++;
+            Record_Free(r);
+        }
+
+        OpBase_Free(stream);
+        OpBase_Free(distinct);
+        return produced;
+    }
+};
+
+TEST_F(DistinctTest, TypedEquality) {
+    // 1 and 1.0 are equal as they are when grouping, true, "1" and NULL are distinct.
+    ASSERT_EQ(_distinct(10, _mixed_values, NULL), 4);
+
+    int seen[500] = {0};
+    ASSERT_EQ(_distinct(2000, _numeric_values, seen), 500);
+    for(int i = 0; i < 500; i++) ASSERT_EQ(seen[i], 1);
+}
+
+TEST_F(DistinctTest, DropDuplicates) {
+    int seen[1000] = {0};
+    ASSERT_EQ(_distinct(3000, _repeated_values, seen), 1000);
+    for(int i = 0; i < 1000; i++) ASSERT_EQ(seen[i], 1);
+}
+
+TEST_F(DistinctTest, SpillToDisk) {
+    // Small limit spills every few records, merging runs repeatedly.
+    Distinct_SetMemoryLimit(4096);
+    int seen[1000] = {0};
+    ASSERT_EQ(_distinct(3000, _repeated_values, seen), 1000);
+    for(int i = 0; i < 1000; i++) ASSERT_EQ(seen[i], 1);
+    ASSERT_EQ(_distinct(10, _mixed_values, NULL), 4);
+    // Integral doubles are compared against spilled integers.
+    memset(seen, 0, sizeof(seen));
+    ASSERT_EQ(_distinct(2000, _numeric_values, seen), 500);
+    for(int i = 0; i < 500; i++) ASSERT_EQ(seen[i], 1);
+    Distinct_SetMemoryLimit(DISTINCT_DEFAULT_MEMORY_LIMIT);
+}
@@ -0,0 +1,181 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/index/index.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 100
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class EdgeIndexTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, NODE_COUNT);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* Account i transfers to account (i + 1) % NODE_COUNT with txid i,
+     * and follows account (i + 2) % NODE_COUNT with a FOLLOWS edge carrying the same txid. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *account = GraphContext_AddSchema(gc, "Account", SCHEMA_NODE);
+        Schema *transfer = GraphContext_AddSchema(gc, "TRANSFER", SCHEMA_EDGE);
+        Schema *follows = GraphContext_AddSchema(gc, "FOLLOWS", SCHEMA_EDGE);
+        Attribute_ID txid = GraphContext_FindOrAddAttribute(gc, "txid");
+
+        Node n;
+        Edge e;
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) Graph_CreateNode(gc->g, account->id, &n);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_ConnectNodes(gc->g, i, (i + 1) % NODE_COUNT, transfer->id, &e);
+            GraphEntity_AddProperty((GraphEntity*)&e, txid, SI_LongVal(i));
+            Graph_ConnectNodes(gc->g, i, (i + 2) % NODE_COUNT, follows->id, &e);
+            GraphEntity_AddProperty((GraphEntity*)&e, txid, SI_LongVal(i));
+        }
+        Graph_ReleaseLock(gc->g);
+
+        ASSERT_EQ(GraphContext_AddEdgeIndex(gc, "TRANSFER", "txid", IDX_SKIPLIST), INDEX_OK);
+    }
+
+    static Index *_index() {
+        return GraphContext_GetEdgeIndex(GraphContext_GetFromTLS(), "TRANSFER", "txid");
+    }
+
+    // Returns the ID of the single edge holding txid, or INVALID_ENTITY_ID.
+    static EdgeID _seek(Index *idx, int64_t txid) {
+        SIValue v = SI_LongVal(txid);
+        IndexIter *iter = IndexIter_Create(idx, T_INT64);
+        IndexIter_ApplyBound(iter, &v, EQ);
+        EdgeID *id = IndexIter_Next(iter);
+        EdgeID res = id ? *id : INVALID_ENTITY_ID;
+        if(id) {
+            EXPECT_TRUE(IndexIter_Next(iter) == NULL);
+        }
+        IndexIter_Free(iter);
+        return res;
+    }
+};
+
+TEST_F(EdgeIndexTest, Lookup) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    // Edge and node indices are keyed by different schemas.
+    ASSERT_TRUE(GraphContext_GetIndex(gc, "TRANSFER", "txid") == NULL);
+    ASSERT_TRUE(GraphContext_GetEdgeIndex(gc, "FOLLOWS", "txid") == NULL);
+    ASSERT_EQ(GraphContext_AddEdgeIndex(gc, "TRANSFER", "txid", IDX_SKIPLIST), INDEX_FAIL);
+    ASSERT_EQ(GraphContext_AddEdgeIndex(gc, "MISSING", "txid", IDX_SKIPLIST), INDEX_FAIL);
+
+    Index *idx = _index();
+    ASSERT_TRUE(idx != NULL);
+    ASSERT_TRUE(Index_IsEdgeIndex(idx));
+    // Only TRANSFER edges are indexed.
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT);
+
+    Edge e;
+    for(int i = 0; i < NODE_COUNT; i++) {
+        EdgeID id = _seek(idx, i);
+        ASSERT_NE(id, INVALID_ENTITY_ID);
+        Graph_GetEdge(gc->g, id, &e);
+        SIValue *v = GraphEntity_GetProperty((GraphEntity*)&e, GraphContext_GetAttributeID(gc, "txid"));
+        ASSERT_EQ(v->longval, i);
+    }
+    ASSERT_EQ(_seek(idx, NODE_COUNT), INVALID_ENTITY_ID);
+}
+
+TEST_F(EdgeIndexTest, Endpoints) {
+    Index *idx = _index();
+    NodeID src;
+    NodeID dest;
+    for(int i = 0; i < NODE_COUNT; i++) {
+        ASSERT_TRUE(Index_EdgeEndpoints(idx, _seek(idx, i), &src, &dest));
+        ASSERT_EQ(src, i);
+        ASSERT_EQ(dest, (i + 1) % NODE_COUNT);
+    }
+}
+
+TEST_F(EdgeIndexTest, Maintenance) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Schema *s = GraphContext_GetSchema(gc, "TRANSFER", SCHEMA_EDGE);
+    Attribute_ID txid = GraphContext_GetAttributeID(gc, "txid");
+    Index *idx = _index();
+
+    // Remove transfer 7.
+    Edge e;
+    EdgeID id = _seek(idx, 7);
+    Graph_GetEdge(gc->g, id, &e);
+    e.relationID = s->id;
+    e.srcNodeID = 7;
+    e.destNodeID = 8;
+    GraphContext_DeleteEdgeFromIndices(gc, &e);
+    ASSERT_EQ(_seek(idx, 7), INVALID_ENTITY_ID);
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT - 1);
+    NodeID src;
+    NodeID dest;
+    ASSERT_FALSE(Index_EdgeEndpoints(idx, id, &src, &dest));
+
+    // Introduce a new transfer, its endpoints are recorded.
+    Graph_AcquireWriteLock(gc->g);
+    Graph_ConnectNodes(gc->g, 3, 50, s->id, &e);
+    GraphEntity_AddProperty((GraphEntity*)&e, txid, SI_LongVal(1000));
+    Graph_ReleaseLock(gc->g);
+    GraphContext_AddEdgeToIndices(gc, s, &e);
+    ASSERT_EQ(_seek(idx, 1000), ENTITY_GET_ID(&e));
+    ASSERT_TRUE(Index_EdgeEndpoints(idx, ENTITY_GET_ID(&e), &src, &dest));
+    ASSERT_EQ(src, 3);
+    ASSERT_EQ(dest, 50);
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT);
+
+    // Dropping the index.
+    ASSERT_EQ(GraphContext_DeleteEdgeIndex(gc, "TRANSFER", "txid"), INDEX_OK);
+    ASSERT_TRUE(_index() == NULL);
+    ASSERT_EQ(GraphContext_DeleteEdgeIndex(gc, "TRANSFER", "txid"), INDEX_FAIL);
+}
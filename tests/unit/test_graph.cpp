@@ -55,6 +55,36 @@ class GraphTest : public ::testing::Test
         GrB_finalize();
     }    
 
+    // Validates each transposed relation matrix is the transpose of its relation matrix.
+    void _validate_transposed_relations(Graph *g)
+    {
+        GrB_Index nvals;
+        GrB_Index tnvals;
+        GrB_Matrix T;
+
+        for(int r = 0; r < Graph_RelationTypeCount(g); r++) {
+            GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+            GrB_Matrix TR = Graph_GetTransposedRelationMatrix(g, r);
+            GrB_Matrix_nvals(&nvals, R);
+            GrB_Matrix_nvals(&tnvals, TR);
+            ASSERT_EQ(nvals, tnvals);
+
+            GrB_Matrix_dup(&T, R);
+            GrB_transpose(T, NULL, NULL, R, NULL);
+            GrB_Index I[nvals];
+            GrB_Index J[nvals];
+            GrB_Index TI[nvals];
+            GrB_Index TJ[nvals];
+            GrB_Matrix_extractTuples_BOOL(I, J, NULL, &nvals, T);
+            GrB_Matrix_extractTuples_BOOL(TI, TJ, NULL, &tnvals, TR);
+            for(GrB_Index i = 0; i < nvals; i++) {
+                ASSERT_EQ(I[i], TI[i]);
+                ASSERT_EQ(J[i], TJ[i]);
+            }
+            GrB_Matrix_free(&T);
+        }
+    }
+
     void _test_node_creation(Graph *g, size_t node_count)
     {
         GrB_Index ncols, nrows, nvals;
@@ -395,7 +425,10 @@ TEST_F(GraphTest, RemoveNodes)
 
     // Connect 1 to 2.
     Graph_ConnectNodes(g, 1, 2, r, &edge);
-    
+
+    // Fold pending additions into graph matrices.
+    Graph_ApplyAllPending(g);
+
     // Validate graph creation.
     ASSERT_EQ(Graph_NodeCount(g), 3);
     M = Graph_GetRelationMatrix(g, r);
@@ -534,6 +567,9 @@ TEST_F(GraphTest, RemoveEdges)
     // Connect 1 to 2.
     Graph_ConnectNodes(g, 1, 2, r, &e);
 
+    // Fold pending additions into graph matrices.
+    Graph_ApplyAllPending(g);
+
     // Validate graph creation.
     ASSERT_EQ(Graph_EdgeCount(g), 3);
 
@@ -653,6 +689,86 @@ TEST_F(GraphTest, RemoveEdges)
     Graph_Free(g);
 }
 
+TEST_F(GraphTest, RemovePendingEntities)
+{
+    /* Deletions remove entries from wherever they live,
+     * pending additions remain within delta matrices. */
+    Edge e;
+    Node n;
+    GrB_Index nnz;
+    Graph *g = Graph_New(32, 32);
+    Graph_AcquireWriteLock(g);
+    int l = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+    for(int i = 0; i < 4; i++) Graph_CreateNode(g, l, &n);
+
+    // 0->1 is folded into the relation matrix.
+    Graph_ConnectNodes(g, 0, 1, r, &e);
+    Graph_ApplyAllPending(g);
+
+    // 1->2, 2->3 and 3->0 are pending.
+    Graph_ConnectNodes(g, 1, 2, r, &e);
+    Graph_ConnectNodes(g, 2, 3, r, &e);
+    Graph_ConnectNodes(g, 3, 0, r, &e);
+
+    GrB_Matrix M = Graph_GetRelationMatrix(g, r);
+    GrB_Matrix DP = Graph_GetDeltaMatrix(g, M);
+    ASSERT_TRUE(DP != NULL);
+    GrB_Matrix_nvals(&nnz, DP);
+    ASSERT_EQ(nnz, 3);
+
+    // Delete pending edge 1->2 and folded edge 0->1.
+    Edge *edges = (Edge *)array_new(Edge, 2);
+    Graph_GetEdgesConnectingNodes(g, 1, 2, r, &edges);
+    Graph_GetEdgesConnectingNodes(g, 0, 1, r, &edges);
+    ASSERT_EQ(array_len(edges), 2);
+    ASSERT_EQ(Graph_DeleteEdge(g, edges), 1);
+    ASSERT_EQ(Graph_DeleteEdge(g, edges + 1), 1);
+    ASSERT_EQ(Graph_DeleteEdge(g, edges), 0);
+
+    ASSERT_FALSE(Graph_EdgeExists(g, 1, 2, r));
+    ASSERT_FALSE(Graph_EdgeExists(g, 0, 1, r));
+    ASSERT_FALSE(Graph_EdgeExists(g, 1, 2, GRAPH_NO_RELATION));
+    ASSERT_TRUE(Graph_EdgeExists(g, 2, 3, r));
+    ASSERT_EQ(Graph_EdgeCount(g), 2);
+
+    // Remaining additions weren't folded.
+    M = Graph_GetRelationMatrix(g, r);
+    GrB_Matrix_nvals(&nnz, M);
+    ASSERT_EQ(nnz, 0);
+    DP = Graph_GetDeltaMatrix(g, M);
+    ASSERT_TRUE(DP != NULL);
+    GrB_Matrix_nvals(&nnz, DP);
+    ASSERT_EQ(nnz, 2);
+
+    // Bulk delete node 3, implicitly deleting its pending edges.
+    uint node_deleted;
+    uint edge_deleted;
+    Graph_GetNode(g, 3, &n);
+    Graph_BulkDelete(g, &n, 1, NULL, 0, &node_deleted, &edge_deleted);
+    ASSERT_EQ(node_deleted, 1);
+    ASSERT_EQ(edge_deleted, 2);
+    ASSERT_EQ(Graph_NodeCount(g), 3);
+    ASSERT_EQ(Graph_EdgeCount(g), 0);
+    ASSERT_EQ(Graph_GetNodeLabel(g, 3), GRAPH_NO_LABEL);
+
+    M = Graph_GetRelationMatrix(g, r);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, M) == NULL);
+    M = Graph_GetAdjacencyMatrix(g);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, M) == NULL);
+    M = Graph_GetLabelMatrix(g, l);
+    GrB_Matrix_nvals(&nnz, M);
+    DP = Graph_GetDeltaMatrix(g, M);
+    GrB_Index pending = 0;
+    if(DP) GrB_Matrix_nvals(&pending, DP);
+    ASSERT_EQ(nnz + pending, 3);
+
+    // Cleanup.
+    array_free(edges);
+    Graph_ReleaseLock(g);
+    Graph_Free(g);
+}
+
 TEST_F(GraphTest, GetNode)
 {
     /* Create a graph with nodeCount nodes,
@@ -791,6 +907,75 @@ TEST_F(GraphTest, GetEdge)
     Graph_Free(g);
 }
 
+TEST_F(GraphTest, GetIncomingEdges)
+{
+    /* Create a graph with multiple relation types,
+     * make sure incoming edges are retrieved via
+     * the transposed relation matrices. */
+
+    Node n;
+    Edge e;
+    size_t nodeCount = 4;
+
+    Graph *g = Graph_New(nodeCount, nodeCount);
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+    int r0 = Graph_AddRelationType(g);
+    int r1 = Graph_AddRelationType(g);
+
+    /* Connect nodes:
+     * (0)-[r0]->(3)
+     * (1)-[r0]->(3)
+     * (1)-[r1]->(3)
+     * (2)-[r1]->(3)
+     * (3)-[r0]->(0) */
+    Graph_ConnectNodes(g, 0, 3, r0, &e);
+    Graph_ConnectNodes(g, 1, 3, r0, &e);
+    Graph_ConnectNodes(g, 1, 3, r1, &e);
+    Graph_ConnectNodes(g, 2, 3, r1, &e);
+    Graph_ConnectNodes(g, 3, 0, r0, &e);
+
+    _validate_transposed_relations(g);
+
+    Edge *edges = (Edge*)array_new(Edge, 4);
+    Graph_GetNode(g, 3, &n);
+
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r0, &edges);
+    ASSERT_EQ(array_len(edges), 2);
+    for(int i = 0; i < array_len(edges); i++) {
+        ASSERT_EQ(Edge_GetDestNodeID(edges + i), 3);
+        ASSERT_EQ(Edge_GetRelationID(edges + i), r0);
+    }
+    array_clear(edges);
+
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r1, &edges);
+    ASSERT_EQ(array_len(edges), 2);
+    for(int i = 0; i < array_len(edges); i++) {
+        ASSERT_EQ(Edge_GetDestNodeID(edges + i), 3);
+        ASSERT_EQ(Edge_GetRelationID(edges + i), r1);
+    }
+    array_clear(edges);
+
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, GRAPH_NO_RELATION, &edges);
+    ASSERT_EQ(array_len(edges), 4);
+    array_clear(edges);
+
+    // Remove (1)-[r0]->(3), transposed r0 should be updated.
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r0, &edges);
+    for(int i = 0; i < array_len(edges); i++) {
+        if(Edge_GetSrcNodeID(edges + i) == 1) Graph_DeleteEdge(g, edges + i);
+    }
+    array_clear(edges);
+
+    _validate_transposed_relations(g);
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_INCOMING, r0, &edges);
+    ASSERT_EQ(array_len(edges), 1);
+    ASSERT_EQ(Edge_GetSrcNodeID(edges), 0);
+
+    array_free(edges);
+    Graph_ReleaseLock(g);
+    Graph_Free(g);
+}
 
 TEST_F(GraphTest, BulkDelete)
 {
@@ -907,6 +1092,364 @@ TEST_F(GraphTest, BulkDelete)
     ASSERT_EQ(Graph_NodeCount(g), 3);
     ASSERT_EQ(Graph_EdgeCount(g), 3);
 
+    // Transposed relation matrices should reflect deletions.
+    _validate_transposed_relations(g);
+
     // Clean up.
     Graph_Free(g);
 }
+
+TEST_F(GraphTest, DeltaMatrices)
+{
+    /* New entities are introduced to delta matrices,
+     * make sure they're visible to readers before and after folding. */
+
+    Node n;
+    Edge e;
+    GrB_Index nvals;
+    size_t nodeCount = 4;
+
+    Graph *g = Graph_New(nodeCount, nodeCount);
+    int l = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, l, &n);
+
+    /* Connect nodes:
+     * (0)-[r]->(1)
+     * (0)-[r]->(1)
+     * (1)-[r]->(2) */
+    Graph_ConnectNodes(g, 0, 1, r, &e);
+    Graph_ConnectNodes(g, 0, 1, r, &e);
+    Graph_ConnectNodes(g, 1, 2, r, &e);
+    Graph_ReleaseLock(g);
+
+    // Graph matrices are untouched, additions are pending.
+    GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+    GrB_Matrix_nvals(&nvals, R);
+    ASSERT_EQ(nvals, 0);
+
+    GrB_Matrix DP = Graph_GetDeltaMatrix(g, R);
+    ASSERT_TRUE(DP != NULL);
+    GrB_Matrix_nvals(&nvals, DP);
+    ASSERT_EQ(nvals, 2);
+
+    // Readers see pending additions.
+    ASSERT_EQ(Graph_LabeledNodeCount(g, l), nodeCount);
+    ASSERT_EQ(Graph_GetNodeLabel(g, 3), l);
+    ASSERT_TRUE(Graph_EdgeExists(g, 0, 1, r));
+    ASSERT_FALSE(Graph_EdgeExists(g, 2, 1, r));
+
+    Edge *edges = (Edge*)array_new(Edge, 4);
+    Graph_GetNode(g, 1, &n);
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_BOTH, r, &edges);
+    ASSERT_EQ(array_len(edges), 3);
+    array_clear(edges);
+
+    // Too few additions to fold.
+    Graph_FoldDeltas(g);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, R) != NULL);
+
+    // Fold additions into graph matrices.
+    Graph_AcquireWriteLock(g);
+    Graph_ApplyAllPending(g);
+    Graph_ReleaseLock(g);
+
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, R) == NULL);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, Graph_GetLabelMatrix(g, l)) == NULL);
+    GrB_Matrix_nvals(&nvals, R);
+    ASSERT_EQ(nvals, 2);
+    _validate_transposed_relations(g);
+
+    // Connecting already connected nodes updates graph matrices in place.
+    Graph_AcquireWriteLock(g);
+    Graph_ConnectNodes(g, 1, 2, r, &e);
+    Graph_ReleaseLock(g);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, R) == NULL);
+
+    Graph_GetEdgesConnectingNodes(g, 1, 2, r, &edges);
+    ASSERT_EQ(array_len(edges), 2);
+    array_clear(edges);
+
+    Graph_GetNodeEdges(g, &n, GRAPH_EDGE_DIR_BOTH, r, &edges);
+    ASSERT_EQ(array_len(edges), 4);
+
+    array_free(edges);
+    Graph_Free(g);
+}
+
+static void *_fold_deltas(void *arg) {
+    Graph *g = (Graph*)arg;
+    Graph_FoldDeltas(g);
+    return NULL;
+}
+
+TEST_F(GraphTest, FoldDeltasSnapshot)
+{
+    /* Folding publishes new matrices, readers pinned to
+     * replaced matrices keep on seeing a consistent view. */
+
+    Node n;
+    Edge e;
+    pthread_t t;
+    GrB_Index nvals;
+    size_t nodeCount = 128;
+    size_t edgeCount = GRAPH_DELTA_FOLD_THRESHOLD / 4;
+
+    Graph *g = Graph_New(nodeCount, edgeCount);
+    int r = Graph_AddRelationType(g);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+    for(int i = 0; i < edgeCount; i++) {
+        Graph_ConnectNodes(g, i / nodeCount, i % nodeCount, r, &e);
+    }
+    Graph_ReleaseLock(g);
+
+    // Reader pinned to current matrices.
+    Graph_AcquireReadLock(g);
+    GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+    GrB_Matrix DP = Graph_GetDeltaMatrix(g, R);
+    ASSERT_TRUE(DP != NULL);
+
+    // Fold from a different thread, not blocked by reader.
+    pthread_create(&t, NULL, _fold_deltas, g);
+    pthread_join(t, NULL);
+
+    // Pinned reader keeps on seeing the matrices it started with.
+    ASSERT_EQ(Graph_GetRelationMatrix(g, r), R);
+    ASSERT_EQ(Graph_GetDeltaMatrix(g, R), DP);
+    GrB_Matrix_nvals(&nvals, DP);
+    ASSERT_EQ(nvals, edgeCount);
+    ASSERT_TRUE(Graph_EdgeExists(g, 0, 1, r));
+    ASSERT_EQ(Graph_GetTransposedMatrix(g, R), Graph_GetTransposedRelationMatrix(g, r));
+    Graph_ReleaseLock(g);
+
+    // Folded matrix published to new readers.
+    Graph_AcquireReadLock(g);
+    GrB_Matrix folded = Graph_GetRelationMatrix(g, r);
+    ASSERT_NE(folded, R);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, folded) == NULL);
+    GrB_Matrix_nvals(&nvals, folded);
+    ASSERT_EQ(nvals, edgeCount);
+    ASSERT_TRUE(Graph_EdgeExists(g, 0, 1, r));
+    Graph_ReleaseLock(g);
+
+    // Once reader is gone, replaced matrices are reclaimed by the next fold.
+    ASSERT_GT(g->_retired_count[0], 0);
+    pthread_create(&t, NULL, _fold_deltas, g);
+    pthread_join(t, NULL);
+    ASSERT_EQ(g->_retired_count[0], 0);
+
+    Graph_Free(g);
+}
+
+TEST_F(GraphTest, BackgroundFold)
+{
+    /* Deltas are folded in the background once a writer leaves,
+     * writers yet to commit keep on seeing the matrices they started with. */
+
+    Node n;
+    Edge e;
+    pthread_t t;
+    GrB_Index nvals;
+    size_t nodeCount = 128;
+    size_t edgeCount = GRAPH_DELTA_FOLD_THRESHOLD / 4;
+
+    Graph *g = Graph_New(nodeCount, edgeCount);
+    int r = Graph_AddRelationType(g);
+
+    Graph_WriterEnter(g);
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+    for(int i = 0; i < 16; i++) Graph_ConnectNodes(g, 0, i, r, &e);
+    Graph_ReleaseLock(g);
+    // Too few additions, nothing is scheduled.
+    Graph_WriterLeave(g);
+    ASSERT_FALSE(g->_folding);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 16; i < 16 + edgeCount; i++) {
+        Graph_ConnectNodes(g, i / nodeCount, i % nodeCount, r, &e);
+    }
+    Graph_ReleaseLock(g);
+
+    // Writer pinned to current matrices.
+    Graph_WriterEnter(g);
+    GrB_Matrix R = Graph_GetRelationMatrix(g, r);
+
+    // Fold from a different thread, not blocked by writer.
+    pthread_create(&t, NULL, _fold_deltas, g);
+    pthread_join(t, NULL);
+    ASSERT_EQ(Graph_GetRelationMatrix(g, r), R);
+
+    // Writer commits against the current matrices.
+    Graph_AcquireWriteLock(g);
+    GrB_Matrix folded = Graph_GetRelationMatrix(g, r);
+    ASSERT_EQ(Graph_GetDeltaMatrix(g, folded), (GrB_Matrix)NULL);
+    for(int i = 16 + edgeCount; i < 16 + 2 * edgeCount; i++) {
+        Graph_ConnectNodes(g, i / nodeCount, i % nodeCount, r, &e);
+    }
+    Graph_ReleaseLock(g);
+    ASSERT_EQ(Graph_GetRelationMatrix(g, r), folded);
+
+    // Leaving writer schedules a fold.
+    Graph_WriterLeave(g);
+    Graph_WriterEnter(g);
+    Graph_AwaitFold(g);
+    ASSERT_FALSE(g->_folding);
+    Graph_WriterLeave(g);
+
+    Graph_AcquireReadLock(g);
+    GrB_Matrix M = Graph_GetRelationMatrix(g, r);
+    ASSERT_NE(M, folded);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, M) == NULL);
+    GrB_Matrix_nvals(&nvals, M);
+    ASSERT_EQ(nvals, 16 + 2 * edgeCount);
+    Graph_ReleaseLock(g);
+
+    Graph_Free(g);
+}
+
+static void *_introduce_schemas(void *arg) {
+    Graph *g = (Graph*)arg;
+    Graph_AddLabel(g);
+    Graph_AddRelationType(g);
+    return NULL;
+}
+
+TEST_F(GraphTest, PinnedVersion)
+{
+    /* Labels and relations introduced while a reader is
+     * pinned are empty as far as the reader is concerned. */
+
+    Node n;
+    Edge e;
+    pthread_t t;
+    GrB_Index nvals;
+    Graph *g = Graph_New(16, 16);
+    int l = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < 4; i++) Graph_CreateNode(g, l, &n);
+    Graph_ConnectNodes(g, 0, 1, r, &e);
+    Graph_ReleaseLock(g);
+
+    Graph_AcquireReadLock(g);
+    GrB_Matrix L = Graph_GetLabelMatrix(g, l);
+
+    // Introduced from a different thread, as if by a writer.
+    pthread_create(&t, NULL, _introduce_schemas, g);
+    pthread_join(t, NULL);
+    int new_label = l + 1;
+    int new_relation = r + 1;
+
+    // Reader's matrices are unchanged, new ones are empty.
+    ASSERT_EQ(Graph_GetLabelMatrix(g, l), L);
+    ASSERT_TRUE(Graph_EdgeExists(g, 0, 1, r));
+    GrB_Matrix_nvals(&nvals, Graph_GetLabelMatrix(g, new_label));
+    ASSERT_EQ(nvals, 0);
+    GrB_Matrix_nvals(&nvals, Graph_GetRelationMatrix(g, new_relation));
+    ASSERT_EQ(nvals, 0);
+    ASSERT_TRUE(Graph_GetDeltaMatrix(g, Graph_GetRelationMatrix(g, new_relation)) == NULL);
+    Graph_ReleaseLock(g);
+
+    // New readers see the new matrices.
+    Graph_AcquireReadLock(g);
+    ASSERT_NE(Graph_GetLabelMatrix(g, new_label), Graph_GetZeroMatrix(g));
+    ASSERT_NE(Graph_GetRelationMatrix(g, new_relation), Graph_GetZeroMatrix(g));
+    Graph_ReleaseLock(g);
+
+    Graph_Free(g);
+}
+
+TEST_F(GraphTest, GetNodeLabel)
+{
+    Node n;
+    size_t nodeCount = GRAPH_DEFAULT_NODE_CAP + 16;
+    Graph *g = Graph_New(16, 16);
+    int l0 = Graph_AddLabel(g);
+    int l1 = Graph_AddLabel(g);
+
+    // Create labeled and unlabeled nodes, exceeding initial capacity.
+    Graph_AcquireWriteLock(g);
+    Graph_AllocateNodes(g, nodeCount);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, (i % 3) - 1, &n);
+
+    size_t l0Count = 0;
+    for(int i = 0; i < nodeCount; i++) {
+        ASSERT_EQ(Graph_GetNodeLabel(g, i), (i % 3) - 1);
+        if(Graph_GetNodeLabel(g, i) == l0) l0Count++;
+    }
+
+    // Deleted node loses its label, reused ID picks up the new label.
+    Graph_GetNode(g, 1, &n);
+    ASSERT_EQ(Graph_GetNodeLabel(g, 1), l0);
+    Graph_DeleteNode(g, &n);
+    ASSERT_EQ(Graph_GetNodeLabel(g, 1), GRAPH_NO_LABEL);
+    ASSERT_EQ(Graph_LabeledNodeCount(g, l0), l0Count - 1);
+
+    Graph_CreateNode(g, l1, &n);
+    ASSERT_EQ(ENTITY_GET_ID(&n), 1);
+    ASSERT_EQ(Graph_GetNodeLabel(g, 1), l1);
+    Graph_ReleaseLock(g);
+
+    Graph_Free(g);
+}
+
+TEST_F(GraphTest, Statistics)
+{
+    Node n;
+    Edge e;
+    size_t nodeCount = 100;
+    Graph *g = Graph_New(nodeCount, nodeCount);
+    int l0 = Graph_AddLabel(g);
+    int l1 = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+
+    /* Every L0 node is connected to one of two L1 nodes:
+     * (L0)-[R]->(L1) */
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, l0, &n);
+    Graph_CreateNode(g, l1, &n);
+    Graph_CreateNode(g, l1, &n);
+    for(int i = 0; i < nodeCount; i++) {
+        Graph_ConnectNodes(g, i, nodeCount + (i % 2), r, &e);
+    }
+
+    // Statistics are updated once writer releases the graph.
+    const GraphStatistics *stats = Graph_Statistics(g);
+    ASSERT_EQ(stats->node_count, 0);
+    Graph_ReleaseLock(g);
+
+    ASSERT_EQ(stats->node_count, nodeCount + 2);
+    ASSERT_EQ(stats->label_counts[l0], nodeCount);
+    ASSERT_EQ(stats->label_counts[l1], 2);
+
+    const RelationStatistics *rstats = stats->relations + r;
+    ASSERT_EQ(rstats->edge_count, nodeCount);
+    ASSERT_EQ(rstats->src_count, nodeCount);
+    ASSERT_EQ(rstats->dest_count, 2);
+    ASSERT_EQ(rstats->max_out_degree, 1);
+    ASSERT_EQ(rstats->max_in_degree, nodeCount / 2);
+    ASSERT_EQ(RelationStatistics_AvgOutDegree(rstats), 1);
+    ASSERT_EQ(RelationStatistics_AvgInDegree(rstats), nodeCount / 2);
+    ASSERT_EQ(stats->adjacency.edge_count, nodeCount);
+
+    // Degrees are not resampled while the number of connections is about the same.
+    Graph_AcquireWriteLock(g);
+    Graph_ConnectNodes(g, 0, nodeCount + 1, r, &e);
+    Graph_ReleaseLock(g);
+    ASSERT_EQ(rstats->edge_count, nodeCount + 1);
+    ASSERT_EQ(rstats->max_out_degree, 1);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_ConnectNodes(g, nodeCount, i, r, &e);
+    Graph_ReleaseLock(g);
+    ASSERT_EQ(rstats->max_out_degree, nodeCount);
+    ASSERT_EQ(rstats->src_count, nodeCount + 1);
+
+    Graph_Free(g);
+}
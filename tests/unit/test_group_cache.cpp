@@ -0,0 +1,100 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/value.h"
+#include "../../src/grouping/group_cache.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define KEY_COUNT 2
+
+class GroupCacheTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+    }
+
+    static SIValue* _keys(SIValue a, SIValue b) {
+        SIValue *keys = (SIValue*)rm_malloc(sizeof(SIValue) * KEY_COUNT);
+        keys[0] = a;
+        keys[1] = b;
+        return keys;
+    }
+
+    static Group* _get(CacheGroup *groups, SIValue a, SIValue b) {
+        SIValue keys[KEY_COUNT] = {a, b};
+        return CacheGroupGet(groups, Group_HashKeys(keys, KEY_COUNT), keys, KEY_COUNT);
+    }
+
+    static void _add(CacheGroup *groups, SIValue a, SIValue b) {
+        SIValue *keys = _keys(a, b);
+        CacheGroupAdd(groups, Group_HashKeys(keys, KEY_COUNT), KEY_COUNT, keys, NULL, NULL);
+    }
+};
+
+TEST_F(GroupCacheTest, TypedKeys) {
+    CacheGroup *groups = CacheGroupNew();
+
+    _add(groups, SI_LongVal(1), SI_ConstStringVal((char*)"a"));
+    _add(groups, SI_DoubleVal(1.5), SI_NullVal());
+    _add(groups, SI_BoolVal(1), SI_ConstStringVal((char*)"a"));
+    _add(groups, SI_ConstStringVal((char*)"1"), SI_ConstStringVal((char*)"a"));
+
+    // Keys are compared by value and type.
+    ASSERT_TRUE(_get(groups, SI_LongVal(1), SI_ConstStringVal((char*)"a")) != NULL);
+    ASSERT_TRUE(_get(groups, SI_DoubleVal(1.5), SI_NullVal()) != NULL);
+    ASSERT_TRUE(_get(groups, SI_BoolVal(1), SI_ConstStringVal((char*)"a")) != NULL);
+    ASSERT_TRUE(_get(groups, SI_ConstStringVal((char*)"1"), SI_ConstStringVal((char*)"a")) != NULL);
+    ASSERT_TRUE(_get(groups, SI_LongVal(1), SI_ConstStringVal((char*)"b")) == NULL);
+    ASSERT_TRUE(_get(groups, SI_LongVal(1), SI_NullVal()) == NULL);
+    ASSERT_TRUE(_get(groups, SI_BoolVal(0), SI_ConstStringVal((char*)"a")) == NULL);
+
+    // Numerics of different types are equal when their values are.
+    Group *g = _get(groups, SI_DoubleVal(1.0), SI_ConstStringVal((char*)"a"));
+    ASSERT_TRUE(g != NULL);
+    ASSERT_EQ(g->keys[0].type, T_INT64);
+
+    FreeGroupCache(groups);
+}
+
+TEST_F(GroupCacheTest, ManyGroups) {
+    CacheGroup *groups = CacheGroupNew();
+    int group_count = 10000;
+
+    for(int i = 0; i < group_count; i++) _add(groups, SI_LongVal(i / 100), SI_DoubleVal(i % 100));
+
+    for(int i = 0; i < group_count; i++) {
+        Group *g = _get(groups, SI_LongVal(i / 100), SI_DoubleVal(i % 100));
+        ASSERT_TRUE(g != NULL);
+        ASSERT_EQ(g->keys[0].longval, i / 100);
+        ASSERT_EQ(g->keys[1].doubleval, i % 100);
+    }
+    ASSERT_TRUE(_get(groups, SI_LongVal(group_count), SI_DoubleVal(0)) == NULL);
+
+    // Groups are iterated by order of creation.
+    int i = 0;
+    Group *g;
+    CacheGroupIterator *iter = CacheGroupIter(groups);
+    while(CacheGroupIterNext(iter, &g)) {
+        ASSERT_EQ(g->keys[0].longval, i / 100);
+        ASSERT_EQ(g->keys[1].doubleval, i % 100);
+        i++;
+    }
+    ASSERT_EQ(i, group_count);
+    CacheGroupIterator_Free(iter);
+
+    FreeGroupCache(groups);
+}
@@ -0,0 +1,239 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/index/index.h"
+#include "../../src/index/hash_index.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 100
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class HashIndexTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* Device i has uuid "d<i>", and a group which is the integer i % 10
+     * for even devices and the double i % 10 for odd ones. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "Device", SCHEMA_NODE);
+        Attribute_ID uuid = GraphContext_FindOrAddAttribute(gc, "uuid");
+        Attribute_ID group = GraphContext_FindOrAddAttribute(gc, "group");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, s->id, &n);
+            snprintf(buf, 16, "d%d", i);
+            GraphEntity_AddProperty((GraphEntity*)&n, uuid, SI_DuplicateStringVal(buf));
+            SIValue v = (i % 2) ? SI_DoubleVal(i % 10) : SI_LongVal(i % 10);
+            GraphEntity_AddProperty((GraphEntity*)&n, group, v);
+        }
+        Graph_ReleaseLock(gc->g);
+
+        ASSERT_EQ(GraphContext_AddIndex(gc, "Device", "uuid", IDX_HASH), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddIndex(gc, "Device", "group", IDX_HASH), INDEX_OK);
+    }
+
+    // Consumes iterator, returns the number of nodes it produced.
+    static int _count(IndexIter *iter, bool *seen) {
+        int count = 0;
+        NodeID *id;
+        while((id = IndexIter_Next(iter))) {
+            if(seen) {
+                EXPECT_FALSE(seen[*id]);
+                seen[*id] = true;
+            }
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(HashIndexTest, HashTable) {
+    HashIndex *h = HashIndex_New();
+    char buf[16];
+    uint64_t count;
+
+    // Enough keys to grow the table several times.
+    for(int i = 0; i < 1000; i++) {
+        snprintf(buf, 16, "k%d", i);
+        SIValue k = SI_ConstStringVal(buf);
+        ASSERT_TRUE(HashIndex_Insert(h, &k, i));
+        ASSERT_FALSE(HashIndex_Insert(h, &k, i));
+    }
+    ASSERT_EQ(HashIndex_KeyCount(h), 1000);
+
+    // Numerics which compare equal share a key, strings never match numerics.
+    SIValue one = SI_LongVal(1);
+    SIValue one_double = SI_DoubleVal(1.0);
+    SIValue one_string = SI_ConstStringVal((char*)"1");
+    ASSERT_TRUE(HashIndex_Insert(h, &one, 7));
+    ASSERT_TRUE(HashIndex_Insert(h, &one_double, 3));
+    ASSERT_TRUE(HashIndex_Insert(h, &one, 5));
+    ASSERT_FALSE(HashIndex_Insert(h, &one_double, 5));
+    ASSERT_TRUE(HashIndex_Lookup(h, &one_string, &count) == NULL);
+    const NodeID *ids = HashIndex_Lookup(h, &one_double, &count);
+    ASSERT_EQ(count, 3);
+    // Posting lists are sorted.
+    ASSERT_EQ(ids[0], 3);
+    ASSERT_EQ(ids[1], 5);
+    ASSERT_EQ(ids[2], 7);
+
+    ASSERT_TRUE(HashIndex_Delete(h, &one, 5));
+    ASSERT_FALSE(HashIndex_Delete(h, &one, 5));
+    ASSERT_TRUE(HashIndex_Delete(h, &one_double, 3));
+    ids = HashIndex_Lookup(h, &one, &count);
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(ids[0], 7);
+    ASSERT_TRUE(HashIndex_Delete(h, &one, 7));
+    ASSERT_TRUE(HashIndex_Lookup(h, &one, &count) == NULL);
+
+    // Remove every other key, the remaining keys must stay reachable.
+    for(int i = 0; i < 1000; i += 2) {
+        snprintf(buf, 16, "k%d", i);
+        SIValue k = SI_ConstStringVal(buf);
+        ASSERT_TRUE(HashIndex_Delete(h, &k, i));
+    }
+    ASSERT_EQ(HashIndex_KeyCount(h), 500);
+    for(int i = 0; i < 1000; i++) {
+        snprintf(buf, 16, "k%d", i);
+        SIValue k = SI_ConstStringVal(buf);
+        ids = HashIndex_Lookup(h, &k, &count);
+        if(i % 2) {
+            ASSERT_EQ(count, 1);
+            ASSERT_EQ(ids[0], i);
+        } else {
+            ASSERT_TRUE(ids == NULL);
+        }
+    }
+
+    HashIndex_Free(h);
+}
+
+TEST_F(HashIndexTest, Lookup) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    // An attribute holds a single index, whichever its type.
+    ASSERT_EQ(GraphContext_AddIndex(gc, "Device", "uuid", IDX_SKIPLIST), INDEX_FAIL);
+
+    Index *idx = GraphContext_GetIndex(gc, "Device", "uuid");
+    ASSERT_TRUE(Index_IsHashIndex(idx));
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT);
+    ASSERT_EQ(Index_DistinctCount(idx), NODE_COUNT);
+
+    SIValue keys[3] = {SI_ConstStringVal((char*)"d42"), SI_ConstStringVal((char*)"missing"),
+                       SI_ConstStringVal((char*)"d7")};
+    IndexIter *iter = IndexIter_CreateLookup(idx, keys, 3);
+    bool seen[NODE_COUNT] = {false};
+    ASSERT_EQ(_count(iter, seen), 2);
+    ASSERT_TRUE(seen[42]);
+    ASSERT_TRUE(seen[7]);
+
+    // Reset restarts the lookup.
+    IndexIter_Reset(iter);
+    ASSERT_EQ(_count(iter, NULL), 2);
+    IndexIter_Free(iter);
+
+    // Integers and doubles of equal value form a single group.
+    idx = GraphContext_GetIndex(gc, "Device", "group");
+    ASSERT_EQ(Index_DistinctCount(idx), 10);
+    SIValue groups[3] = {SI_LongVal(3), SI_DoubleVal(3.0), SI_DoubleVal(4.0)};
+    iter = IndexIter_CreateLookup(idx, groups, 3);
+    memset(seen, 0, sizeof(seen));
+    // Duplicate lookup values don't produce entities twice.
+    ASSERT_EQ(_count(iter, seen), NODE_COUNT / 5);
+    for(int i = 0; i < NODE_COUNT; i++) ASSERT_EQ(seen[i], i % 10 == 3 || i % 10 == 4);
+    IndexIter_Free(iter);
+}
+
+TEST_F(HashIndexTest, Maintenance) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Index *idx = GraphContext_GetIndex(gc, "Device", "uuid");
+    Attribute_ID uuid = GraphContext_GetAttributeID(gc, "uuid");
+
+    SIValue key = SI_ConstStringVal((char*)"replaced");
+    IndexIter *iter = IndexIter_CreateLookup(idx, &key, 1);
+    ASSERT_EQ(_count(iter, NULL), 0);
+
+    // Update device 9's uuid, removing the old key and introducing the new one.
+    Node n;
+    Graph_GetNode(gc->g, 9, &n);
+    SIValue *v = GraphEntity_GetProperty((GraphEntity*)&n, uuid);
+    Index_DeleteNode(idx, 9, v);
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT - 1);
+    GraphEntity_SetProperty((GraphEntity*)&n, uuid, SI_DuplicateStringVal("replaced"));
+    Index_InsertNode(idx, 9, GraphEntity_GetProperty((GraphEntity*)&n, uuid));
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT);
+    ASSERT_EQ(Index_DistinctCount(idx), NODE_COUNT);
+
+    // Posting lists are looked up as the iterator advances.
+    IndexIter_Reset(iter);
+    bool seen[NODE_COUNT] = {false};
+    ASSERT_EQ(_count(iter, seen), 1);
+    ASSERT_TRUE(seen[9]);
+    IndexIter_Free(iter);
+
+    // Old key is gone.
+    key = SI_ConstStringVal((char*)"d9");
+    iter = IndexIter_CreateLookup(idx, &key, 1);
+    ASSERT_EQ(_count(iter, NULL), 0);
+    IndexIter_Free(iter);
+
+    // Values of unsupported types aren't indexed.
+    SIValue b = SI_BoolVal(true);
+    Index_InsertNode(idx, 11, &b);
+    ASSERT_EQ(Index_EntityCount(idx), NODE_COUNT);
+}
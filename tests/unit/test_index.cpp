@@ -90,7 +90,7 @@ class IndexTest: public ::testing::Test {
 
 TEST_F(IndexTest, StringIndex) {
   // Index the label's string property
-  Index* str_idx = Index_Create(g, label, label_id, str_key, str_key_id);
+  Index* str_idx = Index_Create(g, label, label_id, str_key, str_key_id, IDX_SKIPLIST);
   // Check the label and property tags on the index
   ASSERT_STREQ(label, str_idx->label);
   ASSERT_STREQ(str_key, str_idx->attribute);
@@ -130,7 +130,7 @@ TEST_F(IndexTest, StringIndex) {
 
 TEST_F(IndexTest, NumericIndex) {
   // Index the label's numeric property
-  Index *num_idx = Index_Create(g, label, label_id, num_key, num_key_id);
+  Index *num_idx = Index_Create(g, label, label_id, num_key, num_key_id, IDX_SKIPLIST);
   // Check the label and property tags on the index
   ASSERT_STREQ(label, num_idx->label);
   ASSERT_STREQ(num_key, num_idx->attribute);
@@ -178,7 +178,7 @@ static int count_iter_vals(IndexIter *iter) {
 /* Validate the progressive application of iterator bounds
  * on the numeric skiplist. */
 TEST_F(IndexTest, IteratorBounds) {
-  Index *num_idx = Index_Create(g, label, label_id, num_key, num_key_id);
+  Index *num_idx = Index_Create(g, label, label_id, num_key, num_key_id, IDX_SKIPLIST);
   IndexIter *iter = IndexIter_Create(num_idx, T_DOUBLE);
   // Verify total number of values in index without range
   int prev_vals = count_iter_vals(iter);
@@ -246,3 +246,46 @@ TEST_F(IndexTest, IteratorBounds) {
   IndexIter_Free(iter);
   Index_Free(num_idx);
 }
+
+/* Validate reversed iteration visits the bounded range in descending order,
+ * and index updates are reflected in the indexed entity count. */
+TEST_F(IndexTest, ReverseIterator) {
+  Index *num_idx = Index_Create(g, label, label_id, num_key, num_key_id, IDX_SKIPLIST);
+  ASSERT_EQ(Index_EntityCount(num_idx), expected_n);
+
+  SIValue lb = SI_DoubleVal(5);
+  SIValue ub = SI_DoubleVal(15);
+  IndexIter *iter = IndexIter_Create(num_idx, T_DOUBLE);
+  IndexIter_ApplyBound(iter, &lb, GE);
+  IndexIter_ApplyBound(iter, &ub, LT);
+  int expected_vals = count_iter_vals(iter);
+  ASSERT_GT(expected_vals, 0);
+
+  IndexIter_Reverse(iter);
+  NodeID *node_id;
+  Node cur;
+  SIValue last_prop = ub;
+  int num_vals = 0;
+  while ((node_id = IndexIter_Next(iter)) != NULL) {
+    Graph_GetNode(g, *node_id, &cur);
+    SIValue *cur_prop = GraphEntity_GetProperty((GraphEntity*)&cur, num_key_id);
+    // Values should be sorted in decreasing value within bounds
+    ASSERT_GE(SIValue_Compare(last_prop, *cur_prop), 0);
+    ASSERT_GE(SIValue_Compare(*cur_prop, lb), 0);
+    last_prop = *cur_prop;
+    num_vals ++;
+  }
+  ASSERT_EQ(num_vals, expected_vals);
+
+  // Remove a single indexed node
+  Graph_GetNode(g, 0, &cur);
+  SIValue *prop = GraphEntity_GetProperty((GraphEntity*)&cur, num_key_id);
+  Index_DeleteNode(num_idx, 0, prop);
+  ASSERT_EQ(Index_EntityCount(num_idx), expected_n - 1);
+  // Removing a node which isn't indexed has no effect
+  Index_DeleteNode(num_idx, 0, prop);
+  ASSERT_EQ(Index_EntityCount(num_idx), expected_n - 1);
+
+  IndexIter_Free(iter);
+  Index_Free(num_idx);
+}
@@ -0,0 +1,163 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/execution_plan/ops/op_sort.h"
+#include "../../src/execution_plan/ops/op_ordered_index_scan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 100
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class OrderedIndexScanTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* Every person has a numeric score, while age is either
+     * missing, a string, a boolean, an integer or a double. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "person", SCHEMA_NODE);
+        Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+        Attribute_ID score = GraphContext_FindOrAddAttribute(gc, "score");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, s->id, &n);
+            GraphEntity_AddProperty((GraphEntity*)&n, score, SI_LongVal((i * 37) % NODE_COUNT));
+            switch(i % 7) {
+                case 0:
+                    break;
+                case 1:
+                    snprintf(buf, 16, "a%d", i % 13);
+                    GraphEntity_AddProperty((GraphEntity*)&n, age, SI_DuplicateStringVal(buf));
+                    break;
+                case 2:
+                    GraphEntity_AddProperty((GraphEntity*)&n, age, SI_BoolVal(i % 2));
+                    break;
+                case 3:
+                    GraphEntity_AddProperty((GraphEntity*)&n, age, SI_DoubleVal(i / 3.0));
+                    break;
+                default:
+                    GraphEntity_AddProperty((GraphEntity*)&n, age, SI_LongVal(i % 11));
+                    break;
+            }
+        }
+        Graph_ReleaseLock(gc->g);
+
+        ASSERT_EQ(GraphContext_AddIndex(gc, "person", "age", IDX_SKIPLIST), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddIndex(gc, "person", "score", IDX_SKIPLIST), INDEX_OK);
+    }
+
+    /* Scans all persons ordered by attribute,
+     * validates every person is produced in order. */
+    static void _scan(const char *attribute, int direction) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
+        Index *idx = GraphContext_GetIndex(gc, "person", attribute);
+        ASSERT_TRUE(idx != NULL);
+
+        const char *query = "MATCH (p:person) RETURN p";
+        char *errMsg = NULL;
+        AST **asts = ParseQuery(query, strlen(query), &errMsg);
+        ASSERT_TRUE(asts != NULL);
+        AST *ast = asts[0];
+
+        Node *n = Node_New("person", "p");
+        OpBase *scan = NewOrderedIndexScanOp(gc->g, n, idx, direction, ast);
+
+        // Scan twice, validating reset.
+        for(int pass = 0; pass < 2; pass++) {
+            int count = 0;
+            bool seen[NODE_COUNT] = {false};
+            SIValue prev = SI_NullVal();
+            Record r;
+            while((r = scan->consume(scan))) {
+                Node *node = Record_GetNode(r, 0);
+                NodeID id = ENTITY_GET_ID(node);
+                ASSERT_FALSE(seen[id]);
+                seen[id] = true;
+
+                SIValue *v = GraphEntity_GetProperty((GraphEntity*)node, attr_id);
+                SIValue curr = (v == PROPERTY_NOTFOUND) ? SI_NullVal() : *v;
+                if(count > 0) {
+                    ASSERT_LE(SIValue_Order(prev, curr) * direction, 0) << attribute;
+                }
+                prev = curr;
+                count++;
+                Record_Free(r);
+            }
+            ASSERT_EQ(count, NODE_COUNT) << attribute;
+            scan->reset(scan);
+        }
+
+        OpBase_Free(scan);
+        Node_Free(n);
+        AST_Free(asts);
+    }
+};
+
+TEST_F(OrderedIndexScanTest, PartiallyIndexed) {
+    _scan("age", DIR_ASC);
+    _scan("age", DIR_DESC);
+}
+
+TEST_F(OrderedIndexScanTest, FullyIndexed) {
+    _scan("score", DIR_ASC);
+    _scan("score", DIR_DESC);
+}
@@ -0,0 +1,208 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+#include <vector>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_filter.h"
+#include "../../src/execution_plan/ops/op_aggregate.h"
+#include "../../src/execution_plan/ops/op_all_node_scan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 1000
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class ParallelAggregateTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = NULL;
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    // Node i has age i % 100, score i / 10 and name 'n<i % 7>'.
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+        Attribute_ID score = GraphContext_FindOrAddAttribute(gc, "score");
+        Attribute_ID name = GraphContext_FindOrAddAttribute(gc, "name");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, GRAPH_NO_LABEL, &n);
+            snprintf(buf, 16, "n%d", i % 7);
+            GraphEntity_AddProperty((GraphEntity*)&n, age, SI_LongVal(i % 100));
+            GraphEntity_AddProperty((GraphEntity*)&n, score, SI_DoubleVal(i / 10.0));
+            GraphEntity_AddProperty((GraphEntity*)&n, name, SI_ConstStringVal(buf));
+        }
+        Graph_ReleaseLock(gc->g);
+    }
+
+    /* Runs query's aggregation over a filtered scan of all nodes,
+     * records reference the aggregate operation, which is returned. */
+    static OpBase* _aggregate(AST *ast, std::vector<Record> &records) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Node *n = Node_New(NULL, "n");
+        OpBase *scan = NewAllNodeScanOp(gc->g, n, ast);
+        OpBase *filter = NewFilterOp(BuildFiltersTree(ast, ast->whereNode->filters));
+
+        uint exp_count = array_len(ast->returnNode->returnElements);
+        AR_ExpNode **exps = (AR_ExpNode**)array_newlen(AR_ExpNode*, exp_count);
+        char **aliases = (char**)array_newlen(char*, exp_count);
+        for(uint i = 0; i < exp_count; i++) {
+            exps[i] = AR_EXP_BuildFromAST(ast, ast->returnNode->returnElements[i]->exp);
+            aliases[i] = NULL;
+        }
+        OpBase *aggregate = NewAggregateOp(ast, exps, aliases);
+
+        ExecutionPlan_AddOp(filter, scan);
+        ExecutionPlan_AddOp(aggregate, filter);
+        filter->init(filter);
+        aggregate->init(aggregate);
+
+        Record r;
+        while((r = aggregate->consume(aggregate))) records.push_back(r);
+        return aggregate;
+    }
+
+    // Groups are produced in the same order.
+    static void _assert_same(std::vector<Record> &expected, std::vector<Record> &actual,
+                             int column_count, const char *query) {
+        ASSERT_EQ(actual.size(), expected.size()) << query;
+        for(size_t i = 0; i < expected.size(); i++) {
+            for(int j = 0; j < column_count; j++) {
+                SIValue e = Record_Get(expected[i], j);
+                SIValue a = Record_Get(actual[i], j);
+                if(SI_TYPE(e) & SI_NUMERIC) {
+                    ASSERT_DOUBLE_EQ(SI_GET_NUMERIC(a), SI_GET_NUMERIC(e)) << query;
+                } else {
+                    ASSERT_EQ(SIValue_Compare(a, e), 0) << query;
+                }
+            }
+        }
+    }
+
+    static void _free_plan(OpBase *aggregate, std::vector<Record> &records) {
+        for(size_t i = 0; i < records.size(); i++) Record_Free(records[i]);
+
+        OpBase *filter = aggregate->children[0];
+        OpBase *scan = filter->children[0];
+        Node *n = ((AllNodeScan*)scan)->n;
+        OpBase_Free(aggregate);
+        OpBase_Free(filter);
+        OpBase_Free(scan);
+        Node_Free(n);
+    }
+};
+
+TEST_F(ParallelAggregateTest, MatchesSequential) {
+    const char *queries[] = {
+        "MATCH (n) WHERE n.age > 10 RETURN n.name, count(n), sum(n.age), min(n.score), max(n.age)",
+        "MATCH (n) WHERE n.score < 50 RETURN n.age / 10, avg(n.score), percentileDisc(n.age, 0.5), stDev(n.score)",
+        "MATCH (n) WHERE n.age = 5 RETURN count(n), sum(n.score)",
+        "MATCH (n) WHERE n.age > 100 RETURN n.name, count(n)",
+    };
+
+    for(int q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+        const char *query = queries[q];
+        char *errMsg = NULL;
+        AST **asts = ParseQuery(query, strlen(query), &errMsg);
+        ASSERT_TRUE(asts != NULL) << query;
+        AST *ast = asts[0];
+        AST_NameAnonymousNodes(ast);
+        int column_count = array_len(ast->returnNode->returnElements);
+
+        std::vector<Record> sequential;
+        std::vector<Record> parallel;
+        Aggregate_SetParallelism(1, 0);
+        OpBase *sequential_plan = _aggregate(ast, sequential);
+        Aggregate_SetParallelism(4, 0);
+        OpBase *parallel_plan = _aggregate(ast, parallel);
+
+        _assert_same(sequential, parallel, column_count, query);
+
+        _free_plan(sequential_plan, sequential);
+        _free_plan(parallel_plan, parallel);
+        AST_Free(asts);
+    }
+
+    Aggregate_SetParallelism(AGGREGATE_DEFAULT_THREAD_COUNT, AGGREGATE_DEFAULT_PARALLEL_THRESHOLD);
+}
+
+TEST_F(ParallelAggregateTest, QueryThreadCount) {
+    /* Query's thread count overrides the module setting,
+     * workers read the graph as pinned by the query's reader. */
+    GraphContext *gc = GraphContext_GetFromTLS();
+    const char *query = "MATCH (n) WHERE n.age < 50 RETURN n.name, count(n), sum(n.score)";
+    char *errMsg = NULL;
+    AST **asts = ParseQuery(query, strlen(query), &errMsg);
+    ASSERT_TRUE(asts != NULL);
+    AST *ast = asts[0];
+    AST_NameAnonymousNodes(ast);
+    int column_count = array_len(ast->returnNode->returnElements);
+
+    std::vector<Record> sequential;
+    std::vector<Record> parallel;
+    Aggregate_SetParallelism(1, 0);
+    Graph_AcquireReadLock(gc->g);
+    OpBase *sequential_plan = _aggregate(ast, sequential);
+    Aggregate_BindThreadCount(AGGREGATE_MAX_THREAD_COUNT * 2);
+    OpBase *parallel_plan = _aggregate(ast, parallel);
+    Aggregate_BindThreadCount(0);
+    Graph_ReleaseLock(gc->g);
+
+    _assert_same(sequential, parallel, column_count, query);
+
+    _free_plan(sequential_plan, sequential);
+    _free_plan(parallel_plan, parallel);
+    AST_Free(asts);
+    Aggregate_SetParallelism(AGGREGATE_DEFAULT_THREAD_COUNT, AGGREGATE_DEFAULT_PARALLEL_THRESHOLD);
+}
@@ -0,0 +1,366 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_params.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_index_scan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+void ExecutionPlanInit(ExecutionPlan *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 10
+#define USER_COUNT 6
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+/* Plans built against one set of query parameters
+ * are executed again with other parameters bound. */
+class ParamPlansTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* Person i is named 'n<i>' and aged i, except for person 8 aged true
+     * and person 9 aged false and named true, booleans aren't indexed.
+     * User i follows the persons, its email is 'u<i>', age is i and tenant is 't<i % 2>'
+     * except for the last user's tenant, true.
+     * Person i transfers to person i + 1 by transaction i, referenced 'r<i>',
+     * the last transfer closes the cycle by transaction true, referenced true. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "person", SCHEMA_NODE);
+        Schema *u = GraphContext_AddSchema(gc, "User", SCHEMA_NODE);
+        Schema *t = GraphContext_AddSchema(gc, "transfer", SCHEMA_EDGE);
+        Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+        Attribute_ID name = GraphContext_FindOrAddAttribute(gc, "name");
+        Attribute_ID tenant = GraphContext_FindOrAddAttribute(gc, "tenant");
+        Attribute_ID email = GraphContext_FindOrAddAttribute(gc, "email");
+        Attribute_ID txid = GraphContext_FindOrAddAttribute(gc, "txid");
+        Attribute_ID ref = GraphContext_FindOrAddAttribute(gc, "ref");
+
+        Node n;
+        Edge e;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, s->id, &n);
+            SIValue v = (i < 8) ? SI_LongVal(i) : SI_BoolVal(i == 8);
+            GraphEntity_AddProperty((GraphEntity*)&n, age, v);
+            snprintf(buf, 16, "n%d", i);
+            v = (i < 9) ? SI_DuplicateStringVal(buf) : SI_BoolVal(true);
+            GraphEntity_AddProperty((GraphEntity*)&n, name, v);
+        }
+        for(int i = 0; i < USER_COUNT; i++) {
+            Graph_CreateNode(gc->g, u->id, &n);
+            snprintf(buf, 16, "t%d", i % 2);
+            SIValue v = (i < USER_COUNT - 1) ? SI_DuplicateStringVal(buf) : SI_BoolVal(true);
+            GraphEntity_AddProperty((GraphEntity*)&n, tenant, v);
+            snprintf(buf, 16, "u%d", i);
+            GraphEntity_AddProperty((GraphEntity*)&n, email, SI_DuplicateStringVal(buf));
+            GraphEntity_AddProperty((GraphEntity*)&n, age, SI_LongVal(i));
+        }
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_ConnectNodes(gc->g, i, (i + 1) % NODE_COUNT, t->id, &e);
+            SIValue v = (i < NODE_COUNT - 1) ? SI_LongVal(i) : SI_BoolVal(true);
+            GraphEntity_AddProperty((GraphEntity*)&e, txid, v);
+            snprintf(buf, 16, "r%d", i);
+            v = (i < NODE_COUNT - 1) ? SI_DuplicateStringVal(buf) : SI_BoolVal(true);
+            GraphEntity_AddProperty((GraphEntity*)&e, ref, v);
+        }
+        Graph_ReleaseLock(gc->g);
+
+        ASSERT_EQ(GraphContext_AddIndex(gc, "person", "age", IDX_SKIPLIST), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddIndex(gc, "person", "name", IDX_HASH), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddIndex(gc, "User", "email", IDX_SKIPLIST), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddEdgeIndex(gc, "transfer", "txid", IDX_SKIPLIST), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddEdgeIndex(gc, "transfer", "ref", IDX_HASH), INDEX_OK);
+
+        const char *tenant_email[2] = {"tenant", "email"};
+        const char *tenant_age[2] = {"tenant", "age"};
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", tenant_email, 2, IDX_BTREE), INDEX_OK);
+        ASSERT_EQ(GraphContext_AddCompositeIndex(gc, "User", tenant_age, 2, IDX_BTREE), INDEX_OK);
+    }
+
+    static QueryParams* _bind(const char *prefix) {
+        char *err = NULL;
+        QueryParams *params = NULL;
+        EXPECT_TRUE(QueryParams_Parse(prefix, &params, &err) != NULL) << prefix;
+        QueryParams_Bind(params);
+        return params;
+    }
+
+    static ExecutionPlan* _plan(const char *query, AST ***ast) {
+        char *errMsg = NULL;
+        *ast = ParseQuery(query, strlen(query), &errMsg);
+        EXPECT_TRUE(*ast != NULL) << query;
+        ModifyAST(*ast);
+        ExecutionPlan *plan = NewExecutionPlan(NULL, *ast, NULL, false);
+        ExecutionPlanInit(plan);
+        return plan;
+    }
+
+    static bool _uses(ExecutionPlan *plan, OPType type) {
+        return ExecutionPlan_LocateOp(plan->root, type) != NULL;
+    }
+
+    /* Binds params, resets plan and counts the records it produces,
+     * results are consumed beneath the Results operation. */
+    static int _count(ExecutionPlan *plan, const char *params) {
+        QueryParams *p = _bind(params);
+        OpBase *root = plan->root;
+        if(root->type == OPType_RESULTS) root = root->children[0];
+        OpBase_Reset(root);
+
+        int count = 0;
+        Record r;
+        while((r = OpBase_Consume(root))) {
+            count++;
+            Record_Free(r);
+        }
+
+        QueryParams_Bind(NULL);
+        QueryParams_Free(p);
+        return count;
+    }
+
+    // Returns true if plan scans a composite index.
+    static bool _usesComposite(ExecutionPlan *plan) {
+        IndexScan *scan = (IndexScan*)ExecutionPlan_LocateOp(plan->root, OPType_INDEX_SCAN);
+        return scan && scan->composite;
+    }
+
+    static void _free(ExecutionPlan *plan, AST **ast) {
+        ExecutionPlanFree(plan);
+        AST_Free(ast);
+    }
+};
+
+TEST_F(ParamPlansTest, IndexScanRange) {
+    AST **ast;
+    QueryParams *p = _bind("CYPHER min=5 RETURN 1");
+    ExecutionPlan *plan = _plan("MATCH (p:person) WHERE p.age > $min RETURN p", &ast);
+    QueryParams_Bind(NULL);
+    QueryParams_Free(p);
+    ASSERT_TRUE(_uses(plan, OPType_INDEX_SCAN));
+
+    ASSERT_EQ(_count(plan, "CYPHER min=5 RETURN 1"), 2);
+    ASSERT_EQ(_count(plan, "CYPHER min=1 RETURN 1"), 6);
+    ASSERT_EQ(_count(plan, "CYPHER min=2.5 RETURN 1"), 5);
+    ASSERT_EQ(_count(plan, "CYPHER min='a' RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER min=null RETURN 1"), 0);
+    // Unindexed values are served by the replaced label scan.
+    ASSERT_EQ(_count(plan, "CYPHER min=false RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER min=6 RETURN 1"), 1);
+    _free(plan, ast);
+
+    // Parameters on either side of the comparison.
+    plan = _plan("MATCH (p:person) WHERE $max >= p.age AND p.age >= $min RETURN p", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_INDEX_SCAN));
+    ASSERT_EQ(_count(plan, "CYPHER min=2 max=4 RETURN 1"), 3);
+    ASSERT_EQ(_count(plan, "CYPHER min=0 max=7 RETURN 1"), 8);
+    ASSERT_EQ(_count(plan, "CYPHER min='a' max=4 RETURN 1"), 0);
+    _free(plan, ast);
+}
+
+TEST_F(ParamPlansTest, InlineParams) {
+    AST **ast;
+    ExecutionPlan *plan = _plan("MATCH (p:person {name:$name}) RETURN p", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_INDEX_SCAN));
+    ASSERT_EQ(_count(plan, "CYPHER name='n3' RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER name='zz' RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER name=true RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER name='n0' RETURN 1"), 1);
+    _free(plan, ast);
+
+    plan = _plan("MATCH (p:person {name:$name, age:$age}) RETURN p", &ast);
+    ASSERT_EQ(_count(plan, "CYPHER name='n3' age=3 RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER name='n3' age=4 RETURN 1"), 0);
+    _free(plan, ast);
+}
+
+TEST_F(ParamPlansTest, SkipLimit) {
+    AST **ast;
+    ExecutionPlan *plan = _plan("MATCH (p:person) RETURN p SKIP $s LIMIT $l", &ast);
+    ASSERT_EQ(_count(plan, "CYPHER s=2 l=3 RETURN 1"), 3);
+    ASSERT_EQ(_count(plan, "CYPHER s=8 l=5 RETURN 1"), 2);
+    ASSERT_EQ(_count(plan, "CYPHER s=0 l=0 RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER s=0 l=20 RETURN 1"), NODE_COUNT);
+    _free(plan, ast);
+
+    // Sort keeps as many records as skipped and limited.
+    plan = _plan("MATCH (p:person) RETURN p.age ORDER BY p.age SKIP $s LIMIT $l", &ast);
+    ASSERT_EQ(_count(plan, "CYPHER s=1 l=2 RETURN 1"), 2);
+    ASSERT_EQ(_count(plan, "CYPHER s=9 l=5 RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER s=0 l=0 RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER s=3 l=4 RETURN 1"), 4);
+    _free(plan, ast);
+}
+
+TEST_F(ParamPlansTest, IdSeek) {
+    AST **ast;
+    ExecutionPlan *plan = _plan("MATCH (p:person) WHERE id(p) = $id RETURN p", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_NODE_BY_ID_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER id=3 RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER id=3.0 RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER id=2.5 RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER id=-1 RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER id='a' RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), 1);
+    _free(plan, ast);
+
+    plan = _plan("MATCH (p:person) WHERE id(p) < $id RETURN p", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_NODE_BY_ID_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER id=3 RETURN 1"), 3);
+    ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER id=100 RETURN 1"), NODE_COUNT);
+    _free(plan, ast);
+
+    plan = _plan("MATCH (p:person) WHERE $id < id(p) RETURN p", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_NODE_BY_ID_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER id=7 RETURN 1"), 2);
+    ASSERT_EQ(_count(plan, "CYPHER id=-2 RETURN 1"), NODE_COUNT);
+    ASSERT_EQ(_count(plan, "CYPHER id=7.5 RETURN 1"), 2);
+    _free(plan, ast);
+
+    // Seeks replacing label scans only produce nodes of the label.
+    plan = _plan("MATCH (u:User) WHERE id(u) >= $id RETURN u", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_NODE_BY_ID_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), USER_COUNT);
+    ASSERT_EQ(_count(plan, "CYPHER id=12 RETURN 1"), USER_COUNT - 2);
+    _free(plan, ast);
+    plan = _plan("MATCH (u:User) WHERE id(u) = 3 RETURN u", &ast);
+    ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), 0);
+    _free(plan, ast);
+    plan = _plan("MATCH (u) WHERE id(u) > 8 RETURN u", &ast);
+    ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), 1 + USER_COUNT);
+    _free(plan, ast);
+}
+
+TEST_F(ParamPlansTest, CompositeIndexScan) {
+    AST **ast;
+    const char *queries[3] = {
+        "MATCH (u:User {tenant:$t, email:$e}) RETURN u",
+        "MATCH (u:User) WHERE u.tenant = $t AND u.email = $e RETURN u",
+        "MATCH (u:User) WHERE $e = u.email AND $t = u.tenant RETURN u"
+    };
+    for(int i = 0; i < 3; i++) {
+        ExecutionPlan *plan = _plan(queries[i], &ast);
+        ASSERT_TRUE(_usesComposite(plan)) << queries[i];
+        ASSERT_EQ(_count(plan, "CYPHER t='t0' e='u2' RETURN 1"), 1);
+        ASSERT_EQ(_count(plan, "CYPHER t='t1' e='u2' RETURN 1"), 0);
+        ASSERT_EQ(_count(plan, "CYPHER t='t1' e='u3' RETURN 1"), 1);
+        ASSERT_EQ(_count(plan, "CYPHER t='t0' e=null RETURN 1"), 0);
+        // Unindexed values are served by the replaced label scan.
+        ASSERT_EQ(_count(plan, "CYPHER t=true e='u5' RETURN 1"), 1);
+        _free(plan, ast);
+    }
+
+    // Constant prefix followed by a parameterised range.
+    ExecutionPlan *plan = _plan("MATCH (u:User) WHERE u.tenant = 't1' AND u.age > $a RETURN u", &ast);
+    ASSERT_TRUE(_usesComposite(plan));
+    ASSERT_EQ(_count(plan, "CYPHER a=0 RETURN 1"), 2);
+    ASSERT_EQ(_count(plan, "CYPHER a=1 RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER a=5 RETURN 1"), 0);
+    _free(plan, ast);
+
+    // A single parameterised attribute, no other index applies.
+    plan = _plan("MATCH (u:User) WHERE u.tenant = $t RETURN u", &ast);
+    ASSERT_TRUE(_usesComposite(plan));
+    ASSERT_EQ(_count(plan, "CYPHER t='t0' RETURN 1"), 3);
+    ASSERT_EQ(_count(plan, "CYPHER t='t1' RETURN 1"), 2);
+    _free(plan, ast);
+}
+
+TEST_F(ParamPlansTest, EdgeIndexSeek) {
+    AST **ast;
+    const char *queries[3] = {
+        "MATCH (a)-[t:transfer {txid:$id}]->(b) RETURN a, b",
+        "MATCH (a)-[t:transfer]->(b) WHERE t.txid = $id RETURN a, b",
+        "MATCH (a:person)-[t:transfer]->(b:person) WHERE $id = t.txid RETURN a, b"
+    };
+    for(int i = 0; i < 3; i++) {
+        ExecutionPlan *plan = _plan(queries[i], &ast);
+        ASSERT_TRUE(_uses(plan, OPType_EDGE_INDEX_SEEK)) << queries[i];
+        ASSERT_FALSE(_uses(plan, OPType_CONDITIONAL_TRAVERSE)) << queries[i];
+        ASSERT_EQ(_count(plan, "CYPHER id=3 RETURN 1"), 1);
+        ASSERT_EQ(_count(plan, "CYPHER id=42 RETURN 1"), 0);
+        ASSERT_EQ(_count(plan, "CYPHER id=null RETURN 1"), 0);
+        // Unindexed values are served by scanning the relation.
+        ASSERT_EQ(_count(plan, "CYPHER id=true RETURN 1"), 1);
+        ASSERT_EQ(_count(plan, "CYPHER id=0 RETURN 1"), 1);
+        _free(plan, ast);
+    }
+
+    // Ordered indices are bounded by every parameter filter on the property.
+    ExecutionPlan *plan = _plan("MATCH (a)-[t:transfer]->(b) WHERE t.txid >= $min AND t.txid < $max RETURN a", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_EDGE_INDEX_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER min=2 max=5 RETURN 1"), 3);
+    ASSERT_EQ(_count(plan, "CYPHER min=0 max=100 RETURN 1"), NODE_COUNT - 1);
+    ASSERT_EQ(_count(plan, "CYPHER min='a' max=5 RETURN 1"), 0);
+    _free(plan, ast);
+
+    // Hash indices serve equalities.
+    plan = _plan("MATCH (a)-[t:transfer {ref:$r}]->(b) RETURN a", &ast);
+    ASSERT_TRUE(_uses(plan, OPType_EDGE_INDEX_SEEK));
+    ASSERT_EQ(_count(plan, "CYPHER r='r4' RETURN 1"), 1);
+    ASSERT_EQ(_count(plan, "CYPHER r='r' RETURN 1"), 0);
+    ASSERT_EQ(_count(plan, "CYPHER r=true RETURN 1"), 1);
+    _free(plan, ast);
+    plan = _plan("MATCH (a)-[t:transfer]->(b) WHERE t.ref > $r RETURN a", &ast);
+    ASSERT_FALSE(_uses(plan, OPType_EDGE_INDEX_SEEK));
+    _free(plan, ast);
+}
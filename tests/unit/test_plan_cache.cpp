@@ -0,0 +1,93 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/query_executor.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class PlanCacheTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+    }
+
+    static void TearDownTestCase() {
+        PlanCache_SetCapacity(PLAN_CACHE_DEFAULT_CAP);
+    }
+
+    // Checks out query's entry and returns it to cache with a parsed AST.
+    static void _cache_query(PlanCache *cache, const char *query) {
+        char *errMsg;
+        PlanCacheEntry *entry = PlanCache_Acquire(cache, query);
+        if(!entry->ast) entry->ast = ParseQuery(query, strlen(query), &errMsg);
+        PlanCache_Release(cache, entry);
+    }
+};
+
+TEST_F(PlanCacheTest, CheckoutAndRelease) {
+    PlanCache *cache = PlanCache_New();
+    const char *query = "MATCH (n) RETURN n";
+
+    // New entries are empty.
+    PlanCacheEntry *entry = PlanCache_Acquire(cache, query);
+    ASSERT_TRUE(entry->ast == NULL);
+    ASSERT_TRUE(entry->plan == NULL);
+
+    // Entries without an AST are not cached.
+    PlanCache_Release(cache, entry);
+    ASSERT_FALSE(PlanCache_Contains(cache, query));
+
+    _cache_query(cache, query);
+    ASSERT_TRUE(PlanCache_Contains(cache, query));
+
+    // Checked out entries are removed from cache.
+    entry = PlanCache_Acquire(cache, query);
+    ASSERT_TRUE(entry->ast != NULL);
+    ASSERT_FALSE(PlanCache_Contains(cache, query));
+    PlanCache_Release(cache, entry);
+    ASSERT_EQ(PlanCache_Size(cache), 1);
+
+    // Entries checked out before cache was cleared are discarded.
+    entry = PlanCache_Acquire(cache, query);
+    PlanCache_Clear(cache);
+    PlanCache_Release(cache, entry);
+    ASSERT_EQ(PlanCache_Size(cache), 0);
+
+    PlanCache_Free(cache);
+}
+
+TEST_F(PlanCacheTest, EvictLeastRecentlyUsed) {
+    PlanCache_SetCapacity(2);
+    PlanCache *cache = PlanCache_New();
+    const char *a = "MATCH (a) RETURN a";
+    const char *b = "MATCH (b) RETURN b";
+    const char *c = "MATCH (c) RETURN c";
+
+    _cache_query(cache, a);
+    _cache_query(cache, b);
+    // Access a, making b the least recently used query.
+    _cache_query(cache, a);
+    _cache_query(cache, c);
+
+    ASSERT_EQ(PlanCache_Size(cache), 2);
+    ASSERT_TRUE(PlanCache_Contains(cache, a));
+    ASSERT_FALSE(PlanCache_Contains(cache, b));
+    ASSERT_TRUE(PlanCache_Contains(cache, c));
+
+    PlanCache_Free(cache);
+}
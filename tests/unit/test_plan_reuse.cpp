@@ -0,0 +1,227 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+void ExecutionPlanInit(ExecutionPlan *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 4
+#define QUERY_COUNT 7
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+/* Plans are executed again once the graph they were built against
+ * was modified, results must match those of a newly built plan. */
+class PlanReuseTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->schema_version = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* Adds count N nodes, node i is connected to node i + 1 by R
+     * and to node i + 2 by S, new nodes are connected to existing ones. */
+    static void _add_nodes(int count) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Graph *g = gc->g;
+        int n_id = GraphContext_GetSchema(gc, "N", SCHEMA_NODE)->id;
+        int r_id = GraphContext_GetSchema(gc, "R", SCHEMA_EDGE)->id;
+        int s_id = GraphContext_GetSchema(gc, "S", SCHEMA_EDGE)->id;
+
+        Node n;
+        Edge e;
+        Graph_AcquireWriteLock(g);
+        NodeID first = Graph_NodeCount(g);
+        for(int i = 0; i < count; i++) Graph_CreateNode(g, n_id, &n);
+        NodeID last = first + count;
+        for(NodeID i = 0; i < last; i++) {
+            // Connect to new nodes only.
+            if(i + 1 >= first && i + 1 < last) Graph_ConnectNodes(g, i, i + 1, r_id, &e);
+            if(i + 2 >= first && i + 2 < last) Graph_ConnectNodes(g, i, i + 2, s_id, &e);
+        }
+        Graph_ReleaseLock(g);
+    }
+
+    // Connects every pair of nodes by S, such that folding is due.
+    static void _connect_all() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Graph *g = gc->g;
+        int s_id = GraphContext_GetSchema(gc, "S", SCHEMA_EDGE)->id;
+
+        Edge e;
+        Graph_AcquireWriteLock(g);
+        NodeID node_count = Graph_NodeCount(g);
+        for(NodeID i = 0; i < node_count; i++) {
+            for(NodeID j = 0; j < node_count; j++) Graph_ConnectNodes(g, i, j, s_id, &e);
+        }
+        Graph_ReleaseLock(g);
+    }
+
+    static ExecutionPlan* _plan(const char *query, AST ***ast) {
+        char *errMsg = NULL;
+        *ast = ParseQuery(query, strlen(query), &errMsg);
+        EXPECT_TRUE(*ast != NULL) << query;
+        ModifyAST(*ast);
+        ExecutionPlan *plan = NewExecutionPlan(NULL, *ast, NULL, false);
+        ExecutionPlanInit(plan);
+        return plan;
+    }
+
+    // Counts the records plan produces, consumed beneath the Results operation.
+    static int _count(ExecutionPlan *plan) {
+        OpBase *root = plan->root;
+        if(root->type == OPType_RESULTS) root = root->children[0];
+
+        int count = 0;
+        Record r;
+        while((r = OpBase_Consume(root))) {
+            count++;
+            Record_Free(r);
+        }
+        return count;
+    }
+
+    // Counts the records produced by a newly built plan for query.
+    static int _expected(const char *query) {
+        AST **ast;
+        ExecutionPlan *plan = _plan(query, &ast);
+        int count = _count(plan);
+        ExecutionPlanFree(plan);
+        AST_Free(ast);
+        return count;
+    }
+};
+
+TEST_F(PlanReuseTest, RebindAfterWrites) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Graph *g = gc->g;
+    uint64_t version = gc->schema_version;
+    GraphContext_AddSchema(gc, "N", SCHEMA_NODE);
+    GraphContext_AddSchema(gc, "R", SCHEMA_EDGE);
+    GraphContext_AddSchema(gc, "S", SCHEMA_EDGE);
+    ASSERT_EQ(gc->schema_version, version + 3);
+    _add_nodes(NODE_COUNT);
+
+    const char *queries[QUERY_COUNT] = {
+        "MATCH (a:N) RETURN a",
+        "MATCH (a) RETURN a",
+        "MATCH (a:N)-[:R]->(b:N) RETURN a, b",
+        "MATCH (a:N)-[:R|:S]->(b)<-[:R]-(c) RETURN a, c",
+        "MATCH (a:N)-[:R]->(b:N), (a)-[:S]->(c:N), (b)-[:R]->(c) RETURN a",
+        "MATCH (a:N)-[:R*1..3]->(b:N) RETURN DISTINCT a, b",
+        "MATCH (a:N), (b:N), shortestPath((a)-[:R*]->(b)) RETURN a, b"
+    };
+    const OPType types[QUERY_COUNT] = {
+        OPType_NODE_BY_LABEL_SCAN,
+        OPType_ALL_NODE_SCAN,
+        OPType_CONDITIONAL_TRAVERSE,
+        OPType_CONDITIONAL_TRAVERSE,
+        OPType_EXPAND_INTO,
+        OPType_VAR_LEN_REACH,
+        OPType_SHORTEST_PATH
+    };
+
+    AST **asts[QUERY_COUNT];
+    ExecutionPlan *plans[QUERY_COUNT];
+    Graph_AcquireReadLock(g);
+    for(int i = 0; i < QUERY_COUNT; i++) {
+        plans[i] = _plan(queries[i], asts + i);
+        ASSERT_TRUE(ExecutionPlan_LocateOp(plans[i]->root, types[i]) != NULL) << queries[i];
+        ASSERT_FALSE(plans[i]->disposable);
+        ASSERT_GT(_count(plans[i]), 0) << queries[i];
+    }
+    Graph_ReleaseLock(g);
+
+    // Graph grows past its initial capacity.
+    _add_nodes(NODE_COUNT * 16);
+    Graph_AcquireReadLock(g);
+    for(int i = 0; i < QUERY_COUNT; i++) {
+        ExecutionPlan_Reset(plans[i], NULL);
+        ASSERT_EQ(_count(plans[i]), _expected(queries[i])) << queries[i];
+    }
+    Graph_ReleaseLock(g);
+
+    /* Folding replaces graph matrices, the next fold reclaims replaced matrices
+     * as no reader is pinned to them. */
+    _connect_all();
+    _add_nodes(NODE_COUNT);
+    GrB_Matrix relation = Graph_GetRelationMatrix(g, GraphContext_GetSchema(gc, "R", SCHEMA_EDGE)->id);
+    Graph_FoldDeltas(g);
+    _connect_all();
+    Graph_FoldDeltas(g);
+    ASSERT_NE(relation, Graph_GetRelationMatrix(g, GraphContext_GetSchema(gc, "R", SCHEMA_EDGE)->id));
+
+    Graph_AcquireReadLock(g);
+    for(int i = 0; i < QUERY_COUNT; i++) {
+        ExecutionPlan_Reset(plans[i], NULL);
+        ASSERT_EQ(_count(plans[i]), _expected(queries[i])) << queries[i];
+    }
+    Graph_ReleaseLock(g);
+
+    for(int i = 0; i < QUERY_COUNT; i++) {
+        ExecutionPlanFree(plans[i]);
+        AST_Free(asts[i]);
+    }
+}
+
+TEST_F(PlanReuseTest, ReducedCountIsDisposable) {
+    AST **ast;
+    ExecutionPlan *plan = _plan("MATCH (a:N) RETURN count(a)", &ast);
+    // Count is computed while planning.
+    ASSERT_TRUE(plan->disposable);
+    ExecutionPlanFree(plan);
+    AST_Free(ast);
+}
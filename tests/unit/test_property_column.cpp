@@ -0,0 +1,281 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/schema/column.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class PropertyColumnTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext_Free(GraphContext_GetFromTLS());
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(16, 16);
+        gc->index_count = 0;
+        gc->schema_version = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+};
+
+TEST_F(PropertyColumnTest, NumericColumn) {
+    PropertyColumn *c = PropertyColumn_New(0, NULL);
+    SIValue v;
+
+    // Empty column holds no value for any node.
+    ASSERT_FALSE(PropertyColumn_Get(c, 10, &v));
+
+    // Set every other node, forcing column to grow.
+    for(int i = 0; i < 1000; i += 2) ASSERT_TRUE(PropertyColumn_Set(c, i, SI_LongVal(i * 3)));
+    ASSERT_EQ(c->type, T_INT64);
+    ASSERT_GE(c->cap, 1000);
+
+    for(int i = 0; i < 1000; i++) {
+        if(i % 2 == 0) {
+            ASSERT_TRUE(PropertyColumn_Get(c, i, &v));
+            ASSERT_EQ(v.type, T_INT64);
+            ASSERT_EQ(v.longval, i * 3);
+        } else {
+            ASSERT_FALSE(PropertyColumn_Get(c, i, &v));
+        }
+    }
+
+    // Removing a value, either explicitly or by setting NULL.
+    PropertyColumn_Unset(c, 4);
+    ASSERT_FALSE(PropertyColumn_Set(c, 6, SI_NullVal()));
+    ASSERT_FALSE(PropertyColumn_Get(c, 4, &v));
+    ASSERT_FALSE(PropertyColumn_Get(c, 6, &v));
+    ASSERT_TRUE(PropertyColumn_Get(c, 8, &v));
+    ASSERT_EQ(v.longval, 24);
+
+    PropertyColumn_Free(c);
+}
+
+TEST_F(PropertyColumnTest, PooledStrings) {
+    StringPool *pool = StringPool_New();
+    PropertyColumn *c = PropertyColumn_New(1, pool);
+    const char *names[3] = {"Alice", "Bob", "Carol"};
+    SIValue v;
+
+    // Interned values are shared with the column, others are interned by it.
+    char *alice = StringPool_Intern(pool, "Alice");
+    SIValue interned = SI_ConstStringVal(alice);
+    interned.allocation = M_INTERNED;
+    for(int i = 0; i < 30; i++) {
+        SIValue name = (i % 3 == 0) ? interned : SI_ConstStringVal((char*)names[i % 3]);
+        ASSERT_TRUE(PropertyColumn_Set(c, i, name));
+    }
+    ASSERT_EQ(c->type, T_STRING);
+    ASSERT_EQ(StringPool_Size(pool), 3);
+
+    for(int i = 0; i < 30; i++) {
+        ASSERT_TRUE(PropertyColumn_Get(c, i, &v));
+        ASSERT_EQ(v.type, T_STRING);
+        ASSERT_EQ(v.allocation, M_CONST);
+        ASSERT_STREQ(v.stringval, names[i % 3]);
+        if(i % 3 == 0) ASSERT_EQ(v.stringval, alice);
+    }
+
+    // Overwriting a value with itself keeps its string.
+    StringPool_Release(alice);
+    ASSERT_TRUE(PropertyColumn_Set(c, 1, SI_ConstStringVal((char*)"Bob")));
+    ASSERT_EQ(StringPool_Size(pool), 3);
+
+    // Strings are released once the column no longer holds them.
+    for(int i = 2; i < 30; i += 3) PropertyColumn_Unset(c, i);
+    ASSERT_EQ(StringPool_Size(pool), 2);
+    PropertyColumn_Free(c);
+    ASSERT_EQ(StringPool_Size(pool), 0);
+
+    StringPool_Free(pool);
+}
+
+TEST_F(PropertyColumnTest, Widening) {
+    PropertyColumn *c = PropertyColumn_New(2, NULL);
+    SIValue v;
+
+    for(int i = 0; i < 100; i++) ASSERT_TRUE(PropertyColumn_Set(c, i, SI_LongVal(i)));
+
+    // Introducing a double widens the column in place.
+    ASSERT_TRUE(PropertyColumn_Set(c, 100, SI_DoubleVal(1.5)));
+    ASSERT_EQ(c->type, T_DOUBLE);
+    for(int i = 0; i < 100; i++) {
+        ASSERT_TRUE(PropertyColumn_Get(c, i, &v));
+        ASSERT_EQ(v.type, T_INT64);
+        ASSERT_EQ(v.longval, i);
+    }
+    ASSERT_TRUE(PropertyColumn_Get(c, 100, &v));
+    ASSERT_EQ(v.type, T_DOUBLE);
+    ASSERT_EQ(v.doubleval, 1.5);
+
+    // Nodes switch between integers and doubles.
+    ASSERT_TRUE(PropertyColumn_Set(c, 0, SI_DoubleVal(2.0)));
+    ASSERT_TRUE(PropertyColumn_Set(c, 100, SI_LongVal(-7)));
+    ASSERT_TRUE(PropertyColumn_Get(c, 0, &v));
+    ASSERT_EQ(v.type, T_DOUBLE);
+    ASSERT_TRUE(PropertyColumn_Get(c, 100, &v));
+    ASSERT_EQ(v.type, T_INT64);
+    ASSERT_EQ(v.longval, -7);
+
+    // Integers a double can't represent are refused.
+    int64_t big = (1LL << 53) + 1;
+    ASSERT_FALSE(PropertyColumn_Set(c, 1, SI_LongVal(big)));
+    ASSERT_FALSE(PropertyColumn_Get(c, 1, &v));
+    PropertyColumn_Free(c);
+
+    // Such integers keep a column from widening.
+    c = PropertyColumn_New(3, NULL);
+    ASSERT_TRUE(PropertyColumn_Set(c, 0, SI_LongVal(big)));
+    ASSERT_FALSE(PropertyColumn_Set(c, 1, SI_DoubleVal(0.5)));
+    ASSERT_EQ(c->type, T_INT64);
+    ASSERT_TRUE(PropertyColumn_Get(c, 0, &v));
+    ASSERT_EQ(v.longval, big);
+
+    // Double columns hold integers from the start.
+    PropertyColumn_Free(c);
+    c = PropertyColumn_New(4, NULL);
+    ASSERT_TRUE(PropertyColumn_Set(c, 0, SI_DoubleVal(0.5)));
+    ASSERT_TRUE(PropertyColumn_Set(c, 1, SI_LongVal(3)));
+    ASSERT_TRUE(PropertyColumn_Get(c, 1, &v));
+    ASSERT_EQ(v.type, T_INT64);
+    ASSERT_EQ(v.longval, 3);
+
+    PropertyColumn_Free(c);
+}
+
+TEST_F(PropertyColumnTest, RefusedValues) {
+    PropertyColumn *c = PropertyColumn_New(5, NULL);
+    SIValue v;
+
+    ASSERT_TRUE(PropertyColumn_Set(c, 0, SI_BoolVal(true)));
+    ASSERT_TRUE(PropertyColumn_Set(c, 1, SI_BoolVal(false)));
+
+    // Values of a different type are refused, removing the node from the column.
+    ASSERT_FALSE(PropertyColumn_Set(c, 1, SI_DoubleVal(1.5)));
+    ASSERT_FALSE(PropertyColumn_Set(c, 2, SI_ConstStringVal((char*)"a")));
+    ASSERT_FALSE(PropertyColumn_Get(c, 1, &v));
+    ASSERT_FALSE(PropertyColumn_Get(c, 2, &v));
+
+    // Column keeps serving the values it holds.
+    ASSERT_EQ(c->type, T_BOOL);
+    ASSERT_TRUE(PropertyColumn_Get(c, 0, &v));
+    ASSERT_EQ(v.type, T_BOOL);
+    ASSERT_TRUE(v.longval);
+
+    PropertyColumn_Free(c);
+}
+
+TEST_F(PropertyColumnTest, MemoryUsage) {
+    PropertyColumn *c = PropertyColumn_New(6, NULL);
+    size_t empty = PropertyColumn_MemoryUsage(c);
+
+    // Integers cost 8 bytes and a validity bit per node ID.
+    for(int i = 0; i < 1024; i++) PropertyColumn_Set(c, i, SI_LongVal(i));
+    ASSERT_EQ(PropertyColumn_MemoryUsage(c) - empty, 1024 * sizeof(int64_t) + 1024 / 8);
+
+    // Widened columns track integers with a second bit.
+    PropertyColumn_Set(c, 0, SI_DoubleVal(0.5));
+    ASSERT_EQ(PropertyColumn_MemoryUsage(c) - empty, 1024 * sizeof(double) + 2 * 1024 / 8);
+
+    PropertyColumn_Free(c);
+}
+
+TEST_F(PropertyColumnTest, StorageOfRecord) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+    Schema_SetColumnarLayout(true);
+    Schema *s = GraphContext_AddSchema(gc, "Person", SCHEMA_NODE);
+    Attribute_ID name = GraphContext_FindOrAddAttribute(gc, "name");
+    Attribute_ID age = GraphContext_FindOrAddAttribute(gc, "age");
+
+    Node a;
+    Node b;
+    Graph_AcquireWriteLock(gc->g);
+    Graph_CreateNode(gc->g, s->id, &a);
+    GraphEntity_AddProperty((GraphEntity*)&a, name, GraphContext_InternValue(gc, SI_ConstStringVal((char*)"Alice")));
+    GraphEntity_AddProperty((GraphEntity*)&a, age, SI_LongVal(30));
+    Graph_CreateNode(gc->g, s->id, &b);
+    GraphEntity_AddProperty((GraphEntity*)&b, age, SI_LongVal(40));
+    // Numeric name is refused by the string column.
+    GraphEntity_AddProperty((GraphEntity*)&b, name, SI_LongVal(7));
+    Schema_AddNodeToColumns(s, &a);
+    Schema_AddNodeToColumns(s, &b);
+    Graph_ReleaseLock(gc->g);
+
+    // Columns hold the values, nodes keep only what columns refused.
+    ASSERT_EQ(a.entity->prop_count, 0);
+    ASSERT_EQ(b.entity->prop_count, 1);
+    ASSERT_EQ(StringPool_Size(gc->string_pool), 1);
+
+    SIValue v = GraphEntity_GetPropertyValue((GraphEntity*)&a, name);
+    ASSERT_STREQ(v.stringval, "Alice");
+    v = GraphEntity_GetPropertyValue((GraphEntity*)&b, name);
+    ASSERT_EQ(v.type, T_INT64);
+    ASSERT_EQ(v.longval, 7);
+    v = GraphEntity_GetPropertyValue((GraphEntity*)&b, age);
+    ASSERT_EQ(v.longval, 40);
+
+    // Property enumeration covers both locations.
+    ASSERT_EQ(GraphEntity_PropertyCount((GraphEntity*)&b), 2);
+    EntityProperty props[2];
+    GraphEntity_GetProperties((GraphEntity*)&b, props);
+    ASSERT_EQ(props[0].id, name);
+    ASSERT_EQ(props[0].value.longval, 7);
+    ASSERT_EQ(props[1].id, age);
+    ASSERT_EQ(props[1].value.longval, 40);
+
+    // Updates widen the column rather than evict it.
+    ASSERT_TRUE(Schema_SetColumnValue(s, &a, age, SI_DoubleVal(30.5)));
+    v = GraphEntity_GetPropertyValue((GraphEntity*)&a, age);
+    ASSERT_EQ(v.type, T_DOUBLE);
+    v = GraphEntity_GetPropertyValue((GraphEntity*)&b, age);
+    ASSERT_EQ(v.type, T_INT64);
+
+    // Deleted nodes release their strings.
+    Schema_RemoveNodeFromColumns(s, ENTITY_GET_ID(&a));
+    ASSERT_EQ(StringPool_Size(gc->string_pool), 0);
+    v = GraphEntity_GetPropertyValue((GraphEntity*)&a, name);
+    ASSERT_TRUE(SIValue_IsNull(v));
+
+    Schema_SetColumnarLayout(false);
+}
@@ -0,0 +1,113 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_params.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/arithmetic_expression.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class QueryParamsTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+    }
+};
+
+TEST_F(QueryParamsTest, ParsePrefix) {
+    char *err = NULL;
+    QueryParams *params = NULL;
+    const char *query = "CYPHER name='Roi \\'R\\'' age=33 h=1.5 b=true n=null MATCH (p) RETURN p";
+    const char *body = QueryParams_Parse(query, &params, &err);
+
+    ASSERT_TRUE(params != NULL);
+    ASSERT_STREQ(body, "MATCH (p) RETURN p");
+
+    SIValue v;
+    ASSERT_TRUE(QueryParams_Get(params, "name", &v));
+    ASSERT_EQ(v.type, T_STRING);
+    ASSERT_STREQ(v.stringval, "Roi 'R'");
+    ASSERT_TRUE(QueryParams_Get(params, "age", &v));
+    ASSERT_EQ(v.type, T_INT64);
+    ASSERT_EQ(v.longval, 33);
+    ASSERT_TRUE(QueryParams_Get(params, "h", &v));
+    ASSERT_EQ(v.type, T_DOUBLE);
+    ASSERT_EQ(v.doubleval, 1.5);
+    ASSERT_TRUE(QueryParams_Get(params, "b", &v));
+    ASSERT_EQ(v.type, T_BOOL);
+    ASSERT_TRUE(QueryParams_Get(params, "n", &v));
+    ASSERT_TRUE(SIValue_IsNull(v));
+    ASSERT_FALSE(QueryParams_Get(params, "missing", &v));
+
+    QueryParams_Free(params);
+}
+
+TEST_F(QueryParamsTest, NoPrefix) {
+    char *err = NULL;
+    QueryParams *params = NULL;
+    const char *query = "MATCH (cypher) RETURN cypher";
+    ASSERT_EQ(QueryParams_Parse(query, &params, &err), query);
+    ASSERT_TRUE(params == NULL);
+}
+
+TEST_F(QueryParamsTest, InvalidValue) {
+    char *err = NULL;
+    QueryParams *params = NULL;
+    const char *query = "CYPHER name='unterminated MATCH (p) RETURN p";
+    ASSERT_TRUE(QueryParams_Parse(query, &params, &err) == NULL);
+    ASSERT_STREQ(err, "Invalid value for query parameter 'name'");
+    free(err);
+
+    query = "CYPHER x=1abc RETURN $x";
+    ASSERT_TRUE(QueryParams_Parse(query, &params, &err) == NULL);
+    free(err);
+}
+
+TEST_F(QueryParamsTest, ParamReferences) {
+    char *err = NULL;
+    QueryParams *params = NULL;
+    const char *query = QueryParams_Parse("CYPHER x=2 RETURN $x, $y", &params, &err);
+    AST **ast = ParseQuery(query, strlen(query), &err);
+    ASSERT_TRUE(ast != NULL);
+
+    // Both referred parameters are tracked.
+    char **names = AST_Params(ast);
+    ASSERT_EQ(array_len(names), 2);
+    ASSERT_STREQ(QueryParams_Missing(params, names), "y");
+
+    // Parameters are resolved against the bound parameters.
+    AST_ReturnElementNode *elm = ast[0]->returnNode->returnElements[0];
+    AR_ExpNode *exp = AR_EXP_BuildFromAST(ast[0], elm->exp);
+
+    char *str;
+    AR_EXP_ToString(exp, &str);
+    ASSERT_STREQ(str, "$x");
+    free(str);
+
+    ASSERT_TRUE(SIValue_IsNull(AR_EXP_Evaluate(exp, NULL)));
+    QueryParams_Bind(params);
+    SIValue v = AR_EXP_Evaluate(exp, NULL);
+    ASSERT_EQ(v.type, T_INT64);
+    ASSERT_EQ(v.longval, 2);
+    QueryParams_Bind(NULL);
+
+    AR_EXP_Free(exp);
+    AST_Free(ast);
+    QueryParams_Free(params);
+}
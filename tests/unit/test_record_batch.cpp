@@ -0,0 +1,72 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "../../src/execution_plan/record_batch.h"
+#include "../../src/execution_plan/ops/op.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/value.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+// Operation producing a fixed number of single entry records.
+typedef struct {
+    OpBase op;
+    int produced;
+    int limit;
+} CountOp;
+
+static Record CountOpConsume(OpBase *opBase) {
+    CountOp *op = (CountOp*)opBase;
+    if(op->produced == op->limit) return NULL;
+    Record r = Record_New(1);
+    Record_AddScalar(r, 0, SI_LongVal(op->produced++));
+    return r;
+}
+
+class RecordBatchTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {// Use the malloc family for allocations
+      Alloc_Reset();
+    }
+};
+
+TEST_F(RecordBatchTest, ConsumeRowsAsBatch) {
+    CountOp op;
+    OpBase_Init(&op.op);
+    op.op.consume = CountOpConsume;
+    op.produced = 0;
+    op.limit = RECORD_BATCH_CAP + 10;
+
+    RecordBatch *batch = RecordBatch_New();
+
+    // First batch is filled to capacity.
+    ASSERT_EQ(OpBase_ConsumeBatch(&op.op, batch), RECORD_BATCH_CAP);
+    ASSERT_TRUE(RecordBatch_Full(batch));
+    for(uint i = 0; i < batch->count; i++) {
+        ASSERT_EQ(Record_GetScalar(batch->records[i], 0).longval, i);
+    }
+    RecordBatch_Clear(batch);
+    ASSERT_EQ(batch->count, 0);
+
+    // Remaining records.
+    ASSERT_EQ(OpBase_ConsumeBatch(&op.op, batch), 10);
+    ASSERT_EQ(Record_GetScalar(batch->records[0], 0).longval, RECORD_BATCH_CAP);
+    RecordBatch_Clear(batch);
+
+    // Depleted.
+    ASSERT_EQ(OpBase_ConsumeBatch(&op.op, batch), 0);
+
+    RecordBatch_Free(batch);
+}
@@ -0,0 +1,71 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/execution_plan/record.h"
+#include "../../src/execution_plan/record_pool.h"
+#include "../../src/util/rmalloc.h"
+#include "../../src/value.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class RecordPoolTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {// Use the malloc family for allocations
+      Alloc_Reset();
+    }
+};
+
+TEST_F(RecordPoolTest, ReuseFreedRecords) {
+    RecordPool *pool = RecordPool_New();
+
+    Record a = Record_NewPooled(pool, 3);
+    Record_AddScalar(a, 0, SI_LongVal(1));
+    ASSERT_EQ(Record_length(a), 3);
+    ASSERT_EQ(pool->allocated, 1);
+    ASSERT_EQ(pool->reused, 0);
+
+    // Freed record is handed out again, cleared.
+    Record_Free(a);
+    Record b = Record_NewPooled(pool, 3);
+    ASSERT_EQ(b, a);
+    ASSERT_EQ(Record_GetType(b, 0), REC_TYPE_UNKNOWN);
+    ASSERT_EQ(pool->allocated, 1);
+    ASSERT_EQ(pool->reused, 1);
+
+    // Records of a different length are not shared.
+    Record c = Record_NewPooled(pool, 5);
+    ASSERT_EQ(Record_length(c), 5);
+    ASSERT_EQ(pool->allocated, 2);
+
+    // Clones are drawn from the source record's pool.
+    Record_AddScalar(b, 1, SI_LongVal(7));
+    Record_Free(c);
+    Record d = Record_Clone(b);
+    ASSERT_EQ(pool->allocated, 3);
+    ASSERT_EQ(Record_GetScalar(d, 1).longval, 7);
+
+    Record_Free(b);
+    Record_Free(d);
+    RecordPool_Free(pool);
+}
+
+TEST_F(RecordPoolTest, NoPool) {
+    // Without a pool records are heap allocated.
+    Record r = Record_NewPooled(NULL, 2);
+    ASSERT_EQ(Record_length(r), 2);
+    Record clone = Record_Clone(r);
+    ASSERT_EQ(Record_length(clone), 2);
+    Record_Free(r);
+    Record_Free(clone);
+}
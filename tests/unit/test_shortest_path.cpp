@@ -0,0 +1,244 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/query_executor.h"
+#include "../../src/graph/graph.h"
+#include "../../src/graph/entities/edge.h"
+#include "../../src/algorithms/shortest_path.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_shortest_path.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 10
+
+/* Produces a record for every pair of nodes in graph,
+ * holding the pair at positions a and b. */
+typedef struct {
+    OpBase op;
+    Graph *g;
+    int a;                  // Record position of first node.
+    int b;                  // Record position of second node.
+    int entries;            // Record length.
+    NodeID pair;            // Next pair to produce.
+} NodePairs;
+
+static Record NodePairsConsume(OpBase *opBase) {
+    NodePairs *op = (NodePairs*)opBase;
+    size_t node_count = Graph_NodeCount(op->g);
+    if(op->pair == node_count * node_count) return NULL;
+
+    Node a;
+    Node b;
+    Graph_GetNode(op->g, op->pair / node_count, &a);
+    Graph_GetNode(op->g, op->pair % node_count, &b);
+    op->pair++;
+
+    Record r = Record_New(op->entries);
+    Record_AddNode(r, op->a, a);
+    Record_AddNode(r, op->b, b);
+    return r;
+}
+
+static void NodePairsFree(OpBase *) {
+}
+
+static OpBase *NewNodePairs(Graph *g, int a, int b, int entries) {
+    NodePairs *op = (NodePairs*)malloc(sizeof(NodePairs));
+    OpBase_Init(&op->op);
+    op->op.consume = NodePairsConsume;
+    op->op.free = NodePairsFree;
+    op->g = g;
+    op->a = a;
+    op->b = b;
+    op->entries = entries;
+    op->pair = 0;
+    return (OpBase*)op;
+}
+
+class ShortestPathTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        GrB_init(GrB_NONBLOCKING);
+    }
+
+    static void TearDownTestCase() {
+        GrB_finalize();
+    }
+
+    /* Two shortest paths of length 4 lead from 0 to 5:
+     * 0->1->3->4->5 and 0->2->3->4->5,
+     * a longer one goes through 6, 7, 8 and 9,
+     * edges are split between relations R and S. */
+    static void _BuildGraph(GrB_Matrix *R, GrB_Matrix *S) {
+        GrB_Index r_edges[][2] = {{0, 1}, {1, 3}, {3, 4}, {0, 6}, {7, 8}, {9, 5}};
+        GrB_Index s_edges[][2] = {{0, 2}, {2, 3}, {4, 5}, {6, 7}, {8, 9}};
+        GrB_Matrix_new(R, GrB_BOOL, NODE_COUNT, NODE_COUNT);
+        GrB_Matrix_new(S, GrB_BOOL, NODE_COUNT, NODE_COUNT);
+        for(int i = 0; i < 6; i++) GrB_Matrix_setElement_BOOL(*R, true, r_edges[i][0], r_edges[i][1]);
+        for(int i = 0; i < 5; i++) GrB_Matrix_setElement_BOOL(*S, true, s_edges[i][0], s_edges[i][1]);
+    }
+
+    static void _ValidateSearch(ShortestPathCtx *ctx) {
+        uint64_t path_count;
+        ASSERT_EQ(ShortestPath_Search(ctx, 0, 5, 1, EDGE_LENGTH_INF, &path_count), 4);
+        ASSERT_EQ(path_count, 2);
+        ASSERT_EQ(ShortestPath_Search(ctx, 0, 4, 1, EDGE_LENGTH_INF, &path_count), 3);
+        ASSERT_EQ(path_count, 2);
+        ASSERT_EQ(ShortestPath_Search(ctx, 6, 5, 1, EDGE_LENGTH_INF, &path_count), 4);
+        ASSERT_EQ(path_count, 1);
+        ASSERT_EQ(ShortestPath_Search(ctx, 0, 1, 1, EDGE_LENGTH_INF, &path_count), 1);
+        ASSERT_EQ(path_count, 1);
+
+        // Path length is bounded.
+        ASSERT_EQ(ShortestPath_Search(ctx, 0, 5, 1, 3, &path_count), -1);
+        ASSERT_EQ(ShortestPath_Search(ctx, 0, 5, 1, 4, &path_count), 4);
+
+        // Edges are followed by their direction.
+        ASSERT_EQ(ShortestPath_Search(ctx, 5, 0, 1, EDGE_LENGTH_INF, &path_count), -1);
+        ASSERT_EQ(path_count, 0);
+
+        // A node is connected to itself only by the empty path.
+        ASSERT_EQ(ShortestPath_Search(ctx, 3, 3, 0, EDGE_LENGTH_INF, &path_count), 0);
+        ASSERT_EQ(path_count, 1);
+        ASSERT_EQ(ShortestPath_Search(ctx, 3, 3, 1, EDGE_LENGTH_INF, &path_count), -1);
+    }
+};
+
+TEST_F(ShortestPathTest, BidirectionalSearch) {
+    GrB_Matrix R;
+    GrB_Matrix S;
+    _BuildGraph(&R, &S);
+
+    // Destination side expanded by multiplying with forward matrices.
+    GrB_Matrix forward[2] = {R, S};
+    ShortestPathCtx *ctx = ShortestPathCtx_New(forward, NULL, 2, NODE_COUNT);
+    _ValidateSearch(ctx);
+    ShortestPathCtx_Free(ctx);
+
+    // Destination side expanded over transposed matrices.
+    GrB_Matrix backward[2];
+    GrB_Matrix_new(&backward[0], GrB_BOOL, NODE_COUNT, NODE_COUNT);
+    GrB_Matrix_new(&backward[1], GrB_BOOL, NODE_COUNT, NODE_COUNT);
+    GrB_transpose(backward[0], GrB_NULL, GrB_NULL, R, GrB_NULL);
+    GrB_transpose(backward[1], GrB_NULL, GrB_NULL, S, GrB_NULL);
+    ctx = ShortestPathCtx_New(forward, backward, 2, NODE_COUNT);
+    _ValidateSearch(ctx);
+    ShortestPathCtx_Free(ctx);
+
+    // Only traverse R.
+    uint64_t path_count;
+    ctx = ShortestPathCtx_New(forward, backward, 1, NODE_COUNT);
+    ASSERT_EQ(ShortestPath_Search(ctx, 0, 4, 1, EDGE_LENGTH_INF, &path_count), 3);
+    ASSERT_EQ(path_count, 1);
+    ASSERT_EQ(ShortestPath_Search(ctx, 0, 5, 1, EDGE_LENGTH_INF, &path_count), -1);
+    ShortestPathCtx_Free(ctx);
+
+    GrB_Matrix_free(&R);
+    GrB_Matrix_free(&S);
+    GrB_Matrix_free(&backward[0]);
+    GrB_Matrix_free(&backward[1]);
+}
+
+TEST_F(ShortestPathTest, ParsePathFunctions) {
+    const char *query = "MATCH (a), (b), shortestPath((a)-[:R*]->(b)), allShortestPaths((b)<-[*..3]-(a)) RETURN a";
+    char *errMsg = NULL;
+    AST **ast = ParseQuery(query, strlen(query), &errMsg);
+    ASSERT_TRUE(ast != NULL);
+
+    AST_PathSelector expected[2] = {N_PATH_SHORTEST, N_PATH_ALL_SHORTEST};
+    int link_count = 0;
+    Vector *entities = ast[0]->matchNode->_mergedPatterns;
+    for(int i = 0; i < Vector_Size(entities); i++) {
+        AST_GraphEntity *entity;
+        Vector_Get(entities, i, &entity);
+        if(entity->t != N_LINK) continue;
+        ASSERT_EQ(((AST_LinkEntity*)entity)->selector, expected[link_count++]);
+    }
+    ASSERT_EQ(link_count, 2);
+    AST_Free(ast);
+
+    query = "MATCH (a), (b), longestPath((a)-[*]->(b)) RETURN a";
+    ast = ParseQuery(query, strlen(query), &errMsg);
+    ASSERT_TRUE(ast == NULL);
+    ASSERT_STREQ(errMsg, "Unknown path function 'longestPath'");
+    free(errMsg);
+}
+
+TEST_F(ShortestPathTest, Operation) {
+    // (0)->(1)->(3), (0)->(2)->(3)
+    Node n;
+    Edge e;
+    Graph *g = Graph_New(GRAPH_DEFAULT_NODE_CAP, GRAPH_DEFAULT_EDGE_CAP);
+    Graph_AcquireWriteLock(g);
+    Graph_AddRelationType(g);
+    for(int i = 0; i < 4; i++) Graph_CreateNode(g, GRAPH_NO_LABEL, &n);
+    Graph_ConnectNodes(g, 0, 1, 0, &e);
+    Graph_ConnectNodes(g, 1, 3, 0, &e);
+    Graph_ConnectNodes(g, 0, 2, 0, &e);
+    Graph_ConnectNodes(g, 2, 3, 0, &e);
+
+    const char *queries[2] = {
+        "MATCH (a), (b), shortestPath((a)-[*]->(b)) RETURN a, b",
+        "MATCH (a), (b), allShortestPaths((b)<-[*]-(a)) RETURN a, b"
+    };
+    // Number of records produced per (a, b) pair.
+    int expected[2][4][4] = {
+        {{0, 1, 1, 1}, {0, 0, 0, 1}, {0, 0, 0, 1}, {0, 0, 0, 0}},
+        {{0, 1, 1, 2}, {0, 0, 0, 1}, {0, 0, 0, 1}, {0, 0, 0, 0}}
+    };
+
+    for(int q = 0; q < 2; q++) {
+        AST **ast = ParseQuery(queries[q], strlen(queries[q]), NULL);
+        ASSERT_TRUE(ast != NULL);
+        Vector *entities = ast[0]->matchNode->_mergedPatterns;
+        AST_LinkEntity *link = NULL;
+        for(int i = 0; i < Vector_Size(entities); i++) {
+            AST_GraphEntity *entity;
+            Vector_Get(entities, i, &entity);
+            if(entity->t == N_LINK) link = (AST_LinkEntity*)entity;
+        }
+
+        int a = AST_GetAliasID(ast[0], (char*)"a");
+        int b = AST_GetAliasID(ast[0], (char*)"b");
+        OpBase *op = NewShortestPathOp(g, ast[0], link, "a", "b");
+        OpBase *pairs = NewNodePairs(g, a, b, AST_AliasCount(ast[0]));
+        ExecutionPlan_AddOp(op, pairs);
+        op->init(op);
+
+        int produced[4][4] = {{0}};
+        Record r;
+        while((r = op->consume(op))) {
+            NodeID src = ENTITY_GET_ID(Record_GetNode(r, a));
+            NodeID dest = ENTITY_GET_ID(Record_GetNode(r, b));
+            produced[src][dest]++;
+            Record_Free(r);
+        }
+
+        for(int i = 0; i < 4; i++) {
+            for(int j = 0; j < 4; j++) ASSERT_EQ(produced[i][j], expected[q][i][j]);
+        }
+
+        OpBase_Free(pairs);
+        OpBase_Free(op);
+        AST_Free(ast);
+    }
+
+    Graph_ReleaseLock(g);
+    Graph_Free(g);
+}
@@ -87,6 +87,55 @@ TEST_F(SkiplistTest, SkiplistRange) {
   skiplistFree(sl);
 }
 
+TEST_F(SkiplistTest, SkiplistReverseRange) {
+  SIValue cur_prop;
+  skiplist *sl = skiplistCreate(compareNumerics, compareNodes, cloneKey, freeKey);
+
+  // The IDs we will assign to the Node values in the skiplist
+  // (defined as the order the keys should be in after sorting)
+  EntityID ids[] = {5, 2, 0, 6, 3, 4, 1};
+  char *keys[] = {"5.5", "0", "-30.2", "7", "1", "2", "-1.5", NULL};
+
+  for (long i = 0; keys[i] != NULL; i ++) {
+    cur_prop = SIValue_FromString(keys[i]);
+    skiplistInsert(sl, &cur_prop, ids[i]);
+  }
+
+  // Iterate over all keys in descending order
+  EntityID *ret_node;
+  EntityID last_id = 7;
+  skiplistIterator *iter = skiplistIterateAll(sl);
+  skiplistIterate_Reverse(iter);
+  while ((ret_node = skiplistIterator_Next(iter)) != NULL) {
+    ASSERT_EQ(last_id - 1, *ret_node);
+    last_id = *ret_node;
+  }
+  ASSERT_EQ(last_id, 0);
+  skiplistIterate_Free(iter);
+
+  // Iterate over a range of keys (-1.5, 5.5] in descending order
+  SIValue *min = (SIValue*)malloc(sizeof(SIValue));
+  SIValue *max = (SIValue*)malloc(sizeof(SIValue));
+  *min = SI_DoubleVal(-1.5);
+  *max = SI_DoubleVal(5.5);
+  iter = skiplistIterateRange(sl, min, max, 1, 0);
+  skiplistIterate_Reverse(iter);
+  last_id = 6;
+  for (int pass = 0; pass < 2; pass ++) {
+    while ((ret_node = skiplistIterator_Next(iter)) != NULL) {
+      ASSERT_EQ(last_id - 1, *ret_node);
+      last_id = *ret_node;
+    }
+    ASSERT_EQ(last_id, 2);
+    // Reset restarts from the upper bound
+    skiplistIterate_Reset(iter);
+    last_id = 6;
+  }
+
+  skiplistIterate_Free(iter);
+  skiplistFree(sl);
+}
+
 TEST_F(SkiplistTest, SkiplistDelete) {
   int delete_result;
 
@@ -0,0 +1,75 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/util/string_pool.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class StringPoolTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+    }
+};
+
+TEST_F(StringPoolTest, InternAndRelease) {
+    StringPool *pool = StringPool_New();
+    char us[3] = "US";
+
+    // Equal strings share a single copy.
+    char *a = StringPool_Intern(pool, "US");
+    char *b = StringPool_Intern(pool, us);
+    char *c = StringPool_Intern(pool, "FR");
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_NE(a, us);
+    ASSERT_STREQ(a, "US");
+    ASSERT_EQ(StringPool_Size(pool), 2);
+
+    // String remains pooled while it has holders.
+    StringPool_Release(a);
+    ASSERT_EQ(StringPool_Size(pool), 2);
+    ASSERT_EQ(StringPool_Intern(pool, "US"), b);
+    StringPool_Release(b);
+    StringPool_Release(b);
+    ASSERT_EQ(StringPool_Size(pool), 1);
+
+    StringPool_Release(c);
+    ASSERT_EQ(StringPool_Size(pool), 0);
+
+    StringPool_Free(pool);
+}
+
+TEST_F(StringPoolTest, InternedValues) {
+    StringPool *pool = StringPool_New();
+    char *s = StringPool_Intern(pool, "active");
+    SIValue v = SI_ConstStringVal(s);
+    v.allocation = M_INTERNED;
+
+    // Shallow copies do not hold a reference.
+    SIValue copy = SI_ShallowCopy(v);
+    ASSERT_EQ(copy.allocation, M_CONST);
+    ASSERT_EQ(SIValue_Compare(v, copy), 0);
+    ASSERT_EQ(SIValue_Compare(v, SI_ConstStringVal((char*)"active")), 0);
+
+    // Freeing the value releases it from the pool.
+    SIValue_Free(&v);
+    ASSERT_EQ(StringPool_Size(pool), 0);
+
+    StringPool_Free(pool);
+}
@@ -14,6 +14,7 @@ extern "C" {
 #include "../../src/parser/ast.h"
 #include "../../src/query_executor.h"
 #include "../../src/graph/query_graph.h"
+#include "../../src/graph/graphcontext.h"
 #include "../../src/filter_tree/filter_tree.h"
 #include "../../src/arithmetic/algebraic_expression.h"
 #include "../../src/execution_plan/optimizations/traverse_order.h"
@@ -27,9 +28,13 @@ class TraversalOrderingTest: public ::testing::Test {
     static void SetUpTestCase() {
         // Use the malloc family for allocations
         Alloc_Reset();
+
+        // Initialize GraphBLAS.
+        GrB_init(GrB_NONBLOCKING);
     }
 
     static void TearDownTestCase() {
+        GrB_finalize();
     }
 
     AST* _build_ast(const char *query) {
@@ -113,7 +118,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[1] = ExpBC;
     set[2] = ExpAB;
 
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -122,7 +127,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[0] = ExpAB;
     set[1] = ExpBC;
     set[2] = ExpCD;
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -131,7 +136,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[0] = ExpAB;
     set[1] = ExpCD;
     set[2] = ExpBC;
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -140,7 +145,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[0] = ExpBC;
     set[1] = ExpAB;
     set[2] = ExpCD;
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -149,7 +154,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[0] = ExpBC;
     set[1] = ExpCD;
     set[2] = ExpAB;
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -158,7 +163,7 @@ TEST_F(TraversalOrderingTest, TransposeFree) {
     set[0] = ExpCD;
     set[1] = ExpAB;
     set[2] = ExpBC;
-    orderExpressions(set, 3, NULL);
+    orderExpressions(set, 3, NULL, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -230,7 +235,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 
     filters = build_filter_tree_from_query("MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE A.val = 1 RETURN *");
 
-    orderExpressions(set, 3, filters);
+    orderExpressions(set, 3, filters, NULL, NULL);
     ASSERT_EQ(set[0], ExpAB);
     ASSERT_EQ(set[1], ExpBC);
     ASSERT_EQ(set[2], ExpCD);
@@ -244,7 +249,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 
     filters = build_filter_tree_from_query("MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE B.val = 1 RETURN *");
 
-    orderExpressions(set, 3, filters);
+    orderExpressions(set, 3, filters, NULL, NULL);
     ASSERT_TRUE (set[0] == ExpAB || set[0] == ExpBC);
 
     FilterTree_Free(filters);
@@ -256,7 +261,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 
     filters = build_filter_tree_from_query("MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE C.val = 1 RETURN *");
 
-    orderExpressions(set, 3, filters);
+    orderExpressions(set, 3, filters, NULL, NULL);
     ASSERT_TRUE(set[0] == ExpBC || set[0] == ExpCD);
 
     FilterTree_Free(filters);
@@ -268,7 +273,7 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
 
     filters = build_filter_tree_from_query("MATCH (A)-[]->(B)-[]->(C)-[]->(D) WHERE D.val = 1 RETURN *");
 
-    orderExpressions(set, 3, filters);
+    orderExpressions(set, 3, filters, NULL, NULL);
 
     ASSERT_EQ(set[0], ExpCD);
     ASSERT_EQ(set[1], ExpBC);
@@ -281,3 +286,169 @@ TEST_F(TraversalOrderingTest, FilterFirst) {
     AlgebraicExpression_Free(ExpCD);
     QueryGraph_Free(qg);
 }
+
+TEST_F(TraversalOrderingTest, StatisticsDriven) {
+    /* Given the traversal (A:L0)-[:R]->(B:L1)
+     * where there are 100 L0 nodes, each connected to one of 2 L1 nodes,
+     * starting at B produces fewer intermediate rows than starting at A. */
+    Node n;
+    Edge e;
+    size_t nodeCount = 100;
+    Graph *g = Graph_New(nodeCount, nodeCount);
+    int l0 = Graph_AddLabel(g);
+    int l1 = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+
+    Graph_AcquireWriteLock(g);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, l0, &n);
+    Graph_CreateNode(g, l1, &n);
+    Graph_CreateNode(g, l1, &n);
+    for(int i = 0; i < nodeCount; i++) {
+        Graph_ConnectNodes(g, i, nodeCount + (i % 2), r, &e);
+    }
+    Graph_ReleaseLock(g);
+
+    GraphContext *gc = (GraphContext*)rm_calloc(1, sizeof(GraphContext));
+    gc->g = g;
+
+    Node *A = Node_New("L0", "A");
+    Node *B = Node_New("L1", "B");
+    A->labelID = l0;
+    B->labelID = l1;
+
+    // [L0] * [R] * [L1]
+    AlgebraicExpression *ExpAB = AlgebraicExpression_Empty();
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, true);
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, false);
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, true);
+    ExpAB->operands[0].schema_id = l0;
+    ExpAB->operands[1].schema_id = r;
+    ExpAB->operands[2].schema_id = l1;
+    ExpAB->src_node = A;
+    ExpAB->dest_node = B;
+
+    // Without statistics, traversal starts at source.
+    AlgebraicExpression *set[1] = {ExpAB};
+    orderExpressions(set, 1, NULL, NULL, NULL);
+    ASSERT_EQ(ExpAB->src_node, A);
+
+    // Statistics suggest starting at the destination.
+    double estimates[2];
+    orderExpressions(set, 1, NULL, gc, estimates);
+    ASSERT_EQ(ExpAB->src_node, B);
+    ASSERT_EQ(ExpAB->dest_node, A);
+
+    // Scanning 2 L1 nodes, each reached by 50 L0 nodes.
+    ASSERT_EQ(estimates[0], 2);
+    ASSERT_NEAR(estimates[1], 2 * 50 * (100.0 / 102), 0.001);
+
+    // Clean up.
+    AlgebraicExpression_Free(ExpAB);
+    Node_Free(A);
+    Node_Free(B);
+    rm_free(gc);
+    Graph_Free(g);
+}
+
+TEST_F(TraversalOrderingTest, StatisticsAfterLoad) {
+    /* Graphs populated as RDB load does, without a write lock,
+     * are costed by their statistics once pending changes are applied. */
+    Node n;
+    Edge e;
+    size_t nodeCount = 100;
+    Graph *g = Graph_New(nodeCount, nodeCount);
+    int l0 = Graph_AddLabel(g);
+    int l1 = Graph_AddLabel(g);
+    int r = Graph_AddRelationType(g);
+
+    Graph_SetMatrixPolicy(g, RESIZE_TO_CAPACITY);
+    for(int i = 0; i < nodeCount; i++) Graph_CreateNode(g, l0, &n);
+    Graph_CreateNode(g, l1, &n);
+    Graph_CreateNode(g, l1, &n);
+    for(int i = 0; i < nodeCount; i++) {
+        Graph_ConnectNodes(g, i, nodeCount + (i % 2), r, &e);
+    }
+    Graph_SetMatrixPolicy(g, SYNC_AND_MINIMIZE_SPACE);
+    Graph_ApplyAllPending(g);
+
+    const GraphStatistics *stats = Graph_Statistics(g);
+    ASSERT_EQ(stats->node_count, nodeCount + 2);
+    ASSERT_EQ(stats->label_counts[l0], nodeCount);
+    ASSERT_EQ(stats->label_counts[l1], 2);
+
+    GraphContext *gc = (GraphContext*)rm_calloc(1, sizeof(GraphContext));
+    gc->g = g;
+
+    Node *A = Node_New("L0", "A");
+    Node *B = Node_New("L1", "B");
+    A->labelID = l0;
+    B->labelID = l1;
+
+    // [L0] * [R] * [L1]
+    AlgebraicExpression *ExpAB = AlgebraicExpression_Empty();
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, true);
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, false);
+    AlgebraicExpression_AppendTerm(ExpAB, NULL, false, false, true);
+    ExpAB->operands[0].schema_id = l0;
+    ExpAB->operands[1].schema_id = r;
+    ExpAB->operands[2].schema_id = l1;
+    ExpAB->src_node = A;
+    ExpAB->dest_node = B;
+
+    // Estimates match those of a graph populated by write queries.
+    double estimates[2];
+    AlgebraicExpression *set[1] = {ExpAB};
+    orderExpressions(set, 1, NULL, gc, estimates);
+    ASSERT_EQ(ExpAB->src_node, B);
+    ASSERT_EQ(estimates[0], 2);
+    ASSERT_NEAR(estimates[1], 2 * 50 * (100.0 / 102), 0.001);
+
+    // Clean up.
+    AlgebraicExpression_Free(ExpAB);
+    Node_Free(A);
+    Node_Free(B);
+    rm_free(gc);
+    Graph_Free(g);
+}
+
+TEST_F(TraversalOrderingTest, LongPattern) {
+    /* Given the traversal (N0)->(N1)->...->(Nk) filtered on Nk
+     * traversal should start at Nk and retract all the way back to N0,
+     * patterns both within and beyond exhaustive search are arranged. */
+    uint lengths[2] = {10, 24};
+    for(uint l = 0; l < 2; l++) {
+        uint exp_count = lengths[l];
+        Node *nodes[exp_count + 1];
+        AlgebraicExpression *exps[exp_count];
+        AlgebraicExpression *set[exp_count];
+
+        char alias[16];
+        for(uint i = 0; i <= exp_count; i++) {
+            snprintf(alias, 16, "N%u", i);
+            nodes[i] = Node_New(NULL, alias);
+        }
+        for(uint i = 0; i < exp_count; i++) {
+            exps[i] = AlgebraicExpression_Empty();
+            AlgebraicExpression_AppendTerm(exps[i], NULL, false, false, false);
+            exps[i]->src_node = nodes[i];
+            exps[i]->dest_node = nodes[i + 1];
+            set[i] = exps[i];
+        }
+
+        char query[128];
+        snprintf(query, 128, "MATCH (N%u) WHERE N%u.val = 1 RETURN N%u", exp_count, exp_count, exp_count);
+        FT_FilterNode *filters = build_filter_tree_from_query(query);
+
+        double estimates[exp_count + 1];
+        orderExpressions(set, exp_count, filters, NULL, estimates);
+        for(uint i = 0; i < exp_count; i++) ASSERT_EQ(set[i], exps[exp_count - 1 - i]);
+        ASSERT_EQ(set[0]->src_node, nodes[exp_count]);
+
+        // Every step is expected to produce the filtered rows.
+        for(uint i = 0; i <= exp_count; i++) ASSERT_NEAR(estimates[i], 0.1, 0.0001);
+
+        FilterTree_Free(filters);
+        for(uint i = 0; i < exp_count; i++) AlgebraicExpression_Free(exps[i]);
+        for(uint i = 0; i <= exp_count; i++) Node_Free(nodes[i]);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "../../src/execution_plan/traverse_batch.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+class TraverseBatchTest: public ::testing::Test {
+  protected:
+    static void TearDownTestCase() {
+        TraverseBatch_SetCap(TRAVERSE_BATCH_DEFAULT_CAP);
+    }
+};
+
+TEST_F(TraverseBatchTest, GrowWhileChildProduces) {
+    TraverseBatch batch;
+    TraverseBatch_Init(&batch, 0);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE);
+
+    // Full batches with small results double batch size up to cap.
+    uint expected = TRAVERSE_BATCH_INITIAL_SIZE;
+    while(expected < TRAVERSE_BATCH_DEFAULT_CAP) {
+        TraverseBatch_Update(&batch, batch.size, batch.size);
+        expected *= 2;
+        ASSERT_EQ(batch.size, expected);
+    }
+    TraverseBatch_Update(&batch, batch.size, batch.size);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_DEFAULT_CAP);
+    ASSERT_EQ(batch.max_used, TRAVERSE_BATCH_DEFAULT_CAP);
+
+    // Partial batch, child is depleting.
+    TraverseBatch_Init(&batch, 0);
+    TraverseBatch_Update(&batch, batch.size - 1, 1);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE);
+    ASSERT_EQ(batch.batches, 1);
+}
+
+TEST_F(TraverseBatchTest, ResultBudget) {
+    TraverseBatch batch;
+    TraverseBatch_Init(&batch, 0);
+    TraverseBatch_Update(&batch, batch.size, 1);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE * 2);
+
+    // Doubling batch would exceed budget, keep size.
+    TraverseBatch_Update(&batch, batch.size, TRAVERSE_BATCH_RESULT_BUDGET);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE * 2);
+
+    // Budget exceeded, back off.
+    TraverseBatch_Update(&batch, batch.size, TRAVERSE_BATCH_RESULT_BUDGET + 1);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE);
+}
+
+TEST_F(TraverseBatchTest, LimitAndCap) {
+    TraverseBatch batch;
+    TraverseBatch_Init(&batch, 3);
+    ASSERT_EQ(batch.size, 3);
+
+    TraverseBatch_SetCap(20);
+    TraverseBatch_Init(&batch, 0);
+    TraverseBatch_Update(&batch, batch.size, 1);
+    ASSERT_EQ(batch.size, 20);
+
+    // Reset restarts from initial size.
+    TraverseBatch_Reset(&batch);
+    ASSERT_EQ(batch.size, TRAVERSE_BATCH_INITIAL_SIZE);
+    ASSERT_EQ(batch.batches, 0);
+}
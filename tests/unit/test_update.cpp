@@ -0,0 +1,144 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+void ExecutionPlanInit(ExecutionPlan *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NODE_COUNT 4
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+class UpdateTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    // Node i holds the interned string 'v<i>' as its v property.
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "N", SCHEMA_NODE);
+        Attribute_ID v = GraphContext_FindOrAddAttribute(gc, "v");
+        GraphContext_FindOrAddAttribute(gc, "w");
+
+        Node n;
+        char buf[16];
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) {
+            Graph_CreateNode(gc->g, s->id, &n);
+            snprintf(buf, 16, "v%d", i);
+            SIValue value = GraphContext_InternValue(gc, SI_ConstStringVal(buf));
+            GraphEntity_AddProperty((GraphEntity*)&n, v, value);
+        }
+        Graph_ReleaseLock(gc->g);
+    }
+
+    // Runs query to completion.
+    static void _run(const char *query) {
+        char *errMsg = NULL;
+        AST **ast = ParseQuery(query, strlen(query), &errMsg);
+        ASSERT_TRUE(ast != NULL) << query;
+        ModifyAST(ast);
+        ExecutionPlan *plan = NewExecutionPlan(NULL, ast, NULL, false);
+        ExecutionPlanInit(plan);
+
+        // Update operation acquires the graph's write lock.
+        Record r;
+        while((r = OpBase_Consume(plan->root))) Record_Free(r);
+
+        ExecutionPlanFree(plan);
+        AST_Free(ast);
+    }
+
+    static SIValue _property(NodeID id, const char *attribute) {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Node n;
+        Graph_GetNode(gc->g, id, &n);
+        SIValue *v = GraphEntity_GetProperty((GraphEntity*)&n, GraphContext_GetAttributeID(gc, attribute));
+        return (v == PROPERTY_NOTFOUND) ? SI_NullVal() : *v;
+    }
+};
+
+TEST_F(UpdateTest, SetFromUpdatedProperty) {
+    GraphContext *gc = GraphContext_GetFromTLS();
+
+    // w is evaluated from v before v is replaced by the same clause.
+    _run("MATCH (a:N) SET a.v = 'x', a.w = a.v");
+    char buf[16];
+    for(int i = 0; i < NODE_COUNT; i++) {
+        snprintf(buf, 16, "v%d", i);
+        ASSERT_STREQ(_property(i, "v").stringval, "x");
+        ASSERT_STREQ(_property(i, "w").stringval, buf);
+    }
+    // Each node holds its own former value, all nodes share 'x'.
+    ASSERT_EQ(StringPool_Size(gc->string_pool), NODE_COUNT + 1);
+
+    // Replaced strings are released from the pool.
+    _run("MATCH (a:N) SET a.w = a.v");
+    for(int i = 0; i < NODE_COUNT; i++) {
+        ASSERT_STREQ(_property(i, "w").stringval, "x");
+    }
+    ASSERT_EQ(StringPool_Size(gc->string_pool), 1);
+
+    _run("MATCH (a:N) SET a.v = null, a.w = a.v");
+    for(int i = 0; i < NODE_COUNT; i++) {
+        ASSERT_EQ(_property(i, "v").type, T_NULL);
+        ASSERT_STREQ(_property(i, "w").stringval, "x");
+    }
+    ASSERT_EQ(StringPool_Size(gc->string_pool), 1);
+}
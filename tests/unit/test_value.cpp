@@ -62,3 +62,17 @@ TEST(ValueTest, TestStrings) {
     SIValue_Free(&v);
 }
 
+
+TEST(ValueTest, TestHashCode) {
+    Alloc_Reset();
+    // Values which compare equal share a hash code.
+    ASSERT_EQ(SIValue_HashCode(SI_LongVal(1)), SIValue_HashCode(SI_DoubleVal(1.0)));
+    ASSERT_EQ(SIValue_HashCode(SI_DoubleVal(-0.0)), SIValue_HashCode(SI_LongVal(0)));
+    ASSERT_NE(SIValue_HashCode(SI_LongVal(1)), SIValue_HashCode(SI_DoubleVal(1.5)));
+    ASSERT_NE(SIValue_HashCode(SI_LongVal(1)), SIValue_HashCode(SI_BoolVal(1)));
+
+    char a[] = "value";
+    char b[] = "value";
+    ASSERT_EQ(SIValue_HashCode(SI_ConstStringVal(a)), SIValue_HashCode(SI_ConstStringVal(b)));
+    ASSERT_NE(SIValue_HashCode(SI_ConstStringVal(a)), SIValue_HashCode(SI_LongVal(1)));
+}
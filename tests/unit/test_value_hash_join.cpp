@@ -0,0 +1,190 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/execution_plan/ops/op_value_hash_join.h"
+#include "../../src/util/rmalloc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Produces records holding a single value at position idx,
+ * values are generated by the test's value function. */
+typedef struct {
+    OpBase op;
+    int idx;                    // Record position value is placed at.
+    int count;                  // Number of records to produce.
+    int produced;               // Number of records produced.
+    SIValue (*value)(int i);    // Value of the i'th record.
+} ValueStream;
+
+static Record ValueStreamConsume(OpBase *opBase) {
+    ValueStream *op = (ValueStream*)opBase;
+    if(op->produced == op->count) return NULL;
+    Record r = Record_New(2);
+    Record_AddScalar(r, op->idx, op->value(op->produced++));
+    return r;
+}
+
+static void ValueStreamFree(OpBase *) {
+}
+
+static OpBase *NewValueStream(int idx, int count, SIValue (*value)(int i)) {
+    ValueStream *op = (ValueStream*)malloc(sizeof(ValueStream));
+    OpBase_Init(&op->op);
+    op->op.consume = ValueStreamConsume;
+    op->op.free = ValueStreamFree;
+    op->idx = idx;
+    op->count = count;
+    op->produced = 0;
+    op->value = value;
+    return (OpBase*)op;
+}
+
+// Expression evaluating to the value at record position idx.
+static AR_ExpNode *_RecordValueExp(int idx) {
+    AR_ExpNode *exp = (AR_ExpNode*)rm_calloc(1, sizeof(AR_ExpNode));
+    exp->type = AR_EXP_OPERAND;
+    exp->operand.type = AR_EXP_VARIADIC;
+    exp->operand.variadic.entity_alias = rm_strdup("v");
+    exp->operand.variadic.entity_alias_idx = idx;
+    exp->operand.variadic.entity_prop = NULL;
+    return exp;
+}
+
+// Every value but the last one appears twice, the last record joins on NULL.
+static SIValue _left_int(int i) {
+    if(i == 200) return SI_NullVal();
+    return SI_LongVal(i / 2);
+}
+
+// Numerically equal doubles join with ints.
+static SIValue _right_double(int i) {
+    if(i == 200) return SI_NullVal();
+    return SI_DoubleVal(i);
+}
+
+// Strings referring to external storage, similar to property values.
+static char _strings[200][16];
+
+static SIValue _left_string(int i) {
+    return SI_ConstStringVal(_strings[i / 2]);
+}
+
+static SIValue _right_string(int i) {
+    return SI_ConstStringVal(_strings[i]);
+}
+
+// Strings owned by the records holding them, e.g. computed by a projection.
+static SIValue _left_owned_string(int i) {
+    return SI_DuplicateStringVal(_strings[i / 2]);
+}
+
+static SIValue _right_owned_string(int i) {
+    return SI_DuplicateStringVal(_strings[i]);
+}
+
+class ValueHashJoinTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        for(int i = 0; i < 200; i++) snprintf(_strings[i], sizeof(_strings[i]), "value %d", i);
+    }
+
+    static void TearDownTestCase() {
+        ValueHashJoin_SetMemoryLimit(VALUE_HASH_JOIN_DEFAULT_MEMORY_LIMIT);
+    }
+
+    /* Joins left and right owned strings, holding on to every joined record
+     * until the join is freed, joined records own the values they hold. */
+    static void _join_owned(bool expect_spill) {
+        OpBase *join = NewValueHashJoin(_RecordValueExp(0), _RecordValueExp(1));
+        OpBase *lhs = NewValueStream(0, 200, _left_owned_string);
+        OpBase *rhs = NewValueStream(1, 200, _right_owned_string);
+        ExecutionPlan_AddOp(join, lhs);
+        ExecutionPlan_AddOp(join, rhs);
+        join->init(join);
+
+        Record joined[200];
+        int joined_count = 0;
+        Record r;
+        while((r = join->consume(join))) {
+            ASSERT_LT(joined_count, 200);
+            joined[joined_count++] = r;
+        }
+        ASSERT_EQ(((OpValueHashJoin*)join)->spilled, expect_spill);
+        OpBase_Free(lhs);
+        OpBase_Free(rhs);
+        OpBase_Free(join);
+
+        ASSERT_EQ(joined_count, 200);
+        for(int i = 0; i < joined_count; i++) {
+            SIValue l = Record_GetScalar(joined[i], 0);
+            SIValue v = Record_GetScalar(joined[i], 1);
+            ASSERT_EQ(l.allocation, M_SELF);
+            ASSERT_EQ(v.allocation, M_SELF);
+            ASSERT_STREQ(l.stringval, v.stringval);
+            Record_Free(joined[i]);
+        }
+    }
+
+    /* Joins 200 left records holding values 0-99 twice
+     * with 200 right records holding values 0-199,
+     * validates each value in the range 0-99 joined twice. */
+    static void _join(SIValue (*left)(int), SIValue (*right)(int), int count, bool expect_spill) {
+        OpBase *join = NewValueHashJoin(_RecordValueExp(0), _RecordValueExp(1));
+        OpBase *lhs = NewValueStream(0, count, left);
+        OpBase *rhs = NewValueStream(1, count, right);
+        ExecutionPlan_AddOp(join, lhs);
+        ExecutionPlan_AddOp(join, rhs);
+        join->init(join);
+
+        int joined[100] = {0};
+        int joined_count = 0;
+        Record r;
+        while((r = join->consume(join))) {
+            // Merged record holds joined values at positions 0 and 1.
+            SIValue l = Record_GetScalar(r, 0);
+            SIValue v = Record_GetScalar(r, 1);
+            EXPECT_EQ(SIValue_Compare(l, v), 0);
+            if(v.type == T_STRING) joined[atoi(v.stringval + strlen("value "))]++;
+            else joined[(int)SI_GET_NUMERIC(v)]++;
+            joined_count++;
+            Record_Free(r);
+        }
+
+        ASSERT_EQ(((OpValueHashJoin*)join)->spilled, expect_spill);
+        ASSERT_EQ(joined_count, 200);
+        for(int i = 0; i < 100; i++) ASSERT_EQ(joined[i], 2);
+
+        OpBase_Free(lhs);
+        OpBase_Free(rhs);
+        OpBase_Free(join);
+    }
+};
+
+TEST_F(ValueHashJoinTest, InMemoryJoin) {
+    _join(_left_int, _right_double, 201, false);
+    _join(_left_string, _right_string, 200, false);
+    _join_owned(false);
+}
+
+TEST_F(ValueHashJoinTest, SpilledJoin) {
+    // Exceed limit after caching a few records.
+    ValueHashJoin_SetMemoryLimit(4096);
+    _join(_left_int, _right_double, 201, true);
+    _join(_left_string, _right_string, 200, true);
+    _join_owned(true);
+}
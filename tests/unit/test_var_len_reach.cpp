@@ -0,0 +1,215 @@
+/*
+* Copyright 2018-2019 Redis Labs Ltd. and Contributors
+*
+* This file is available under the Redis Labs Source Available License Agreement
+*/
+
+#include "../../deps/googletest/include/gtest/gtest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <string.h>
+#include "../../src/value.h"
+#include "../../src/query_executor.h"
+#include "../../src/arithmetic/agg_funcs.h"
+#include "../../src/graph/graphcontext.h"
+#include "../../src/execution_plan/plan_cache.h"
+#include "../../src/execution_plan/execution_plan.h"
+#include "../../src/util/arr.h"
+#include "../../src/util/rmalloc.h"
+
+void ExecutionPlanInit(ExecutionPlan *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <set>
+#include <utility>
+
+#define NODE_COUNT 10
+
+extern pthread_key_t _tlsGCKey;    // Thread local storage graph context key.
+
+typedef std::set<std::pair<NodeID, NodeID>> Pairs;
+
+class VarLenReachTest: public ::testing::Test {
+  protected:
+    static void SetUpTestCase() {
+        // Use the malloc family for allocations
+        Alloc_Reset();
+        AR_RegisterFuncs();
+        Agg_RegisterFuncs();
+        ASSERT_EQ(GrB_init(GrB_NONBLOCKING), GrB_SUCCESS);
+        GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW); // all matrices in CSR format
+        GxB_Global_Option_set(GxB_HYPER, GxB_NEVER_HYPER); // matrices are never hypersparse
+        _fake_graph_context();
+        _build_graph();
+    }
+
+    static void TearDownTestCase() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        GraphContext_Free(gc);
+        GrB_finalize();
+    }
+
+    static void _fake_graph_context() {
+        GraphContext *gc = (GraphContext*)malloc(sizeof(GraphContext));
+
+        gc->g = Graph_New(NODE_COUNT, 16);
+        gc->index_count = 0;
+        gc->graph_name = strdup("G");
+        gc->attributes = NewTrieMap();
+        gc->string_mapping = (char**)array_new(char*, 64);
+        gc->node_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_LABEL_CAP);
+        gc->relation_schemas = (Schema**)array_new(Schema*, GRAPH_DEFAULT_RELATION_TYPE_CAP);
+        gc->string_pool = StringPool_New();
+        gc->plan_cache = PlanCache_New();
+
+        int error = pthread_key_create(&_tlsGCKey, NULL);
+        ASSERT_EQ(error, 0);
+        pthread_setspecific(_tlsGCKey, gc);
+    }
+
+    /* R edges form the cycle 0->1->2->3->4->0, the 2-cycle 5<->6,
+     * a self loop on 3 and the edge 2->7.
+     * S edges lead 7->8->9->2 closing a cycle through both types,
+     * and 4->8, node 8 is also reachable through 5->8. */
+    static void _build_graph() {
+        GraphContext *gc = GraphContext_GetFromTLS();
+        Schema *s = GraphContext_AddSchema(gc, "N", SCHEMA_NODE);
+        Schema *r = GraphContext_AddSchema(gc, "R", SCHEMA_EDGE);
+        Schema *t = GraphContext_AddSchema(gc, "S", SCHEMA_EDGE);
+
+        int R[][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}, {5, 6}, {6, 5}, {3, 3}, {2, 7}};
+        int S[][2] = {{7, 8}, {8, 9}, {9, 2}, {4, 8}, {5, 8}};
+
+        Node n;
+        Edge e;
+        Graph_AcquireWriteLock(gc->g);
+        for(int i = 0; i < NODE_COUNT; i++) Graph_CreateNode(gc->g, s->id, &n);
+        for(uint i = 0; i < sizeof(R) / sizeof(R[0]); i++) {
+            Graph_ConnectNodes(gc->g, R[i][0], R[i][1], r->id, &e);
+        }
+        for(uint i = 0; i < sizeof(S) / sizeof(S[0]); i++) {
+            Graph_ConnectNodes(gc->g, S[i][0], S[i][1], t->id, &e);
+        }
+        Graph_ReleaseLock(gc->g);
+    }
+
+    /* Plans query, reports the type of its variable length traversal
+     * and the distinct (a, b) pairs the traversal produced. */
+    static Pairs _traverse(const char *query, OPType *type) {
+        char *errMsg = NULL;
+        AST **ast = ParseQuery(query, strlen(query), &errMsg);
+        EXPECT_TRUE(ast != NULL) << query;
+        ModifyAST(ast);
+
+        ExecutionPlan *plan = NewExecutionPlan(NULL, ast, NULL, false);
+        ExecutionPlanInit(plan);
+
+        OPType t = (OPType)(OPType_VAR_LEN_REACH | OPType_CONDITIONAL_VAR_LEN_TRAVERSE |
+                            OPType_CONDITIONAL_VAR_LEN_TRAVERSE_EXPAND_INTO);
+        OpBase **ops = ExecutionPlan_LocateOps(plan->root, t);
+        EXPECT_EQ(array_len(ops), 1) << query;
+        OpBase *op = ops[0];
+        array_free(ops);
+        *type = op->type;
+
+        int a = AST_GetAliasID(ast[0], (char*)"a");
+        int b = AST_GetAliasID(ast[0], (char*)"b");
+
+        Pairs pairs;
+        Record r;
+        while((r = op->consume(op))) {
+            NodeID src = ENTITY_GET_ID(Record_GetNode(r, a));
+            NodeID dest = ENTITY_GET_ID(Record_GetNode(r, b));
+            bool inserted = pairs.insert(std::make_pair(src, dest)).second;
+            // Reachability produces each destination once per source.
+            if(*type == OPType_VAR_LEN_REACH) EXPECT_TRUE(inserted) << query;
+            Record_Free(r);
+        }
+
+        ExecutionPlanFree(plan);
+        AST_Free(ast);
+        return pairs;
+    }
+
+    /* Query is expected to be served by reachability if it returns distinct rows,
+     * its results must match those of the path enumerating traversal. */
+    static void _compare(const char *pattern) {
+        char distinct[256];
+        char all[256];
+        snprintf(distinct, 256, "MATCH %s RETURN DISTINCT a, b", pattern);
+        snprintf(all, 256, "MATCH %s RETURN a, b", pattern);
+
+        OPType distinct_type;
+        OPType all_type;
+        Pairs reached = _traverse(distinct, &distinct_type);
+        Pairs paths = _traverse(all, &all_type);
+
+        ASSERT_EQ(distinct_type, OPType_VAR_LEN_REACH) << pattern;
+        ASSERT_NE(all_type, OPType_VAR_LEN_REACH) << pattern;
+        ASSERT_FALSE(paths.empty()) << pattern;
+        ASSERT_EQ(reached, paths) << pattern;
+    }
+};
+
+TEST_F(VarLenReachTest, MinHops) {
+    _compare("(a:N)-[:R*1..2]->(b:N)");
+    _compare("(a:N)-[:R*0..2]->(b:N)");
+    _compare("(a:N)-[:R*..2]->(b:N)");
+    _compare("(a:N)-[:R*0..1]->(b:N)");
+}
+
+TEST_F(VarLenReachTest, MaxHops) {
+    _compare("(a:N)-[:R*1..3]->(b:N)");
+    _compare("(a:N)-[:R*]->(b:N)");
+    _compare("(a:N)-[:R*0..]->(b:N)");
+    _compare("(a:N)-[:R*..5]->(b:N)");
+}
+
+TEST_F(VarLenReachTest, Cycles) {
+    // Sources reach themselves through cycles and self loops.
+    OPType type;
+    Pairs reached = _traverse("MATCH (a:N)-[:R*2..3]->(b:N) RETURN a, b", &type);
+    ASSERT_TRUE(reached.count(std::make_pair(5, 5)));
+    reached = _traverse("MATCH (a:N)-[:R*]->(b:N) RETURN DISTINCT a, b", &type);
+    ASSERT_EQ(type, OPType_VAR_LEN_REACH);
+    ASSERT_TRUE(reached.count(std::make_pair(0, 0)));
+    ASSERT_TRUE(reached.count(std::make_pair(3, 3)));
+    ASSERT_TRUE(reached.count(std::make_pair(5, 5)));
+    ASSERT_FALSE(reached.count(std::make_pair(7, 7)));
+
+    // Cycle closed by the variable length traversal.
+    _compare("(a:N)-[:R]->(b:N)-[:R*1..4]->(a)");
+    _compare("(a:N)-[:R|:S*]->(b:N)-[:R]->(a)");
+}
+
+TEST_F(VarLenReachTest, MultipleRelationTypes) {
+    _compare("(a:N)-[:R|:S*1..3]->(b:N)");
+    _compare("(a:N)-[:S|:R*]->(b:N)");
+    _compare("(a:N)-[:S*0..2]->(b:N)");
+}
+
+TEST_F(VarLenReachTest, Direction) {
+    _compare("(a:N)<-[:R*1..3]-(b:N)");
+    _compare("(a:N)<-[:R|:S*]-(b:N)");
+    _compare("(b:N)-[:R*0..2]->(a:N)");
+}
+
+TEST_F(VarLenReachTest, RewriteRequiresDistinct) {
+    OPType type;
+
+    // Path multiplicity matters.
+    _traverse("MATCH (a:N)-[:R*1..3]->(b:N) RETURN a, b", &type);
+    ASSERT_EQ(type, OPType_CONDITIONAL_VAR_LEN_TRAVERSE);
+    _traverse("MATCH (a:N)-[:R*1..3]->(b:N) RETURN DISTINCT a, count(b)", &type);
+    ASSERT_EQ(type, OPType_CONDITIONAL_VAR_LEN_TRAVERSE);
+
+    // Nodes reachable only by reusing an edge can't be told apart.
+    _traverse("MATCH (a:N)-[:R*2..3]->(b:N) RETURN DISTINCT a, b", &type);
+    ASSERT_EQ(type, OPType_CONDITIONAL_VAR_LEN_TRAVERSE);
+}